@@ -144,6 +144,15 @@ HPP_FCL_DLLAPI bool overlap(const Matrix3f& R0, const Vec3f& T0, const OBB& b1,
 /// The second box is in identity configuration.
 HPP_FCL_DLLAPI bool obbDisjoint(const Matrix3f& B, const Vec3f& T,
                                 const Vec3f& a, const Vec3f& b);
+
+/// Same test in the scalar type Scalar, whatever FCL_REAL is. It is
+/// instantiated for float and double, so that a caller may run it in single
+/// precision within a double precision build.
+template <typename Scalar>
+HPP_FCL_DLLAPI bool obbDisjoint(const Eigen::Matrix<Scalar, 3, 3>& B,
+                                const Eigen::Matrix<Scalar, 3, 1>& T,
+                                const Eigen::Matrix<Scalar, 3, 1>& a,
+                                const Eigen::Matrix<Scalar, 3, 1>& b);
 }  // namespace fcl
 
 }  // namespace hpp
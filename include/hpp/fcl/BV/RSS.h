@@ -89,12 +89,12 @@ struct HPP_FCL_DLLAPI RSS {
   /// @brief Check collision between two RSS
   bool overlap(const RSS& other) const;
 
-  /// Not implemented
-  bool overlap(const RSS& other, const CollisionRequest&,
-               FCL_REAL& sqrDistLowerBound) const {
-    sqrDistLowerBound = sqrt(-1);
-    return overlap(other);
-  }
+  /// @brief Check collision between two RSS
+  /// @return true if collision happens.
+  /// @retval sqrDistLowerBound squared lower bound on distance between RSS if
+  ///         they do not overlap.
+  bool overlap(const RSS& other, const CollisionRequest& request,
+               FCL_REAL& sqrDistLowerBound) const;
 
   /// @brief the distance between two RSS; P and Q, if not NULL, return the
   /// nearest points
@@ -77,6 +77,11 @@ class HPP_FCL_DLLAPI BVHModelBase : public CollisionGeometry {
   /// @brief Number of points
   unsigned int num_vertices;
 
+  /// @brief Radius of the points of a point cloud, which are handled as
+  /// spheres by the collision and distance queries. Unused for meshes.
+  /// \note computeLocalAABB must be called again after it is modified.
+  FCL_REAL point_radius;
+
   /// @brief The state of BVH building process
   BVHBuildState build_state;
 
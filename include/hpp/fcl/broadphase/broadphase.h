@@ -40,8 +40,10 @@
 #include "hpp/fcl/broadphase/broadphase_bruteforce.h"
 #include "hpp/fcl/broadphase/broadphase_SaP.h"
 #include "hpp/fcl/broadphase/broadphase_SSaP.h"
+#include "hpp/fcl/broadphase/broadphase_MBP.h"
 #include "hpp/fcl/broadphase/broadphase_interval_tree.h"
 #include "hpp/fcl/broadphase/broadphase_spatialhash.h"
+#include "hpp/fcl/broadphase/broadphase_continuous_dynamic_AABB_tree.h"
 
 #include "hpp/fcl/broadphase/default_broadphase_callbacks.h"
 
@@ -0,0 +1,248 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HPP_FCL_BROAD_PHASE_MBP_H
+#define HPP_FCL_BROAD_PHASE_MBP_H
+
+#include <vector>
+#include <unordered_map>
+
+#include "hpp/fcl/broadphase/broadphase_collision_manager.h"
+
+namespace hpp {
+namespace fcl {
+
+/// @brief Multi box pruning collision manager.
+///
+/// The scene is partitioned into a regular grid of regions. Each region runs
+/// its own sweep and prune over the objects whose AABB overlaps it, so that
+/// the sort axis never degenerates over very large scenes. Objects spanning
+/// several regions are stored once and referenced by index from every region
+/// they touch. A candidate pair is reported only by the region containing the
+/// lower corner of the intersection of the two AABBs, which guarantees that
+/// each pair is reported exactly once. Objects outside of the scene limits are
+/// assigned to the border regions.
+///
+/// Updating a single object moves it to its place in the sorted regions it
+/// overlaps. When the library is built with OpenMP, updating all the objects
+/// or a set of objects refreshes the objects, filters the regions they left
+/// and sorts the modified regions in parallel.
+class HPP_FCL_DLLAPI MBPCollisionManager : public BroadPhaseCollisionManager {
+ public:
+  typedef BroadPhaseCollisionManager Base;
+  using Base::getObjects;
+
+  /// @param scene_min lower corner of the partitioned scene
+  /// @param scene_max upper corner of the partitioned scene
+  /// @param nb_regions_x, nb_regions_y, nb_regions_z number of regions along
+  ///        each axis
+  MBPCollisionManager(const Vec3f& scene_min, const Vec3f& scene_max,
+                      unsigned int nb_regions_x = 8,
+                      unsigned int nb_regions_y = 8,
+                      unsigned int nb_regions_z = 1);
+
+  ~MBPCollisionManager();
+
+  /// @brief add objects to the manager
+  void registerObjects(const std::vector<CollisionObject*>& other_objs);
+
+  /// @brief add one object to the manager
+  void registerObject(CollisionObject* obj);
+
+  /// @brief remove one object from the manager
+  void unregisterObject(CollisionObject* obj);
+
+  /// @brief initialize the manager, related with the specific type of manager
+  void setup();
+
+  /// @brief update the condition of manager
+  virtual void update();
+
+  /// @brief update the manager by explicitly given the object updated
+  void update(CollisionObject* updated_obj);
+
+  /// @brief update the manager by explicitly given the set of objects update
+  void update(const std::vector<CollisionObject*>& updated_objs);
+
+  /// @brief clear the manager
+  void clear();
+
+  /// @brief return the objects managed by the manager
+  void getObjects(std::vector<CollisionObject*>& objs) const;
+
+  /// @brief perform collision test between one object and all the objects
+  /// belonging to the manager
+  void collide(CollisionObject* obj, CollisionCallBackBase* callback) const;
+
+  /// @brief perform distance computation between one object and all the objects
+  /// belonging to the manager
+  void distance(CollisionObject* obj, DistanceCallBackBase* callback) const;
+
+  /// @brief perform collision test for the objects belonging to the manager
+  /// (i.e., N^2 self collision)
+  void collide(CollisionCallBackBase* callback) const;
+
+  /// @brief perform distance test for the objects belonging to the manager
+  /// (i.e., N^2 self distance)
+  void distance(DistanceCallBackBase* callback) const;
+
+  /// @brief perform collision test with objects belonging to another manager
+  void collide(BroadPhaseCollisionManager* other_manager,
+               CollisionCallBackBase* callback) const;
+
+  /// @brief perform distance test with objects belonging to another manager
+  void distance(BroadPhaseCollisionManager* other_manager,
+                DistanceCallBackBase* callback) const;
+
+  /// @brief whether the manager is empty
+  bool empty() const;
+
+  /// @brief the number of objects managed by the manager
+  size_t size() const;
+
+  /// @brief the number of regions the scene is partitioned into
+  size_t numRegions() const { return regions.size(); }
+
+ protected:
+  /// @brief Object registered in the manager
+  struct MBPObject {
+    /// @brief object
+    CollisionObject* obj;
+
+    /// @brief cached AABB value
+    AABB cached;
+
+    /// @brief range of regions overlapped by the cached AABB
+    int region_min[3];
+    int region_max[3];
+  };
+
+  /// @brief Region of the scene with its own sweep and prune
+  struct MBPRegion {
+    /// @brief indices in objects, sorted along the sweep axis
+    std::vector<size_t> indices;
+
+    /// @brief whether indices needs to be sorted again
+    bool dirty;
+  };
+
+  /// @brief compute the range of regions overlapped by an AABB
+  void computeRegionRange(const AABB& aabb, int range_min[3],
+                          int range_max[3]) const;
+
+  /// @brief compute the region containing a point, with points outside of the
+  /// scene being assigned to the border regions
+  int computeRegion(const Vec3f& p, int region[3]) const;
+
+  /// @brief index of a region from its grid coordinates
+  int regionIndex(int x, int y, int z) const {
+    return x + nb_regions[0] * (y + nb_regions[1] * z);
+  }
+
+  /// @brief lower bound of the distance between an AABB and the objects
+  /// assigned to a region
+  FCL_REAL regionDistance(const AABB& aabb, int x, int y, int z) const;
+
+  /// @brief whether a region is in a range of regions
+  static bool inRange(int x, int y, int z, const int range_min[3],
+                      const int range_max[3]) {
+    return range_min[0] <= x && x <= range_max[0] && range_min[1] <= y &&
+           y <= range_max[1] && range_min[2] <= z && z <= range_max[2];
+  }
+
+  /// @brief insert the object at a given index in a region, or move it to its
+  /// place if it is already a member of the region. A dirty region is sorted
+  /// later and the object is appended to it.
+  void placeInRegion(MBPRegion& region, size_t index, bool member);
+
+  /// @brief add the object at a given index to the regions of a range
+  void addToRegions(size_t index, const int range_min[3],
+                    const int range_max[3]);
+
+  /// @brief remove the object at a given index from the regions of a range
+  void removeFromRegions(size_t index, const int range_min[3],
+                         const int range_max[3]);
+
+  /// @brief refresh the cached AABB of one object and compute the range of
+  /// regions it overlaps
+  /// @return false if the AABB did not change, in which case the range is not
+  /// computed
+  bool refreshObject(size_t index, int range_min[3], int range_max[3]);
+
+  /// @brief refresh the cached AABB and the regions of one object
+  void update_(size_t index);
+
+  /// @brief refresh the cached AABBs and the regions of a set of objects,
+  /// given by their sorted and unique indices
+  void update_(const std::vector<size_t>& indices);
+
+  /// @brief sort the regions which are marked as dirty
+  void sortRegions();
+
+  bool collide_(CollisionObject* obj, CollisionCallBackBase* callback) const;
+
+  bool distance_(CollisionObject* obj, size_t first_index,
+                 DistanceCallBackBase* callback, FCL_REAL& min_dist) const;
+
+  /// @brief lower corner of the partitioned scene
+  Vec3f scene_min;
+
+  /// @brief size of a region along each axis
+  Vec3f region_size;
+
+  /// @brief number of regions along each axis
+  int nb_regions[3];
+
+  /// @brief axis along which the regions are sorted
+  int sweep_axis;
+
+  /// @brief objects registered in the manager
+  std::vector<MBPObject> objects;
+
+  /// @brief regions of the scene
+  std::vector<MBPRegion> regions;
+
+  /// @brief map from a collision object to its index in objects
+  std::unordered_map<CollisionObject*, size_t> obj_index_map;
+
+  /// @brief per object stamp used to visit each object at most once during a
+  /// distance query
+  mutable std::vector<size_t> visit_stamps;
+  mutable size_t current_stamp;
+};
+
+}  // namespace fcl
+}  // namespace hpp
+
+#endif
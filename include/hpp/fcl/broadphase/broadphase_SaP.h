@@ -107,6 +107,36 @@ class HPP_FCL_DLLAPI SaPCollisionManager : public BroadPhaseCollisionManager {
   void distance(BroadPhaseCollisionManager* other_manager,
                 DistanceCallBackBase* callback) const;
 
+  /// @brief find the objects whose distance to a query object is at most
+  /// radius. The query object itself and the objects which cannot collide
+  /// with it are skipped.
+  /// @param obj the query object
+  /// @param radius the maximal distance
+  /// @param results buffer cleared and filled with the objects found, sorted
+  /// by increasing distance
+  /// @param exact if false, the distance between the AABBs of the objects is
+  /// used. Otherwise, the distance between the geometries is computed with the
+  /// narrowphase for the objects whose AABB is close enough.
+  /// @return the number of objects found
+  size_t radiusQuery(CollisionObject* obj, FCL_REAL radius,
+                     std::vector<NeighborResult>& results,
+                     bool exact = false) const;
+
+  /// @brief find the k objects which are the closest to a query object. The
+  /// query object itself and the objects which cannot collide with it are
+  /// skipped.
+  /// @param obj the query object
+  /// @param k the maximal number of objects
+  /// @param results buffer cleared and filled with the objects found, sorted
+  /// by increasing distance
+  /// @param exact if false, the distance between the AABBs of the objects is
+  /// used. Otherwise, the distance between the geometries is computed with the
+  /// narrowphase, only for the objects whose AABB is close enough.
+  /// @return the number of objects found
+  size_t nearestNeighbors(CollisionObject* obj, size_t k,
+                          std::vector<NeighborResult>& results,
+                          bool exact = false) const;
+
   /// @brief whether the manager is empty
   bool empty() const;
 
@@ -192,6 +222,10 @@ class HPP_FCL_DLLAPI SaPCollisionManager : public BroadPhaseCollisionManager {
 
   void update_(SaPAABB* updated_aabb);
 
+  /// @brief move an end point right after prev in the end point list of a
+  /// coordinate, at the beginning if prev is null
+  void moveEndPoint(EndPoint* end_point, EndPoint* prev, size_t coord);
+
   void updateVelist();
 
   /// @brief End point list for x, y, z coordinates
@@ -215,6 +249,11 @@ class HPP_FCL_DLLAPI SaPCollisionManager : public BroadPhaseCollisionManager {
 
   bool collide_(CollisionObject* obj, CollisionCallBackBase* callback) const;
 
+  /// @brief best-first search of the k objects closest to a query object
+  /// within max_distance
+  void neighborSearch_(CollisionObject* obj, FCL_REAL max_distance, size_t k,
+                       std::vector<NeighborResult>& results, bool exact) const;
+
   void addToOverlapPairs(const SaPPair& p);
 
   void removeFromOverlapPairs(const SaPPair& p);
@@ -39,6 +39,8 @@
 
 #include "hpp/fcl/fwd.hh"
 #include "hpp/fcl/data_types.h"
+#include "hpp/fcl/collision_object.h"
+#include "hpp/fcl/narrowphase/continuous_collision_object.h"
 
 namespace hpp {
 namespace fcl {
@@ -61,7 +63,10 @@ struct HPP_FCL_DLLAPI CollisionCallBackBase {
   virtual bool collide(CollisionObject* o1, CollisionObject* o2) = 0;
 
   /// @brief Functor call associated to the collide operation.
+  ///        Pairs of objects whose collision filters do not match are
+  ///        skipped (see CollisionObject::canCollideWith).
   virtual bool operator()(CollisionObject* o1, CollisionObject* o2) {
+    if (!o1->canCollideWith(*o2)) return false;
     return collide(o1, o2);
   }
 };
@@ -92,6 +97,33 @@ struct HPP_FCL_DLLAPI DistanceCallBackBase {
   }
 };
 
+/// @brief Base callback class for continuous collision queries.
+/// It is called on the pairs of ContinuousCollisionObjects whose swept AABBs
+/// overlap.
+struct HPP_FCL_DLLAPI ContinuousCollisionCallBackBase {
+  /// @brief Initialization of the callback before running the continuous
+  /// collision broadphase manager.
+  virtual void init(){};
+
+  /// @brief Continuous collision evaluation between two objects whose swept
+  ///        volumes may overlap.
+  ///        This callback will cause the broadphase evaluation to stop if it
+  ///        returns true.
+  ///
+  /// @param[in] o1 Continuous collision object #1.
+  /// @param[in] o2 Continuous collision object #2.
+  virtual bool collide(ContinuousCollisionObject* o1,
+                       ContinuousCollisionObject* o2) = 0;
+
+  /// @brief Functor call associated to the collide operation.
+  virtual bool operator()(ContinuousCollisionObject* o1,
+                          ContinuousCollisionObject* o2) {
+    return collide(o1, o2);
+  }
+
+  virtual ~ContinuousCollisionCallBackBase(){};
+};
+
 }  // namespace fcl
 }  // namespace hpp
 
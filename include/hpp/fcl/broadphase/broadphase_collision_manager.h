@@ -48,9 +48,35 @@
 namespace hpp {
 namespace fcl {
 
+/// @brief Object found by a neighbor query of a broadphase manager
+struct HPP_FCL_DLLAPI NeighborResult {
+  /// @brief object found by the query
+  CollisionObject* object;
+
+  /// @brief distance between the query object and the object found. This is
+  /// the distance between their AABBs, or the distance between their
+  /// geometries when the query is refined by the narrowphase.
+  FCL_REAL distance;
+
+  NeighborResult(CollisionObject* object = nullptr, FCL_REAL distance = 0)
+      : object(object), distance(distance) {}
+
+  bool operator==(const NeighborResult& other) const {
+    return object == other.object && distance == other.distance;
+  }
+
+  bool operator!=(const NeighborResult& other) const {
+    return !(*this == other);
+  }
+};
+
 /// @brief Base class for broad phase collision. It helps to accelerate the
 /// collision/distance between N objects. Also support self collision, self
 /// distance and collision/distance with another M objects.
+///
+/// The managers use the world AABBs cached in the objects and never
+/// recompute them. After moving objects, call CollisionObject::computeAABB,
+/// or computeAABBs for a set of objects, before registering or updating them.
 class HPP_FCL_DLLAPI BroadPhaseCollisionManager {
  public:
   BroadPhaseCollisionManager();
@@ -38,31 +38,27 @@
 #ifndef HPP_FCL_BROADPHASE_BROADPHASECONTINUOUSCOLLISIONMANAGER_H
 #define HPP_FCL_BROADPHASE_BROADPHASECONTINUOUSCOLLISIONMANAGER_H
 
-#include "hpp/fcl/broadphase/broadphase_collision_manager.h"
-#include "hpp/fcl/collision_object.h"
+#include "hpp/fcl/broadphase/broadphase_callbacks.h"
 #include "hpp/fcl/narrowphase/continuous_collision_object.h"
 
 namespace hpp {
 namespace fcl {
 
-/// @brief Callback for continuous collision between two objects. Return value
-/// is whether can stop now.
-template <typename S>
-using ContinuousCollisionCallBack = bool (*)(ContinuousCollisionObject* o1,
-                                             ContinuousCollisionObject* o2,
-                                             void* cdata);
-
-/// @brief Callback for continuous distance between two objects, Return value is
-/// whether can stop now, also return the minimum distance till now.
-template <typename S>
-using ContinuousDistanceCallBack = bool (*)(ContinuousCollisionObject* o1,
-                                            ContinuousCollisionObject* o2,
-                                            S& dist);
-
 /// @brief Base class for broad phase continuous collision. It helps to
-/// accelerate the continuous collision/distance between N objects. Also support
-/// self collision, self distance and collision/distance with another M objects.
-template <typename S>
+/// accelerate the continuous collision between N moving objects, by culling
+/// the pairs whose swept AABBs do not overlap. Also support self collision
+/// and collision with another M objects.
+///
+/// The motions of all the objects are processed in one call, e.g. a whole
+/// edge of a motion planner or a physics substep:
+/// \code
+///   for (ContinuousCollisionObject* obj : objects) {
+///     obj->setMotion(tf_beg, tf_end);
+///     obj->computeAABB();
+///   }
+///   manager.update();
+///   manager.collide(&callback);
+/// \endcode
 class HPP_FCL_DLLAPI BroadPhaseContinuousCollisionManager {
  public:
   BroadPhaseContinuousCollisionManager();
@@ -102,28 +98,15 @@ class HPP_FCL_DLLAPI BroadPhaseContinuousCollisionManager {
   /// @brief perform collision test between one object and all the objects
   /// belonging to the manager
   virtual void collide(ContinuousCollisionObject* obj,
-                       CollisionCallBackBase* callback) const = 0;
-
-  /// @brief perform distance computation between one object and all the objects
-  /// belonging to the manager
-  virtual void distance(ContinuousCollisionObject* obj,
-                        DistanceCallBackBase* callback) const = 0;
+                       ContinuousCollisionCallBackBase* callback) const = 0;
 
   /// @brief perform collision test for the objects belonging to the manager
   /// (i.e., N^2 self collision)
-  virtual void collide(CollisionCallBackBase* callback) const = 0;
-
-  /// @brief perform distance test for the objects belonging to the manager
-  /// (i.e., N^2 self distance)
-  virtual void distance(DistanceCallBackBase* callback) const = 0;
+  virtual void collide(ContinuousCollisionCallBackBase* callback) const = 0;
 
   /// @brief perform collision test with objects belonging to another manager
   virtual void collide(BroadPhaseContinuousCollisionManager* other_manager,
-                       CollisionCallBackBase* callback) const = 0;
-
-  /// @brief perform distance test with objects belonging to another manager
-  virtual void distance(BroadPhaseContinuousCollisionManager* other_manager,
-                        DistanceCallBackBase* callback) const = 0;
+                       ContinuousCollisionCallBackBase* callback) const = 0;
 
   /// @brief whether the manager is empty
   virtual bool empty() const = 0;
@@ -132,15 +115,8 @@ class HPP_FCL_DLLAPI BroadPhaseContinuousCollisionManager {
   virtual size_t size() const = 0;
 };
 
-using BroadPhaseContinuousCollisionManagerf =
-    BroadPhaseContinuousCollisionManager<float>;
-using BroadPhaseContinuousCollisionManagerd =
-    BroadPhaseContinuousCollisionManager<FCL_REAL>;
-
 }  // namespace fcl
 
 }  // namespace hpp
 
-#include "hpp/fcl/broadphase/broadphase_continuous_collision_manager-inl.h"
-
 #endif
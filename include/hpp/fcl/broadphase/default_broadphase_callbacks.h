@@ -42,9 +42,7 @@
 #include "hpp/fcl/broadphase/broadphase_callbacks.h"
 #include "hpp/fcl/collision.h"
 #include "hpp/fcl/distance.h"
-// #include "hpp/fcl/narrowphase/continuous_collision.h"
-// #include "hpp/fcl/narrowphase/continuous_collision_request.h"
-// #include "hpp/fcl/narrowphase/continuous_collision_result.h"
+#include "hpp/fcl/narrowphase/continuous_collision_object.h"
 // #include "hpp/fcl/narrowphase/distance_request.h"
 // #include "hpp/fcl/narrowphase/distance_result.h"
 
@@ -106,54 +104,41 @@ struct DistanceData {
 bool defaultCollisionFunction(CollisionObject* o1, CollisionObject* o2,
                               void* data);
 
-/// @brief Collision data for use with the DefaultContinuousCollisionFunction.
-/// It stores the collision request and the result given by the collision
-/// algorithm (and stores the conclusion of whether further evaluation of the
-/// broadphase collision manager has been deemed unnecessary).
-// struct DefaultContinuousCollisionData {
-//   ContinuousCollisionRequest request;
-//   ContinuousCollisionResult result;
-//
-//   /// If `true`, requests that the broadphase evaluation stop.
-//   bool done{false};
-// };
-
-/// @brief Provides a simple callback for the continuous collision query in the
-/// BroadPhaseCollisionManager. It assumes the `data` parameter is non-null and
-/// points to an instance of DefaultContinuousCollisionData. It simply invokes
-/// the `collide()` method on the culled pair of geometries and stores the
-/// results in the data's ContinuousCollisionResult instance.
-///
-/// This callback will never cause the broadphase evaluation to terminate early.
-/// However, if the `done` member of the DefaultContinuousCollisionData is set
-/// to true, this method will simply return without doing any computation.
+/// @brief Continuous collision data stores the continuous collision request
+/// and the earliest contact found by the continuous collision algorithm.
+struct ContinuousCollisionData {
+  ContinuousCollisionData() : o1(nullptr), o2(nullptr), done(false) {}
+
+  /// @brief Continuous collision request
+  ContinuousCollisionRequest request;
+
+  /// @brief Result of the pair with the earliest time of contact
+  ContinuousCollisionResult result;
+
+  /// @brief Pair with the earliest time of contact, null if none
+  ContinuousCollisionObject *o1, *o2;
+
+  /// @brief Whether the collision iteration can stop
+  bool done;
+};
+
+/// @brief Provides a simple callback for the continuous collision query in
+/// the BroadPhaseContinuousCollisionManager. It assumes the `data` parameter
+/// is non-null and points to an instance of ContinuousCollisionData. It
+/// invokes continuousCollide() on the culled pair of objects and keeps the
+/// result if its time of contact is the earliest so far.
 ///
-/// For a given instance of DefaultContinuousCollisionData, if broadphase
-/// evaluation has already terminated (i.e.,
-/// DefaultContinuousCollisionFunction() returned `true`), subsequent
-/// invocations with the same instance of CollisionData will return
-/// immediately, requesting termination of broadphase evaluation (i.e., return
-/// `true`).
+/// This callback will cause the broadphase evaluation to stop if a pair is
+/// in contact at the beginning of the motion, since no earlier contact can
+/// be found.
 ///
 /// @param o1   The first object in the culled pair.
 /// @param o2   The second object in the culled pair.
-/// @param data A non-null pointer to a CollisionData instance.
-/// @return True if the broadphase evaluation should stop.
-/// @tparam S   The scalar type with which the computation will be performed.
-// bool DefaultContinuousCollisionFunction(ContinuousCollisionObject* o1,
-//                                         ContinuousCollisionObject* o2,
-//                                         void* data) {
-//   assert(data != nullptr);
-//   auto* cdata = static_cast<DefaultContinuousCollisionData*>(data);
-//
-//   if (cdata->done) return true;
-//
-//   const ContinuousCollisionRequest& request = cdata->request;
-//   ContinuousCollisionResult& result = cdata->result;
-//   collide(o1, o2, request, result);
-//
-//   return cdata->done;
-// }
+/// @param data A non-null pointer to a ContinuousCollisionData instance.
+/// @return `true` if the broadphase evaluation should stop.
+bool defaultContinuousCollisionFunction(ContinuousCollisionObject* o1,
+                                        ContinuousCollisionObject* o2,
+                                        void* data);
 
 /// @brief Provides a simple callback for the distance query in the
 /// BroadPhaseCollisionManager. It assumes the `data` parameter is non-null and
@@ -200,6 +185,56 @@ struct HPP_FCL_DLLAPI DistanceCallBackDefault : DistanceCallBackBase {
   virtual ~DistanceCallBackDefault(){};
 };
 
+/// @brief Default continuous collision callback, which finds the earliest
+/// contact between the objects.
+struct HPP_FCL_DLLAPI ContinuousCollisionCallBackDefault
+    : ContinuousCollisionCallBackBase {
+  bool collide(ContinuousCollisionObject* o1, ContinuousCollisionObject* o2);
+
+  ContinuousCollisionData data;
+
+  virtual ~ContinuousCollisionCallBackDefault(){};
+};
+
+/// @brief Continuous collision callback which stores all the pairs coming in
+/// contact during the motion, with their results. It never stops the
+/// broadphase evaluation.
+struct HPP_FCL_DLLAPI ContinuousCollisionCallBackCollect
+    : ContinuousCollisionCallBackBase {
+  typedef std::pair<ContinuousCollisionObject*, ContinuousCollisionObject*>
+      CollisionPair;
+
+  /// @brief Default constructor.
+  /// @param request continuous collision request used for all the pairs
+  ContinuousCollisionCallBackCollect(
+      const ContinuousCollisionRequest& request = ContinuousCollisionRequest());
+
+  bool collide(ContinuousCollisionObject* o1, ContinuousCollisionObject* o2);
+
+  /// @brief Reset the collected pairs
+  void init();
+
+  /// @brief Returns the pairs coming in contact, in the collection order
+  const std::vector<CollisionPair>& getCollidingPairs() const {
+    return colliding_pairs;
+  }
+
+  /// @brief Returns the results of the pairs coming in contact, in the order
+  /// of getCollidingPairs()
+  const std::vector<ContinuousCollisionResult>& getResults() const {
+    return results;
+  }
+
+  virtual ~ContinuousCollisionCallBackCollect(){};
+
+  /// @brief Continuous collision request
+  ContinuousCollisionRequest request;
+
+ protected:
+  std::vector<CollisionPair> colliding_pairs;
+  std::vector<ContinuousCollisionResult> results;
+};
+
 /// @brief Collision callback to collect collision pairs potentially in contacts
 struct HPP_FCL_DLLAPI CollisionCallBackCollect : CollisionCallBackBase {
   typedef std::pair<CollisionObject*, CollisionObject*> CollisionPair;
@@ -228,6 +263,75 @@ struct HPP_FCL_DLLAPI CollisionCallBackCollect : CollisionCallBackBase {
   size_t max_size;
 };
 
+/// @brief Collision callback which collects the candidate pairs of the
+/// broadphase and runs the narrowphase on all of them at once.
+///
+/// The pairs are grouped by the node types of their geometries, and the
+/// collision function of each group is looked up before running the queries.
+/// Each group is processed by a single loop, in which the collision function
+/// of the pairs of shapes is resolved at compile time. The queries share a
+/// single GJK solver, or one solver per thread when processed in parallel.
+/// Only the results of the pairs in collision are stored.
+///
+/// \code
+///   CollisionCallBackBatch callback(request);
+///   manager->collide(&callback);
+///   callback.processPairs();
+///   // results of the pairs in collision
+///   const std::vector<CollisionResult>& results = callback.getResults();
+/// \endcode
+struct HPP_FCL_DLLAPI CollisionCallBackBatch : CollisionCallBackBase {
+  typedef std::pair<CollisionObject*, CollisionObject*> CollisionPair;
+
+  /// @brief Default constructor.
+  /// @param request collision request used for all the pairs
+  /// @param parallel whether the pairs are processed in parallel. This requires
+  ///        the library to be built with OpenMP.
+  CollisionCallBackBatch(const CollisionRequest& request = CollisionRequest(),
+                         bool parallel = false);
+
+  /// @brief Stores the pair. It never stops the broadphase evaluation.
+  bool collide(CollisionObject* o1, CollisionObject* o2);
+
+  /// @brief Reset the collected pairs
+  void init();
+
+  /// @brief Run the narrowphase on all the collected pairs.
+  /// @return the number of pairs in collision
+  size_t processPairs();
+
+  /// @brief Returns the number of collected pairs
+  size_t numCollisionPairs() const { return collision_pairs.size(); }
+
+  /// @brief Returns the collected pairs
+  const std::vector<CollisionPair>& getCollisionPairs() const {
+    return collision_pairs;
+  }
+
+  /// @brief Returns the pairs found in collision by the last call to
+  /// processPairs(), in the collection order
+  const std::vector<CollisionPair>& getCollidingPairs() const {
+    return colliding_pairs;
+  }
+
+  /// @brief Returns the results of the pairs found in collision by the last
+  /// call to processPairs(), in the order of getCollidingPairs()
+  const std::vector<CollisionResult>& getResults() const { return results; }
+
+  virtual ~CollisionCallBackBatch(){};
+
+  /// @brief Collision request
+  CollisionRequest request;
+
+  /// @brief Whether the pairs are processed in parallel
+  bool parallel;
+
+ protected:
+  std::vector<CollisionPair> collision_pairs;
+  std::vector<CollisionPair> colliding_pairs;
+  std::vector<CollisionResult> results;
+};
+
 }  // namespace fcl
 
 }  // namespace hpp
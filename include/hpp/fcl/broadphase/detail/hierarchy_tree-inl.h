@@ -685,6 +685,8 @@ typename HierarchyTree<BV>::Node* HierarchyTree<BV>::sort(Node* n, Node*& r) {
     n->children[i] = p;
     n->children[j] = s;
     std::swap(p->bv, n->bv);
+    std::swap(p->collision_group, n->collision_group);
+    std::swap(p->collision_mask, n->collision_mask);
     return p;
   }
   return n;
@@ -765,6 +767,22 @@ void HierarchyTree<BV>::insertLeaf(Node* const sub_root, Node* const leaf)
     root_node = node;
   }
 
+  // The ancestors of `leaf` must accept its collision filters. The new `node`
+  // takes the union of its children, and the union is propagated up until an
+  // ancestor already contains it.
+  node = leaf->parent;
+  node->collision_group =
+      node->children[0]->collision_group | node->children[1]->collision_group;
+  node->collision_mask =
+      node->children[0]->collision_mask | node->children[1]->collision_mask;
+  for (node = node->parent; node; node = node->parent) {
+    const uint32_t group = node->collision_group | leaf->collision_group;
+    const uint32_t mask = node->collision_mask | leaf->collision_mask;
+    if (group == node->collision_group && mask == node->collision_mask) break;
+    node->collision_group = group;
+    node->collision_mask = mask;
+  }
+
   // Note that the above algorithm always adds the new `leaf` node as the right
   // child, i.e., children[1].  Calling removeLeaf(l) followed by calling
   // this function insertLeaf(l) where l is a left child will result in
@@ -890,6 +908,8 @@ typename HierarchyTree<BV>::Node* HierarchyTree<BV>::createNode(Node* parent,
   node->parent = parent;
   node->data = data;
   node->children[1] = 0;
+  node->collision_group = 0xFFFFFFFF;
+  node->collision_mask = 0xFFFFFFFF;
   return node;
 }
 
@@ -0,0 +1,155 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HPP_FCL_BROADPHASE_DETAIL_NEIGHBOR_SEARCH_H
+#define HPP_FCL_BROADPHASE_DETAIL_NEIGHBOR_SEARCH_H
+
+#include <functional>
+#include <limits>
+#include <queue>
+#include <vector>
+
+#include "hpp/fcl/distance.h"
+#include "hpp/fcl/broadphase/broadphase_collision_manager.h"
+
+namespace hpp {
+namespace fcl {
+
+namespace detail {
+
+/// @brief Best-first search of the objects of a broadphase manager which are
+/// the closest to a query object.
+///
+/// The candidates are explored by increasing lower bound of their distance to
+/// the query object. A candidate is either an object, or a set of objects
+/// identified by a Node (a node of a tree, a position in a sorted list...)
+/// which the manager expands into other candidates. When the search is refined
+/// by the narrowphase, the distance between the geometries of an object is
+/// computed when it reaches the top of the queue, and the object is queued
+/// again with this distance. Hence, the objects are reported by increasing
+/// distance and the narrowphase is only run on the objects which may belong to
+/// the result.
+template <typename Node>
+class NeighborSearch {
+ public:
+  NeighborSearch(const CollisionObject* query, bool exact)
+      : query(query), exact(exact) {}
+
+  /// @brief lower bound of the distance between the query object and the
+  /// objects contained in an AABB
+  FCL_REAL lowerBound(const AABB& aabb) const {
+    FCL_REAL d = query->getAABB().distance(aabb);
+    // The narrowphase returns a negative distance for geometries in collision.
+    if (exact && d <= 0) return -std::numeric_limits<FCL_REAL>::infinity();
+    return d;
+  }
+
+  /// @brief queue a set of objects
+  void pushNode(const Node& node, FCL_REAL bound) {
+    queue.push(Candidate(bound, node, nullptr));
+  }
+
+  /// @brief queue an object, unless it is the query object or it cannot
+  /// collide with it
+  void pushObject(CollisionObject* obj, FCL_REAL bound) {
+    if (obj == query || !obj->canCollideWith(*query)) return;
+    queue.push(Candidate(bound, Node(), obj));
+  }
+
+  /// @brief lowest bound of the queued candidates, infinity if there is none
+  FCL_REAL nextBound() const {
+    if (queue.empty()) return std::numeric_limits<FCL_REAL>::infinity();
+    return queue.top().bound;
+  }
+
+  /// @brief run the search until k objects are found or the lower bound of
+  /// the remaining candidates exceeds max_distance
+  /// @param expand functor called as expand(node, *this) which queues the
+  /// candidates contained in a node
+  template <typename Expand>
+  void run(FCL_REAL max_distance, size_t k,
+           std::vector<NeighborResult>& results, Expand expand) {
+    const DistanceRequest request;
+    DistanceResult result;
+    while (!queue.empty() && results.size() < k) {
+      Candidate candidate = queue.top();
+      if (candidate.bound > max_distance) break;
+      queue.pop();
+
+      if (candidate.obj == nullptr)
+        expand(candidate.node, *this);
+      else if (exact && !candidate.refined) {
+        result.clear();
+        candidate.bound = distance(query, candidate.obj, request, result);
+        candidate.refined = true;
+        queue.push(candidate);
+      } else
+        results.push_back(NeighborResult(candidate.obj, candidate.bound));
+    }
+  }
+
+ protected:
+  struct Candidate {
+    Candidate(FCL_REAL bound, const Node& node, CollisionObject* obj)
+        : bound(bound), node(node), obj(obj), refined(false) {}
+
+    /// @brief lower bound of the distance to the query object
+    FCL_REAL bound;
+
+    Node node;
+
+    /// @brief object, null if the candidate is a node
+    CollisionObject* obj;
+
+    /// @brief whether bound is the distance given by the narrowphase
+    bool refined;
+
+    bool operator>(const Candidate& other) const {
+      return bound > other.bound;
+    }
+  };
+
+  const CollisionObject* query;
+  bool exact;
+
+  std::priority_queue<Candidate, std::vector<Candidate>,
+                      std::greater<Candidate> >
+      queue;
+};
+
+}  // namespace detail
+}  // namespace fcl
+}  // namespace hpp
+
+#endif
@@ -68,6 +68,8 @@ NodeBase<BV>::NodeBase() {
   parent = nullptr;
   children[0] = nullptr;
   children[1] = nullptr;
+  collision_group = 0xFFFFFFFF;
+  collision_mask = 0xFFFFFFFF;
 }
 
 }  // namespace detail
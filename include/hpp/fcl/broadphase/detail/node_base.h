@@ -69,6 +69,15 @@ struct NodeBase {
   /// @brief morton code for current BV
   uint32_t code;
 
+  /// @brief union of the collision groups of the objects in the subtree.
+  /// The managers which use it to prune the traversal set it in the leaves.
+  /// Inserting leaves and balancing incrementally keep the internal nodes
+  /// a superset of the union. All the bits are set otherwise.
+  uint32_t collision_group;
+
+  /// @brief union of the collision masks of the objects in the subtree
+  uint32_t collision_mask;
+
   NodeBase();
 };
 
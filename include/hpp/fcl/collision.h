@@ -93,6 +93,36 @@ inline std::size_t collide(const CollisionGeometry* o1, const Transform3f& tf1,
   return res;
 }
 
+/// @brief Collision test of two geometries for a batch of n placements.
+/// @sa ComputeCollision::operator()(const Transform3f*, const Transform3f*,
+/// std::size_t, const CollisionRequest&, CollisionResult*, int) const
+HPP_FCL_DLLAPI std::size_t collide(const CollisionGeometry* o1,
+                                   const Transform3f* tf1,
+                                   const CollisionGeometry* o2,
+                                   const Transform3f* tf2, std::size_t n,
+                                   const CollisionRequest& request,
+                                   CollisionResult* results,
+                                   int num_threads = 1);
+
+/// @brief Collision test of a mesh with itself.
+///
+/// The bounding volume hierarchy of the mesh is traversed against itself.
+/// Pairs of triangles sharing a vertex index are not tested, so vertices
+/// duplicated in the mesh make their triangles non-adjacent. The contacts
+/// are expressed in the world frame, with o1 and o2 both pointing to the
+/// mesh and b1, b2 the indices of the triangles.
+///
+/// For a deformable mesh, move the vertices between
+/// BVHModel::beginUpdateModel and BVHModel::endUpdateModel, which refits the
+/// hierarchy, before each query.
+/// @param model a mesh of type BVH_MODEL_TRIANGLES,
+/// @param tf the placement of the mesh.
+/// @return the number of contacts.
+HPP_FCL_DLLAPI std::size_t selfCollide(const BVHModelBase* model,
+                                       const Transform3f& tf,
+                                       const CollisionRequest& request,
+                                       CollisionResult& result);
+
 /// @brief This class reduces the cost of identifying the geometry pair.
 /// This is mostly useful for repeated shape-shape queries.
 ///
@@ -100,6 +130,9 @@ inline std::size_t collide(const CollisionGeometry* o1, const Transform3f& tf1,
 ///   ComputeCollision calc_collision (o1, o2);
 ///   std::size_t ncontacts = calc_collision(tf1, tf2, request, result);
 /// \endcode
+///
+/// The const methods can be called concurrently from several threads: the
+/// solver used by a query is local to the call or provided by the caller.
 class HPP_FCL_DLLAPI ComputeCollision {
  public:
   /// @brief Default constructor from two Collision Geometries.
@@ -109,6 +142,26 @@ class HPP_FCL_DLLAPI ComputeCollision {
                          const CollisionRequest& request,
                          CollisionResult& result) const;
 
+  /// @brief Run the query with a solver provided by the caller, which is
+  /// reconfigured from the request. This avoids building a solver for each
+  /// query, e.g. when each thread owns a solver.
+  std::size_t operator()(const Transform3f& tf1, const Transform3f& tf2,
+                         const CollisionRequest& request,
+                         CollisionResult& result, GJKSolver& solver) const;
+
+  /// @brief Run the query, reusing the outcome of the previous query between
+  /// the two geometries stored in \c cache, which is then updated.
+  /// See PairCache.
+  std::size_t operator()(const Transform3f& tf1, const Transform3f& tf2,
+                         const CollisionRequest& request,
+                         CollisionResult& result, PairCache& cache) const;
+
+  /// @brief Run the query with a cache and a solver provided by the caller.
+  std::size_t operator()(const Transform3f& tf1, const Transform3f& tf2,
+                         const CollisionRequest& request,
+                         CollisionResult& result, PairCache& cache,
+                         GJKSolver& solver) const;
+
   inline std::size_t operator()(const Transform3f& tf1, const Transform3f& tf2,
                                 CollisionRequest& request,
                                 CollisionResult& result) const {
@@ -118,8 +171,30 @@ class HPP_FCL_DLLAPI ComputeCollision {
     return res;
   }
 
+  /// @brief Collision test of the two geometries for a batch of n placements.
+  ///
+  /// The query i is run between o1 placed at tf1[i] and o2 placed at tf2[i],
+  /// and results[i] is cleared and filled with its result. When the GJK
+  /// initial guess of the request is GJKInitialGuess::CachedGuess, each query
+  /// is warm-started with the guess of the previous one, which pays off when
+  /// the placements follow each other, e.g. along a path.
+  ///
+  /// When the library is built with OpenMP, the batch is split into
+  /// contiguous chunks processed by num_threads threads, each with its own GJK
+  /// solver. Otherwise, the batch is processed sequentially.
+  ///
+  /// @param tf1, tf2 arrays of n placements of o1 and o2
+  /// @param results preallocated array of n results
+  /// @param num_threads number of threads, 0 for the default number of
+  ///        threads of OpenMP
+  /// @return the number of queries in collision
+  std::size_t operator()(const Transform3f* tf1, const Transform3f* tf2,
+                         std::size_t n, const CollisionRequest& request,
+                         CollisionResult* results, int num_threads = 1) const;
+
   bool operator==(const ComputeCollision& other) const {
-    return o1 == other.o1 && o2 == other.o2 && solver == other.solver;
+    return o1 == other.o1 && o2 == other.o2 && swap_geoms == other.swap_geoms &&
+           func == other.func;
   }
 
   bool operator!=(const ComputeCollision& other) const {
@@ -136,14 +211,16 @@ class HPP_FCL_DLLAPI ComputeCollision {
   mutable const CollisionGeometry* o1;
   mutable const CollisionGeometry* o2;
 
-  mutable GJKSolver solver;
-
   CollisionFunctionMatrix::CollisionFunc func;
   bool swap_geoms;
 
+  /// @brief Run the query with the given solver, already configured from the
+  /// request. Every operator goes through it, so that the derived classes
+  /// only override this method.
   virtual std::size_t run(const Transform3f& tf1, const Transform3f& tf2,
                           const CollisionRequest& request,
-                          CollisionResult& result) const;
+                          CollisionResult& result,
+                          const GJKSolver* solver) const;
 
  public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
@@ -38,14 +38,17 @@
 #ifndef HPP_FCL_COLLISION_DATA_H
 #define HPP_FCL_COLLISION_DATA_H
 
+#include <algorithm>
 #include <vector>
 #include <set>
 #include <limits>
+#include <utility>
 
 #include <hpp/fcl/collision_object.h>
 #include <hpp/fcl/config.hh>
 #include <hpp/fcl/data_types.h>
 #include <hpp/fcl/timings.h>
+#include <hpp/fcl/profiling.h>
 
 namespace hpp {
 namespace fcl {
@@ -161,7 +164,7 @@ struct HPP_FCL_DLLAPI QueryRequest {
         gjk_variant(GJKVariant::DefaultGJK),
         gjk_convergence_criterion(GJKConvergenceCriterion::VDB),
         gjk_convergence_criterion_type(GJKConvergenceCriterionType::Relative),
-        gjk_tolerance(1e-6),
+        gjk_tolerance(GJK_DEFAULT_TOLERANCE),
         gjk_max_iterations(128),
         cached_gjk_guess(1, 0, 0),
         cached_support_func_guess(support_func_guess_t::Zero()),
@@ -202,6 +205,10 @@ struct HPP_FCL_DLLAPI QueryResult {
   /// @brief timings for the given request
   CPUTimes timings;
 
+  /// @brief counters of the operations performed by the query, filled when
+  /// the library is built with HPP_FCL_ENABLE_PROFILING.
+  QueryProfile profile;
+
   QueryResult()
       : cached_gjk_guess(Vec3f::Zero()),
         cached_support_func_guess(support_func_guess_t::Constant(-1)) {}
@@ -262,6 +269,12 @@ struct HPP_FCL_DLLAPI CollisionRequest : QueryRequest {
   /// to save computational resources.
   FCL_REAL distance_upper_bound;
 
+  /// @brief Whether shapes in contact along a face or an edge return up to 4
+  /// contact points, within num_max_contacts, instead of a single one.
+  /// Only used when enable_contact is true.
+  /// See details::computeContactManifold for the supported shapes.
+  bool enable_contact_manifold;
+
   /// @brief Constructor from a flag and a maximal number of contacts.
   ///
   /// @param[in] flag Collision request flag
@@ -273,7 +286,8 @@ struct HPP_FCL_DLLAPI CollisionRequest : QueryRequest {
         enable_distance_lower_bound(flag & DISTANCE_LOWER_BOUND),
         security_margin(0),
         break_distance(1e-3),
-        distance_upper_bound((std::numeric_limits<FCL_REAL>::max)()) {}
+        distance_upper_bound((std::numeric_limits<FCL_REAL>::max)()),
+        enable_contact_manifold(false) {}
 
   /// @brief Default constructor.
   CollisionRequest()
@@ -282,7 +296,8 @@ struct HPP_FCL_DLLAPI CollisionRequest : QueryRequest {
         enable_distance_lower_bound(false),
         security_margin(0),
         break_distance(1e-3),
-        distance_upper_bound((std::numeric_limits<FCL_REAL>::max)()) {}
+        distance_upper_bound((std::numeric_limits<FCL_REAL>::max)()),
+        enable_contact_manifold(false) {}
 
   bool isSatisfied(const CollisionResult& result) const;
 
@@ -294,16 +309,31 @@ struct HPP_FCL_DLLAPI CollisionRequest : QueryRequest {
            enable_distance_lower_bound == other.enable_distance_lower_bound &&
            security_margin == other.security_margin &&
            break_distance == other.break_distance &&
-           distance_upper_bound == other.distance_upper_bound;
+           distance_upper_bound == other.distance_upper_bound &&
+           enable_contact_manifold == other.enable_contact_manifold;
   }
 };
 
 /// @brief collision result
 struct HPP_FCL_DLLAPI CollisionResult : QueryResult {
  private:
-  /// @brief contact information
+  /// @brief contact information, when no contact buffer is set
   std::vector<Contact> contacts;
 
+  /// @brief caller-owned storage of the contacts, if any
+  std::vector<Contact>* contact_buffer;
+
+  /// @brief maximal number of contacts stored in contact_buffer
+  size_t contact_buffer_capacity;
+
+  std::vector<Contact>& contactStorage() {
+    return contact_buffer ? *contact_buffer : contacts;
+  }
+
+  const std::vector<Contact>& contactStorage() const {
+    return contact_buffer ? *contact_buffer : contacts;
+  }
+
  public:
   /// Lower bound on distance between objects if they are disjoint.
   /// See \ref hpp_fcl_collision_and_distance_lower_bound_computation
@@ -318,7 +348,113 @@ struct HPP_FCL_DLLAPI CollisionResult : QueryResult {
 
  public:
   CollisionResult()
-      : distance_lower_bound((std::numeric_limits<FCL_REAL>::max)()) {}
+      : contact_buffer(NULL),
+        contact_buffer_capacity(0),
+        distance_lower_bound((std::numeric_limits<FCL_REAL>::max)()) {}
+
+  /// @brief copy constructor. The copy stores its contacts in its own
+  /// storage, even if other uses a contact buffer.
+  CollisionResult(const CollisionResult& other)
+      : QueryResult(other),
+        contacts(other.contactStorage()),
+        contact_buffer(NULL),
+        contact_buffer_capacity(0),
+        distance_lower_bound(other.distance_lower_bound) {
+    nearest_points[0] = other.nearest_points[0];
+    nearest_points[1] = other.nearest_points[1];
+  }
+
+  /// @brief move constructor. The result takes over the storage of other,
+  /// including its contact buffer, and other is left without contacts nor
+  /// contact buffer.
+  CollisionResult(CollisionResult&& other) noexcept
+      : QueryResult(other),
+        contacts(std::move(other.contacts)),
+        contact_buffer(other.contact_buffer),
+        contact_buffer_capacity(other.contact_buffer_capacity),
+        distance_lower_bound(other.distance_lower_bound) {
+    nearest_points[0] = other.nearest_points[0];
+    nearest_points[1] = other.nearest_points[1];
+    other.contacts.clear();
+    other.contact_buffer = NULL;
+    other.contact_buffer_capacity = 0;
+  }
+
+  /// @brief copy the contacts and the distance information of other. If a
+  /// contact buffer is set, it is kept and grown to hold all the contacts of
+  /// other.
+  CollisionResult& operator=(const CollisionResult& other) {
+    if (this == &other) return *this;
+    QueryResult::operator=(other);
+    const std::vector<Contact>& other_contacts = other.contactStorage();
+    if (contact_buffer) {
+      contact_buffer_capacity =
+          (std::max)(contact_buffer_capacity, other_contacts.size());
+      contact_buffer->reserve(contact_buffer_capacity);
+    }
+    contactStorage().assign(other_contacts.begin(), other_contacts.end());
+    distance_lower_bound = other.distance_lower_bound;
+    nearest_points[0] = other.nearest_points[0];
+    nearest_points[1] = other.nearest_points[1];
+    return *this;
+  }
+
+  /// @brief move the contacts and the distance information of other. If a
+  /// contact buffer is set, it is kept and the contacts are copied into it as
+  /// by the copy assignment. Otherwise, the contacts of other are moved when
+  /// it does not use a contact buffer.
+  CollisionResult& operator=(CollisionResult&& other) {
+    if (this == &other) return *this;
+    if (contact_buffer || other.contact_buffer) return *this = other;
+    QueryResult::operator=(other);
+    contacts = std::move(other.contacts);
+    other.contacts.clear();
+    distance_lower_bound = other.distance_lower_bound;
+    nearest_points[0] = other.nearest_points[0];
+    nearest_points[1] = other.nearest_points[1];
+    return *this;
+  }
+
+  /// @brief store the contacts in a caller-owned buffer.
+  ///
+  /// The buffer is cleared and reserved once for capacity contacts, so that
+  /// storing contacts never allocates memory afterwards. The buffer must
+  /// outlive this result, or be released with resetContactBuffer(), and must
+  /// not be modified by the caller while it is set. Once capacity contacts
+  /// are stored, addContact drops the new ones: collide() thus rejects a
+  /// request whose num_max_contacts exceeds capacity.
+  /// Assigning a result with more contacts grows the buffer and its capacity.
+  void setContactBuffer(std::vector<Contact>& buffer, size_t capacity) {
+    if (capacity == 0)
+      HPP_FCL_THROW_PRETTY("The capacity of the contact buffer must be > 0.",
+                           std::invalid_argument);
+    buffer.clear();
+    buffer.reserve(capacity);
+    buffer.insert(buffer.end(), contactStorage().begin(),
+                  contactStorage().begin() +
+                      (std::min)(contactStorage().size(), capacity));
+    contacts.clear();
+    contact_buffer = &buffer;
+    contact_buffer_capacity = capacity;
+  }
+
+  /// @brief store the contacts in the internal storage of the result again.
+  /// The contacts stored so far are copied from the contact buffer.
+  void resetContactBuffer() {
+    if (!contact_buffer) return;
+    contacts = *contact_buffer;
+    contact_buffer = NULL;
+    contact_buffer_capacity = 0;
+  }
+
+  /// @brief whether the contacts are stored in a caller-owned buffer
+  bool hasContactBuffer() const { return contact_buffer != NULL; }
+
+  /// @brief maximal number of contacts that can be stored
+  size_t contactCapacity() const {
+    return contact_buffer ? contact_buffer_capacity
+                          : (std::numeric_limits<size_t>::max)();
+  }
 
   /// @brief Update the lower bound only if the distance is inferior.
   inline void updateDistanceLowerBound(const FCL_REAL& distance_lower_bound_) {
@@ -327,58 +463,67 @@ struct HPP_FCL_DLLAPI CollisionResult : QueryResult {
   }
 
   /// @brief add one contact into result structure
-  inline void addContact(const Contact& c) { contacts.push_back(c); }
+  /// When a contact buffer is set and full, the contact is dropped.
+  inline void addContact(const Contact& c) {
+    std::vector<Contact>& storage = contactStorage();
+    if (contact_buffer && storage.size() >= contact_buffer_capacity) return;
+    storage.push_back(c);
+  }
 
   /// @brief whether two CollisionResult are the same or not
   inline bool operator==(const CollisionResult& other) const {
-    return contacts == other.contacts &&
+    return contactStorage() == other.contactStorage() &&
            distance_lower_bound == other.distance_lower_bound;
   }
 
   /// @brief return binary collision result
-  bool isCollision() const { return contacts.size() > 0; }
+  bool isCollision() const { return contactStorage().size() > 0; }
 
   /// @brief number of contacts found
-  size_t numContacts() const { return contacts.size(); }
+  size_t numContacts() const { return contactStorage().size(); }
 
   /// @brief get the i-th contact calculated
   const Contact& getContact(size_t i) const {
-    if (contacts.size() == 0)
+    const std::vector<Contact>& storage = contactStorage();
+    if (storage.size() == 0)
       throw std::invalid_argument(
           "The number of contacts is zero. No Contact can be returned.");
 
-    if (i < contacts.size())
-      return contacts[i];
+    if (i < storage.size())
+      return storage[i];
     else
-      return contacts.back();
+      return storage.back();
   }
 
   /// @brief set the i-th contact calculated
   void setContact(size_t i, const Contact& c) {
-    if (contacts.size() == 0)
+    std::vector<Contact>& storage = contactStorage();
+    if (storage.size() == 0)
       throw std::invalid_argument(
           "The number of contacts is zero. No Contact can be returned.");
 
-    if (i < contacts.size())
-      contacts[i] = c;
+    if (i < storage.size())
+      storage[i] = c;
     else
-      contacts.back() = c;
+      storage.back() = c;
   }
 
   /// @brief get all the contacts
   void getContacts(std::vector<Contact>& contacts_) const {
-    contacts_.resize(contacts.size());
-    std::copy(contacts.begin(), contacts.end(), contacts_.begin());
+    const std::vector<Contact>& storage = contactStorage();
+    contacts_.resize(storage.size());
+    std::copy(storage.begin(), storage.end(), contacts_.begin());
   }
 
-  const std::vector<Contact>& getContacts() const { return contacts; }
+  const std::vector<Contact>& getContacts() const { return contactStorage(); }
 
   /// @brief clear the results obtained
   void clear() {
     distance_lower_bound = (std::numeric_limits<FCL_REAL>::max)();
-    contacts.clear();
+    contactStorage().clear();
     distance_lower_bound = (std::numeric_limits<FCL_REAL>::max)();
     timings.clear();
+    profile.clear();
   }
 
   /// @brief reposition Contact objects when fcl inverts them
@@ -393,6 +538,10 @@ struct HPP_FCL_DLLAPI DistanceRequest : QueryRequest {
   /// @brief whether to return the nearest points
   bool enable_nearest_points;
 
+  /// @brief whether to return the gradients of the distance with respect to
+  /// the placements of the objects, see DistanceResult::gradients.
+  bool enable_gradients;
+
   /// @brief error threshold for approximate distance
   FCL_REAL rel_err;  // relative error, between 0 and 1
   FCL_REAL abs_err;  // absolute error
@@ -403,6 +552,7 @@ struct HPP_FCL_DLLAPI DistanceRequest : QueryRequest {
   DistanceRequest(bool enable_nearest_points_ = false, FCL_REAL rel_err_ = 0.0,
                   FCL_REAL abs_err_ = 0.0)
       : enable_nearest_points(enable_nearest_points_),
+        enable_gradients(false),
         rel_err(rel_err_),
         abs_err(abs_err_) {}
 
@@ -412,6 +562,7 @@ struct HPP_FCL_DLLAPI DistanceRequest : QueryRequest {
   inline bool operator==(const DistanceRequest& other) const {
     return QueryRequest::operator==(other) &&
            enable_nearest_points == other.enable_nearest_points &&
+           enable_gradients == other.enable_gradients &&
            rel_err == other.rel_err && abs_err == other.abs_err;
   }
 };
@@ -429,6 +580,23 @@ struct HPP_FCL_DLLAPI DistanceResult : QueryResult {
   /// In case both objects are in collision, store the normal
   Vec3f normal;
 
+  /// @brief gradients of min_distance with respect to the placements of
+  /// object 1 and object 2, computed when DistanceRequest::enable_gradients
+  /// is set.
+  ///
+  /// The placement \f$ M \f$ of an object is perturbed by a twist
+  /// \f$ \xi = (v, \omega) \f$ expressed in the frame of the object, as
+  /// \f$ M \exp(\xi) \f$. The first three components of a gradient are the
+  /// derivatives with respect to the linear velocity \f$ v \f$, the last
+  /// three with respect to the angular velocity \f$ \omega \f$.
+  ///
+  /// The witness points are considered fixed on the objects, which gives the
+  /// exact gradient when they are unique. When they are not, e.g. between
+  /// parallel faces, it is one of the directional derivatives. The gradients
+  /// are NaN when the direction between the objects is unknown, e.g. between
+  /// intersecting meshes.
+  Vec6f gradients[2];
+
   /// @brief collision object 1
   const CollisionGeometry* o1;
 
@@ -456,6 +624,8 @@ struct HPP_FCL_DLLAPI DistanceResult : QueryResult {
     const Vec3f nan(
         Vec3f::Constant(std::numeric_limits<FCL_REAL>::quiet_NaN()));
     nearest_points[0] = nearest_points[1] = normal = nan;
+    gradients[0] = gradients[1] =
+        Vec6f::Constant(std::numeric_limits<FCL_REAL>::quiet_NaN());
   }
 
   /// @brief add distance information into the result
@@ -497,9 +667,18 @@ struct HPP_FCL_DLLAPI DistanceResult : QueryResult {
       nearest_points[0] = other_result.nearest_points[0];
       nearest_points[1] = other_result.nearest_points[1];
       normal = other_result.normal;
+      gradients[0] = other_result.gradients[0];
+      gradients[1] = other_result.gradients[1];
     }
   }
 
+  /// @brief compute the gradients of min_distance from the nearest points
+  /// and the normal, for the objects placed at tf1 and tf2.
+  ///
+  /// The direction from object 1 to object 2 is given by the nearest points
+  /// when they differ, by the normal otherwise.
+  void computeGradients(const Transform3f& tf1, const Transform3f& tf2);
+
   /// @brief clear the result
   void clear() {
     const Vec3f nan(
@@ -510,7 +689,10 @@ struct HPP_FCL_DLLAPI DistanceResult : QueryResult {
     b1 = NONE;
     b2 = NONE;
     nearest_points[0] = nearest_points[1] = normal = nan;
+    gradients[0] = gradients[1] =
+        Vec6f::Constant(std::numeric_limits<FCL_REAL>::quiet_NaN());
     timings.clear();
+    profile.clear();
   }
 
   /// @brief whether two DistanceResult are the same or not
@@ -534,6 +716,81 @@ struct HPP_FCL_DLLAPI DistanceResult : QueryResult {
   }
 };
 
+/// @brief Outcome of the last query between a pair of geometries, kept from
+/// one query to the next to exploit temporal coherence.
+///
+/// The cache is given to ComputeCollision or ComputeDistance, which update it
+/// after each query. GJK is then warm started from the last separating axis.
+/// When the relative motion of the geometries since the last query is small
+/// compared to their last separation, the narrow phase is skipped:
+/// - a collision query reports no collision when the cached distance lower
+///   bound, minus the motion, stays above the security margin,
+/// - a distance query returns the distance between the last witness points,
+///   moved along with the geometries, when the cached distance minus the
+///   motion proves it accurate up to DistanceRequest::abs_err or
+///   DistanceRequest::rel_err. Otherwise, this distance bounds the BVH
+///   traversal.
+///
+/// The motion is bounded using the local AABB of the geometries, which must
+/// have been computed (see CollisionGeometry::computeLocalAABB). Otherwise,
+/// queries are only warm started.
+///
+/// A cache must only be used with one pair of geometries, and by one thread
+/// at a time. It must be cleared when a geometry is modified.
+struct HPP_FCL_DLLAPI PairCache {
+  /// @brief whether the cache holds the outcome of a previous query
+  bool valid;
+
+  /// @brief placement of the second geometry in the frame of the first one at
+  /// the last query
+  Transform3f relative_pose;
+
+  /// @brief lower bound on the distance between the geometries at the last
+  /// query, -infinity when unknown.
+  FCL_REAL distance_lower_bound;
+
+  /// @brief last separating axis found by GJK
+  Vec3f separating_axis;
+
+  /// @brief last support function vertex indices
+  support_func_guess_t support_func_guess;
+
+  /// @brief closest points of the last distance query, expressed in the
+  /// frame of their geometry. NaN when unknown.
+  Vec3f witness_points[2];
+
+  /// @brief closest primitives of the last distance query, as reported by
+  /// DistanceResult::b1 and DistanceResult::b2.
+  int b1, b2;
+
+  /// @brief number of queries answered without running the narrow phase
+  std::size_t num_skipped_queries;
+
+  PairCache() { clear(); }
+
+  /// @brief forget the last query
+  void clear() {
+    valid = false;
+    relative_pose.setIdentity();
+    distance_lower_bound = -std::numeric_limits<FCL_REAL>::infinity();
+    separating_axis = Vec3f(1, 0, 0);
+    support_func_guess.setZero();
+    witness_points[0] = witness_points[1] =
+        Vec3f::Constant(std::numeric_limits<FCL_REAL>::quiet_NaN());
+    b1 = b2 = DistanceResult::NONE;
+    num_skipped_queries = 0;
+  }
+
+  /// @brief Upper bound on the displacement of the points of a geometry
+  /// relative to the other one, between the cached relative placement and a
+  /// new one.
+  ///
+  /// @return infinity if the local AABB of both geometries is unknown.
+  FCL_REAL motionBound(const CollisionGeometry* o1,
+                       const CollisionGeometry* o2,
+                       const Transform3f& new_relative_pose) const;
+};
+
 namespace internal {
 inline void updateDistanceLowerBoundFromBV(const CollisionRequest& /*req*/,
                                            CollisionResult& res,
@@ -38,8 +38,10 @@
 #ifndef HPP_FCL_COLLISION_OBJECT_BASE_H
 #define HPP_FCL_COLLISION_OBJECT_BASE_H
 
+#include <cstdint>
 #include <limits>
 #include <typeinfo>
+#include <vector>
 
 #include <hpp/fcl/deprecated.hh>
 #include <hpp/fcl/fwd.hh>
@@ -49,6 +51,27 @@
 namespace hpp {
 namespace fcl {
 
+/// @brief bit field of collision groups used to filter the pairs of objects
+/// tested by the broadphase managers.
+typedef uint32_t CollisionGroup;
+
+/// @brief collision group of an object by default
+static const CollisionGroup DEFAULT_COLLISION_GROUP = 1;
+
+/// @brief collision mask of an object by default: it collides with all the
+/// groups
+static const CollisionGroup ALL_COLLISION_GROUPS = 0xFFFFFFFF;
+
+/// @brief whether two sets of objects, described by the union of their
+/// collision groups and the union of their collision masks, may contain a pair
+/// of objects allowed to collide. Each group must intersect the mask of the
+/// other.
+inline bool collisionFiltersMatch(CollisionGroup group1, CollisionGroup mask1,
+                                  CollisionGroup group2,
+                                  CollisionGroup mask2) {
+  return (group1 & mask2) && (group2 & mask1);
+}
+
 /// @brief object type: BVH (mesh, points), basic geometry, octree
 enum OBJECT_TYPE {
   OT_UNKNOWN,
@@ -56,12 +79,15 @@ enum OBJECT_TYPE {
   OT_GEOM,
   OT_OCTREE,
   OT_HFIELD,
+  OT_SDF,
+  OT_COMPOUND,
   OT_COUNT
 };
 
 /// @brief traversal node type: bounding volume (AABB, OBB, RSS, kIOS, OBBRSS,
 /// KDOP16, KDOP18, kDOP24), basic shape (box, sphere, ellipsoid, capsule, cone,
-/// cylinder, convex, plane, triangle), and octree
+/// cylinder, convex, plane, triangle), octree, height field, signed distance
+/// field and compound
 enum NODE_TYPE {
   BV_UNKNOWN,
   BV_AABB,
@@ -85,6 +111,8 @@ enum NODE_TYPE {
   GEOM_ELLIPSOID,
   HF_AABB,
   HF_OBBRSS,
+  GEOM_SDF,
+  GEOM_COMPOUND,
   NODE_COUNT
 };
 
@@ -216,25 +244,39 @@ class HPP_FCL_DLLAPI CollisionObject {
  public:
   CollisionObject(const shared_ptr<CollisionGeometry>& cgeom_,
                   bool compute_local_aabb = true)
-      : cgeom(cgeom_), user_data(nullptr) {
+      : cgeom(cgeom_),
+        user_data(nullptr),
+        collision_group(DEFAULT_COLLISION_GROUP),
+        collision_mask(ALL_COLLISION_GROUPS) {
     init(compute_local_aabb);
   }
 
   CollisionObject(const shared_ptr<CollisionGeometry>& cgeom_,
                   const Transform3f& tf, bool compute_local_aabb = true)
-      : cgeom(cgeom_), t(tf), user_data(nullptr) {
+      : cgeom(cgeom_),
+        t(tf),
+        user_data(nullptr),
+        collision_group(DEFAULT_COLLISION_GROUP),
+        collision_mask(ALL_COLLISION_GROUPS) {
     init(compute_local_aabb);
   }
 
   CollisionObject(const shared_ptr<CollisionGeometry>& cgeom_,
                   const Matrix3f& R, const Vec3f& T,
                   bool compute_local_aabb = true)
-      : cgeom(cgeom_), t(R, T), user_data(nullptr) {
+      : cgeom(cgeom_),
+        t(R, T),
+        user_data(nullptr),
+        collision_group(DEFAULT_COLLISION_GROUP),
+        collision_mask(ALL_COLLISION_GROUPS) {
     init(compute_local_aabb);
   }
 
   bool operator==(const CollisionObject& other) const {
-    return cgeom == other.cgeom && t == other.t && user_data == other.user_data;
+    return cgeom == other.cgeom && t == other.t &&
+           user_data == other.user_data &&
+           collision_group == other.collision_group &&
+           collision_mask == other.collision_mask;
   }
 
   bool operator!=(const CollisionObject& other) const {
@@ -255,15 +297,26 @@ class HPP_FCL_DLLAPI CollisionObject {
   /// @brief get the AABB in world space
   AABB& getAABB() { return aabb; }
 
-  /// @brief compute the AABB in world space
+  /// @brief compute the AABB in world space.
+  ///
+  /// For a rotated object, the AABB bounds the rotated local AABB, whose
+  /// half extents are |R| times the local half extents. It is intersected with
+  /// the bounding sphere of the geometry, which is tighter for some meshes.
   void computeAABB() {
-    if (t.getRotation().isIdentity()) {
+    const Matrix3f& R = t.getRotation();
+    if (R.isIdentity()) {
       aabb = translate(cgeom->aabb_local, t.getTranslation());
     } else {
-      Vec3f center(t.transform(cgeom->aabb_center));
-      Vec3f delta(Vec3f::Constant(cgeom->aabb_radius));
+      const AABB& aabb_local = cgeom->aabb_local;
+      Vec3f center(t.transform(aabb_local.center()));
+      Vec3f delta(R.cwiseAbs() * ((aabb_local.max_ - aabb_local.min_) / 2));
       aabb.min_ = center - delta;
       aabb.max_ = center + delta;
+
+      Vec3f sphere_center(t.transform(cgeom->aabb_center));
+      Vec3f radius(Vec3f::Constant(cgeom->aabb_radius));
+      aabb.min_ = aabb.min_.cwiseMax(sphere_center - radius);
+      aabb.max_ = aabb.max_.cwiseMin(sphere_center + radius);
     }
   }
 
@@ -273,6 +326,27 @@ class HPP_FCL_DLLAPI CollisionObject {
   /// @brief set user data in object
   void setUserData(void* data) { user_data = data; }
 
+  /// @brief get the collision groups the object belongs to
+  CollisionGroup getCollisionGroup() const { return collision_group; }
+
+  /// @brief set the collision groups the object belongs to
+  /// @note The broadphase managers must be updated afterwards.
+  void setCollisionGroup(CollisionGroup group) { collision_group = group; }
+
+  /// @brief get the collision groups the object may collide with
+  CollisionGroup getCollisionMask() const { return collision_mask; }
+
+  /// @brief set the collision groups the object may collide with
+  /// @note The broadphase managers must be updated afterwards.
+  void setCollisionMask(CollisionGroup mask) { collision_mask = mask; }
+
+  /// @brief whether the collision filters of two objects allow them to
+  /// collide. Broadphase managers never report pairs which cannot collide.
+  bool canCollideWith(const CollisionObject& other) const {
+    return collisionFiltersMatch(collision_group, collision_mask,
+                                 other.collision_group, other.collision_mask);
+  }
+
   /// @brief get translation of the object
   inline const Vec3f& getTranslation() const { return t.getTranslation(); }
 
@@ -340,8 +414,23 @@ class HPP_FCL_DLLAPI CollisionObject {
 
   /// @brief pointer to user defined data specific to this object
   void* user_data;
+
+  /// @brief bit field of the collision groups the object belongs to
+  CollisionGroup collision_group;
+
+  /// @brief bit field of the collision groups the object may collide with
+  CollisionGroup collision_mask;
 };
 
+/// @brief compute the world space AABB of a set of collision objects, as
+/// CollisionObject::computeAABB does.
+///
+/// When the library is built with OpenMP, large sets are processed in
+/// parallel. The broadphase managers use the AABBs cached in the objects:
+/// this is meant to be called before registerObjects or update, after moving
+/// many objects.
+HPP_FCL_DLLAPI void computeAABBs(const std::vector<CollisionObject*>& objects);
+
 }  // namespace fcl
 
 }  // namespace hpp
@@ -37,7 +37,8 @@ inline const char* get_node_type_name(NODE_TYPE node_type) {
       "BV_KDOP24",      "GEOM_BOX",      "GEOM_SPHERE", "GEOM_CAPSULE",
       "GEOM_CONE",      "GEOM_CYLINDER", "GEOM_CONVEX", "GEOM_PLANE",
       "GEOM_HALFSPACE", "GEOM_TRIANGLE", "GEOM_OCTREE", "GEOM_ELLIPSOID",
-      "HF_AABB",        "HF_OBBRSS",     "NODE_COUNT"};
+      "HF_AABB",        "HF_OBBRSS",     "GEOM_SDF",    "GEOM_COMPOUND",
+      "NODE_COUNT"};
 
   return node_type_name_all[node_type];
 }
@@ -47,7 +48,8 @@ inline const char* get_node_type_name(NODE_TYPE node_type) {
  */
 inline const char* get_object_type_name(OBJECT_TYPE object_type) {
   static const char* object_type_name_all[] = {
-      "OT_UNKNOWN", "OT_BVH", "OT_GEOM", "OT_OCTREE", "OT_HFIELD", "OT_COUNT"};
+      "OT_UNKNOWN", "OT_BVH", "OT_GEOM",     "OT_OCTREE",
+      "OT_HFIELD",  "OT_SDF", "OT_COMPOUND", "OT_COUNT"};
 
   return object_type_name_all[object_type];
 }
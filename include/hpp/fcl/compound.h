@@ -0,0 +1,183 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HPP_FCL_COMPOUND_H
+#define HPP_FCL_COMPOUND_H
+
+#include <vector>
+
+#include <hpp/fcl/fwd.hh>
+#include <hpp/fcl/collision_object.h>
+#include <hpp/fcl/collision_data.h>
+
+namespace hpp {
+namespace fcl {
+
+class GJKSolver;
+
+/// @addtogroup Construction_Of_Compound
+/// @{
+
+/// @brief Rigid assembly of collision geometries, each one at a fixed
+/// placement in the frame of the compound.
+///
+/// The children are usually primitive shapes, so that the queries against
+/// them keep their analytic narrow phase, but they may be of any type,
+/// including compounds. An AABB hierarchy over the children, expressed in the
+/// frame of the compound, selects the children tested against the other
+/// object of a query.
+///
+/// In the contacts and in the distance result, the primitive index of the
+/// compound (b1 or b2) is the index of the child.
+class HPP_FCL_DLLAPI Compound : public CollisionGeometry {
+ public:
+  typedef CollisionGeometry Base;
+
+  /// @brief Node of the AABB hierarchy over the children.
+  struct HPP_FCL_DLLAPI Node {
+    /// @brief AABB of the node, in the frame of the compound
+    AABB aabb;
+    /// @brief Index of the child for a leaf, -1 otherwise
+    int child;
+    /// @brief Indices of the two sub-nodes, when the node is not a leaf
+    unsigned int left, right;
+
+    bool isLeaf() const { return child >= 0; }
+
+    bool operator==(const Node& other) const {
+      return aabb == other.aabb && child == other.child &&
+             left == other.left && right == other.right;
+    }
+  };
+
+  /// @brief Constructing an empty compound
+  Compound();
+
+  /// @brief Clone *this into a new Compound. The children are shared.
+  virtual Compound* clone() const { return new Compound(*this); }
+
+  /// @brief Add a child geometry at a placement in the frame of the compound
+  /// and update the hierarchy.
+  /// @return the index of the child
+  std::size_t addChild(const shared_ptr<CollisionGeometry>& geometry,
+                       const Transform3f& placement = Transform3f());
+
+  /// @brief Number of children
+  std::size_t getNumChildren() const { return children.size(); }
+
+  /// @brief Geometry of the i-th child
+  const shared_ptr<CollisionGeometry>& getChild(std::size_t i) const {
+    return children[i];
+  }
+
+  /// @brief Placement of the i-th child in the frame of the compound
+  const Transform3f& getChildPlacement(std::size_t i) const {
+    return placements[i];
+  }
+
+  /// @brief Move the i-th child and update the hierarchy
+  void setChildPlacement(std::size_t i, const Transform3f& placement);
+
+  /// @brief Compute the AABB of the compound in local coordinate and rebuild
+  /// the hierarchy. It must be called when the geometry of a child changes.
+  void computeLocalAABB();
+
+  /// @brief Get the object type: it is a compound
+  OBJECT_TYPE getObjectType() const { return OT_COMPOUND; }
+
+  /// @brief Get the node type
+  NODE_TYPE getNodeType() const { return GEOM_COMPOUND; }
+
+  /// @brief Nodes of the hierarchy, the root being the first one. It is empty
+  /// when the compound has no child.
+  const std::vector<Node>& getNodes() const { return nodes; }
+
+ protected:
+  /// @brief Build the sub-hierarchy over the children order[begin, end[
+  /// @return the index of its root in nodes
+  unsigned int buildHierarchy(std::vector<unsigned int>& order,
+                              std::size_t begin, std::size_t end);
+
+  std::vector<shared_ptr<CollisionGeometry> > children;
+  std::vector<Transform3f> placements;
+
+  /// @brief AABB of each child, in the frame of the compound
+  std::vector<AABB> child_aabbs;
+
+  std::vector<Node> nodes;
+
+ private:
+  virtual bool isEqual(const CollisionGeometry& _other) const;
+
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/// @}
+
+namespace details {
+
+/// @brief Collision between a compound and another geometry.
+///
+/// @param compound_first whether the compound is the first object of the
+///        query, to which the contacts refer as o1.
+/// @return the number of contacts of result
+HPP_FCL_DLLAPI std::size_t compoundCollide(
+    const Compound& compound, const Transform3f& tf_compound,
+    const CollisionGeometry* other, const Transform3f& tf_other,
+    bool compound_first, const GJKSolver* nsolver,
+    const CollisionRequest& request, CollisionResult& result);
+
+/// @brief Distance between a compound and another geometry.
+///
+/// @param compound_first whether the compound is the first object of the
+///        query, to which the result refers as o1.
+/// @return the distance found, which updates result if it is lower than
+///         result.min_distance.
+HPP_FCL_DLLAPI FCL_REAL compoundDistance(const Compound& compound,
+                                         const Transform3f& tf_compound,
+                                         const CollisionGeometry* other,
+                                         const Transform3f& tf_other,
+                                         bool compound_first,
+                                         const GJKSolver* nsolver,
+                                         const DistanceRequest& request,
+                                         DistanceResult& result);
+
+}  // namespace details
+
+}  // namespace fcl
+
+}  // namespace hpp
+
+#endif
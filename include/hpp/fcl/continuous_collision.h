@@ -0,0 +1,196 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HPP_FCL_CONTINUOUS_COLLISION_H
+#define HPP_FCL_CONTINUOUS_COLLISION_H
+
+#include <hpp/fcl/collision_object.h>
+
+namespace hpp {
+namespace fcl {
+
+/// @brief Interpolation between the initial and the final placements of a
+/// moving object
+enum CCDMotionType {
+  /// Linear interpolation of the translation and constant angular velocity
+  /// rotation (slerp)
+  CCDM_LINEAR,
+  /// Constant twist, i.e. rotation around and translation along a fixed axis
+  CCDM_SCREW
+};
+
+/// @brief Motion of an object between two placements, parameterized by the
+/// time in [0, 1].
+class HPP_FCL_DLLAPI Motion {
+ public:
+  Motion(const Transform3f& tf_beg, const Transform3f& tf_end,
+         CCDMotionType type = CCDM_LINEAR);
+
+  /// @brief Placement at time t in [0, 1]
+  Transform3f getTransform(FCL_REAL t) const;
+
+  /// @brief Upper bound of the speed of the points of a geometry moved by
+  /// the motion, over [0, 1].
+  ///
+  /// The bound is computed from the bounding sphere of the geometry, see
+  /// CollisionGeometry::computeLocalAABB.
+  FCL_REAL speedBound(const CollisionGeometry& geom) const;
+
+  /// @brief Upper bound of the distance between the points of a geometry
+  /// moved by the motion and the linear interpolation of their initial and
+  /// final positions, over [0, 1].
+  ///
+  /// The swept volume of the geometry is contained in the convex hull of its
+  /// initial and final placements, inflated by this distance.
+  FCL_REAL deviationBound(const CollisionGeometry& geom) const;
+
+  const Transform3f& getBeginTransform() const { return tf_beg; }
+
+  const Transform3f& getEndTransform() const { return tf_end; }
+
+  CCDMotionType getType() const { return type; }
+
+ private:
+  Transform3f tf_beg, tf_end;
+  CCDMotionType type;
+
+  /// Rotation from tf_beg to tf_end, expressed in the frame of tf_beg.
+  Vec3f axis;
+  FCL_REAL angle;
+
+  /// Linear velocity: in the world frame for CCDM_LINEAR, in the frame of
+  /// the moving object for CCDM_SCREW.
+  Vec3f linear_velocity;
+};
+
+/// @brief request to the continuous collision algorithm
+struct HPP_FCL_DLLAPI ContinuousCollisionRequest {
+  /// @brief Interpolation of the motion of the objects
+  CCDMotionType motion_type;
+
+  /// @brief Distance below which the objects are considered in contact. The
+  /// time of contact is returned when the distance between the objects
+  /// falls below this value.
+  FCL_REAL distance_tolerance;
+
+  /// @brief Maximal number of iterations of conservative advancement. When
+  /// it is reached, the objects are reported in collision at the last time
+  /// reached, which is conservative.
+  size_t num_max_iterations;
+
+  ContinuousCollisionRequest(CCDMotionType motion_type = CCDM_LINEAR,
+                             FCL_REAL distance_tolerance = 1e-4,
+                             size_t num_max_iterations = 200)
+      : motion_type(motion_type),
+        distance_tolerance(distance_tolerance),
+        num_max_iterations(num_max_iterations) {}
+
+  bool operator==(const ContinuousCollisionRequest& other) const {
+    return motion_type == other.motion_type &&
+           distance_tolerance == other.distance_tolerance &&
+           num_max_iterations == other.num_max_iterations;
+  }
+};
+
+/// @brief continuous collision result
+struct HPP_FCL_DLLAPI ContinuousCollisionResult {
+  /// @brief Whether the objects come in contact during the motion
+  bool is_collide;
+
+  /// @brief First time of contact in [0, 1], 1 if there is none
+  FCL_REAL time_of_contact;
+
+  /// @brief Placements of the objects at the time of contact
+  Transform3f contact_tf1, contact_tf2;
+
+  /// @brief Number of distance queries performed
+  size_t num_iterations;
+
+  ContinuousCollisionResult() { clear(); }
+
+  /// @brief Clear the result
+  void clear() {
+    is_collide = false;
+    time_of_contact = 1;
+    contact_tf1.setIdentity();
+    contact_tf2.setIdentity();
+    num_iterations = 0;
+  }
+};
+
+/// @brief Continuous collision checking between two moving geometries, by
+/// conservative advancement.
+///
+/// The time is advanced by the distance between the geometries divided by
+/// an upper bound of their relative speed, so that the first time of
+/// contact is never skipped. The local AABB of both geometries must have
+/// been computed.
+///
+/// @return the time of contact, 1 if the geometries do not collide.
+HPP_FCL_DLLAPI FCL_REAL continuousCollide(
+    const CollisionGeometry* o1, const Transform3f& tf1_beg,
+    const Transform3f& tf1_end, const CollisionGeometry* o2,
+    const Transform3f& tf2_beg, const Transform3f& tf2_end,
+    const ContinuousCollisionRequest& request,
+    ContinuousCollisionResult& result);
+
+/// @brief Continuous collision checking between two geometries moved by the
+/// given motions. The motion type of the request is ignored.
+/// @copydetails continuousCollide(const CollisionGeometry*, const
+/// Transform3f&, const Transform3f&, const CollisionGeometry*, const
+/// Transform3f&, const Transform3f&, const ContinuousCollisionRequest&,
+/// ContinuousCollisionResult&)
+HPP_FCL_DLLAPI FCL_REAL continuousCollide(
+    const CollisionGeometry* o1, const Motion& motion1,
+    const CollisionGeometry* o2, const Motion& motion2,
+    const ContinuousCollisionRequest& request,
+    ContinuousCollisionResult& result);
+
+/// @brief Continuous collision checking between two moving objects, from
+/// their current placements to the given final placements.
+/// @copydetails continuousCollide(const CollisionGeometry*, const
+/// Transform3f&, const Transform3f&, const CollisionGeometry*, const
+/// Transform3f&, const Transform3f&, const ContinuousCollisionRequest&,
+/// ContinuousCollisionResult&)
+HPP_FCL_DLLAPI FCL_REAL continuousCollide(
+    const CollisionObject* o1, const Transform3f& tf1_end,
+    const CollisionObject* o2, const Transform3f& tf2_end,
+    const ContinuousCollisionRequest& request,
+    ContinuousCollisionResult& result);
+
+}  // namespace fcl
+
+}  // namespace hpp
+
+#endif
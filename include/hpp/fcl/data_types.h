@@ -62,15 +62,35 @@ namespace hpp {
 
 namespace hpp {
 namespace fcl {
+/// @brief Scalar type of the library, chosen once per build by the CMake
+/// option HPP_FCL_USE_FLOAT. The library is not templated on the scalar
+/// type: a float and a double build are two installs, and code using one of
+/// them must be compiled with the same definition, which the exported CMake
+/// target and the pkg-config file provide.
+#ifdef HPP_FCL_USE_FLOAT
+typedef float FCL_REAL;
+#else
 typedef double FCL_REAL;
+#endif
 typedef Eigen::Matrix<FCL_REAL, 3, 1> Vec3f;
 typedef Eigen::Matrix<FCL_REAL, Eigen::Dynamic, 1> VecXf;
+/// Not aligned, so that the structures holding it need no aligned allocator.
+typedef Eigen::Matrix<FCL_REAL, 6, 1, Eigen::DontAlign> Vec6f;
 typedef Eigen::Matrix<FCL_REAL, 3, 3> Matrix3f;
 typedef Eigen::Matrix<FCL_REAL, Eigen::Dynamic, 3> Matrixx3f;
 typedef Eigen::Matrix<Eigen::DenseIndex, Eigen::Dynamic, 3> Matrixx3i;
 typedef Eigen::Matrix<FCL_REAL, Eigen::Dynamic, Eigen::Dynamic> MatrixXf;
 typedef Eigen::Vector2i support_func_guess_t;
 
+/// @brief Default tolerance of the GJK and EPA algorithms. In single
+/// precision, it is raised above the rounding errors on the support points,
+/// which otherwise prevent the algorithms from converging.
+#ifdef HPP_FCL_USE_FLOAT
+constexpr FCL_REAL GJK_DEFAULT_TOLERANCE = 1e-4f;
+#else
+constexpr FCL_REAL GJK_DEFAULT_TOLERANCE = 1e-6;
+#endif
+
 /// @brief Initial guess to use for the GJK algorithm
 /// DefaultGuess: Vec3f(1, 0, 0)
 /// CachedGuess: previous vector found by GJK or guess cached by the user
@@ -88,6 +88,17 @@ inline FCL_REAL distance(const CollisionGeometry* o1, const Transform3f& tf1,
   return res;
 }
 
+/// @brief Distance computation between two geometries for a batch of n
+/// placements.
+/// @sa ComputeDistance::operator()(const Transform3f*, const Transform3f*,
+/// std::size_t, const DistanceRequest&, DistanceResult*, int) const
+HPP_FCL_DLLAPI FCL_REAL distance(const CollisionGeometry* o1,
+                                 const Transform3f* tf1,
+                                 const CollisionGeometry* o2,
+                                 const Transform3f* tf2, std::size_t n,
+                                 const DistanceRequest& request,
+                                 DistanceResult* results, int num_threads = 1);
+
 /// This class reduces the cost of identifying the geometry pair.
 /// This is mostly useful for repeated shape-shape queries.
 ///
@@ -95,6 +106,9 @@ inline FCL_REAL distance(const CollisionGeometry* o1, const Transform3f& tf1,
 ///   ComputeDistance calc_distance (o1, o2);
 ///   FCL_REAL distance = calc_distance(tf1, tf2, request, result);
 /// \endcode
+///
+/// The const methods can be called concurrently from several threads: the
+/// solver used by a query is local to the call or provided by the caller.
 class HPP_FCL_DLLAPI ComputeDistance {
  public:
   ComputeDistance(const CollisionGeometry* o1, const CollisionGeometry* o2);
@@ -103,6 +117,25 @@ class HPP_FCL_DLLAPI ComputeDistance {
                       const DistanceRequest& request,
                       DistanceResult& result) const;
 
+  /// @brief Run the query with a solver provided by the caller, which is
+  /// reconfigured from the request. This avoids building a solver for each
+  /// query, e.g. when each thread owns a solver.
+  FCL_REAL operator()(const Transform3f& tf1, const Transform3f& tf2,
+                      const DistanceRequest& request, DistanceResult& result,
+                      GJKSolver& solver) const;
+
+  /// @brief Run the query, reusing the outcome of the previous query between
+  /// the two geometries stored in \c cache, which is then updated.
+  /// See PairCache.
+  FCL_REAL operator()(const Transform3f& tf1, const Transform3f& tf2,
+                      const DistanceRequest& request, DistanceResult& result,
+                      PairCache& cache) const;
+
+  /// @brief Run the query with a cache and a solver provided by the caller.
+  FCL_REAL operator()(const Transform3f& tf1, const Transform3f& tf2,
+                      const DistanceRequest& request, DistanceResult& result,
+                      PairCache& cache, GJKSolver& solver) const;
+
   inline FCL_REAL operator()(const Transform3f& tf1, const Transform3f& tf2,
                              DistanceRequest& request,
                              DistanceResult& result) const {
@@ -112,9 +145,30 @@ class HPP_FCL_DLLAPI ComputeDistance {
     return res;
   }
 
+  /// @brief Distance computation between the two geometries for a batch of n
+  /// placements.
+  ///
+  /// The query i is run between o1 placed at tf1[i] and o2 placed at tf2[i],
+  /// and results[i] is cleared and filled with its result. When the GJK
+  /// initial guess of the request is GJKInitialGuess::CachedGuess, each query
+  /// is warm-started with the guess of the previous one.
+  ///
+  /// When the library is built with OpenMP, the batch is split into
+  /// contiguous chunks processed by num_threads threads, each with its own GJK
+  /// solver. Otherwise, the batch is processed sequentially.
+  ///
+  /// @param tf1, tf2 arrays of n placements of o1 and o2
+  /// @param results preallocated array of n results
+  /// @param num_threads number of threads, 0 for the default number of
+  ///        threads of OpenMP
+  /// @return the minimal distance over the batch
+  FCL_REAL operator()(const Transform3f* tf1, const Transform3f* tf2,
+                      std::size_t n, const DistanceRequest& request,
+                      DistanceResult* results, int num_threads = 1) const;
+
   bool operator==(const ComputeDistance& other) const {
     return o1 == other.o1 && o2 == other.o2 && swap_geoms == other.swap_geoms &&
-           solver == other.solver && func == other.func;
+           func == other.func;
   }
 
   bool operator!=(const ComputeDistance& other) const {
@@ -131,14 +185,15 @@ class HPP_FCL_DLLAPI ComputeDistance {
   mutable const CollisionGeometry* o1;
   mutable const CollisionGeometry* o2;
 
-  mutable GJKSolver solver;
-
   DistanceFunctionMatrix::DistanceFunc func;
   bool swap_geoms;
 
+  /// @brief Run the query with the given solver, already configured from the
+  /// request. Every operator goes through it, so that the derived classes
+  /// only override this method.
   virtual FCL_REAL run(const Transform3f& tf1, const Transform3f& tf2,
-                       const DistanceRequest& request,
-                       DistanceResult& result) const;
+                       const DistanceRequest& request, DistanceResult& result,
+                       const GJKSolver* solver) const;
 
  public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
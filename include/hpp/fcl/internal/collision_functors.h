@@ -0,0 +1,389 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2015, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \author Jia Pan */
+
+#ifndef HPP_FCL_INTERNAL_COLLISION_FUNCTORS_H
+#define HPP_FCL_INTERNAL_COLLISION_FUNCTORS_H
+
+/// @cond INTERNAL
+
+#include <hpp/fcl/collision_data.h>
+#include <hpp/fcl/narrowphase/narrowphase.h>
+#include <hpp/fcl/internal/traversal_node_setup.h>
+#include <hpp/fcl/internal/collision_node.h>
+#include <hpp/fcl/internal/shape_shape_func.h>
+
+namespace hpp {
+namespace fcl {
+
+namespace details {
+template <typename T_BVH, typename T_SH>
+struct bvh_shape_traits {
+  enum { Options = RelativeTransformationIsIdentity };
+};
+#define BVH_SHAPE_DEFAULT_TO_ORIENTED(bv) \
+  template <typename T_SH>                \
+  struct bvh_shape_traits<bv, T_SH> {     \
+    enum { Options = 0 };                 \
+  }
+BVH_SHAPE_DEFAULT_TO_ORIENTED(OBB);
+BVH_SHAPE_DEFAULT_TO_ORIENTED(RSS);
+BVH_SHAPE_DEFAULT_TO_ORIENTED(kIOS);
+BVH_SHAPE_DEFAULT_TO_ORIENTED(OBBRSS);
+#undef BVH_SHAPE_DEFAULT_TO_ORIENTED
+
+/// The collision between a point cloud and a BVH model is made with
+/// non-aligned object frames, so that the points are not copied, unless the
+/// oriented overlap of the bounding volumes is not implemented.
+template <typename T_BVH>
+struct bvh_point_cloud_traits {
+  enum { Options = 0 };
+};
+template <short N>
+struct bvh_point_cloud_traits<KDOP<N> > {
+  enum { Options = RelativeTransformationIsIdentity };
+};
+}  // namespace details
+
+/// @brief Collider functor between a point cloud and a shape. Each point is a
+/// sphere of radius BVHModelBase::point_radius.
+template <typename T_BVH, typename T_SH>
+struct HPP_FCL_LOCAL PointCloudShapeCollider {
+  static std::size_t collide(const CollisionGeometry* o1,
+                             const Transform3f& tf1,
+                             const CollisionGeometry* o2,
+                             const Transform3f& tf2, const GJKSolver* nsolver,
+                             const CollisionRequest& request,
+                             CollisionResult& result) {
+    if (request.isSatisfied(result)) return result.numContacts();
+
+    PointCloudShapeCollisionTraversalNode<T_BVH, T_SH> node(request);
+    const BVHModel<T_BVH>* obj1 = static_cast<const BVHModel<T_BVH>*>(o1);
+    const T_SH* obj2 = static_cast<const T_SH*>(o2);
+
+    initialize(node, *obj1, tf1, *obj2, tf2, nsolver, result);
+    fcl::collide(&node, request, result);
+    return result.numContacts();
+  }
+};
+
+/// \tparam _Options takes two values.
+///         - RelativeTransformationIsIdentity if object 1 should be moved
+///           into the frame of object 2 before computing collisions.
+///         - 0 if the query should be made with non-aligned object frames.
+template <typename T_BVH, typename T_SH,
+          int _Options = details::bvh_shape_traits<T_BVH, T_SH>::Options>
+struct HPP_FCL_LOCAL BVHShapeCollider {
+  static std::size_t collide(const CollisionGeometry* o1,
+                             const Transform3f& tf1,
+                             const CollisionGeometry* o2,
+                             const Transform3f& tf2, const GJKSolver* nsolver,
+                             const CollisionRequest& request,
+                             CollisionResult& result) {
+    if (request.isSatisfied(result)) return result.numContacts();
+
+    if (request.security_margin < 0)
+      HPP_FCL_THROW_PRETTY(
+          "Negative security margin are not handled yet for BVHModel",
+          std::invalid_argument);
+
+    if (details::isPointCloud(o1))
+      return PointCloudShapeCollider<T_BVH, T_SH>::collide(
+          o1, tf1, o2, tf2, nsolver, request, result);
+
+    if (_Options & RelativeTransformationIsIdentity)
+      return aligned(o1, tf1, o2, tf2, nsolver, request, result);
+    else
+      return oriented(o1, tf1, o2, tf2, nsolver, request, result);
+  }
+
+  static std::size_t aligned(const CollisionGeometry* o1,
+                             const Transform3f& tf1,
+                             const CollisionGeometry* o2,
+                             const Transform3f& tf2, const GJKSolver* nsolver,
+                             const CollisionRequest& request,
+                             CollisionResult& result) {
+    if (request.isSatisfied(result)) return result.numContacts();
+
+    MeshShapeCollisionTraversalNode<T_BVH, T_SH,
+                                    RelativeTransformationIsIdentity>
+        node(request);
+    const BVHModel<T_BVH>* obj1 = static_cast<const BVHModel<T_BVH>*>(o1);
+    BVHModel<T_BVH>* obj1_tmp = new BVHModel<T_BVH>(*obj1);
+    Transform3f tf1_tmp = tf1;
+    const T_SH* obj2 = static_cast<const T_SH*>(o2);
+
+    initialize(node, *obj1_tmp, tf1_tmp, *obj2, tf2, nsolver, result);
+    fcl::collide(&node, request, result);
+
+    delete obj1_tmp;
+    return result.numContacts();
+  }
+
+  static std::size_t oriented(const CollisionGeometry* o1,
+                              const Transform3f& tf1,
+                              const CollisionGeometry* o2,
+                              const Transform3f& tf2, const GJKSolver* nsolver,
+                              const CollisionRequest& request,
+                              CollisionResult& result) {
+    if (request.isSatisfied(result)) return result.numContacts();
+
+    MeshShapeCollisionTraversalNode<T_BVH, T_SH, 0> node(request);
+    const BVHModel<T_BVH>* obj1 = static_cast<const BVHModel<T_BVH>*>(o1);
+    const T_SH* obj2 = static_cast<const T_SH*>(o2);
+
+    initialize(node, *obj1, tf1, *obj2, tf2, nsolver, result);
+    fcl::collide(&node, request, result);
+    return result.numContacts();
+  }
+};
+
+/// @brief Collider functor for HeightField data structure
+/// \tparam _Options takes two values.
+///         - RelativeTransformationIsIdentity if object 1 should be moved
+///           into the frame of object 2 before computing collisions.
+///         - 0 if the query should be made with non-aligned object frames.
+template <typename BV, typename Shape>
+struct HPP_FCL_LOCAL HeightFieldShapeCollider {
+  typedef HeightField<BV> HF;
+
+  static std::size_t collide(const CollisionGeometry* o1,
+                             const Transform3f& tf1,
+                             const CollisionGeometry* o2,
+                             const Transform3f& tf2, const GJKSolver* nsolver,
+                             const CollisionRequest& request,
+                             CollisionResult& result) {
+    if (request.isSatisfied(result)) return result.numContacts();
+
+    const HF& height_field = static_cast<const HF&>(*o1);
+    const Shape& shape = static_cast<const Shape&>(*o2);
+
+    HeightFieldShapeCollisionTraversalNode<BV, Shape, 0> node(request);
+
+    initialize(node, height_field, tf1, shape, tf2, nsolver, result);
+    fcl::collide(&node, request, result);
+    return result.numContacts();
+  }
+};
+
+namespace details {
+template <typename OrientedMeshCollisionTraversalNode, typename T_BVH>
+std::size_t orientedMeshCollide(const CollisionGeometry* o1,
+                                const Transform3f& tf1,
+                                const CollisionGeometry* o2,
+                                const Transform3f& tf2,
+                                const CollisionRequest& request,
+                                CollisionResult& result) {
+  if (request.isSatisfied(result)) return result.numContacts();
+
+  OrientedMeshCollisionTraversalNode node(request);
+  const BVHModel<T_BVH>* obj1 = static_cast<const BVHModel<T_BVH>*>(o1);
+  const BVHModel<T_BVH>* obj2 = static_cast<const BVHModel<T_BVH>*>(o2);
+
+  initialize(node, *obj1, tf1, *obj2, tf2, result);
+  collide(&node, request, result);
+
+  return result.numContacts();
+}
+
+}  // namespace details
+
+template <typename T_BVH>
+std::size_t BVHCollide(const CollisionGeometry* o1, const Transform3f& tf1,
+                       const CollisionGeometry* o2, const Transform3f& tf2,
+                       const CollisionRequest& request,
+                       CollisionResult& result) {
+  if (request.isSatisfied(result)) return result.numContacts();
+
+  MeshCollisionTraversalNode<T_BVH> node(request);
+  const BVHModel<T_BVH>* obj1 = static_cast<const BVHModel<T_BVH>*>(o1);
+  const BVHModel<T_BVH>* obj2 = static_cast<const BVHModel<T_BVH>*>(o2);
+  BVHModel<T_BVH>* obj1_tmp = new BVHModel<T_BVH>(*obj1);
+  Transform3f tf1_tmp = tf1;
+  BVHModel<T_BVH>* obj2_tmp = new BVHModel<T_BVH>(*obj2);
+  Transform3f tf2_tmp = tf2;
+
+  initialize(node, *obj1_tmp, tf1_tmp, *obj2_tmp, tf2_tmp, result);
+  fcl::collide(&node, request, result);
+
+  delete obj1_tmp;
+  delete obj2_tmp;
+
+  return result.numContacts();
+}
+
+template <>
+inline std::size_t BVHCollide<OBB>(const CollisionGeometry* o1,
+                                   const Transform3f& tf1,
+                                   const CollisionGeometry* o2,
+                                   const Transform3f& tf2,
+                                   const CollisionRequest& request,
+                                   CollisionResult& result) {
+  return details::orientedMeshCollide<MeshCollisionTraversalNodeOBB, OBB>(
+      o1, tf1, o2, tf2, request, result);
+}
+
+template <>
+inline std::size_t BVHCollide<OBBRSS>(const CollisionGeometry* o1,
+                                      const Transform3f& tf1,
+                                      const CollisionGeometry* o2,
+                                      const Transform3f& tf2,
+                                      const CollisionRequest& request,
+                                      CollisionResult& result) {
+  return details::orientedMeshCollide<MeshCollisionTraversalNodeOBBRSS, OBBRSS>(
+      o1, tf1, o2, tf2, request, result);
+}
+
+template <>
+inline std::size_t BVHCollide<kIOS>(const CollisionGeometry* o1,
+                                    const Transform3f& tf1,
+                                    const CollisionGeometry* o2,
+                                    const Transform3f& tf2,
+                                    const CollisionRequest& request,
+                                    CollisionResult& result) {
+  return details::orientedMeshCollide<MeshCollisionTraversalNodekIOS, kIOS>(
+      o1, tf1, o2, tf2, request, result);
+}
+
+/// @brief Collider functor between a point cloud and a BVH model, either of
+/// them being the point cloud.
+/// \tparam _Options takes two values.
+///         - RelativeTransformationIsIdentity if the objects should be moved
+///           into the world frame before computing collisions.
+///         - 0 if the query should be made with non-aligned object frames.
+template <typename T_BVH,
+          int _Options = details::bvh_point_cloud_traits<T_BVH>::Options>
+struct HPP_FCL_LOCAL BVHPointCloudCollider {
+  static std::size_t collide(const CollisionGeometry* o1,
+                             const Transform3f& tf1,
+                             const CollisionGeometry* o2,
+                             const Transform3f& tf2, const GJKSolver* nsolver,
+                             const CollisionRequest& request,
+                             CollisionResult& result) {
+    if (request.isSatisfied(result)) return result.numContacts();
+
+    if (_Options & RelativeTransformationIsIdentity)
+      return aligned(o1, tf1, o2, tf2, nsolver, request, result);
+    else
+      return oriented(o1, tf1, o2, tf2, nsolver, request, result);
+  }
+
+  static std::size_t aligned(const CollisionGeometry* o1,
+                             const Transform3f& tf1,
+                             const CollisionGeometry* o2,
+                             const Transform3f& tf2, const GJKSolver* nsolver,
+                             const CollisionRequest& request,
+                             CollisionResult& result) {
+    PointCloudCollisionTraversalNode<T_BVH, RelativeTransformationIsIdentity>
+        node(request);
+    const BVHModel<T_BVH>* obj1 = static_cast<const BVHModel<T_BVH>*>(o1);
+    const BVHModel<T_BVH>* obj2 = static_cast<const BVHModel<T_BVH>*>(o2);
+    BVHModel<T_BVH>* obj1_tmp = new BVHModel<T_BVH>(*obj1);
+    Transform3f tf1_tmp = tf1;
+    BVHModel<T_BVH>* obj2_tmp = new BVHModel<T_BVH>(*obj2);
+    Transform3f tf2_tmp = tf2;
+
+    initialize(node, *obj1_tmp, tf1_tmp, *obj2_tmp, tf2_tmp, nsolver, result);
+    fcl::collide(&node, request, result);
+
+    delete obj1_tmp;
+    delete obj2_tmp;
+
+    return result.numContacts();
+  }
+
+  static std::size_t oriented(const CollisionGeometry* o1,
+                              const Transform3f& tf1,
+                              const CollisionGeometry* o2,
+                              const Transform3f& tf2, const GJKSolver* nsolver,
+                              const CollisionRequest& request,
+                              CollisionResult& result) {
+    PointCloudCollisionTraversalNode<T_BVH, 0> node(request);
+    const BVHModel<T_BVH>* obj1 = static_cast<const BVHModel<T_BVH>*>(o1);
+    const BVHModel<T_BVH>* obj2 = static_cast<const BVHModel<T_BVH>*>(o2);
+
+    initialize(node, *obj1, tf1, *obj2, tf2, nsolver, result);
+    fcl::collide(&node, request, result);
+    return result.numContacts();
+  }
+};
+
+template <typename T_BVH>
+std::size_t BVHCollide(const CollisionGeometry* o1, const Transform3f& tf1,
+                       const CollisionGeometry* o2, const Transform3f& tf2,
+                       const GJKSolver* nsolver,
+                       const CollisionRequest& request,
+                       CollisionResult& result) {
+  if (details::isPointCloud(o1) || details::isPointCloud(o2))
+    return BVHPointCloudCollider<T_BVH>::collide(o1, tf1, o2, tf2, nsolver,
+                                                 request, result);
+  return BVHCollide<T_BVH>(o1, tf1, o2, tf2, request, result);
+}
+
+/// @brief Collider functor between a point cloud and a height field. Each
+/// point is a sphere of radius BVHModelBase::point_radius.
+template <typename BV>
+struct HPP_FCL_LOCAL PointCloudHeightFieldCollider {
+  static std::size_t collide(const CollisionGeometry* o1,
+                             const Transform3f& tf1,
+                             const CollisionGeometry* o2,
+                             const Transform3f& tf2, const GJKSolver* nsolver,
+                             const CollisionRequest& request,
+                             CollisionResult& result) {
+    if (request.isSatisfied(result)) return result.numContacts();
+
+    if (!details::isPointCloud(o1))
+      HPP_FCL_THROW_PRETTY(
+          "Collision between a triangle mesh and a height field is not "
+          "implemented",
+          std::invalid_argument);
+
+    PointCloudHeightFieldCollisionTraversalNode<BV> node(request);
+    const BVHModel<BV>* obj1 = static_cast<const BVHModel<BV>*>(o1);
+    const HeightField<BV>* obj2 = static_cast<const HeightField<BV>*>(o2);
+
+    initialize(node, *obj1, tf1, *obj2, tf2, nsolver, result);
+    fcl::collide(&node, request, result);
+    return result.numContacts();
+  }
+};
+
+}  // namespace fcl
+}  // namespace hpp
+
+/// @endcond
+
+#endif
@@ -40,9 +40,12 @@
 
 /// @cond INTERNAL
 
+#include <type_traits>
+
 #include <hpp/fcl/BVH/BVH_front.h>
 #include <hpp/fcl/internal/traversal_node_base.h>
 #include <hpp/fcl/internal/traversal_node_bvhs.h>
+#include <hpp/fcl/internal/traversal_recurse.h>
 
 /// @brief collision and distance function on traversal nodes. these functions
 /// provide a higher level abstraction for collision functions provided in
@@ -69,6 +72,56 @@ HPP_FCL_DLLAPI void collide(CollisionTraversalNodeBase* node,
 HPP_FCL_DLLAPI void distance(DistanceTraversalNodeBase* node,
                              BVHFrontList* front_list = NULL,
                              unsigned int qsize = 2);
+
+/// collision on a traversal node whose dynamic type is TraversalNode
+///
+/// The traversal is instantiated for TraversalNode so that the BV tests and
+/// the leaf tests are not dispatched through the virtual table. Front list
+/// propagation is forwarded to the virtual implementation.
+template <typename TraversalNode>
+typename std::enable_if<
+    std::is_base_of<CollisionTraversalNodeBase, TraversalNode>::value>::type
+collide(TraversalNode* node, const CollisionRequest& request,
+        CollisionResult& result, BVHFrontList* front_list = NULL,
+        bool recursive = true) {
+  if (front_list && front_list->size() > 0) {
+    propagateBVHFrontListCollisionRecurse(node, request, result, front_list);
+  } else {
+    FCL_REAL sqrDistLowerBound = 0;
+    if (recursive)
+      collisionRecurse(node, 0, 0, front_list, sqrDistLowerBound);
+    else
+      collisionNonRecurse(node, front_list, sqrDistLowerBound);
+
+    if (!std::isnan(sqrDistLowerBound)) {
+      if (sqrDistLowerBound == 0) {
+        assert(result.distance_lower_bound <= 0);
+      } else {
+        assert(result.distance_lower_bound * result.distance_lower_bound -
+                   sqrDistLowerBound <
+               1e-8);
+      }
+    }
+  }
+}
+
+/// @brief distance computation on a traversal node whose dynamic type is
+/// TraversalNode. The queue based traversal (qsize > 2) is forwarded to the
+/// virtual implementation.
+template <typename TraversalNode>
+typename std::enable_if<
+    std::is_base_of<DistanceTraversalNodeBase, TraversalNode>::value>::type
+distance(TraversalNode* node, BVHFrontList* front_list = NULL,
+         unsigned int qsize = 2) {
+  node->preprocess();
+
+  if (qsize <= 2)
+    distanceRecurse(node, 0, 0, front_list);
+  else
+    distanceQueueRecurse(node, 0, 0, front_list, qsize);
+
+  node->postprocess();
+}
 }  // namespace fcl
 
 }  // namespace hpp
@@ -0,0 +1,385 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2015, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \author Jia Pan */
+
+#ifndef HPP_FCL_INTERNAL_DISTANCE_FUNCTORS_H
+#define HPP_FCL_INTERNAL_DISTANCE_FUNCTORS_H
+
+/// @cond INTERNAL
+
+#include <hpp/fcl/collision_data.h>
+#include <hpp/fcl/narrowphase/narrowphase.h>
+#include <hpp/fcl/internal/traversal_node_setup.h>
+#include <hpp/fcl/internal/collision_node.h>
+#include <hpp/fcl/internal/shape_shape_func.h>
+
+namespace hpp {
+namespace fcl {
+
+template <typename T_SH1, typename T_SH2>
+FCL_REAL ShapeShapeDistance(const CollisionGeometry* o1, const Transform3f& tf1,
+                            const CollisionGeometry* o2, const Transform3f& tf2,
+                            const GJKSolver* nsolver,
+                            const DistanceRequest& request,
+                            DistanceResult& result) {
+  if (request.isSatisfied(result)) return result.min_distance;
+  ShapeDistanceTraversalNode<T_SH1, T_SH2> node;
+  const T_SH1* obj1 = static_cast<const T_SH1*>(o1);
+  const T_SH2* obj2 = static_cast<const T_SH2*>(o2);
+
+  initialize(node, *obj1, tf1, *obj2, tf2, nsolver, request, result);
+  distance(&node);
+
+  return result.min_distance;
+}
+
+/// @brief Distance functor between a point cloud and a shape. Each point is a
+/// sphere of radius BVHModelBase::point_radius.
+template <typename T_BVH, typename T_SH>
+struct HPP_FCL_LOCAL PointCloudShapeDistancer {
+  static FCL_REAL distance(const CollisionGeometry* o1, const Transform3f& tf1,
+                           const CollisionGeometry* o2, const Transform3f& tf2,
+                           const GJKSolver* nsolver,
+                           const DistanceRequest& request,
+                           DistanceResult& result) {
+    if (request.isSatisfied(result)) return result.min_distance;
+    PointCloudShapeDistanceTraversalNode<T_BVH, T_SH> node;
+    const BVHModel<T_BVH>* obj1 = static_cast<const BVHModel<T_BVH>*>(o1);
+    const T_SH* obj2 = static_cast<const T_SH*>(o2);
+
+    initialize(node, *obj1, tf1, *obj2, tf2, nsolver, request, result);
+    fcl::distance(&node);
+
+    return result.min_distance;
+  }
+};
+
+template <typename T_BVH, typename T_SH>
+struct HPP_FCL_LOCAL BVHShapeDistancer {
+  static FCL_REAL distance(const CollisionGeometry* o1, const Transform3f& tf1,
+                           const CollisionGeometry* o2, const Transform3f& tf2,
+                           const GJKSolver* nsolver,
+                           const DistanceRequest& request,
+                           DistanceResult& result) {
+    if (details::isPointCloud(o1))
+      return PointCloudShapeDistancer<T_BVH, T_SH>::distance(
+          o1, tf1, o2, tf2, nsolver, request, result);
+
+    if (request.isSatisfied(result)) return result.min_distance;
+    MeshShapeDistanceTraversalNode<T_BVH, T_SH> node;
+    const BVHModel<T_BVH>* obj1 = static_cast<const BVHModel<T_BVH>*>(o1);
+    BVHModel<T_BVH>* obj1_tmp = new BVHModel<T_BVH>(*obj1);
+    Transform3f tf1_tmp = tf1;
+    const T_SH* obj2 = static_cast<const T_SH*>(o2);
+
+    initialize(node, *obj1_tmp, tf1_tmp, *obj2, tf2, nsolver, request, result);
+    fcl::distance(&node);
+
+    delete obj1_tmp;
+    return result.min_distance;
+  }
+};
+
+namespace details {
+
+template <typename OrientedMeshShapeDistanceTraversalNode, typename T_BVH,
+          typename T_SH>
+FCL_REAL orientedBVHShapeDistance(const CollisionGeometry* o1,
+                                  const Transform3f& tf1,
+                                  const CollisionGeometry* o2,
+                                  const Transform3f& tf2,
+                                  const GJKSolver* nsolver,
+                                  const DistanceRequest& request,
+                                  DistanceResult& result) {
+  if (isPointCloud(o1))
+    return PointCloudShapeDistancer<T_BVH, T_SH>::distance(
+        o1, tf1, o2, tf2, nsolver, request, result);
+
+  if (request.isSatisfied(result)) return result.min_distance;
+  OrientedMeshShapeDistanceTraversalNode node;
+  const BVHModel<T_BVH>* obj1 = static_cast<const BVHModel<T_BVH>*>(o1);
+  const T_SH* obj2 = static_cast<const T_SH*>(o2);
+
+  initialize(node, *obj1, tf1, *obj2, tf2, nsolver, request, result);
+  fcl::distance(&node);
+
+  return result.min_distance;
+}
+
+}  // namespace details
+
+template <typename T_SH>
+struct HPP_FCL_LOCAL BVHShapeDistancer<RSS, T_SH> {
+  static FCL_REAL distance(const CollisionGeometry* o1, const Transform3f& tf1,
+                           const CollisionGeometry* o2, const Transform3f& tf2,
+                           const GJKSolver* nsolver,
+                           const DistanceRequest& request,
+                           DistanceResult& result) {
+    return details::orientedBVHShapeDistance<
+        MeshShapeDistanceTraversalNodeRSS<T_SH>, RSS, T_SH>(
+        o1, tf1, o2, tf2, nsolver, request, result);
+  }
+};
+
+template <typename T_SH>
+struct HPP_FCL_LOCAL BVHShapeDistancer<kIOS, T_SH> {
+  static FCL_REAL distance(const CollisionGeometry* o1, const Transform3f& tf1,
+                           const CollisionGeometry* o2, const Transform3f& tf2,
+                           const GJKSolver* nsolver,
+                           const DistanceRequest& request,
+                           DistanceResult& result) {
+    return details::orientedBVHShapeDistance<
+        MeshShapeDistanceTraversalNodekIOS<T_SH>, kIOS, T_SH>(
+        o1, tf1, o2, tf2, nsolver, request, result);
+  }
+};
+
+template <typename T_SH>
+struct HPP_FCL_LOCAL BVHShapeDistancer<OBBRSS, T_SH> {
+  static FCL_REAL distance(const CollisionGeometry* o1, const Transform3f& tf1,
+                           const CollisionGeometry* o2, const Transform3f& tf2,
+                           const GJKSolver* nsolver,
+                           const DistanceRequest& request,
+                           DistanceResult& result) {
+    return details::orientedBVHShapeDistance<
+        MeshShapeDistanceTraversalNodeOBBRSS<T_SH>, OBBRSS, T_SH>(
+        o1, tf1, o2, tf2, nsolver, request, result);
+  }
+};
+
+template <typename T_HF, typename T_SH>
+struct HPP_FCL_LOCAL HeightFieldShapeDistancer {
+  static FCL_REAL distance(const CollisionGeometry* o1, const Transform3f& tf1,
+                           const CollisionGeometry* o2, const Transform3f& tf2,
+                           const GJKSolver* nsolver,
+                           const DistanceRequest& request,
+                           DistanceResult& result) {
+    HPP_FCL_UNUSED_VARIABLE(o1);
+    HPP_FCL_UNUSED_VARIABLE(tf1);
+    HPP_FCL_UNUSED_VARIABLE(o2);
+    HPP_FCL_UNUSED_VARIABLE(tf2);
+    HPP_FCL_UNUSED_VARIABLE(nsolver);
+    HPP_FCL_UNUSED_VARIABLE(request);
+    // TODO(jcarpent)
+    HPP_FCL_THROW_PRETTY(
+        "Distance between a height field and a shape is not implemented",
+        std::invalid_argument);
+    //    if(request.isSatisfied(result)) return result.min_distance;
+    //    HeightFieldShapeDistanceTraversalNode<T_HF, T_SH> node;
+    //
+    //    const HeightField<T_HF>* obj1 = static_cast<const HeightField<T_HF>*
+    //    >(o1); const T_SH* obj2 = static_cast<const T_SH*>(o2);
+    //
+    //    initialize(node, *obj1, tf1, *obj2, tf2, nsolver, request, result);
+    //    fcl::distance(&node);
+
+    return result.min_distance;
+  }
+};
+
+template <typename T_BVH>
+FCL_REAL BVHDistance(const CollisionGeometry* o1, const Transform3f& tf1,
+                     const CollisionGeometry* o2, const Transform3f& tf2,
+                     const DistanceRequest& request, DistanceResult& result) {
+  if (request.isSatisfied(result)) return result.min_distance;
+  MeshDistanceTraversalNode<T_BVH> node;
+  const BVHModel<T_BVH>* obj1 = static_cast<const BVHModel<T_BVH>*>(o1);
+  const BVHModel<T_BVH>* obj2 = static_cast<const BVHModel<T_BVH>*>(o2);
+  BVHModel<T_BVH>* obj1_tmp = new BVHModel<T_BVH>(*obj1);
+  Transform3f tf1_tmp = tf1;
+  BVHModel<T_BVH>* obj2_tmp = new BVHModel<T_BVH>(*obj2);
+  Transform3f tf2_tmp = tf2;
+
+  initialize(node, *obj1_tmp, tf1_tmp, *obj2_tmp, tf2_tmp, request, result);
+  distance(&node);
+  delete obj1_tmp;
+  delete obj2_tmp;
+
+  return result.min_distance;
+}
+
+namespace details {
+template <typename OrientedMeshDistanceTraversalNode, typename T_BVH>
+FCL_REAL orientedMeshDistance(const CollisionGeometry* o1,
+                              const Transform3f& tf1,
+                              const CollisionGeometry* o2,
+                              const Transform3f& tf2,
+                              const DistanceRequest& request,
+                              DistanceResult& result) {
+  if (request.isSatisfied(result)) return result.min_distance;
+  OrientedMeshDistanceTraversalNode node;
+  const BVHModel<T_BVH>* obj1 = static_cast<const BVHModel<T_BVH>*>(o1);
+  const BVHModel<T_BVH>* obj2 = static_cast<const BVHModel<T_BVH>*>(o2);
+
+  initialize(node, *obj1, tf1, *obj2, tf2, request, result);
+  distance(&node);
+
+  return result.min_distance;
+}
+
+}  // namespace details
+
+template <>
+inline FCL_REAL BVHDistance<RSS>(const CollisionGeometry* o1,
+                                 const Transform3f& tf1,
+                                 const CollisionGeometry* o2,
+                                 const Transform3f& tf2,
+                                 const DistanceRequest& request,
+                                 DistanceResult& result) {
+  return details::orientedMeshDistance<MeshDistanceTraversalNodeRSS, RSS>(
+      o1, tf1, o2, tf2, request, result);
+}
+
+template <>
+inline FCL_REAL BVHDistance<kIOS>(const CollisionGeometry* o1,
+                                  const Transform3f& tf1,
+                                  const CollisionGeometry* o2,
+                                  const Transform3f& tf2,
+                                  const DistanceRequest& request,
+                                  DistanceResult& result) {
+  return details::orientedMeshDistance<MeshDistanceTraversalNodekIOS, kIOS>(
+      o1, tf1, o2, tf2, request, result);
+}
+
+template <>
+inline FCL_REAL BVHDistance<OBBRSS>(const CollisionGeometry* o1,
+                                    const Transform3f& tf1,
+                                    const CollisionGeometry* o2,
+                                    const Transform3f& tf2,
+                                    const DistanceRequest& request,
+                                    DistanceResult& result) {
+  return details::orientedMeshDistance<MeshDistanceTraversalNodeOBBRSS, OBBRSS>(
+      o1, tf1, o2, tf2, request, result);
+}
+
+namespace details {
+/// The distance between a point cloud and a BVH model is computed with
+/// non-aligned object frames for the bounding volumes whose oriented distance
+/// is implemented, as for meshes.
+template <typename T_BVH>
+struct bvh_point_cloud_distance_traits {
+  enum { Options = RelativeTransformationIsIdentity };
+};
+#define BVH_POINT_CLOUD_DISTANCE_ORIENTED(bv) \
+  template <>                                  \
+  struct bvh_point_cloud_distance_traits<bv> { \
+    enum { Options = 0 };                      \
+  }
+BVH_POINT_CLOUD_DISTANCE_ORIENTED(RSS);
+BVH_POINT_CLOUD_DISTANCE_ORIENTED(kIOS);
+BVH_POINT_CLOUD_DISTANCE_ORIENTED(OBBRSS);
+#undef BVH_POINT_CLOUD_DISTANCE_ORIENTED
+}  // namespace details
+
+/// @brief Distance functor between a point cloud and a BVH model, either of
+/// them being the point cloud.
+/// \tparam _Options takes two values.
+///         - RelativeTransformationIsIdentity if the objects should be moved
+///           into the world frame before computing the distance.
+///         - 0 if the query should be made with non-aligned object frames.
+template <typename T_BVH,
+          int _Options =
+              details::bvh_point_cloud_distance_traits<T_BVH>::Options>
+struct HPP_FCL_LOCAL BVHPointCloudDistancer {
+  static FCL_REAL distance(const CollisionGeometry* o1, const Transform3f& tf1,
+                           const CollisionGeometry* o2, const Transform3f& tf2,
+                           const GJKSolver* nsolver,
+                           const DistanceRequest& request,
+                           DistanceResult& result) {
+    if (request.isSatisfied(result)) return result.min_distance;
+
+    if (_Options & RelativeTransformationIsIdentity)
+      return aligned(o1, tf1, o2, tf2, nsolver, request, result);
+    else
+      return oriented(o1, tf1, o2, tf2, nsolver, request, result);
+  }
+
+  static FCL_REAL aligned(const CollisionGeometry* o1, const Transform3f& tf1,
+                          const CollisionGeometry* o2, const Transform3f& tf2,
+                          const GJKSolver* nsolver,
+                          const DistanceRequest& request,
+                          DistanceResult& result) {
+    PointCloudDistanceTraversalNode<T_BVH, RelativeTransformationIsIdentity>
+        node;
+    const BVHModel<T_BVH>* obj1 = static_cast<const BVHModel<T_BVH>*>(o1);
+    const BVHModel<T_BVH>* obj2 = static_cast<const BVHModel<T_BVH>*>(o2);
+    BVHModel<T_BVH>* obj1_tmp = new BVHModel<T_BVH>(*obj1);
+    Transform3f tf1_tmp = tf1;
+    BVHModel<T_BVH>* obj2_tmp = new BVHModel<T_BVH>(*obj2);
+    Transform3f tf2_tmp = tf2;
+
+    initialize(node, *obj1_tmp, tf1_tmp, *obj2_tmp, tf2_tmp, nsolver, request,
+               result);
+    fcl::distance(&node);
+    delete obj1_tmp;
+    delete obj2_tmp;
+
+    return result.min_distance;
+  }
+
+  static FCL_REAL oriented(const CollisionGeometry* o1, const Transform3f& tf1,
+                           const CollisionGeometry* o2, const Transform3f& tf2,
+                           const GJKSolver* nsolver,
+                           const DistanceRequest& request,
+                           DistanceResult& result) {
+    PointCloudDistanceTraversalNode<T_BVH, 0> node;
+    const BVHModel<T_BVH>* obj1 = static_cast<const BVHModel<T_BVH>*>(o1);
+    const BVHModel<T_BVH>* obj2 = static_cast<const BVHModel<T_BVH>*>(o2);
+
+    initialize(node, *obj1, tf1, *obj2, tf2, nsolver, request, result);
+    fcl::distance(&node);
+
+    return result.min_distance;
+  }
+};
+
+template <typename T_BVH>
+FCL_REAL BVHDistance(const CollisionGeometry* o1, const Transform3f& tf1,
+                     const CollisionGeometry* o2, const Transform3f& tf2,
+                     const GJKSolver* nsolver, const DistanceRequest& request,
+                     DistanceResult& result) {
+  if (details::isPointCloud(o1) || details::isPointCloud(o2))
+    return BVHPointCloudDistancer<T_BVH>::distance(o1, tf1, o2, tf2, nsolver,
+                                                   request, result);
+  return BVHDistance<T_BVH>(o1, tf1, o2, tf2, request, result);
+}
+
+}  // namespace fcl
+}  // namespace hpp
+
+/// @endcond
+
+#endif
@@ -42,6 +42,7 @@
 #include <hpp/fcl/collision_data.h>
 #include <hpp/fcl/collision_utility.h>
 #include <hpp/fcl/narrowphase/narrowphase.h>
+#include <hpp/fcl/narrowphase/contact_manifold.h>
 #include <hpp/fcl/shape/geometric_shapes_traits.h>
 
 namespace hpp {
@@ -65,6 +66,15 @@ struct ShapeShapeCollider {
                          CollisionResult& result) {
     if (request.isSatisfied(result)) return result.numContacts();
 
+    const size_t num_contacts_before = result.numContacts();
+    FCL_REAL sqrDistLowerBound;
+    if (details::overlapCollide(nsolver, *static_cast<const T_SH1*>(o1), tf1,
+                                *static_cast<const T_SH2*>(o2), tf2, o1,
+                                Contact::NONE, o2, Contact::NONE, request,
+                                result, sqrDistLowerBound))
+      return result.numContacts() > num_contacts_before ? result.numContacts()
+                                                        : 0;
+
     DistanceResult distanceResult;
     DistanceRequest distanceRequest(request.enable_contact);
     FCL_REAL distance = ShapeShapeDistance<T_SH1, T_SH2>(
@@ -82,19 +92,50 @@ struct ShapeShapeCollider {
       if (result.numContacts() < request.num_max_contacts) {
         const Vec3f& p1 = distanceResult.nearest_points[0];
         const Vec3f& p2 = distanceResult.nearest_points[1];
+        const Vec3f normal(distance <= 0 ? distanceResult.normal
+                                         : Vec3f((p2 - p1).normalized()));
 
-        Contact contact(
-            o1, o2, distanceResult.b1, distanceResult.b2, (p1 + p2) / 2,
-            (distance <= 0 ? distanceResult.normal : (p2 - p1).normalized()),
-            -distance);
+        if (!request.enable_contact || !request.enable_contact_manifold ||
+            !addContactManifold(o1, tf1, o2, tf2, request, distanceResult,
+                                normal, result)) {
+          Contact contact(o1, o2, distanceResult.b1, distanceResult.b2,
+                          (p1 + p2) / 2, normal, -distance);
 
-        result.addContact(contact);
+          result.addContact(contact);
+        }
       }
       num_contacts = result.numContacts();
     }
 
     return num_contacts;
   }
+
+  /// @brief Add the points of the contact manifold between the shapes to
+  /// the result.
+  /// @return false if no manifold was found.
+  static bool addContactManifold(const CollisionGeometry* o1,
+                                 const Transform3f& tf1,
+                                 const CollisionGeometry* o2,
+                                 const Transform3f& tf2,
+                                 const CollisionRequest& request,
+                                 const DistanceResult& distanceResult,
+                                 const Vec3f& normal,
+                                 CollisionResult& result) {
+    const unsigned int max_points = (unsigned int)(std::min)(
+        (size_t)details::contact_manifold_max_points,
+        request.num_max_contacts - result.numContacts());
+    Vec3f positions[details::contact_manifold_max_points];
+    FCL_REAL depths[details::contact_manifold_max_points];
+    const unsigned int num_points = details::computeContactManifold(
+        *static_cast<const ShapeBase*>(o1), tf1,
+        *static_cast<const ShapeBase*>(o2), tf2, normal,
+        request.security_margin + request.collision_distance_threshold,
+        max_points, positions, depths);
+    for (unsigned int i = 0; i < num_points; ++i)
+      result.addContact(Contact(o1, o2, distanceResult.b1, distanceResult.b2,
+                                positions[i], normal, depths[i]));
+    return num_points > 0;
+  }
 };
 
 template <typename ShapeType1, typename ShapeType2>
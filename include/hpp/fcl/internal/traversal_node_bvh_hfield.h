@@ -133,6 +133,7 @@ class MeshHeightFieldCollisionTraversalNode
   /// @brief BV culling test in one BVTT node
   bool BVDisjoints(unsigned int b1, unsigned int b2) const {
     if (this->enable_statistics) this->num_bv_tests++;
+    HPP_FCL_PROFILE_COUNT(num_bv_tests, 1);
     if (RTIsIdentity)
       return !this->model1->getBV(b1).overlap(this->model2->getBV(b2));
     else
@@ -147,6 +148,7 @@ class MeshHeightFieldCollisionTraversalNode
   bool BVDisjoints(unsigned int b1, unsigned int b2,
                    FCL_REAL& sqrDistLowerBound) const {
     if (this->enable_statistics) this->num_bv_tests++;
+    HPP_FCL_PROFILE_COUNT(num_bv_tests, 1);
     if (RTIsIdentity)
       return !this->model1->getBV(b1).overlap(this->model2->getBV(b2),
                                               this->request, sqrDistLowerBound);
@@ -176,6 +178,7 @@ class MeshHeightFieldCollisionTraversalNode
   void leafCollides(unsigned int b1, unsigned int b2,
                     FCL_REAL& sqrDistLowerBound) const {
     if (this->enable_statistics) this->num_leaf_tests++;
+    HPP_FCL_PROFILE_COUNT(num_leaf_tests, 1);
 
     const BVNode<BV1>& node1 = this->model1->getBV(b1);
     const HeightFieldNode<BV2>& node2 = this->model2->getBV(b2);
@@ -419,6 +422,7 @@ class MeshDistanceTraversalNode : public BVHDistanceTraversalNode<BV> {
   /// @brief BV culling test in one BVTT node
   FCL_REAL BVDistanceLowerBound(unsigned int b1, unsigned int b2) const {
     if (enable_statistics) num_bv_tests++;
+    HPP_FCL_PROFILE_COUNT(num_bv_tests, 1);
     if (RTIsIdentity)
       return details::DistanceTraversalBVDistanceLowerBound_impl<BV>::run(
           model1->getBV(b1), model2->getBV(b2));
@@ -430,6 +434,7 @@ class MeshDistanceTraversalNode : public BVHDistanceTraversalNode<BV> {
   /// @brief Distance testing between leaves (two triangles)
   void leafComputeDistance(unsigned int b1, unsigned int b2) const {
     if (this->enable_statistics) this->num_leaf_tests++;
+    HPP_FCL_PROFILE_COUNT(num_leaf_tests, 1);
 
     const BVNode<BV>& node1 = this->model1->getBV(b1);
     const BVNode<BV>& node2 = this->model2->getBV(b2);
@@ -514,8 +519,8 @@ class MeshDistanceTraversalNode : public BVHDistanceTraversalNode<BV> {
     /// the points obtained by triDistance are not in world space: both are in
     /// object1's local coordinate system, so we need to convert them into the
     /// world space.
-    if (request.enable_nearest_points && (result->o1 == model1) &&
-        (result->o2 == model2)) {
+    if ((request.enable_nearest_points || request.enable_gradients) &&
+        (result->o1 == model1) && (result->o2 == model2)) {
       result->nearest_points[0] = tf1.transform(result->nearest_points[0]);
       result->nearest_points[1] = tf1.transform(result->nearest_points[1]);
     }
@@ -160,6 +160,7 @@ class MeshShapeCollisionTraversalNode
   bool BVDisjoints(unsigned int b1, unsigned int /*b2*/,
                    FCL_REAL& sqrDistLowerBound) const {
     if (this->enable_statistics) this->num_bv_tests++;
+    HPP_FCL_PROFILE_COUNT(num_bv_tests, 1);
     bool disjoint;
     if (RTIsIdentity)
       disjoint = !this->model1->getBV(b1).bv.overlap(
@@ -179,6 +180,7 @@ class MeshShapeCollisionTraversalNode
   void leafCollides(unsigned int b1, unsigned int /*b2*/,
                     FCL_REAL& sqrDistLowerBound) const {
     if (this->enable_statistics) this->num_leaf_tests++;
+    HPP_FCL_PROFILE_COUNT(num_leaf_tests, 1);
     const BVNode<BV>& node = this->model1->getBV(b1);
 
     int primitive_id = node.primitiveId();
@@ -189,6 +191,14 @@ class MeshShapeCollisionTraversalNode
     const Vec3f& p2 = vertices[tri_id[1]];
     const Vec3f& p3 = vertices[tri_id[2]];
 
+    static const Transform3f Id;
+    if (details::overlapCollide(nsolver, TriangleP(p1, p2, p3),
+                                RTIsIdentity ? Id : this->tf1, *(this->model2),
+                                this->tf2, this->model1, primitive_id,
+                                this->model2, Contact::NONE, this->request,
+                                *this->result, sqrDistLowerBound))
+      return;
+
     FCL_REAL distance;
     Vec3f normal;
     Vec3f c1, c2;  // closest point
@@ -260,6 +270,7 @@ class ShapeMeshCollisionTraversalNode
   bool BVDisjoints(unsigned int /*b1*/, unsigned int b2,
                    FCL_REAL& sqrDistLowerBound) const {
     if (this->enable_statistics) this->num_bv_tests++;
+    HPP_FCL_PROFILE_COUNT(num_bv_tests, 1);
     bool disjoint;
     if (RTIsIdentity)
       disjoint = !this->model2->getBV(b2).bv.overlap(this->model1_bv,
@@ -279,6 +290,7 @@ class ShapeMeshCollisionTraversalNode
   void leafCollides(unsigned int /*b1*/, unsigned int b2,
                     FCL_REAL& sqrDistLowerBound) const {
     if (this->enable_statistics) this->num_leaf_tests++;
+    HPP_FCL_PROFILE_COUNT(num_leaf_tests, 1);
     const BVNode<BV>& node = this->model2->getBV(b2);
 
     int primitive_id = node.primitiveId();
@@ -289,6 +301,15 @@ class ShapeMeshCollisionTraversalNode
     const Vec3f& p2 = vertices[tri_id[1]];
     const Vec3f& p3 = vertices[tri_id[2]];
 
+    static const Transform3f Id;
+    if (details::overlapCollide(nsolver, *(this->model1), this->tf1,
+                                TriangleP(p1, p2, p3),
+                                RTIsIdentity ? Id : this->tf2, this->model1,
+                                Contact::NONE, this->model2, primitive_id,
+                                this->request, *this->result,
+                                sqrDistLowerBound))
+      return;
+
     FCL_REAL distance;
     Vec3f normal;
     Vec3f c1, c2;  // closest points
@@ -442,6 +463,7 @@ class MeshShapeDistanceTraversalNode
   /// @brief Distance testing between leaves (one triangle and one shape)
   void leafComputeDistance(unsigned int b1, unsigned int /*b2*/) const {
     if (this->enable_statistics) this->num_leaf_tests++;
+    HPP_FCL_PROFILE_COUNT(num_leaf_tests, 1);
 
     const BVNode<BV>& node = this->model1->getBV(b1);
 
@@ -459,8 +481,10 @@ class MeshShapeDistanceTraversalNode
                                       Transform3f(), d, closest_p2, closest_p1,
                                       normal);
 
+    // The normal goes from the shape to the triangle.
     this->result->update(d, this->model1, this->model2, primitive_id,
-                         DistanceResult::NONE, closest_p1, closest_p2, normal);
+                         DistanceResult::NONE, closest_p1, closest_p2,
+                         -normal);
   }
 
   /// @brief Whether the traversal process can stop early
@@ -491,6 +515,7 @@ void meshShapeDistanceOrientedNodeleafComputeDistance(
     bool enable_statistics, int& num_leaf_tests,
     const DistanceRequest& /* request */, DistanceResult& result) {
   if (enable_statistics) num_leaf_tests++;
+  HPP_FCL_PROFILE_COUNT(num_leaf_tests, 1);
 
   const BVNode<BV>& node = model1->getBV(b1);
   int primitive_id = node.primitiveId();
@@ -505,8 +530,9 @@ void meshShapeDistanceOrientedNodeleafComputeDistance(
   nsolver->shapeTriangleInteraction(model2, tf2, p1, p2, p3, tf1, distance,
                                     closest_p2, closest_p1, normal);
 
+  // The normal goes from the shape to the triangle.
   result.update(distance, model1, &model2, primitive_id, DistanceResult::NONE,
-                closest_p1, closest_p2, normal);
+                closest_p1, closest_p2, -normal);
 }
 
 template <typename BV, typename S>
@@ -526,8 +552,9 @@ static inline void distancePreprocessOrientedNode(
   nsolver->shapeTriangleInteraction(model2, tf2, p1, p2, p3, tf1, distance,
                                     closest_p2, closest_p1, normal);
 
+  // The normal goes from the shape to the triangle.
   result.update(distance, model1, &model2, init_tri_id, DistanceResult::NONE,
-                closest_p1, closest_p2, normal);
+                closest_p1, closest_p2, -normal);
 }
 
 }  // namespace details
@@ -553,6 +580,7 @@ class MeshShapeDistanceTraversalNodeRSS
 
   FCL_REAL BVDistanceLowerBound(unsigned int b1, unsigned int /*b2*/) const {
     if (this->enable_statistics) this->num_bv_tests++;
+    HPP_FCL_PROFILE_COUNT(num_bv_tests, 1);
     return distance(this->tf1.getRotation(), this->tf1.getTranslation(),
                     this->model2_bv, this->model1->getBV(b1).bv);
   }
@@ -583,6 +611,7 @@ class MeshShapeDistanceTraversalNodekIOS
 
   FCL_REAL BVDistanceLowerBound(unsigned int b1, unsigned int /*b2*/) const {
     if (this->enable_statistics) this->num_bv_tests++;
+    HPP_FCL_PROFILE_COUNT(num_bv_tests, 1);
     return distance(this->tf1.getRotation(), this->tf1.getTranslation(),
                     this->model2_bv, this->model1->getBV(b1).bv);
   }
@@ -613,6 +642,7 @@ class MeshShapeDistanceTraversalNodeOBBRSS
 
   FCL_REAL BVDistanceLowerBound(unsigned int b1, unsigned int /*b2*/) const {
     if (this->enable_statistics) this->num_bv_tests++;
+    HPP_FCL_PROFILE_COUNT(num_bv_tests, 1);
     return distance(this->tf1.getRotation(), this->tf1.getTranslation(),
                     this->model2_bv, this->model1->getBV(b1).bv);
   }
@@ -644,6 +674,7 @@ class ShapeMeshDistanceTraversalNode
   /// @brief Distance testing between leaves (one shape and one triangle)
   void leafComputeDistance(unsigned int /*b1*/, unsigned int b2) const {
     if (this->enable_statistics) this->num_leaf_tests++;
+    HPP_FCL_PROFILE_COUNT(num_leaf_tests, 1);
 
     const BVNode<BV>& node = this->model2->getBV(b2);
 
@@ -702,6 +733,7 @@ class ShapeMeshDistanceTraversalNodeRSS
 
   FCL_REAL BVDistanceLowerBound(unsigned int /*b1*/, unsigned int b2) const {
     if (this->enable_statistics) this->num_bv_tests++;
+    HPP_FCL_PROFILE_COUNT(num_bv_tests, 1);
     return distance(this->tf2.getRotation(), this->tf2.getTranslation(),
                     this->model1_bv, this->model2->getBV(b2).bv);
   }
@@ -732,6 +764,7 @@ class ShapeMeshDistanceTraversalNodekIOS
 
   FCL_REAL BVDistanceLowerBound(unsigned int /*b1*/, unsigned int b2) const {
     if (this->enable_statistics) this->num_bv_tests++;
+    HPP_FCL_PROFILE_COUNT(num_bv_tests, 1);
     return distance(this->tf2.getRotation(), this->tf2.getTranslation(),
                     this->model1_bv, this->model2->getBV(b2).bv);
   }
@@ -762,6 +795,7 @@ class ShapeMeshDistanceTraversalNodeOBBRSS
 
   FCL_REAL BVDistanceLowerBound(unsigned int /*b1*/, unsigned int b2) const {
     if (this->enable_statistics) this->num_bv_tests++;
+    HPP_FCL_PROFILE_COUNT(num_bv_tests, 1);
     return distance(this->tf2.getRotation(), this->tf2.getTranslation(),
                     this->model1_bv, this->model2->getBV(b2).bv);
   }
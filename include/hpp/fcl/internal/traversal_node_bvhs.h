@@ -153,6 +153,7 @@ class MeshCollisionTraversalNode : public BVHCollisionTraversalNode<BV> {
   bool BVDisjoints(unsigned int b1, unsigned int b2,
                    FCL_REAL& sqrDistLowerBound) const {
     if (this->enable_statistics) this->num_bv_tests++;
+    HPP_FCL_PROFILE_COUNT(num_bv_tests, 1);
     bool disjoint;
     if (RTIsIdentity)
       disjoint = !this->model1->getBV(b1).overlap(
@@ -185,6 +186,7 @@ class MeshCollisionTraversalNode : public BVHCollisionTraversalNode<BV> {
   void leafCollides(unsigned int b1, unsigned int b2,
                     FCL_REAL& sqrDistLowerBound) const {
     if (this->enable_statistics) this->num_leaf_tests++;
+    HPP_FCL_PROFILE_COUNT(num_leaf_tests, 1);
 
     const BVNode<BV>& node1 = this->model1->getBV(b1);
     const BVNode<BV>& node2 = this->model2->getBV(b2);
@@ -251,6 +253,45 @@ typedef MeshCollisionTraversalNode<RSS, 0> MeshCollisionTraversalNodeRSS;
 typedef MeshCollisionTraversalNode<kIOS, 0> MeshCollisionTraversalNodekIOS;
 typedef MeshCollisionTraversalNode<OBBRSS, 0> MeshCollisionTraversalNodeOBBRSS;
 
+/// @brief Traversal node for collision of a mesh with itself
+///
+/// The two models of the node are the same mesh at the same placement, so
+/// that the bounding volumes are tested in the frame of the mesh. Pairs of
+/// triangles sharing a vertex touch by construction and are skipped.
+template <typename BV>
+class MeshSelfCollisionTraversalNode
+    : public MeshCollisionTraversalNode<BV, RelativeTransformationIsIdentity> {
+ public:
+  typedef MeshCollisionTraversalNode<BV, RelativeTransformationIsIdentity>
+      Base;
+
+  MeshSelfCollisionTraversalNode(const CollisionRequest& request)
+      : Base(request) {}
+
+  /// @brief Whether the triangles of leaves b1 and b2 share a vertex
+  bool adjacent(unsigned int b1, unsigned int b2) const {
+    const Triangle& tri1 =
+        this->tri_indices1[this->model1->getBV(b1).primitiveId()];
+    const Triangle& tri2 =
+        this->tri_indices2[this->model2->getBV(b2).primitiveId()];
+    for (int i = 0; i < 3; ++i) {
+      if (tri1[i] == tri2[0] || tri1[i] == tri2[1] || tri1[i] == tri2[2])
+        return true;
+    }
+    return false;
+  }
+
+  /// Intersection testing between leaves, skipping adjacent triangles
+  void leafCollides(unsigned int b1, unsigned int b2,
+                    FCL_REAL& sqrDistLowerBound) const {
+    if (adjacent(b1, b2)) {
+      sqrDistLowerBound = std::numeric_limits<FCL_REAL>::infinity();
+      return;
+    }
+    Base::leafCollides(b1, b2, sqrDistLowerBound);
+  }
+};
+
 /// @}
 
 namespace details {
@@ -424,6 +465,7 @@ class MeshDistanceTraversalNode : public BVHDistanceTraversalNode<BV> {
   /// @brief BV culling test in one BVTT node
   FCL_REAL BVDistanceLowerBound(unsigned int b1, unsigned int b2) const {
     if (enable_statistics) num_bv_tests++;
+    HPP_FCL_PROFILE_COUNT(num_bv_tests, 1);
     if (RTIsIdentity)
       return details::DistanceTraversalBVDistanceLowerBound_impl<BV>::run(
           model1->getBV(b1), model2->getBV(b2));
@@ -435,6 +477,7 @@ class MeshDistanceTraversalNode : public BVHDistanceTraversalNode<BV> {
   /// @brief Distance testing between leaves (two triangles)
   void leafComputeDistance(unsigned int b1, unsigned int b2) const {
     if (this->enable_statistics) this->num_leaf_tests++;
+    HPP_FCL_PROFILE_COUNT(num_leaf_tests, 1);
 
     const BVNode<BV>& node1 = this->model1->getBV(b1);
     const BVNode<BV>& node2 = this->model2->getBV(b2);
@@ -453,8 +496,9 @@ class MeshDistanceTraversalNode : public BVHDistanceTraversalNode<BV> {
     const Vec3f& t22 = vertices2[tri_id2[1]];
     const Vec3f& t23 = vertices2[tri_id2[2]];
 
-    // nearest point pair
-    Vec3f P1, P2, normal;
+    // nearest point pair. The normal is not computed between triangles.
+    Vec3f P1, P2,
+        normal(Vec3f::Constant(std::numeric_limits<FCL_REAL>::quiet_NaN()));
 
     FCL_REAL d2;
     if (RTIsIdentity)
@@ -519,8 +563,8 @@ class MeshDistanceTraversalNode : public BVHDistanceTraversalNode<BV> {
     /// the points obtained by triDistance are not in world space: both are in
     /// object1's local coordinate system, so we need to convert them into the
     /// world space.
-    if (request.enable_nearest_points && (result->o1 == model1) &&
-        (result->o2 == model2)) {
+    if ((request.enable_nearest_points || request.enable_gradients) &&
+        (result->o1 == model1) && (result->o2 == model2)) {
       result->nearest_points[0] = tf1.transform(result->nearest_points[0]);
       result->nearest_points[1] = tf1.transform(result->nearest_points[1]);
     }
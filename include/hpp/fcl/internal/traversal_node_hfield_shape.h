@@ -223,6 +223,7 @@ class HeightFieldShapeCollisionTraversalNode
   bool BVDisjoints(unsigned int b1, unsigned int /*b2*/,
                    FCL_REAL& sqrDistLowerBound) const {
     if (this->enable_statistics) this->num_bv_tests++;
+    HPP_FCL_PROFILE_COUNT(num_bv_tests, 1);
 
     bool disjoint;
     if (RTIsIdentity) {
@@ -350,6 +351,7 @@ class HeightFieldShapeCollisionTraversalNode
   void leafCollides(unsigned int b1, unsigned int /*b2*/,
                     FCL_REAL& sqrDistLowerBound) const {
     if (this->enable_statistics) this->num_leaf_tests++;
+    HPP_FCL_PROFILE_COUNT(num_leaf_tests, 1);
     const HFNode<BV>& node = this->model1->getBV(b1);
 
     // Split quadrilateral primitives into two convex shapes corresponding to
@@ -468,6 +470,7 @@ class HeightFieldShapeDistanceTraversalNode : public DistanceTraversalNodeBase {
   /// @brief Distance testing between leaves (one triangle and one shape)
   void leafComputeDistance(unsigned int b1, unsigned int /*b2*/) const {
     if (this->enable_statistics) this->num_leaf_tests++;
+    HPP_FCL_PROFILE_COUNT(num_leaf_tests, 1);
 
     const BVNode<BV>& node = this->model1->getBV(b1);
 
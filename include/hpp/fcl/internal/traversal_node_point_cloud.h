@@ -0,0 +1,786 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HPP_FCL_TRAVERSAL_NODE_POINT_CLOUD_H
+#define HPP_FCL_TRAVERSAL_NODE_POINT_CLOUD_H
+
+/// @cond INTERNAL
+
+#include <hpp/fcl/collision_data.h>
+#include <hpp/fcl/hfield.h>
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+#include <hpp/fcl/narrowphase/narrowphase.h>
+#include <hpp/fcl/internal/shape_shape_func.h>
+#include <hpp/fcl/internal/traversal_node_bvhs.h>
+#include <hpp/fcl/internal/traversal_node_bvh_shape.h>
+#include <hpp/fcl/internal/traversal_node_hfield_shape.h>
+
+namespace hpp {
+namespace fcl {
+
+/// @addtogroup Traversal_For_Collision
+/// @{
+
+namespace details {
+/// @brief Whether a BVH model is a point cloud.
+inline bool isPointCloud(const CollisionGeometry* o) {
+  return static_cast<const BVHModelBase*>(o)->getModelType() ==
+         BVH_MODEL_POINTCLOUD;
+}
+
+/// @brief Lower bound of the distance between two bounding volumes expressed
+/// in the same frame.
+template <typename BV>
+FCL_REAL bvDistanceLowerBound(const BV& bv1, const BV& bv2) {
+  return bv1.distance(bv2);
+}
+
+template <>
+inline FCL_REAL bvDistanceLowerBound<OBB>(const OBB& bv1, const OBB& bv2) {
+  FCL_REAL sqrDistLowerBound;
+  CollisionRequest request(DISTANCE_LOWER_BOUND, 0);
+  if (bv1.overlap(bv2, request, sqrDistLowerBound)) return -1;
+  return sqrt(sqrDistLowerBound);
+}
+
+/// @brief Maximal number of points of the subtrees of a point cloud whose
+/// points are tested against a shape as one batch.
+static const unsigned int point_cloud_bucket_size = 16;
+
+/// @brief Points of a bucket, one per row, so that each coordinate is a
+/// contiguous vector.
+typedef Eigen::Matrix<FCL_REAL, Eigen::Dynamic, 3, Eigen::ColMajor,
+                      point_cloud_bucket_size, 3>
+    BucketPoints;
+typedef Eigen::Array<FCL_REAL, Eigen::Dynamic, 1, Eigen::ColMajor,
+                     point_cloud_bucket_size, 1>
+    BucketDistances;
+
+/// @brief Signed distances between the points of a bucket and a shape, for
+/// the shapes where it has a closed form. The points are expressed in the
+/// frame of the shape.
+template <typename S>
+struct BucketShapeDistance : std::false_type {};
+
+template <>
+struct BucketShapeDistance<Sphere> : std::true_type {
+  static void run(const Sphere& s, const BucketPoints& p,
+                  BucketDistances& d) {
+    d = p.array().square().rowwise().sum().sqrt() - s.radius;
+  }
+};
+
+template <>
+struct BucketShapeDistance<Box> : std::true_type {
+  static void run(const Box& s, const BucketPoints& p, BucketDistances& d) {
+    const BucketDistances q0(p.col(0).array().abs() - s.halfSide[0]),
+        q1(p.col(1).array().abs() - s.halfSide[1]),
+        q2(p.col(2).array().abs() - s.halfSide[2]);
+    d = (q0.max(0).square() + q1.max(0).square() + q2.max(0).square())
+            .sqrt() +
+        q0.max(q1).max(q2).min(0);
+  }
+};
+
+template <>
+struct BucketShapeDistance<Capsule> : std::true_type {
+  static void run(const Capsule& s, const BucketPoints& p,
+                  BucketDistances& d) {
+    const BucketDistances qz((p.col(2).array().abs() - s.halfLength).max(0));
+    d = (p.col(0).array().square() + p.col(1).array().square() + qz.square())
+            .sqrt() -
+        s.radius;
+  }
+};
+
+template <>
+struct BucketShapeDistance<Cylinder> : std::true_type {
+  static void run(const Cylinder& s, const BucketPoints& p,
+                  BucketDistances& d) {
+    const BucketDistances qr(
+        (p.col(0).array().square() + p.col(1).array().square()).sqrt() -
+        s.radius);
+    const BucketDistances qz(p.col(2).array().abs() - s.halfLength);
+    d = (qr.max(0).square() + qz.max(0).square()).sqrt() + qr.max(qz).min(0);
+  }
+};
+
+template <>
+struct BucketShapeDistance<Halfspace> : std::true_type {
+  static void run(const Halfspace& s, const BucketPoints& p,
+                  BucketDistances& d) {
+    d = (p * s.n).array() - s.d;
+  }
+};
+
+/// @brief Gather the points of the subtree of a point cloud rooted at b, in
+/// the order of the traversal, and express them in the frame tf.
+/// @return the number of points, at most point_cloud_bucket_size.
+template <typename BV>
+unsigned int gatherBucket(const BVHModel<BV>& model, unsigned int b,
+                          const Transform3f& tf, int* ids,
+                          BucketPoints& points) {
+  unsigned int stack[point_cloud_bucket_size + 1];
+  unsigned int size = 0, n = 0;
+  stack[size++] = b;
+  points.resize(model.getBV(b).num_primitives, 3);
+  while (size > 0) {
+    const BVNode<BV>& node = model.getBV(stack[--size]);
+    if (node.isLeaf()) {
+      ids[n] = node.primitiveId();
+      points.row(n) = model.vertices[ids[n]].transpose();
+      ++n;
+    } else {
+      stack[size++] = (unsigned int)node.rightChild();
+      stack[size++] = (unsigned int)node.leftChild();
+    }
+  }
+  assert(n == (unsigned int)points.rows());
+  // Transform the whole bucket at once rather than point by point.
+  points = (points * tf.getRotation().transpose()).rowwise() +
+           tf.getTranslation().transpose();
+  return n;
+}
+
+/// @brief Distance between the primitive id1 of model1 and the primitive id2
+/// of model2. The primitive of a point cloud is a sphere of radius
+/// BVHModelBase::point_radius centered at the point, the one of a mesh is a
+/// triangle.
+/// @return the signed distance, p1 and p2 are the nearest points and normal
+///         goes from model1 to model2, all expressed in the world frame.
+inline FCL_REAL bvhPrimitiveDistance(const GJKSolver* nsolver,
+                                     const BVHModelBase& model1,
+                                     const Transform3f& tf1, int id1,
+                                     const BVHModelBase& model2,
+                                     const Transform3f& tf2, int id2,
+                                     Vec3f& p1, Vec3f& p2, Vec3f& normal) {
+  FCL_REAL distance;
+  const bool cloud1 = model1.getModelType() == BVH_MODEL_POINTCLOUD;
+  const bool cloud2 = model2.getModelType() == BVH_MODEL_POINTCLOUD;
+  if (cloud1 && cloud2) {
+    nsolver->shapeDistance(
+        Sphere(model1.point_radius),
+        Transform3f(tf1.transform(model1.vertices[id1])),
+        Sphere(model2.point_radius),
+        Transform3f(tf2.transform(model2.vertices[id2])), distance, p1, p2,
+        normal);
+  } else if (cloud1) {
+    const Triangle& tri = model2.tri_indices[id2];
+    nsolver->shapeTriangleInteraction(
+        Sphere(model1.point_radius),
+        Transform3f(tf1.transform(model1.vertices[id1])),
+        model2.vertices[tri[0]], model2.vertices[tri[1]],
+        model2.vertices[tri[2]], tf2, distance, p1, p2, normal);
+  } else {
+    assert(cloud2);
+    const Triangle& tri = model1.tri_indices[id1];
+    nsolver->shapeTriangleInteraction(
+        Sphere(model2.point_radius),
+        Transform3f(tf2.transform(model2.vertices[id2])),
+        model1.vertices[tri[0]], model1.vertices[tri[1]],
+        model1.vertices[tri[2]], tf1, distance, p2, p1, normal);
+    normal *= -1;
+  }
+  return distance;
+}
+}  // namespace details
+
+/// @brief Traversal node for collision between a point cloud and a shape
+///
+/// Each point is a sphere of radius BVHModelBase::point_radius. The bounding
+/// volume of the shape is computed in the frame of the point cloud, so that
+/// the bounding volumes are compared without moving the points, and the
+/// bounding volume tests are inflated by the point radius.
+template <typename BV, typename S>
+class PointCloudShapeCollisionTraversalNode
+    : public BVHShapeCollisionTraversalNode<BV, S> {
+ public:
+  PointCloudShapeCollisionTraversalNode(const CollisionRequest& request)
+      : BVHShapeCollisionTraversalNode<BV, S>(request),
+        point(0),
+        bv_request(request) {
+    nsolver = NULL;
+  }
+
+  /// test between BV b1 and shape
+  /// @param b1 BV to test,
+  /// @retval sqrDistLowerBound square of a lower bound of the minimal
+  ///         distance between bounding volumes.
+  bool BVDisjoints(unsigned int b1, unsigned int /*b2*/,
+                   FCL_REAL& sqrDistLowerBound) const {
+    if (this->enable_statistics) this->num_bv_tests++;
+    HPP_FCL_PROFILE_COUNT(num_bv_tests, 1);
+    const bool disjoint = !this->model1->getBV(b1).bv.overlap(
+        this->model2_bv, bv_request, sqrDistLowerBound);
+    if (disjoint)
+      internal::updateDistanceLowerBoundFromBV(this->request, *this->result,
+                                               sqrDistLowerBound);
+    else
+      // The inflated bounding volume tests may leave a positive value.
+      sqrDistLowerBound = 0;
+    return disjoint;
+  }
+
+  /// @brief Whether the BV node in the point cloud is a leaf, or the root
+  /// of a subtree small enough to be tested as one batch.
+  bool isFirstNodeLeaf(unsigned int b) const {
+    const BVNode<BV>& node = this->model1->getBV(b);
+    return node.isLeaf() ||
+           (details::BucketShapeDistance<S>::value &&
+            node.num_primitives <= details::point_cloud_bucket_size);
+  }
+
+  /// @brief Intersection testing between leaves (points and one shape)
+  void leafCollides(unsigned int b1, unsigned int b2,
+                    FCL_REAL& sqrDistLowerBound) const {
+    if (this->model1->getBV(b1).isLeaf()) {
+      pointCollides(this->model1->getBV(b1).primitiveId(), sqrDistLowerBound);
+      return;
+    }
+    leafBucketCollides(b1, b2, sqrDistLowerBound,
+                       details::BucketShapeDistance<S>());
+  }
+
+  /// @brief The sphere of the points, centered at the origin.
+  Sphere point;
+  /// @brief Request of the bounding volume tests, whose security margin is
+  /// increased by the point radius.
+  CollisionRequest bv_request;
+
+  const GJKSolver* nsolver;
+
+ private:
+  /// @brief Intersection testing between one point and the shape
+  void pointCollides(int primitive_id, FCL_REAL& sqrDistLowerBound) const {
+    if (this->enable_statistics) this->num_leaf_tests++;
+    HPP_FCL_PROFILE_COUNT(num_leaf_tests, 1);
+
+    const Transform3f tf_point(
+        this->tf1.transform(this->model1->vertices[primitive_id]));
+
+    if (details::overlapCollide(nsolver, point, tf_point, *(this->model2),
+                                this->tf2, this->model1, primitive_id,
+                                this->model2, Contact::NONE, this->request,
+                                *this->result, sqrDistLowerBound))
+      return;
+
+    DistanceRequest distanceRequest(true);
+    DistanceResult distanceResult;
+    const FCL_REAL distance = ShapeShapeDistance<Sphere, S>(
+        &point, tf_point, this->model2, this->tf2, nsolver, distanceRequest,
+        distanceResult);
+    const Vec3f& c1 = distanceResult.nearest_points[0];
+    const Vec3f& c2 = distanceResult.nearest_points[1];
+
+    FCL_REAL distToCollision = distance - this->request.security_margin;
+    if (distToCollision <= this->request.collision_distance_threshold) {
+      sqrDistLowerBound = 0;
+      if (this->request.num_max_contacts > this->result->numContacts()) {
+        const Vec3f normal(distance <= 0 ? distanceResult.normal
+                                         : Vec3f((c2 - c1).normalized()));
+        this->result->addContact(Contact(this->model1, this->model2,
+                                         primitive_id, Contact::NONE,
+                                         .5 * (c1 + c2), normal, -distance));
+      }
+    } else
+      sqrDistLowerBound = distToCollision * distToCollision;
+
+    internal::updateDistanceLowerBoundFromLeaf(this->request, *this->result,
+                                               distToCollision, c1, c2);
+  }
+
+  void leafBucketCollides(unsigned int, unsigned int, FCL_REAL&,
+                          std::false_type) const {
+    assert(false && "no batched distance for this shape");
+  }
+
+  /// @brief Intersection testing between the points of a bucket and the
+  /// shape. The signed distances of all the points are computed at once, and
+  /// only the points in collision, and the closest one, go through the
+  /// point test, which fills the result.
+  void leafBucketCollides(unsigned int b1, unsigned int b2,
+                          FCL_REAL& sqrDistLowerBound, std::true_type) const {
+    if (BVDisjoints(b1, b2, sqrDistLowerBound)) return;
+
+    int ids[details::point_cloud_bucket_size];
+    details::BucketPoints points;
+    details::BucketDistances distances;
+    const unsigned int n = details::gatherBucket(
+        *this->model1, b1, this->tf2.inverseTimes(this->tf1), ids, points);
+    details::BucketShapeDistance<S>::run(*(this->model2), points, distances);
+    distances -= point.radius + this->request.security_margin;
+
+    // The closed forms and the point test may round differently.
+    const FCL_REAL tolerance =
+        std::sqrt(std::numeric_limits<FCL_REAL>::epsilon());
+    sqrDistLowerBound = (std::numeric_limits<FCL_REAL>::max)();
+    FCL_REAL sqrDist;
+    unsigned int closest = n;
+    for (unsigned int i = 0; i < n; ++i) {
+      if (distances[i] <=
+          this->request.collision_distance_threshold + tolerance) {
+        pointCollides(ids[i], sqrDist);
+        sqrDistLowerBound = (std::min)(sqrDistLowerBound, sqrDist);
+        if (this->request.isSatisfied(*this->result)) return;
+      } else if (closest == n || distances[i] < distances[closest])
+        closest = i;
+    }
+    if (closest == n) return;
+    // The distance lower bound of the result comes from the closest point.
+    sqrDist = distances[closest] * distances[closest];
+    if (distances[closest] - tolerance < this->result->distance_lower_bound)
+      pointCollides(ids[closest], sqrDist);
+    sqrDistLowerBound = (std::min)(sqrDistLowerBound, sqrDist);
+  }
+};
+
+/// @brief Traversal node for collision between a point cloud and a BVH model,
+/// which is either a point cloud or a mesh.
+template <typename BV, int _Options = RelativeTransformationIsIdentity>
+class PointCloudCollisionTraversalNode : public BVHCollisionTraversalNode<BV> {
+ public:
+  enum {
+    Options = _Options,
+    RTIsIdentity = _Options & RelativeTransformationIsIdentity
+  };
+
+  PointCloudCollisionTraversalNode(const CollisionRequest& request)
+      : BVHCollisionTraversalNode<BV>(request), bv_request(request) {
+    nsolver = NULL;
+  }
+
+  /// BV test between b1 and b2
+  /// @param b1, b2 Bounding volumes to test,
+  /// @retval sqrDistLowerBound square of a lower bound of the minimal
+  ///         distance between bounding volumes.
+  bool BVDisjoints(unsigned int b1, unsigned int b2,
+                   FCL_REAL& sqrDistLowerBound) const {
+    if (this->enable_statistics) this->num_bv_tests++;
+    HPP_FCL_PROFILE_COUNT(num_bv_tests, 1);
+    bool disjoint;
+    if (RTIsIdentity)
+      disjoint = !this->model1->getBV(b1).overlap(
+          this->model2->getBV(b2), bv_request, sqrDistLowerBound);
+    else
+      disjoint = !overlap(RT._R(), RT._T(), this->model2->getBV(b2).bv,
+                          this->model1->getBV(b1).bv, bv_request,
+                          sqrDistLowerBound);
+    if (disjoint)
+      internal::updateDistanceLowerBoundFromBV(this->request, *this->result,
+                                               sqrDistLowerBound);
+    else
+      // The inflated bounding volume tests may leave a positive value.
+      sqrDistLowerBound = 0;
+    return disjoint;
+  }
+
+  /// @brief Intersection testing between leaves (two points, or one point
+  /// and one triangle)
+  void leafCollides(unsigned int b1, unsigned int b2,
+                    FCL_REAL& sqrDistLowerBound) const {
+    if (this->enable_statistics) this->num_leaf_tests++;
+    HPP_FCL_PROFILE_COUNT(num_leaf_tests, 1);
+
+    const int primitive_id1 = this->model1->getBV(b1).primitiveId();
+    const int primitive_id2 = this->model2->getBV(b2).primitiveId();
+
+    Vec3f p1, p2, normal;
+    const FCL_REAL distance = details::bvhPrimitiveDistance(
+        nsolver, *this->model1, this->tf1, primitive_id1, *this->model2,
+        this->tf2, primitive_id2, p1, p2, normal);
+
+    const FCL_REAL distToCollision = distance - this->request.security_margin;
+    if (distToCollision <= this->request.collision_distance_threshold) {
+      sqrDistLowerBound = 0;
+      if (this->result->numContacts() < this->request.num_max_contacts) {
+        Vec3f p(p1);
+        if (distance > 0) {
+          normal = (p2 - p1).normalized();
+          p = .5 * (p1 + p2);
+        }
+        this->result->addContact(Contact(this->model1, this->model2,
+                                         primitive_id1, primitive_id2, p,
+                                         normal, -distance));
+      }
+    } else
+      sqrDistLowerBound = distToCollision * distToCollision;
+
+    internal::updateDistanceLowerBoundFromLeaf(this->request, *this->result,
+                                               distToCollision, p1, p2);
+  }
+
+  /// @brief Request of the bounding volume tests, whose security margin is
+  /// increased by the point radii of the models.
+  CollisionRequest bv_request;
+
+  const GJKSolver* nsolver;
+
+  details::RelativeTransformation<!bool(RTIsIdentity)> RT;
+};
+
+/// @brief Traversal node for collision between a point cloud and a height
+/// field.
+///
+/// The bounding volumes of the height field are tested in the frame of the
+/// point cloud. Each point is tested against the two convex prisms of the
+/// height field cell.
+template <typename BV>
+class PointCloudHeightFieldCollisionTraversalNode
+    : public CollisionTraversalNodeBase {
+ public:
+  PointCloudHeightFieldCollisionTraversalNode(const CollisionRequest& request)
+      : CollisionTraversalNodeBase(request), point(0), bv_request(request) {
+    model1 = NULL;
+    model2 = NULL;
+    nsolver = NULL;
+
+    num_bv_tests = 0;
+    num_leaf_tests = 0;
+    query_time_seconds = 0.0;
+  }
+
+  /// @brief Whether the BV node in the point cloud is leaf
+  bool isFirstNodeLeaf(unsigned int b) const {
+    return model1->getBV(b).isLeaf();
+  }
+
+  /// @brief Whether the BV node in the height field is leaf
+  bool isSecondNodeLeaf(unsigned int b) const {
+    return model2->getBV(b).isLeaf();
+  }
+
+  /// @brief Determine the traversal order, is the first BVTT subtree better
+  bool firstOverSecond(unsigned int b1, unsigned int b2) const {
+    FCL_REAL sz1 = model1->getBV(b1).bv.size();
+    FCL_REAL sz2 = model2->getBV(b2).bv.size();
+
+    bool l1 = model1->getBV(b1).isLeaf();
+    bool l2 = model2->getBV(b2).isLeaf();
+
+    if (l2 || (!l1 && (sz1 > sz2))) return true;
+    return false;
+  }
+
+  /// @brief Obtain the left child of BV node in the point cloud
+  int getFirstLeftChild(unsigned int b) const {
+    return model1->getBV(b).leftChild();
+  }
+
+  /// @brief Obtain the right child of BV node in the point cloud
+  int getFirstRightChild(unsigned int b) const {
+    return model1->getBV(b).rightChild();
+  }
+
+  /// @brief Obtain the left child of BV node in the height field
+  int getSecondLeftChild(unsigned int b) const {
+    return static_cast<int>(model2->getBV(b).leftChild());
+  }
+
+  /// @brief Obtain the right child of BV node in the height field
+  int getSecondRightChild(unsigned int b) const {
+    return static_cast<int>(model2->getBV(b).rightChild());
+  }
+
+  /// BV test between b1 and b2
+  /// @param b1, b2 Bounding volumes to test,
+  /// @retval sqrDistLowerBound square of a lower bound of the minimal
+  ///         distance between bounding volumes.
+  bool BVDisjoints(unsigned int b1, unsigned int b2,
+                   FCL_REAL& sqrDistLowerBound) const {
+    if (this->enable_statistics) this->num_bv_tests++;
+    HPP_FCL_PROFILE_COUNT(num_bv_tests, 1);
+    const bool disjoint =
+        !overlap(RT._R(), RT._T(), model2->getBV(b2).bv, model1->getBV(b1).bv,
+                 bv_request, sqrDistLowerBound);
+    if (disjoint)
+      internal::updateDistanceLowerBoundFromBV(this->request, *this->result,
+                                               sqrDistLowerBound);
+    else
+      // The inflated bounding volume tests may leave a positive value.
+      sqrDistLowerBound = 0;
+    return disjoint;
+  }
+
+  /// @brief Intersection testing between leaves (one point and one cell)
+  void leafCollides(unsigned int b1, unsigned int b2,
+                    FCL_REAL& sqrDistLowerBound) const {
+    if (this->enable_statistics) this->num_leaf_tests++;
+    HPP_FCL_PROFILE_COUNT(num_leaf_tests, 1);
+
+    const int primitive_id = model1->getBV(b1).primitiveId();
+    const Transform3f tf_point(
+        this->tf1.transform(model1->vertices[primitive_id]));
+
+    typedef Convex<Triangle> ConvexTriangle;
+    ConvexTriangle convex1, convex2;
+    details::buildConvexTriangles(model2->getBV(b2), *model2, convex1,
+                                  convex2);
+
+    FCL_REAL distance, distance2;
+    Vec3f c1, c2, normal, c1_2, c2_2, normal2;
+    nsolver->shapeDistance(point, tf_point, convex1, this->tf2, distance, c1,
+                           c2, normal);
+    nsolver->shapeDistance(point, tf_point, convex2, this->tf2, distance2,
+                           c1_2, c2_2, normal2);
+    if (distance2 < distance) {
+      distance = distance2;
+      c1 = c1_2;
+      c2 = c2_2;
+      normal = normal2;
+    }
+
+    FCL_REAL distToCollision = distance - this->request.security_margin;
+    if (distToCollision <= this->request.collision_distance_threshold) {
+      sqrDistLowerBound = 0;
+      if (this->request.num_max_contacts > this->result->numContacts()) {
+        if (distance > 0) normal = (c2 - c1).normalized();
+        this->result->addContact(Contact(model1, model2, primitive_id, (int)b2,
+                                         .5 * (c1 + c2), normal, -distance));
+      }
+    } else
+      sqrDistLowerBound = distToCollision * distToCollision;
+
+    internal::updateDistanceLowerBoundFromLeaf(this->request, *this->result,
+                                               distToCollision, c1, c2);
+  }
+
+  /// @brief The point cloud
+  const BVHModel<BV>* model1;
+  /// @brief The height field
+  const HeightField<BV>* model2;
+
+  /// @brief The sphere of the points, centered at the origin.
+  Sphere point;
+  /// @brief Request of the bounding volume tests, whose security margin is
+  /// increased by the point radius.
+  CollisionRequest bv_request;
+
+  const GJKSolver* nsolver;
+
+  /// @brief Placement of the height field in the frame of the point cloud
+  details::RelativeTransformation<true> RT;
+
+  mutable int num_bv_tests;
+  mutable int num_leaf_tests;
+  mutable FCL_REAL query_time_seconds;
+};
+
+/// @}
+
+/// @addtogroup Traversal_For_Distance
+/// @{
+
+/// @brief Traversal node for distance computation between a point cloud and
+/// a shape
+template <typename BV, typename S>
+class PointCloudShapeDistanceTraversalNode
+    : public BVHShapeDistanceTraversalNode<BV, S> {
+ public:
+  PointCloudShapeDistanceTraversalNode()
+      : BVHShapeDistanceTraversalNode<BV, S>(), point(0) {
+    rel_err = 0;
+    abs_err = 0;
+
+    nsolver = NULL;
+  }
+
+  /// @brief BV culling test in one BVTT node
+  FCL_REAL BVDistanceLowerBound(unsigned int b1, unsigned int /*b2*/) const {
+    if (this->enable_statistics) this->num_bv_tests++;
+    HPP_FCL_PROFILE_COUNT(num_bv_tests, 1);
+    return details::bvDistanceLowerBound(this->model1->getBV(b1).bv,
+                                         this->model2_bv) -
+           point.radius;
+  }
+
+  /// @brief Whether the BV node in the point cloud is a leaf, or the root
+  /// of a subtree small enough to be tested as one batch.
+  bool isFirstNodeLeaf(unsigned int b) const {
+    const BVNode<BV>& node = this->model1->getBV(b);
+    return node.isLeaf() ||
+           (details::BucketShapeDistance<S>::value &&
+            node.num_primitives <= details::point_cloud_bucket_size);
+  }
+
+  /// @brief Distance testing between leaves (points and one shape)
+  void leafComputeDistance(unsigned int b1, unsigned int /*b2*/) const {
+    if (this->model1->getBV(b1).isLeaf())
+      pointComputeDistance(this->model1->getBV(b1).primitiveId());
+    else
+      leafBucketComputeDistance(b1, details::BucketShapeDistance<S>());
+  }
+
+  /// @brief Whether the traversal process can stop early
+  bool canStop(FCL_REAL c) const {
+    if ((c >= this->result->min_distance - abs_err) &&
+        (c * (1 + rel_err) >= this->result->min_distance))
+      return true;
+    return false;
+  }
+
+  /// @brief The sphere of the points, centered at the origin.
+  Sphere point;
+
+  FCL_REAL rel_err;
+  FCL_REAL abs_err;
+
+  const GJKSolver* nsolver;
+
+ private:
+  /// @brief Distance testing between one point and the shape
+  void pointComputeDistance(int primitive_id) const {
+    if (this->enable_statistics) this->num_leaf_tests++;
+    HPP_FCL_PROFILE_COUNT(num_leaf_tests, 1);
+
+    const Transform3f tf_point(
+        this->tf1.transform(this->model1->vertices[primitive_id]));
+
+    DistanceRequest distanceRequest(true);
+    DistanceResult distanceResult;
+    const FCL_REAL d = ShapeShapeDistance<Sphere, S>(
+        &point, tf_point, this->model2, this->tf2, nsolver, distanceRequest,
+        distanceResult);
+
+    this->result->update(d, this->model1, this->model2, primitive_id,
+                         DistanceResult::NONE, distanceResult.nearest_points[0],
+                         distanceResult.nearest_points[1],
+                         distanceResult.normal);
+  }
+
+  void leafBucketComputeDistance(unsigned int, std::false_type) const {
+    assert(false && "no batched distance for this shape");
+  }
+
+  /// @brief Distance testing between the points of a bucket and the shape.
+  /// The distances of all the points are computed at once, and only the
+  /// closest point goes through the point test, which fills the result.
+  void leafBucketComputeDistance(unsigned int b1, std::true_type) const {
+    int ids[details::point_cloud_bucket_size];
+    details::BucketPoints points;
+    details::BucketDistances distances;
+    details::gatherBucket(*this->model1, b1,
+                          this->tf2.inverseTimes(this->tf1), ids, points);
+    details::BucketShapeDistance<S>::run(*(this->model2), points, distances);
+
+    // The closed forms and the point test may round differently.
+    const FCL_REAL tolerance =
+        std::sqrt(std::numeric_limits<FCL_REAL>::epsilon());
+    Eigen::DenseIndex closest;
+    if (distances.minCoeff(&closest) - point.radius - tolerance <
+        this->result->min_distance)
+      pointComputeDistance(ids[closest]);
+  }
+};
+
+/// @brief Traversal node for distance computation between a point cloud and
+/// a BVH model, which is either a point cloud or a mesh.
+template <typename BV, int _Options = RelativeTransformationIsIdentity>
+class PointCloudDistanceTraversalNode : public BVHDistanceTraversalNode<BV> {
+ public:
+  enum {
+    Options = _Options,
+    RTIsIdentity = _Options & RelativeTransformationIsIdentity
+  };
+
+  PointCloudDistanceTraversalNode() : BVHDistanceTraversalNode<BV>() {
+    bv_inflation = 0;
+    rel_err = 0;
+    abs_err = 0;
+
+    nsolver = NULL;
+  }
+
+  /// @brief BV culling test in one BVTT node
+  FCL_REAL BVDistanceLowerBound(unsigned int b1, unsigned int b2) const {
+    if (this->enable_statistics) this->num_bv_tests++;
+    HPP_FCL_PROFILE_COUNT(num_bv_tests, 1);
+    if (RTIsIdentity)
+      return details::DistanceTraversalBVDistanceLowerBound_impl<BV>::run(
+                 this->model1->getBV(b1), this->model2->getBV(b2)) -
+             bv_inflation;
+    else
+      return details::DistanceTraversalBVDistanceLowerBound_impl<BV>::run(
+                 RT._R(), RT._T(), this->model1->getBV(b1),
+                 this->model2->getBV(b2)) -
+             bv_inflation;
+  }
+
+  /// @brief Distance testing between leaves (two points, or one point and
+  /// one triangle)
+  void leafComputeDistance(unsigned int b1, unsigned int b2) const {
+    if (this->enable_statistics) this->num_leaf_tests++;
+    HPP_FCL_PROFILE_COUNT(num_leaf_tests, 1);
+
+    const int primitive_id1 = this->model1->getBV(b1).primitiveId();
+    const int primitive_id2 = this->model2->getBV(b2).primitiveId();
+
+    Vec3f p1, p2, normal;
+    const FCL_REAL d = details::bvhPrimitiveDistance(
+        nsolver, *this->model1, this->tf1, primitive_id1, *this->model2,
+        this->tf2, primitive_id2, p1, p2, normal);
+
+    this->result->update(d, this->model1, this->model2, primitive_id1,
+                         primitive_id2, p1, p2, normal);
+  }
+
+  /// @brief Whether the traversal process can stop early
+  bool canStop(FCL_REAL c) const {
+    if ((c >= this->result->min_distance - abs_err) &&
+        (c * (1 + rel_err) >= this->result->min_distance))
+      return true;
+    return false;
+  }
+
+  /// @brief Sum of the point radii of the models, subtracted from the
+  /// distance between bounding volumes.
+  FCL_REAL bv_inflation;
+
+  FCL_REAL rel_err;
+  FCL_REAL abs_err;
+
+  const GJKSolver* nsolver;
+
+  details::RelativeTransformation<!bool(RTIsIdentity)> RT;
+};
+
+/// @}
+
+}  // namespace fcl
+
+}  // namespace hpp
+
+/// @endcond
+
+#endif
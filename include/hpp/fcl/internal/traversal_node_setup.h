@@ -48,6 +48,7 @@
 
 // #include <hpp/fcl/internal/traversal_node_hfields.h>
 #include <hpp/fcl/internal/traversal_node_hfield_shape.h>
+#include <hpp/fcl/internal/traversal_node_point_cloud.h>
 
 #ifdef HPP_FCL_HAS_OCTOMAP
 #include <hpp/fcl/internal/traversal_node_octree.h>
@@ -514,6 +515,27 @@ bool initialize(MeshCollisionTraversalNode<BV, 0>& node,
   return true;
 }
 
+/// @brief Initialize traversal node for collision of a mesh with itself
+template <typename BV>
+bool initialize(MeshSelfCollisionTraversalNode<BV>& node,
+                const BVHModel<BV>& model, const Transform3f& tf,
+                CollisionResult& result) {
+  if (model.getModelType() != BVH_MODEL_TRIANGLES)
+    HPP_FCL_THROW_PRETTY(
+        "model should be of type BVHModelType::BVH_MODEL_TRIANGLES.",
+        std::invalid_argument)
+
+  node.vertices1 = node.vertices2 = model.vertices;
+  node.tri_indices1 = node.tri_indices2 = model.tri_indices;
+
+  node.model1 = node.model2 = &model;
+  node.tf1 = node.tf2 = tf;
+
+  node.result = &result;
+
+  return true;
+}
+
 /// @brief Initialize traversal node for distance between two geometric shapes
 template <typename S1, typename S2>
 bool initialize(ShapeDistanceTraversalNode<S1, S2>& node, const S1& shape1,
@@ -854,6 +876,259 @@ bool initialize(ShapeMeshDistanceTraversalNodeOBBRSS<S>& node, const S& model1,
       node, model1, tf1, model2, tf2, nsolver, request, result);
 }
 
+namespace details {
+/// @brief Check that two BVH models can be handled by the point cloud
+/// traversal nodes: one of them at least is a point cloud, and the other one
+/// is a point cloud or a mesh.
+inline void checkPointCloudModels(const BVHModelBase& model1,
+                                  const BVHModelBase& model2) {
+  if (model1.getModelType() != BVH_MODEL_POINTCLOUD &&
+      model2.getModelType() != BVH_MODEL_POINTCLOUD)
+    HPP_FCL_THROW_PRETTY(
+        "model1 or model2 should be of type "
+        "BVHModelType::BVH_MODEL_POINTCLOUD.",
+        std::invalid_argument)
+  if (model1.getModelType() == BVH_MODEL_UNKNOWN ||
+      model2.getModelType() == BVH_MODEL_UNKNOWN)
+    HPP_FCL_THROW_PRETTY(
+        "model1 and model2 should be of type "
+        "BVHModelType::BVH_MODEL_POINTCLOUD or "
+        "BVHModelType::BVH_MODEL_TRIANGLES.",
+        std::invalid_argument)
+}
+
+/// @brief Radius of the primitives of a BVH model: the point radius for a
+/// point cloud, zero for a mesh.
+inline FCL_REAL primitiveRadius(const BVHModelBase& model) {
+  return model.getModelType() == BVH_MODEL_POINTCLOUD ? model.point_radius
+                                                      : 0;
+}
+
+/// @brief Move the vertices of a BVH model by its placement, which is then
+/// set to identity.
+template <typename BV>
+void applyPlacement(BVHModel<BV>& model, Transform3f& tf, bool use_refit,
+                    bool refit_bottomup) {
+  if (tf.isIdentity()) return;
+  std::vector<Vec3f> vertices_transformed(model.num_vertices);
+  for (unsigned int i = 0; i < model.num_vertices; ++i)
+    vertices_transformed[i] = tf.transform(model.vertices[i]);
+
+  model.beginReplaceModel();
+  model.replaceSubModel(vertices_transformed);
+  model.endReplaceModel(use_refit, refit_bottomup);
+
+  tf.setIdentity();
+}
+}  // namespace details
+
+/// @brief Initialize traversal node for collision between a point cloud and a
+/// shape
+template <typename BV, typename S>
+bool initialize(PointCloudShapeCollisionTraversalNode<BV, S>& node,
+                const BVHModel<BV>& model1, const Transform3f& tf1,
+                const S& model2, const Transform3f& tf2,
+                const GJKSolver* nsolver, CollisionResult& result) {
+  if (model1.getModelType() != BVH_MODEL_POINTCLOUD)
+    HPP_FCL_THROW_PRETTY(
+        "model1 should be of type BVHModelType::BVH_MODEL_POINTCLOUD.",
+        std::invalid_argument)
+
+  node.model1 = &model1;
+  node.tf1 = tf1;
+  node.model2 = &model2;
+  node.tf2 = tf2;
+  node.nsolver = nsolver;
+
+  node.point.radius = model1.point_radius;
+  node.bv_request.security_margin += model1.point_radius;
+  computeBV(model2, tf1.inverseTimes(tf2), node.model2_bv);
+
+  node.result = &result;
+
+  return true;
+}
+
+/// @brief Initialize traversal node for collision between a point cloud and a
+/// BVH model, given the current transforms
+template <typename BV>
+bool initialize(
+    PointCloudCollisionTraversalNode<BV, RelativeTransformationIsIdentity>&
+        node,
+    BVHModel<BV>& model1, Transform3f& tf1, BVHModel<BV>& model2,
+    Transform3f& tf2, const GJKSolver* nsolver, CollisionResult& result,
+    bool use_refit = false, bool refit_bottomup = false) {
+  details::checkPointCloudModels(model1, model2);
+
+  details::applyPlacement(model1, tf1, use_refit, refit_bottomup);
+  details::applyPlacement(model2, tf2, use_refit, refit_bottomup);
+
+  node.model1 = &model1;
+  node.tf1 = tf1;
+  node.model2 = &model2;
+  node.tf2 = tf2;
+  node.nsolver = nsolver;
+
+  node.bv_request.security_margin +=
+      details::primitiveRadius(model1) + details::primitiveRadius(model2);
+
+  node.result = &result;
+
+  return true;
+}
+
+/// @brief Initialize traversal node for collision between a point cloud and a
+/// BVH model
+template <typename BV>
+bool initialize(PointCloudCollisionTraversalNode<BV, 0>& node,
+                const BVHModel<BV>& model1, const Transform3f& tf1,
+                const BVHModel<BV>& model2, const Transform3f& tf2,
+                const GJKSolver* nsolver, CollisionResult& result) {
+  details::checkPointCloudModels(model1, model2);
+
+  node.model1 = &model1;
+  node.tf1 = tf1;
+  node.model2 = &model2;
+  node.tf2 = tf2;
+  node.nsolver = nsolver;
+
+  node.bv_request.security_margin +=
+      details::primitiveRadius(model1) + details::primitiveRadius(model2);
+
+  node.result = &result;
+
+  node.RT.R.noalias() = tf1.getRotation().transpose() * tf2.getRotation();
+  node.RT.T.noalias() = tf1.getRotation().transpose() *
+                        (tf2.getTranslation() - tf1.getTranslation());
+
+  return true;
+}
+
+/// @brief Initialize traversal node for collision between a point cloud and a
+/// height field
+template <typename BV>
+bool initialize(PointCloudHeightFieldCollisionTraversalNode<BV>& node,
+                const BVHModel<BV>& model1, const Transform3f& tf1,
+                const HeightField<BV>& model2, const Transform3f& tf2,
+                const GJKSolver* nsolver, CollisionResult& result) {
+  if (model1.getModelType() != BVH_MODEL_POINTCLOUD)
+    HPP_FCL_THROW_PRETTY(
+        "model1 should be of type BVHModelType::BVH_MODEL_POINTCLOUD.",
+        std::invalid_argument)
+
+  node.model1 = &model1;
+  node.tf1 = tf1;
+  node.model2 = &model2;
+  node.tf2 = tf2;
+  node.nsolver = nsolver;
+
+  node.point.radius = model1.point_radius;
+  node.bv_request.security_margin += model1.point_radius;
+
+  node.result = &result;
+
+  node.RT.R.noalias() = tf1.getRotation().transpose() * tf2.getRotation();
+  node.RT.T.noalias() = tf1.getRotation().transpose() *
+                        (tf2.getTranslation() - tf1.getTranslation());
+
+  return true;
+}
+
+/// @brief Initialize traversal node for distance computation between a point
+/// cloud and a shape
+template <typename BV, typename S>
+bool initialize(PointCloudShapeDistanceTraversalNode<BV, S>& node,
+                const BVHModel<BV>& model1, const Transform3f& tf1,
+                const S& model2, const Transform3f& tf2,
+                const GJKSolver* nsolver, const DistanceRequest& request,
+                DistanceResult& result) {
+  if (model1.getModelType() != BVH_MODEL_POINTCLOUD)
+    HPP_FCL_THROW_PRETTY(
+        "model1 should be of type BVHModelType::BVH_MODEL_POINTCLOUD.",
+        std::invalid_argument)
+
+  node.request = request;
+  node.result = &result;
+
+  node.model1 = &model1;
+  node.tf1 = tf1;
+  node.model2 = &model2;
+  node.tf2 = tf2;
+  node.nsolver = nsolver;
+
+  node.rel_err = request.rel_err;
+  node.abs_err = request.abs_err;
+
+  node.point.radius = model1.point_radius;
+  computeBV(model2, tf1.inverseTimes(tf2), node.model2_bv);
+
+  return true;
+}
+
+/// @brief Initialize traversal node for distance computation between a point
+/// cloud and a BVH model, given the current transforms
+template <typename BV>
+bool initialize(
+    PointCloudDistanceTraversalNode<BV, RelativeTransformationIsIdentity>&
+        node,
+    BVHModel<BV>& model1, Transform3f& tf1, BVHModel<BV>& model2,
+    Transform3f& tf2, const GJKSolver* nsolver, const DistanceRequest& request,
+    DistanceResult& result, bool use_refit = false,
+    bool refit_bottomup = false) {
+  details::checkPointCloudModels(model1, model2);
+
+  details::applyPlacement(model1, tf1, use_refit, refit_bottomup);
+  details::applyPlacement(model2, tf2, use_refit, refit_bottomup);
+
+  node.request = request;
+  node.result = &result;
+
+  node.model1 = &model1;
+  node.tf1 = tf1;
+  node.model2 = &model2;
+  node.tf2 = tf2;
+  node.nsolver = nsolver;
+
+  node.rel_err = request.rel_err;
+  node.abs_err = request.abs_err;
+
+  node.bv_inflation =
+      details::primitiveRadius(model1) + details::primitiveRadius(model2);
+
+  return true;
+}
+
+/// @brief Initialize traversal node for distance computation between a point
+/// cloud and a BVH model
+template <typename BV>
+bool initialize(PointCloudDistanceTraversalNode<BV, 0>& node,
+                const BVHModel<BV>& model1, const Transform3f& tf1,
+                const BVHModel<BV>& model2, const Transform3f& tf2,
+                const GJKSolver* nsolver, const DistanceRequest& request,
+                DistanceResult& result) {
+  details::checkPointCloudModels(model1, model2);
+
+  node.request = request;
+  node.result = &result;
+
+  node.model1 = &model1;
+  node.tf1 = tf1;
+  node.model2 = &model2;
+  node.tf2 = tf2;
+  node.nsolver = nsolver;
+
+  node.rel_err = request.rel_err;
+  node.abs_err = request.abs_err;
+
+  node.bv_inflation =
+      details::primitiveRadius(model1) + details::primitiveRadius(model2);
+
+  relativeTransform(tf1.getRotation(), tf1.getTranslation(), tf2.getRotation(),
+                    tf2.getTranslation(), node.RT.R, node.RT.T);
+
+  return true;
+}
+
 }  // namespace fcl
 
 }  // namespace hpp
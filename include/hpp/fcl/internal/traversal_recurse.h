@@ -42,6 +42,7 @@
 
 #include <hpp/fcl/BVH/BVH_front.h>
 #include <queue>
+#include <vector>
 #include <hpp/fcl/internal/traversal_node_base.h>
 #include <hpp/fcl/internal/traversal_node_bvhs.h>
 
@@ -74,6 +75,202 @@ void propagateBVHFrontListCollisionRecurse(CollisionTraversalNodeBase* node,
                                            CollisionResult& result,
                                            BVHFrontList* front_list);
 
+/// @defgroup Static_Traversal
+/// Traversal functions instantiated for a concrete traversal node type.
+///
+/// The methods of the node are called with a qualified name, which bypasses
+/// the virtual table and lets the compiler inline the BV tests and the leaf
+/// tests in the traversal loop. TraversalNode must be the dynamic type of the
+/// node: overrides defined in classes deriving from TraversalNode are ignored.
+/// Use the functions taking a pointer to the base classes above for nodes
+/// whose dynamic type is not known at compile time.
+/// @{
+
+/// @brief Recurse function for collision, without virtual calls
+template <typename TraversalNode>
+void collisionRecurse(TraversalNode* node, unsigned int b1, unsigned int b2,
+                      BVHFrontList* front_list, FCL_REAL& sqrDistLowerBound) {
+  FCL_REAL sqrDistLowerBound1 = 0, sqrDistLowerBound2 = 0;
+  bool l1 = node->TraversalNode::isFirstNodeLeaf(b1);
+  bool l2 = node->TraversalNode::isSecondNodeLeaf(b2);
+  if (l1 && l2) {
+    updateFrontList(front_list, b1, b2);
+    node->TraversalNode::leafCollides(b1, b2, sqrDistLowerBound);
+    return;
+  }
+
+  if (node->TraversalNode::BVDisjoints(b1, b2, sqrDistLowerBound)) {
+    updateFrontList(front_list, b1, b2);
+    return;
+  }
+  if (node->TraversalNode::firstOverSecond(b1, b2)) {
+    unsigned int c1 = (unsigned int)node->TraversalNode::getFirstLeftChild(b1);
+    unsigned int c2 =
+        (unsigned int)node->TraversalNode::getFirstRightChild(b1);
+
+    collisionRecurse(node, c1, b2, front_list, sqrDistLowerBound1);
+
+    // early stop is disabled is front_list is used
+    if (node->canStop() && !front_list) return;
+
+    collisionRecurse(node, c2, b2, front_list, sqrDistLowerBound2);
+    sqrDistLowerBound = std::min(sqrDistLowerBound1, sqrDistLowerBound2);
+  } else {
+    unsigned int c1 =
+        (unsigned int)node->TraversalNode::getSecondLeftChild(b2);
+    unsigned int c2 =
+        (unsigned int)node->TraversalNode::getSecondRightChild(b2);
+
+    collisionRecurse(node, b1, c1, front_list, sqrDistLowerBound1);
+
+    // early stop is disabled is front_list is used
+    if (node->canStop() && !front_list) return;
+
+    collisionRecurse(node, b1, c2, front_list, sqrDistLowerBound2);
+    sqrDistLowerBound = std::min(sqrDistLowerBound1, sqrDistLowerBound2);
+  }
+}
+
+/// @brief Recurse function for collision of a hierarchy with itself, without
+/// virtual calls
+///
+/// Each pair of distinct nodes below b is visited once, and a node is never
+/// paired with itself: the children of b are tested against themselves
+/// recursively, then against each other.
+/// @retval sqrDistLowerBound squared lower bound on the distance between the
+///         primitives below b, infinite if no pair of primitives was tested.
+template <typename TraversalNode>
+void selfCollisionRecurse(TraversalNode* node, unsigned int b,
+                          FCL_REAL& sqrDistLowerBound) {
+  sqrDistLowerBound = std::numeric_limits<FCL_REAL>::infinity();
+  if (node->TraversalNode::isFirstNodeLeaf(b)) return;
+
+  unsigned int c1 = (unsigned int)node->TraversalNode::getFirstLeftChild(b);
+  unsigned int c2 = (unsigned int)node->TraversalNode::getFirstRightChild(b);
+  FCL_REAL sqrDistLowerBound1, sqrDistLowerBound2,
+      sqrDistLowerBound3 = std::numeric_limits<FCL_REAL>::infinity();
+
+  selfCollisionRecurse(node, c1, sqrDistLowerBound1);
+  sqrDistLowerBound = sqrDistLowerBound1;
+  if (node->canStop()) return;
+
+  selfCollisionRecurse(node, c2, sqrDistLowerBound2);
+  sqrDistLowerBound = std::min(sqrDistLowerBound, sqrDistLowerBound2);
+  if (node->canStop()) return;
+
+  collisionRecurse(node, c1, c2, NULL, sqrDistLowerBound3);
+  sqrDistLowerBound = std::min(sqrDistLowerBound, sqrDistLowerBound3);
+}
+
+/// @brief Non recursive collision traversal, without virtual calls
+template <typename TraversalNode>
+void collisionNonRecurse(TraversalNode* node, BVHFrontList* front_list,
+                         FCL_REAL& sqrDistLowerBound) {
+  typedef std::pair<unsigned int, unsigned int> BVPair_t;
+  typedef std::vector<BVPair_t> Stack_t;
+
+  Stack_t pairs;
+  pairs.reserve(1000);
+  sqrDistLowerBound = std::numeric_limits<FCL_REAL>::infinity();
+  FCL_REAL sdlb = std::numeric_limits<FCL_REAL>::infinity();
+
+  pairs.push_back(BVPair_t(0, 0));
+
+  while (!pairs.empty()) {
+    unsigned int a = pairs.back().first, b = pairs.back().second;
+    pairs.pop_back();
+
+    bool la = node->TraversalNode::isFirstNodeLeaf(a);
+    bool lb = node->TraversalNode::isSecondNodeLeaf(b);
+
+    // Leaf / Leaf case
+    if (la && lb) {
+      updateFrontList(front_list, a, b);
+      node->TraversalNode::leafCollides(a, b, sdlb);
+      if (sdlb < sqrDistLowerBound) sqrDistLowerBound = sdlb;
+      if (node->canStop() && !front_list) return;
+      continue;
+    }
+
+    // Check the BV
+    if (node->TraversalNode::BVDisjoints(a, b, sdlb)) {
+      if (sdlb < sqrDistLowerBound) sqrDistLowerBound = sdlb;
+      updateFrontList(front_list, a, b);
+      continue;
+    }
+
+    if (node->TraversalNode::firstOverSecond(a, b)) {
+      unsigned int c1 = (unsigned int)node->TraversalNode::getFirstLeftChild(a);
+      unsigned int c2 =
+          (unsigned int)node->TraversalNode::getFirstRightChild(a);
+      pairs.push_back(BVPair_t(c2, b));
+      pairs.push_back(BVPair_t(c1, b));
+    } else {
+      unsigned int c1 =
+          (unsigned int)node->TraversalNode::getSecondLeftChild(b);
+      unsigned int c2 =
+          (unsigned int)node->TraversalNode::getSecondRightChild(b);
+      pairs.push_back(BVPair_t(a, c2));
+      pairs.push_back(BVPair_t(a, c1));
+    }
+  }
+}
+
+/// @brief Recurse function for distance, without virtual calls
+template <typename TraversalNode>
+void distanceRecurse(TraversalNode* node, unsigned int b1, unsigned int b2,
+                     BVHFrontList* front_list) {
+  bool l1 = node->TraversalNode::isFirstNodeLeaf(b1);
+  bool l2 = node->TraversalNode::isSecondNodeLeaf(b2);
+
+  if (l1 && l2) {
+    updateFrontList(front_list, b1, b2);
+    node->TraversalNode::leafComputeDistance(b1, b2);
+    return;
+  }
+
+  unsigned int a1, a2, c1, c2;
+
+  if (node->TraversalNode::firstOverSecond(b1, b2)) {
+    a1 = (unsigned int)node->TraversalNode::getFirstLeftChild(b1);
+    a2 = b2;
+    c1 = (unsigned int)node->TraversalNode::getFirstRightChild(b1);
+    c2 = b2;
+  } else {
+    a1 = b1;
+    a2 = (unsigned int)node->TraversalNode::getSecondLeftChild(b2);
+    c1 = b1;
+    c2 = (unsigned int)node->TraversalNode::getSecondRightChild(b2);
+  }
+
+  FCL_REAL d1 = node->TraversalNode::BVDistanceLowerBound(a1, a2);
+  FCL_REAL d2 = node->TraversalNode::BVDistanceLowerBound(c1, c2);
+
+  if (d2 < d1) {
+    if (!node->TraversalNode::canStop(d2))
+      distanceRecurse(node, c1, c2, front_list);
+    else
+      updateFrontList(front_list, c1, c2);
+
+    if (!node->TraversalNode::canStop(d1))
+      distanceRecurse(node, a1, a2, front_list);
+    else
+      updateFrontList(front_list, a1, a2);
+  } else {
+    if (!node->TraversalNode::canStop(d1))
+      distanceRecurse(node, a1, a2, front_list);
+    else
+      updateFrontList(front_list, a1, a2);
+
+    if (!node->TraversalNode::canStop(d2))
+      distanceRecurse(node, c1, c2, front_list);
+    else
+      updateFrontList(front_list, c1, c2);
+  }
+}
+
+/// @}
+
 }  // namespace fcl
 
 }  // namespace hpp
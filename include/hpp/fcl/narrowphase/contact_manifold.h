@@ -0,0 +1,84 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HPP_FCL_NARROWPHASE_CONTACT_MANIFOLD_H
+#define HPP_FCL_NARROWPHASE_CONTACT_MANIFOLD_H
+
+#include <hpp/fcl/math/transform.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+
+namespace hpp {
+namespace fcl {
+
+namespace details {
+
+/// @brief Maximal number of points of a contact manifold.
+static const unsigned int contact_manifold_max_points = 4;
+
+/// @brief Compute a contact manifold between two shapes in contact.
+///
+/// The features (face, edge) of each shape supporting the contact normal are
+/// clipped against each other, and the points of the clipped feature which
+/// lie closer than max_separation from the feature of the other shape are
+/// kept. When they are more than max_points, the deepest point and the points
+/// spanning the largest area are selected.
+///
+/// Manifolds are computed for the faces of Box and ConvexBase, the caps and
+/// sides of Cylinder and the sides of Capsule. When a shape only touches the
+/// other one with a vertex or when the features are not supported, no
+/// manifold is computed.
+///
+/// @param[in] normal unit contact normal, in the world frame. It is
+///            oriented from s1 to s2 before computing the manifold.
+/// @param[in] max_separation largest signed distance between the features of
+///            the shapes at a point of the manifold.
+/// @param[in] max_points maximal number of points of the manifold, at most
+///            contact_manifold_max_points.
+/// @param[out] positions positions of the points of the manifold, halfway
+///             between the shapes, in the world frame.
+/// @param[out] depths penetration depths at the points of the manifold.
+/// @return the number of points of the manifold, which is 0 when no
+///         manifold of at least 2 points was found.
+HPP_FCL_DLLAPI unsigned int computeContactManifold(
+    const ShapeBase& s1, const Transform3f& tf1, const ShapeBase& s2,
+    const Transform3f& tf2, const Vec3f& normal, FCL_REAL max_separation,
+    unsigned int max_points, Vec3f positions[], FCL_REAL depths[]);
+
+}  // namespace details
+
+}  // namespace fcl
+
+}  // namespace hpp
+
+#endif
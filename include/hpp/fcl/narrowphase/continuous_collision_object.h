@@ -0,0 +1,130 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HPP_FCL_NARROWPHASE_CONTINUOUS_COLLISION_OBJECT_H
+#define HPP_FCL_NARROWPHASE_CONTINUOUS_COLLISION_OBJECT_H
+
+#include <hpp/fcl/continuous_collision.h>
+
+namespace hpp {
+namespace fcl {
+
+/// @brief the object for continuous collision checking, contains the
+/// geometry and its motion over a time step
+class HPP_FCL_DLLAPI ContinuousCollisionObject {
+ public:
+  ContinuousCollisionObject(const shared_ptr<CollisionGeometry>& cgeom_,
+                            const Transform3f& tf_beg,
+                            const Transform3f& tf_end,
+                            CCDMotionType type = CCDM_LINEAR,
+                            bool compute_local_aabb = true)
+      : cgeom(cgeom_), motion(tf_beg, tf_end, type), user_data(nullptr) {
+    if (compute_local_aabb) cgeom->computeLocalAABB();
+    computeAABB();
+  }
+
+  /// @brief get the type of the object
+  OBJECT_TYPE getObjectType() const { return cgeom->getObjectType(); }
+
+  /// @brief get the node type
+  NODE_TYPE getNodeType() const { return cgeom->getNodeType(); }
+
+  /// @brief get the motion of the object
+  const Motion& getMotion() const { return motion; }
+
+  /// @brief set the motion of the object
+  /// @note The AABB must be recomputed and the broadphase managers updated
+  /// afterwards.
+  void setMotion(const Motion& motion_) { motion = motion_; }
+
+  /// @brief set the motion of the object, keeping its type
+  /// @note The AABB must be recomputed and the broadphase managers updated
+  /// afterwards.
+  void setMotion(const Transform3f& tf_beg, const Transform3f& tf_end) {
+    motion = Motion(tf_beg, tf_end, motion.getType());
+  }
+
+  /// @brief get the AABB of the swept volume, in world space
+  const AABB& getAABB() const { return aabb; }
+
+  /// @brief compute the AABB of the swept volume, in world space.
+  ///
+  /// It bounds the world AABBs at the initial and the final placements,
+  /// inflated by Motion::deviationBound.
+  void computeAABB();
+
+  /// @brief get user data in object
+  void* getUserData() const { return user_data; }
+
+  /// @brief set user data in object
+  void setUserData(void* data) { user_data = data; }
+
+  /// @brief get shared pointer to collision geometry of the object instance
+  const shared_ptr<const CollisionGeometry> collisionGeometry() const {
+    return cgeom;
+  }
+
+  /// @brief get shared pointer to collision geometry of the object instance
+  const shared_ptr<CollisionGeometry>& collisionGeometry() { return cgeom; }
+
+ protected:
+  shared_ptr<CollisionGeometry> cgeom;
+
+  Motion motion;
+
+  /// @brief AABB of the swept volume in global coordinate
+  AABB aabb;
+
+  /// @brief pointer to user defined data specific to this object
+  void* user_data;
+
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/// @brief Continuous collision checking between two objects moved by their
+/// own motions.
+/// @copydetails continuousCollide(const CollisionGeometry*, const Motion&,
+/// const CollisionGeometry*, const Motion&, const
+/// ContinuousCollisionRequest&, ContinuousCollisionResult&)
+HPP_FCL_DLLAPI FCL_REAL continuousCollide(
+    const ContinuousCollisionObject* o1, const ContinuousCollisionObject* o2,
+    const ContinuousCollisionRequest& request,
+    ContinuousCollisionResult& result);
+
+}  // namespace fcl
+
+}  // namespace hpp
+
+#endif
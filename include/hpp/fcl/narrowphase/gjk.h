@@ -42,6 +42,7 @@
 
 #include <hpp/fcl/shape/geometric_shapes.h>
 #include <hpp/fcl/math/transform.h>
+#include <hpp/fcl/profiling.h>
 
 namespace hpp {
 namespace fcl {
@@ -209,6 +210,7 @@ struct HPP_FCL_DLLAPI GJK {
   /// in sv
   inline void getSupport(const Vec3f& d, bool dIsNormalized, SimplexV& sv,
                          support_func_guess_t& hint) const {
+    HPP_FCL_PROFILE_COUNT(num_support_calls, 1);
     shape->support(d, dIsNormalized, sv.w0, sv.w1, hint);
     sv.w = sv.w0 - sv.w1;
   }
@@ -238,6 +240,20 @@ struct HPP_FCL_DLLAPI GJK {
   /// @brief get the guess from current simplex
   Vec3f getGuessFromSimplex() const;
 
+  /// @brief Estimate the penetration from the simplex enclosing the origin,
+  /// without running EPA.
+  ///
+  /// The face of the simplex the closest to the origin gives an estimate of
+  /// the normal, and its distance to the origin a lower bound of the
+  /// penetration depth computed by EPA, which does not account for the
+  /// inflation either. If the simplex is not a tetrahedron, the normal is
+  /// given by the closest points and the lower bound is zero.
+  /// @param[out] w0, w1 a point of each shape in the intersection
+  /// @param[out] normal from shape 0 to shape 1, or zero if it is unknown.
+  /// @param[out] depth lower bound of the penetration depth.
+  void getPenetrationFromSimplex(Vec3f& w0, Vec3f& w1, Vec3f& normal,
+                                 FCL_REAL& depth) const;
+
   /// @brief Distance threshold for early break.
   /// GJK stops when it proved the distance is more than this threshold.
   /// @note The closest points will be erroneous in this case.
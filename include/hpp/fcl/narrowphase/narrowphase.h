@@ -42,6 +42,7 @@
 
 #include <limits>
 #include <iostream>
+#include <type_traits>
 
 #include <hpp/fcl/narrowphase/gjk.h>
 #include <hpp/fcl/collision_data.h>
@@ -171,6 +172,87 @@ struct HPP_FCL_DLLAPI GJKSolver {
     return false;
   }
 
+  /// @brief Overlap test between two shapes, which answers whether their
+  /// distance is below a margin and estimates the contact without EPA.
+  ///
+  /// GJK stops as soon as it finds an axis separating the shapes by more than
+  /// the margin, or a simplex enclosing the origin. EPA is never run. The last
+  /// direction of GJK is written back as the cached guess.
+  ///
+  /// @param[in] margin distance below which the shapes overlap
+  /// @param[out] distance_lower_bound lower bound of the distance between the
+  ///             shapes, when they do not overlap.
+  /// @param[out] contact_point, normal, depth when the shapes overlap, the
+  ///             contact point, the normal from s1 to s2 and the penetration
+  ///             depth, all exact when the shapes are separated. When they
+  ///             intersect, they are only estimated from the GJK simplex
+  ///             (see details::GJK::getPenetrationFromSimplex): the depth is
+  ///             a lower bound and the normal may be far from the one of EPA.
+  /// @return true if the distance between the shapes is below the margin.
+  template <typename S1, typename S2>
+  bool shapeOverlap(const S1& s1, const Transform3f& tf1, const S2& s2,
+                    const Transform3f& tf2, FCL_REAL margin,
+                    FCL_REAL& distance_lower_bound, Vec3f& contact_point,
+                    Vec3f& normal, FCL_REAL& depth) const {
+    details::MinkowskiDiff shape;
+    shape.set(&s1, &s2, tf1, tf2);
+
+    Vec3f guess;
+    support_func_guess_t support_hint;
+    details::GJK gjk((unsigned int)gjk_max_iterations, gjk_tolerance);
+    initialize_gjk(gjk, shape, s1, s2, guess, support_hint);
+    gjk.setDistanceEarlyBreak(margin);
+
+    details::GJK::Status gjk_status = gjk.evaluate(shape, guess, support_hint);
+    HPP_FCL_COMPILER_DIAGNOSTIC_PUSH
+    HPP_FCL_COMPILER_DIAGNOSTIC_IGNORED_DEPRECECATED_DECLARATIONS
+    if (gjk_initial_guess == GJKInitialGuess::CachedGuess ||
+        enable_cached_guess) {
+      cached_guess = gjk.getGuessFromSimplex();
+      support_func_cached_guess = gjk.support_hint;
+    }
+    HPP_FCL_COMPILER_DIAGNOSTIC_POP
+
+    Vec3f w0, w1;
+    switch (gjk_status) {
+      case details::GJK::Valid:
+      case details::GJK::EarlyStopped:
+        distance_lower_bound = gjk.distance;
+        if (gjk.distance > margin) return false;
+        // EarlyStopped implies a distance above the margin, hence GJK
+        // converged and the closest points are exact.
+        gjk.getClosestPoints(shape, w0, w1);
+        normal.noalias() = tf1.getRotation() * (w1 - w0).normalized();
+        depth = -gjk.distance;
+        break;
+      case details::GJK::Inside:
+        distance_lower_bound = -(std::numeric_limits<FCL_REAL>::max)();
+        if (gjk.hasPenetrationInformation(shape)) {
+          gjk.getClosestPoints(shape, w0, w1);
+          normal.noalias() = tf1.getRotation() * (w0 - w1).normalized();
+          depth = -gjk.distance;
+        } else {
+          gjk.getPenetrationFromSimplex(w0, w1, normal, depth);
+          normal = tf1.getRotation() * normal;
+        }
+        break;
+      default:
+        // GJK did not converge: the shapes are assumed to overlap.
+        distance_lower_bound = 0;
+        gjk.getClosestPoints(shape, w0, w1);
+        normal.setZero();
+        depth = 0;
+    }
+    contact_point = tf1.transform((w0 + w1) / 2);
+    if (normal.isZero()) {
+      // No direction is known: use the one between the shapes.
+      normal = tf2.getTranslation() - tf1.getTranslation();
+      if (normal.isZero()) normal = Vec3f::UnitX();
+      normal.normalize();
+    }
+    return true;
+  }
+
   //// @brief intersection checking between one shape and a triangle with
   /// transformation
   /// @return true if the shape are colliding.
@@ -329,7 +411,7 @@ struct HPP_FCL_DLLAPI GJKSolver {
           Vec3f w0, w1;
           epa.getClosestPoints(shape, w0, w1);
           assert(epa.depth >= -eps);
-          distance = (std::min)(0., -epa.depth);
+          distance = (std::min)(FCL_REAL(0), -epa.depth);
           normal.noalias() = tf1.getRotation() * epa.normal;
           p1 = tf1.transform(w0);
           p2 = tf1.transform(w1);
@@ -349,11 +431,11 @@ struct HPP_FCL_DLLAPI GJKSolver {
   /// @brief Default constructor for GJK algorithm
   GJKSolver() {
     gjk_max_iterations = 128;
-    gjk_tolerance = 1e-6;
+    gjk_tolerance = GJK_DEFAULT_TOLERANCE;
     epa_max_face_num = 128;
     epa_max_vertex_num = 64;
     epa_max_iterations = 255;
-    epa_tolerance = 1e-6;
+    epa_tolerance = GJK_DEFAULT_TOLERANCE;
     enable_cached_guess = false;  // TODO: use gjk_initial_guess instead
     cached_guess = Vec3f(1, 0, 0);
     support_func_cached_guess = support_func_guess_t::Zero();
@@ -377,7 +459,7 @@ struct HPP_FCL_DLLAPI GJKSolver {
     epa_max_face_num = 128;
     epa_max_vertex_num = 64;
     epa_max_iterations = 255;
-    epa_tolerance = 1e-6;
+    epa_tolerance = GJK_DEFAULT_TOLERANCE;
 
     set(request);
   }
@@ -415,7 +497,7 @@ struct HPP_FCL_DLLAPI GJKSolver {
     epa_max_face_num = 128;
     epa_max_vertex_num = 64;
     epa_max_iterations = 255;
-    epa_tolerance = 1e-6;
+    epa_tolerance = GJK_DEFAULT_TOLERANCE;
 
     set(request);
   }
@@ -441,8 +523,9 @@ struct HPP_FCL_DLLAPI GJKSolver {
 
     // The distance upper bound should be at least greater to the requested
     // security margin. Otherwise, we will likely miss some collisions.
-    distance_upper_bound = (std::max)(
-        0., (std::max)(request.distance_upper_bound, request.security_margin));
+    distance_upper_bound =
+        (std::max)(FCL_REAL(0), (std::max)(request.distance_upper_bound,
+                                           request.security_margin));
   }
 
   /// @brief Copy constructor
@@ -723,6 +806,84 @@ HPP_FCL_DECLARE_SHAPE_DISTANCE_SELF(
 #if !(__cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1600))
 #pragma GCC diagnostic pop
 #endif
+
+namespace details {
+
+/// @brief Whether a shape is unbounded, in which case GJK does not apply.
+template <typename S>
+struct is_unbounded_shape : std::false_type {};
+template <>
+struct is_unbounded_shape<Halfspace> : std::true_type {};
+template <>
+struct is_unbounded_shape<Plane> : std::true_type {};
+
+/// @brief Whether GJKSolver::shapeOverlap is the fastest way to test the
+/// overlap between two shapes. This is not the case when one of them is
+/// unbounded, or when their distance is computed analytically.
+template <typename S1, typename S2>
+struct use_gjk_overlap
+    : std::integral_constant<bool, !is_unbounded_shape<S1>::value &&
+                                       !is_unbounded_shape<S2>::value> {};
+
+#define HPP_FCL_ANALYTIC_DISTANCE(S1, S2) \
+  template <>                             \
+  struct use_gjk_overlap<S1, S2> : std::false_type {}
+#define HPP_FCL_ANALYTIC_DISTANCE_PAIR(S1, S2) \
+  HPP_FCL_ANALYTIC_DISTANCE(S1, S2);           \
+  HPP_FCL_ANALYTIC_DISTANCE(S2, S1)
+
+HPP_FCL_ANALYTIC_DISTANCE(Sphere, Sphere);
+HPP_FCL_ANALYTIC_DISTANCE_PAIR(Sphere, Box);
+HPP_FCL_ANALYTIC_DISTANCE_PAIR(Sphere, Capsule);
+HPP_FCL_ANALYTIC_DISTANCE_PAIR(Sphere, Cylinder);
+HPP_FCL_ANALYTIC_DISTANCE_PAIR(Sphere, TriangleP);
+HPP_FCL_ANALYTIC_DISTANCE(Capsule, Capsule);
+
+#undef HPP_FCL_ANALYTIC_DISTANCE
+#undef HPP_FCL_ANALYTIC_DISTANCE_PAIR
+
+/// @brief Whether a collision request only asks whether the shapes overlap,
+/// in which case GJKSolver::shapeOverlap answers it. A negative margin
+/// requires the penetration depth, hence EPA.
+inline bool isOverlapRequest(const CollisionRequest& request) {
+  return !request.enable_contact && !request.enable_distance_lower_bound &&
+         request.security_margin + request.collision_distance_threshold >= 0;
+}
+
+/// @brief Collision test between two shapes with GJKSolver::shapeOverlap,
+/// when the request only asks whether they overlap. EPA is never run.
+/// @return false if the request needs the full collision test. Otherwise,
+/// the result is updated with at most one contact between the primitive b1
+/// of o1 and the primitive b2 of o2, and sqrDistLowerBound is set.
+template <typename S1, typename S2>
+bool overlapCollide(const GJKSolver* nsolver, const S1& s1,
+                    const Transform3f& tf1, const S2& s2,
+                    const Transform3f& tf2, const CollisionGeometry* o1,
+                    int b1, const CollisionGeometry* o2, int b2,
+                    const CollisionRequest& request, CollisionResult& result,
+                    FCL_REAL& sqrDistLowerBound) {
+  if (!use_gjk_overlap<S1, S2>::value || !isOverlapRequest(request))
+    return false;
+  FCL_REAL distance, depth;
+  Vec3f contact_point, normal;
+  if (!nsolver->shapeOverlap(
+          s1, tf1, s2, tf2,
+          request.security_margin + request.collision_distance_threshold,
+          distance, contact_point, normal, depth)) {
+    const FCL_REAL distToCollision = distance - request.security_margin;
+    sqrDistLowerBound = distToCollision * distToCollision;
+    result.updateDistanceLowerBound(distToCollision);
+    return true;
+  }
+  sqrDistLowerBound = 0;
+  result.updateDistanceLowerBound(-depth - request.security_margin);
+  if (result.numContacts() < request.num_max_contacts)
+    result.addContact(Contact(o1, o2, b1, b2, contact_point, normal, depth));
+  return true;
+}
+
+}  // namespace details
+
 }  // namespace fcl
 
 }  // namespace hpp
@@ -0,0 +1,151 @@
+//
+// Copyright (c) 2023 INRIA
+//
+
+#ifndef HPP_FCL_PROFILING_H
+#define HPP_FCL_PROFILING_H
+
+#include <cstddef>
+
+#include "hpp/fcl/fwd.hh"
+#include "hpp/fcl/timings.h"
+
+namespace hpp {
+namespace fcl {
+
+///
+/// @brief Counters of the operations performed during one query.
+///
+/// The counters are filled only when the library is built with the CMake
+/// option HPP_FCL_ENABLE_PROFILING. Otherwise, the instrumentation compiles to
+/// nothing and the counters stay at zero. They are reset at the beginning of
+/// each call to collide() and distance(). Profiles of queries run on different
+/// threads can be summed with operator+=.
+///
+/// The bounding volume and leaf tests are counted but not timed, since reading
+/// the clock would cost more than most of these tests.
+struct HPP_FCL_DLLAPI QueryProfile {
+  /// @brief number of bounding volume tests
+  std::size_t num_bv_tests;
+
+  /// @brief number of leaf tests (primitive against primitive)
+  std::size_t num_leaf_tests;
+
+  /// @brief number of calls to GJK
+  std::size_t num_gjk_calls;
+
+  /// @brief total number of GJK iterations
+  std::size_t num_gjk_iterations;
+
+  /// @brief number of support function calls, in GJK and EPA
+  std::size_t num_support_calls;
+
+  /// @brief number of calls to EPA
+  std::size_t num_epa_calls;
+
+  /// @brief total number of EPA iterations
+  std::size_t num_epa_iterations;
+
+  /// @brief number of calls to EPA which ended in the fallback case
+  std::size_t num_epa_fallbacks;
+
+  /// @brief time spent in GJK, in microseconds
+  double gjk_time;
+
+  /// @brief time spent in EPA, in microseconds
+  double epa_time;
+
+  QueryProfile() { clear(); }
+
+  /// @brief reset all the counters
+  void clear() {
+    num_bv_tests = num_leaf_tests = 0;
+    num_gjk_calls = num_gjk_iterations = num_support_calls = 0;
+    num_epa_calls = num_epa_iterations = num_epa_fallbacks = 0;
+    gjk_time = epa_time = 0;
+  }
+
+  /// @brief add the counters of other
+  QueryProfile& operator+=(const QueryProfile& other) {
+    num_bv_tests += other.num_bv_tests;
+    num_leaf_tests += other.num_leaf_tests;
+    num_gjk_calls += other.num_gjk_calls;
+    num_gjk_iterations += other.num_gjk_iterations;
+    num_support_calls += other.num_support_calls;
+    num_epa_calls += other.num_epa_calls;
+    num_epa_iterations += other.num_epa_iterations;
+    num_epa_fallbacks += other.num_epa_fallbacks;
+    gjk_time += other.gjk_time;
+    epa_time += other.epa_time;
+    return *this;
+  }
+
+  /// @brief whether the library records the counters
+  static bool enabled() {
+#ifdef HPP_FCL_ENABLE_PROFILING
+    return true;
+#else
+    return false;
+#endif
+  }
+};
+
+namespace details {
+#ifdef HPP_FCL_ENABLE_PROFILING
+/// @brief Profile of the query running on the calling thread, or NULL.
+HPP_FCL_DLLAPI QueryProfile*& currentQueryProfile();
+
+/// @brief Makes profile, after clearing it, the profile of the queries run on
+/// the calling thread during the lifetime of this object.
+class ProfileScope {
+ public:
+  explicit ProfileScope(QueryProfile& profile)
+      : previous(currentQueryProfile()) {
+    profile.clear();
+    currentQueryProfile() = &profile;
+  }
+  ~ProfileScope() { currentQueryProfile() = previous; }
+
+ private:
+  QueryProfile* previous;
+};
+
+/// @brief Adds the time elapsed during its lifetime to a field of the profile
+/// of the current query.
+class ProfileTimer {
+ public:
+  explicit ProfileTimer(double QueryProfile::*field_) : field(field_) {}
+  ~ProfileTimer() {
+    QueryProfile* profile = currentQueryProfile();
+    if (profile) profile->*field += timer.elapsed().user;
+  }
+
+ private:
+  double QueryProfile::*field;
+  Timer timer;
+};
+
+#define HPP_FCL_PROFILE_SCOPE(profile) \
+  ::hpp::fcl::details::ProfileScope hpp_fcl_profile_scope(profile)
+#define HPP_FCL_PROFILE_COUNT(counter, n)                 \
+  do {                                                    \
+    ::hpp::fcl::QueryProfile* hpp_fcl_profile =           \
+        ::hpp::fcl::details::currentQueryProfile();       \
+    if (hpp_fcl_profile) hpp_fcl_profile->counter += (n); \
+  } while (0)
+#define HPP_FCL_PROFILE_TIME(field)                                \
+  ::hpp::fcl::details::ProfileTimer hpp_fcl_profile_timer_##field( \
+      &::hpp::fcl::QueryProfile::field)
+#else
+#define HPP_FCL_PROFILE_SCOPE(profile)
+#define HPP_FCL_PROFILE_COUNT(counter, n) \
+  do {                                    \
+  } while (0)
+#define HPP_FCL_PROFILE_TIME(field)
+#endif
+}  // namespace details
+
+}  // namespace fcl
+}  // namespace hpp
+
+#endif  // ifndef HPP_FCL_PROFILING_H
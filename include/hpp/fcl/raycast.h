@@ -0,0 +1,171 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HPP_FCL_RAYCAST_H
+#define HPP_FCL_RAYCAST_H
+
+#include <limits>
+
+#include <hpp/fcl/collision_object.h>
+
+namespace hpp {
+namespace fcl {
+
+/// @brief A ray, or a segment when max_distance is finite.
+struct HPP_FCL_DLLAPI Ray {
+  /// @brief Origin of the ray
+  Vec3f origin;
+
+  /// @brief Unit direction of the ray
+  Vec3f direction;
+
+  /// @brief Distance along the ray beyond which hits are ignored
+  FCL_REAL max_distance;
+
+  Ray()
+      : origin(Vec3f::Zero()),
+        direction(Vec3f::UnitX()),
+        max_distance(std::numeric_limits<FCL_REAL>::infinity()) {}
+
+  /// @param[in] direction direction of the ray, which is normalized.
+  Ray(const Vec3f& origin, const Vec3f& direction,
+      FCL_REAL max_distance = std::numeric_limits<FCL_REAL>::infinity())
+      : origin(origin),
+        direction(direction.normalized()),
+        max_distance(max_distance) {}
+
+  /// @brief Point at a given distance along the ray
+  Vec3f pointAt(FCL_REAL distance) const {
+    return origin + distance * direction;
+  }
+};
+
+/// @brief Which hit is returned by a ray query
+enum RayHitMode {
+  /// The hit the closest to the origin of the ray
+  RAY_CLOSEST_HIT,
+  /// Any hit, the query stops as soon as one is found
+  RAY_ANY_HIT
+};
+
+/// @brief request to the ray casting algorithm
+struct HPP_FCL_DLLAPI RayRequest {
+  /// @brief Which hit is returned
+  RayHitMode mode;
+
+  /// @brief Number of rays traced together by raycast(const
+  /// CollisionGeometry*, const Transform3f&, const Ray*, std::size_t, const
+  /// RayRequest&, RayResult*) on bounding volume hierarchies: 1, 4 or 8.
+  /// Packets are efficient when the rays are coherent, e.g. the rays of a
+  /// camera or of a LiDAR.
+  unsigned int packet_size;
+
+  RayRequest(RayHitMode mode = RAY_CLOSEST_HIT, unsigned int packet_size = 8)
+      : mode(mode), packet_size(packet_size) {}
+
+  bool operator==(const RayRequest& other) const {
+    return mode == other.mode && packet_size == other.packet_size;
+  }
+};
+
+/// @brief ray casting result
+struct HPP_FCL_DLLAPI RayResult {
+  /// @brief Whether the ray hits the geometry
+  bool hit;
+
+  /// @brief Distance from the origin of the ray to the hit point
+  FCL_REAL distance;
+
+  /// @brief Unit normal of the surface at the hit point, in the world frame,
+  /// oriented towards the origin of the ray.
+  Vec3f normal;
+
+  /// @brief Index of the primitive which is hit: the triangle of a BVHModel
+  /// or the cell of a HeightField, in row major order. Contact::NONE for
+  /// shapes and OcTree.
+  int primitive_id;
+
+  RayResult() { clear(); }
+
+  /// @brief Clear the result
+  void clear() {
+    hit = false;
+    distance = std::numeric_limits<FCL_REAL>::infinity();
+    normal.setZero();
+    primitive_id = -1;
+  }
+
+  bool operator==(const RayResult& other) const {
+    return hit == other.hit && distance == other.distance &&
+           normal == other.normal && primitive_id == other.primitive_id;
+  }
+};
+
+/// @brief Cast a ray on a geometry.
+///
+/// Geometries are considered as surfaces: a ray starting inside a shape hits
+/// its boundary where it leaves the shape. HeightField are hit on their top
+/// surface. BVHModel of triangles, HeightField, OcTree and all the shapes
+/// except ConvexBase without polygons are supported.
+///
+/// @return whether the ray hits the geometry.
+HPP_FCL_DLLAPI bool raycast(const CollisionGeometry* geom,
+                            const Transform3f& tf, const Ray& ray,
+                            const RayRequest& request, RayResult& result);
+
+/// @copydoc raycast(const CollisionGeometry*, const Transform3f&, const Ray&,
+/// const RayRequest&, RayResult&)
+HPP_FCL_DLLAPI bool raycast(const CollisionObject* o, const Ray& ray,
+                            const RayRequest& request, RayResult& result);
+
+/// @brief Cast a set of rays on a geometry.
+///
+/// On BVHModel, rays are traced by packets of RayRequest::packet_size rays
+/// which traverse the hierarchy together. Other geometries trace the rays
+/// one by one.
+///
+/// @param[in] rays, num_rays the rays
+/// @param[out] results the results, of size num_rays
+/// @return the number of rays which hit the geometry.
+HPP_FCL_DLLAPI std::size_t raycast(const CollisionGeometry* geom,
+                                   const Transform3f& tf, const Ray* rays,
+                                   std::size_t num_rays,
+                                   const RayRequest& request,
+                                   RayResult* results);
+
+}  // namespace fcl
+
+}  // namespace hpp
+
+#endif
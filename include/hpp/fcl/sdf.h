@@ -0,0 +1,220 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HPP_FCL_SDF_H
+#define HPP_FCL_SDF_H
+
+#include <vector>
+
+#include <hpp/fcl/fwd.hh>
+#include <hpp/fcl/collision_object.h>
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+
+namespace hpp {
+namespace fcl {
+
+/// @addtogroup Construction_Of_SDF
+/// @{
+
+/// @brief Signed distance field of a closed triangle mesh, precomputed on a
+/// regular grid, negative inside the mesh.
+///
+/// The grid is split into bricks of brick_size^3 voxels. The field is sampled
+/// at the corners of all the bricks, and at all the voxel corners of the
+/// bricks within the narrow band of the surface only. Distances are
+/// interpolated trilinearly from the samples of the brick containing the
+/// query point when it is sampled, from the brick corners otherwise, so that
+/// a query costs O(1) whatever the size of the mesh.
+///
+/// Against a sphere, capsule or convex shape, the distance is the minimum of
+/// the field over the shape, searched from sampled support points of the
+/// shape and refined along the gradient of the field. It is approximate: its
+/// accuracy is governed by the voxel size. In penetration, it is minus the
+/// depth of the deepest point of the shape, which is a lower bound of the
+/// penetration depth.
+class HPP_FCL_DLLAPI SignedDistanceField : public CollisionGeometry {
+ public:
+  typedef CollisionGeometry Base;
+
+  /// @brief Number of voxels along the side of a brick
+  enum { brick_size = 7 };
+
+  /// @brief Constructing an empty field
+  SignedDistanceField();
+
+  /// @brief Sample the signed distance field of a mesh.
+  ///
+  /// The inside of the mesh is found by ray parity, hence the mesh must be
+  /// closed.
+  ///
+  /// @param model the triangle mesh
+  /// @param voxel_size spacing of the samples within the narrow band
+  /// @param narrow_band distance to the surface within which the bricks are
+  ///        sampled at every voxel, 3 * voxel_size if negative
+  /// @param padding margin around the AABB of the mesh covered by the grid,
+  ///        narrow_band if negative
+  SignedDistanceField(const BVHModelBase& model, FCL_REAL voxel_size,
+                      FCL_REAL narrow_band = -1, FCL_REAL padding = -1);
+
+  /// @brief Clone *this into a new SignedDistanceField
+  virtual SignedDistanceField* clone() const {
+    return new SignedDistanceField(*this);
+  }
+
+  /// @brief Compute the AABB of the mesh in local coordinate
+  void computeLocalAABB();
+
+  /// @brief Get the object type: it is a signed distance field
+  OBJECT_TYPE getObjectType() const { return OT_SDF; }
+
+  /// @brief Get the node type
+  NODE_TYPE getNodeType() const { return GEOM_SDF; }
+
+  /// @brief Signed distance to the surface of a point, in the frame of the
+  /// field.
+  ///
+  /// Outside of the grid, it is the distance to the grid plus the distance at
+  /// the closest point of the grid, which is an upper bound.
+  FCL_REAL distance(const Vec3f& p) const;
+
+  /// @brief Signed distance to the surface of a point, in the frame of the
+  /// field, and its gradient.
+  FCL_REAL distance(const Vec3f& p, Vec3f& gradient) const;
+
+  /// @brief Spacing of the samples within the narrow band
+  FCL_REAL getVoxelSize() const { return voxel_size; }
+
+  /// @brief Distance to the surface within which the bricks are sampled at
+  /// every voxel
+  FCL_REAL getNarrowBand() const { return narrow_band; }
+
+  /// @brief Corner of the grid with the lowest coordinates
+  const Vec3f& getOrigin() const { return origin; }
+
+  /// @brief Number of bricks of the grid along each axis
+  const Eigen::Vector3i& getNumBricks() const { return num_bricks; }
+
+  /// @brief Number of bricks sampled at every voxel
+  std::size_t getNumSampledBricks() const {
+    return brick_samples.size() / brick_num_samples;
+  }
+
+ protected:
+  enum {
+    brick_num_samples = (brick_size + 1) * (brick_size + 1) * (brick_size + 1)
+  };
+
+  /// @brief Interpolated distance at a point of the grid, in voxel units from
+  /// the origin, and its gradient.
+  FCL_REAL interpolate(const Vec3f& u, Vec3f& gradient) const;
+
+  /// @brief Index of a brick corner in coarse_samples
+  std::size_t coarseIndex(int i, int j, int k) const {
+    return ((std::size_t)i * (std::size_t)(num_bricks[1] + 1) +
+            (std::size_t)j) *
+               (std::size_t)(num_bricks[2] + 1) +
+           (std::size_t)k;
+  }
+
+  /// @brief Index of a brick in brick_indices
+  std::size_t brickIndex(int i, int j, int k) const {
+    return ((std::size_t)i * (std::size_t)num_bricks[1] + (std::size_t)j) *
+               (std::size_t)num_bricks[2] +
+           (std::size_t)k;
+  }
+
+  FCL_REAL voxel_size;
+  FCL_REAL narrow_band;
+  Vec3f origin;
+  Eigen::Vector3i num_bricks;
+
+  /// @brief AABB of the mesh
+  AABB mesh_aabb;
+
+  /// @brief Samples at the brick corners
+  std::vector<float> coarse_samples;
+
+  /// @brief Offset of the samples of each brick in brick_samples, divided by
+  /// brick_num_samples, or -1 if the brick is only sampled at its corners
+  std::vector<int> brick_indices;
+
+  /// @brief Samples of the bricks within the narrow band
+  std::vector<float> brick_samples;
+
+ private:
+  virtual bool isEqual(const CollisionGeometry& _other) const {
+    const SignedDistanceField* other_ptr =
+        dynamic_cast<const SignedDistanceField*>(&_other);
+    if (other_ptr == nullptr) return false;
+    const SignedDistanceField& other = *other_ptr;
+
+    return voxel_size == other.voxel_size &&
+           narrow_band == other.narrow_band && origin == other.origin &&
+           num_bricks == other.num_bricks && mesh_aabb == other.mesh_aabb &&
+           coarse_samples == other.coarse_samples &&
+           brick_indices == other.brick_indices &&
+           brick_samples == other.brick_samples;
+  }
+
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/// @}
+
+namespace details {
+
+/// @brief Minimum of a signed distance field over a convex shape.
+///
+/// @param sdf the signed distance field
+/// @param shape a bounded convex shape
+/// @param tf placement of the shape in the frame of the field
+/// @param[out] p1 witness point on the surface of the field
+/// @param[out] p2 witness point on the shape
+/// @param[out] normal unit direction from the field to the shape
+/// @return the signed distance between the mesh and the shape, negative in
+///         penetration
+HPP_FCL_DLLAPI FCL_REAL sdfShapeDistance(const SignedDistanceField& sdf,
+                                         const ShapeBase& shape,
+                                         const Transform3f& tf, Vec3f& p1,
+                                         Vec3f& p2, Vec3f& normal);
+
+}  // namespace details
+
+}  // namespace fcl
+
+}  // namespace hpp
+
+#endif
@@ -61,6 +61,7 @@ void save(Archive &ar, const hpp::fcl::BVHModelBase &bvh_model,
     ar &make_nvp("tri_indices", tri_indices_map);
   }
   ar &make_nvp("build_state", bvh_model.build_state);
+  ar &make_nvp("point_radius", bvh_model.point_radius);
 
   if (bvh_model.prev_vertices) {
     const bool has_prev_vertices = true;
@@ -133,6 +134,7 @@ void load(Archive &ar, hpp::fcl::BVHModelBase &bvh_model,
     bvh_model.tri_indices = NULL;
 
   ar >> make_nvp("build_state", bvh_model.build_state);
+  ar >> make_nvp("point_radius", bvh_model.point_radius);
 
   typedef internal::BVHModelBaseAccessor Accessor;
   reinterpret_cast<Accessor &>(bvh_model).num_tris_allocated = num_tris;
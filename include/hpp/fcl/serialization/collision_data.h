@@ -71,6 +71,8 @@ void serialize(Archive& ar, hpp::fcl::CollisionRequest& collision_request,
                collision_request.enable_distance_lower_bound);
   ar& make_nvp("security_margin", collision_request.security_margin);
   ar& make_nvp("break_distance", collision_request.break_distance);
+  ar& make_nvp("enable_contact_manifold",
+               collision_request.enable_contact_manifold);
 }
 
 template <class Archive>
@@ -105,6 +107,7 @@ void serialize(Archive& ar, hpp::fcl::DistanceRequest& distance_request,
                boost::serialization::base_object<hpp::fcl::QueryRequest>(
                    distance_request));
   ar& make_nvp("enable_nearest_points", distance_request.enable_nearest_points);
+  ar& make_nvp("enable_gradients", distance_request.enable_gradients);
   ar& make_nvp("rel_err", distance_request.rel_err);
   ar& make_nvp("abs_err", distance_request.abs_err);
 }
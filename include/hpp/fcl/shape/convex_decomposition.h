@@ -0,0 +1,98 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef HPP_FCL_SHAPE_CONVEX_DECOMPOSITION_H
+#define HPP_FCL_SHAPE_CONVEX_DECOMPOSITION_H
+
+#include <hpp/fcl/fwd.hh>
+#include <hpp/fcl/data_types.h>
+
+namespace hpp {
+namespace fcl {
+
+class BVHModelBase;
+class Compound;
+
+/// @brief Parameters of the approximate convex decomposition of a triangle
+/// mesh.
+struct HPP_FCL_DLLAPI ConvexDecompositionRequest {
+  /// @brief Maximal number of convex pieces
+  unsigned int max_num_pieces;
+
+  /// @brief Concavity below which a piece is not split any further,
+  /// relatively to the diagonal of the AABB of the mesh.
+  ///
+  /// The concavity of a piece is the largest distance between the vertices
+  /// of its triangles and the boundary of its convex hull.
+  FCL_REAL max_concavity;
+
+  /// @brief Number of cutting planes tried along each axis when splitting a
+  /// piece
+  unsigned int num_split_candidates;
+
+  ConvexDecompositionRequest(unsigned int max_num_pieces_ = 16,
+                             FCL_REAL max_concavity_ = 0.02,
+                             unsigned int num_split_candidates_ = 8)
+      : max_num_pieces(max_num_pieces_),
+        max_concavity(max_concavity_),
+        num_split_candidates(num_split_candidates_) {}
+};
+
+/// @brief Approximate convex decomposition of a triangle mesh.
+///
+/// The triangles of the mesh are recursively split by axis aligned planes.
+/// At each step, the piece with the largest concavity is cut along the
+/// plane which minimizes the sum of the concavities of the two halves, until
+/// every piece is below ConvexDecompositionRequest::max_concavity or the
+/// number of pieces reaches ConvexDecompositionRequest::max_num_pieces.
+///
+/// Each piece is the convex hull of its triangles, stored as a
+/// Convex<Triangle> with its neighbors. Since every triangle of the mesh
+/// belongs to a piece, the union of the pieces contains the surface of the
+/// mesh.
+///
+/// \return a compound whose children are the convex pieces, at the
+///         identity placement.
+/// \throw std::invalid_argument if the model is not a triangle mesh or if
+///        it is flat.
+/// \note the convex hulls are built with ConvexBase::convexHull.
+HPP_FCL_DLLAPI shared_ptr<Compound> convexDecomposition(
+    const BVHModelBase& model,
+    const ConvexDecompositionRequest& request = ConvexDecompositionRequest());
+
+}  // namespace fcl
+}  // namespace hpp
+
+#endif
@@ -590,12 +590,42 @@ class HPP_FCL_DLLAPI ConvexBase : public ShapeBase {
   ///          "Qt". If \c NULL, "Qt" is passed to Qhull.
   ///        - if \c keepTriangles is \c false, an empty string is passed to
   ///          Qhull.
-  /// \note hpp-fcl must have been compiled with option \c HPP_FCL_HAS_QHULL set
-  ///       to \c ON.
+  /// \note if hpp-fcl was not compiled with option \c HPP_FCL_HAS_QHULL, the
+  ///       hull is built by \ref quickHull and \c qhullCommand is ignored.
   static ConvexBase* convexHull(const Vec3f* points, unsigned int num_points,
                                 bool keepTriangles,
                                 const char* qhullCommand = NULL);
 
+  /// @brief Build a convex hull with the quickhull algorithm implemented in
+  /// hpp-fcl, without Qhull.
+  ///
+  /// The vertices of the hull are the input points it goes through, in the
+  /// order of the input. Points closer to the hull than the numerical
+  /// tolerance are not kept.
+  /// \param points, num_points the points whose convex hull should be computed.
+  /// \param keepTriangles if \c true, returns a Convex<Triangle> object which
+  ///        contains the triangles of the hull, oriented outwards. Otherwise,
+  ///        coplanar triangles are merged and only the edges of the resulting
+  ///        polygons are stored in the neighbors.
+  /// \throw std::invalid_argument if there are less than 4 points or if they
+  ///        are coplanar.
+  static ConvexBase* quickHull(const Vec3f* points, unsigned int num_points,
+                               bool keepTriangles);
+
+  /// @brief Build the convex hulls of several sets of points with \ref
+  /// quickHull.
+  ///
+  /// When the library is built with OpenMP, the sets are distributed over
+  /// num_threads threads. Otherwise, they are processed sequentially.
+  /// \param hulls resized to the number of sets, hulls[i] is the hull of
+  ///        point_sets[i].
+  /// \param num_threads number of threads, 0 for the default number of
+  ///        threads of OpenMP
+  static void quickHull(const std::vector<std::vector<Vec3f> >& point_sets,
+                        bool keepTriangles,
+                        std::vector<shared_ptr<ConvexBase> >& hulls,
+                        int num_threads = 1);
+
   virtual ~ConvexBase();
 
   ///  @brief Clone (deep copy).
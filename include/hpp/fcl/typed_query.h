@@ -0,0 +1,538 @@
+//
+// Copyright (c) 2023 INRIA
+//
+
+#ifndef HPP_FCL_TYPED_QUERY_H
+#define HPP_FCL_TYPED_QUERY_H
+
+#include <limits>
+#include <type_traits>
+
+#include <hpp/fcl/collision_data.h>
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/hfield.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+#include <hpp/fcl/narrowphase/narrowphase.h>
+#include <hpp/fcl/internal/collision_functors.h>
+#include <hpp/fcl/internal/distance_functors.h>
+
+namespace hpp {
+namespace fcl {
+
+namespace details {
+
+/// @brief Type under which a geometry is handled by the collision and
+/// distance functions. All the convex shapes are handled as ConvexBase.
+template <typename T, typename Enable = void>
+struct query_type {
+  typedef T type;
+};
+
+template <typename T>
+struct query_type<
+    T, typename std::enable_if<std::is_base_of<ConvexBase, T>::value>::type> {
+  typedef ConvexBase type;
+};
+
+/// @brief Node type of the geometries of type T.
+template <typename T>
+struct node_type_traits;
+
+#define HPP_FCL_NODE_TYPE_TRAITS(T, node_type) \
+  template <>                                  \
+  struct node_type_traits<T> {                 \
+    static const NODE_TYPE value = node_type;  \
+  }
+
+HPP_FCL_NODE_TYPE_TRAITS(Box, GEOM_BOX);
+HPP_FCL_NODE_TYPE_TRAITS(Sphere, GEOM_SPHERE);
+HPP_FCL_NODE_TYPE_TRAITS(Ellipsoid, GEOM_ELLIPSOID);
+HPP_FCL_NODE_TYPE_TRAITS(Capsule, GEOM_CAPSULE);
+HPP_FCL_NODE_TYPE_TRAITS(Cone, GEOM_CONE);
+HPP_FCL_NODE_TYPE_TRAITS(Cylinder, GEOM_CYLINDER);
+HPP_FCL_NODE_TYPE_TRAITS(ConvexBase, GEOM_CONVEX);
+HPP_FCL_NODE_TYPE_TRAITS(Plane, GEOM_PLANE);
+HPP_FCL_NODE_TYPE_TRAITS(Halfspace, GEOM_HALFSPACE);
+HPP_FCL_NODE_TYPE_TRAITS(BVHModel<AABB>, BV_AABB);
+HPP_FCL_NODE_TYPE_TRAITS(BVHModel<OBB>, BV_OBB);
+HPP_FCL_NODE_TYPE_TRAITS(BVHModel<RSS>, BV_RSS);
+HPP_FCL_NODE_TYPE_TRAITS(BVHModel<kIOS>, BV_kIOS);
+HPP_FCL_NODE_TYPE_TRAITS(BVHModel<OBBRSS>, BV_OBBRSS);
+HPP_FCL_NODE_TYPE_TRAITS(BVHModel<KDOP<16> >, BV_KDOP16);
+HPP_FCL_NODE_TYPE_TRAITS(BVHModel<KDOP<18> >, BV_KDOP18);
+HPP_FCL_NODE_TYPE_TRAITS(BVHModel<KDOP<24> >, BV_KDOP24);
+HPP_FCL_NODE_TYPE_TRAITS(HeightField<AABB>, HF_AABB);
+HPP_FCL_NODE_TYPE_TRAITS(HeightField<OBBRSS>, HF_OBBRSS);
+
+#undef HPP_FCL_NODE_TYPE_TRAITS
+
+/// @brief List of types
+template <typename... Types>
+struct type_list {};
+
+/// @brief Geometry types handled by the collision and distance functions,
+/// octrees excepted.
+typedef type_list<Box, Sphere, Ellipsoid, Capsule, Cone, Cylinder, ConvexBase,
+                  Plane, Halfspace, BVHModel<AABB>, BVHModel<OBB>,
+                  BVHModel<RSS>, BVHModel<kIOS>, BVHModel<OBBRSS>,
+                  BVHModel<KDOP<16> >, BVHModel<KDOP<18> >,
+                  BVHModel<KDOP<24> >, HeightField<AABB>, HeightField<OBBRSS> >
+    query_types;
+
+/// @brief Whether T is one of the shapes handled by the collision and
+/// distance functions.
+template <typename T>
+struct is_query_shape : std::false_type {};
+
+template <>
+struct is_query_shape<Box> : std::true_type {};
+template <>
+struct is_query_shape<Sphere> : std::true_type {};
+template <>
+struct is_query_shape<Ellipsoid> : std::true_type {};
+template <>
+struct is_query_shape<Capsule> : std::true_type {};
+template <>
+struct is_query_shape<Cone> : std::true_type {};
+template <>
+struct is_query_shape<Cylinder> : std::true_type {};
+template <>
+struct is_query_shape<ConvexBase> : std::true_type {};
+template <>
+struct is_query_shape<Plane> : std::true_type {};
+template <>
+struct is_query_shape<Halfspace> : std::true_type {};
+
+/// @brief Whether the collision and distance between shapes of types S1 and
+/// S2 are handled.
+template <typename S1, typename S2>
+struct shape_pair_supported
+    : std::integral_constant<bool, is_query_shape<S1>::value &&
+                                       is_query_shape<S2>::value> {};
+
+// TODO Louis: Ellipsoid - Plane
+// TODO Louis: Ellipsoid - Halfspace
+template <>
+struct shape_pair_supported<Ellipsoid, Plane> : std::false_type {};
+template <>
+struct shape_pair_supported<Plane, Ellipsoid> : std::false_type {};
+template <>
+struct shape_pair_supported<Ellipsoid, Halfspace> : std::false_type {};
+template <>
+struct shape_pair_supported<Halfspace, Ellipsoid> : std::false_type {};
+
+/// @brief Queries handled for the geometries whose bounding volume is BV.
+template <typename BV>
+struct bv_query_traits {
+  enum {
+    /// collision of a BVHModel<BV> with a shape or another BVHModel<BV>
+    BVHCollision = false,
+    /// distance between a BVHModel<BV> and a shape
+    BVHShapeDistance = false,
+    /// distance between two BVHModel<BV>
+    BVHDistance = false,
+    /// collision and distance between a HeightField<BV> and a shape
+    HeightField = false
+  };
+};
+
+#define HPP_FCL_BV_QUERY_TRAITS(BV, collision, shape_distance, distance, \
+                                hfield)                                  \
+  template <>                                                            \
+  struct bv_query_traits<BV> {                                           \
+    enum {                                                               \
+      BVHCollision = collision,                                          \
+      BVHShapeDistance = shape_distance,                                 \
+      BVHDistance = distance,                                            \
+      HeightField = hfield                                               \
+    };                                                                   \
+  }
+
+HPP_FCL_BV_QUERY_TRAITS(AABB, true, false, true, true);
+HPP_FCL_BV_QUERY_TRAITS(OBB, true, true, true, false);
+HPP_FCL_BV_QUERY_TRAITS(RSS, true, true, true, false);
+HPP_FCL_BV_QUERY_TRAITS(kIOS, true, true, true, false);
+HPP_FCL_BV_QUERY_TRAITS(OBBRSS, true, true, true, true);
+HPP_FCL_BV_QUERY_TRAITS(KDOP<16>, true, false, false, false);
+HPP_FCL_BV_QUERY_TRAITS(KDOP<18>, true, false, false, false);
+HPP_FCL_BV_QUERY_TRAITS(KDOP<24>, true, false, false, false);
+
+#undef HPP_FCL_BV_QUERY_TRAITS
+
+}  // namespace details
+
+/// @brief Collision function between the geometries of types T1 and T2.
+///
+/// This is the function stored in CollisionFunctionMatrix for the pair, so
+/// that the typed collide and the runtime look up table run the same code.
+/// Supported is false for the pairs which are not handled in this order.
+template <typename T1, typename T2, typename Enable = void>
+struct CollisionFunctor {
+  enum { Supported = false };
+};
+
+template <typename S1, typename S2>
+struct CollisionFunctor<S1, S2,
+                        typename std::enable_if<details::shape_pair_supported<
+                            S1, S2>::value>::type> {
+  enum { Supported = true };
+  static std::size_t run(const CollisionGeometry* o1, const Transform3f& tf1,
+                         const CollisionGeometry* o2, const Transform3f& tf2,
+                         const GJKSolver* nsolver,
+                         const CollisionRequest& request,
+                         CollisionResult& result) {
+    return ShapeShapeCollide<S1, S2>(o1, tf1, o2, tf2, nsolver, request,
+                                     result);
+  }
+};
+
+template <typename BV, typename S>
+struct CollisionFunctor<
+    BVHModel<BV>, S,
+    typename std::enable_if<details::bv_query_traits<BV>::BVHCollision &&
+                            details::is_query_shape<S>::value>::type> {
+  enum { Supported = true };
+  static std::size_t run(const CollisionGeometry* o1, const Transform3f& tf1,
+                         const CollisionGeometry* o2, const Transform3f& tf2,
+                         const GJKSolver* nsolver,
+                         const CollisionRequest& request,
+                         CollisionResult& result) {
+    return BVHShapeCollider<BV, S>::collide(o1, tf1, o2, tf2, nsolver, request,
+                                            result);
+  }
+};
+
+template <typename BV, typename S>
+struct CollisionFunctor<
+    HeightField<BV>, S,
+    typename std::enable_if<details::bv_query_traits<BV>::HeightField &&
+                            details::is_query_shape<S>::value>::type> {
+  enum { Supported = true };
+  static std::size_t run(const CollisionGeometry* o1, const Transform3f& tf1,
+                         const CollisionGeometry* o2, const Transform3f& tf2,
+                         const GJKSolver* nsolver,
+                         const CollisionRequest& request,
+                         CollisionResult& result) {
+    return HeightFieldShapeCollider<BV, S>::collide(o1, tf1, o2, tf2, nsolver,
+                                                    request, result);
+  }
+};
+
+template <typename BV>
+struct CollisionFunctor<
+    BVHModel<BV>, BVHModel<BV>,
+    typename std::enable_if<details::bv_query_traits<BV>::BVHCollision>::type> {
+  enum { Supported = true };
+  static std::size_t run(const CollisionGeometry* o1, const Transform3f& tf1,
+                         const CollisionGeometry* o2, const Transform3f& tf2,
+                         const GJKSolver* nsolver,
+                         const CollisionRequest& request,
+                         CollisionResult& result) {
+    return BVHCollide<BV>(o1, tf1, o2, tf2, nsolver, request, result);
+  }
+};
+
+/// Collision between a point cloud and a height field. BVHModel<BV> must be a
+/// point cloud.
+template <typename BV>
+struct CollisionFunctor<
+    BVHModel<BV>, HeightField<BV>,
+    typename std::enable_if<details::bv_query_traits<BV>::HeightField>::type> {
+  enum { Supported = true };
+  static std::size_t run(const CollisionGeometry* o1, const Transform3f& tf1,
+                         const CollisionGeometry* o2, const Transform3f& tf2,
+                         const GJKSolver* nsolver,
+                         const CollisionRequest& request,
+                         CollisionResult& result) {
+    return PointCloudHeightFieldCollider<BV>::collide(o1, tf1, o2, tf2,
+                                                      nsolver, request, result);
+  }
+};
+
+template <typename BV>
+struct CollisionFunctor<
+    HeightField<BV>, BVHModel<BV>,
+    typename std::enable_if<details::bv_query_traits<BV>::HeightField>::type> {
+  enum { Supported = true };
+  static std::size_t run(const CollisionGeometry* o1, const Transform3f& tf1,
+                         const CollisionGeometry* o2, const Transform3f& tf2,
+                         const GJKSolver* nsolver,
+                         const CollisionRequest& request,
+                         CollisionResult& result) {
+    const std::size_t res = PointCloudHeightFieldCollider<BV>::collide(
+        o2, tf2, o1, tf1, nsolver, request, result);
+    result.swapObjects();
+    return res;
+  }
+};
+
+/// @brief Distance function between the geometries of types T1 and T2.
+///
+/// This is the function stored in DistanceFunctionMatrix for the pair.
+/// Supported is false for the pairs which are not handled in this order.
+template <typename T1, typename T2, typename Enable = void>
+struct DistanceFunctor {
+  enum { Supported = false };
+};
+
+template <typename S1, typename S2>
+struct DistanceFunctor<S1, S2,
+                       typename std::enable_if<details::shape_pair_supported<
+                           S1, S2>::value>::type> {
+  enum { Supported = true };
+  static FCL_REAL run(const CollisionGeometry* o1, const Transform3f& tf1,
+                      const CollisionGeometry* o2, const Transform3f& tf2,
+                      const GJKSolver* nsolver, const DistanceRequest& request,
+                      DistanceResult& result) {
+    return ShapeShapeDistance<S1, S2>(o1, tf1, o2, tf2, nsolver, request,
+                                      result);
+  }
+};
+
+template <typename BV, typename S>
+struct DistanceFunctor<
+    BVHModel<BV>, S,
+    typename std::enable_if<details::bv_query_traits<BV>::BVHShapeDistance &&
+                            details::is_query_shape<S>::value>::type> {
+  enum { Supported = true };
+  static FCL_REAL run(const CollisionGeometry* o1, const Transform3f& tf1,
+                      const CollisionGeometry* o2, const Transform3f& tf2,
+                      const GJKSolver* nsolver, const DistanceRequest& request,
+                      DistanceResult& result) {
+    return BVHShapeDistancer<BV, S>::distance(o1, tf1, o2, tf2, nsolver,
+                                              request, result);
+  }
+};
+
+template <typename BV, typename S>
+struct DistanceFunctor<
+    HeightField<BV>, S,
+    typename std::enable_if<details::bv_query_traits<BV>::HeightField &&
+                            details::is_query_shape<S>::value>::type> {
+  enum { Supported = true };
+  static FCL_REAL run(const CollisionGeometry* o1, const Transform3f& tf1,
+                      const CollisionGeometry* o2, const Transform3f& tf2,
+                      const GJKSolver* nsolver, const DistanceRequest& request,
+                      DistanceResult& result) {
+    return HeightFieldShapeDistancer<BV, S>::distance(o1, tf1, o2, tf2,
+                                                      nsolver, request, result);
+  }
+};
+
+template <typename BV>
+struct DistanceFunctor<
+    BVHModel<BV>, BVHModel<BV>,
+    typename std::enable_if<details::bv_query_traits<BV>::BVHDistance>::type> {
+  enum { Supported = true };
+  static FCL_REAL run(const CollisionGeometry* o1, const Transform3f& tf1,
+                      const CollisionGeometry* o2, const Transform3f& tf2,
+                      const GJKSolver* nsolver, const DistanceRequest& request,
+                      DistanceResult& result) {
+    return BVHDistance<BV>(o1, tf1, o2, tf2, nsolver, request, result);
+  }
+};
+
+namespace details {
+
+/// @brief Store Functor<T1, T2>::run in table if the pair is supported.
+template <template <typename, typename, typename> class Functor, typename T1,
+          typename T2, typename Func>
+void registerFunction(Func (&table)[NODE_COUNT][NODE_COUNT],
+                      std::true_type /*supported*/) {
+  table[node_type_traits<T1>::value][node_type_traits<T2>::value] =
+      &Functor<T1, T2, void>::run;
+}
+
+template <template <typename, typename, typename> class Functor, typename T1,
+          typename T2, typename Func>
+void registerFunction(Func (&/*table*/)[NODE_COUNT][NODE_COUNT],
+                      std::false_type /*supported*/) {}
+
+/// @brief Store Functor<T1, T2>::run in table for each supported pair made of
+/// T1 and a type of the list.
+template <template <typename, typename, typename> class Functor, typename T1,
+          typename Func, typename... Types2>
+void registerFunctionRow(Func (&table)[NODE_COUNT][NODE_COUNT],
+                         type_list<Types2...>) {
+  const int dummy[] = {
+      0, (registerFunction<Functor, T1, Types2>(
+              table, std::integral_constant<
+                         bool, Functor<T1, Types2, void>::Supported>()),
+          0)...};
+  HPP_FCL_UNUSED_VARIABLE(dummy);
+}
+
+/// @brief Store Functor<T1, T2>::run in table for each supported pair of
+/// types of the list.
+template <template <typename, typename, typename> class Functor,
+          typename Func, typename... Types>
+void registerFunctions(Func (&table)[NODE_COUNT][NODE_COUNT],
+                       type_list<Types...> types) {
+  const int dummy[] = {
+      0, (registerFunctionRow<Functor, Types>(table, types), 0)...};
+  HPP_FCL_UNUSED_VARIABLE(dummy);
+}
+
+/// @brief How a query between T1 and T2 is dispatched. The pairs which are
+/// only handled in the reverse order (a shape with a BVH model or a height
+/// field) are queried with the objects swapped, as collide and distance do at
+/// runtime.
+template <template <typename, typename, typename> class Functor, typename T1,
+          typename T2>
+struct query_dispatch {
+  typedef typename query_type<T1>::type Q1;
+  typedef typename query_type<T2>::type Q2;
+  enum {
+    Direct = Functor<Q1, Q2, void>::Supported,
+    Swapped = !Direct && Functor<Q2, Q1, void>::Supported,
+    Supported = Direct || Swapped
+  };
+};
+
+template <typename T1, typename T2>
+inline std::size_t runCollision(const T1* o1, const Transform3f& tf1,
+                                const T2* o2, const Transform3f& tf2,
+                                const GJKSolver* solver,
+                                const CollisionRequest& request,
+                                CollisionResult& result,
+                                std::false_type /*swapped*/) {
+  typedef typename query_type<T1>::type Q1;
+  typedef typename query_type<T2>::type Q2;
+  return CollisionFunctor<Q1, Q2>::run(o1, tf1, o2, tf2, solver, request,
+                                       result);
+}
+
+template <typename T1, typename T2>
+inline std::size_t runCollision(const T1* o1, const Transform3f& tf1,
+                                const T2* o2, const Transform3f& tf2,
+                                const GJKSolver* solver,
+                                const CollisionRequest& request,
+                                CollisionResult& result,
+                                std::true_type /*swapped*/) {
+  typedef typename query_type<T1>::type Q1;
+  typedef typename query_type<T2>::type Q2;
+  std::size_t res = CollisionFunctor<Q2, Q1>::run(o2, tf2, o1, tf1, solver,
+                                                  request, result);
+  result.swapObjects();
+  return res;
+}
+
+template <typename T1, typename T2>
+inline FCL_REAL runDistance(const T1* o1, const Transform3f& tf1,
+                            const T2* o2, const Transform3f& tf2,
+                            const GJKSolver* solver,
+                            const DistanceRequest& request,
+                            DistanceResult& result,
+                            std::false_type /*swapped*/) {
+  typedef typename query_type<T1>::type Q1;
+  typedef typename query_type<T2>::type Q2;
+  return DistanceFunctor<Q1, Q2>::run(o1, tf1, o2, tf2, solver, request,
+                                      result);
+}
+
+template <typename T1, typename T2>
+inline FCL_REAL runDistance(const T1* o1, const Transform3f& tf1,
+                            const T2* o2, const Transform3f& tf2,
+                            const GJKSolver* solver,
+                            const DistanceRequest& request,
+                            DistanceResult& result,
+                            std::true_type /*swapped*/) {
+  typedef typename query_type<T1>::type Q1;
+  typedef typename query_type<T2>::type Q2;
+  FCL_REAL res =
+      DistanceFunctor<Q2, Q1>::run(o2, tf2, o1, tf1, solver, request, result);
+  if (request.enable_nearest_points || request.enable_gradients) {
+    std::swap(result.o1, result.o2);
+    result.nearest_points[0].swap(result.nearest_points[1]);
+  }
+  result.normal = -result.normal;
+  return res;
+}
+
+/// Check that the contacts requested fit in the contact buffer of the result.
+inline void checkContactCapacity(const CollisionRequest& request,
+                                 const CollisionResult& result) {
+  if (result.contactCapacity() < request.num_max_contacts)
+    HPP_FCL_THROW_PRETTY("The contact buffer of the collision result holds "
+                             << result.contactCapacity()
+                             << " contacts, fewer than num_max_contacts ("
+                             << request.num_max_contacts << ").",
+                         std::invalid_argument);
+}
+
+}  // namespace details
+
+/// @brief Main collision interface for geometries whose types are known at
+/// compile time, e.g. collide<Capsule, BVHModel<OBBRSS> >.
+///
+/// The collision function is resolved at compile time, without virtual call
+/// nor look up table, and can be inlined in the caller. It runs the same code
+/// as the runtime collide. This overload only exists for the pairs of types
+/// handled by CollisionFunctionMatrix, octrees excepted.
+template <typename T1, typename T2>
+inline typename std::enable_if<
+    details::query_dispatch<CollisionFunctor, T1, T2>::Supported,
+    std::size_t>::type
+collide(const T1* o1, const Transform3f& tf1, const T2* o2,
+        const Transform3f& tf2, const CollisionRequest& request,
+        CollisionResult& result) {
+  HPP_FCL_PROFILE_SCOPE(result.profile);
+  // If security margin is set to -infinity, return that there is no collision
+  if (request.security_margin == -std::numeric_limits<FCL_REAL>::infinity()) {
+    result.clear();
+    return false;
+  }
+  if (request.num_max_contacts == 0)
+    HPP_FCL_THROW_PRETTY("Invalid number of max contacts (current value is 0).",
+                         std::invalid_argument);
+  details::checkContactCapacity(request, result);
+
+  GJKSolver solver(request);
+  typedef std::integral_constant<
+      bool, details::query_dispatch<CollisionFunctor, T1, T2>::Swapped>
+      swapped;
+  std::size_t res = details::runCollision(o1, tf1, o2, tf2, &solver, request,
+                                          result, swapped());
+
+  if (solver.gjk_initial_guess == GJKInitialGuess::CachedGuess ||
+      solver.enable_cached_guess) {
+    result.cached_gjk_guess = solver.cached_guess;
+    result.cached_support_func_guess = solver.support_func_cached_guess;
+  }
+  return res;
+}
+
+/// @brief Main distance interface for geometries whose types are known at
+/// compile time, e.g. distance<Capsule, BVHModel<OBBRSS> >.
+///
+/// The distance function is resolved at compile time and runs the same code
+/// as the runtime distance. This overload only exists for the pairs of types
+/// handled by DistanceFunctionMatrix, octrees excepted.
+template <typename T1, typename T2>
+inline typename std::enable_if<
+    details::query_dispatch<DistanceFunctor, T1, T2>::Supported,
+    FCL_REAL>::type
+distance(const T1* o1, const Transform3f& tf1, const T2* o2,
+         const Transform3f& tf2, const DistanceRequest& request,
+         DistanceResult& result) {
+  HPP_FCL_PROFILE_SCOPE(result.profile);
+  GJKSolver solver(request);
+  typedef std::integral_constant<
+      bool, details::query_dispatch<DistanceFunctor, T1, T2>::Swapped>
+      swapped;
+  FCL_REAL res = details::runDistance(o1, tf1, o2, tf2, &solver, request,
+                                      result, swapped());
+
+  if (solver.gjk_initial_guess == GJKInitialGuess::CachedGuess ||
+      solver.enable_cached_guess) {
+    result.cached_gjk_guess = solver.cached_guess;
+    result.cached_support_func_guess = solver.support_func_cached_guess;
+  }
+  if (request.enable_gradients) result.computeGradients(tf1, tf2);
+  return res;
+}
+
+}  // namespace fcl
+}  // namespace hpp
+
+#endif
@@ -40,6 +40,7 @@
 #include "hpp/fcl/broadphase/broadphase_bruteforce.h"
 #include "hpp/fcl/broadphase/broadphase_SaP.h"
 #include "hpp/fcl/broadphase/broadphase_SSaP.h"
+#include "hpp/fcl/broadphase/broadphase_MBP.h"
 #include "hpp/fcl/broadphase/broadphase_interval_tree.h"
 #include "hpp/fcl/broadphase/broadphase_spatialhash.h"
 
@@ -86,6 +87,22 @@ void exposeBroadPhase() {
                        bp::return_value_policy<bp::copy_const_reference>())
       .DEF_CLASS_FUNC(CollisionCallBackCollect, exist);
 
+  // CollisionCallBackBatch
+  bp::class_<CollisionCallBackBatch, bp::bases<CollisionCallBackBase> >(
+      "CollisionCallBackBatch", bp::no_init)
+      .def(dv::init<CollisionCallBackBatch,
+                    bp::optional<const CollisionRequest&, bool> >())
+      .DEF_CLASS_FUNC(CollisionCallBackBatch, processPairs)
+      .DEF_CLASS_FUNC(CollisionCallBackBatch, numCollisionPairs)
+      .DEF_CLASS_FUNC2(CollisionCallBackBatch, getCollisionPairs,
+                       bp::return_value_policy<bp::copy_const_reference>())
+      .DEF_CLASS_FUNC2(CollisionCallBackBatch, getCollidingPairs,
+                       bp::return_value_policy<bp::copy_const_reference>())
+      .DEF_CLASS_FUNC2(CollisionCallBackBatch, getResults,
+                       bp::return_value_policy<bp::copy_const_reference>())
+      .DEF_RW_CLASS_ATTRIB(CollisionCallBackBatch, request)
+      .DEF_RW_CLASS_ATTRIB(CollisionCallBackBatch, parallel);
+
   bp::class_<CollisionData>("CollisionData", bp::no_init)
       .def(dv::init<CollisionData>())
       .DEF_RW_CLASS_ATTRIB(CollisionData, request)
@@ -98,16 +115,39 @@ void exposeBroadPhase() {
       .DEF_RW_CLASS_ATTRIB(DistanceData, result)
       .DEF_RW_CLASS_ATTRIB(DistanceData, done);
 
+  bp::class_<NeighborResult>("NeighborResult", bp::no_init)
+      .def(dv::init<NeighborResult>())
+      .add_property(
+          "object",
+          bp::make_getter(
+              &NeighborResult::object,
+              bp::return_value_policy<bp::reference_existing_object>()),
+          doxygen::class_attrib_doc<NeighborResult>("object"))
+      .DEF_RW_CLASS_ATTRIB(NeighborResult, distance);
+
+  if (!eigenpy::register_symbolic_link_to_registered_type<
+          std::vector<NeighborResult> >()) {
+    bp::class_<std::vector<NeighborResult> >("StdVec_NeighborResult")
+        .def(bp::vector_indexing_suite<std::vector<NeighborResult> >());
+  }
+
   BroadPhaseCollisionManagerWrapper::expose();
 
-  BroadPhaseCollisionManagerWrapper::exposeDerived<
-      DynamicAABBTreeCollisionManager>();
+  {
+    auto cl = BroadPhaseCollisionManagerWrapper::exposeDerived<
+        DynamicAABBTreeCollisionManager>();
+    BroadPhaseCollisionManagerWrapper::exposeNeighborQueries(cl);
+  }
   BroadPhaseCollisionManagerWrapper::exposeDerived<
       DynamicAABBTreeArrayCollisionManager>();
   BroadPhaseCollisionManagerWrapper::exposeDerived<
       IntervalTreeCollisionManager>();
   BroadPhaseCollisionManagerWrapper::exposeDerived<SSaPCollisionManager>();
-  BroadPhaseCollisionManagerWrapper::exposeDerived<SaPCollisionManager>();
+  {
+    auto cl =
+        BroadPhaseCollisionManagerWrapper::exposeDerived<SaPCollisionManager>();
+    BroadPhaseCollisionManagerWrapper::exposeNeighborQueries(cl);
+  }
   BroadPhaseCollisionManagerWrapper::exposeDerived<NaiveCollisionManager>();
 
   // Specific case of SpatialHashingCollisionManager
@@ -121,4 +161,10 @@ void exposeBroadPhase() {
         .def(dv::init<Derived, FCL_REAL, const Vec3f &, const Vec3f &,
                       bp::optional<unsigned int> >());
   }
+
+  bp::class_<MBPCollisionManager, bp::bases<BroadPhaseCollisionManager> >(
+      "MBPCollisionManager", bp::no_init)
+      .def(dv::init<MBPCollisionManager, const Vec3f &, const Vec3f &,
+                    bp::optional<unsigned int, unsigned int, unsigned int> >())
+      .DEF_CLASS_FUNC(MBPCollisionManager, numRegions);
 }
@@ -214,16 +214,34 @@ struct BroadPhaseCollisionManagerWrapper
   }
 
   template <typename Derived>
-  static void exposeDerived() {
+  static bp::class_<Derived, bp::bases<BroadPhaseCollisionManager> >
+  exposeDerived() {
     std::string class_name = boost::typeindex::type_id<Derived>().pretty_name();
     boost::algorithm::replace_all(class_name, "hpp::fcl::", "");
 #if defined(WIN32)
     boost::algorithm::replace_all(class_name, "class ", "");
 #endif
 
-    bp::class_<Derived, bp::bases<BroadPhaseCollisionManager> >(
-        class_name.c_str(), bp::no_init)
-        .def(dv::init<Derived>());
+    bp::class_<Derived, bp::bases<BroadPhaseCollisionManager> > cl(
+        class_name.c_str(), bp::no_init);
+    cl.def(dv::init<Derived>());
+    return cl;
+  }
+
+  /// @brief expose the radius and nearest neighbor queries of a manager
+  template <typename Derived>
+  static void exposeNeighborQueries(
+      bp::class_<Derived, bp::bases<BroadPhaseCollisionManager> >& cl) {
+    cl.def("radiusQuery", &Derived::radiusQuery,
+           (bp::arg("self"), bp::arg("obj"), bp::arg("radius"),
+            bp::arg("results"), bp::arg("exact") = false),
+           "Find the objects whose distance to obj is at most radius. "
+           "Returns the number of objects found.")
+        .def("nearestNeighbors", &Derived::nearestNeighbors,
+             (bp::arg("self"), bp::arg("obj"), bp::arg("k"),
+              bp::arg("results"), bp::arg("exact") = false),
+             "Find the k objects which are the closest to obj. "
+             "Returns the number of objects found.");
   }
 
 };  // BroadPhaseCollisionManagerWrapper
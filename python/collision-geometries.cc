@@ -77,7 +77,8 @@ typedef std::vector<Vec3f> Vec3fs;
 typedef std::vector<Triangle> Triangles;
 
 struct BVHModelBaseWrapper {
-  typedef Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor> RowMatrixX3;
+  typedef Eigen::Matrix<FCL_REAL, Eigen::Dynamic, 3, Eigen::RowMajor>
+      RowMatrixX3;
   typedef Eigen::Map<RowMatrixX3> MapRowMatrixX3;
   typedef Eigen::Ref<RowMatrixX3> RefRowMatrixX3;
 
@@ -154,7 +155,8 @@ void exposeHeightField(const std::string& bvname) {
 }
 
 struct ConvexBaseWrapper {
-  typedef Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor> RowMatrixX3;
+  typedef Eigen::Matrix<FCL_REAL, Eigen::Dynamic, 3, Eigen::RowMajor>
+      RowMatrixX3;
   typedef Eigen::Map<RowMatrixX3> MapRowMatrixX3;
   typedef Eigen::Ref<RowMatrixX3> RefRowMatrixX3;
 
@@ -182,6 +184,11 @@ struct ConvexBaseWrapper {
     return ConvexBase::convexHull(points.data(), (unsigned int)points.size(),
                                   keepTri, qhullCommand);
   }
+
+  static ConvexBase* quickHull(const Vec3fs& points, bool keepTri) {
+    return ConvexBase::quickHull(points.data(), (unsigned int)points.size(),
+                                 keepTri);
+  }
 };
 
 template <typename PolygonT>
@@ -288,6 +295,10 @@ void exposeShapes() {
            doxygen::member_func_doc(&ConvexBase::convexHull),
            return_value_policy<manage_new_object>())
       .staticmethod("convexHull")
+      .def("quickHull", &ConvexBaseWrapper::quickHull,
+           "Build a convex hull with the quickhull algorithm of hpp-fcl.",
+           return_value_policy<manage_new_object>())
+      .staticmethod("quickHull")
       .def("clone", &ConvexBase::clone,
            doxygen::member_func_doc(&ConvexBase::clone),
            return_value_policy<manage_new_object>());
@@ -404,6 +415,8 @@ void exposeCollisionGeometries() {
         .value("OT_GEOM", OT_GEOM)
         .value("OT_OCTREE", OT_OCTREE)
         .value("OT_HFIELD", OT_HFIELD)
+        .value("OT_SDF", OT_SDF)
+        .value("OT_COMPOUND", OT_COMPOUND)
         .export_values();
   }
 
@@ -431,6 +444,8 @@ void exposeCollisionGeometries() {
         .value("GEOM_OCTREE", GEOM_OCTREE)
         .value("HF_AABB", HF_AABB)
         .value("HF_OBBRSS", HF_OBBRSS)
+        .value("GEOM_SDF", GEOM_SDF)
+        .value("GEOM_COMPOUND", GEOM_COMPOUND)
         .export_values();
   }
 
@@ -594,6 +609,8 @@ void exposeCollisionGeometries() {
            "Retrieve the triangle given by its index.")
       .def_readonly("num_vertices", &BVHModelBase::num_vertices)
       .def_readonly("num_tris", &BVHModelBase::num_tris)
+      .def_readwrite("point_radius", &BVHModelBase::point_radius,
+                     "Radius of the points of a point cloud.")
       .def_readonly("build_state", &BVHModelBase::build_state)
 
       .def_readonly("convex", &BVHModelBase::convex)
@@ -663,6 +680,11 @@ void exposeCollisionObject() {
 
         .DEF_CLASS_FUNC(CollisionObject, isIdentityTransform)
         .DEF_CLASS_FUNC(CollisionObject, setIdentityTransform)
+        .DEF_CLASS_FUNC(CollisionObject, getCollisionGroup)
+        .DEF_CLASS_FUNC(CollisionObject, setCollisionGroup)
+        .DEF_CLASS_FUNC(CollisionObject, getCollisionMask)
+        .DEF_CLASS_FUNC(CollisionObject, setCollisionMask)
+        .DEF_CLASS_FUNC(CollisionObject, canCollideWith)
         .DEF_CLASS_FUNC2(CollisionObject, setCollisionGeometry,
                          (bp::with_custodian_and_ward_postcall<1, 2>()))
 
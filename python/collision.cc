@@ -43,6 +43,7 @@
 #ifdef HPP_FCL_HAS_DOXYGEN_AUTODOC
 #include "doxygen_autodoc/functions.h"
 #include "doxygen_autodoc/hpp/fcl/collision_data.h"
+#include "doxygen_autodoc/hpp/fcl/profiling.h"
 #endif
 
 #include "../doc/python/doxygen.hh"
@@ -59,6 +60,11 @@ const CollisionGeometry* geto(const Contact& c) {
   return index == 1 ? c.o1 : c.o2;
 }
 
+template <int index>
+Vec3f getWitnessPoint(const PairCache& cache) {
+  return cache.witness_points[index];
+}
+
 void exposeCollisionAPI() {
   if (!eigenpy::register_symbolic_link_to_registered_type<
           CollisionRequestFlag>()) {
@@ -80,6 +86,27 @@ void exposeCollisionAPI() {
         .def("clear", &CPUTimes::clear, arg("self"), "Reset the time values.");
   }
 
+  if (!eigenpy::register_symbolic_link_to_registered_type<QueryProfile>()) {
+    class_<QueryProfile>("QueryProfile", doxygen::class_doc<QueryProfile>(),
+                         no_init)
+        .def(dv::init<QueryProfile>())
+        .DEF_RO_CLASS_ATTRIB(QueryProfile, num_bv_tests)
+        .DEF_RO_CLASS_ATTRIB(QueryProfile, num_leaf_tests)
+        .DEF_RO_CLASS_ATTRIB(QueryProfile, num_gjk_calls)
+        .DEF_RO_CLASS_ATTRIB(QueryProfile, num_gjk_iterations)
+        .DEF_RO_CLASS_ATTRIB(QueryProfile, num_support_calls)
+        .DEF_RO_CLASS_ATTRIB(QueryProfile, num_epa_calls)
+        .DEF_RO_CLASS_ATTRIB(QueryProfile, num_epa_iterations)
+        .DEF_RO_CLASS_ATTRIB(QueryProfile, num_epa_fallbacks)
+        .DEF_RO_CLASS_ATTRIB(QueryProfile, gjk_time)
+        .DEF_RO_CLASS_ATTRIB(QueryProfile, epa_time)
+        .DEF_CLASS_FUNC(QueryProfile, clear)
+        .def(self += self)
+        .def("enabled", &QueryProfile::enabled,
+             doxygen::member_func_doc(&QueryProfile::enabled))
+        .staticmethod("enabled");
+  }
+
   if (!eigenpy::register_symbolic_link_to_registered_type<QueryRequest>()) {
     class_<QueryRequest>("QueryRequest", doxygen::class_doc<QueryRequest>(),
                          no_init)
@@ -125,7 +152,8 @@ void exposeCollisionAPI() {
         .DEF_RW_CLASS_ATTRIB(CollisionRequest, enable_distance_lower_bound)
         .DEF_RW_CLASS_ATTRIB(CollisionRequest, security_margin)
         .DEF_RW_CLASS_ATTRIB(CollisionRequest, break_distance)
-        .DEF_RW_CLASS_ATTRIB(CollisionRequest, distance_upper_bound);
+        .DEF_RW_CLASS_ATTRIB(CollisionRequest, distance_upper_bound)
+        .DEF_RW_CLASS_ATTRIB(CollisionRequest, enable_contact_manifold);
   }
 
   if (!eigenpy::register_symbolic_link_to_registered_type<
@@ -172,7 +200,8 @@ void exposeCollisionAPI() {
                         no_init)
         .DEF_RW_CLASS_ATTRIB(QueryResult, cached_gjk_guess)
         .DEF_RW_CLASS_ATTRIB(QueryResult, cached_support_func_guess)
-        .DEF_RW_CLASS_ATTRIB(QueryResult, timings);
+        .DEF_RW_CLASS_ATTRIB(QueryResult, timings)
+        .DEF_RW_CLASS_ATTRIB(QueryResult, profile);
   }
 
   if (!eigenpy::register_symbolic_link_to_registered_type<CollisionResult>()) {
@@ -196,6 +225,11 @@ void exposeCollisionAPI() {
                  static_cast<const std::vector<Contact>& (CollisionResult::*)()
                                  const>(&CollisionResult::getContacts)),
              return_internal_reference<>())
+        .DEF_CLASS_FUNC2(CollisionResult, setContactBuffer,
+                         with_custodian_and_ward<1, 2>())
+        .DEF_CLASS_FUNC(CollisionResult, resetContactBuffer)
+        .DEF_CLASS_FUNC(CollisionResult, hasContactBuffer)
+        .DEF_CLASS_FUNC(CollisionResult, contactCapacity)
 
         .DEF_RW_CLASS_ATTRIB(CollisionResult, distance_lower_bound);
   }
@@ -216,6 +250,26 @@ void exposeCollisionAPI() {
                                   const CollisionGeometry*, const Transform3f&,
                                   CollisionRequest&, CollisionResult&)>(
           &collide));
+  doxygen::def("selfCollide", &selfCollide);
+
+  if (!eigenpy::register_symbolic_link_to_registered_type<PairCache>()) {
+    class_<PairCache>("PairCache", doxygen::class_doc<PairCache>(), no_init)
+        .def(dv::init<PairCache>())
+        .DEF_RW_CLASS_ATTRIB(PairCache, valid)
+        .DEF_RW_CLASS_ATTRIB(PairCache, relative_pose)
+        .DEF_RW_CLASS_ATTRIB(PairCache, distance_lower_bound)
+        .DEF_RW_CLASS_ATTRIB(PairCache, separating_axis)
+        .DEF_RW_CLASS_ATTRIB(PairCache, support_func_guess)
+        .def("getWitnessPoint1", &getWitnessPoint<0>,
+             doxygen::class_attrib_doc<PairCache>("witness_points"))
+        .def("getWitnessPoint2", &getWitnessPoint<1>,
+             doxygen::class_attrib_doc<PairCache>("witness_points"))
+        .DEF_RW_CLASS_ATTRIB(PairCache, b1)
+        .DEF_RW_CLASS_ATTRIB(PairCache, b2)
+        .DEF_RW_CLASS_ATTRIB(PairCache, num_skipped_queries)
+        .DEF_CLASS_FUNC(PairCache, clear)
+        .DEF_CLASS_FUNC(PairCache, motionBound);
+  }
 
   class_<ComputeCollision>("ComputeCollision",
                            doxygen::class_doc<ComputeCollision>(), no_init)
@@ -224,5 +278,10 @@ void exposeCollisionAPI() {
       .def("__call__",
            static_cast<std::size_t (ComputeCollision::*)(
                const Transform3f&, const Transform3f&, CollisionRequest&,
-               CollisionResult&) const>(&ComputeCollision::operator()));
+               CollisionResult&) const>(&ComputeCollision::operator()))
+      .def("__call__",
+           static_cast<std::size_t (ComputeCollision::*)(
+               const Transform3f&, const Transform3f&,
+               const CollisionRequest&, CollisionResult&, PairCache&) const>(
+               &ComputeCollision::operator()));
 }
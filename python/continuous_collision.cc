@@ -0,0 +1,113 @@
+//
+// Software License Agreement (BSD License)
+//
+//  Copyright (c) 2023, INRIA
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//   * Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above
+//     copyright notice, this list of conditions and the following
+//     disclaimer in the documentation and/or other materials provided
+//     with the distribution.
+//   * Neither the name of CNRS-LAAS. nor the names of its
+//     contributors may be used to endorse or promote products derived
+//     from this software without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+//  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+//  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+//  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+//  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+//  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+//  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+//  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <eigenpy/eigenpy.hpp>
+
+#include "fcl.hh"
+
+#include <hpp/fcl/fwd.hh>
+#include <hpp/fcl/continuous_collision.h>
+
+#ifdef HPP_FCL_HAS_DOXYGEN_AUTODOC
+#include "doxygen_autodoc/functions.h"
+#include "doxygen_autodoc/hpp/fcl/continuous_collision.h"
+#endif
+
+using namespace boost::python;
+using namespace hpp::fcl;
+
+namespace dv = doxygen::visitor;
+
+void exposeContinuousCollisionAPI() {
+  if (!eigenpy::register_symbolic_link_to_registered_type<CCDMotionType>()) {
+    enum_<CCDMotionType>("CCDMotionType")
+        .value("CCDM_LINEAR", CCDM_LINEAR)
+        .value("CCDM_SCREW", CCDM_SCREW)
+        .export_values();
+  }
+
+  if (!eigenpy::register_symbolic_link_to_registered_type<Motion>()) {
+    class_<Motion>("Motion", doxygen::class_doc<Motion>(), no_init)
+        .def(dv::init<Motion, const Transform3f&, const Transform3f&,
+                      optional<CCDMotionType> >())
+        .DEF_CLASS_FUNC(Motion, getTransform)
+        .DEF_CLASS_FUNC(Motion, speedBound)
+        .def("getBeginTransform", &Motion::getBeginTransform,
+             return_value_policy<copy_const_reference>())
+        .def("getEndTransform", &Motion::getEndTransform,
+             return_value_policy<copy_const_reference>())
+        .DEF_CLASS_FUNC(Motion, getType);
+  }
+
+  if (!eigenpy::register_symbolic_link_to_registered_type<
+          ContinuousCollisionRequest>()) {
+    class_<ContinuousCollisionRequest>(
+        "ContinuousCollisionRequest",
+        doxygen::class_doc<ContinuousCollisionRequest>(), no_init)
+        .def(dv::init<ContinuousCollisionRequest,
+                      optional<CCDMotionType, FCL_REAL, size_t> >())
+        .DEF_RW_CLASS_ATTRIB(ContinuousCollisionRequest, motion_type)
+        .DEF_RW_CLASS_ATTRIB(ContinuousCollisionRequest, distance_tolerance)
+        .DEF_RW_CLASS_ATTRIB(ContinuousCollisionRequest, num_max_iterations);
+  }
+
+  if (!eigenpy::register_symbolic_link_to_registered_type<
+          ContinuousCollisionResult>()) {
+    class_<ContinuousCollisionResult>(
+        "ContinuousCollisionResult",
+        doxygen::class_doc<ContinuousCollisionResult>(), no_init)
+        .def(dv::init<ContinuousCollisionResult>())
+        .DEF_RW_CLASS_ATTRIB(ContinuousCollisionResult, is_collide)
+        .DEF_RW_CLASS_ATTRIB(ContinuousCollisionResult, time_of_contact)
+        .DEF_RW_CLASS_ATTRIB(ContinuousCollisionResult, contact_tf1)
+        .DEF_RW_CLASS_ATTRIB(ContinuousCollisionResult, contact_tf2)
+        .DEF_RW_CLASS_ATTRIB(ContinuousCollisionResult, num_iterations)
+        .DEF_CLASS_FUNC(ContinuousCollisionResult, clear);
+  }
+
+  doxygen::def(
+      "continuousCollide",
+      static_cast<FCL_REAL (*)(
+          const CollisionGeometry*, const Transform3f&, const Transform3f&,
+          const CollisionGeometry*, const Transform3f&, const Transform3f&,
+          const ContinuousCollisionRequest&, ContinuousCollisionResult&)>(
+          &continuousCollide));
+  doxygen::def(
+      "continuousCollide",
+      static_cast<FCL_REAL (*)(const CollisionObject*, const Transform3f&,
+                               const CollisionObject*, const Transform3f&,
+                               const ContinuousCollisionRequest&,
+                               ContinuousCollisionResult&)>(
+          &continuousCollide));
+}
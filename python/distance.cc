@@ -56,6 +56,12 @@ struct DistanceRequestWrapper {
   static Vec3f getNearestPoint2(const DistanceResult& res) {
     return res.nearest_points[1];
   }
+  static VecXf getGradient1(const DistanceResult& res) {
+    return res.gradients[0];
+  }
+  static VecXf getGradient2(const DistanceResult& res) {
+    return res.gradients[1];
+  }
 };
 
 void exposeDistanceAPI() {
@@ -67,6 +73,7 @@ void exposeDistanceAPI() {
              arg("abs_err")),
             "Constructor"))
         .DEF_RW_CLASS_ATTRIB(DistanceRequest, enable_nearest_points)
+        .DEF_RW_CLASS_ATTRIB(DistanceRequest, enable_gradients)
         .DEF_RW_CLASS_ATTRIB(DistanceRequest, rel_err)
         .DEF_RW_CLASS_ATTRIB(DistanceRequest, abs_err);
   }
@@ -88,6 +95,12 @@ void exposeDistanceAPI() {
              doxygen::class_attrib_doc<DistanceResult>("nearest_points"))
         .def("getNearestPoint2", &DistanceRequestWrapper::getNearestPoint2,
              doxygen::class_attrib_doc<DistanceResult>("nearest_points"))
+        .def("getGradient1", &DistanceRequestWrapper::getGradient1,
+             doxygen::class_attrib_doc<DistanceResult>("gradients"))
+        .def("getGradient2", &DistanceRequestWrapper::getGradient2,
+             doxygen::class_attrib_doc<DistanceResult>("gradients"))
+        .def("computeGradients", &DistanceResult::computeGradients,
+             doxygen::member_func_doc(&DistanceResult::computeGradients))
         .DEF_RO_CLASS_ATTRIB(DistanceResult, o1)
         .DEF_RO_CLASS_ATTRIB(DistanceResult, o2)
         .DEF_RW_CLASS_ATTRIB(DistanceResult, b1)
@@ -121,5 +134,10 @@ void exposeDistanceAPI() {
       .def("__call__",
            static_cast<FCL_REAL (ComputeDistance::*)(
                const Transform3f&, const Transform3f&, DistanceRequest&,
-               DistanceResult&) const>(&ComputeDistance::operator()));
+               DistanceResult&) const>(&ComputeDistance::operator()))
+      .def("__call__",
+           static_cast<FCL_REAL (ComputeDistance::*)(
+               const Transform3f&, const Transform3f&, const DistanceRequest&,
+               DistanceResult&, PairCache&) const>(
+               &ComputeDistance::operator()));
 }
@@ -97,6 +97,8 @@ BOOST_PYTHON_MODULE(hppfcl) {
   exposeCollisionAPI();
   exposeDistanceAPI();
   exposeGJK();
+  exposeRaycastAPI();
+  exposeContinuousCollisionAPI();
 #ifdef HPP_FCL_HAS_OCTOMAP
   exposeOctree();
 #endif
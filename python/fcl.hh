@@ -16,6 +16,10 @@ void exposeDistanceAPI();
 
 void exposeGJK();
 
+void exposeRaycastAPI();
+
+void exposeContinuousCollisionAPI();
+
 #ifdef HPP_FCL_HAS_OCTOMAP
 void exposeOctree();
 #endif
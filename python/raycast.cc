@@ -0,0 +1,122 @@
+//
+// Software License Agreement (BSD License)
+//
+//  Copyright (c) 2023, INRIA
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//   * Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above
+//     copyright notice, this list of conditions and the following
+//     disclaimer in the documentation and/or other materials provided
+//     with the distribution.
+//   * Neither the name of CNRS-LAAS. nor the names of its
+//     contributors may be used to endorse or promote products derived
+//     from this software without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+//  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+//  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+//  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+//  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+//  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+//  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+//  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+
+#include <eigenpy/eigenpy.hpp>
+
+#include "fcl.hh"
+
+#include <hpp/fcl/fwd.hh>
+#include <hpp/fcl/raycast.h>
+
+#ifdef HPP_FCL_HAS_DOXYGEN_AUTODOC
+#include "doxygen_autodoc/functions.h"
+#include "doxygen_autodoc/hpp/fcl/raycast.h"
+#endif
+
+using namespace boost::python;
+using namespace hpp::fcl;
+
+namespace dv = doxygen::visitor;
+
+/// Cast a vector of rays and return the vector of results.
+static std::vector<RayResult> raycastRays(const CollisionGeometry* geom,
+                                          const Transform3f& tf,
+                                          const std::vector<Ray>& rays,
+                                          const RayRequest& request) {
+  std::vector<RayResult> results(rays.size());
+  raycast(geom, tf, rays.data(), rays.size(), request, results.data());
+  return results;
+}
+
+void exposeRaycastAPI() {
+  if (!eigenpy::register_symbolic_link_to_registered_type<Ray>()) {
+    class_<Ray>("Ray", doxygen::class_doc<Ray>(), no_init)
+        .def(dv::init<Ray>())
+        .def(dv::init<Ray, const Vec3f&, const Vec3f&,
+                      optional<FCL_REAL> >())
+        .DEF_RW_CLASS_ATTRIB(Ray, origin)
+        .DEF_RW_CLASS_ATTRIB(Ray, direction)
+        .DEF_RW_CLASS_ATTRIB(Ray, max_distance)
+        .DEF_CLASS_FUNC(Ray, pointAt);
+  }
+
+  if (!eigenpy::register_symbolic_link_to_registered_type<
+          std::vector<Ray> >()) {
+    class_<std::vector<Ray> >("StdVec_Ray")
+        .def(vector_indexing_suite<std::vector<Ray> >());
+  }
+
+  if (!eigenpy::register_symbolic_link_to_registered_type<RayHitMode>()) {
+    enum_<RayHitMode>("RayHitMode")
+        .value("RAY_CLOSEST_HIT", RAY_CLOSEST_HIT)
+        .value("RAY_ANY_HIT", RAY_ANY_HIT)
+        .export_values();
+  }
+
+  if (!eigenpy::register_symbolic_link_to_registered_type<RayRequest>()) {
+    class_<RayRequest>("RayRequest", doxygen::class_doc<RayRequest>(),
+                       no_init)
+        .def(dv::init<RayRequest, optional<RayHitMode, unsigned int> >())
+        .DEF_RW_CLASS_ATTRIB(RayRequest, mode)
+        .DEF_RW_CLASS_ATTRIB(RayRequest, packet_size);
+  }
+
+  if (!eigenpy::register_symbolic_link_to_registered_type<RayResult>()) {
+    class_<RayResult>("RayResult", doxygen::class_doc<RayResult>(), no_init)
+        .def(dv::init<RayResult>())
+        .DEF_RW_CLASS_ATTRIB(RayResult, hit)
+        .DEF_RW_CLASS_ATTRIB(RayResult, distance)
+        .DEF_RW_CLASS_ATTRIB(RayResult, normal)
+        .DEF_RW_CLASS_ATTRIB(RayResult, primitive_id)
+        .DEF_CLASS_FUNC(RayResult, clear);
+  }
+
+  if (!eigenpy::register_symbolic_link_to_registered_type<
+          std::vector<RayResult> >()) {
+    class_<std::vector<RayResult> >("StdVec_RayResult")
+        .def(vector_indexing_suite<std::vector<RayResult> >());
+  }
+
+  doxygen::def(
+      "raycast",
+      static_cast<bool (*)(const CollisionGeometry*, const Transform3f&,
+                           const Ray&, const RayRequest&, RayResult&)>(
+          &raycast));
+  doxygen::def(
+      "raycast",
+      static_cast<bool (*)(const CollisionObject*, const Ray&,
+                           const RayRequest&, RayResult&)>(&raycast));
+  def("raycast", &raycastRays,
+      (arg("geom"), arg("tf"), arg("rays"), arg("request")),
+      "Cast a list of rays on a geometry and return the list of results.");
+}
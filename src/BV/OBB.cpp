@@ -159,18 +159,21 @@ inline OBB merge_smalldist(const OBB& b1, const OBB& b2) {
   return b;
 }
 
-bool obbDisjoint(const Matrix3f& B, const Vec3f& T, const Vec3f& a,
-                 const Vec3f& b) {
-  FCL_REAL t, s;
-  const FCL_REAL reps = 1e-6;
-
-  Matrix3f Bf(B.array().abs() + reps);
+template <typename Scalar>
+bool obbDisjoint(const Eigen::Matrix<Scalar, 3, 3>& B,
+                 const Eigen::Matrix<Scalar, 3, 1>& T,
+                 const Eigen::Matrix<Scalar, 3, 1>& a,
+                 const Eigen::Matrix<Scalar, 3, 1>& b) {
+  Scalar t, s;
+  const Scalar reps = Scalar(1e-6);
+
+  Eigen::Matrix<Scalar, 3, 3> Bf(B.array().abs() + reps);
   // Bf += reps;
 
   // if any of these tests are one-sided, then the polyhedra are disjoint
 
   // A1 x A2 = A0
-  t = ((T[0] < 0.0) ? -T[0] : T[0]);
+  t = ((T[0] < 0) ? -T[0] : T[0]);
 
   // if(t > (a[0] + Bf.dotX(b)))
   if (t > (a[0] + Bf.row(0).dot(b))) return true;
@@ -178,19 +181,19 @@ bool obbDisjoint(const Matrix3f& B, const Vec3f& T, const Vec3f& a,
   // B1 x B2 = B0
   // s =  B.transposeDotX(T);
   s = B.col(0).dot(T);
-  t = ((s < 0.0) ? -s : s);
+  t = ((s < 0) ? -s : s);
 
   // if(t > (b[0] + Bf.transposeDotX(a)))
   if (t > (b[0] + Bf.col(0).dot(a))) return true;
 
   // A2 x A0 = A1
-  t = ((T[1] < 0.0) ? -T[1] : T[1]);
+  t = ((T[1] < 0) ? -T[1] : T[1]);
 
   // if(t > (a[1] + Bf.dotY(b)))
   if (t > (a[1] + Bf.row(1).dot(b))) return true;
 
   // A0 x A1 = A2
-  t = ((T[2] < 0.0) ? -T[2] : T[2]);
+  t = ((T[2] < 0) ? -T[2] : T[2]);
 
   // if(t > (a[2] + Bf.dotZ(b)))
   if (t > (a[2] + Bf.row(2).dot(b))) return true;
@@ -198,7 +201,7 @@ bool obbDisjoint(const Matrix3f& B, const Vec3f& T, const Vec3f& a,
   // B2 x B0 = B1
   // s = B.transposeDotY(T);
   s = B.col(1).dot(T);
-  t = ((s < 0.0) ? -s : s);
+  t = ((s < 0) ? -s : s);
 
   // if(t > (b[1] + Bf.transposeDotY(a)))
   if (t > (b[1] + Bf.col(1).dot(a))) return true;
@@ -206,14 +209,14 @@ bool obbDisjoint(const Matrix3f& B, const Vec3f& T, const Vec3f& a,
   // B0 x B1 = B2
   // s = B.transposeDotZ(T);
   s = B.col(2).dot(T);
-  t = ((s < 0.0) ? -s : s);
+  t = ((s < 0) ? -s : s);
 
   // if(t > (b[2] + Bf.transposeDotZ(a)))
   if (t > (b[2] + Bf.col(2).dot(a))) return true;
 
   // A0 x B0
   s = T[2] * B(1, 0) - T[1] * B(2, 0);
-  t = ((s < 0.0) ? -s : s);
+  t = ((s < 0) ? -s : s);
 
   if (t >
       (a[1] * Bf(2, 0) + a[2] * Bf(1, 0) + b[1] * Bf(0, 2) + b[2] * Bf(0, 1)))
@@ -221,7 +224,7 @@ bool obbDisjoint(const Matrix3f& B, const Vec3f& T, const Vec3f& a,
 
   // A0 x B1
   s = T[2] * B(1, 1) - T[1] * B(2, 1);
-  t = ((s < 0.0) ? -s : s);
+  t = ((s < 0) ? -s : s);
 
   if (t >
       (a[1] * Bf(2, 1) + a[2] * Bf(1, 1) + b[0] * Bf(0, 2) + b[2] * Bf(0, 0)))
@@ -229,7 +232,7 @@ bool obbDisjoint(const Matrix3f& B, const Vec3f& T, const Vec3f& a,
 
   // A0 x B2
   s = T[2] * B(1, 2) - T[1] * B(2, 2);
-  t = ((s < 0.0) ? -s : s);
+  t = ((s < 0) ? -s : s);
 
   if (t >
       (a[1] * Bf(2, 2) + a[2] * Bf(1, 2) + b[0] * Bf(0, 1) + b[1] * Bf(0, 0)))
@@ -237,7 +240,7 @@ bool obbDisjoint(const Matrix3f& B, const Vec3f& T, const Vec3f& a,
 
   // A1 x B0
   s = T[0] * B(2, 0) - T[2] * B(0, 0);
-  t = ((s < 0.0) ? -s : s);
+  t = ((s < 0) ? -s : s);
 
   if (t >
       (a[0] * Bf(2, 0) + a[2] * Bf(0, 0) + b[1] * Bf(1, 2) + b[2] * Bf(1, 1)))
@@ -245,7 +248,7 @@ bool obbDisjoint(const Matrix3f& B, const Vec3f& T, const Vec3f& a,
 
   // A1 x B1
   s = T[0] * B(2, 1) - T[2] * B(0, 1);
-  t = ((s < 0.0) ? -s : s);
+  t = ((s < 0) ? -s : s);
 
   if (t >
       (a[0] * Bf(2, 1) + a[2] * Bf(0, 1) + b[0] * Bf(1, 2) + b[2] * Bf(1, 0)))
@@ -253,7 +256,7 @@ bool obbDisjoint(const Matrix3f& B, const Vec3f& T, const Vec3f& a,
 
   // A1 x B2
   s = T[0] * B(2, 2) - T[2] * B(0, 2);
-  t = ((s < 0.0) ? -s : s);
+  t = ((s < 0) ? -s : s);
 
   if (t >
       (a[0] * Bf(2, 2) + a[2] * Bf(0, 2) + b[0] * Bf(1, 1) + b[1] * Bf(1, 0)))
@@ -261,7 +264,7 @@ bool obbDisjoint(const Matrix3f& B, const Vec3f& T, const Vec3f& a,
 
   // A2 x B0
   s = T[1] * B(0, 0) - T[0] * B(1, 0);
-  t = ((s < 0.0) ? -s : s);
+  t = ((s < 0) ? -s : s);
 
   if (t >
       (a[0] * Bf(1, 0) + a[1] * Bf(0, 0) + b[1] * Bf(2, 2) + b[2] * Bf(2, 1)))
@@ -269,7 +272,7 @@ bool obbDisjoint(const Matrix3f& B, const Vec3f& T, const Vec3f& a,
 
   // A2 x B1
   s = T[1] * B(0, 1) - T[0] * B(1, 1);
-  t = ((s < 0.0) ? -s : s);
+  t = ((s < 0) ? -s : s);
 
   if (t >
       (a[0] * Bf(1, 1) + a[1] * Bf(0, 1) + b[0] * Bf(2, 2) + b[2] * Bf(2, 0)))
@@ -277,7 +280,7 @@ bool obbDisjoint(const Matrix3f& B, const Vec3f& T, const Vec3f& a,
 
   // A2 x B2
   s = T[1] * B(0, 2) - T[0] * B(1, 2);
-  t = ((s < 0.0) ? -s : s);
+  t = ((s < 0) ? -s : s);
 
   if (t >
       (a[0] * Bf(1, 2) + a[1] * Bf(0, 2) + b[0] * Bf(2, 1) + b[1] * Bf(2, 0)))
@@ -286,6 +289,21 @@ bool obbDisjoint(const Matrix3f& B, const Vec3f& T, const Vec3f& a,
   return false;
 }
 
+template HPP_FCL_DLLAPI bool obbDisjoint<float>(const Eigen::Matrix3f&,
+                                                const Eigen::Vector3f&,
+                                                const Eigen::Vector3f&,
+                                                const Eigen::Vector3f&);
+template HPP_FCL_DLLAPI bool obbDisjoint<double>(const Eigen::Matrix3d&,
+                                                 const Eigen::Vector3d&,
+                                                 const Eigen::Vector3d&,
+                                                 const Eigen::Vector3d&);
+
+bool obbDisjoint(const Matrix3f& B, const Vec3f& T, const Vec3f& a,
+                 const Vec3f& b) {
+  return obbDisjoint<FCL_REAL>(B, T, a, b);
+}
+
+
 namespace internal {
 inline FCL_REAL obbDisjoint_check_A_axis(const Vec3f& T, const Vec3f& a,
                                          const Vec3f& b, const Matrix3f& Bf) {
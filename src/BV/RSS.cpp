@@ -727,6 +727,18 @@ bool RSS::overlap(const RSS& other) const {
   return (dist <= (radius + other.radius));
 }
 
+bool RSS::overlap(const RSS& other, const CollisionRequest& request,
+                  FCL_REAL& sqrDistLowerBound) const {
+  Vec3f T(axes.transpose() * (other.Tr - Tr));
+  Matrix3f R(axes.transpose() * other.axes);
+
+  FCL_REAL dist = rectDistance(R, T, length, other.length) - radius -
+                  other.radius - request.security_margin;
+  if (dist <= 0) return true;
+  sqrDistLowerBound = dist * dist;
+  return false;
+}
+
 bool overlap(const Matrix3f& R0, const Vec3f& T0, const RSS& b1,
              const RSS& b2) {
   // ROb2 = R0 . b2
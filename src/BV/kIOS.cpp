@@ -38,6 +38,7 @@
 #include <hpp/fcl/BV/kIOS.h>
 #include <hpp/fcl/BVH/BVH_utility.h>
 #include <hpp/fcl/math/transform.h>
+#include <hpp/fcl/collision_data.h>
 
 #include <iostream>
 #include <limits>
@@ -62,7 +63,8 @@ bool kIOS::overlap(const kIOS& other, const CollisionRequest& request,
   for (unsigned int i = 0; i < num_spheres; ++i) {
     for (unsigned int j = 0; j < other.num_spheres; ++j) {
       FCL_REAL o_dist = (spheres[i].o - other.spheres[j].o).squaredNorm();
-      FCL_REAL sum_r = spheres[i].r + other.spheres[j].r;
+      FCL_REAL sum_r =
+          spheres[i].r + other.spheres[j].r + request.security_margin;
       if (o_dist > sum_r * sum_r) {
         o_dist = sqrt(o_dist) - sum_r;
         sqrDistLowerBound = o_dist * o_dist;
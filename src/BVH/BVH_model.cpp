@@ -56,6 +56,7 @@ BVHModelBase::BVHModelBase()
       prev_vertices(NULL),
       num_tris(0),
       num_vertices(0),
+      point_radius(0),
       build_state(BVH_BUILD_STATE_EMPTY),
       num_tris_allocated(0),
       num_vertices_allocated(0),
@@ -65,6 +66,7 @@ BVHModelBase::BVHModelBase(const BVHModelBase& other)
     : CollisionGeometry(other),
       num_tris(other.num_tris),
       num_vertices(other.num_vertices),
+      point_radius(other.point_radius),
       build_state(other.build_state),
       num_tris_allocated(other.num_tris),
       num_vertices_allocated(other.num_vertices) {
@@ -93,8 +95,9 @@ bool BVHModelBase::isEqual(const CollisionGeometry& _other) const {
   if (other_ptr == nullptr) return false;
   const BVHModelBase& other = *other_ptr;
 
-  bool result =
-      num_tris == other.num_tris && num_vertices == other.num_vertices;
+  bool result = num_tris == other.num_tris &&
+                num_vertices == other.num_vertices &&
+                point_radius == other.point_radius;
 
   if (!result) return false;
 
@@ -749,6 +752,11 @@ void BVHModelBase::computeLocalAABB() {
 
   aabb_radius = sqrt(aabb_radius);
 
+  if (getModelType() == BVH_MODEL_POINTCLOUD) {
+    aabb_.expand(point_radius);
+    aabb_radius += point_radius;
+  }
+
   aabb_local = aabb_;
 }
 
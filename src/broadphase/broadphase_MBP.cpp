@@ -0,0 +1,605 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hpp/fcl/broadphase/broadphase_MBP.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace hpp {
+namespace fcl {
+
+//==============================================================================
+MBPCollisionManager::MBPCollisionManager(const Vec3f& scene_min_,
+                                         const Vec3f& scene_max_,
+                                         unsigned int nb_regions_x,
+                                         unsigned int nb_regions_y,
+                                         unsigned int nb_regions_z)
+    : scene_min(scene_min_), sweep_axis(0), current_stamp(0) {
+  if (nb_regions_x == 0 || nb_regions_y == 0 || nb_regions_z == 0)
+    HPP_FCL_THROW_PRETTY("The number of regions along each axis must be "
+                         "strictly positive.",
+                         std::invalid_argument);
+
+  nb_regions[0] = (int)nb_regions_x;
+  nb_regions[1] = (int)nb_regions_y;
+  nb_regions[2] = (int)nb_regions_z;
+  for (int i = 0; i < 3; ++i) {
+    FCL_REAL extent = scene_max_[i] - scene_min_[i];
+    // A flat scene is not partitioned along that axis.
+    if (extent <= 0) {
+      extent = 1;
+      nb_regions[i] = 1;
+    }
+    region_size[i] = extent / nb_regions[i];
+  }
+
+  Eigen::DenseIndex axis;
+  region_size.maxCoeff(&axis);
+  sweep_axis = (int)axis;
+
+  regions.resize((size_t)(nb_regions[0] * nb_regions[1] * nb_regions[2]));
+  for (size_t i = 0; i < regions.size(); ++i) regions[i].dirty = false;
+}
+
+//==============================================================================
+MBPCollisionManager::~MBPCollisionManager() { clear(); }
+
+//==============================================================================
+int MBPCollisionManager::computeRegion(const Vec3f& p, int region[3]) const {
+  for (int i = 0; i < 3; ++i) {
+    FCL_REAL c = (p[i] - scene_min[i]) / region_size[i];
+    if (c < 1)
+      region[i] = 0;
+    else if (c >= nb_regions[i])
+      region[i] = nb_regions[i] - 1;
+    else
+      region[i] = (int)c;
+  }
+  return regionIndex(region[0], region[1], region[2]);
+}
+
+//==============================================================================
+void MBPCollisionManager::computeRegionRange(const AABB& aabb,
+                                             int range_min[3],
+                                             int range_max[3]) const {
+  computeRegion(aabb.min_, range_min);
+  computeRegion(aabb.max_, range_max);
+}
+
+//==============================================================================
+FCL_REAL MBPCollisionManager::regionDistance(const AABB& aabb, int x, int y,
+                                             int z) const {
+  const int region[3] = {x, y, z};
+  FCL_REAL d2 = 0;
+  for (int i = 0; i < 3; ++i) {
+    // The border regions extend to infinity.
+    if (region[i] > 0) {
+      FCL_REAL lo = scene_min[i] + region[i] * region_size[i];
+      if (aabb.max_[i] < lo) d2 += (lo - aabb.max_[i]) * (lo - aabb.max_[i]);
+    }
+    if (region[i] < nb_regions[i] - 1) {
+      FCL_REAL hi = scene_min[i] + (region[i] + 1) * region_size[i];
+      if (aabb.min_[i] > hi) d2 += (aabb.min_[i] - hi) * (aabb.min_[i] - hi);
+    }
+  }
+  return std::sqrt(d2);
+}
+
+//==============================================================================
+void MBPCollisionManager::placeInRegion(MBPRegion& region, size_t index,
+                                        bool member) {
+  std::vector<size_t>& indices = region.indices;
+  if (region.dirty) {
+    if (!member) indices.push_back(index);
+    return;
+  }
+
+  const int axis = sweep_axis;
+  const FCL_REAL value = objects[index].cached.min_[axis];
+  if (!member) {
+    // Keep the region sorted.
+    auto pos = std::upper_bound(indices.begin(), indices.end(), value,
+                                [this, axis](FCL_REAL v, size_t i) {
+                                  return v < objects[i].cached.min_[axis];
+                                });
+    indices.insert(pos, index);
+    return;
+  }
+
+  // Only the key of the object changed: the other objects are still sorted
+  // and the object is moved to its place, as in an insertion sort.
+  size_t k = (size_t)(std::find(indices.begin(), indices.end(), index) -
+                      indices.begin());
+  while (k > 0 && value < objects[indices[k - 1]].cached.min_[axis]) {
+    indices[k] = indices[k - 1];
+    --k;
+  }
+  while (k + 1 < indices.size() &&
+         objects[indices[k + 1]].cached.min_[axis] < value) {
+    indices[k] = indices[k + 1];
+    ++k;
+  }
+  indices[k] = index;
+}
+
+//==============================================================================
+void MBPCollisionManager::addToRegions(size_t index, const int range_min[3],
+                                       const int range_max[3]) {
+  for (int z = range_min[2]; z <= range_max[2]; ++z)
+    for (int y = range_min[1]; y <= range_max[1]; ++y)
+      for (int x = range_min[0]; x <= range_max[0]; ++x)
+        placeInRegion(regions[(size_t)regionIndex(x, y, z)], index, false);
+}
+
+//==============================================================================
+void MBPCollisionManager::removeFromRegions(size_t index,
+                                            const int range_min[3],
+                                            const int range_max[3]) {
+  for (int z = range_min[2]; z <= range_max[2]; ++z)
+    for (int y = range_min[1]; y <= range_max[1]; ++y)
+      for (int x = range_min[0]; x <= range_max[0]; ++x) {
+        std::vector<size_t>& indices =
+            regions[(size_t)regionIndex(x, y, z)].indices;
+        auto it = std::find(indices.begin(), indices.end(), index);
+        if (it != indices.end()) indices.erase(it);
+      }
+}
+
+//==============================================================================
+void MBPCollisionManager::sortRegions() {
+  const int axis = sweep_axis;
+  const long nb = (long)regions.size();
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (long r = 0; r < nb; ++r) {
+    MBPRegion& region = regions[(size_t)r];
+    if (!region.dirty) continue;
+    std::sort(region.indices.begin(), region.indices.end(),
+              [this, axis](size_t a, size_t b) {
+                return objects[a].cached.min_[axis] <
+                       objects[b].cached.min_[axis];
+              });
+    region.dirty = false;
+  }
+}
+
+//==============================================================================
+void MBPCollisionManager::registerObjects(
+    const std::vector<CollisionObject*>& other_objs) {
+  if (other_objs.empty()) return;
+
+  // Append everything and sort the regions once.
+  for (size_t i = 0; i < regions.size(); ++i) regions[i].dirty = true;
+  objects.reserve(objects.size() + other_objs.size());
+  for (size_t i = 0; i < other_objs.size(); ++i) registerObject(other_objs[i]);
+
+  sortRegions();
+}
+
+//==============================================================================
+void MBPCollisionManager::registerObject(CollisionObject* obj) {
+  const size_t index = objects.size();
+  objects.push_back(MBPObject());
+  MBPObject& object = objects.back();
+  object.obj = obj;
+  object.cached = obj->getAABB();
+  computeRegionRange(object.cached, object.region_min, object.region_max);
+  obj_index_map[obj] = index;
+
+  addToRegions(index, object.region_min, object.region_max);
+}
+
+//==============================================================================
+void MBPCollisionManager::unregisterObject(CollisionObject* obj) {
+  auto it = obj_index_map.find(obj);
+  if (it == obj_index_map.end()) return;
+
+  const size_t index = it->second;
+  obj_index_map.erase(it);
+  removeFromRegions(index, objects[index].region_min,
+                    objects[index].region_max);
+
+  // Move the last object to the freed slot. Its AABB is unchanged, so the
+  // regions referencing it stay sorted.
+  const size_t last = objects.size() - 1;
+  if (index != last) {
+    const MBPObject& moved = objects[last];
+    for (int z = moved.region_min[2]; z <= moved.region_max[2]; ++z)
+      for (int y = moved.region_min[1]; y <= moved.region_max[1]; ++y)
+        for (int x = moved.region_min[0]; x <= moved.region_max[0]; ++x) {
+          std::vector<size_t>& indices =
+              regions[(size_t)regionIndex(x, y, z)].indices;
+          std::replace(indices.begin(), indices.end(), last, index);
+        }
+    objects[index] = moved;
+    obj_index_map[objects[index].obj] = index;
+  }
+  objects.pop_back();
+}
+
+//==============================================================================
+void MBPCollisionManager::setup() { sortRegions(); }
+
+//==============================================================================
+bool MBPCollisionManager::refreshObject(size_t index, int range_min[3],
+                                        int range_max[3]) {
+  MBPObject& object = objects[index];
+  const AABB& aabb = object.obj->getAABB();
+  if (object.cached == aabb) return false;
+  object.cached = aabb;
+  computeRegionRange(aabb, range_min, range_max);
+  return true;
+}
+
+//==============================================================================
+void MBPCollisionManager::update_(size_t index) {
+  int range_min[3], range_max[3];
+  if (!refreshObject(index, range_min, range_max)) return;
+  MBPObject& object = objects[index];
+
+  for (int z = object.region_min[2]; z <= object.region_max[2]; ++z)
+    for (int y = object.region_min[1]; y <= object.region_max[1]; ++y)
+      for (int x = object.region_min[0]; x <= object.region_max[0]; ++x) {
+        if (!inRange(x, y, z, range_min, range_max)) {
+          std::vector<size_t>& indices =
+              regions[(size_t)regionIndex(x, y, z)].indices;
+          indices.erase(std::find(indices.begin(), indices.end(), index));
+        }
+      }
+
+  for (int z = range_min[2]; z <= range_max[2]; ++z)
+    for (int y = range_min[1]; y <= range_max[1]; ++y)
+      for (int x = range_min[0]; x <= range_max[0]; ++x)
+        placeInRegion(regions[(size_t)regionIndex(x, y, z)], index,
+                      inRange(x, y, z, object.region_min, object.region_max));
+
+  std::copy(range_min, range_min + 3, object.region_min);
+  std::copy(range_max, range_max + 3, object.region_max);
+}
+
+//==============================================================================
+void MBPCollisionManager::update_(const std::vector<size_t>& indices) {
+  const long n = (long)indices.size();
+
+  // Refresh the objects in parallel, keeping their previous range.
+  std::vector<int> previous_ranges(6 * indices.size());
+  std::vector<char> moved(indices.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (n > 1024)
+#endif
+  for (long k = 0; k < n; ++k) {
+    MBPObject& object = objects[indices[(size_t)k]];
+    int* previous = &previous_ranges[6 * (size_t)k];
+    std::copy(object.region_min, object.region_min + 3, previous);
+    std::copy(object.region_max, object.region_max + 3, previous + 3);
+    moved[(size_t)k] = refreshObject(indices[(size_t)k], object.region_min,
+                                     object.region_max);
+  }
+
+  // Record the changes of region membership. The objects entering a region
+  // are appended to it, the regions left by an object are filtered below.
+  std::vector<char> left(regions.size(), false);
+  for (size_t k = 0; k < indices.size(); ++k) {
+    if (!moved[k]) continue;
+    const MBPObject& object = objects[indices[k]];
+    const int* previous_min = &previous_ranges[6 * k];
+    const int* previous_max = previous_min + 3;
+    for (int z = (std::min)(previous_min[2], object.region_min[2]);
+         z <= (std::max)(previous_max[2], object.region_max[2]); ++z)
+      for (int y = (std::min)(previous_min[1], object.region_min[1]);
+           y <= (std::max)(previous_max[1], object.region_max[1]); ++y)
+        for (int x = (std::min)(previous_min[0], object.region_min[0]);
+             x <= (std::max)(previous_max[0], object.region_max[0]); ++x) {
+          const bool was_in = inRange(x, y, z, previous_min, previous_max);
+          const bool is_in =
+              inRange(x, y, z, object.region_min, object.region_max);
+          const size_t r = (size_t)regionIndex(x, y, z);
+          if (is_in) {
+            if (!was_in) regions[r].indices.push_back(indices[k]);
+            regions[r].dirty = true;
+          } else if (was_in)
+            left[r] = true;
+        }
+  }
+
+  const long nb = (long)regions.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (long r = 0; r < nb; ++r) {
+    if (!left[(size_t)r]) continue;
+    const int x = (int)r % nb_regions[0];
+    const int y = ((int)r / nb_regions[0]) % nb_regions[1];
+    const int z = (int)r / (nb_regions[0] * nb_regions[1]);
+    std::vector<size_t>& region_indices = regions[(size_t)r].indices;
+    region_indices.erase(
+        std::remove_if(region_indices.begin(), region_indices.end(),
+                       [this, x, y, z](size_t i) {
+                         return !inRange(x, y, z, objects[i].region_min,
+                                         objects[i].region_max);
+                       }),
+        region_indices.end());
+  }
+
+  sortRegions();
+}
+
+//==============================================================================
+void MBPCollisionManager::update() {
+  std::vector<size_t> indices(objects.size());
+  for (size_t i = 0; i < indices.size(); ++i) indices[i] = i;
+  update_(indices);
+}
+
+//==============================================================================
+void MBPCollisionManager::update(CollisionObject* updated_obj) {
+  auto it = obj_index_map.find(updated_obj);
+  if (it == obj_index_map.end()) return;
+  update_(it->second);
+
+  sortRegions();
+}
+
+//==============================================================================
+void MBPCollisionManager::update(
+    const std::vector<CollisionObject*>& updated_objs) {
+  std::vector<size_t> indices;
+  indices.reserve(updated_objs.size());
+  for (size_t i = 0; i < updated_objs.size(); ++i) {
+    auto it = obj_index_map.find(updated_objs[i]);
+    if (it != obj_index_map.end()) indices.push_back(it->second);
+  }
+  // Each object is refreshed by a single thread.
+  std::sort(indices.begin(), indices.end());
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+  update_(indices);
+}
+
+//==============================================================================
+void MBPCollisionManager::clear() {
+  objects.clear();
+  obj_index_map.clear();
+  visit_stamps.clear();
+  for (size_t i = 0; i < regions.size(); ++i) {
+    regions[i].indices.clear();
+    regions[i].dirty = false;
+  }
+}
+
+//==============================================================================
+void MBPCollisionManager::getObjects(
+    std::vector<CollisionObject*>& objs) const {
+  objs.resize(objects.size());
+  for (size_t i = 0; i < objects.size(); ++i) objs[i] = objects[i].obj;
+}
+
+//==============================================================================
+bool MBPCollisionManager::collide_(CollisionObject* obj,
+                                   CollisionCallBackBase* callback) const {
+  const int axis = sweep_axis;
+  const AABB& aabb = obj->getAABB();
+
+  int range_min[3], range_max[3], owner[3];
+  computeRegionRange(aabb, range_min, range_max);
+
+  for (int z = range_min[2]; z <= range_max[2]; ++z)
+    for (int y = range_min[1]; y <= range_max[1]; ++y)
+      for (int x = range_min[0]; x <= range_max[0]; ++x) {
+        const int r = regionIndex(x, y, z);
+        const std::vector<size_t>& indices = regions[(size_t)r].indices;
+        const auto end = std::upper_bound(
+            indices.begin(), indices.end(), aabb.max_[axis],
+            [this, axis](FCL_REAL v, size_t i) {
+              return v < objects[i].cached.min_[axis];
+            });
+
+        for (auto it = indices.begin(); it != end; ++it) {
+          const MBPObject& other = objects[*it];
+          if (other.obj == obj) continue;
+          if (!other.cached.overlap(aabb)) continue;
+          // Only the region owning the lower corner of the intersection
+          // reports the pair.
+          if (computeRegion(aabb.min_.cwiseMax(other.cached.min_), owner) != r)
+            continue;
+          if ((*callback)(other.obj, obj)) return true;
+        }
+      }
+
+  return false;
+}
+
+//==============================================================================
+void MBPCollisionManager::collide(CollisionObject* obj,
+                                  CollisionCallBackBase* callback) const {
+  callback->init();
+  if (size() == 0) return;
+
+  collide_(obj, callback);
+}
+
+//==============================================================================
+void MBPCollisionManager::collide(CollisionCallBackBase* callback) const {
+  callback->init();
+  if (size() == 0) return;
+
+  const int axis = sweep_axis;
+  int owner[3];
+  for (size_t r = 0; r < regions.size(); ++r) {
+    const std::vector<size_t>& indices = regions[r].indices;
+    for (size_t i = 0; i < indices.size(); ++i) {
+      const MBPObject& a = objects[indices[i]];
+      for (size_t j = i + 1; j < indices.size(); ++j) {
+        const MBPObject& b = objects[indices[j]];
+        if (b.cached.min_[axis] > a.cached.max_[axis]) break;
+        if (!a.cached.overlap(b.cached)) continue;
+        if ((size_t)computeRegion(a.cached.min_.cwiseMax(b.cached.min_),
+                                  owner) != r)
+          continue;
+        if ((*callback)(a.obj, b.obj)) return;
+      }
+    }
+  }
+}
+
+//==============================================================================
+bool MBPCollisionManager::distance_(CollisionObject* obj, size_t first_index,
+                                    DistanceCallBackBase* callback,
+                                    FCL_REAL& min_dist) const {
+  const int axis = sweep_axis;
+  const AABB& aabb = obj->getAABB();
+
+  if (visit_stamps.size() < objects.size())
+    visit_stamps.resize(objects.size(), 0);
+  ++current_stamp;
+
+  // Visit the regions by increasing lower bound of the distance.
+  std::vector<std::pair<FCL_REAL, int> > order;
+  order.reserve(regions.size());
+  for (int z = 0; z < nb_regions[2]; ++z)
+    for (int y = 0; y < nb_regions[1]; ++y)
+      for (int x = 0; x < nb_regions[0]; ++x) {
+        const int r = regionIndex(x, y, z);
+        if (regions[(size_t)r].indices.empty()) continue;
+        FCL_REAL d = regionDistance(aabb, x, y, z);
+        if (d < min_dist) order.push_back(std::make_pair(d, r));
+      }
+  std::sort(order.begin(), order.end());
+
+  for (size_t k = 0; k < order.size(); ++k) {
+    if (order[k].first >= min_dist) break;
+
+    const std::vector<size_t>& indices =
+        regions[(size_t)order[k].second].indices;
+    for (size_t i = 0; i < indices.size(); ++i) {
+      const size_t index = indices[i];
+      const MBPObject& other = objects[index];
+      // The remaining objects of the region are further along the sweep axis.
+      if (other.cached.min_[axis] - aabb.max_[axis] >= min_dist) break;
+      if (index < first_index || visit_stamps[index] == current_stamp)
+        continue;
+      visit_stamps[index] = current_stamp;
+      if (other.obj == obj) continue;
+
+      if (other.cached.distance(aabb) < min_dist) {
+        if ((*callback)(other.obj, obj, min_dist)) return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+//==============================================================================
+void MBPCollisionManager::distance(CollisionObject* obj,
+                                   DistanceCallBackBase* callback) const {
+  callback->init();
+  if (size() == 0) return;
+
+  FCL_REAL min_dist = (std::numeric_limits<FCL_REAL>::max)();
+  distance_(obj, 0, callback, min_dist);
+}
+
+//==============================================================================
+void MBPCollisionManager::distance(DistanceCallBackBase* callback) const {
+  callback->init();
+  if (size() == 0) return;
+
+  // Each pair is considered once, from the object with the lowest index.
+  FCL_REAL min_dist = (std::numeric_limits<FCL_REAL>::max)();
+  for (size_t i = 0; i < objects.size(); ++i) {
+    if (distance_(objects[i].obj, i + 1, callback, min_dist)) return;
+  }
+}
+
+//==============================================================================
+void MBPCollisionManager::collide(BroadPhaseCollisionManager* other_manager_,
+                                  CollisionCallBackBase* callback) const {
+  callback->init();
+  MBPCollisionManager* other_manager =
+      static_cast<MBPCollisionManager*>(other_manager_);
+
+  if ((size() == 0) || (other_manager->size() == 0)) return;
+
+  if (this == other_manager) {
+    collide(callback);
+    return;
+  }
+
+  if (this->size() < other_manager->size()) {
+    for (size_t i = 0; i < objects.size(); ++i)
+      if (other_manager->collide_(objects[i].obj, callback)) return;
+  } else {
+    for (size_t i = 0; i < other_manager->objects.size(); ++i)
+      if (collide_(other_manager->objects[i].obj, callback)) return;
+  }
+}
+
+//==============================================================================
+void MBPCollisionManager::distance(BroadPhaseCollisionManager* other_manager_,
+                                   DistanceCallBackBase* callback) const {
+  callback->init();
+  MBPCollisionManager* other_manager =
+      static_cast<MBPCollisionManager*>(other_manager_);
+
+  if ((size() == 0) || (other_manager->size() == 0)) return;
+
+  if (this == other_manager) {
+    distance(callback);
+    return;
+  }
+
+  FCL_REAL min_dist = (std::numeric_limits<FCL_REAL>::max)();
+  if (this->size() < other_manager->size()) {
+    for (size_t i = 0; i < objects.size(); ++i)
+      if (other_manager->distance_(objects[i].obj, 0, callback, min_dist))
+        return;
+  } else {
+    for (size_t i = 0; i < other_manager->objects.size(); ++i)
+      if (distance_(other_manager->objects[i].obj, 0, callback, min_dist))
+        return;
+  }
+}
+
+//==============================================================================
+bool MBPCollisionManager::empty() const { return objects.empty(); }
+
+//==============================================================================
+size_t MBPCollisionManager::size() const { return objects.size(); }
+
+}  // namespace fcl
+}  // namespace hpp
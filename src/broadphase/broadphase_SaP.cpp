@@ -36,6 +36,7 @@
 /** @author Jia Pan */
 
 #include "hpp/fcl/broadphase/broadphase_SaP.h"
+#include "hpp/fcl/broadphase/detail/neighbor_search.h"
 
 namespace hpp {
 namespace fcl {
@@ -283,132 +284,100 @@ void SaPCollisionManager::setup() {
   optimal_axis = axis;
 }
 
+//==============================================================================
+void SaPCollisionManager::moveEndPoint(EndPoint* end_point, EndPoint* prev,
+                                       size_t coord) {
+  if (end_point->prev[coord] != nullptr)
+    end_point->prev[coord]->next[coord] = end_point->next[coord];
+  else
+    elist[coord] = end_point->next[coord];
+  if (end_point->next[coord] != nullptr)
+    end_point->next[coord]->prev[coord] = end_point->prev[coord];
+
+  EndPoint* next = (prev != nullptr) ? prev->next[coord] : elist[coord];
+  end_point->prev[coord] = prev;
+  end_point->next[coord] = next;
+  if (prev != nullptr)
+    prev->next[coord] = end_point;
+  else
+    elist[coord] = end_point;
+  if (next != nullptr) next->prev[coord] = end_point;
+}
+
 //==============================================================================
 void SaPCollisionManager::update_(SaPAABB* updated_aabb) {
   if (updated_aabb->cached == updated_aabb->obj->getAABB()) return;
 
   SaPAABB* current = updated_aabb;
-
-  Vec3f new_min = current->obj->getAABB().min_;
-  Vec3f new_max = current->obj->getAABB().max_;
-
-  SaPAABB dummy;
-  dummy.cached = current->obj->getAABB();
-
-  for (int coord = 0; coord < 3; ++coord) {
-    int direction;  // -1 reverse, 0 nochange, 1 forward
-    EndPoint* temp;
-
-    if (current->lo->getVal((size_t)coord) > new_min[coord])
-      direction = -1;
-    else if (current->lo->getVal((size_t)coord) < new_min[coord])
-      direction = 1;
-    else
-      direction = 0;
-
-    if (direction == -1) {
-      // first update the "lo" endpoint of the interval
-      if (current->lo->prev[coord] != nullptr) {
-        temp = current->lo;
-        while ((temp != nullptr) &&
-               (temp->getVal((size_t)coord) > new_min[coord])) {
-          if (temp->minmax == 1)
-            if (temp->aabb->cached.overlap(dummy.cached))
-              addToOverlapPairs(SaPPair(temp->aabb->obj, current->obj));
-          temp = temp->prev[coord];
-        }
-
-        if (temp == nullptr) {
-          current->lo->prev[coord]->next[coord] = current->lo->next[coord];
-          current->lo->next[coord]->prev[coord] = current->lo->prev[coord];
-          current->lo->prev[coord] = nullptr;
-          current->lo->next[coord] = elist[coord];
-          elist[coord]->prev[coord] = current->lo;
-          elist[coord] = current->lo;
-        } else {
-          current->lo->prev[coord]->next[coord] = current->lo->next[coord];
-          current->lo->next[coord]->prev[coord] = current->lo->prev[coord];
-          current->lo->prev[coord] = temp;
-          current->lo->next[coord] = temp->next[coord];
-          temp->next[coord]->prev[coord] = current->lo;
-          temp->next[coord] = current->lo;
-        }
+  const AABB& new_aabb = current->obj->getAABB();
+
+  for (size_t coord = 0; coord < 3; ++coord) {
+    const FCL_REAL new_min = new_aabb.min_[(int)coord];
+    const FCL_REAL new_max = new_aabb.max_[(int)coord];
+    EndPoint* prev;
+    EndPoint* next;
+
+    // The interval is first grown and then shrunk, so that an end point never
+    // crosses the other end point of its interval.
+
+    // The "lo" end point moves backward: the intervals whose "hi" end point is
+    // crossed start overlapping the interval along this axis.
+    if (new_min < current->lo->getVal(coord)) {
+      next = current->lo;
+      prev = current->lo->prev[coord];
+      while ((prev != nullptr) && (prev->getVal(coord) > new_min)) {
+        if ((prev->minmax == 1) && prev->aabb->cached.overlap(new_aabb))
+          addToOverlapPairs(SaPPair(prev->aabb->obj, current->obj));
+        next = prev;
+        prev = prev->prev[coord];
       }
+      if (next != current->lo) moveEndPoint(current->lo, prev, coord);
+      current->lo->getVal(coord) = new_min;
+    }
 
-      current->lo->getVal((size_t)coord) = new_min[coord];
-
-      // update hi end point
-      temp = current->hi;
-      while (temp->getVal((size_t)coord) > new_max[coord]) {
-        if ((temp->minmax == 0) &&
-            (temp->aabb->cached.overlap(current->cached)))
-          removeFromOverlapPairs(SaPPair(temp->aabb->obj, current->obj));
-        temp = temp->prev[coord];
+    // The "hi" end point moves forward: the intervals whose "lo" end point is
+    // crossed start overlapping the interval along this axis.
+    if (new_max > current->hi->getVal(coord)) {
+      prev = current->hi;
+      next = current->hi->next[coord];
+      while ((next != nullptr) && (next->getVal(coord) < new_max)) {
+        if ((next->minmax == 0) && next->aabb->cached.overlap(new_aabb))
+          addToOverlapPairs(SaPPair(next->aabb->obj, current->obj));
+        prev = next;
+        next = next->next[coord];
       }
+      if (prev != current->hi) moveEndPoint(current->hi, prev, coord);
+      current->hi->getVal(coord) = new_max;
+    }
 
-      current->hi->prev[coord]->next[coord] = current->hi->next[coord];
-      if (current->hi->next[coord] != nullptr)
-        current->hi->next[coord]->prev[coord] = current->hi->prev[coord];
-      current->hi->prev[coord] = temp;
-      current->hi->next[coord] = temp->next[coord];
-      if (temp->next[coord] != nullptr)
-        temp->next[coord]->prev[coord] = current->hi;
-      temp->next[coord] = current->hi;
-
-      current->hi->getVal((size_t)coord) = new_max[coord];
-    } else if (direction == 1) {
-      // here, we first update the "hi" endpoint.
-      if (current->hi->next[coord] != nullptr) {
-        temp = current->hi;
-        while ((temp->next[coord] != nullptr) &&
-               (temp->getVal((size_t)coord) < new_max[coord])) {
-          if (temp->minmax == 0)
-            if (temp->aabb->cached.overlap(dummy.cached))
-              addToOverlapPairs(SaPPair(temp->aabb->obj, current->obj));
-          temp = temp->next[coord];
-        }
-
-        if (temp->getVal((size_t)coord) < new_max[coord]) {
-          current->hi->prev[coord]->next[coord] = current->hi->next[coord];
-          current->hi->next[coord]->prev[coord] = current->hi->prev[coord];
-          current->hi->prev[coord] = temp;
-          current->hi->next[coord] = nullptr;
-          temp->next[coord] = current->hi;
-        } else {
-          current->hi->prev[coord]->next[coord] = current->hi->next[coord];
-          current->hi->next[coord]->prev[coord] = current->hi->prev[coord];
-          current->hi->prev[coord] = temp->prev[coord];
-          current->hi->next[coord] = temp;
-          temp->prev[coord]->next[coord] = current->hi;
-          temp->prev[coord] = current->hi;
-        }
+    // The "lo" end point moves forward: the intervals whose "hi" end point is
+    // crossed stop overlapping the interval.
+    if (new_min > current->lo->getVal(coord)) {
+      prev = current->lo;
+      next = current->lo->next[coord];
+      while (next->getVal(coord) < new_min) {
+        if (next->minmax == 1)
+          removeFromOverlapPairs(SaPPair(next->aabb->obj, current->obj));
+        prev = next;
+        next = next->next[coord];
       }
+      if (prev != current->lo) moveEndPoint(current->lo, prev, coord);
+      current->lo->getVal(coord) = new_min;
+    }
 
-      current->hi->getVal((size_t)coord) = new_max[coord];
-
-      // then, update the "lo" endpoint of the interval.
-      temp = current->lo;
-
-      while (temp->getVal((size_t)coord) < new_min[coord]) {
-        if ((temp->minmax == 1) &&
-            (temp->aabb->cached.overlap(current->cached)))
-          removeFromOverlapPairs(SaPPair(temp->aabb->obj, current->obj));
-        temp = temp->next[coord];
+    // The "hi" end point moves backward: the intervals whose "lo" end point is
+    // crossed stop overlapping the interval.
+    if (new_max < current->hi->getVal(coord)) {
+      next = current->hi;
+      prev = current->hi->prev[coord];
+      while (prev->getVal(coord) > new_max) {
+        if (prev->minmax == 0)
+          removeFromOverlapPairs(SaPPair(prev->aabb->obj, current->obj));
+        next = prev;
+        prev = prev->prev[coord];
       }
-
-      if (current->lo->prev[coord] != nullptr)
-        current->lo->prev[coord]->next[coord] = current->lo->next[coord];
-      else
-        elist[coord] = current->lo->next[coord];
-      current->lo->next[coord]->prev[coord] = current->lo->prev[coord];
-      current->lo->prev[coord] = temp->prev[coord];
-      current->lo->next[coord] = temp;
-      if (temp->prev[coord] != nullptr)
-        temp->prev[coord]->next[coord] = current->lo;
-      else
-        elist[coord] = current->lo;
-      temp->prev[coord] = current->lo;
-      current->lo->getVal((size_t)coord) = new_min[coord];
+      if (next != current->hi) moveEndPoint(current->hi, prev, coord);
+      current->hi->getVal(coord) = new_max;
     }
   }
 }
@@ -525,7 +494,7 @@ bool SaPCollisionManager::collide_(CollisionObject* obj,
   EndPoint* pos = elist[axis];
 
   while (pos != end_pos) {
-    if (pos->aabb->obj != obj) {
+    if (pos->aabb->obj != obj && pos->aabb->obj->canCollideWith(*obj)) {
       if ((pos->minmax == 0) &&
           (pos->aabb->hi->getVal((size_t)axis) >= min_val)) {
         if (pos->aabb->cached.overlap(obj->getAABB()))
@@ -678,6 +647,84 @@ void SaPCollisionManager::distance(CollisionObject* obj,
   distance_(obj, callback, min_dist);
 }
 
+//==============================================================================
+size_t SaPCollisionManager::radiusQuery(CollisionObject* obj, FCL_REAL radius,
+                                        std::vector<NeighborResult>& results,
+                                        bool exact) const {
+  results.clear();
+  if (size() == 0) return 0;
+  neighborSearch_(obj, radius, (std::numeric_limits<size_t>::max)(), results,
+                  exact);
+  return results.size();
+}
+
+//==============================================================================
+size_t SaPCollisionManager::nearestNeighbors(
+    CollisionObject* obj, size_t k, std::vector<NeighborResult>& results,
+    bool exact) const {
+  results.clear();
+  if (size() == 0 || k == 0) return 0;
+  neighborSearch_(obj, std::numeric_limits<FCL_REAL>::infinity(), k, results,
+                  exact);
+  return results.size();
+}
+
+//==============================================================================
+void SaPCollisionManager::neighborSearch_(CollisionObject* obj,
+                                          FCL_REAL max_distance, size_t k,
+                                          std::vector<NeighborResult>& results,
+                                          bool exact) const {
+  typedef detail::NeighborSearch<EndPoint*> Search;
+  Search search(obj, exact);
+  const size_t axis = (size_t)optimal_axis;
+  const AABB& obj_aabb = obj->getAABB();
+  const FCL_REAL min_val = obj_aabb.min_[axis];
+  const FCL_REAL max_val = obj_aabb.max_[axis];
+
+  EndPoint dummy;
+  SaPAABB dummy_aabb;
+  dummy_aabb.cached = obj_aabb;
+  dummy.minmax = 1;
+  dummy.aabb = &dummy_aabb;
+
+  const auto res_it = std::upper_bound(
+      velist[axis].begin(), velist[axis].end(), &dummy,
+      std::bind(std::less<FCL_REAL>(),
+                std::bind(static_cast<FCL_REAL (EndPoint::*)(size_t) const>(
+                              &EndPoint::getVal),
+                          std::placeholders::_1, axis),
+                std::bind(static_cast<FCL_REAL (EndPoint::*)(size_t) const>(
+                              &EndPoint::getVal),
+                          std::placeholders::_2, axis)));
+
+  EndPoint* end_pos = nullptr;
+  if (res_it != velist[axis].end()) end_pos = *res_it;
+
+  // The intervals starting before the end of the query interval are queued
+  // directly, as in collide_, unless they end too far before its start.
+  for (EndPoint* pos = elist[axis]; pos != end_pos; pos = pos->next[axis]) {
+    if (pos->minmax == 0 &&
+        pos->aabb->hi->getVal(axis) >= min_val - max_distance)
+      search.pushObject(pos->aabb->obj, search.lowerBound(pos->aabb->cached));
+  }
+
+  // The intervals starting after the end of the query interval are swept
+  // lazily, by increasing gap along the axis, which is a lower bound of the
+  // distance to all the objects remaining in the sweep.
+  while (end_pos && end_pos->minmax != 0) end_pos = end_pos->next[axis];
+  if (end_pos) search.pushNode(end_pos, end_pos->getVal(axis) - max_val);
+
+  search.run(max_distance, k, results,
+             [axis, max_val](EndPoint* pos, Search& search) {
+               search.pushObject(pos->aabb->obj,
+                                 search.lowerBound(pos->aabb->cached));
+               do {
+                 pos = pos->next[axis];
+               } while (pos && pos->minmax != 0);
+               if (pos) search.pushNode(pos, pos->getVal(axis) - max_val);
+             });
+}
+
 //==============================================================================
 void SaPCollisionManager::collide(CollisionCallBackBase* callback) const {
   callback->init();
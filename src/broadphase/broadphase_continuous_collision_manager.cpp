@@ -35,11 +35,7 @@
 
 /** @author Jia Pan */
 
-#ifndef HPP_FCL_BROADPHASE_BROADPHASECONTINUOUSCOLLISIONMANAGER_INL_H
-#define HPP_FCL_BROADPHASE_BROADPHASECONTINUOUSCOLLISIONMANAGER_INL_H
-
 #include "hpp/fcl/broadphase/broadphase_continuous_collision_manager.h"
-#include <algorithm>
 
 namespace hpp {
 namespace fcl {
@@ -50,20 +46,17 @@ BroadPhaseContinuousCollisionManager::BroadPhaseContinuousCollisionManager() {
 }
 
 //==============================================================================
-
 BroadPhaseContinuousCollisionManager::~BroadPhaseContinuousCollisionManager() {
   // Do nothing
 }
 
 //==============================================================================
-
 void BroadPhaseContinuousCollisionManager::registerObjects(
     const std::vector<ContinuousCollisionObject*>& other_objs) {
   for (size_t i = 0; i < other_objs.size(); ++i) registerObject(other_objs[i]);
 }
 
 //==============================================================================
-
 void BroadPhaseContinuousCollisionManager::update(
     ContinuousCollisionObject* updated_obj) {
   HPP_FCL_UNUSED_VARIABLE(updated_obj);
@@ -72,7 +65,6 @@ void BroadPhaseContinuousCollisionManager::update(
 }
 
 //==============================================================================
-
 void BroadPhaseContinuousCollisionManager::update(
     const std::vector<ContinuousCollisionObject*>& updated_objs) {
   HPP_FCL_UNUSED_VARIABLE(updated_objs);
@@ -81,7 +73,4 @@ void BroadPhaseContinuousCollisionManager::update(
 }
 
 }  // namespace fcl
-
 }  // namespace hpp
-
-#endif
@@ -0,0 +1,218 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hpp/fcl/broadphase/broadphase_continuous_dynamic_AABB_tree.h"
+
+namespace hpp {
+namespace fcl {
+
+namespace detail {
+
+namespace {
+
+/// Forwards the pairs of proxies reported by the AABB tree to a continuous
+/// collision callback.
+struct ProxyCollisionCallBack : CollisionCallBackBase {
+  ProxyCollisionCallBack(ContinuousCollisionCallBackBase* callback)
+      : callback(callback) {}
+
+  bool collide(CollisionObject* o1, CollisionObject* o2) {
+    ContinuousCollisionObject* obj1 =
+        static_cast<ContinuousCollisionObject*>(o1->getUserData());
+    ContinuousCollisionObject* obj2 =
+        static_cast<ContinuousCollisionObject*>(o2->getUserData());
+    // An object queried against a manager it belongs to meets itself.
+    if (obj1 == obj2) return false;
+    return (*callback)(obj1, obj2);
+  }
+
+  ContinuousCollisionCallBackBase* callback;
+};
+
+}  // namespace
+
+}  // namespace detail
+
+//==============================================================================
+DynamicAABBTreeContinuousCollisionManager::
+    DynamicAABBTreeContinuousCollisionManager() {
+  // The proxies only carry the swept AABB of the octrees.
+  manager.octree_as_geometry_collide = true;
+}
+
+//==============================================================================
+DynamicAABBTreeContinuousCollisionManager::
+    ~DynamicAABBTreeContinuousCollisionManager() {
+  clear();
+}
+
+//==============================================================================
+CollisionObject* DynamicAABBTreeContinuousCollisionManager::createProxy(
+    ContinuousCollisionObject* obj) const {
+  CollisionObject* proxy = new CollisionObject(
+      obj->collisionGeometry(), obj->getMotion().getBeginTransform(), false);
+  proxy->getAABB() = obj->getAABB();
+  proxy->setUserData(obj);
+  return proxy;
+}
+
+//==============================================================================
+void DynamicAABBTreeContinuousCollisionManager::registerObjects(
+    const std::vector<ContinuousCollisionObject*>& other_objs) {
+  std::vector<CollisionObject*> new_proxies;
+  new_proxies.reserve(other_objs.size());
+  for (size_t i = 0; i < other_objs.size(); ++i) {
+    if (proxies.count(other_objs[i])) continue;
+    CollisionObject* proxy = createProxy(other_objs[i]);
+    proxies[other_objs[i]] = proxy;
+    new_proxies.push_back(proxy);
+  }
+  manager.registerObjects(new_proxies);
+}
+
+//==============================================================================
+void DynamicAABBTreeContinuousCollisionManager::registerObject(
+    ContinuousCollisionObject* obj) {
+  if (proxies.count(obj)) return;
+  CollisionObject* proxy = createProxy(obj);
+  proxies[obj] = proxy;
+  manager.registerObject(proxy);
+}
+
+//==============================================================================
+void DynamicAABBTreeContinuousCollisionManager::unregisterObject(
+    ContinuousCollisionObject* obj) {
+  auto it = proxies.find(obj);
+  if (it == proxies.end()) return;
+  manager.unregisterObject(it->second);
+  delete it->second;
+  proxies.erase(it);
+}
+
+//==============================================================================
+void DynamicAABBTreeContinuousCollisionManager::setup() { manager.setup(); }
+
+//==============================================================================
+void DynamicAABBTreeContinuousCollisionManager::update() {
+  for (auto it = proxies.begin(); it != proxies.end(); ++it)
+    it->second->getAABB() = it->first->getAABB();
+  manager.update();
+}
+
+//==============================================================================
+void DynamicAABBTreeContinuousCollisionManager::update(
+    ContinuousCollisionObject* updated_obj) {
+  auto it = proxies.find(updated_obj);
+  if (it == proxies.end()) return;
+  it->second->getAABB() = updated_obj->getAABB();
+  manager.update(it->second);
+}
+
+//==============================================================================
+void DynamicAABBTreeContinuousCollisionManager::update(
+    const std::vector<ContinuousCollisionObject*>& updated_objs) {
+  std::vector<CollisionObject*> updated_proxies;
+  updated_proxies.reserve(updated_objs.size());
+  for (size_t i = 0; i < updated_objs.size(); ++i) {
+    auto it = proxies.find(updated_objs[i]);
+    if (it == proxies.end()) continue;
+    it->second->getAABB() = updated_objs[i]->getAABB();
+    updated_proxies.push_back(it->second);
+  }
+  manager.update(updated_proxies);
+}
+
+//==============================================================================
+void DynamicAABBTreeContinuousCollisionManager::clear() {
+  manager.clear();
+  for (auto it = proxies.begin(); it != proxies.end(); ++it) delete it->second;
+  proxies.clear();
+}
+
+//==============================================================================
+void DynamicAABBTreeContinuousCollisionManager::getObjects(
+    std::vector<ContinuousCollisionObject*>& objs) const {
+  objs.clear();
+  objs.reserve(proxies.size());
+  for (auto it = proxies.begin(); it != proxies.end(); ++it)
+    objs.push_back(it->first);
+}
+
+//==============================================================================
+void DynamicAABBTreeContinuousCollisionManager::collide(
+    ContinuousCollisionObject* obj,
+    ContinuousCollisionCallBackBase* callback) const {
+  callback->init();
+  detail::ProxyCollisionCallBack proxy_callback(callback);
+  auto it = proxies.find(obj);
+  if (it != proxies.end()) {
+    manager.collide(it->second, &proxy_callback);
+  } else {
+    CollisionObject* proxy = createProxy(obj);
+    manager.collide(proxy, &proxy_callback);
+    delete proxy;
+  }
+}
+
+//==============================================================================
+void DynamicAABBTreeContinuousCollisionManager::collide(
+    ContinuousCollisionCallBackBase* callback) const {
+  callback->init();
+  detail::ProxyCollisionCallBack proxy_callback(callback);
+  manager.collide(&proxy_callback);
+}
+
+//==============================================================================
+void DynamicAABBTreeContinuousCollisionManager::collide(
+    BroadPhaseContinuousCollisionManager* other_manager_,
+    ContinuousCollisionCallBackBase* callback) const {
+  callback->init();
+  DynamicAABBTreeContinuousCollisionManager* other_manager =
+      static_cast<DynamicAABBTreeContinuousCollisionManager*>(other_manager_);
+  detail::ProxyCollisionCallBack proxy_callback(callback);
+  manager.collide(&other_manager->manager, &proxy_callback);
+}
+
+//==============================================================================
+bool DynamicAABBTreeContinuousCollisionManager::empty() const {
+  return proxies.empty();
+}
+
+//==============================================================================
+size_t DynamicAABBTreeContinuousCollisionManager::size() const {
+  return proxies.size();
+}
+
+}  // namespace fcl
+}  // namespace hpp
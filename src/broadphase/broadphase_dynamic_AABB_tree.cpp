@@ -45,6 +45,7 @@
 
 #include "hpp/fcl/BV/BV.h"
 #include "hpp/fcl/shape/geometric_shapes_utility.h"
+#include "hpp/fcl/broadphase/detail/neighbor_search.h"
 
 namespace hpp {
 namespace fcl {
@@ -248,10 +249,48 @@ bool distanceRecurse(DynamicAABBTreeCollisionManager::DynamicAABBNode* root1,
 
 #endif
 
+//==============================================================================
+void updateCollisionFilters(
+    DynamicAABBTreeCollisionManager::DynamicAABBNode* node) {
+  if (node->isLeaf()) {
+    const CollisionObject* obj = static_cast<CollisionObject*>(node->data);
+    node->collision_group = obj->getCollisionGroup();
+    node->collision_mask = obj->getCollisionMask();
+    return;
+  }
+
+  updateCollisionFilters(node->children[0]);
+  updateCollisionFilters(node->children[1]);
+  node->collision_group =
+      node->children[0]->collision_group | node->children[1]->collision_group;
+  node->collision_mask =
+      node->children[0]->collision_mask | node->children[1]->collision_mask;
+}
+
+//==============================================================================
+void updateCollisionFiltersToRoot(
+    DynamicAABBTreeCollisionManager::DynamicAABBNode* leaf) {
+  const CollisionObject* obj = static_cast<CollisionObject*>(leaf->data);
+  leaf->collision_group = obj->getCollisionGroup();
+  leaf->collision_mask = obj->getCollisionMask();
+
+  for (DynamicAABBTreeCollisionManager::DynamicAABBNode* node = leaf->parent;
+       node; node = node->parent) {
+    node->collision_group =
+        node->children[0]->collision_group | node->children[1]->collision_group;
+    node->collision_mask =
+        node->children[0]->collision_mask | node->children[1]->collision_mask;
+  }
+}
+
 //==============================================================================
 bool collisionRecurse(DynamicAABBTreeCollisionManager::DynamicAABBNode* root1,
                       DynamicAABBTreeCollisionManager::DynamicAABBNode* root2,
                       CollisionCallBackBase* callback) {
+  if (!collisionFiltersMatch(root1->collision_group, root1->collision_mask,
+                             root2->collision_group, root2->collision_mask))
+    return false;
+
   if (root1->isLeaf() && root2->isLeaf()) {
     if (!root1->bv.overlap(root2->bv)) return false;
     return (*callback)(static_cast<CollisionObject*>(root1->data),
@@ -274,6 +313,11 @@ bool collisionRecurse(DynamicAABBTreeCollisionManager::DynamicAABBNode* root1,
 //==============================================================================
 bool collisionRecurse(DynamicAABBTreeCollisionManager::DynamicAABBNode* root,
                       CollisionObject* query, CollisionCallBackBase* callback) {
+  if (!collisionFiltersMatch(root->collision_group, root->collision_mask,
+                             query->getCollisionGroup(),
+                             query->getCollisionMask()))
+    return false;
+
   if (root->isLeaf()) {
     if (!root->bv.overlap(query->getAABB())) return false;
     return (*callback)(static_cast<CollisionObject*>(root->data), query);
@@ -299,6 +343,9 @@ bool selfCollisionRecurse(
     CollisionCallBackBase* callback) {
   if (root->isLeaf()) return false;
 
+  // No group of the subtree matches any mask of the subtree.
+  if (!(root->collision_group & root->collision_mask)) return false;
+
   if (selfCollisionRecurse(root->children[0], callback)) return true;
 
   if (selfCollisionRecurse(root->children[1], callback)) return true;
@@ -469,6 +516,7 @@ void DynamicAABBTreeCollisionManager::registerObjects(
     }
 
     dtree.init(leaves, tree_init_level);
+    detail::dynamic_AABB_tree::updateCollisionFilters(dtree.getRoot());
 
     setup_ = true;
   }
@@ -477,6 +525,7 @@ void DynamicAABBTreeCollisionManager::registerObjects(
 //==============================================================================
 void DynamicAABBTreeCollisionManager::registerObject(CollisionObject* obj) {
   DynamicAABBNode* node = dtree.insert(obj->getAABB(), obj);
+  detail::dynamic_AABB_tree::updateCollisionFiltersToRoot(node);
   table[obj] = node;
 }
 
@@ -498,11 +547,15 @@ void DynamicAABBTreeCollisionManager::setup() {
 
     size_t height = dtree.getMaxHeight();
 
+    // The incremental balancing keeps the collision filters of the internal
+    // nodes valid, the top-down balancing rebuilds them.
     if (((FCL_REAL)height - std::log((FCL_REAL)num) / std::log(2.0)) <
-        max_tree_nonbalanced_level)
+        max_tree_nonbalanced_level) {
       dtree.balanceIncremental(tree_incremental_balance_pass);
-    else
+    } else {
       dtree.balanceTopdown();
+      detail::dynamic_AABB_tree::updateCollisionFilters(dtree.getRoot());
+    }
 
     setup_ = true;
   }
@@ -519,6 +572,8 @@ void DynamicAABBTreeCollisionManager::update() {
   }
 
   dtree.refit();
+  if (dtree.getRoot())
+    detail::dynamic_AABB_tree::updateCollisionFilters(dtree.getRoot());
   setup_ = false;
 
   setup();
@@ -531,6 +586,7 @@ void DynamicAABBTreeCollisionManager::update_(CollisionObject* updated_obj) {
     DynamicAABBNode* node = it->second;
     if (!(node->bv == updated_obj->getAABB()))
       dtree.update(node, updated_obj->getAABB());
+    detail::dynamic_AABB_tree::updateCollisionFiltersToRoot(node);
   }
   setup_ = false;
 }
@@ -658,6 +714,58 @@ void DynamicAABBTreeCollisionManager::distance(
       dtree.getRoot(), other_manager->dtree.getRoot(), callback, min_dist);
 }
 
+//==============================================================================
+size_t DynamicAABBTreeCollisionManager::radiusQuery(
+    CollisionObject* obj, FCL_REAL radius, std::vector<NeighborResult>& results,
+    bool exact) const {
+  results.clear();
+  if (size() == 0) return 0;
+  neighborSearch_(obj, radius, (std::numeric_limits<size_t>::max)(), results,
+                  exact);
+  return results.size();
+}
+
+//==============================================================================
+size_t DynamicAABBTreeCollisionManager::nearestNeighbors(
+    CollisionObject* obj, size_t k, std::vector<NeighborResult>& results,
+    bool exact) const {
+  results.clear();
+  if (size() == 0 || k == 0) return 0;
+  neighborSearch_(obj, std::numeric_limits<FCL_REAL>::infinity(), k, results,
+                  exact);
+  return results.size();
+}
+
+//==============================================================================
+void DynamicAABBTreeCollisionManager::neighborSearch_(
+    CollisionObject* obj, FCL_REAL max_distance, size_t k,
+    std::vector<NeighborResult>& results, bool exact) const {
+  typedef detail::NeighborSearch<DynamicAABBNode*> Search;
+  Search search(obj, exact);
+  const CollisionGroup group = obj->getCollisionGroup();
+  const CollisionGroup mask = obj->getCollisionMask();
+
+  // Queue a node, unless none of the objects of its subtree can collide with
+  // the query object.
+  auto push = [group, mask](DynamicAABBNode* node, Search& search) {
+    if (!collisionFiltersMatch(node->collision_group, node->collision_mask,
+                               group, mask))
+      return;
+    if (node->isLeaf())
+      search.pushObject(static_cast<CollisionObject*>(node->data),
+                        search.lowerBound(node->bv));
+    else
+      search.pushNode(node, search.lowerBound(node->bv));
+  };
+
+  push(dtree.getRoot(), search);
+  search.run(max_distance, k, results,
+             [&push](DynamicAABBNode* node, Search& search) {
+               push(node->children[0], search);
+               push(node->children[1], search);
+             });
+}
+
 //==============================================================================
 bool DynamicAABBTreeCollisionManager::empty() const { return dtree.empty(); }
 
@@ -261,7 +261,7 @@ void IntervalTreeCollisionManager::update(CollisionObject* updated_obj) {
     dummy.value = old_aabb.max_[i];
     it = std::lower_bound(endpoints[i].begin(), endpoints[i].end(), dummy);
     for (; it != endpoints[i].end(); ++it) {
-      if (it->obj == updated_obj && it->minmax == 0) {
+      if (it->obj == updated_obj && it->minmax == 1) {
         it->value = new_aabb.max_[i];
         break;
       }
@@ -474,6 +474,8 @@ void IntervalTreeCollisionManager::collide(
       auto end = active.end();
       for (; iter != end; ++iter) {
         CollisionObject* active_index = *iter;
+        if (!active_index->canCollideWith(*index)) continue;
+
         const AABB& b0 = active_index->getAABB();
         const AABB& b1 = index->getAABB();
 
@@ -587,7 +589,7 @@ bool IntervalTreeCollisionManager::checkColl(
     CollisionObject* obj, CollisionCallBackBase* callback) const {
   while (pos_start < pos_end) {
     SAPInterval* ivl = static_cast<SAPInterval*>(*pos_start);
-    if (ivl->obj != obj) {
+    if (ivl->obj != obj && ivl->obj->canCollideWith(*obj)) {
       if (ivl->obj->getAABB().overlap(obj->getAABB())) {
         if ((*callback)(ivl->obj, obj)) return true;
       }
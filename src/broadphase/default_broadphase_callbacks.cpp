@@ -35,11 +35,24 @@
 /** @author Sean Curtis (sean@tri.global) */
 
 #include "hpp/fcl/broadphase/default_broadphase_callbacks.h"
+#include "hpp/fcl/collision_utility.h"
+#include "hpp/fcl/narrowphase/narrowphase.h"
+#include "hpp/fcl/typed_query.h"
 #include <algorithm>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <utility>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace hpp {
 namespace fcl {
 
+CollisionFunctionMatrix& getCollisionFunctionLookTable();
+
 bool defaultCollisionFunction(CollisionObject* o1, CollisionObject* o2,
                               void* data) {
   assert(data != nullptr);
@@ -64,6 +77,55 @@ bool CollisionCallBackDefault::collide(CollisionObject* o1,
   return defaultCollisionFunction(o1, o2, &data);
 }
 
+bool defaultContinuousCollisionFunction(ContinuousCollisionObject* o1,
+                                        ContinuousCollisionObject* o2,
+                                        void* data) {
+  assert(data != nullptr);
+  auto* cdata = static_cast<ContinuousCollisionData*>(data);
+
+  if (cdata->done) return true;
+
+  ContinuousCollisionResult result;
+  continuousCollide(o1, o2, cdata->request, result);
+
+  if (result.is_collide &&
+      (!cdata->result.is_collide ||
+       result.time_of_contact < cdata->result.time_of_contact)) {
+    cdata->result = result;
+    cdata->o1 = o1;
+    cdata->o2 = o2;
+    // No pair can come in contact earlier.
+    if (result.time_of_contact == 0) cdata->done = true;
+  }
+
+  return cdata->done;
+}
+
+bool ContinuousCollisionCallBackDefault::collide(
+    ContinuousCollisionObject* o1, ContinuousCollisionObject* o2) {
+  return defaultContinuousCollisionFunction(o1, o2, &data);
+}
+
+ContinuousCollisionCallBackCollect::ContinuousCollisionCallBackCollect(
+    const ContinuousCollisionRequest& request)
+    : request(request) {}
+
+bool ContinuousCollisionCallBackCollect::collide(
+    ContinuousCollisionObject* o1, ContinuousCollisionObject* o2) {
+  ContinuousCollisionResult result;
+  continuousCollide(o1, o2, request, result);
+  if (result.is_collide) {
+    colliding_pairs.push_back(std::make_pair(o1, o2));
+    results.push_back(result);
+  }
+  return false;
+}
+
+void ContinuousCollisionCallBackCollect::init() {
+  colliding_pairs.clear();
+  results.clear();
+}
+
 bool defaultDistanceFunction(CollisionObject* o1, CollisionObject* o2,
                              void* data, FCL_REAL& dist) {
   assert(data != nullptr);
@@ -117,5 +179,288 @@ bool CollisionCallBackCollect::exist(const CollisionPair& pair) const {
          collision_pairs.end();
 }
 
+CollisionCallBackBatch::CollisionCallBackBatch(
+    const CollisionRequest& request, bool parallel)
+    : request(request), parallel(parallel) {}
+
+bool CollisionCallBackBatch::collide(CollisionObject* o1,
+                                     CollisionObject* o2) {
+  collision_pairs.push_back(std::make_pair(o1, o2));
+  return false;
+}
+
+void CollisionCallBackBatch::init() { collision_pairs.clear(); }
+
+namespace {
+/// @brief Pairs in collision found by a thread, with the index of the pair
+/// in the collection order. The results are stored in a deque so that they
+/// are not copied again when more pairs are found.
+struct BatchOutput {
+  CollisionResult result;
+  std::vector<size_t> indices;
+  std::deque<CollisionResult> results;
+
+  /// @brief Result of the next query
+  CollisionResult& next() {
+    result.clear();
+    return result;
+  }
+
+  /// @brief Keep the result of the last query if the pair is in collision.
+  void add(size_t index) {
+    if (result.isCollision()) {
+      indices.push_back(index);
+      results.push_back(result);
+    }
+  }
+};
+
+/// @brief Geometries of the pairs of a bucket, which all have the same node
+/// types, and the collision function of these node types.
+struct BatchBucket {
+  CollisionFunctionMatrix::CollisionFunc func;
+  bool swap_geoms;
+};
+
+/// @brief Run the narrowphase on the pairs of indices [begin, end) of a
+/// bucket.
+typedef void (*BatchLoop)(const BatchBucket& bucket,
+                          const CollisionCallBackBatch::CollisionPair* pairs,
+                          const size_t* begin, const size_t* end,
+                          const GJKSolver* solver,
+                          const CollisionRequest& request,
+                          BatchOutput& output);
+
+/// @brief Loop of the buckets which have no specialized loop, through the
+/// collision function of the bucket.
+void collideBucket(const BatchBucket& bucket,
+                   const CollisionCallBackBatch::CollisionPair* pairs,
+                   const size_t* begin, const size_t* end,
+                   const GJKSolver* solver, const CollisionRequest& request,
+                   BatchOutput& output) {
+  for (const size_t* it = begin; it != end; ++it) {
+    const CollisionObject* o1 = pairs[*it].first;
+    const CollisionObject* o2 = pairs[*it].second;
+    CollisionResult& result = output.next();
+    if (bucket.swap_geoms) {
+      bucket.func(o2->collisionGeometry().get(), o2->getTransform(),
+                  o1->collisionGeometry().get(), o1->getTransform(), solver,
+                  request, result);
+      result.swapObjects();
+    } else
+      bucket.func(o1->collisionGeometry().get(), o1->getTransform(),
+                  o2->collisionGeometry().get(), o2->getTransform(), solver,
+                  request, result);
+    output.add(*it);
+  }
+}
+
+/// @brief Loop of the buckets of shapes of types S1 and S2, where the
+/// collision function is resolved at compile time.
+template <typename S1, typename S2, typename Enable = void>
+struct ShapeBatchLoop {
+  enum { Supported = false };
+};
+
+template <typename S1, typename S2>
+struct ShapeBatchLoop<S1, S2,
+                      typename std::enable_if<CollisionFunctor<
+                          S1, S2, void>::Supported>::type> {
+  enum { Supported = true };
+  static void run(const BatchBucket& /*bucket*/,
+                  const CollisionCallBackBatch::CollisionPair* pairs,
+                  const size_t* begin, const size_t* end,
+                  const GJKSolver* solver, const CollisionRequest& request,
+                  BatchOutput& output) {
+    for (const size_t* it = begin; it != end; ++it) {
+      const CollisionObject* o1 = pairs[*it].first;
+      const CollisionObject* o2 = pairs[*it].second;
+      CollisionFunctor<S1, S2>::run(
+          o1->collisionGeometry().get(), o1->getTransform(),
+          o2->collisionGeometry().get(), o2->getTransform(), solver, request,
+          output.next());
+      output.add(*it);
+    }
+  }
+};
+
+/// @brief Shapes which get a specialized loop. For the other geometries, the
+/// cost of a query is large compared to the one of the dispatch.
+typedef details::type_list<Box, Sphere, Ellipsoid, Capsule, Cone, Cylinder,
+                           ConvexBase, Plane, Halfspace>
+    batch_shape_types;
+
+/// @brief Loops of the buckets, indexed by the node types of the pairs.
+struct BatchLoopTable {
+  BatchLoop loops[NODE_COUNT][NODE_COUNT];
+
+  BatchLoopTable() {
+    for (int i = 0; i < NODE_COUNT; ++i)
+      for (int j = 0; j < NODE_COUNT; ++j) loops[i][j] = &collideBucket;
+    details::registerFunctions<ShapeBatchLoop>(loops, batch_shape_types());
+  }
+};
+
+const BatchLoopTable& getBatchLoopTable() {
+  static const BatchLoopTable table;
+  return table;
+}
+
+/// @brief Range [begin, end) of the sorted pair indices, whose pairs are in
+/// the same bucket.
+struct BatchTask {
+  size_t bucket;
+  size_t begin, end;
+};
+
+/// @brief Number of consecutive pairs which are grouped by bucket. The pairs
+/// are only grouped within such windows: consecutive pairs of the broadphase
+/// often share an object, which is still in the cache when the other pairs
+/// of the window are processed.
+const size_t batch_window_size = 256;
+}  // namespace
+
+size_t CollisionCallBackBatch::processPairs() {
+  colliding_pairs.clear();
+  results.clear();
+
+  const size_t size = collision_pairs.size();
+  // If security margin is set to -infinity, return that there is no collision
+  if (size == 0 ||
+      request.security_margin == -std::numeric_limits<FCL_REAL>::infinity())
+    return 0;
+
+  if (request.num_max_contacts == 0)
+    HPP_FCL_THROW_PRETTY("Invalid number of max contacts (current value is 0).",
+                         std::invalid_argument);
+
+  // Bucket the pairs by node types. The collision functions are looked up
+  // before running any query, so that an unsupported pair is reported before
+  // doing any work.
+  const CollisionFunctionMatrix& looktable = getCollisionFunctionLookTable();
+  const BatchLoopTable& loop_table = getBatchLoopTable();
+  std::vector<BatchBucket> buckets;
+  std::vector<BatchLoop> loops;
+  std::vector<size_t> key_buckets(NODE_COUNT * NODE_COUNT, size);
+  std::vector<size_t> pair_buckets(size);
+  for (size_t i = 0; i < size; ++i) {
+    const CollisionGeometry* o1 =
+        collision_pairs[i].first->collisionGeometry().get();
+    const CollisionGeometry* o2 =
+        collision_pairs[i].second->collisionGeometry().get();
+    const NODE_TYPE node_type1 = o1->getNodeType();
+    const NODE_TYPE node_type2 = o2->getNodeType();
+    size_t& bucket_index =
+        key_buckets[(size_t)node_type1 * NODE_COUNT + (size_t)node_type2];
+    if (bucket_index == size) {
+      const OBJECT_TYPE object_type2 = o2->getObjectType();
+      BatchBucket bucket;
+      bucket.swap_geoms =
+          o1->getObjectType() == OT_GEOM &&
+          (object_type2 == OT_BVH || object_type2 == OT_HFIELD);
+      bucket.func = bucket.swap_geoms
+                        ? looktable.collision_matrix[node_type2][node_type1]
+                        : looktable.collision_matrix[node_type1][node_type2];
+      if (!bucket.func)
+        HPP_FCL_THROW_PRETTY("Collision function between node type "
+                                 << std::string(get_node_type_name(node_type1))
+                                 << " and node type "
+                                 << std::string(get_node_type_name(node_type2))
+                                 << " is not yet supported.",
+                             std::invalid_argument);
+      bucket_index = buckets.size();
+      buckets.push_back(bucket);
+      loops.push_back(loop_table.loops[node_type1][node_type2]);
+    }
+    pair_buckets[i] = bucket_index;
+  }
+
+  // Sort the pair indices of each window by bucket, keeping the collection
+  // order within a bucket. A task is made of the pairs of a window which are
+  // in the same bucket.
+  std::vector<size_t> sorted(size);
+  std::vector<BatchTask> tasks;
+  std::vector<size_t> window_tasks(1, 0);
+  std::vector<size_t> offsets(buckets.size() + 1);
+  for (size_t window = 0; window < size; window += batch_window_size) {
+    const size_t window_end = std::min(window + batch_window_size, size);
+    std::fill(offsets.begin(), offsets.end(), 0);
+    for (size_t i = window; i < window_end; ++i) ++offsets[pair_buckets[i] + 1];
+    offsets[0] = window;
+    for (size_t b = 0; b < buckets.size(); ++b) {
+      if (offsets[b + 1] > 0) {
+        BatchTask task;
+        task.bucket = b;
+        task.begin = offsets[b];
+        task.end = offsets[b] + offsets[b + 1];
+        tasks.push_back(task);
+      }
+      offsets[b + 1] += offsets[b];
+    }
+    for (size_t i = window; i < window_end; ++i)
+      sorted[offsets[pair_buckets[i]]++] = i;
+    window_tasks.push_back(tasks.size());
+  }
+
+  std::vector<BatchOutput> outputs(1);
+  if (parallel) {
+#ifdef _OPENMP
+    outputs.resize((size_t)omp_get_max_threads());
+#endif
+    const long nb_windows = (long)(window_tasks.size() - 1);
+    std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      GJKSolver solver(request);
+#ifdef _OPENMP
+      BatchOutput& output = outputs[(size_t)omp_get_thread_num()];
+#pragma omp for schedule(dynamic) nowait
+#else
+      BatchOutput& output = outputs[0];
+#endif
+      for (long w = 0; w < nb_windows; ++w) {
+        try {
+          for (size_t t = window_tasks[(size_t)w];
+               t < window_tasks[(size_t)w + 1]; ++t)
+            loops[tasks[t].bucket](
+                buckets[tasks[t].bucket], collision_pairs.data(),
+                sorted.data() + tasks[t].begin, sorted.data() + tasks[t].end,
+                &solver, request, output);
+        } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+          if (!error) error = std::current_exception();
+        }
+      }
+    }
+    if (error) std::rethrow_exception(error);
+  } else {
+    GJKSolver solver(request);
+    for (size_t t = 0; t < tasks.size(); ++t)
+      loops[tasks[t].bucket](buckets[tasks[t].bucket], collision_pairs.data(),
+                             sorted.data() + tasks[t].begin,
+                             sorted.data() + tasks[t].end, &solver, request,
+                             outputs[0]);
+  }
+
+  // Report the pairs in collision in the collection order.
+  std::vector<std::pair<size_t, const CollisionResult*> > found;
+  for (size_t o = 0; o < outputs.size(); ++o)
+    for (size_t i = 0; i < outputs[o].indices.size(); ++i)
+      found.push_back(
+          std::make_pair(outputs[o].indices[i], &outputs[o].results[i]));
+  std::sort(found.begin(), found.end());
+  colliding_pairs.resize(found.size());
+  results.reserve(found.size());
+  for (size_t i = 0; i < found.size(); ++i) {
+    colliding_pairs[i] = collision_pairs[found[i].first];
+    results.push_back(*found[i].second);
+  }
+  return results.size();
+}
+
 }  // namespace fcl
 }  // namespace hpp
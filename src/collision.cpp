@@ -38,10 +38,16 @@
 #include <hpp/fcl/collision.h>
 #include <hpp/fcl/collision_utility.h>
 #include <hpp/fcl/collision_func_matrix.h>
+#include <hpp/fcl/typed_query.h>
 #include <hpp/fcl/narrowphase/narrowphase.h>
 
+#include <exception>
 #include <iostream>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace hpp {
 namespace fcl {
 
@@ -52,8 +58,9 @@ CollisionFunctionMatrix& getCollisionFunctionLookTable() {
 
 // reorder collision results in the order the call has been made.
 void CollisionResult::swapObjects() {
-  for (std::vector<Contact>::iterator it = contacts.begin();
-       it != contacts.end(); ++it) {
+  std::vector<Contact>& storage = contactStorage();
+  for (std::vector<Contact>::iterator it = storage.begin();
+       it != storage.end(); ++it) {
     std::swap(it->o1, it->o2);
     std::swap(it->b1, it->b2);
     it->normal *= -1;
@@ -70,6 +77,7 @@ std::size_t collide(const CollisionObject* o1, const CollisionObject* o2,
 std::size_t collide(const CollisionGeometry* o1, const Transform3f& tf1,
                     const CollisionGeometry* o2, const Transform3f& tf2,
                     const CollisionRequest& request, CollisionResult& result) {
+  HPP_FCL_PROFILE_SCOPE(result.profile);
   // If securit margin is set to -infinity, return that there is no collision
   if (request.security_margin == -std::numeric_limits<FCL_REAL>::infinity()) {
     result.clear();
@@ -85,6 +93,7 @@ std::size_t collide(const CollisionGeometry* o1, const Transform3f& tf1,
                          std::invalid_argument);
     res = 0;
   } else {
+    details::checkContactCapacity(request, result);
     OBJECT_TYPE object_type1 = o1->getObjectType();
     OBJECT_TYPE object_type2 = o2->getObjectType();
     NODE_TYPE node_type1 = o1->getNodeType();
@@ -159,7 +168,8 @@ ComputeCollision::ComputeCollision(const CollisionGeometry* o1,
 std::size_t ComputeCollision::run(const Transform3f& tf1,
                                   const Transform3f& tf2,
                                   const CollisionRequest& request,
-                                  CollisionResult& result) const {
+                                  CollisionResult& result,
+                                  const GJKSolver* solver) const {
   // If security margin is set to -infinity, return that there is no collision
   if (request.security_margin == -std::numeric_limits<FCL_REAL>::infinity()) {
     result.clear();
@@ -167,10 +177,10 @@ std::size_t ComputeCollision::run(const Transform3f& tf1,
   }
   std::size_t res;
   if (swap_geoms) {
-    res = func(o2, tf2, o1, tf1, &solver, request, result);
+    res = func(o2, tf2, o1, tf1, solver, request, result);
     result.swapObjects();
   } else {
-    res = func(o1, tf1, o2, tf2, &solver, request, result);
+    res = func(o1, tf1, o2, tf2, solver, request, result);
   }
   return res;
 }
@@ -178,18 +188,27 @@ std::size_t ComputeCollision::run(const Transform3f& tf1,
 std::size_t ComputeCollision::operator()(const Transform3f& tf1,
                                          const Transform3f& tf2,
                                          const CollisionRequest& request,
-                                         CollisionResult& result) const
+                                         CollisionResult& result) const {
+  GJKSolver solver;
+  return operator()(tf1, tf2, request, result, solver);
+}
 
-{
+std::size_t ComputeCollision::operator()(const Transform3f& tf1,
+                                         const Transform3f& tf2,
+                                         const CollisionRequest& request,
+                                         CollisionResult& result,
+                                         GJKSolver& solver) const {
+  details::checkContactCapacity(request, result);
+  HPP_FCL_PROFILE_SCOPE(result.profile);
   solver.set(request);
 
   std::size_t res;
   if (request.enable_timings) {
     Timer timer;
-    res = run(tf1, tf2, request, result);
+    res = run(tf1, tf2, request, result, &solver);
     result.timings = timer.elapsed();
   } else
-    res = run(tf1, tf2, request, result);
+    res = run(tf1, tf2, request, result, &solver);
 
   if (solver.gjk_initial_guess == GJKInitialGuess::CachedGuess ||
       solver.enable_cached_guess) {
@@ -200,5 +219,165 @@ std::size_t ComputeCollision::operator()(const Transform3f& tf1,
   return res;
 }
 
+std::size_t ComputeCollision::operator()(const Transform3f& tf1,
+                                         const Transform3f& tf2,
+                                         const CollisionRequest& request,
+                                         CollisionResult& result,
+                                         PairCache& cache) const {
+  GJKSolver solver;
+  return operator()(tf1, tf2, request, result, cache, solver);
+}
+
+std::size_t ComputeCollision::operator()(const Transform3f& tf1,
+                                         const Transform3f& tf2,
+                                         const CollisionRequest& request,
+                                         CollisionResult& result,
+                                         PairCache& cache,
+                                         GJKSolver& solver) const {
+  const Transform3f relative_pose(tf1.inverseTimes(tf2));
+  if (cache.valid &&
+      request.security_margin != -std::numeric_limits<FCL_REAL>::infinity()) {
+    // Lower bound of the distance to collision, after the motion since the
+    // last query.
+    const FCL_REAL distToCollision =
+        cache.distance_lower_bound - cache.motionBound(o1, o2, relative_pose) -
+        request.security_margin;
+    if (distToCollision > request.collision_distance_threshold) {
+      details::checkContactCapacity(request, result);
+      result.updateDistanceLowerBound(distToCollision);
+      result.cached_gjk_guess = cache.separating_axis;
+      result.cached_support_func_guess = cache.support_func_guess;
+      ++cache.num_skipped_queries;
+      return result.numContacts();
+    }
+  }
+
+  // The cache needs a tight lower bound of the distance to skip the next
+  // queries, which the overlap test of GJK does not provide.
+  CollisionRequest cached_request(request);
+  cached_request.enable_distance_lower_bound = true;
+  if (cache.valid ||
+      request.gjk_initial_guess == GJKInitialGuess::DefaultGuess) {
+    cached_request.gjk_initial_guess = GJKInitialGuess::CachedGuess;
+    cached_request.cached_gjk_guess = cache.separating_axis;
+    cached_request.cached_support_func_guess = cache.support_func_guess;
+  }
+  std::size_t res = operator()(tf1, tf2, cached_request, result, solver);
+
+  cache.valid = true;
+  cache.relative_pose = relative_pose;
+  if (cached_request.gjk_initial_guess == GJKInitialGuess::CachedGuess) {
+    cache.separating_axis = result.cached_gjk_guess;
+    cache.support_func_guess = result.cached_support_func_guess;
+  }
+  if (!result.isCollision() &&
+      result.distance_lower_bound < (std::numeric_limits<FCL_REAL>::max)())
+    cache.distance_lower_bound =
+        result.distance_lower_bound + request.security_margin;
+  else
+    cache.distance_lower_bound = -std::numeric_limits<FCL_REAL>::infinity();
+  return res;
+}
+
+std::size_t ComputeCollision::operator()(const Transform3f* tf1,
+                                         const Transform3f* tf2, std::size_t n,
+                                         const CollisionRequest& request,
+                                         CollisionResult* results,
+                                         int num_threads) const {
+  if (request.num_max_contacts == 0)
+    HPP_FCL_THROW_PRETTY("Invalid number of max contacts (current value is 0).",
+                         std::invalid_argument);
+#ifdef _OPENMP
+  if (num_threads <= 0) num_threads = omp_get_max_threads();
+#else
+  HPP_FCL_UNUSED_VARIABLE(num_threads);
+#endif
+
+  std::size_t num_collisions = 0;
+  const long size = (long)n;
+  // The exceptions cannot leave the parallel region: the first one is
+  // rethrown after it.
+  std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(num_threads) if (num_threads > 1) \
+    reduction(+ : num_collisions)
+#endif
+  {
+    // Each thread processes a contiguous chunk of the batch, so that the
+    // guess of a query can be used to warm start the next one.
+    GJKSolver thread_solver;
+    CollisionRequest thread_request(request);
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (long k = 0; k < size; ++k) {
+      const std::size_t i = (std::size_t)k;
+      CollisionResult& result = results[i];
+      try {
+        result.clear();
+        operator()(tf1[i], tf2[i], thread_request, result, thread_solver);
+        num_collisions += result.isCollision() ? 1 : 0;
+        thread_request.updateGuess(result);
+      } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        if (!error) error = std::current_exception();
+      }
+    }
+  }
+  if (error) std::rethrow_exception(error);
+  return num_collisions;
+}
+
+std::size_t collide(const CollisionGeometry* o1, const Transform3f* tf1,
+                    const CollisionGeometry* o2, const Transform3f* tf2,
+                    std::size_t n, const CollisionRequest& request,
+                    CollisionResult* results, int num_threads) {
+  ComputeCollision calc_collision(o1, o2);
+  return calc_collision(tf1, tf2, n, request, results, num_threads);
+}
+
+namespace details {
+template <typename BV>
+std::size_t selfCollide(const BVHModelBase* model, const Transform3f& tf,
+                        const CollisionRequest& request,
+                        CollisionResult& result) {
+  MeshSelfCollisionTraversalNode<BV> node(request);
+  initialize(node, static_cast<const BVHModel<BV>&>(*model), tf, result);
+  FCL_REAL sqrDistLowerBound;
+  selfCollisionRecurse(&node, 0, sqrDistLowerBound);
+  return result.numContacts();
+}
+}  // namespace details
+
+std::size_t selfCollide(const BVHModelBase* model, const Transform3f& tf,
+                        const CollisionRequest& request,
+                        CollisionResult& result) {
+  if (request.isSatisfied(result)) return result.numContacts();
+
+  switch (model->getNodeType()) {
+    case BV_AABB:
+      return details::selfCollide<AABB>(model, tf, request, result);
+    case BV_OBB:
+      return details::selfCollide<OBB>(model, tf, request, result);
+    case BV_RSS:
+      return details::selfCollide<RSS>(model, tf, request, result);
+    case BV_kIOS:
+      return details::selfCollide<kIOS>(model, tf, request, result);
+    case BV_OBBRSS:
+      return details::selfCollide<OBBRSS>(model, tf, request, result);
+    case BV_KDOP16:
+      return details::selfCollide<KDOP<16> >(model, tf, request, result);
+    case BV_KDOP18:
+      return details::selfCollide<KDOP<18> >(model, tf, request, result);
+    case BV_KDOP24:
+      return details::selfCollide<KDOP<24> >(model, tf, request, result);
+    default:
+      HPP_FCL_THROW_PRETTY("Unsupported bounding volume type.",
+                           std::invalid_argument);
+  }
+}
+
 }  // namespace fcl
 }  // namespace hpp
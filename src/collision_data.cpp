@@ -48,6 +48,79 @@ bool DistanceRequest::isSatisfied(const DistanceResult& result) const {
   return (result.min_distance <= 0);
 }
 
+void DistanceResult::computeGradients(const Transform3f& tf1,
+                                      const Transform3f& tf2) {
+  const Vec3f& p1 = nearest_points[0];
+  const Vec3f& p2 = nearest_points[1];
+  // Unit direction from object 1 to object 2, along which the distance
+  // grows. The nearest points are swapped in penetration.
+  // The points only give it when they are as far apart as the distance: the
+  // witness points of intersecting triangles, for instance, are not.
+  Vec3f n(p2 - p1);
+  const FCL_REAL norm = n.norm();
+  const FCL_REAL scale = (std::max)(FCL_REAL(1), p1.cwiseAbs().maxCoeff());
+  if (norm > Eigen::NumTraits<FCL_REAL>::dummy_precision() * scale &&
+      std::abs(norm - std::abs(min_distance)) <= 1e-6 * scale) {
+    n /= (min_distance < 0) ? -norm : norm;
+  } else {
+    n = normal;
+    // The normal of the narrow phases which do not compute it is undefined.
+    if (!n.allFinite() || std::abs(n.squaredNorm() - 1) > 1e-3) {
+      gradients[0] = gradients[1] =
+          Vec6f::Constant(std::numeric_limits<FCL_REAL>::quiet_NaN());
+      return;
+    }
+  }
+
+  // Moving the witness point p of an object at tf by the twist (v, w) in the
+  // frame of the object moves it by R (v + w x R^T (p - t)).
+  const Matrix3f& R1 = tf1.getRotation();
+  const Matrix3f& R2 = tf2.getRotation();
+  gradients[0].head<3>().noalias() = -R1.transpose() * n;
+  gradients[0].tail<3>().noalias() =
+      -R1.transpose() * (p1 - tf1.getTranslation()).cross(n);
+  gradients[1].head<3>().noalias() = R2.transpose() * n;
+  gradients[1].tail<3>().noalias() =
+      R2.transpose() * (p2 - tf2.getTranslation()).cross(n);
+}
+
+FCL_REAL PairCache::motionBound(const CollisionGeometry* o1,
+                                const CollisionGeometry* o2,
+                                const Transform3f& new_relative_pose) const {
+  const Matrix3f& R_old = relative_pose.getRotation();
+  const Vec3f& T_old = relative_pose.getTranslation();
+  const Matrix3f& R_new = new_relative_pose.getRotation();
+  const Vec3f& T_new = new_relative_pose.getTranslation();
+
+  const Matrix3f dR(R_new - R_old);
+  // The Frobenius norm is an upper bound of the spectral norm.
+  const FCL_REAL dR_norm = dR.norm();
+  const FCL_REAL inf = std::numeric_limits<FCL_REAL>::infinity();
+
+  FCL_REAL bound = inf;
+  // Motion of the points of o2 in the frame of o1.
+  if (o2->aabb_radius >= 0 && o2->aabb_radius < inf) {
+    const Vec3f dc(dR * o2->aabb_center + T_new - T_old);
+    bound = dc.norm() + dR_norm * o2->aabb_radius;
+  }
+  // Motion of the points of o1 in the frame of o2.
+  if (o1->aabb_radius >= 0 && o1->aabb_radius < inf) {
+    const Vec3f dc(dR.transpose() * o1->aabb_center +
+                   R_old.transpose() * T_old - R_new.transpose() * T_new);
+    bound = (std::min)(bound, dc.norm() + dR_norm * o1->aabb_radius);
+  }
+  return bound;
+}
+
+#ifdef HPP_FCL_ENABLE_PROFILING
+namespace details {
+QueryProfile*& currentQueryProfile() {
+  static thread_local QueryProfile* profile = NULL;
+  return profile;
+}
+}  // namespace details
+#endif
+
 }  // namespace fcl
 
 }  // namespace hpp
@@ -35,7 +35,7 @@
 
 /** \author Jia Pan */
 
-#include <../src/collision_node.h>
+#include <hpp/fcl/internal/collision_node.h>
 #include <hpp/fcl/internal/traversal_recurse.h>
 
 namespace hpp {
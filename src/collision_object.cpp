@@ -42,6 +42,14 @@ namespace fcl {
 bool CollisionGeometry::isUncertain() const {
   return !isOccupied() && !isFree();
 }
+
+void computeAABBs(const std::vector<CollisionObject*>& objects) {
+  const long size = (long)objects.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (size > 1024)
+#endif
+  for (long i = 0; i < size; ++i) objects[(size_t)i]->computeAABB();
+}
 }  // namespace fcl
 
 }  // namespace hpp
@@ -0,0 +1,416 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <hpp/fcl/compound.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <hpp/fcl/collision_func_matrix.h>
+#include <hpp/fcl/distance_func_matrix.h>
+#include <hpp/fcl/collision_utility.h>
+
+namespace hpp {
+namespace fcl {
+
+CollisionFunctionMatrix& getCollisionFunctionLookTable();
+DistanceFunctionMatrix& getDistanceFunctionLookTable();
+
+namespace {
+
+/// AABB, in the frame of the parent, of an AABB in a frame placed at tf.
+AABB transformAABB(const AABB& aabb, const Transform3f& tf) {
+  const Vec3f center(tf.transform(aabb.center()));
+  const Vec3f delta(tf.getRotation().cwiseAbs() *
+                    ((aabb.max_ - aabb.min_) / 2));
+  return AABB(center - delta, center + delta);
+}
+
+/// AABB of \p geometry expressed in the frame of the compound. Geometries
+/// whose local AABB has not been computed are bounded by the whole space so
+/// that no child is culled.
+AABB otherAABB(const CollisionGeometry* geometry, const Transform3f& tf) {
+  if (geometry->aabb_radius < 0) {
+    const FCL_REAL inf = (std::numeric_limits<FCL_REAL>::max)();
+    return AABB(Vec3f::Constant(-inf), Vec3f::Constant(inf));
+  }
+  return transformAABB(geometry->aabb_local, tf);
+}
+
+/// Order of the children along an axis of the compound frame.
+struct CenterLess {
+  const std::vector<AABB>& aabbs;
+  Eigen::DenseIndex axis;
+
+  CenterLess(const std::vector<AABB>& aabbs, Eigen::DenseIndex axis)
+      : aabbs(aabbs), axis(axis) {}
+
+  bool operator()(unsigned int a, unsigned int b) const {
+    return aabbs[a].center()[axis] < aabbs[b].center()[axis];
+  }
+};
+
+/// Whether no child whose AABB is at distance bound of the other object can
+/// improve min_distance, up to the tolerances of the request.
+bool canStop(const DistanceRequest& request, FCL_REAL bound,
+             FCL_REAL min_distance) {
+  return bound >= min_distance - request.abs_err &&
+         bound * (1 + request.rel_err) >= min_distance;
+}
+
+/// Collision between o1 and o2 which appends the contacts to result in this
+/// order, with the same dispatch as collide.
+void collideGeometries(const CollisionGeometry* o1, const Transform3f& tf1,
+                       const CollisionGeometry* o2, const Transform3f& tf2,
+                       const GJKSolver* nsolver,
+                       const CollisionRequest& request,
+                       CollisionResult& result) {
+  const CollisionFunctionMatrix& looktable = getCollisionFunctionLookTable();
+  OBJECT_TYPE object_type1 = o1->getObjectType();
+  OBJECT_TYPE object_type2 = o2->getObjectType();
+  NODE_TYPE node_type1 = o1->getNodeType();
+  NODE_TYPE node_type2 = o2->getNodeType();
+
+  const bool swap_geoms =
+      object_type1 == OT_GEOM &&
+      (object_type2 == OT_BVH || object_type2 == OT_HFIELD);
+  CollisionFunctionMatrix::CollisionFunc func =
+      swap_geoms ? looktable.collision_matrix[node_type2][node_type1]
+                 : looktable.collision_matrix[node_type1][node_type2];
+  if (!func)
+    HPP_FCL_THROW_PRETTY("Collision function between node type "
+                             << std::string(get_node_type_name(node_type1))
+                             << " and node type "
+                             << std::string(get_node_type_name(node_type2))
+                             << " is not yet supported.",
+                         std::invalid_argument);
+
+  if (!swap_geoms) {
+    func(o1, tf1, o2, tf2, nsolver, request, result);
+    return;
+  }
+  // Only the new contacts are reordered.
+  const std::size_t n = result.numContacts();
+  func(o2, tf2, o1, tf1, nsolver, request, result);
+  for (std::size_t i = n; i < result.numContacts(); ++i) {
+    Contact contact(result.getContact(i));
+    std::swap(contact.o1, contact.o2);
+    std::swap(contact.b1, contact.b2);
+    contact.normal *= -1;
+    result.setContact(i, contact);
+  }
+}
+
+/// Distance between o1 and o2 with the same dispatch as distance. result is
+/// updated in this order.
+void distanceGeometries(const CollisionGeometry* o1, const Transform3f& tf1,
+                        const CollisionGeometry* o2, const Transform3f& tf2,
+                        const GJKSolver* nsolver,
+                        const DistanceRequest& request,
+                        DistanceResult& result) {
+  const DistanceFunctionMatrix& looktable = getDistanceFunctionLookTable();
+  OBJECT_TYPE object_type1 = o1->getObjectType();
+  OBJECT_TYPE object_type2 = o2->getObjectType();
+  NODE_TYPE node_type1 = o1->getNodeType();
+  NODE_TYPE node_type2 = o2->getNodeType();
+
+  const bool swap_geoms =
+      object_type1 == OT_GEOM &&
+      (object_type2 == OT_BVH || object_type2 == OT_HFIELD);
+  DistanceFunctionMatrix::DistanceFunc func =
+      swap_geoms ? looktable.distance_matrix[node_type2][node_type1]
+                 : looktable.distance_matrix[node_type1][node_type2];
+  if (!func)
+    HPP_FCL_THROW_PRETTY("Distance function between node type "
+                             << std::string(get_node_type_name(node_type1))
+                             << " and node type "
+                             << std::string(get_node_type_name(node_type2))
+                             << " is not yet supported.",
+                         std::invalid_argument);
+
+  if (!swap_geoms) {
+    func(o1, tf1, o2, tf2, nsolver, request, result);
+    return;
+  }
+  const FCL_REAL min_distance = result.min_distance;
+  func(o2, tf2, o1, tf1, nsolver, request, result);
+  if (result.min_distance < min_distance) {
+    std::swap(result.o1, result.o2);
+    std::swap(result.b1, result.b2);
+    std::swap(result.nearest_points[0], result.nearest_points[1]);
+    result.normal = -result.normal;
+  }
+}
+
+/// Collision between the children of the sub-hierarchy rooted at node and
+/// the other object, whose AABB in the frame of the compound is bv.
+void collideNode(const Compound& compound, unsigned int node,
+                 const Transform3f& tf_compound, const CollisionGeometry* other,
+                 const Transform3f& tf_other, const AABB& bv,
+                 bool compound_first, const GJKSolver* nsolver,
+                 const CollisionRequest& request, CollisionResult& result) {
+  const Compound::Node& n = compound.getNodes()[node];
+  FCL_REAL sqrDistLowerBound;
+  if (!n.aabb.overlap(bv, request, sqrDistLowerBound)) {
+    internal::updateDistanceLowerBoundFromBV(request, result,
+                                             sqrDistLowerBound);
+    return;
+  }
+
+  if (!n.isLeaf()) {
+    collideNode(compound, n.left, tf_compound, other, tf_other, bv,
+                compound_first, nsolver, request, result);
+    if (request.isSatisfied(result)) return;
+    collideNode(compound, n.right, tf_compound, other, tf_other, bv,
+                compound_first, nsolver, request, result);
+    return;
+  }
+
+  const std::size_t i = (std::size_t)n.child;
+  const CollisionGeometry* child = compound.getChild(i).get();
+  const Transform3f tf_child(tf_compound * compound.getChildPlacement(i));
+  const std::size_t num_contacts = result.numContacts();
+  // The traversals of the child check the lower bound they produce against
+  // the result, so each child query starts from an unset lower bound.
+  const FCL_REAL distance_lower_bound = result.distance_lower_bound;
+  result.distance_lower_bound = (std::numeric_limits<FCL_REAL>::max)();
+  if (compound_first)
+    collideGeometries(child, tf_child, other, tf_other, nsolver, request,
+                      result);
+  else
+    collideGeometries(other, tf_other, child, tf_child, nsolver, request,
+                      result);
+  result.distance_lower_bound =
+      (std::min)(result.distance_lower_bound, distance_lower_bound);
+
+  // The contacts refer to the compound and the index of the child.
+  for (std::size_t k = num_contacts; k < result.numContacts(); ++k) {
+    Contact contact(result.getContact(k));
+    if (compound_first) {
+      contact.o1 = &compound;
+      contact.b1 = n.child;
+    } else {
+      contact.o2 = &compound;
+      contact.b2 = n.child;
+    }
+    result.setContact(k, contact);
+  }
+}
+
+/// Distance between the children of the sub-hierarchy rooted at node and the
+/// other object, whose AABB in the frame of the compound is bv. The nearest
+/// sub-node is visited first.
+void distanceNode(const Compound& compound, unsigned int node,
+                  const Transform3f& tf_compound,
+                  const CollisionGeometry* other, const Transform3f& tf_other,
+                  const AABB& bv, bool compound_first,
+                  const GJKSolver* nsolver, const DistanceRequest& request,
+                  DistanceResult& result) {
+  const Compound::Node& n = compound.getNodes()[node];
+  if (!n.isLeaf()) {
+    unsigned int first = n.left, second = n.right;
+    FCL_REAL d1 = compound.getNodes()[first].aabb.distance(bv);
+    FCL_REAL d2 = compound.getNodes()[second].aabb.distance(bv);
+    if (d2 < d1) {
+      std::swap(first, second);
+      std::swap(d1, d2);
+    }
+    if (canStop(request, d1, result.min_distance)) return;
+    distanceNode(compound, first, tf_compound, other, tf_other, bv,
+                 compound_first, nsolver, request, result);
+    if (canStop(request, d2, result.min_distance)) return;
+    distanceNode(compound, second, tf_compound, other, tf_other, bv,
+                 compound_first, nsolver, request, result);
+    return;
+  }
+
+  const std::size_t i = (std::size_t)n.child;
+  const CollisionGeometry* child = compound.getChild(i).get();
+  const Transform3f tf_child(tf_compound * compound.getChildPlacement(i));
+  // The children queries may stop as soon as they cannot improve result.
+  DistanceResult child_result(result.min_distance);
+  if (compound_first)
+    distanceGeometries(child, tf_child, other, tf_other, nsolver, request,
+                       child_result);
+  else
+    distanceGeometries(other, tf_other, child, tf_child, nsolver, request,
+                       child_result);
+  if (child_result.min_distance >= result.min_distance) return;
+
+  if (compound_first)
+    result.update(child_result.min_distance, &compound, child_result.o2,
+                  n.child, child_result.b2, child_result.nearest_points[0],
+                  child_result.nearest_points[1], child_result.normal);
+  else
+    result.update(child_result.min_distance, child_result.o1, &compound,
+                  child_result.b1, n.child, child_result.nearest_points[0],
+                  child_result.nearest_points[1], child_result.normal);
+}
+
+}  // namespace
+
+Compound::Compound() : CollisionGeometry() {}
+
+std::size_t Compound::addChild(const shared_ptr<CollisionGeometry>& geometry,
+                               const Transform3f& placement) {
+  if (!geometry)
+    HPP_FCL_THROW_PRETTY("The child geometry is NULL.", std::invalid_argument);
+  if (geometry.get() == this)
+    HPP_FCL_THROW_PRETTY("A compound cannot be its own child.",
+                         std::invalid_argument);
+
+  if (geometry->aabb_radius < 0) geometry->computeLocalAABB();
+  children.push_back(geometry);
+  placements.push_back(placement);
+  computeLocalAABB();
+  return children.size() - 1;
+}
+
+void Compound::setChildPlacement(std::size_t i, const Transform3f& placement) {
+  if (i >= children.size())
+    HPP_FCL_THROW_PRETTY("Child index " << i << " is out of range (the "
+                                        << "compound has " << children.size()
+                                        << " children).",
+                         std::invalid_argument);
+  placements[i] = placement;
+  computeLocalAABB();
+}
+
+void Compound::computeLocalAABB() {
+  child_aabbs.resize(children.size());
+  nodes.clear();
+  aabb_local = AABB();
+  for (std::size_t i = 0; i < children.size(); ++i) {
+    child_aabbs[i] = transformAABB(children[i]->aabb_local, placements[i]);
+    aabb_local += child_aabbs[i];
+  }
+
+  if (children.empty()) {
+    aabb_local = AABB(Vec3f::Zero());
+  } else {
+    std::vector<unsigned int> order(children.size());
+    for (std::size_t i = 0; i < order.size(); ++i) order[i] = (unsigned int)i;
+    nodes.reserve(2 * children.size() - 1);
+    buildHierarchy(order, 0, order.size());
+  }
+  aabb_center = aabb_local.center();
+  aabb_radius = (aabb_local.min_ - aabb_center).norm();
+}
+
+unsigned int Compound::buildHierarchy(std::vector<unsigned int>& order,
+                                      std::size_t begin, std::size_t end) {
+  const unsigned int index = (unsigned int)nodes.size();
+  nodes.push_back(Node());
+  AABB aabb(child_aabbs[order[begin]]);
+  for (std::size_t i = begin + 1; i < end; ++i) aabb += child_aabbs[order[i]];
+  nodes[index].aabb = aabb;
+
+  if (end - begin == 1) {
+    nodes[index].child = (int)order[begin];
+    nodes[index].left = nodes[index].right = 0;
+    return index;
+  }
+
+  // Split at the median of the AABB centers along the longest axis of the
+  // AABB of the centers.
+  AABB centers(child_aabbs[order[begin]].center());
+  for (std::size_t i = begin + 1; i < end; ++i)
+    centers += child_aabbs[order[i]].center();
+  Eigen::DenseIndex axis;
+  (centers.max_ - centers.min_).maxCoeff(&axis);
+  const std::size_t middle = begin + (end - begin) / 2;
+  std::nth_element(order.begin() + (std::ptrdiff_t)begin,
+                   order.begin() + (std::ptrdiff_t)middle,
+                   order.begin() + (std::ptrdiff_t)end,
+                   CenterLess(child_aabbs, axis));
+
+  nodes[index].child = -1;
+  const unsigned int left = buildHierarchy(order, begin, middle);
+  const unsigned int right = buildHierarchy(order, middle, end);
+  nodes[index].left = left;
+  nodes[index].right = right;
+  return index;
+}
+
+bool Compound::isEqual(const CollisionGeometry& _other) const {
+  const Compound* other_ptr = dynamic_cast<const Compound*>(&_other);
+  if (other_ptr == nullptr) return false;
+  const Compound& other = *other_ptr;
+
+  if (children.size() != other.children.size()) return false;
+  for (std::size_t i = 0; i < children.size(); ++i) {
+    if (*children[i] != *other.children[i]) return false;
+    if (placements[i] != other.placements[i]) return false;
+  }
+  return nodes == other.nodes;
+}
+
+namespace details {
+
+std::size_t compoundCollide(const Compound& compound,
+                            const Transform3f& tf_compound,
+                            const CollisionGeometry* other,
+                            const Transform3f& tf_other, bool compound_first,
+                            const GJKSolver* nsolver,
+                            const CollisionRequest& request,
+                            CollisionResult& result) {
+  if (request.isSatisfied(result) || compound.getNodes().empty())
+    return result.numContacts();
+
+  const AABB bv(otherAABB(other, tf_compound.inverseTimes(tf_other)));
+  collideNode(compound, 0, tf_compound, other, tf_other, bv, compound_first,
+              nsolver, request, result);
+  return result.numContacts();
+}
+
+FCL_REAL compoundDistance(const Compound& compound,
+                          const Transform3f& tf_compound,
+                          const CollisionGeometry* other,
+                          const Transform3f& tf_other, bool compound_first,
+                          const GJKSolver* nsolver,
+                          const DistanceRequest& request,
+                          DistanceResult& result) {
+  if (compound.getNodes().empty()) return result.min_distance;
+
+  const AABB bv(otherAABB(other, tf_compound.inverseTimes(tf_other)));
+  distanceNode(compound, 0, tf_compound, other, tf_other, bv, compound_first,
+               nsolver, request, result);
+  return result.min_distance;
+}
+
+}  // namespace details
+
+}  // namespace fcl
+}  // namespace hpp
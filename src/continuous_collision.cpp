@@ -0,0 +1,267 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <hpp/fcl/continuous_collision.h>
+
+#include <cmath>
+#include <limits>
+
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/internal/tools.h>
+#include <hpp/fcl/narrowphase/continuous_collision_object.h>
+
+namespace hpp {
+namespace fcl {
+
+namespace details {
+
+namespace {
+
+/// Smallest time step taken with the distance lower bound of collision
+/// queries, below which the distance is computed.
+const FCL_REAL min_lower_bound_step = 0.005;
+
+/// Left Jacobian of SO(3) at the rotation of vector axis * angle, which maps
+/// the linear part of a twist to the translation of its exponential.
+Matrix3f leftJacobian(const Vec3f& axis, FCL_REAL angle) {
+  const Matrix3f W((Matrix3f() << 0, -axis[2], axis[1], axis[2], 0, -axis[0],
+                    -axis[1], axis[0], 0)
+                       .finished());
+  if (angle < 1e-6) return Matrix3f::Identity() + (angle / 2) * W;
+  return Matrix3f::Identity() + ((1 - std::cos(angle)) / angle) * W +
+         ((angle - std::sin(angle)) / angle) * W * W;
+}
+
+/// Throw if the bounding sphere of a geometry is unknown.
+void checkBoundingSphere(const CollisionGeometry* geom) {
+  if (geom->aabb_radius < 0)
+    HPP_FCL_THROW_PRETTY(
+        "the local AABB of the geometry is unknown: call computeLocalAABB.",
+        std::invalid_argument);
+}
+
+/// World AABB of a geometry at a placement, see
+/// CollisionObject::computeAABB.
+AABB worldAABB(const CollisionGeometry& geom, const Transform3f& tf) {
+  const Matrix3f& R = tf.getRotation();
+  if (R.isIdentity()) return translate(geom.aabb_local, tf.getTranslation());
+  const AABB& aabb_local = geom.aabb_local;
+  const Vec3f center(tf.transform(aabb_local.center()));
+  const Vec3f delta(R.cwiseAbs() * ((aabb_local.max_ - aabb_local.min_) / 2));
+  const Vec3f sphere_center(tf.transform(geom.aabb_center));
+  const Vec3f radius(Vec3f::Constant(geom.aabb_radius));
+  return AABB((center - delta).cwiseMax(sphere_center - radius),
+              (center + delta).cwiseMin(sphere_center + radius));
+}
+
+}  // namespace
+
+}  // namespace details
+
+Motion::Motion(const Transform3f& tf_beg, const Transform3f& tf_end,
+               CCDMotionType type)
+    : tf_beg(tf_beg), tf_end(tf_end), type(type) {
+  const Matrix3f& R0 = tf_beg.getRotation();
+  const Eigen::AngleAxis<FCL_REAL> rotation(R0.transpose() *
+                                            tf_end.getRotation());
+  angle = rotation.angle();
+  axis = (angle > 0) ? Vec3f(rotation.axis()) : Vec3f(Vec3f::UnitX());
+
+  const Vec3f translation(tf_end.getTranslation() - tf_beg.getTranslation());
+  switch (type) {
+    case CCDM_LINEAR:
+      linear_velocity = translation;
+      break;
+    case CCDM_SCREW:
+      linear_velocity = details::leftJacobian(axis, angle)
+                            .inverse() * (R0.transpose() * translation);
+      break;
+    default:
+      HPP_FCL_THROW_PRETTY("unknown motion type " << type << ".",
+                           std::invalid_argument);
+  }
+}
+
+Transform3f Motion::getTransform(FCL_REAL t) const {
+  const Matrix3f& R0 = tf_beg.getRotation();
+  const Matrix3f R(
+      R0 * Eigen::AngleAxis<FCL_REAL>(t * angle, axis).toRotationMatrix());
+  if (type == CCDM_LINEAR)
+    return Transform3f(R, tf_beg.getTranslation() + t * linear_velocity);
+  return Transform3f(R, tf_beg.getTranslation() +
+                            R0 * (details::leftJacobian(axis, t * angle) *
+                                  (t * linear_velocity)));
+}
+
+FCL_REAL Motion::speedBound(const CollisionGeometry& geom) const {
+  details::checkBoundingSphere(&geom);
+  // Without rotation, all the points move at the same speed, even those of
+  // unbounded geometries.
+  if (angle == 0) return linear_velocity.norm();
+  const Vec3f angular_velocity(angle * axis);
+  if (type == CCDM_LINEAR) {
+    // The velocity of a point x of the geometry is
+    // linear_velocity + R0 R(t) (angular_velocity x x).
+    return linear_velocity.norm() +
+           angular_velocity.cross(geom.aabb_center).norm() +
+           angle * geom.aabb_radius;
+  }
+  // With a constant twist, the velocity of a point x of the geometry is
+  // R(t) (angular_velocity x x + linear_velocity).
+  return (angular_velocity.cross(geom.aabb_center) + linear_velocity).norm() +
+         angle * geom.aabb_radius;
+}
+
+FCL_REAL Motion::deviationBound(const CollisionGeometry& geom) const {
+  if (angle == 0) return 0;
+  // The deviation vanishes at both ends of the motion, hence it is bounded by
+  // the largest acceleration of the points of the geometry divided by 8.
+  if (type == CCDM_LINEAR) {
+    // The acceleration of a point x is angle^2 times its distance to the
+    // rotation axis.
+    details::checkBoundingSphere(&geom);
+    return angle * angle *
+           (axis.cross(geom.aabb_center).norm() + geom.aabb_radius) / 8;
+  }
+  // With a constant twist, the acceleration of a point x is
+  // R(t) (angular_velocity x (angular_velocity x x + linear_velocity)).
+  return angle * speedBound(geom) / 8;
+}
+
+FCL_REAL continuousCollide(const CollisionGeometry* o1,
+                           const Transform3f& tf1_beg,
+                           const Transform3f& tf1_end,
+                           const CollisionGeometry* o2,
+                           const Transform3f& tf2_beg,
+                           const Transform3f& tf2_end,
+                           const ContinuousCollisionRequest& request,
+                           ContinuousCollisionResult& result) {
+  return continuousCollide(o1, Motion(tf1_beg, tf1_end, request.motion_type),
+                           o2, Motion(tf2_beg, tf2_end, request.motion_type),
+                           request, result);
+}
+
+FCL_REAL continuousCollide(const CollisionGeometry* o1, const Motion& motion1,
+                           const CollisionGeometry* o2, const Motion& motion2,
+                           const ContinuousCollisionRequest& request,
+                           ContinuousCollisionResult& result) {
+  details::checkBoundingSphere(o1);
+  details::checkBoundingSphere(o2);
+  result.clear();
+
+  // Upper bound of the speed at which the distance between the objects
+  // decreases.
+  const FCL_REAL speed = motion1.speedBound(*o1) + motion2.speedBound(*o2);
+
+  // On bounding volume hierarchies, the distance lower bound given by a
+  // collision query is much cheaper than the distance and suffices to
+  // advance far from contact.
+  const bool use_lower_bound =
+      o1->getObjectType() != OT_GEOM || o2->getObjectType() != OT_GEOM;
+  const ComputeCollision compute_collision(o1, o2);
+  CollisionRequest collision_request(DISTANCE_LOWER_BOUND, 1);
+  collision_request.security_margin = request.distance_tolerance;
+  CollisionResult collision_result;
+  const ComputeDistance compute_distance(o1, o2);
+  DistanceRequest distance_request(false);
+  DistanceResult distance_result;
+
+  FCL_REAL t = 0;
+  while (t <= 1) {
+    const Transform3f tf1(motion1.getTransform(t)),
+        tf2(motion2.getTransform(t));
+    ++result.num_iterations;
+    bool in_contact = result.num_iterations >= request.num_max_iterations;
+    FCL_REAL distance = 0;
+    if (!in_contact && use_lower_bound) {
+      collision_result.clear();
+      in_contact = compute_collision(tf1, tf2, collision_request,
+                                     collision_result) > 0;
+      distance = collision_result.distance_lower_bound;
+    }
+    if (!in_contact &&
+        (!use_lower_bound ||
+         distance < details::min_lower_bound_step * speed)) {
+      distance_result.clear();
+      distance = compute_distance(tf1, tf2, distance_request, distance_result);
+      in_contact = distance <= request.distance_tolerance;
+    }
+    if (in_contact) {
+      result.is_collide = true;
+      result.time_of_contact = t;
+      result.contact_tf1 = tf1;
+      result.contact_tf2 = tf2;
+      return t;
+    }
+    // The objects cannot touch before the distance is covered at the
+    // largest relative speed.
+    if (speed == 0) break;
+    t += distance / speed;
+  }
+
+  result.contact_tf1 = motion1.getEndTransform();
+  result.contact_tf2 = motion2.getEndTransform();
+  return result.time_of_contact;
+}
+
+FCL_REAL continuousCollide(const CollisionObject* o1,
+                           const Transform3f& tf1_end,
+                           const CollisionObject* o2,
+                           const Transform3f& tf2_end,
+                           const ContinuousCollisionRequest& request,
+                           ContinuousCollisionResult& result) {
+  return continuousCollide(o1->collisionGeometry().get(), o1->getTransform(),
+                           tf1_end, o2->collisionGeometry().get(),
+                           o2->getTransform(), tf2_end, request, result);
+}
+
+void ContinuousCollisionObject::computeAABB() {
+  aabb = details::worldAABB(*cgeom, motion.getBeginTransform()) +
+         details::worldAABB(*cgeom, motion.getEndTransform());
+  aabb.expand(motion.deviationBound(*cgeom));
+}
+
+FCL_REAL continuousCollide(const ContinuousCollisionObject* o1,
+                           const ContinuousCollisionObject* o2,
+                           const ContinuousCollisionRequest& request,
+                           ContinuousCollisionResult& result) {
+  return continuousCollide(o1->collisionGeometry().get(), o1->getMotion(),
+                           o2->collisionGeometry().get(), o2->getMotion(),
+                           request, result);
+}
+
+}  // namespace fcl
+
+}  // namespace hpp
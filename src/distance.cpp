@@ -40,8 +40,13 @@
 #include <hpp/fcl/distance_func_matrix.h>
 #include <hpp/fcl/narrowphase/narrowphase.h>
 
+#include <exception>
 #include <iostream>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace hpp {
 namespace fcl {
 
@@ -60,6 +65,7 @@ FCL_REAL distance(const CollisionObject* o1, const CollisionObject* o2,
 FCL_REAL distance(const CollisionGeometry* o1, const Transform3f& tf1,
                   const CollisionGeometry* o2, const Transform3f& tf2,
                   const DistanceRequest& request, DistanceResult& result) {
+  HPP_FCL_PROFILE_SCOPE(result.profile);
   GJKSolver solver(request);
 
   const DistanceFunctionMatrix& looktable = getDistanceFunctionLookTable();
@@ -84,7 +90,7 @@ FCL_REAL distance(const CollisionGeometry* o1, const Transform3f& tf1,
       res = looktable.distance_matrix[node_type2][node_type1](
           o2, tf2, o1, tf1, &solver, request, result);
       // If closest points are requested, switch object 1 and 2
-      if (request.enable_nearest_points) {
+      if (request.enable_nearest_points || request.enable_gradients) {
         const CollisionGeometry* tmpo = result.o1;
         result.o1 = result.o2;
         result.o2 = tmpo;
@@ -92,6 +98,8 @@ FCL_REAL distance(const CollisionGeometry* o1, const Transform3f& tf1,
         result.nearest_points[0] = result.nearest_points[1];
         result.nearest_points[1] = tmpn;
       }
+      // The normal always points from object 1 to object 2.
+      result.normal = -result.normal;
     }
   } else {
     if (!looktable.distance_matrix[node_type1][node_type2]) {
@@ -111,6 +119,7 @@ FCL_REAL distance(const CollisionGeometry* o1, const Transform3f& tf1,
     result.cached_gjk_guess = solver.cached_guess;
     result.cached_support_func_guess = solver.support_func_cached_guess;
   }
+  if (request.enable_gradients) result.computeGradients(tf1, tf2);
 
   return res;
 }
@@ -145,17 +154,19 @@ ComputeDistance::ComputeDistance(const CollisionGeometry* o1,
 
 FCL_REAL ComputeDistance::run(const Transform3f& tf1, const Transform3f& tf2,
                               const DistanceRequest& request,
-                              DistanceResult& result) const {
+                              DistanceResult& result,
+                              const GJKSolver* solver) const {
   FCL_REAL res;
 
   if (swap_geoms) {
-    res = func(o2, tf2, o1, tf1, &solver, request, result);
-    if (request.enable_nearest_points) {
+    res = func(o2, tf2, o1, tf1, solver, request, result);
+    if (request.enable_nearest_points || request.enable_gradients) {
       std::swap(result.o1, result.o2);
       result.nearest_points[0].swap(result.nearest_points[1]);
     }
+    result.normal = -result.normal;
   } else {
-    res = func(o1, tf1, o2, tf2, &solver, request, result);
+    res = func(o1, tf1, o2, tf2, solver, request, result);
   }
 
   return res;
@@ -165,23 +176,191 @@ FCL_REAL ComputeDistance::operator()(const Transform3f& tf1,
                                      const Transform3f& tf2,
                                      const DistanceRequest& request,
                                      DistanceResult& result) const {
+  GJKSolver solver;
+  return operator()(tf1, tf2, request, result, solver);
+}
+
+FCL_REAL ComputeDistance::operator()(const Transform3f& tf1,
+                                     const Transform3f& tf2,
+                                     const DistanceRequest& request,
+                                     DistanceResult& result,
+                                     GJKSolver& solver) const {
+  HPP_FCL_PROFILE_SCOPE(result.profile);
   solver.set(request);
 
   FCL_REAL res;
   if (request.enable_timings) {
     Timer timer;
-    res = run(tf1, tf2, request, result);
+    res = run(tf1, tf2, request, result, &solver);
     result.timings = timer.elapsed();
   } else
-    res = run(tf1, tf2, request, result);
+    res = run(tf1, tf2, request, result, &solver);
 
   if (solver.gjk_initial_guess == GJKInitialGuess::CachedGuess ||
       solver.enable_cached_guess) {
     result.cached_gjk_guess = solver.cached_guess;
     result.cached_support_func_guess = solver.support_func_cached_guess;
   }
+  if (request.enable_gradients) result.computeGradients(tf1, tf2);
+  return res;
+}
+
+FCL_REAL ComputeDistance::operator()(const Transform3f& tf1,
+                                     const Transform3f& tf2,
+                                     const DistanceRequest& request,
+                                     DistanceResult& result,
+                                     PairCache& cache) const {
+  GJKSolver solver;
+  return operator()(tf1, tf2, request, result, cache, solver);
+}
+
+FCL_REAL ComputeDistance::operator()(const Transform3f& tf1,
+                                     const Transform3f& tf2,
+                                     const DistanceRequest& request,
+                                     DistanceResult& result, PairCache& cache,
+                                     GJKSolver& solver) const {
+  const Transform3f relative_pose(tf1.inverseTimes(tf2));
+  if (cache.valid) {
+    // Distance between the last witness points, moved along with the
+    // geometries. It is NaN when they are unknown.
+    const Vec3f& w1 = cache.witness_points[0];
+    const Vec3f& w2 = cache.witness_points[1];
+    const FCL_REAL witness_distance =
+        (relative_pose.transform(w2) - w1).norm();
+    if (witness_distance > 0) {
+      const Vec3f p1(tf1.transform(w1)), p2(tf2.transform(w2));
+      const Vec3f normal((p2 - p1) / witness_distance);
+      // The witness points give an upper bound of the distance, which lets
+      // the BVH traversals prune more nodes. The result is filled in the
+      // order of the narrow phase, like in run.
+      if (swap_geoms)
+        result.update(witness_distance, o2, o1, cache.b1, cache.b2, p2, p1,
+                      -normal);
+      else
+        result.update(witness_distance, o1, o2, cache.b1, cache.b2, p1, p2,
+                      normal);
+
+      const FCL_REAL lower_bound = cache.distance_lower_bound -
+                                   cache.motionBound(o1, o2, relative_pose);
+      if (witness_distance - lower_bound <=
+          (std::max)(request.abs_err, request.rel_err * lower_bound)) {
+        if (swap_geoms) {
+          if (request.enable_nearest_points || request.enable_gradients) {
+            std::swap(result.o1, result.o2);
+            result.nearest_points[0].swap(result.nearest_points[1]);
+          }
+          result.normal = -result.normal;
+        }
+        if (request.enable_gradients) result.computeGradients(tf1, tf2);
+        result.cached_gjk_guess = cache.separating_axis;
+        result.cached_support_func_guess = cache.support_func_guess;
+        ++cache.num_skipped_queries;
+        return result.min_distance;
+      }
+    }
+  }
+
+  DistanceRequest cached_request(request);
+  if (cache.valid ||
+      request.gjk_initial_guess == GJKInitialGuess::DefaultGuess) {
+    cached_request.gjk_initial_guess = GJKInitialGuess::CachedGuess;
+    cached_request.cached_gjk_guess = cache.separating_axis;
+    cached_request.cached_support_func_guess = cache.support_func_guess;
+  }
+  FCL_REAL res = operator()(tf1, tf2, cached_request, result, solver);
+
+  cache.valid = true;
+  cache.relative_pose = relative_pose;
+  if (cached_request.gjk_initial_guess == GJKInitialGuess::CachedGuess) {
+    cache.separating_axis = result.cached_gjk_guess;
+    cache.support_func_guess = result.cached_support_func_guess;
+  }
+  // run leaves the nearest points in the order of the narrow phase unless
+  // they, or the gradients, are requested.
+  const bool reversed = swap_geoms && !request.enable_nearest_points &&
+                        !request.enable_gradients;
+  const Vec3f& q1 = result.nearest_points[reversed ? 1 : 0];
+  const Vec3f& q2 = result.nearest_points[reversed ? 0 : 1];
+  if (result.min_distance > 0 && q1.allFinite() && q2.allFinite()) {
+    cache.witness_points[0].noalias() =
+        tf1.getRotation().transpose() * (q1 - tf1.getTranslation());
+    cache.witness_points[1].noalias() =
+        tf2.getRotation().transpose() * (q2 - tf2.getTranslation());
+    cache.b1 = result.b1;
+    cache.b2 = result.b2;
+    // The distance is measured between the witness points so that a query
+    // repeated at the same placement is answered from the cache. It is
+    // accurate up to the tolerance of the request.
+    const FCL_REAL d = (relative_pose.transform(cache.witness_points[1]) -
+                        cache.witness_points[0])
+                           .norm();
+    cache.distance_lower_bound =
+        (std::max)(d - request.abs_err, d / (1 + request.rel_err));
+  } else {
+    cache.witness_points[0] = cache.witness_points[1] =
+        Vec3f::Constant(std::numeric_limits<FCL_REAL>::quiet_NaN());
+    cache.b1 = cache.b2 = DistanceResult::NONE;
+    cache.distance_lower_bound = -std::numeric_limits<FCL_REAL>::infinity();
+  }
   return res;
 }
 
+FCL_REAL ComputeDistance::operator()(const Transform3f* tf1,
+                                     const Transform3f* tf2, std::size_t n,
+                                     const DistanceRequest& request,
+                                     DistanceResult* results,
+                                     int num_threads) const {
+#ifdef _OPENMP
+  if (num_threads <= 0) num_threads = omp_get_max_threads();
+#else
+  HPP_FCL_UNUSED_VARIABLE(num_threads);
+#endif
+
+  FCL_REAL min_distance = (std::numeric_limits<FCL_REAL>::max)();
+  const long size = (long)n;
+  // The exceptions cannot leave the parallel region: the first one is
+  // rethrown after it.
+  std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(num_threads) if (num_threads > 1) \
+    reduction(min : min_distance)
+#endif
+  {
+    // Each thread processes a contiguous chunk of the batch, so that the
+    // guess of a query can be used to warm start the next one.
+    GJKSolver thread_solver;
+    DistanceRequest thread_request(request);
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (long k = 0; k < size; ++k) {
+      const std::size_t i = (std::size_t)k;
+      DistanceResult& result = results[i];
+      try {
+        result.clear();
+        min_distance = (std::min)(
+            min_distance,
+            operator()(tf1[i], tf2[i], thread_request, result, thread_solver));
+        thread_request.updateGuess(result);
+      } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        if (!error) error = std::current_exception();
+      }
+    }
+  }
+  if (error) std::rethrow_exception(error);
+  return min_distance;
+}
+
+FCL_REAL distance(const CollisionGeometry* o1, const Transform3f* tf1,
+                  const CollisionGeometry* o2, const Transform3f* tf2,
+                  std::size_t n, const DistanceRequest& request,
+                  DistanceResult* results, int num_threads) {
+  ComputeDistance calc_distance(o1, o2);
+  return calc_distance(tf1, tf2, n, request, results, num_threads);
+}
+
 }  // namespace fcl
 }  // namespace hpp
@@ -161,7 +161,7 @@ FCL_REAL ShapeShapeDistance<Capsule, Capsule>(
   result.min_distance = distance;
 
   // witness points for the capsules
-  if (request.enable_nearest_points) {
+  if (request.enable_nearest_points || request.enable_gradients) {
     result.nearest_points[0] = w1 - radius1 * normal;
     result.nearest_points[1] = w2 + radius2 * normal;
   }
@@ -78,6 +78,7 @@ FCL_REAL ShapeShapeDistance<Sphere, Sphere>(
   penetrationDepth = r1 + r2 - dist;
   bool collision = (penetrationDepth >= 0);
   result.min_distance = -penetrationDepth;
+  result.normal = unit;
   if (collision) {
     // Take contact point at the middle of intersection between each sphere
     // and segment [c1 c2].
@@ -37,9 +37,9 @@
 
 #include <hpp/fcl/distance_func_matrix.h>
 
-#include <../src/collision_node.h>
-#include <hpp/fcl/internal/shape_shape_func.h>
-#include <hpp/fcl/internal/traversal_node_setup.h>
+#include <hpp/fcl/typed_query.h>
+#include <hpp/fcl/sdf.h>
+#include <hpp/fcl/compound.h>
 #include <../src/traits_traversal.h>
 
 namespace hpp {
@@ -66,215 +66,49 @@ FCL_REAL Distance(const CollisionGeometry* o1, const Transform3f& tf1,
 
 #endif
 
-template <typename T_SH1, typename T_SH2>
-FCL_REAL ShapeShapeDistance(const CollisionGeometry* o1, const Transform3f& tf1,
-                            const CollisionGeometry* o2, const Transform3f& tf2,
-                            const GJKSolver* nsolver,
-                            const DistanceRequest& request,
-                            DistanceResult& result) {
-  if (request.isSatisfied(result)) return result.min_distance;
-  ShapeDistanceTraversalNode<T_SH1, T_SH2> node;
-  const T_SH1* obj1 = static_cast<const T_SH1*>(o1);
-  const T_SH2* obj2 = static_cast<const T_SH2*>(o2);
-
-  initialize(node, *obj1, tf1, *obj2, tf2, nsolver, request, result);
-  distance(&node);
-
-  return result.min_distance;
-}
-
-template <typename T_BVH, typename T_SH>
-struct HPP_FCL_LOCAL BVHShapeDistancer {
-  static FCL_REAL distance(const CollisionGeometry* o1, const Transform3f& tf1,
-                           const CollisionGeometry* o2, const Transform3f& tf2,
-                           const GJKSolver* nsolver,
-                           const DistanceRequest& request,
-                           DistanceResult& result) {
-    if (request.isSatisfied(result)) return result.min_distance;
-    MeshShapeDistanceTraversalNode<T_BVH, T_SH> node;
-    const BVHModel<T_BVH>* obj1 = static_cast<const BVHModel<T_BVH>*>(o1);
-    BVHModel<T_BVH>* obj1_tmp = new BVHModel<T_BVH>(*obj1);
-    Transform3f tf1_tmp = tf1;
-    const T_SH* obj2 = static_cast<const T_SH*>(o2);
-
-    initialize(node, *obj1_tmp, tf1_tmp, *obj2, tf2, nsolver, request, result);
-    fcl::distance(&node);
-
-    delete obj1_tmp;
-    return result.min_distance;
-  }
-};
-
-namespace details {
-
-template <typename OrientedMeshShapeDistanceTraversalNode, typename T_BVH,
-          typename T_SH>
-FCL_REAL orientedBVHShapeDistance(const CollisionGeometry* o1,
-                                  const Transform3f& tf1,
-                                  const CollisionGeometry* o2,
-                                  const Transform3f& tf2,
-                                  const GJKSolver* nsolver,
-                                  const DistanceRequest& request,
-                                  DistanceResult& result) {
-  if (request.isSatisfied(result)) return result.min_distance;
-  OrientedMeshShapeDistanceTraversalNode node;
-  const BVHModel<T_BVH>* obj1 = static_cast<const BVHModel<T_BVH>*>(o1);
-  const T_SH* obj2 = static_cast<const T_SH*>(o2);
-
-  initialize(node, *obj1, tf1, *obj2, tf2, nsolver, request, result);
-  fcl::distance(&node);
-
-  return result.min_distance;
-}
-
-}  // namespace details
-
-template <typename T_SH>
-struct HPP_FCL_LOCAL BVHShapeDistancer<RSS, T_SH> {
-  static FCL_REAL distance(const CollisionGeometry* o1, const Transform3f& tf1,
-                           const CollisionGeometry* o2, const Transform3f& tf2,
-                           const GJKSolver* nsolver,
-                           const DistanceRequest& request,
-                           DistanceResult& result) {
-    return details::orientedBVHShapeDistance<
-        MeshShapeDistanceTraversalNodeRSS<T_SH>, RSS, T_SH>(
-        o1, tf1, o2, tf2, nsolver, request, result);
-  }
-};
-
-template <typename T_SH>
-struct HPP_FCL_LOCAL BVHShapeDistancer<kIOS, T_SH> {
-  static FCL_REAL distance(const CollisionGeometry* o1, const Transform3f& tf1,
-                           const CollisionGeometry* o2, const Transform3f& tf2,
-                           const GJKSolver* nsolver,
-                           const DistanceRequest& request,
-                           DistanceResult& result) {
-    return details::orientedBVHShapeDistance<
-        MeshShapeDistanceTraversalNodekIOS<T_SH>, kIOS, T_SH>(
-        o1, tf1, o2, tf2, nsolver, request, result);
-  }
-};
-
-template <typename T_SH>
-struct HPP_FCL_LOCAL BVHShapeDistancer<OBBRSS, T_SH> {
-  static FCL_REAL distance(const CollisionGeometry* o1, const Transform3f& tf1,
-                           const CollisionGeometry* o2, const Transform3f& tf2,
-                           const GJKSolver* nsolver,
-                           const DistanceRequest& request,
-                           DistanceResult& result) {
-    return details::orientedBVHShapeDistance<
-        MeshShapeDistanceTraversalNodeOBBRSS<T_SH>, OBBRSS, T_SH>(
-        o1, tf1, o2, tf2, nsolver, request, result);
-  }
-};
-
-template <typename T_HF, typename T_SH>
-struct HPP_FCL_LOCAL HeightFieldShapeDistancer {
-  static FCL_REAL distance(const CollisionGeometry* o1, const Transform3f& tf1,
-                           const CollisionGeometry* o2, const Transform3f& tf2,
-                           const GJKSolver* nsolver,
-                           const DistanceRequest& request,
-                           DistanceResult& result) {
-    HPP_FCL_UNUSED_VARIABLE(o1);
-    HPP_FCL_UNUSED_VARIABLE(tf1);
-    HPP_FCL_UNUSED_VARIABLE(o2);
-    HPP_FCL_UNUSED_VARIABLE(tf2);
-    HPP_FCL_UNUSED_VARIABLE(nsolver);
-    HPP_FCL_UNUSED_VARIABLE(request);
-    // TODO(jcarpent)
-    HPP_FCL_THROW_PRETTY(
-        "Distance between a height field and a shape is not implemented",
-        std::invalid_argument);
-    //    if(request.isSatisfied(result)) return result.min_distance;
-    //    HeightFieldShapeDistanceTraversalNode<T_HF, T_SH> node;
-    //
-    //    const HeightField<T_HF>* obj1 = static_cast<const HeightField<T_HF>*
-    //    >(o1); const T_SH* obj2 = static_cast<const T_SH*>(o2);
-    //
-    //    initialize(node, *obj1, tf1, *obj2, tf2, nsolver, request, result);
-    //    fcl::distance(&node);
-
-    return result.min_distance;
-  }
-};
-
-template <typename T_BVH>
-FCL_REAL BVHDistance(const CollisionGeometry* o1, const Transform3f& tf1,
-                     const CollisionGeometry* o2, const Transform3f& tf2,
-                     const DistanceRequest& request, DistanceResult& result) {
-  if (request.isSatisfied(result)) return result.min_distance;
-  MeshDistanceTraversalNode<T_BVH> node;
-  const BVHModel<T_BVH>* obj1 = static_cast<const BVHModel<T_BVH>*>(o1);
-  const BVHModel<T_BVH>* obj2 = static_cast<const BVHModel<T_BVH>*>(o2);
-  BVHModel<T_BVH>* obj1_tmp = new BVHModel<T_BVH>(*obj1);
-  Transform3f tf1_tmp = tf1;
-  BVHModel<T_BVH>* obj2_tmp = new BVHModel<T_BVH>(*obj2);
-  Transform3f tf2_tmp = tf2;
-
-  initialize(node, *obj1_tmp, tf1_tmp, *obj2_tmp, tf2_tmp, request, result);
-  distance(&node);
-  delete obj1_tmp;
-  delete obj2_tmp;
-
-  return result.min_distance;
-}
-
-namespace details {
-template <typename OrientedMeshDistanceTraversalNode, typename T_BVH>
-FCL_REAL orientedMeshDistance(const CollisionGeometry* o1,
-                              const Transform3f& tf1,
-                              const CollisionGeometry* o2,
-                              const Transform3f& tf2,
-                              const DistanceRequest& request,
-                              DistanceResult& result) {
+/// Distance between a signed distance field and a shape, the shape coming
+/// first if Swapped.
+template <bool Swapped>
+FCL_REAL SDFShapeDistance(const CollisionGeometry* o1, const Transform3f& tf1,
+                          const CollisionGeometry* o2, const Transform3f& tf2,
+                          const GJKSolver*, const DistanceRequest& request,
+                          DistanceResult& result) {
   if (request.isSatisfied(result)) return result.min_distance;
-  OrientedMeshDistanceTraversalNode node;
-  const BVHModel<T_BVH>* obj1 = static_cast<const BVHModel<T_BVH>*>(o1);
-  const BVHModel<T_BVH>* obj2 = static_cast<const BVHModel<T_BVH>*>(o2);
-
-  initialize(node, *obj1, tf1, *obj2, tf2, request, result);
-  distance(&node);
 
-  return result.min_distance;
+  const CollisionGeometry* o_sdf = Swapped ? o2 : o1;
+  const CollisionGeometry* o_shape = Swapped ? o1 : o2;
+  const Transform3f& tf_sdf = Swapped ? tf2 : tf1;
+  const Transform3f& tf_shape = Swapped ? tf1 : tf2;
+  Vec3f p_sdf, p_shape, normal;
+  const FCL_REAL distance = details::sdfShapeDistance(
+      *static_cast<const SignedDistanceField*>(o_sdf),
+      *static_cast<const ShapeBase*>(o_shape), tf_sdf.inverseTimes(tf_shape),
+      p_sdf, p_shape, normal);
+  p_sdf = tf_sdf.transform(p_sdf);
+  p_shape = tf_sdf.transform(p_shape);
+  normal = tf_sdf.getRotation() * normal;
+  if (Swapped)
+    result.update(distance, o1, o2, DistanceResult::NONE, DistanceResult::NONE,
+                  p_shape, p_sdf, -normal);
+  else
+    result.update(distance, o1, o2, DistanceResult::NONE, DistanceResult::NONE,
+                  p_sdf, p_shape, normal);
+  return distance;
 }
 
-}  // namespace details
-
-template <>
-FCL_REAL BVHDistance<RSS>(const CollisionGeometry* o1, const Transform3f& tf1,
+/// Distance between a compound and any geometry, the geometry coming first if
+/// Swapped.
+template <bool Swapped>
+FCL_REAL CompoundDistance(const CollisionGeometry* o1, const Transform3f& tf1,
                           const CollisionGeometry* o2, const Transform3f& tf2,
+                          const GJKSolver* nsolver,
                           const DistanceRequest& request,
                           DistanceResult& result) {
-  return details::orientedMeshDistance<MeshDistanceTraversalNodeRSS, RSS>(
-      o1, tf1, o2, tf2, request, result);
-}
-
-template <>
-FCL_REAL BVHDistance<kIOS>(const CollisionGeometry* o1, const Transform3f& tf1,
-                           const CollisionGeometry* o2, const Transform3f& tf2,
-                           const DistanceRequest& request,
-                           DistanceResult& result) {
-  return details::orientedMeshDistance<MeshDistanceTraversalNodekIOS, kIOS>(
-      o1, tf1, o2, tf2, request, result);
-}
-
-template <>
-FCL_REAL BVHDistance<OBBRSS>(const CollisionGeometry* o1,
-                             const Transform3f& tf1,
-                             const CollisionGeometry* o2,
-                             const Transform3f& tf2,
-                             const DistanceRequest& request,
-                             DistanceResult& result) {
-  return details::orientedMeshDistance<MeshDistanceTraversalNodeOBBRSS, OBBRSS>(
-      o1, tf1, o2, tf2, request, result);
-}
-
-template <typename T_BVH>
-FCL_REAL BVHDistance(const CollisionGeometry* o1, const Transform3f& tf1,
-                     const CollisionGeometry* o2, const Transform3f& tf2,
-                     const GJKSolver* /*nsolver*/,
-                     const DistanceRequest& request, DistanceResult& result) {
-  return BVHDistance<T_BVH>(o1, tf1, o2, tf2, request, result);
+  if (Swapped)
+    return details::compoundDistance(*static_cast<const Compound*>(o2), tf2,
+                                     o1, tf1, false, nsolver, request, result);
+  return details::compoundDistance(*static_cast<const Compound*>(o1), tf1, o2,
+                                   tf2, true, nsolver, request, result);
 }
 
 DistanceFunctionMatrix::DistanceFunctionMatrix() {
@@ -282,322 +116,34 @@ DistanceFunctionMatrix::DistanceFunctionMatrix() {
     for (int j = 0; j < NODE_COUNT; ++j) distance_matrix[i][j] = NULL;
   }
 
-  distance_matrix[GEOM_BOX][GEOM_BOX] = &ShapeShapeDistance<Box, Box>;
-  distance_matrix[GEOM_BOX][GEOM_SPHERE] = &ShapeShapeDistance<Box, Sphere>;
-  distance_matrix[GEOM_BOX][GEOM_CAPSULE] = &ShapeShapeDistance<Box, Capsule>;
-  distance_matrix[GEOM_BOX][GEOM_CONE] = &ShapeShapeDistance<Box, Cone>;
-  distance_matrix[GEOM_BOX][GEOM_CYLINDER] = &ShapeShapeDistance<Box, Cylinder>;
-  distance_matrix[GEOM_BOX][GEOM_CONVEX] = &ShapeShapeDistance<Box, ConvexBase>;
-  distance_matrix[GEOM_BOX][GEOM_PLANE] = &ShapeShapeDistance<Box, Plane>;
-  distance_matrix[GEOM_BOX][GEOM_HALFSPACE] =
-      &ShapeShapeDistance<Box, Halfspace>;
-  distance_matrix[GEOM_BOX][GEOM_ELLIPSOID] =
-      &ShapeShapeDistance<Box, Ellipsoid>;
-
-  distance_matrix[GEOM_SPHERE][GEOM_BOX] = &ShapeShapeDistance<Sphere, Box>;
-  distance_matrix[GEOM_SPHERE][GEOM_SPHERE] =
-      &ShapeShapeDistance<Sphere, Sphere>;
-  distance_matrix[GEOM_SPHERE][GEOM_CAPSULE] =
-      &ShapeShapeDistance<Sphere, Capsule>;
-  distance_matrix[GEOM_SPHERE][GEOM_CONE] = &ShapeShapeDistance<Sphere, Cone>;
-  distance_matrix[GEOM_SPHERE][GEOM_CYLINDER] =
-      &ShapeShapeDistance<Sphere, Cylinder>;
-  distance_matrix[GEOM_SPHERE][GEOM_CONVEX] =
-      &ShapeShapeDistance<Sphere, ConvexBase>;
-  distance_matrix[GEOM_SPHERE][GEOM_PLANE] = &ShapeShapeDistance<Sphere, Plane>;
-  distance_matrix[GEOM_SPHERE][GEOM_HALFSPACE] =
-      &ShapeShapeDistance<Sphere, Halfspace>;
-  distance_matrix[GEOM_SPHERE][GEOM_ELLIPSOID] =
-      &ShapeShapeDistance<Sphere, Ellipsoid>;
-
-  distance_matrix[GEOM_ELLIPSOID][GEOM_BOX] =
-      &ShapeShapeDistance<Ellipsoid, Box>;
-  distance_matrix[GEOM_ELLIPSOID][GEOM_SPHERE] =
-      &ShapeShapeDistance<Ellipsoid, Sphere>;
-  distance_matrix[GEOM_ELLIPSOID][GEOM_CAPSULE] =
-      &ShapeShapeDistance<Ellipsoid, Capsule>;
-  distance_matrix[GEOM_ELLIPSOID][GEOM_CONE] =
-      &ShapeShapeDistance<Ellipsoid, Cone>;
-  distance_matrix[GEOM_ELLIPSOID][GEOM_CYLINDER] =
-      &ShapeShapeDistance<Ellipsoid, Cylinder>;
-  distance_matrix[GEOM_ELLIPSOID][GEOM_CONVEX] =
-      &ShapeShapeDistance<Ellipsoid, ConvexBase>;
-  // TODO Louis: Ellipsoid - Plane
-  // TODO Louis: Ellipsoid - Halfspace
-  distance_matrix[GEOM_ELLIPSOID][GEOM_ELLIPSOID] =
-      &ShapeShapeDistance<Ellipsoid, Ellipsoid>;
-
-  distance_matrix[GEOM_CAPSULE][GEOM_BOX] = &ShapeShapeDistance<Capsule, Box>;
-  distance_matrix[GEOM_CAPSULE][GEOM_SPHERE] =
-      &ShapeShapeDistance<Capsule, Sphere>;
-  distance_matrix[GEOM_CAPSULE][GEOM_CAPSULE] =
-      &ShapeShapeDistance<Capsule, Capsule>;
-  distance_matrix[GEOM_CAPSULE][GEOM_CONE] = &ShapeShapeDistance<Capsule, Cone>;
-  distance_matrix[GEOM_CAPSULE][GEOM_CYLINDER] =
-      &ShapeShapeDistance<Capsule, Cylinder>;
-  distance_matrix[GEOM_CAPSULE][GEOM_CONVEX] =
-      &ShapeShapeDistance<Capsule, ConvexBase>;
-  distance_matrix[GEOM_CAPSULE][GEOM_PLANE] =
-      &ShapeShapeDistance<Capsule, Plane>;
-  distance_matrix[GEOM_CAPSULE][GEOM_HALFSPACE] =
-      &ShapeShapeDistance<Capsule, Halfspace>;
-  distance_matrix[GEOM_CAPSULE][GEOM_ELLIPSOID] =
-      &ShapeShapeDistance<Capsule, Ellipsoid>;
-
-  distance_matrix[GEOM_CONE][GEOM_BOX] = &ShapeShapeDistance<Cone, Box>;
-  distance_matrix[GEOM_CONE][GEOM_SPHERE] = &ShapeShapeDistance<Cone, Sphere>;
-  distance_matrix[GEOM_CONE][GEOM_CAPSULE] = &ShapeShapeDistance<Cone, Capsule>;
-  distance_matrix[GEOM_CONE][GEOM_CONE] = &ShapeShapeDistance<Cone, Cone>;
-  distance_matrix[GEOM_CONE][GEOM_CYLINDER] =
-      &ShapeShapeDistance<Cone, Cylinder>;
-  distance_matrix[GEOM_CONE][GEOM_CONVEX] =
-      &ShapeShapeDistance<Cone, ConvexBase>;
-  distance_matrix[GEOM_CONE][GEOM_PLANE] = &ShapeShapeDistance<Cone, Plane>;
-  distance_matrix[GEOM_CONE][GEOM_HALFSPACE] =
-      &ShapeShapeDistance<Cone, Halfspace>;
-  distance_matrix[GEOM_CONE][GEOM_ELLIPSOID] =
-      &ShapeShapeDistance<Cone, Ellipsoid>;
-
-  distance_matrix[GEOM_CYLINDER][GEOM_BOX] = &ShapeShapeDistance<Cylinder, Box>;
-  distance_matrix[GEOM_CYLINDER][GEOM_SPHERE] =
-      &ShapeShapeDistance<Cylinder, Sphere>;
-  distance_matrix[GEOM_CYLINDER][GEOM_CAPSULE] =
-      &ShapeShapeDistance<Cylinder, Capsule>;
-  distance_matrix[GEOM_CYLINDER][GEOM_CONE] =
-      &ShapeShapeDistance<Cylinder, Cone>;
-  distance_matrix[GEOM_CYLINDER][GEOM_CYLINDER] =
-      &ShapeShapeDistance<Cylinder, Cylinder>;
-  distance_matrix[GEOM_CYLINDER][GEOM_CONVEX] =
-      &ShapeShapeDistance<Cylinder, ConvexBase>;
-  distance_matrix[GEOM_CYLINDER][GEOM_PLANE] =
-      &ShapeShapeDistance<Cylinder, Plane>;
-  distance_matrix[GEOM_CYLINDER][GEOM_HALFSPACE] =
-      &ShapeShapeDistance<Cylinder, Halfspace>;
-  distance_matrix[GEOM_CYLINDER][GEOM_ELLIPSOID] =
-      &ShapeShapeDistance<Cylinder, Ellipsoid>;
-
-  distance_matrix[GEOM_CONVEX][GEOM_BOX] = &ShapeShapeDistance<ConvexBase, Box>;
-  distance_matrix[GEOM_CONVEX][GEOM_SPHERE] =
-      &ShapeShapeDistance<ConvexBase, Sphere>;
-  distance_matrix[GEOM_CONVEX][GEOM_CAPSULE] =
-      &ShapeShapeDistance<ConvexBase, Capsule>;
-  distance_matrix[GEOM_CONVEX][GEOM_CONE] =
-      &ShapeShapeDistance<ConvexBase, Cone>;
-  distance_matrix[GEOM_CONVEX][GEOM_CYLINDER] =
-      &ShapeShapeDistance<ConvexBase, Cylinder>;
-  distance_matrix[GEOM_CONVEX][GEOM_CONVEX] =
-      &ShapeShapeDistance<ConvexBase, ConvexBase>;
-  distance_matrix[GEOM_CONVEX][GEOM_PLANE] =
-      &ShapeShapeDistance<ConvexBase, Plane>;
-  distance_matrix[GEOM_CONVEX][GEOM_HALFSPACE] =
-      &ShapeShapeDistance<ConvexBase, Halfspace>;
-  distance_matrix[GEOM_CONVEX][GEOM_ELLIPSOID] =
-      &ShapeShapeDistance<ConvexBase, Ellipsoid>;
-
-  distance_matrix[GEOM_PLANE][GEOM_BOX] = &ShapeShapeDistance<Plane, Box>;
-  distance_matrix[GEOM_PLANE][GEOM_SPHERE] = &ShapeShapeDistance<Plane, Sphere>;
-  distance_matrix[GEOM_PLANE][GEOM_CAPSULE] =
-      &ShapeShapeDistance<Plane, Capsule>;
-  distance_matrix[GEOM_PLANE][GEOM_CONE] = &ShapeShapeDistance<Plane, Cone>;
-  distance_matrix[GEOM_PLANE][GEOM_CYLINDER] =
-      &ShapeShapeDistance<Plane, Cylinder>;
-  distance_matrix[GEOM_PLANE][GEOM_CONVEX] =
-      &ShapeShapeDistance<Plane, ConvexBase>;
-  distance_matrix[GEOM_PLANE][GEOM_PLANE] = &ShapeShapeDistance<Plane, Plane>;
-  distance_matrix[GEOM_PLANE][GEOM_HALFSPACE] =
-      &ShapeShapeDistance<Plane, Halfspace>;
-  // TODO Louis: Ellipsoid - Plane
-
-  distance_matrix[GEOM_HALFSPACE][GEOM_BOX] =
-      &ShapeShapeDistance<Halfspace, Box>;
-  distance_matrix[GEOM_HALFSPACE][GEOM_SPHERE] =
-      &ShapeShapeDistance<Halfspace, Sphere>;
-  distance_matrix[GEOM_HALFSPACE][GEOM_CAPSULE] =
-      &ShapeShapeDistance<Halfspace, Capsule>;
-  distance_matrix[GEOM_HALFSPACE][GEOM_CONE] =
-      &ShapeShapeDistance<Halfspace, Cone>;
-  distance_matrix[GEOM_HALFSPACE][GEOM_CYLINDER] =
-      &ShapeShapeDistance<Halfspace, Cylinder>;
-  distance_matrix[GEOM_HALFSPACE][GEOM_CONVEX] =
-      &ShapeShapeDistance<Halfspace, ConvexBase>;
-  distance_matrix[GEOM_HALFSPACE][GEOM_PLANE] =
-      &ShapeShapeDistance<Halfspace, Plane>;
-  distance_matrix[GEOM_HALFSPACE][GEOM_HALFSPACE] =
-      &ShapeShapeDistance<Halfspace, Halfspace>;
-  // TODO Louis: Ellipsoid - Halfspace
-
-  /* AABB distance not implemented */
-  /*
-  distance_matrix[BV_AABB][GEOM_BOX] = &BVHShapeDistancer<AABB, Box>::distance;
-  distance_matrix[BV_AABB][GEOM_SPHERE] = &BVHShapeDistancer<AABB,
-  Sphere>::distance; distance_matrix[BV_AABB][GEOM_CAPSULE] =
-  &BVHShapeDistancer<AABB, Capsule>::distance;
-  distance_matrix[BV_AABB][GEOM_CONE] = &BVHShapeDistancer<AABB,
-  Cone>::distance; distance_matrix[BV_AABB][GEOM_CYLINDER] =
-  &BVHShapeDistancer<AABB, Cylinder>::distance;
-  distance_matrix[BV_AABB][GEOM_CONVEX] = &BVHShapeDistancer<AABB,
-  ConvexBase>::distance; distance_matrix[BV_AABB][GEOM_PLANE] =
-  &BVHShapeDistancer<AABB, Plane>::distance;
-  distance_matrix[BV_AABB][GEOM_HALFSPACE] = &BVHShapeDistancer<AABB,
-  Halfspace>::distance;
-  */
-
-  distance_matrix[BV_OBB][GEOM_BOX] = &BVHShapeDistancer<OBB, Box>::distance;
-  distance_matrix[BV_OBB][GEOM_SPHERE] =
-      &BVHShapeDistancer<OBB, Sphere>::distance;
-  distance_matrix[BV_OBB][GEOM_CAPSULE] =
-      &BVHShapeDistancer<OBB, Capsule>::distance;
-  distance_matrix[BV_OBB][GEOM_CONE] = &BVHShapeDistancer<OBB, Cone>::distance;
-  distance_matrix[BV_OBB][GEOM_CYLINDER] =
-      &BVHShapeDistancer<OBB, Cylinder>::distance;
-  distance_matrix[BV_OBB][GEOM_CONVEX] =
-      &BVHShapeDistancer<OBB, ConvexBase>::distance;
-  distance_matrix[BV_OBB][GEOM_PLANE] =
-      &BVHShapeDistancer<OBB, Plane>::distance;
-  distance_matrix[BV_OBB][GEOM_HALFSPACE] =
-      &BVHShapeDistancer<OBB, Halfspace>::distance;
-  distance_matrix[BV_OBB][GEOM_ELLIPSOID] =
-      &BVHShapeDistancer<OBB, Ellipsoid>::distance;
-
-  distance_matrix[BV_RSS][GEOM_BOX] = &BVHShapeDistancer<RSS, Box>::distance;
-  distance_matrix[BV_RSS][GEOM_SPHERE] =
-      &BVHShapeDistancer<RSS, Sphere>::distance;
-  distance_matrix[BV_RSS][GEOM_CAPSULE] =
-      &BVHShapeDistancer<RSS, Capsule>::distance;
-  distance_matrix[BV_RSS][GEOM_CONE] = &BVHShapeDistancer<RSS, Cone>::distance;
-  distance_matrix[BV_RSS][GEOM_CYLINDER] =
-      &BVHShapeDistancer<RSS, Cylinder>::distance;
-  distance_matrix[BV_RSS][GEOM_CONVEX] =
-      &BVHShapeDistancer<RSS, ConvexBase>::distance;
-  distance_matrix[BV_RSS][GEOM_PLANE] =
-      &BVHShapeDistancer<RSS, Plane>::distance;
-  distance_matrix[BV_RSS][GEOM_HALFSPACE] =
-      &BVHShapeDistancer<RSS, Halfspace>::distance;
-  distance_matrix[BV_RSS][GEOM_ELLIPSOID] =
-      &BVHShapeDistancer<RSS, Ellipsoid>::distance;
-
-  /* KDOP distance not implemented */
-  /*
-  distance_matrix[BV_KDOP16][GEOM_BOX] = &BVHShapeDistancer<KDOP<16>,
-  Box>::distance; distance_matrix[BV_KDOP16][GEOM_SPHERE] =
-  &BVHShapeDistancer<KDOP<16>, Sphere>::distance;
-  distance_matrix[BV_KDOP16][GEOM_CAPSULE] = &BVHShapeDistancer<KDOP<16>,
-  Capsule>::distance; distance_matrix[BV_KDOP16][GEOM_CONE] =
-  &BVHShapeDistancer<KDOP<16>, Cone>::distance;
-  distance_matrix[BV_KDOP16][GEOM_CYLINDER] = &BVHShapeDistancer<KDOP<16>,
-  Cylinder>::distance; distance_matrix[BV_KDOP16][GEOM_CONVEX] =
-  &BVHShapeDistancer<KDOP<16>, ConvexBase>::distance;
-  distance_matrix[BV_KDOP16][GEOM_PLANE] = &BVHShapeDistancer<KDOP<16>,
-  Plane>::distance; distance_matrix[BV_KDOP16][GEOM_HALFSPACE] =
-  &BVHShapeDistancer<KDOP<16>, Halfspace>::distance;
-
-  distance_matrix[BV_KDOP18][GEOM_BOX] = &BVHShapeDistancer<KDOP<18>,
-  Box>::distance; distance_matrix[BV_KDOP18][GEOM_SPHERE] =
-  &BVHShapeDistancer<KDOP<18>, Sphere>::distance;
-  distance_matrix[BV_KDOP18][GEOM_CAPSULE] = &BVHShapeDistancer<KDOP<18>,
-  Capsule>::distance; distance_matrix[BV_KDOP18][GEOM_CONE] =
-  &BVHShapeDistancer<KDOP<18>, Cone>::distance;
-  distance_matrix[BV_KDOP18][GEOM_CYLINDER] = &BVHShapeDistancer<KDOP<18>,
-  Cylinder>::distance; distance_matrix[BV_KDOP18][GEOM_CONVEX] =
-  &BVHShapeDistancer<KDOP<18>, ConvexBase>::distance;
-  distance_matrix[BV_KDOP18][GEOM_PLANE] = &BVHShapeDistancer<KDOP<18>,
-  Plane>::distance; distance_matrix[BV_KDOP18][GEOM_HALFSPACE] =
-  &BVHShapeDistancer<KDOP<18>, Halfspace>::distance;
-
-  distance_matrix[BV_KDOP24][GEOM_BOX] = &BVHShapeDistancer<KDOP<24>,
-  Box>::distance; distance_matrix[BV_KDOP24][GEOM_SPHERE] =
-  &BVHShapeDistancer<KDOP<24>, Sphere>::distance;
-  distance_matrix[BV_KDOP24][GEOM_CAPSULE] = &BVHShapeDistancer<KDOP<24>,
-  Capsule>::distance; distance_matrix[BV_KDOP24][GEOM_CONE] =
-  &BVHShapeDistancer<KDOP<24>, Cone>::distance;
-  distance_matrix[BV_KDOP24][GEOM_CYLINDER] = &BVHShapeDistancer<KDOP<24>,
-  Cylinder>::distance; distance_matrix[BV_KDOP24][GEOM_CONVEX] =
-  &BVHShapeDistancer<KDOP<24>, ConvexBase>::distance;
-  distance_matrix[BV_KDOP24][GEOM_PLANE] = &BVHShapeDistancer<KDOP<24>,
-  Plane>::distance; distance_matrix[BV_KDOP24][GEOM_HALFSPACE] =
-  &BVHShapeDistancer<KDOP<24>, Halfspace>::distance;
-  */
-
-  distance_matrix[BV_kIOS][GEOM_BOX] = &BVHShapeDistancer<kIOS, Box>::distance;
-  distance_matrix[BV_kIOS][GEOM_SPHERE] =
-      &BVHShapeDistancer<kIOS, Sphere>::distance;
-  distance_matrix[BV_kIOS][GEOM_CAPSULE] =
-      &BVHShapeDistancer<kIOS, Capsule>::distance;
-  distance_matrix[BV_kIOS][GEOM_CONE] =
-      &BVHShapeDistancer<kIOS, Cone>::distance;
-  distance_matrix[BV_kIOS][GEOM_CYLINDER] =
-      &BVHShapeDistancer<kIOS, Cylinder>::distance;
-  distance_matrix[BV_kIOS][GEOM_CONVEX] =
-      &BVHShapeDistancer<kIOS, ConvexBase>::distance;
-  distance_matrix[BV_kIOS][GEOM_PLANE] =
-      &BVHShapeDistancer<kIOS, Plane>::distance;
-  distance_matrix[BV_kIOS][GEOM_HALFSPACE] =
-      &BVHShapeDistancer<kIOS, Halfspace>::distance;
-  distance_matrix[BV_kIOS][GEOM_ELLIPSOID] =
-      &BVHShapeDistancer<kIOS, Ellipsoid>::distance;
-
-  distance_matrix[BV_OBBRSS][GEOM_BOX] =
-      &BVHShapeDistancer<OBBRSS, Box>::distance;
-  distance_matrix[BV_OBBRSS][GEOM_SPHERE] =
-      &BVHShapeDistancer<OBBRSS, Sphere>::distance;
-  distance_matrix[BV_OBBRSS][GEOM_CAPSULE] =
-      &BVHShapeDistancer<OBBRSS, Capsule>::distance;
-  distance_matrix[BV_OBBRSS][GEOM_CONE] =
-      &BVHShapeDistancer<OBBRSS, Cone>::distance;
-  distance_matrix[BV_OBBRSS][GEOM_CYLINDER] =
-      &BVHShapeDistancer<OBBRSS, Cylinder>::distance;
-  distance_matrix[BV_OBBRSS][GEOM_CONVEX] =
-      &BVHShapeDistancer<OBBRSS, ConvexBase>::distance;
-  distance_matrix[BV_OBBRSS][GEOM_PLANE] =
-      &BVHShapeDistancer<OBBRSS, Plane>::distance;
-  distance_matrix[BV_OBBRSS][GEOM_HALFSPACE] =
-      &BVHShapeDistancer<OBBRSS, Halfspace>::distance;
-  distance_matrix[BV_OBBRSS][GEOM_ELLIPSOID] =
-      &BVHShapeDistancer<OBBRSS, Ellipsoid>::distance;
-
-  distance_matrix[HF_AABB][GEOM_BOX] =
-      &HeightFieldShapeDistancer<AABB, Box>::distance;
-  distance_matrix[HF_AABB][GEOM_SPHERE] =
-      &HeightFieldShapeDistancer<AABB, Sphere>::distance;
-  distance_matrix[HF_AABB][GEOM_CAPSULE] =
-      &HeightFieldShapeDistancer<AABB, Capsule>::distance;
-  distance_matrix[HF_AABB][GEOM_CONE] =
-      &HeightFieldShapeDistancer<AABB, Cone>::distance;
-  distance_matrix[HF_AABB][GEOM_CYLINDER] =
-      &HeightFieldShapeDistancer<AABB, Cylinder>::distance;
-  distance_matrix[HF_AABB][GEOM_CONVEX] =
-      &HeightFieldShapeDistancer<AABB, ConvexBase>::distance;
-  distance_matrix[HF_AABB][GEOM_PLANE] =
-      &HeightFieldShapeDistancer<AABB, Plane>::distance;
-  distance_matrix[HF_AABB][GEOM_HALFSPACE] =
-      &HeightFieldShapeDistancer<AABB, Halfspace>::distance;
-  distance_matrix[HF_AABB][GEOM_ELLIPSOID] =
-      &HeightFieldShapeDistancer<AABB, Ellipsoid>::distance;
-
-  distance_matrix[HF_OBBRSS][GEOM_BOX] =
-      &HeightFieldShapeDistancer<OBBRSS, Box>::distance;
-  distance_matrix[HF_OBBRSS][GEOM_SPHERE] =
-      &HeightFieldShapeDistancer<OBBRSS, Sphere>::distance;
-  distance_matrix[HF_OBBRSS][GEOM_CAPSULE] =
-      &HeightFieldShapeDistancer<OBBRSS, Capsule>::distance;
-  distance_matrix[HF_OBBRSS][GEOM_CONE] =
-      &HeightFieldShapeDistancer<OBBRSS, Cone>::distance;
-  distance_matrix[HF_OBBRSS][GEOM_CYLINDER] =
-      &HeightFieldShapeDistancer<OBBRSS, Cylinder>::distance;
-  distance_matrix[HF_OBBRSS][GEOM_CONVEX] =
-      &HeightFieldShapeDistancer<OBBRSS, ConvexBase>::distance;
-  distance_matrix[HF_OBBRSS][GEOM_PLANE] =
-      &HeightFieldShapeDistancer<OBBRSS, Plane>::distance;
-  distance_matrix[HF_OBBRSS][GEOM_HALFSPACE] =
-      &HeightFieldShapeDistancer<OBBRSS, Halfspace>::distance;
-  distance_matrix[HF_OBBRSS][GEOM_ELLIPSOID] =
-      &HeightFieldShapeDistancer<OBBRSS, Ellipsoid>::distance;
-
-  distance_matrix[BV_AABB][BV_AABB] = &BVHDistance<AABB>;
-  distance_matrix[BV_OBB][BV_OBB] = &BVHDistance<OBB>;
-  distance_matrix[BV_RSS][BV_RSS] = &BVHDistance<RSS>;
-  distance_matrix[BV_kIOS][BV_kIOS] = &BVHDistance<kIOS>;
-  distance_matrix[BV_OBBRSS][BV_OBBRSS] = &BVHDistance<OBBRSS>;
+  // Functions between shapes, BVH models and height fields. These are the
+  // functions run by the typed distance.
+  details::registerFunctions<DistanceFunctor>(distance_matrix,
+                                             details::query_types());
+
+  distance_matrix[GEOM_SDF][GEOM_BOX] = &SDFShapeDistance<false>;
+  distance_matrix[GEOM_SDF][GEOM_SPHERE] = &SDFShapeDistance<false>;
+  distance_matrix[GEOM_SDF][GEOM_ELLIPSOID] = &SDFShapeDistance<false>;
+  distance_matrix[GEOM_SDF][GEOM_CAPSULE] = &SDFShapeDistance<false>;
+  distance_matrix[GEOM_SDF][GEOM_CONE] = &SDFShapeDistance<false>;
+  distance_matrix[GEOM_SDF][GEOM_CYLINDER] = &SDFShapeDistance<false>;
+  distance_matrix[GEOM_SDF][GEOM_CONVEX] = &SDFShapeDistance<false>;
+  distance_matrix[GEOM_SDF][GEOM_TRIANGLE] = &SDFShapeDistance<false>;
+
+  distance_matrix[GEOM_BOX][GEOM_SDF] = &SDFShapeDistance<true>;
+  distance_matrix[GEOM_SPHERE][GEOM_SDF] = &SDFShapeDistance<true>;
+  distance_matrix[GEOM_ELLIPSOID][GEOM_SDF] = &SDFShapeDistance<true>;
+  distance_matrix[GEOM_CAPSULE][GEOM_SDF] = &SDFShapeDistance<true>;
+  distance_matrix[GEOM_CONE][GEOM_SDF] = &SDFShapeDistance<true>;
+  distance_matrix[GEOM_CYLINDER][GEOM_SDF] = &SDFShapeDistance<true>;
+  distance_matrix[GEOM_CONVEX][GEOM_SDF] = &SDFShapeDistance<true>;
+  distance_matrix[GEOM_TRIANGLE][GEOM_SDF] = &SDFShapeDistance<true>;
+
+  // The children of a compound are dispatched again through this matrix.
+  for (int i = 0; i < NODE_COUNT; ++i) {
+    distance_matrix[GEOM_COMPOUND][i] = &CompoundDistance<false>;
+    distance_matrix[i][GEOM_COMPOUND] = &CompoundDistance<true>;
+  }
 
 #ifdef HPP_FCL_HAS_OCTOMAP
   distance_matrix[GEOM_OCTREE][GEOM_BOX] = &Distance<OcTree, Box>;
@@ -0,0 +1,368 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <hpp/fcl/narrowphase/contact_manifold.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <hpp/fcl/internal/tools.h>
+#include <hpp/fcl/narrowphase/gjk.h>
+
+namespace hpp {
+namespace fcl {
+
+namespace details {
+
+namespace {
+
+typedef std::vector<Vec3f> Feature;
+
+/// Tangent of the angle below which a face or an edge is considered as
+/// orthogonal to the contact normal (about 2 degrees).
+const FCL_REAL angular_tolerance = 0.035;
+
+/// Number of points of the polygon approximating the caps of a cylinder.
+const int num_cap_points = 8;
+
+/// Vertices of a polytope which support direction dir, up to the angular
+/// tolerance.
+void polytopeFeature(const Vec3f* points, unsigned int num_points,
+                     const Vec3f& dir, Feature& feature) {
+  unsigned int support = 0;
+  FCL_REAL max_dot = points[0].dot(dir);
+  for (unsigned int i = 1; i < num_points; ++i) {
+    const FCL_REAL dot = points[i].dot(dir);
+    if (dot > max_dot) {
+      max_dot = dot;
+      support = i;
+    }
+  }
+  for (unsigned int i = 0; i < num_points; ++i) {
+    const FCL_REAL drop = max_dot - points[i].dot(dir);
+    if (drop <= angular_tolerance * (points[i] - points[support]).norm())
+      feature.push_back(points[i]);
+  }
+}
+
+/// Feature (face or edge) of a shape which supports direction dir, in the
+/// world frame.
+/// @return false when the shape only supports dir with a vertex or when the
+///         shape is not supported.
+bool supportFeature(const ShapeBase& shape, const Transform3f& tf,
+                    const Vec3f& dir, Feature& feature) {
+  const Vec3f d(tf.getRotation().transpose() * dir);
+  feature.clear();
+  switch (shape.getNodeType()) {
+    case GEOM_BOX: {
+      const Vec3f& h = static_cast<const Box&>(shape).halfSide;
+      Vec3f vertices[8];
+      for (int i = 0; i < 8; ++i)
+        vertices[i] = Vec3f((i & 1) ? h[0] : -h[0], (i & 2) ? h[1] : -h[1],
+                            (i & 4) ? h[2] : -h[2]);
+      polytopeFeature(vertices, 8, d, feature);
+      break;
+    }
+    case GEOM_CONVEX: {
+      const ConvexBase& convex = static_cast<const ConvexBase&>(shape);
+      polytopeFeature(convex.points, convex.num_points, d, feature);
+      break;
+    }
+    case GEOM_CYLINDER: {
+      const Cylinder& cylinder = static_cast<const Cylinder&>(shape);
+      const FCL_REAL lateral = std::sqrt(d[0] * d[0] + d[1] * d[1]);
+      if (lateral <= angular_tolerance * std::fabs(d[2])) {
+        // Cap
+        const FCL_REAL z =
+            (d[2] > 0) ? cylinder.halfLength : -cylinder.halfLength;
+        for (int k = 0; k < num_cap_points; ++k) {
+          const FCL_REAL angle = 2 * boost::math::constants::pi<FCL_REAL>() *
+                                 (FCL_REAL)k / (FCL_REAL)num_cap_points;
+          feature.push_back(Vec3f(cylinder.radius * std::cos(angle),
+                                  cylinder.radius * std::sin(angle), z));
+        }
+      } else if (std::fabs(d[2]) <= angular_tolerance * lateral) {
+        // Side
+        const Vec3f r(cylinder.radius * d[0] / lateral,
+                      cylinder.radius * d[1] / lateral, 0);
+        feature.push_back(r + Vec3f(0, 0, cylinder.halfLength));
+        feature.push_back(r - Vec3f(0, 0, cylinder.halfLength));
+      }
+      break;
+    }
+    case GEOM_CAPSULE: {
+      const Capsule& capsule = static_cast<const Capsule&>(shape);
+      if (std::fabs(d[2]) <= angular_tolerance * d.norm()) {
+        // Side
+        const Vec3f r(capsule.radius * d.normalized());
+        feature.push_back(r + Vec3f(0, 0, capsule.halfLength));
+        feature.push_back(r - Vec3f(0, 0, capsule.halfLength));
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  for (std::size_t i = 0; i < feature.size(); ++i)
+    feature[i] = tf.transform(feature[i]);
+  return feature.size() >= 2;
+}
+
+struct AngleLess {
+  AngleLess(const Vec3f& center, const Vec3f& u, const Vec3f& v)
+      : center(center), u(u), v(v) {}
+  FCL_REAL angle(const Vec3f& p) const {
+    return std::atan2((p - center).dot(v), (p - center).dot(u));
+  }
+  bool operator()(const Vec3f& p, const Vec3f& q) const {
+    return angle(p) < angle(q);
+  }
+  const Vec3f &center, &u, &v;
+};
+
+/// Sort the points of a planar convex polygon counterclockwise around u x v.
+void sortPolygon(Feature& polygon, const Vec3f& u, const Vec3f& v) {
+  Vec3f center(Vec3f::Zero());
+  for (std::size_t i = 0; i < polygon.size(); ++i) center += polygon[i];
+  center /= (FCL_REAL)polygon.size();
+  std::sort(polygon.begin(), polygon.end(), AngleLess(center, u, v));
+}
+
+/// Clip polygon by the prism orthogonal to normal whose section is the
+/// counterclockwise convex polygon reference (Sutherland-Hodgman).
+void clipPolygon(Feature& polygon, const Feature& reference,
+                 const Vec3f& normal) {
+  Feature input;
+  for (std::size_t i = 0; i < reference.size() && !polygon.empty(); ++i) {
+    const Vec3f& a = reference[i];
+    const Vec3f edge(reference[(i + 1) % reference.size()] - a);
+    input.swap(polygon);
+    polygon.clear();
+    for (std::size_t j = 0; j < input.size(); ++j) {
+      const Vec3f& p = input[j];
+      const Vec3f& q = input[(j + 1) % input.size()];
+      const FCL_REAL dp = edge.cross(p - a).dot(normal);
+      const FCL_REAL dq = edge.cross(q - a).dot(normal);
+      if (dp >= 0) polygon.push_back(p);
+      if ((dp >= 0) != (dq >= 0))
+        polygon.push_back(p + (q - p) * dp / (dp - dq));
+    }
+  }
+}
+
+/// Clip the segment incident by the slab orthogonal to the segment
+/// reference. Both segments must be parallel.
+/// @return false if the intersection is empty.
+bool clipSegment(Feature& incident, const Feature& reference,
+                 const Vec3f& normal) {
+  Vec3f e(reference[1] - reference[0]);
+  e -= e.dot(normal) * normal;
+  Vec3f f(incident[1] - incident[0]);
+  f -= f.dot(normal) * normal;
+  const FCL_REAL e2 = e.squaredNorm(), f2 = f.squaredNorm();
+  if (e2 == 0 || f2 == 0 ||
+      e.cross(f).squaredNorm() >
+          angular_tolerance * angular_tolerance * e2 * f2)
+    return false;
+
+  // Parameters of the points of incident along reference.
+  FCL_REAL t0 = (incident[0] - reference[0]).dot(e) / e2,
+           t1 = (incident[1] - reference[0]).dot(e) / e2;
+  const FCL_REAL lo = (std::max)((std::min)(t0, t1), (FCL_REAL)0),
+                 hi = (std::min)((std::max)(t0, t1), (FCL_REAL)1);
+  if (lo > hi) return false;
+  const Vec3f p0(incident[0]), dp(incident[1] - incident[0]);
+  const FCL_REAL dt = t1 - t0;
+  incident[0] = p0 + dp * ((lo - t0) / dt);
+  incident[1] = p0 + dp * ((hi - t0) / dt);
+  return true;
+}
+
+/// Signed area of the triangle (a, b, c) around normal.
+inline FCL_REAL signedArea(const Vec3f& a, const Vec3f& b, const Vec3f& c,
+                           const Vec3f& normal) {
+  return (b - a).cross(c - a).dot(normal);
+}
+
+/// Support value of shape s along dir, in the world frame.
+inline FCL_REAL supportValue(const ShapeBase& s, const Transform3f& tf,
+                             const Vec3f& dir) {
+  int hint = 0;
+  return tf.transform(getSupport(&s, tf.getRotation().transpose() * dir,
+                                 true, hint))
+      .dot(dir);
+}
+
+}  // namespace
+
+unsigned int computeContactManifold(const ShapeBase& s1,
+                                    const Transform3f& tf1,
+                                    const ShapeBase& s2,
+                                    const Transform3f& tf2,
+                                    const Vec3f& contact_normal,
+                                    FCL_REAL max_separation,
+                                    unsigned int max_points,
+                                    Vec3f positions[], FCL_REAL depths[]) {
+  assert(max_points <= contact_manifold_max_points);
+  if (max_points < 2) return 0;
+
+  // Not all the narrow phase algorithms orient the normal from s1 to s2: the
+  // orientation which gives the smallest overlap of the supports is chosen.
+  Vec3f normal(contact_normal);
+  if (supportValue(s1, tf1, normal) + supportValue(s2, tf2, -normal) >
+      supportValue(s1, tf1, -normal) + supportValue(s2, tf2, normal))
+    normal *= -1;
+
+  Feature f1, f2;
+  if (!supportFeature(s1, tf1, normal, f1) ||
+      !supportFeature(s2, tf2, -normal, f2))
+    return 0;
+
+  // The feature with the most points is the reference, on which the other
+  // one is clipped.
+  const bool reference_is_s1 = f1.size() >= f2.size();
+  Feature& reference = reference_is_s1 ? f1 : f2;
+  Feature& incident = reference_is_s1 ? f2 : f1;
+  if (reference.size() >= 3) {
+    Vec3f u, v;
+    generateCoordinateSystem(normal, u, v);
+    v = normal.cross(u);
+    sortPolygon(reference, u, v);
+    if (incident.size() >= 3) sortPolygon(incident, u, v);
+    clipPolygon(incident, reference, normal);
+  } else if (!clipSegment(incident, reference, normal))
+    return 0;
+
+  // Distance of the plane of the reference feature along the normal.
+  FCL_REAL offset = reference[0].dot(normal);
+  for (std::size_t i = 1; i < reference.size(); ++i) {
+    const FCL_REAL dot = reference[i].dot(normal);
+    offset =
+        reference_is_s1 ? (std::max)(offset, dot) : (std::min)(offset, dot);
+  }
+
+  // Keep the clipped points close enough to the reference feature, dropping
+  // the duplicates produced by the clipping.
+  FCL_REAL scale = 0;
+  for (std::size_t i = 1; i < reference.size(); ++i)
+    scale = (std::max)(scale, (reference[i] - reference[0]).norm());
+  const FCL_REAL eps =
+      std::sqrt(std::numeric_limits<FCL_REAL>::epsilon()) * scale;
+  Feature points;
+  std::vector<FCL_REAL> separations;
+  for (std::size_t i = 0; i < incident.size(); ++i) {
+    const Vec3f& p = incident[i];
+    const FCL_REAL separation =
+        reference_is_s1 ? p.dot(normal) - offset : offset - p.dot(normal);
+    if (separation > max_separation) continue;
+    const Vec3f position(
+        p + (reference_is_s1 ? -.5 : .5) * separation * normal);
+    bool duplicate = false;
+    for (std::size_t j = 0; j < points.size() && !duplicate; ++j)
+      duplicate = (points[j] - position).norm() <= eps;
+    if (duplicate) continue;
+    points.push_back(position);
+    separations.push_back(separation);
+  }
+  if (points.size() < 2) return 0;
+
+  if (points.size() <= max_points) {
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      positions[i] = points[i];
+      depths[i] = -separations[i];
+    }
+    return (unsigned int)points.size();
+  }
+
+  // Select the deepest point, the point the farthest from it, and then the
+  // points which add the most area to the manifold.
+  std::size_t selected[contact_manifold_max_points];
+  selected[0] = (std::size_t)(
+      std::min_element(separations.begin(), separations.end()) -
+      separations.begin());
+  FCL_REAL best = -1;
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const FCL_REAL d = (points[i] - points[selected[0]]).squaredNorm();
+    if (d > best) {
+      best = d;
+      selected[1] = i;
+    }
+  }
+  unsigned int n = 2;
+  if (max_points >= 3) {
+    const Vec3f &a = points[selected[0]], &b = points[selected[1]];
+    best = -1;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      const FCL_REAL area = std::fabs(signedArea(a, b, points[i], normal));
+      if (area > best) {
+        best = area;
+        selected[2] = i;
+      }
+    }
+    if (best > 0) ++n;
+  }
+  if (n == 3 && max_points >= 4) {
+    // Orient the triangle counterclockwise and look for the point the
+    // farthest outside of its edges.
+    if (signedArea(points[selected[0]], points[selected[1]],
+                   points[selected[2]], normal) < 0)
+      std::swap(selected[1], selected[2]);
+    best = 0;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      for (unsigned int k = 0; k < 3; ++k) {
+        const FCL_REAL area =
+            -signedArea(points[selected[k]], points[selected[(k + 1) % 3]],
+                        points[i], normal);
+        if (area > best) {
+          best = area;
+          selected[3] = i;
+        }
+      }
+    }
+    if (best > 0) ++n;
+  }
+  for (unsigned int i = 0; i < n; ++i) {
+    positions[i] = points[selected[i]];
+    depths[i] = -separations[selected[i]];
+  }
+  return n;
+}
+
+}  // namespace details
+
+}  // namespace fcl
+
+}  // namespace hpp
@@ -343,7 +343,7 @@ inline bool sphereTriangleIntersect(const Sphere& s, const Transform3f& tf1,
 
   if (projectInTriangle(P1, P2, P3, normal, center)) {
     closest_point = center - normal * distance_from_plane;
-    min_distance_sqr = distance_from_plane;
+    min_distance_sqr = distance_from_plane * distance_from_plane;
   } else {
     // Compute distance to each each and take minimal distance
     Vec3f nearest_on_edge;
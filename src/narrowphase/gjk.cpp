@@ -621,8 +621,47 @@ bool GJK::getClosestPoints(const MinkowskiDiff& shape, Vec3f& w0, Vec3f& w1) {
   return true;
 }
 
+void GJK::getPenetrationFromSimplex(Vec3f& w0, Vec3f& w1, Vec3f& normal,
+                                    FCL_REAL& depth) const {
+  depth = 0;
+  details::getClosestPoints(*simplex, w0, w1);
+  normal.setZero();
+  if (simplex->rank < 4) {
+    // The origin is on the boundary of the simplex.
+    const FCL_REAL n2 = (w1 - w0).squaredNorm();
+    if (n2 > 0) normal = (w1 - w0) / std::sqrt(n2);
+    return;
+  }
+
+  // The tetrahedron is inside the Minkowski difference, hence the distance
+  // from the origin to its boundary is a lower bound of the penetration.
+  static const int faces[4][4] = {
+      {0, 1, 2, 3}, {0, 1, 3, 2}, {0, 2, 3, 1}, {1, 2, 3, 0}};
+  FCL_REAL closest = (std::numeric_limits<FCL_REAL>::max)();
+  for (int f = 0; f < 4; ++f) {
+    const Vec3f& a = simplex->vertex[faces[f][0]]->w;
+    const Vec3f& b = simplex->vertex[faces[f][1]]->w;
+    const Vec3f& c = simplex->vertex[faces[f][2]]->w;
+    const Vec3f& d = simplex->vertex[faces[f][3]]->w;
+    Vec3f n((b - a).cross(c - a));
+    const FCL_REAL norm = n.norm();
+    if (norm == 0) continue;
+    n /= norm;
+    if (n.dot(d - a) > 0) n = -n;
+    const FCL_REAL dist = n.dot(a);
+    if (dist < closest) {
+      closest = dist;
+      normal = n;
+    }
+  }
+  if (closest < (std::numeric_limits<FCL_REAL>::max)())
+    depth = (std::max)(closest, FCL_REAL(0));
+}
+
 GJK::Status GJK::evaluate(const MinkowskiDiff& shape_, const Vec3f& guess,
                           const support_func_guess_t& supportHint) {
+  HPP_FCL_PROFILE_TIME(gjk_time);
+  HPP_FCL_PROFILE_COUNT(num_gjk_calls, 1);
   FCL_REAL alpha = 0;
   iterations = 0;
   const FCL_REAL inflation = shape_.inflation.sum();
@@ -656,6 +695,7 @@ GJK::Status GJK::evaluate(const MinkowskiDiff& shape_, const Vec3f& guess,
   FCL_REAL momentum;
   bool normalize_support_direction = shape->normalize_support_direction;
   do {
+    HPP_FCL_PROFILE_COUNT(num_gjk_iterations, 1);
     vertex_id_t next = (vertex_id_t)(1 - current);
     Simplex& curr_simplex = simplices[current];
     Simplex& next_simplex = simplices[next];
@@ -1467,8 +1507,9 @@ bool EPA::getEdgeDist(SimplexF* face, SimplexV* a, SimplexV* b,
     else if (b_dot_ab < 0)
       dist = b->w.norm();
     else {
-      dist = std::sqrt(std::max(
-          a->w.squaredNorm() - a_dot_ab * a_dot_ab / ab.squaredNorm(), 0.));
+      dist = std::sqrt(
+          std::max(a->w.squaredNorm() - a_dot_ab * a_dot_ab / ab.squaredNorm(),
+                   FCL_REAL(0)));
     }
 
     return true;
@@ -1530,6 +1571,8 @@ EPA::SimplexF* EPA::findBest() {
 }
 
 EPA::Status EPA::evaluate(GJK& gjk, const Vec3f& guess) {
+  HPP_FCL_PROFILE_TIME(epa_time);
+  HPP_FCL_PROFILE_COUNT(num_epa_calls, 1);
   GJK::Simplex& simplex = *gjk.getSimplex();
   support_func_guess_t hint(gjk.support_hint);
   if ((simplex.rank > 1) && gjk.encloseOrigin()) {
@@ -1573,6 +1616,7 @@ EPA::Status EPA::evaluate(GJK& gjk, const Vec3f& guess) {
 
       status = Valid;
       for (; iterations < max_iterations; ++iterations) {
+        HPP_FCL_PROFILE_COUNT(num_epa_iterations, 1);
         if (nextsv >= max_vertex_num) {
           status = OutOfVertices;
           break;
@@ -1621,6 +1665,7 @@ EPA::Status EPA::evaluate(GJK& gjk, const Vec3f& guess) {
   // combination describe the origin, the point in the simplex is actually
   // the origin.
   status = FallBack;
+  HPP_FCL_PROFILE_COUNT(num_epa_fallbacks, 1);
   // TODO: define a better normal
   assert(simplex.rank == 1 && simplex.vertex[0]->w.isZero(gjk.getTolerance()));
   normal = -guess;
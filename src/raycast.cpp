@@ -0,0 +1,967 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <hpp/fcl/raycast.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <hpp/fcl/BV/BV.h>
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/collision_data.h>
+#include <hpp/fcl/hfield.h>
+#include <hpp/fcl/shape/convex.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+#ifdef HPP_FCL_HAS_OCTOMAP
+#include <hpp/fcl/octree.h>
+#endif
+
+namespace hpp {
+namespace fcl {
+
+namespace details {
+
+namespace {
+
+/// Replacement of the null components of ray directions, so that slab tests
+/// never divide by zero.
+const FCL_REAL tiny = (std::numeric_limits<FCL_REAL>::min)();
+
+inline FCL_REAL safeInverse(FCL_REAL x) { return 1 / (x != 0 ? x : tiny); }
+
+/// Ray expressed in the frame of a geometry.
+struct LocalRay {
+  Vec3f origin, direction, inv_direction;
+  FCL_REAL max_distance;
+
+  LocalRay(const Ray& ray, const Transform3f& tf)
+      : origin(tf.getRotation().transpose() *
+               (ray.origin - tf.getTranslation())),
+        direction(tf.getRotation().transpose() * ray.direction),
+        max_distance(ray.max_distance) {
+    for (int i = 0; i < 3; ++i)
+      inv_direction[i] = safeInverse(direction[i]);
+  }
+
+  /// Largest distance at which a hit improves result.
+  FCL_REAL bound(const RayResult& result) const {
+    return (std::min)(max_distance, result.distance);
+  }
+};
+
+/// Record a hit in result if it is closer than the current one.
+inline void addHit(RayResult& result, FCL_REAL distance, const Vec3f& normal,
+                   int primitive_id) {
+  if (distance < result.distance) {
+    result.hit = true;
+    result.distance = distance;
+    result.normal = normal;
+    result.primitive_id = primitive_id;
+  }
+}
+
+/// Express the normal of a hit in the world frame, normalized and oriented
+/// towards the origin of the ray.
+void finalize(const Transform3f& tf, const Ray& ray, RayResult& result) {
+  if (!result.hit) return;
+  result.normal = tf.getRotation() * result.normal.normalized();
+  if (result.normal.dot(ray.direction) > 0) result.normal *= -1;
+}
+
+/// Intersection of the ray with the box [lo, hi].
+/// @return whether the ray crosses the box between 0 and t_max.
+inline bool raySlabs(const Vec3f& origin, const Vec3f& inv_direction,
+                     const Vec3f& lo, const Vec3f& hi, FCL_REAL t_max,
+                     FCL_REAL& t_enter, FCL_REAL& t_exit) {
+  const Vec3f t0((lo - origin).cwiseProduct(inv_direction));
+  const Vec3f t1((hi - origin).cwiseProduct(inv_direction));
+  t_enter = (std::max)(t0.cwiseMin(t1).maxCoeff(), FCL_REAL(0));
+  t_exit = (std::min)(t0.cwiseMax(t1).minCoeff(), t_max);
+  return t_enter <= t_exit;
+}
+
+/// Intersection of the ray with the oriented box of given axes, center and
+/// half extents.
+inline bool rayOrientedSlabs(const LocalRay& ray, const Matrix3f& axes,
+                             const Vec3f& center, const Vec3f& extent,
+                             FCL_REAL t_max, FCL_REAL& t_enter) {
+  const Vec3f origin(axes.transpose() * (ray.origin - center));
+  const Vec3f direction(axes.transpose() * ray.direction);
+  Vec3f inv_direction;
+  for (int i = 0; i < 3; ++i) inv_direction[i] = safeInverse(direction[i]);
+  FCL_REAL t_exit;
+  return raySlabs(origin, inv_direction, -extent, extent, t_max, t_enter,
+                  t_exit);
+}
+
+/// @name Ray - bounding volume tests
+/// The BV which are not boxes are bounded by a box.
+/// @{
+inline bool rayHitsBV(const LocalRay& ray, const AABB& bv, FCL_REAL t_max,
+                      FCL_REAL& t_enter) {
+  FCL_REAL t_exit;
+  return raySlabs(ray.origin, ray.inv_direction, bv.min_, bv.max_, t_max,
+                  t_enter, t_exit);
+}
+
+inline bool rayHitsBV(const LocalRay& ray, const OBB& bv, FCL_REAL t_max,
+                      FCL_REAL& t_enter) {
+  return rayOrientedSlabs(ray, bv.axes, bv.To, bv.extent, t_max, t_enter);
+}
+
+inline void boundingBox(const RSS& bv, Vec3f& center, Vec3f& extent) {
+  center = bv.Tr + bv.axes.col(0) * (bv.length[0] / 2) +
+           bv.axes.col(1) * (bv.length[1] / 2);
+  extent = Vec3f(bv.length[0] / 2 + bv.radius, bv.length[1] / 2 + bv.radius,
+                 bv.radius);
+}
+
+inline bool rayHitsBV(const LocalRay& ray, const RSS& bv, FCL_REAL t_max,
+                      FCL_REAL& t_enter) {
+  Vec3f center, extent;
+  boundingBox(bv, center, extent);
+  return rayOrientedSlabs(ray, bv.axes, center, extent, t_max, t_enter);
+}
+
+inline bool rayHitsBV(const LocalRay& ray, const kIOS& bv, FCL_REAL t_max,
+                      FCL_REAL& t_enter) {
+  return rayHitsBV(ray, bv.obb, t_max, t_enter);
+}
+
+inline bool rayHitsBV(const LocalRay& ray, const OBBRSS& bv, FCL_REAL t_max,
+                      FCL_REAL& t_enter) {
+  return rayHitsBV(ray, bv.obb, t_max, t_enter);
+}
+
+template <short N>
+inline void boundingBox(const KDOP<N>& bv, Vec3f& lo, Vec3f& hi) {
+  for (short i = 0; i < 3; ++i) {
+    lo[i] = bv.dist(i);
+    hi[i] = bv.dist((short)(N / 2 + i));
+  }
+}
+
+template <short N>
+inline bool rayHitsBV(const LocalRay& ray, const KDOP<N>& bv, FCL_REAL t_max,
+                      FCL_REAL& t_enter) {
+  Vec3f lo, hi;
+  boundingBox(bv, lo, hi);
+  FCL_REAL t_exit;
+  return raySlabs(ray.origin, ray.inv_direction, lo, hi, t_max, t_enter,
+                  t_exit);
+}
+/// @}
+
+/// Möller-Trumbore intersection of a ray and a triangle.
+/// @param[out] normal unnormalized normal of the triangle.
+inline bool rayHitsTriangle(const Vec3f& origin, const Vec3f& direction,
+                            const Vec3f& a, const Vec3f& b, const Vec3f& c,
+                            FCL_REAL t_max, FCL_REAL& t, Vec3f& normal) {
+  const Vec3f e1(b - a), e2(c - a);
+  const Vec3f p(direction.cross(e2));
+  const FCL_REAL det = e1.dot(p);
+  if (det == 0) return false;
+  const FCL_REAL inv_det = 1 / det;
+  const Vec3f s(origin - a);
+  const FCL_REAL u = s.dot(p) * inv_det;
+  if (u < 0 || u > 1) return false;
+  const Vec3f q(s.cross(e1));
+  const FCL_REAL v = direction.dot(q) * inv_det;
+  if (v < 0 || u + v > 1) return false;
+  t = e2.dot(q) * inv_det;
+  if (t < 0 || t > t_max) return false;
+  normal = e1.cross(e2);
+  return true;
+}
+
+/// Roots of a t^2 + 2 b t + c, in increasing order.
+/// @return the number of roots.
+inline int solveQuadratic(FCL_REAL a, FCL_REAL b, FCL_REAL c,
+                          FCL_REAL roots[2]) {
+  if (a == 0) {
+    if (b == 0) return 0;
+    roots[0] = -c / (2 * b);
+    return 1;
+  }
+  const FCL_REAL discriminant = b * b - a * c;
+  if (discriminant < 0) return 0;
+  const FCL_REAL sqrt_discriminant = std::sqrt(discriminant);
+  // Numerically stable form of the roots.
+  const FCL_REAL q = -(b + (b >= 0 ? sqrt_discriminant : -sqrt_discriminant));
+  if (q == 0) {
+    roots[0] = roots[1] = 0;
+    return 2;
+  }
+  roots[0] = q / a;
+  roots[1] = c / q;
+  if (roots[0] > roots[1]) std::swap(roots[0], roots[1]);
+  return 2;
+}
+
+/// Add the hits of the ray with the quadric lateral surface of a shape of
+/// revolution around z, whose height lies in [z_min, z_max].
+/// The quadric is x^2 + y^2 - (k (h - z))^2 = 0, or x^2 + y^2 - r^2 = 0 when
+/// k = 0 and h is the radius.
+inline void rayRevolutionSurface(const LocalRay& ray, FCL_REAL k, FCL_REAL h,
+                                 FCL_REAL z_min, FCL_REAL z_max,
+                                 FCL_REAL t_max, RayResult& result) {
+  const Vec3f &o = ray.origin, &d = ray.direction;
+  const FCL_REAL k2 = k * k;
+  FCL_REAL a, b, c;
+  if (k == 0) {
+    a = d[0] * d[0] + d[1] * d[1];
+    b = o[0] * d[0] + o[1] * d[1];
+    c = o[0] * o[0] + o[1] * o[1] - h * h;
+  } else {
+    a = d[0] * d[0] + d[1] * d[1] - k2 * d[2] * d[2];
+    b = o[0] * d[0] + o[1] * d[1] + k2 * (h - o[2]) * d[2];
+    c = o[0] * o[0] + o[1] * o[1] - k2 * (h - o[2]) * (h - o[2]);
+  }
+  FCL_REAL roots[2];
+  const int n = solveQuadratic(a, b, c, roots);
+  for (int i = 0; i < n; ++i) {
+    const FCL_REAL t = roots[i];
+    if (t < 0 || t > t_max) continue;
+    const Vec3f p(o + t * d);
+    if (p[2] < z_min || p[2] > z_max) continue;
+    addHit(result, t, Vec3f(p[0], p[1], k2 * (h - p[2])), Contact::NONE);
+  }
+}
+
+/// Add the hits of the ray with the sphere of given center and radius, on
+/// the side of the plane z = z_limit given by sign.
+inline void raySphere(const LocalRay& ray, const Vec3f& center,
+                      FCL_REAL radius, FCL_REAL z_limit, FCL_REAL sign,
+                      FCL_REAL t_max, RayResult& result) {
+  const Vec3f o(ray.origin - center);
+  FCL_REAL roots[2];
+  const int n = solveQuadratic(1, o.dot(ray.direction),
+                               o.squaredNorm() - radius * radius, roots);
+  for (int i = 0; i < n; ++i) {
+    const FCL_REAL t = roots[i];
+    if (t < 0 || t > t_max) continue;
+    const Vec3f p(ray.origin + t * ray.direction);
+    if (sign * (p[2] - z_limit) < 0) continue;
+    addHit(result, t, p - center, Contact::NONE);
+  }
+}
+
+/// Add the hit of the ray with the disk of given radius in the plane z.
+inline void rayDisk(const LocalRay& ray, FCL_REAL z, FCL_REAL radius,
+                    FCL_REAL t_max, RayResult& result) {
+  if (ray.direction[2] == 0) return;
+  const FCL_REAL t = (z - ray.origin[2]) / ray.direction[2];
+  if (t < 0 || t > t_max) return;
+  const Vec3f p(ray.origin + t * ray.direction);
+  if (p[0] * p[0] + p[1] * p[1] > radius * radius) return;
+  addHit(result, t, Vec3f::UnitZ(), Contact::NONE);
+}
+
+/// @name Ray casting on shapes, in the frame of the shape.
+/// @{
+void raycastShape(const LocalRay& ray, const Box& box, RayResult& result) {
+  const Vec3f t0((-box.halfSide - ray.origin).cwiseProduct(ray.inv_direction));
+  const Vec3f t1((box.halfSide - ray.origin).cwiseProduct(ray.inv_direction));
+  const Vec3f t_near(t0.cwiseMin(t1)), t_far(t0.cwiseMax(t1));
+  Eigen::Index i_near, i_far;
+  const FCL_REAL t_enter = t_near.maxCoeff(&i_near);
+  const FCL_REAL t_exit = t_far.minCoeff(&i_far);
+  if (t_enter > t_exit) return;
+  // When the origin is inside the box, the ray hits the face it leaves by.
+  const bool inside = t_enter < 0;
+  const FCL_REAL t = inside ? t_exit : t_enter;
+  if (t < 0 || t > ray.bound(result)) return;
+  addHit(result, t, Vec3f::Unit(inside ? i_far : i_near), Contact::NONE);
+}
+
+void raycastShape(const LocalRay& ray, const Sphere& sphere,
+                  RayResult& result) {
+  raySphere(ray, Vec3f::Zero(), sphere.radius,
+            -std::numeric_limits<FCL_REAL>::infinity(), 1, ray.bound(result),
+            result);
+}
+
+void raycastShape(const LocalRay& ray, const Ellipsoid& ellipsoid,
+                  RayResult& result) {
+  // The ellipsoid is the unit sphere in the frame scaled by its radii.
+  const Vec3f o(ray.origin.cwiseQuotient(ellipsoid.radii));
+  const Vec3f d(ray.direction.cwiseQuotient(ellipsoid.radii));
+  FCL_REAL roots[2];
+  const int n = solveQuadratic(d.squaredNorm(), o.dot(d), o.squaredNorm() - 1,
+                               roots);
+  const FCL_REAL t_max = ray.bound(result);
+  for (int i = 0; i < n; ++i) {
+    const FCL_REAL t = roots[i];
+    if (t < 0 || t > t_max) continue;
+    const Vec3f p(ray.origin + t * ray.direction);
+    addHit(result, t, p.cwiseQuotient(ellipsoid.radii.cwiseAbs2()),
+           Contact::NONE);
+    break;
+  }
+}
+
+void raycastShape(const LocalRay& ray, const Capsule& capsule,
+                  RayResult& result) {
+  const FCL_REAL t_max = ray.bound(result);
+  const FCL_REAL h = capsule.halfLength;
+  rayRevolutionSurface(ray, 0, capsule.radius, -h, h, t_max, result);
+  raySphere(ray, Vec3f(0, 0, h), capsule.radius, h, 1, ray.bound(result),
+            result);
+  raySphere(ray, Vec3f(0, 0, -h), capsule.radius, -h, -1, ray.bound(result),
+            result);
+}
+
+void raycastShape(const LocalRay& ray, const Cylinder& cylinder,
+                  RayResult& result) {
+  const FCL_REAL h = cylinder.halfLength;
+  rayRevolutionSurface(ray, 0, cylinder.radius, -h, h, ray.bound(result),
+                       result);
+  rayDisk(ray, h, cylinder.radius, ray.bound(result), result);
+  rayDisk(ray, -h, cylinder.radius, ray.bound(result), result);
+}
+
+void raycastShape(const LocalRay& ray, const Cone& cone, RayResult& result) {
+  // The radius of the cone decreases linearly from its base at z = -h to its
+  // apex at z = h.
+  const FCL_REAL h = cone.halfLength;
+  rayRevolutionSurface(ray, cone.radius / (2 * h), h, -h, h,
+                       ray.bound(result), result);
+  rayDisk(ray, -h, cone.radius, ray.bound(result), result);
+}
+
+void raycastShape(const LocalRay& ray, const Plane& plane, RayResult& result) {
+  const FCL_REAL denominator = plane.n.dot(ray.direction);
+  if (denominator == 0) return;
+  const FCL_REAL t = (plane.d - plane.n.dot(ray.origin)) / denominator;
+  if (t < 0 || t > ray.bound(result)) return;
+  addHit(result, t, plane.n, Contact::NONE);
+}
+
+void raycastShape(const LocalRay& ray, const Halfspace& halfspace,
+                  RayResult& result) {
+  raycastShape(ray, Plane(halfspace.n, halfspace.d), result);
+}
+
+void raycastShape(const LocalRay& ray, const TriangleP& triangle,
+                  RayResult& result) {
+  FCL_REAL t;
+  Vec3f normal;
+  if (rayHitsTriangle(ray.origin, ray.direction, triangle.a, triangle.b,
+                      triangle.c, ray.bound(result), t, normal))
+    addHit(result, t, normal, Contact::NONE);
+}
+
+template <typename PolygonT>
+void raycastShape(const LocalRay& ray, const Convex<PolygonT>& convex,
+                  RayResult& result) {
+  const Vec3f* points = convex.points;
+  for (unsigned int i = 0; i < convex.num_polygons; ++i) {
+    const PolygonT& polygon = convex.polygons[i];
+    for (typename PolygonT::size_type j = 1; j + 1 < polygon.size(); ++j) {
+      FCL_REAL t;
+      Vec3f normal;
+      if (rayHitsTriangle(ray.origin, ray.direction, points[polygon[0]],
+                          points[polygon[j]], points[polygon[j + 1]],
+                          ray.bound(result), t, normal))
+        addHit(result, t, normal, Contact::NONE);
+    }
+  }
+}
+
+void raycastShape(const LocalRay& ray, const ConvexBase& convex,
+                  RayResult& result) {
+  if (const Convex<Triangle>* c =
+          dynamic_cast<const Convex<Triangle>*>(&convex))
+    raycastShape(ray, *c, result);
+  else if (const Convex<Quadrilateral>* c =
+               dynamic_cast<const Convex<Quadrilateral>*>(&convex))
+    raycastShape(ray, *c, result);
+  else
+    HPP_FCL_THROW_PRETTY("raycast requires the polygons of the convex shape.",
+                         std::invalid_argument);
+}
+/// @}
+
+template <typename BV>
+void checkModel(const BVHModel<BV>& model) {
+  if (model.getModelType() != BVH_MODEL_TRIANGLES)
+    HPP_FCL_THROW_PRETTY("raycast only supports BVHModel of triangles.",
+                         std::invalid_argument);
+}
+
+/// Ray casting on a BVHModel, closest node first.
+template <typename BV>
+void raycastBVH(const LocalRay& ray, const BVHModel<BV>& model, bool any_hit,
+                RayResult& result) {
+  checkModel(model);
+  typedef std::pair<int, FCL_REAL> StackEntry;
+  std::vector<StackEntry> stack;
+  stack.reserve(64);
+
+  FCL_REAL t_enter;
+  if (!rayHitsBV(ray, model.getBV(0).bv, ray.bound(result), t_enter)) return;
+  stack.push_back(StackEntry(0, t_enter));
+  while (!stack.empty()) {
+    const StackEntry entry = stack.back();
+    stack.pop_back();
+    if (entry.second > ray.bound(result)) continue;
+
+    const BVNode<BV>& node = model.getBV(entry.first);
+    if (node.isLeaf()) {
+      const Triangle& tri = model.tri_indices[node.primitiveId()];
+      FCL_REAL t;
+      Vec3f normal;
+      if (rayHitsTriangle(ray.origin, ray.direction, model.vertices[tri[0]],
+                          model.vertices[tri[1]], model.vertices[tri[2]],
+                          ray.bound(result), t, normal)) {
+        addHit(result, t, normal, node.primitiveId());
+        if (any_hit) return;
+      }
+      continue;
+    }
+
+    const int children[2] = {node.leftChild(), node.rightChild()};
+    FCL_REAL t_children[2];
+    bool hits[2];
+    for (int k = 0; k < 2; ++k)
+      hits[k] = rayHitsBV(ray, model.getBV(children[k]).bv, ray.bound(result),
+                          t_children[k]);
+    // Push the farthest child first so that the closest one is visited first.
+    const int first = (hits[0] && hits[1] && t_children[1] < t_children[0]);
+    if (hits[1 - first])
+      stack.push_back(StackEntry(children[1 - first], t_children[1 - first]));
+    if (hits[first])
+      stack.push_back(StackEntry(children[first], t_children[first]));
+  }
+}
+
+/// Packet of N rays traversing a BVHModel together. The slab tests of the
+/// bounding volumes are evaluated on all the rays of the packet at once.
+template <int N>
+struct RayPacket {
+  typedef Eigen::Array<FCL_REAL, N, 1> Array;
+  typedef Eigen::Array<bool, N, 1> Mask;
+
+  Array origin[3], direction[3], inv_direction[3];
+  /// Largest distance at which a hit improves the result of each ray.
+  Array t_max;
+  /// Rays which still look for a hit.
+  Mask active;
+
+  /// Slab test against the box [lo, hi] in the frame of the rays.
+  Mask hitsBox(const Vec3f& lo, const Vec3f& hi, Array& t_enter) const {
+    return hitsBox(origin, inv_direction, lo, hi, t_enter);
+  }
+
+  Mask hitsBox(const Array o[3], const Array inv_d[3], const Vec3f& lo,
+               const Vec3f& hi, Array& t_enter) const {
+    t_enter.setZero();
+    Array t_exit(t_max);
+    for (int i = 0; i < 3; ++i) {
+      const Array t0((lo[i] - o[i]) * inv_d[i]), t1((hi[i] - o[i]) * inv_d[i]);
+      t_enter = t_enter.max(t0.min(t1));
+      t_exit = t_exit.min(t0.max(t1));
+    }
+    return active && (t_enter <= t_exit);
+  }
+
+  /// Slab test against an oriented box.
+  Mask hitsOrientedBox(const Matrix3f& axes, const Vec3f& center,
+                       const Vec3f& extent, Array& t_enter) const {
+    Array o[3], inv_d[3];
+    for (int i = 0; i < 3; ++i) {
+      const Vec3f axis(axes.col(i));
+      o[i] = axis[0] * (origin[0] - center[0]) +
+             axis[1] * (origin[1] - center[1]) +
+             axis[2] * (origin[2] - center[2]);
+      const Array d(axis[0] * direction[0] + axis[1] * direction[1] +
+                    axis[2] * direction[2]);
+      inv_d[i] = (d == 0).select(Array::Constant(tiny), d).inverse();
+    }
+    return hitsBox(o, inv_d, -extent, extent, t_enter);
+  }
+
+  Mask hitsBV(const AABB& bv, Array& t_enter) const {
+    return hitsBox(bv.min_, bv.max_, t_enter);
+  }
+  Mask hitsBV(const OBB& bv, Array& t_enter) const {
+    return hitsOrientedBox(bv.axes, bv.To, bv.extent, t_enter);
+  }
+  Mask hitsBV(const RSS& bv, Array& t_enter) const {
+    Vec3f center, extent;
+    boundingBox(bv, center, extent);
+    return hitsOrientedBox(bv.axes, center, extent, t_enter);
+  }
+  Mask hitsBV(const kIOS& bv, Array& t_enter) const {
+    return hitsBV(bv.obb, t_enter);
+  }
+  Mask hitsBV(const OBBRSS& bv, Array& t_enter) const {
+    return hitsBV(bv.obb, t_enter);
+  }
+  template <short K>
+  Mask hitsBV(const KDOP<K>& bv, Array& t_enter) const {
+    Vec3f lo, hi;
+    boundingBox(bv, lo, hi);
+    return hitsBox(lo, hi, t_enter);
+  }
+
+  /// Möller-Trumbore test of all the active rays against a triangle.
+  Mask hitsTriangle(const Vec3f& a, const Vec3f& b, const Vec3f& c,
+                    Array& t) const {
+    const Vec3f e1(b - a), e2(c - a);
+    const Array p0(direction[1] * e2[2] - direction[2] * e2[1]);
+    const Array p1(direction[2] * e2[0] - direction[0] * e2[2]);
+    const Array p2(direction[0] * e2[1] - direction[1] * e2[0]);
+    const Array det(e1[0] * p0 + e1[1] * p1 + e1[2] * p2);
+    const Array inv_det(det.inverse());
+    const Array s0(origin[0] - a[0]), s1(origin[1] - a[1]),
+        s2(origin[2] - a[2]);
+    const Array u((s0 * p0 + s1 * p1 + s2 * p2) * inv_det);
+    const Array q0(s1 * e1[2] - s2 * e1[1]), q1(s2 * e1[0] - s0 * e1[2]),
+        q2(s0 * e1[1] - s1 * e1[0]);
+    const Array v((direction[0] * q0 + direction[1] * q1 + direction[2] * q2) *
+                  inv_det);
+    t = (e2[0] * q0 + e2[1] * q1 + e2[2] * q2) * inv_det;
+    return active && (det != 0) && (u >= 0) && (u <= 1) && (v >= 0) &&
+           (u + v <= 1) && (t >= 0) && (t <= t_max);
+  }
+};
+
+template <int N, typename BV>
+void raycastBVHPacket(const BVHModel<BV>& model, const Transform3f& tf,
+                      const Ray* rays, int num_rays, bool any_hit,
+                      RayResult* results) {
+  typedef RayPacket<N> Packet;
+  typedef typename Packet::Array Array;
+  typedef typename Packet::Mask Mask;
+
+  Packet packet;
+  packet.active.setConstant(false);
+  for (int j = 0; j < num_rays; ++j) {
+    const LocalRay ray(rays[j], tf);
+    for (int i = 0; i < 3; ++i) {
+      packet.origin[i][j] = ray.origin[i];
+      packet.direction[i][j] = ray.direction[i];
+      packet.inv_direction[i][j] = ray.inv_direction[i];
+    }
+    packet.t_max[j] = ray.bound(results[j]);
+    packet.active[j] = true;
+  }
+  // Unused lanes trace a copy of the first ray.
+  for (int j = num_rays; j < N; ++j) {
+    for (int i = 0; i < 3; ++i) {
+      packet.origin[i][j] = packet.origin[i][0];
+      packet.direction[i][j] = packet.direction[i][0];
+      packet.inv_direction[i][j] = packet.inv_direction[i][0];
+    }
+    packet.t_max[j] = -1;
+  }
+
+  typedef std::pair<int, FCL_REAL> StackEntry;
+  std::vector<StackEntry> stack;
+  stack.reserve(64);
+
+  Array t_enter;
+  Mask hits(packet.hitsBV(model.getBV(0).bv, t_enter));
+  if (!hits.any()) return;
+  stack.push_back(StackEntry(
+      0, hits.select(t_enter, std::numeric_limits<FCL_REAL>::infinity())
+             .minCoeff()));
+  while (!stack.empty()) {
+    const StackEntry entry = stack.back();
+    stack.pop_back();
+    if (entry.second > packet.active.select(packet.t_max, -1).maxCoeff())
+      continue;
+
+    const BVNode<BV>& node = model.getBV(entry.first);
+    if (node.isLeaf()) {
+      const Triangle& tri = model.tri_indices[node.primitiveId()];
+      const Vec3f &a = model.vertices[tri[0]], &b = model.vertices[tri[1]],
+                  &c = model.vertices[tri[2]];
+      Array t;
+      const Mask hit_triangle(packet.hitsTriangle(a, b, c, t));
+      if (!hit_triangle.any()) continue;
+      const Vec3f normal((b - a).cross(c - a));
+      for (int j = 0; j < num_rays; ++j) {
+        if (!hit_triangle[j]) continue;
+        addHit(results[j], t[j], normal, node.primitiveId());
+        packet.t_max[j] = t[j];
+        if (any_hit) packet.active[j] = false;
+      }
+      if (!packet.active.any()) return;
+      continue;
+    }
+
+    const int children[2] = {node.leftChild(), node.rightChild()};
+    FCL_REAL t_children[2];
+    bool hit_children[2];
+    for (int k = 0; k < 2; ++k) {
+      hits = packet.hitsBV(model.getBV(children[k]).bv, t_enter);
+      hit_children[k] = hits.any();
+      if (hit_children[k])
+        t_children[k] =
+            hits.select(t_enter, std::numeric_limits<FCL_REAL>::infinity())
+                .minCoeff();
+    }
+    const int first =
+        (hit_children[0] && hit_children[1] && t_children[1] < t_children[0]);
+    if (hit_children[1 - first])
+      stack.push_back(StackEntry(children[1 - first], t_children[1 - first]));
+    if (hit_children[first])
+      stack.push_back(StackEntry(children[first], t_children[first]));
+  }
+}
+
+template <typename BV>
+void raycastBVHPackets(const BVHModel<BV>& model, const Transform3f& tf,
+                       const Ray* rays, std::size_t num_rays,
+                       const RayRequest& request, RayResult* results) {
+  checkModel(model);
+  const bool any_hit = request.mode == RAY_ANY_HIT;
+  const std::size_t packet_size = request.packet_size;
+  for (std::size_t i = 0; i < num_rays; i += packet_size) {
+    const int n = (int)(std::min)(packet_size, num_rays - i);
+    if (packet_size == 8)
+      raycastBVHPacket<8>(model, tf, rays + i, n, any_hit, results + i);
+    else
+      raycastBVHPacket<4>(model, tf, rays + i, n, any_hit, results + i);
+  }
+}
+
+/// Ray casting on the surface of a height field, by walking through the
+/// cells crossed by the projection of the ray on the grid.
+template <typename BV>
+void raycastHeightField(const LocalRay& ray, const HeightField<BV>& hfield,
+                        bool any_hit, RayResult& result) {
+  const MatrixXf& heights = hfield.getHeights();
+  const VecXf& x_grid = hfield.getXGrid();
+  const VecXf& y_grid = hfield.getYGrid();
+  const Eigen::DenseIndex num_cols = heights.cols(), num_rows = heights.rows();
+
+  // The x grid is increasing and the y grid decreasing.
+  const Vec3f lo(x_grid[0], y_grid[num_rows - 1], hfield.getMinHeight());
+  const Vec3f hi(x_grid[num_cols - 1], y_grid[0], hfield.getMaxHeight());
+  FCL_REAL t_enter, t_exit;
+  if (!raySlabs(ray.origin, ray.inv_direction, lo, hi, ray.bound(result),
+                t_enter, t_exit))
+    return;
+
+  // Coordinates of the ray in the grid, in cells.
+  const FCL_REAL cell_x = (hi[0] - lo[0]) / FCL_REAL(num_cols - 1);
+  const FCL_REAL cell_y = (hi[1] - lo[1]) / FCL_REAL(num_rows - 1);
+  const Vec3f start(ray.origin + t_enter * ray.direction);
+  const FCL_REAL u = (start[0] - lo[0]) / cell_x,
+                 v = (hi[1] - start[1]) / cell_y;
+  const FCL_REAL du = ray.direction[0] / cell_x,
+                 dv = -ray.direction[1] / cell_y;
+  Eigen::DenseIndex col = (std::min)(
+      (std::max)((Eigen::DenseIndex)std::floor(u), (Eigen::DenseIndex)0),
+      num_cols - 2);
+  Eigen::DenseIndex row = (std::min)(
+      (std::max)((Eigen::DenseIndex)std::floor(v), (Eigen::DenseIndex)0),
+      num_rows - 2);
+  const FCL_REAL inf = std::numeric_limits<FCL_REAL>::infinity();
+  const Eigen::DenseIndex step_col = (du > 0) ? 1 : -1,
+                          step_row = (dv > 0) ? 1 : -1;
+  const FCL_REAL delta_col = (du != 0) ? 1 / std::fabs(du) : inf,
+                 delta_row = (dv != 0) ? 1 / std::fabs(dv) : inf;
+  FCL_REAL next_col =
+      (du != 0) ? t_enter + (FCL_REAL(col + (du > 0)) - u) / du : inf;
+  FCL_REAL next_row =
+      (dv != 0) ? t_enter + (FCL_REAL(row + (dv > 0)) - v) / dv : inf;
+
+  FCL_REAL t_cell = t_enter;
+  while (true) {
+    const FCL_REAL t_cell_exit = (std::min)((std::min)(next_col, next_row),
+                                            t_exit);
+    // Skip the cells which the ray crosses above their highest point.
+    const Eigen::Block<const MatrixXf, 2, 2> cell =
+        heights.block<2, 2>(row, col);
+    const FCL_REAL z_min =
+        (std::min)(ray.origin[2] + t_cell * ray.direction[2],
+                   ray.origin[2] + t_cell_exit * ray.direction[2]);
+    if (z_min <= cell.maxCoeff()) {
+      const FCL_REAL x0 = x_grid[col], x1 = x_grid[col + 1], y0 = y_grid[row],
+                     y1 = y_grid[row + 1];
+      const Vec3f p00(x0, y0, cell(0, 0)), p10(x0, y1, cell(1, 0)),
+          p11(x1, y1, cell(1, 1)), p01(x1, y0, cell(0, 1));
+      const int id = (int)(row * (num_cols - 1) + col);
+      FCL_REAL t;
+      Vec3f normal;
+      if (rayHitsTriangle(ray.origin, ray.direction, p00, p10, p01,
+                          ray.bound(result), t, normal))
+        addHit(result, t, normal, id);
+      if (rayHitsTriangle(ray.origin, ray.direction, p10, p11, p01,
+                          ray.bound(result), t, normal))
+        addHit(result, t, normal, id);
+      // The cells are visited in the order of the ray.
+      if (result.hit && (any_hit || result.distance <= t_cell_exit)) return;
+    }
+    if (t_cell_exit >= t_exit) return;
+    if (next_col < next_row) {
+      col += step_col;
+      next_col += delta_col;
+      if (col < 0 || col > num_cols - 2) return;
+    } else {
+      row += step_row;
+      next_row += delta_row;
+      if (row < 0 || row > num_rows - 2) return;
+    }
+    t_cell = t_cell_exit;
+  }
+}
+
+#ifdef HPP_FCL_HAS_OCTOMAP
+/// Ray casting on the occupied leaves of an octree, closest child first.
+/// @return whether the traversal can stop.
+bool raycastOcTree(const LocalRay& ray, const OcTree& tree,
+                   const OcTree::OcTreeNode* node, const AABB& bv,
+                   bool any_hit, RayResult& result) {
+  if (!tree.nodeHasChildren(node)) {
+    if (!tree.isNodeOccupied(node)) return false;
+    const Box box(bv.max_ - bv.min_);
+    const Vec3f center(bv.center());
+    LocalRay box_ray(ray);
+    box_ray.origin -= center;
+    raycastShape(box_ray, box, result);
+    return any_hit && result.hit;
+  }
+
+  typedef std::pair<FCL_REAL, unsigned int> Child;
+  Child children[8];
+  AABB child_bvs[8];
+  int num_children = 0;
+  for (unsigned int i = 0; i < 8; ++i) {
+    if (!tree.nodeChildExists(node, i)) continue;
+    computeChildBV(bv, i, child_bvs[i]);
+    FCL_REAL t_enter;
+    if (rayHitsBV(ray, child_bvs[i], ray.bound(result), t_enter))
+      children[num_children++] = Child(t_enter, i);
+  }
+  std::sort(children, children + num_children);
+  for (int k = 0; k < num_children; ++k) {
+    if (children[k].first > ray.bound(result)) break;
+    const unsigned int i = children[k].second;
+    if (raycastOcTree(ray, tree, tree.getNodeChild(node, i), child_bvs[i],
+                      any_hit, result))
+      return true;
+  }
+  return false;
+}
+
+void raycastOcTree(const LocalRay& ray, const OcTree& tree, bool any_hit,
+                   RayResult& result) {
+  const OcTree::OcTreeNode* root = tree.getRoot();
+  if (!root) return;
+  const AABB root_bv(tree.getRootBV());
+  FCL_REAL t_enter;
+  if (!rayHitsBV(ray, root_bv, ray.bound(result), t_enter)) return;
+  raycastOcTree(ray, tree, root, root_bv, any_hit, result);
+}
+#endif
+
+/// Ray casting in the frame of the geometry.
+void raycastLocal(const LocalRay& ray, const CollisionGeometry* geom,
+                  const RayRequest& request, RayResult& result) {
+  const bool any_hit = request.mode == RAY_ANY_HIT;
+  switch (geom->getNodeType()) {
+    case BV_AABB:
+      raycastBVH(ray, *static_cast<const BVHModel<AABB>*>(geom), any_hit,
+                 result);
+      break;
+    case BV_OBB:
+      raycastBVH(ray, *static_cast<const BVHModel<OBB>*>(geom), any_hit,
+                 result);
+      break;
+    case BV_RSS:
+      raycastBVH(ray, *static_cast<const BVHModel<RSS>*>(geom), any_hit,
+                 result);
+      break;
+    case BV_kIOS:
+      raycastBVH(ray, *static_cast<const BVHModel<kIOS>*>(geom), any_hit,
+                 result);
+      break;
+    case BV_OBBRSS:
+      raycastBVH(ray, *static_cast<const BVHModel<OBBRSS>*>(geom), any_hit,
+                 result);
+      break;
+    case BV_KDOP16:
+      raycastBVH(ray, *static_cast<const BVHModel<KDOP<16> >*>(geom), any_hit,
+                 result);
+      break;
+    case BV_KDOP18:
+      raycastBVH(ray, *static_cast<const BVHModel<KDOP<18> >*>(geom), any_hit,
+                 result);
+      break;
+    case BV_KDOP24:
+      raycastBVH(ray, *static_cast<const BVHModel<KDOP<24> >*>(geom), any_hit,
+                 result);
+      break;
+    case HF_AABB:
+      raycastHeightField(ray, *static_cast<const HeightField<AABB>*>(geom),
+                         any_hit, result);
+      break;
+    case HF_OBBRSS:
+      raycastHeightField(ray, *static_cast<const HeightField<OBBRSS>*>(geom),
+                         any_hit, result);
+      break;
+#ifdef HPP_FCL_HAS_OCTOMAP
+    case GEOM_OCTREE:
+      raycastOcTree(ray, *static_cast<const OcTree*>(geom), any_hit, result);
+      break;
+#endif
+    case GEOM_BOX:
+      raycastShape(ray, *static_cast<const Box*>(geom), result);
+      break;
+    case GEOM_SPHERE:
+      raycastShape(ray, *static_cast<const Sphere*>(geom), result);
+      break;
+    case GEOM_ELLIPSOID:
+      raycastShape(ray, *static_cast<const Ellipsoid*>(geom), result);
+      break;
+    case GEOM_CAPSULE:
+      raycastShape(ray, *static_cast<const Capsule*>(geom), result);
+      break;
+    case GEOM_CONE:
+      raycastShape(ray, *static_cast<const Cone*>(geom), result);
+      break;
+    case GEOM_CYLINDER:
+      raycastShape(ray, *static_cast<const Cylinder*>(geom), result);
+      break;
+    case GEOM_CONVEX:
+      raycastShape(ray, *static_cast<const ConvexBase*>(geom), result);
+      break;
+    case GEOM_PLANE:
+      raycastShape(ray, *static_cast<const Plane*>(geom), result);
+      break;
+    case GEOM_HALFSPACE:
+      raycastShape(ray, *static_cast<const Halfspace*>(geom), result);
+      break;
+    case GEOM_TRIANGLE:
+      raycastShape(ray, *static_cast<const TriangleP*>(geom), result);
+      break;
+    default:
+      HPP_FCL_THROW_PRETTY("raycast does not support geometries of node type "
+                               << geom->getNodeType() << ".",
+                           std::invalid_argument);
+  }
+}
+
+}  // namespace
+
+}  // namespace details
+
+bool raycast(const CollisionGeometry* geom, const Transform3f& tf,
+             const Ray& ray, const RayRequest& request, RayResult& result) {
+  result.clear();
+  details::raycastLocal(details::LocalRay(ray, tf), geom, request, result);
+  details::finalize(tf, ray, result);
+  return result.hit;
+}
+
+bool raycast(const CollisionObject* o, const Ray& ray,
+             const RayRequest& request, RayResult& result) {
+  return raycast(o->collisionGeometry().get(), o->getTransform(), ray, request,
+                 result);
+}
+
+std::size_t raycast(const CollisionGeometry* geom, const Transform3f& tf,
+                    const Ray* rays, std::size_t num_rays,
+                    const RayRequest& request, RayResult* results) {
+  if (request.packet_size != 1 && request.packet_size != 4 &&
+      request.packet_size != 8)
+    HPP_FCL_THROW_PRETTY("the packet size must be 1, 4 or 8.",
+                         std::invalid_argument);
+  for (std::size_t i = 0; i < num_rays; ++i) results[i].clear();
+
+  const NODE_TYPE node_type = geom->getNodeType();
+  if (request.packet_size > 1 && geom->getObjectType() == OT_BVH) {
+    switch (node_type) {
+      case BV_AABB:
+        details::raycastBVHPackets(*static_cast<const BVHModel<AABB>*>(geom),
+                                   tf, rays, num_rays, request, results);
+        break;
+      case BV_OBB:
+        details::raycastBVHPackets(*static_cast<const BVHModel<OBB>*>(geom),
+                                   tf, rays, num_rays, request, results);
+        break;
+      case BV_RSS:
+        details::raycastBVHPackets(*static_cast<const BVHModel<RSS>*>(geom),
+                                   tf, rays, num_rays, request, results);
+        break;
+      case BV_kIOS:
+        details::raycastBVHPackets(*static_cast<const BVHModel<kIOS>*>(geom),
+                                   tf, rays, num_rays, request, results);
+        break;
+      case BV_OBBRSS:
+        details::raycastBVHPackets(
+            *static_cast<const BVHModel<OBBRSS>*>(geom), tf, rays, num_rays,
+            request, results);
+        break;
+      case BV_KDOP16:
+        details::raycastBVHPackets(
+            *static_cast<const BVHModel<KDOP<16> >*>(geom), tf, rays,
+            num_rays, request, results);
+        break;
+      case BV_KDOP18:
+        details::raycastBVHPackets(
+            *static_cast<const BVHModel<KDOP<18> >*>(geom), tf, rays,
+            num_rays, request, results);
+        break;
+      case BV_KDOP24:
+        details::raycastBVHPackets(
+            *static_cast<const BVHModel<KDOP<24> >*>(geom), tf, rays,
+            num_rays, request, results);
+        break;
+      default:
+        assert(false);
+    }
+  } else {
+    for (std::size_t i = 0; i < num_rays; ++i)
+      details::raycastLocal(details::LocalRay(rays[i], tf), geom, request,
+                            results[i]);
+  }
+
+  std::size_t num_hits = 0;
+  for (std::size_t i = 0; i < num_rays; ++i) {
+    details::finalize(tf, rays[i], results[i]);
+    if (results[i].hit) ++num_hits;
+  }
+  return num_hits;
+}
+
+}  // namespace fcl
+
+}  // namespace hpp
@@ -0,0 +1,477 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <hpp/fcl/sdf.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <hpp/fcl/internal/intersect.h>
+#include <hpp/fcl/internal/tools.h>
+#include <hpp/fcl/narrowphase/gjk.h>
+
+namespace hpp {
+namespace fcl {
+
+namespace details {
+
+namespace {
+
+/// Squared distance from a point to an AABB.
+FCL_REAL sqrDistance(const AABB& bv, const Vec3f& p) {
+  return (bv.min_ - p).cwiseMax(p - bv.max_).cwiseMax(0).squaredNorm();
+}
+
+/// Squared distance from a point to a triangle, possibly degenerate.
+FCL_REAL sqrDistanceToTriangle(const Vec3f& a, const Vec3f& b, const Vec3f& c,
+                               const Vec3f& p) {
+  const Project::ProjectResult res = Project::projectTriangle(a, b, c, p);
+  if (res.sqr_distance >= 0) return res.sqr_distance;
+  FCL_REAL sqr_distance = (a - p).squaredNorm();
+  const Vec3f* vertices[] = {&a, &b, &c};
+  for (int i = 0; i < 3; ++i) {
+    const Project::ProjectResult res_line =
+        Project::projectLine(*vertices[i], *vertices[(i + 1) % 3], p);
+    if (res_line.sqr_distance >= 0)
+      sqr_distance = (std::min)(sqr_distance, res_line.sqr_distance);
+  }
+  return sqr_distance;
+}
+
+/// Unsigned distance to a triangle mesh, accelerated by an AABB tree.
+class MeshDistance {
+ public:
+  MeshDistance(const BVHModelBase& model) {
+    const std::vector<Vec3f> vertices(model.vertices,
+                                      model.vertices + model.num_vertices);
+    const std::vector<Triangle> triangles(model.tri_indices,
+                                          model.tri_indices + model.num_tris);
+    tree.beginModel();
+    tree.addSubModel(vertices, triangles);
+    tree.endModel();
+  }
+
+  /// Distance from a point to the mesh, given an upper bound of it.
+  FCL_REAL operator()(const Vec3f& p, FCL_REAL upper_bound) const {
+    // Slack for the rounding errors on the upper bound.
+    const FCL_REAL bound = upper_bound * (1 + 1e-6) + 1e-12;
+    const FCL_REAL sqr_bound = bound * bound;
+    const FCL_REAL sqr_distance = sqrDistance(p, sqr_bound);
+    if (sqr_distance < sqr_bound) return std::sqrt(sqr_distance);
+    return std::sqrt(
+        sqrDistance(p, (std::numeric_limits<FCL_REAL>::max)()));
+  }
+
+ private:
+  /// Squared distance from a point to the mesh, if it is below best.
+  FCL_REAL sqrDistance(const Vec3f& p, FCL_REAL best) const {
+    stack.clear();
+    stack.push_back(0);
+    while (!stack.empty()) {
+      const BVNode<AABB>& node = tree.getBV(stack.back());
+      stack.pop_back();
+      if (details::sqrDistance(node.bv, p) >= best) continue;
+      if (node.isLeaf()) {
+        const Triangle& tri = tree.tri_indices[node.primitiveId()];
+        best = (std::min)(
+            best, sqrDistanceToTriangle(tree.vertices[tri[0]],
+                                        tree.vertices[tri[1]],
+                                        tree.vertices[tri[2]], p));
+        continue;
+      }
+      // Visit the closest child first.
+      unsigned int first = (unsigned int)node.leftChild(),
+                   second = (unsigned int)node.rightChild();
+      if (details::sqrDistance(tree.getBV(first).bv, p) >
+          details::sqrDistance(tree.getBV(second).bv, p))
+        std::swap(first, second);
+      stack.push_back(second);
+      stack.push_back(first);
+    }
+    return best;
+  }
+
+  BVHModel<AABB> tree;
+  mutable std::vector<unsigned int> stack;
+};
+
+/// Crossings of the mesh with the columns of the grid, parallel to the z
+/// axis, from which the inside of the mesh is found by ray parity.
+class ColumnCrossings {
+ public:
+  /// @param num_columns number of columns along x and y
+  ColumnCrossings(const BVHModelBase& model, const Vec3f& origin,
+                  FCL_REAL voxel_size, int num_columns_x, int num_columns_y)
+      : num_columns_y(num_columns_y),
+        crossings((std::size_t)num_columns_x * (std::size_t)num_columns_y) {
+    // The columns are shifted by an irrational fraction of a voxel, so that
+    // they do not hit the edges and vertices of the mesh which lie on the
+    // grid.
+    const FCL_REAL shift_x = 1e-4 * std::sqrt(2.),
+                   shift_y = 1e-4 * std::sqrt(3.);
+    for (unsigned int t = 0; t < model.num_tris; ++t) {
+      const Triangle& tri = model.tri_indices[t];
+      Vec3f v[3];
+      for (int k = 0; k < 3; ++k)
+        v[k] = (model.vertices[tri[k]] - origin) / voxel_size -
+               Vec3f(shift_x, shift_y, 0);
+      // Twice the signed area of the projection of the triangle on the xy
+      // plane.
+      const FCL_REAL area = cross2(v[1] - v[0], v[2] - v[0]);
+      if (area == 0) continue;
+      const int i_min = (std::max)(
+          0, (int)std::ceil((std::min)(v[0][0], (std::min)(v[1][0], v[2][0]))));
+      const int i_max = (std::min)(
+          num_columns_x - 1,
+          (int)std::floor((std::max)(v[0][0], (std::max)(v[1][0], v[2][0]))));
+      const int j_min = (std::max)(
+          0, (int)std::ceil((std::min)(v[0][1], (std::min)(v[1][1], v[2][1]))));
+      const int j_max = (std::min)(
+          num_columns_y - 1,
+          (int)std::floor((std::max)(v[0][1], (std::max)(v[1][1], v[2][1]))));
+      for (int i = i_min; i <= i_max; ++i) {
+        for (int j = j_min; j <= j_max; ++j) {
+          const Vec3f q((FCL_REAL)i, (FCL_REAL)j, 0);
+          // Barycentric coordinates of the column in the projection.
+          const FCL_REAL l0 = cross2(v[2] - v[1], q - v[1]) / area;
+          const FCL_REAL l1 = cross2(v[0] - v[2], q - v[2]) / area;
+          const FCL_REAL l2 = 1 - l0 - l1;
+          if (l0 < 0 || l1 < 0 || l2 < 0) continue;
+          crossings[index(i, j)].push_back(l0 * v[0][2] + l1 * v[1][2] +
+                                           l2 * v[2][2]);
+        }
+      }
+    }
+    for (std::size_t c = 0; c < crossings.size(); ++c)
+      std::sort(crossings[c].begin(), crossings[c].end());
+  }
+
+  /// Whether the point of column (i, j) at height z, in voxel units, is
+  /// inside the mesh.
+  bool inside(int i, int j, FCL_REAL z) const {
+    const std::vector<FCL_REAL>& column = crossings[index(i, j)];
+    return (column.end() - std::upper_bound(column.begin(), column.end(), z)) %
+               2 ==
+           1;
+  }
+
+ private:
+  static FCL_REAL cross2(const Vec3f& a, const Vec3f& b) {
+    return a[0] * b[1] - a[1] * b[0];
+  }
+
+  std::size_t index(int i, int j) const {
+    return (std::size_t)i * (std::size_t)num_columns_y + (std::size_t)j;
+  }
+
+  int num_columns_y;
+  std::vector<std::vector<FCL_REAL> > crossings;
+};
+
+/// Trilinear interpolation of the values at the corners of a cell, indexed
+/// by 4 dx + 2 dy + dz, and its gradient in cell units.
+FCL_REAL trilinear(const FCL_REAL v[8], const Vec3f& f, Vec3f& gradient) {
+  const FCL_REAL x0 = 1 - f[0], y0 = 1 - f[1], z0 = 1 - f[2];
+  const FCL_REAL v00 = v[0] * z0 + v[1] * f[2], v01 = v[2] * z0 + v[3] * f[2],
+                 v10 = v[4] * z0 + v[5] * f[2], v11 = v[6] * z0 + v[7] * f[2];
+  const FCL_REAL v0 = v00 * y0 + v01 * f[1], v1 = v10 * y0 + v11 * f[1];
+  gradient[0] = v1 - v0;
+  gradient[1] = (v01 - v00) * x0 + (v11 - v10) * f[0];
+  gradient[2] = ((v[1] - v[0]) * y0 + (v[3] - v[2]) * f[1]) * x0 +
+                ((v[5] - v[4]) * y0 + (v[7] - v[6]) * f[1]) * f[0];
+  return v0 * x0 + v1 * f[0];
+}
+
+/// Maximal number of iterations of the descent over a shape
+const int sdf_shape_max_iterations = 16;
+
+}  // namespace
+
+FCL_REAL sdfShapeDistance(const SignedDistanceField& sdf,
+                          const ShapeBase& shape, const Transform3f& tf,
+                          Vec3f& p1, Vec3f& p2, Vec3f& normal) {
+  // The support function gives the core of spheres and capsules, which are
+  // inflated by their radius.
+  FCL_REAL inflation = 0;
+  switch (shape.getNodeType()) {
+    case GEOM_SPHERE:
+      inflation = static_cast<const Sphere&>(shape).radius;
+      break;
+    case GEOM_CAPSULE:
+      inflation = static_cast<const Capsule&>(shape).radius;
+      break;
+    case GEOM_PLANE:
+    case GEOM_HALFSPACE:
+      HPP_FCL_THROW_PRETTY(
+          "signed distance fields do not support unbounded shapes.",
+          std::invalid_argument);
+    default:
+      break;
+  }
+
+  const Matrix3f& R = tf.getRotation();
+  int hint = 0;
+  Vec3f x(tf.getTranslation());
+  if (shape.getNodeType() != GEOM_SPHERE) {
+    // Start from the best support point in the directions of the faces and
+    // vertices of a cube.
+    FCL_REAL best = (std::numeric_limits<FCL_REAL>::max)();
+    for (int k = 0; k < 14; ++k) {
+      Vec3f dir(Vec3f::Zero());
+      if (k < 6)
+        dir[k / 2] = (k % 2) ? -1 : 1;
+      else
+        dir << ((k & 1) ? -1 : 1), ((k & 2) ? -1 : 1), ((k & 4) ? -1 : 1);
+      const Vec3f y(tf.transform(
+          getSupport(&shape, R.transpose() * dir, false, hint)));
+      const FCL_REAL d = sdf.distance(y);
+      if (d < best) {
+        best = d;
+        x = y;
+      }
+    }
+  }
+
+  Vec3f gradient;
+  FCL_REAL d = sdf.distance(x, gradient);
+  if (shape.getNodeType() != GEOM_SPHERE) {
+    // Conditional gradient descent: the field decreases towards the support
+    // point of the shape in the direction opposite to its gradient.
+    const FCL_REAL tolerance = 1e-3 * sdf.getVoxelSize();
+    for (int it = 0; it < sdf_shape_max_iterations; ++it) {
+      const Vec3f step(
+          tf.transform(getSupport(&shape, -(R.transpose() * gradient), false,
+                                  hint)) -
+          x);
+      if (-gradient.dot(step) <= tolerance) break;
+      FCL_REAL best_gamma = 0, best = d, gamma = 1;
+      for (int k = 0; k < 6; ++k, gamma /= 2) {
+        const FCL_REAL dk = sdf.distance(x + gamma * step);
+        if (dk < best) {
+          best = dk;
+          best_gamma = gamma;
+        }
+      }
+      if (best_gamma == 0) break;
+      x += best_gamma * step;
+      d = sdf.distance(x, gradient);
+    }
+  }
+
+  const FCL_REAL norm = gradient.norm();
+  normal = (norm > 0) ? Vec3f(gradient / norm) : Vec3f(Vec3f::UnitZ());
+  p1 = x - d * normal;
+  p2 = x - inflation * normal;
+  return d - inflation;
+}
+
+}  // namespace details
+
+SignedDistanceField::SignedDistanceField()
+    : CollisionGeometry(),
+      voxel_size(0),
+      narrow_band(0),
+      origin(Vec3f::Zero()),
+      num_bricks(Eigen::Vector3i::Zero()) {}
+
+SignedDistanceField::SignedDistanceField(const BVHModelBase& model,
+                                         FCL_REAL voxel_size_,
+                                         FCL_REAL narrow_band_,
+                                         FCL_REAL padding)
+    : CollisionGeometry(),
+      voxel_size(voxel_size_),
+      narrow_band(narrow_band_ < 0 ? 3 * voxel_size_ : narrow_band_) {
+  if (voxel_size <= 0)
+    HPP_FCL_THROW_PRETTY("the voxel size must be positive.",
+                         std::invalid_argument);
+  if (model.num_tris == 0 || model.vertices == NULL ||
+      model.tri_indices == NULL)
+    HPP_FCL_THROW_PRETTY("the signed distance field requires a triangle mesh.",
+                         std::invalid_argument);
+  if (padding < 0) padding = narrow_band;
+
+  for (unsigned int i = 0; i < model.num_vertices; ++i)
+    mesh_aabb += model.vertices[i];
+  const FCL_REAL brick_length = brick_size * voxel_size;
+  origin = mesh_aabb.min_ - Vec3f::Constant(padding);
+  for (int i = 0; i < 3; ++i)
+    num_bricks[i] = (std::max)(
+        1, (int)std::ceil(
+               (mesh_aabb.max_[i] - mesh_aabb.min_[i] + 2 * padding) /
+               brick_length));
+  computeLocalAABB();
+
+  const details::MeshDistance mesh_distance(model);
+  const details::ColumnCrossings columns(model, origin, voxel_size,
+                                         brick_size * num_bricks[0] + 1,
+                                         brick_size * num_bricks[1] + 1);
+  const FCL_REAL inf = (std::numeric_limits<FCL_REAL>::max)();
+
+  // Brick corners. Along a column, the distance changes by at most the
+  // distance between the samples.
+  coarse_samples.resize(coarseIndex(num_bricks[0], num_bricks[1],
+                                    num_bricks[2]) +
+                        1);
+  for (int i = 0; i <= num_bricks[0]; ++i) {
+    for (int j = 0; j <= num_bricks[1]; ++j) {
+      FCL_REAL previous = inf;
+      for (int k = 0; k <= num_bricks[2]; ++k) {
+        const Vec3f p(origin + brick_length * Vec3f((FCL_REAL)i, (FCL_REAL)j,
+                                                    (FCL_REAL)k));
+        previous = mesh_distance(
+            p, (k == 0) ? inf : std::abs(previous) + brick_length);
+        if (columns.inside(i * brick_size, j * brick_size,
+                           (FCL_REAL)(k * brick_size)))
+          previous = -previous;
+        coarse_samples[coarseIndex(i, j, k)] = (float)previous;
+      }
+    }
+  }
+
+  // Bricks within the narrow band.
+  const FCL_REAL brick_radius = std::sqrt(3.) * brick_length / 2;
+  brick_indices.assign(brickIndex(num_bricks[0] - 1, num_bricks[1] - 1,
+                                  num_bricks[2] - 1) +
+                           1,
+                       -1);
+  int num_sampled_bricks = 0;
+  for (int i = 0; i < num_bricks[0]; ++i) {
+    for (int j = 0; j < num_bricks[1]; ++j) {
+      for (int k = 0; k < num_bricks[2]; ++k) {
+        const Vec3f corner(origin + brick_length * Vec3f((FCL_REAL)i,
+                                                         (FCL_REAL)j,
+                                                         (FCL_REAL)k));
+        if (mesh_distance(corner + Vec3f::Constant(brick_length / 2), inf) >
+            narrow_band + brick_radius)
+          continue;
+        brick_indices[brickIndex(i, j, k)] = num_sampled_bricks++;
+        brick_samples.resize((std::size_t)num_sampled_bricks *
+                             brick_num_samples);
+        float* samples =
+            &brick_samples[(std::size_t)(num_sampled_bricks - 1) *
+                           brick_num_samples];
+        for (int a = 0; a <= brick_size; ++a) {
+          for (int b = 0; b <= brick_size; ++b) {
+            FCL_REAL previous = inf;
+            for (int c = 0; c <= brick_size; ++c) {
+              const Vec3f p(corner + voxel_size * Vec3f((FCL_REAL)a,
+                                                        (FCL_REAL)b,
+                                                        (FCL_REAL)c));
+              previous = mesh_distance(
+                  p, (c == 0) ? inf : std::abs(previous) + voxel_size);
+              if (columns.inside(i * brick_size + a, j * brick_size + b,
+                                 (FCL_REAL)(k * brick_size + c)))
+                previous = -previous;
+              samples[(a * (brick_size + 1) + b) * (brick_size + 1) + c] =
+                  (float)previous;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+void SignedDistanceField::computeLocalAABB() {
+  aabb_local = mesh_aabb;
+  aabb_center = aabb_local.center();
+  aabb_radius = (aabb_local.min_ - aabb_center).norm();
+}
+
+FCL_REAL SignedDistanceField::interpolate(const Vec3f& u,
+                                          Vec3f& gradient) const {
+  int b[3];
+  for (int i = 0; i < 3; ++i)
+    b[i] = (std::min)((int)(u[i] / brick_size), num_bricks[i] - 1);
+  const int index = brick_indices[brickIndex(b[0], b[1], b[2])];
+
+  FCL_REAL v[8];
+  Vec3f f;
+  FCL_REAL distance;
+  if (index >= 0) {
+    const float* samples =
+        &brick_samples[(std::size_t)index * brick_num_samples];
+    int c[3];
+    for (int i = 0; i < 3; ++i) {
+      const FCL_REAL l = u[i] - b[i] * brick_size;
+      c[i] = (std::min)((int)l, brick_size - 1);
+      f[i] = l - c[i];
+    }
+    for (int n = 0; n < 8; ++n)
+      v[n] = samples[((c[0] + (n >> 2)) * (brick_size + 1) + c[1] +
+                      ((n >> 1) & 1)) *
+                         (brick_size + 1) +
+                     c[2] + (n & 1)];
+    distance = details::trilinear(v, f, gradient);
+    gradient /= voxel_size;
+  } else {
+    for (int i = 0; i < 3; ++i) f[i] = u[i] / brick_size - b[i];
+    for (int n = 0; n < 8; ++n)
+      v[n] = coarse_samples[coarseIndex(b[0] + (n >> 2), b[1] + ((n >> 1) & 1),
+                                        b[2] + (n & 1))];
+    distance = details::trilinear(v, f, gradient);
+    gradient /= brick_size * voxel_size;
+  }
+  return distance;
+}
+
+FCL_REAL SignedDistanceField::distance(const Vec3f& p,
+                                       Vec3f& gradient) const {
+  if (coarse_samples.empty())
+    HPP_FCL_THROW_PRETTY("the signed distance field is empty.",
+                         std::invalid_argument);
+  const Vec3f u((p - origin) / voxel_size);
+  const Vec3f extent(brick_size * num_bricks.cast<FCL_REAL>());
+  const Vec3f q(u.cwiseMax(Vec3f::Zero()).cwiseMin(extent));
+  FCL_REAL d = interpolate(q, gradient);
+  if (q != u) {
+    const Vec3f delta((u - q) * voxel_size);
+    const FCL_REAL outside = delta.norm();
+    for (int i = 0; i < 3; ++i)
+      if (u[i] != q[i]) gradient[i] = 0;
+    gradient += delta / outside;
+    d += outside;
+  }
+  return d;
+}
+
+FCL_REAL SignedDistanceField::distance(const Vec3f& p) const {
+  Vec3f gradient;
+  return distance(p, gradient);
+}
+
+}  // namespace fcl
+
+}  // namespace hpp
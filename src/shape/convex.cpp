@@ -18,6 +18,14 @@ using orgQhull::QhullVertexList;
 using orgQhull::QhullVertexSet;
 #endif
 
+#include <algorithm>
+#include <exception>
+#include <limits>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace hpp {
 namespace fcl {
 
@@ -43,6 +51,439 @@ void reorderTriangle(const Convex<Triangle>* convex_tri, Triangle& tri) {
   }
 }
 
+namespace {
+
+/// Incremental quickhull in 3D. The faces are triangles whose vertices are in
+/// counter-clockwise order when seen from outside, and adjacent[i] is the face
+/// on the other side of the edge (vertices[i], vertices[i + 1]).
+class QuickHull {
+ public:
+  struct Face {
+    unsigned int vertices[3];
+    unsigned int adjacent[3];
+    Vec3f normal;
+    FCL_REAL offset;
+    /// First point of the outside set, -1 if it is empty.
+    int outside;
+    bool alive;
+  };
+
+  QuickHull(const Vec3f* points, unsigned int num_points)
+      : points_(points),
+        num_points_(num_points),
+        ignored_(num_points, false),
+        next_(num_points, -1),
+        stamp_(0) {
+    Vec3f max_abs(Vec3f::Zero());
+    for (unsigned int i = 0; i < num_points; ++i)
+      max_abs = max_abs.cwiseMax(points[i].cwiseAbs());
+    eps_ = 3 * std::numeric_limits<FCL_REAL>::epsilon() * max_abs.sum();
+  }
+
+  void build() {
+    buildSimplex();
+    while (!pending_.empty()) {
+      const unsigned int f = pending_.back();
+      pending_.pop_back();
+      if (!faces_[f].alive || faces_[f].outside < 0) continue;
+
+      // The farthest point of the outside set.
+      const Face& face = faces_[f];
+      int eye = face.outside;
+      FCL_REAL max_d = distance(face, points_[eye]);
+      for (int i = next_[(std::size_t)eye]; i >= 0; i = next_[(std::size_t)i]) {
+        const FCL_REAL d = distance(face, points_[i]);
+        if (d > max_d) {
+          max_d = d;
+          eye = i;
+        }
+      }
+      addPoint((unsigned int)eye, f);
+    }
+
+    // With degenerate inputs, such as points on a grid, the farthest point
+    // may lie inside a face or an edge of the final hull. Such vertices have
+    // less than three edges between faces which are not coplanar. The hull
+    // is built again from the other vertices.
+    std::vector<unsigned int> num_edges(num_points_, 0);
+    for (unsigned int f = 0; f < (unsigned int)faces_.size(); ++f) {
+      if (!faces_[f].alive) continue;
+      for (unsigned int i = 0; i < 3; ++i)
+        if (!coplanar(f, i)) ++num_edges[faces_[f].vertices[i]];
+    }
+    std::vector<bool> used(num_points_, false);
+    bool flat_vertex = false;
+    for (std::size_t f = 0; f < faces_.size(); ++f) {
+      if (!faces_[f].alive) continue;
+      for (int i = 0; i < 3; ++i) {
+        const unsigned int v = faces_[f].vertices[i];
+        used[v] = true;
+        if (num_edges[v] < 3) flat_vertex = true;
+      }
+    }
+    if (!flat_vertex) return;
+
+    for (unsigned int i = 0; i < num_points_; ++i)
+      ignored_[i] = !used[i] || num_edges[i] < 3;
+    faces_.clear();
+    visited_.clear();
+    pending_.clear();
+    std::fill(next_.begin(), next_.end(), -1);
+    build();
+  }
+
+  FCL_REAL tolerance() const { return eps_; }
+  const std::vector<Face>& faces() const { return faces_; }
+
+  /// Whether the faces on both sides of edge i of face f are coplanar.
+  bool coplanar(unsigned int f, unsigned int i) const {
+    const Face& face = faces_[f];
+    const Face& other = faces_[face.adjacent[i]];
+    return distance(face, points_[opposite(other, face.vertices[i])]) >=
+               -eps_ &&
+           distance(other, points_[face.vertices[(i + 2) % 3]]) >= -eps_;
+  }
+
+ private:
+  FCL_REAL distance(const Face& face, const Vec3f& p) const {
+    return face.normal.dot(p) - face.offset;
+  }
+
+  /// Vertex of face which follows v in counter-clockwise order, that is the
+  /// vertex opposite to the edge ending at v.
+  static unsigned int opposite(const Face& face, unsigned int v) {
+    for (int i = 0; i < 3; ++i)
+      if (face.vertices[i] == v) return face.vertices[(i + 1) % 3];
+    assert(false);
+    return face.vertices[0];
+  }
+
+  static bool hasVertex(const Face& face, unsigned int v) {
+    return face.vertices[0] == v || face.vertices[1] == v ||
+           face.vertices[2] == v;
+  }
+
+  /// Index of the edge of face which starts at v.
+  static unsigned int edgeStartingAt(const Face& face, unsigned int v) {
+    for (unsigned int i = 0; i < 3; ++i)
+      if (face.vertices[i] == v) return i;
+    assert(false);
+    return 0;
+  }
+
+  unsigned int addFace(unsigned int a, unsigned int b, unsigned int c) {
+    Face face = Face();
+    face.vertices[0] = a;
+    face.vertices[1] = b;
+    face.vertices[2] = c;
+    face.normal = (points_[b] - points_[a]).cross(points_[c] - points_[a]);
+    const FCL_REAL norm = face.normal.norm();
+    if (norm > 0) face.normal /= norm;
+    face.offset = face.normal.dot(points_[a]);
+    face.outside = -1;
+    face.alive = true;
+    faces_.push_back(face);
+    visited_.push_back(0);
+    return (unsigned int)faces_.size() - 1;
+  }
+
+  /// Move point i to the outside set of the face among [begin, end) it is the
+  /// farthest above, if any.
+  void assign(unsigned int i, std::size_t begin, std::size_t end) {
+    FCL_REAL max_d = eps_;
+    std::size_t best = end;
+    for (std::size_t f = begin; f < end; ++f) {
+      const FCL_REAL d = distance(faces_[f], points_[i]);
+      if (d > max_d) {
+        max_d = d;
+        best = f;
+      }
+    }
+    if (best == end) return;
+    if (faces_[best].outside < 0) pending_.push_back((unsigned int)best);
+    next_[i] = faces_[best].outside;
+    faces_[best].outside = (int)i;
+  }
+
+  void buildSimplex() {
+    unsigned int first = 0;
+    while (ignored_[first]) ++first;
+
+    // Two extreme points along the axis with the largest extent.
+    unsigned int v[4] = {first, first, first, first};
+    FCL_REAL extent = -1;
+    for (int axis = 0; axis < 3; ++axis) {
+      unsigned int lo = first, hi = first;
+      for (unsigned int i = first + 1; i < num_points_; ++i) {
+        if (ignored_[i]) continue;
+        if (points_[i][axis] < points_[lo][axis]) lo = i;
+        if (points_[i][axis] > points_[hi][axis]) hi = i;
+      }
+      if (points_[hi][axis] - points_[lo][axis] > extent) {
+        extent = points_[hi][axis] - points_[lo][axis];
+        v[0] = lo;
+        v[1] = hi;
+      }
+    }
+    // Farthest point from the line, then from the plane.
+    const Vec3f axis((points_[v[1]] - points_[v[0]]).normalized());
+    FCL_REAL max_d = 0;
+    for (unsigned int i = 0; i < num_points_; ++i) {
+      if (ignored_[i]) continue;
+      const FCL_REAL d = (points_[i] - points_[v[0]]).cross(axis).norm();
+      if (d > max_d) {
+        max_d = d;
+        v[2] = i;
+      }
+    }
+    bool flat = extent <= eps_ || max_d <= eps_;
+    if (!flat) {
+      const Vec3f normal((points_[v[1]] - points_[v[0]])
+                             .cross(points_[v[2]] - points_[v[0]])
+                             .normalized());
+      max_d = 0;
+      for (unsigned int i = 0; i < num_points_; ++i) {
+        if (ignored_[i]) continue;
+        const FCL_REAL d = std::abs(normal.dot(points_[i] - points_[v[0]]));
+        if (d > max_d) {
+          max_d = d;
+          v[3] = i;
+        }
+      }
+      flat = max_d <= eps_;
+    }
+    if (flat)
+      HPP_FCL_THROW_PRETTY(
+          "The points are coplanar, they do not have a convex hull.",
+          std::invalid_argument);
+
+    // Each face of the tetrahedron is oriented away from the fourth vertex.
+    static const int tetrahedron[4][3] = {
+        {0, 1, 2}, {0, 3, 1}, {1, 3, 2}, {2, 3, 0}};
+    const FCL_REAL sign =
+        (points_[v[1]] - points_[v[0]])
+            .cross(points_[v[2]] - points_[v[0]])
+            .dot(points_[v[3]] - points_[v[0]]) > 0
+            ? -1
+            : 1;
+    for (int f = 0; f < 4; ++f) {
+      const unsigned int a = v[tetrahedron[f][0]];
+      unsigned int b = v[tetrahedron[f][1]], c = v[tetrahedron[f][2]];
+      if (sign < 0) std::swap(b, c);
+      addFace(a, b, c);
+    }
+    for (unsigned int f = 0; f < 4; ++f)
+      for (unsigned int i = 0; i < 3; ++i)
+        for (unsigned int g = 0; g < 4; ++g)
+          // The other face of the tetrahedron with both vertices of the edge.
+          if (g != f && hasVertex(faces_[g], faces_[f].vertices[i]) &&
+              hasVertex(faces_[g], faces_[f].vertices[(i + 1) % 3])) {
+            faces_[f].adjacent[i] = g;
+            break;
+          }
+
+    for (unsigned int i = 0; i < num_points_; ++i)
+      if (!ignored_[i] && i != v[0] && i != v[1] && i != v[2] && i != v[3])
+        assign(i, 0, faces_.size());
+  }
+
+  /// Depth first search of the faces visible from eye, starting from edge
+  /// start of face f and visiting count edges. The edges at the boundary of
+  /// the visible region are appended to horizon_ in counter-clockwise order.
+  void computeHorizon(const Vec3f& eye, unsigned int f, unsigned int start,
+                      unsigned int count) {
+    visited_[f] = stamp_;
+    visible_.push_back(f);
+    for (unsigned int k = 0; k < count; ++k) {
+      const unsigned int i = (start + k) % 3;
+      const unsigned int g = faces_[f].adjacent[i];
+      if (visited_[g] == stamp_) continue;
+      if (distance(faces_[g], eye) > eps_) {
+        const unsigned int j =
+            edgeStartingAt(faces_[g], faces_[f].vertices[(i + 1) % 3]);
+        computeHorizon(eye, g, (j + 1) % 3, 2);
+      } else {
+        horizon_.push_back(std::make_pair(f, i));
+      }
+    }
+  }
+
+  void addPoint(unsigned int eye, unsigned int f) {
+    ++stamp_;
+    visible_.clear();
+    horizon_.clear();
+    computeHorizon(points_[eye], f, 0, 3);
+
+    orphans_.clear();
+    for (std::size_t k = 0; k < visible_.size(); ++k) {
+      Face& face = faces_[visible_[k]];
+      for (int i = face.outside; i >= 0; i = next_[(std::size_t)i])
+        if ((unsigned int)i != eye) orphans_.push_back((unsigned int)i);
+      face.alive = false;
+    }
+
+    // A cone of faces from the horizon to the eye.
+    const std::size_t begin = faces_.size();
+    const std::size_t n = horizon_.size();
+    for (std::size_t k = 0; k < n; ++k) {
+      const unsigned int hf = horizon_[k].first, hi = horizon_[k].second;
+      const unsigned int a = faces_[hf].vertices[hi];
+      const unsigned int b = faces_[hf].vertices[(hi + 1) % 3];
+      const unsigned int g = faces_[hf].adjacent[hi];
+      const unsigned int nf = addFace(a, b, eye);
+      faces_[nf].adjacent[0] = g;
+      faces_[g].adjacent[edgeStartingAt(faces_[g], b)] = nf;
+    }
+    for (std::size_t k = 0; k < n; ++k) {
+      Face& face = faces_[begin + k];
+      assert(face.vertices[1] == faces_[begin + (k + 1) % n].vertices[0]);
+      face.adjacent[1] = (unsigned int)(begin + (k + 1) % n);
+      face.adjacent[2] = (unsigned int)(begin + (k + n - 1) % n);
+    }
+
+    for (std::size_t k = 0; k < orphans_.size(); ++k)
+      assign(orphans_[k], begin, faces_.size());
+  }
+
+  const Vec3f* points_;
+  unsigned int num_points_;
+  FCL_REAL eps_;
+  /// Points which are not candidate vertices.
+  std::vector<bool> ignored_;
+
+  std::vector<Face> faces_;
+  /// Next point in the outside set of a face.
+  std::vector<int> next_;
+  /// Faces which may have a non empty outside set.
+  std::vector<unsigned int> pending_;
+
+  /// Buffers of addPoint.
+  std::vector<unsigned int> visited_;
+  unsigned int stamp_;
+  std::vector<unsigned int> visible_;
+  std::vector<std::pair<unsigned int, unsigned int> > horizon_;
+  std::vector<unsigned int> orphans_;
+};
+
+}  // namespace
+
+ConvexBase* ConvexBase::quickHull(const Vec3f* pts, unsigned int num_points,
+                                  bool keepTriangles) {
+  if (num_points <= 3) {
+    throw std::invalid_argument(
+        "You shouldn't use this function with less than"
+        " 4 points.");
+  }
+
+  QuickHull hull(pts, num_points);
+  hull.build();
+  const std::vector<QuickHull::Face>& faces = hull.faces();
+
+  // Map index in pts to index in vertices. -1 means not used
+  std::vector<int> pts_to_vertices(num_points, -1);
+  std::vector<bool> used(num_points, false);
+  unsigned int nfaces = 0;
+  for (std::size_t f = 0; f < faces.size(); ++f) {
+    if (!faces[f].alive) continue;
+    ++nfaces;
+    for (int i = 0; i < 3; ++i) used[faces[f].vertices[i]] = true;
+  }
+  const unsigned int nvertex =
+      (unsigned int)std::count(used.begin(), used.end(), true);
+  Vec3f* vertices = new Vec3f[nvertex];
+  unsigned int i_vertex = 0;
+  for (unsigned int i = 0; i < num_points; ++i) {
+    if (!used[i]) continue;
+    pts_to_vertices[i] = (int)i_vertex;
+    vertices[i_vertex++] = pts[i];
+  }
+
+  Convex<Triangle>* convex_tri(NULL);
+  ConvexBase* convex(NULL);
+  if (keepTriangles)
+    convex = convex_tri = new Convex<Triangle>();
+  else
+    convex = new ConvexBase;
+  convex->initialize(true, vertices, nvertex);
+  if (keepTriangles) {
+    convex_tri->num_polygons = nfaces;
+    convex_tri->polygons = new Triangle[nfaces];
+  }
+
+  // Directed edges of the triangles, or of the polygons made of coplanar
+  // triangles. Each edge is seen from the faces on both sides.
+  std::vector<std::pair<unsigned int, unsigned int> > edges;
+  edges.reserve(3 * nfaces);
+  unsigned int i_polygon = 0;
+  for (unsigned int f = 0; f < (unsigned int)faces.size(); ++f) {
+    if (!faces[f].alive) continue;
+    unsigned int v[3];
+    for (int i = 0; i < 3; ++i)
+      v[i] = (unsigned int)pts_to_vertices[faces[f].vertices[i]];
+    if (keepTriangles)
+      convex_tri->polygons[i_polygon++] = Triangle(v[0], v[1], v[2]);
+    for (unsigned int i = 0; i < 3; ++i)
+      if (keepTriangles || !hull.coplanar(f, i))
+        edges.push_back(std::make_pair(v[i], v[(i + 1) % 3]));
+  }
+  std::sort(edges.begin(), edges.end());
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+  // Fill the neighbor attribute of the returned object.
+  convex->neighbors = new Neighbors[nvertex];
+  convex->nneighbors_ = new unsigned int[edges.size()];
+  std::size_t e = 0;
+  for (unsigned int i = 0; i < nvertex; ++i) {
+    Neighbors& n = convex->neighbors[i];
+    n.n_ = convex->nneighbors_ + e;
+    std::size_t count = 0;
+    for (; e < edges.size() && edges[e].first == i; ++e, ++count)
+      n.n_[count] = edges[e].second;
+    if (count >= (std::numeric_limits<unsigned char>::max)()) {
+      delete convex;
+      throw std::logic_error("Too many neighbors.");
+    }
+    n.count_ = (unsigned char)count;
+  }
+  assert(e == edges.size());
+  return convex;
+}
+
+void ConvexBase::quickHull(const std::vector<std::vector<Vec3f> >& point_sets,
+                           bool keepTriangles,
+                           std::vector<shared_ptr<ConvexBase> >& hulls,
+                           int num_threads) {
+#ifdef _OPENMP
+  if (num_threads <= 0) num_threads = omp_get_max_threads();
+#else
+  HPP_FCL_UNUSED_VARIABLE(num_threads);
+#endif
+
+  hulls.assign(point_sets.size(), shared_ptr<ConvexBase>());
+  // Exceptions cannot leave a parallel region: the first one is rethrown
+  // once all the hulls are processed.
+  std::exception_ptr error;
+  const long size = (long)point_sets.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads) if ( \
+    num_threads > 1)
+#endif
+  for (long k = 0; k < size; ++k) {
+    const std::size_t i = (std::size_t)k;
+    try {
+      hulls[i].reset(quickHull(point_sets[i].data(),
+                               (unsigned int)point_sets[i].size(),
+                               keepTriangles));
+    } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+      if (!error) error = std::current_exception();
+    }
+  }
+  if (error) std::rethrow_exception(error);
+}
+
 ConvexBase* ConvexBase::convexHull(const Vec3f* pts, unsigned int num_points,
                                    bool keepTriangles,
                                    const char* qhullCommand) {
@@ -175,12 +616,8 @@ ConvexBase* ConvexBase::convexHull(const Vec3f* pts, unsigned int num_points,
   assert(p_nneighbors == convex->nneighbors_ + c_nneighbors);
   return convex;
 #else
-  throw std::logic_error(
-      "Library built without qhull. Cannot build object of this type.");
-  HPP_FCL_UNUSED_VARIABLE(pts);
-  HPP_FCL_UNUSED_VARIABLE(num_points);
-  HPP_FCL_UNUSED_VARIABLE(keepTriangles);
   HPP_FCL_UNUSED_VARIABLE(qhullCommand);
+  return quickHull(pts, num_points, keepTriangles);
 #endif
 }
 }  // namespace fcl
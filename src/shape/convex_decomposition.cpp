@@ -0,0 +1,250 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <hpp/fcl/shape/convex_decomposition.h>
+
+#include <algorithm>
+#include <limits>
+
+#include <hpp/fcl/compound.h>
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/shape/convex.h>
+
+namespace hpp {
+namespace fcl {
+
+namespace {
+
+/// Set of triangles of the mesh and its convex hull.
+struct Piece {
+  std::vector<unsigned int> triangles;
+  shared_ptr<ConvexBase> hull;
+  FCL_REAL concavity;
+  bool splittable;
+};
+
+/// Vertices of the triangles of a piece, without duplicated indices.
+void pieceVertices(const BVHModelBase& model,
+                   const std::vector<unsigned int>& triangles,
+                   std::vector<Vec3f>& points) {
+  std::vector<unsigned int> indices;
+  indices.reserve(3 * triangles.size());
+  for (std::size_t i = 0; i < triangles.size(); ++i) {
+    const Triangle& tri = model.tri_indices[triangles[i]];
+    for (int j = 0; j < 3; ++j) indices.push_back((unsigned int)tri[j]);
+  }
+  std::sort(indices.begin(), indices.end());
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+  points.resize(indices.size());
+  for (std::size_t i = 0; i < indices.size(); ++i)
+    points[i] = model.vertices[indices[i]];
+}
+
+/// Whether the points do not span a volume thicker than eps, in which case
+/// they have no convex hull.
+bool isFlat(const std::vector<Vec3f>& points, FCL_REAL eps) {
+  if (points.size() < 4) return true;
+
+  // Initial simplex of quickhull: farthest point from the first one, from
+  // the line through them and from the plane through the three.
+  const Vec3f& p0 = points[0];
+  std::size_t i1 = 0;
+  for (std::size_t i = 1; i < points.size(); ++i)
+    if ((points[i] - p0).squaredNorm() > (points[i1] - p0).squaredNorm())
+      i1 = i;
+  const Vec3f axis((points[i1] - p0).normalized());
+  if ((points[i1] - p0).norm() <= eps) return true;
+
+  Vec3f normal(Vec3f::Zero());
+  FCL_REAL max_d = 0;
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const Vec3f n((points[i] - p0).cross(axis));
+    if (n.norm() > max_d) {
+      max_d = n.norm();
+      normal = n;
+    }
+  }
+  if (max_d <= eps) return true;
+  normal.normalize();
+
+  for (std::size_t i = 0; i < points.size(); ++i)
+    if (std::abs(normal.dot(points[i] - p0)) > eps) return false;
+  return true;
+}
+
+/// Largest distance between the points, which lie inside the hull, and the
+/// boundary of the hull.
+FCL_REAL concavity(const ConvexBase& hull, const std::vector<Vec3f>& points) {
+  const Convex<Triangle>& convex = static_cast<const Convex<Triangle>&>(hull);
+  std::vector<Vec3f> normals;
+  std::vector<FCL_REAL> offsets;
+  normals.reserve(convex.num_polygons);
+  offsets.reserve(convex.num_polygons);
+  for (unsigned int i = 0; i < convex.num_polygons; ++i) {
+    const Triangle& tri = convex.polygons[i];
+    const Vec3f& p0 = convex.points[tri[0]];
+    // The triangles of the hull are oriented outwards.
+    Vec3f n((convex.points[tri[1]] - p0).cross(convex.points[tri[2]] - p0));
+    const FCL_REAL norm = n.norm();
+    if (norm <= 0) continue;
+    n /= norm;
+    normals.push_back(n);
+    offsets.push_back(n.dot(p0));
+  }
+
+  FCL_REAL result = 0;
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    FCL_REAL depth = (std::numeric_limits<FCL_REAL>::max)();
+    for (std::size_t j = 0; j < normals.size(); ++j)
+      depth = (std::min)(depth, offsets[j] - normals[j].dot(points[i]));
+    result = (std::max)(result, depth);
+  }
+  return result;
+}
+
+/// Build the hull of the triangles of piece. Returns false if they are flat.
+bool buildPiece(const BVHModelBase& model, FCL_REAL eps, Piece& piece) {
+  std::vector<Vec3f> points;
+  pieceVertices(model, piece.triangles, points);
+  if (isFlat(points, eps)) return false;
+
+  piece.hull.reset(ConvexBase::convexHull(
+      points.data(), (unsigned int)points.size(), true));
+  piece.concavity = concavity(*piece.hull, points);
+  piece.splittable = true;
+  return true;
+}
+
+/// Split piece along the best candidate plane. Returns false if no plane
+/// yields two pieces with a volume.
+bool splitPiece(const BVHModelBase& model, const std::vector<Vec3f>& centroids,
+                unsigned int num_candidates, FCL_REAL eps, const Piece& piece,
+                Piece& left, Piece& right) {
+  Vec3f lower(centroids[piece.triangles[0]]), upper(lower);
+  for (std::size_t i = 1; i < piece.triangles.size(); ++i) {
+    lower = lower.cwiseMin(centroids[piece.triangles[i]]);
+    upper = upper.cwiseMax(centroids[piece.triangles[i]]);
+  }
+
+  FCL_REAL best_score = (std::numeric_limits<FCL_REAL>::max)();
+  Piece l, r;
+  for (int axis = 0; axis < 3; ++axis) {
+    if (upper[axis] <= lower[axis]) continue;
+    for (unsigned int k = 0; k < num_candidates; ++k) {
+      const FCL_REAL cut =
+          lower[axis] + (upper[axis] - lower[axis]) * FCL_REAL(k + 1) /
+                            FCL_REAL(num_candidates + 1);
+      l.triangles.clear();
+      r.triangles.clear();
+      for (std::size_t i = 0; i < piece.triangles.size(); ++i) {
+        const unsigned int t = piece.triangles[i];
+        (centroids[t][axis] < cut ? l : r).triangles.push_back(t);
+      }
+      if (l.triangles.empty() || r.triangles.empty()) continue;
+      if (!buildPiece(model, eps, l) || !buildPiece(model, eps, r)) continue;
+
+      const FCL_REAL score = l.concavity + r.concavity;
+      if (score < best_score) {
+        best_score = score;
+        left = l;
+        right = r;
+      }
+    }
+  }
+  return best_score < (std::numeric_limits<FCL_REAL>::max)();
+}
+
+}  // namespace
+
+shared_ptr<Compound> convexDecomposition(
+    const BVHModelBase& model, const ConvexDecompositionRequest& request) {
+  if (model.getModelType() != BVH_MODEL_TRIANGLES || model.num_tris == 0)
+    HPP_FCL_THROW_PRETTY("The convex decomposition requires a triangle mesh.",
+                         std::invalid_argument);
+  if (request.max_num_pieces == 0)
+    HPP_FCL_THROW_PRETTY("The maximal number of pieces must be positive.",
+                         std::invalid_argument);
+
+  AABB aabb(model.vertices[0]);
+  for (unsigned int i = 1; i < model.num_vertices; ++i)
+    aabb += model.vertices[i];
+  const FCL_REAL diagonal = (aabb.max_ - aabb.min_).norm();
+  const FCL_REAL eps = diagonal * Eigen::NumTraits<FCL_REAL>::dummy_precision();
+  const FCL_REAL tolerance = request.max_concavity * diagonal;
+
+  std::vector<Vec3f> centroids(model.num_tris);
+  for (unsigned int i = 0; i < model.num_tris; ++i) {
+    const Triangle& tri = model.tri_indices[i];
+    centroids[i] = (model.vertices[tri[0]] + model.vertices[tri[1]] +
+                    model.vertices[tri[2]]) /
+                   3;
+  }
+
+  std::vector<Piece> pieces(1);
+  pieces[0].triangles.resize(model.num_tris);
+  for (unsigned int i = 0; i < model.num_tris; ++i) pieces[0].triangles[i] = i;
+  if (!buildPiece(model, eps, pieces[0]))
+    HPP_FCL_THROW_PRETTY("The mesh is flat and has no convex hull.",
+                         std::invalid_argument);
+
+  while (pieces.size() < request.max_num_pieces) {
+    std::size_t worst = pieces.size();
+    for (std::size_t i = 0; i < pieces.size(); ++i) {
+      if (!pieces[i].splittable || pieces[i].concavity <= tolerance) continue;
+      if (worst == pieces.size() ||
+          pieces[i].concavity > pieces[worst].concavity)
+        worst = i;
+    }
+    if (worst == pieces.size()) break;
+
+    Piece left, right;
+    if (!splitPiece(model, centroids, request.num_split_candidates, eps,
+                    pieces[worst], left, right)) {
+      pieces[worst].splittable = false;
+      continue;
+    }
+    pieces[worst] = left;
+    pieces.push_back(right);
+  }
+
+  shared_ptr<Compound> compound(new Compound);
+  for (std::size_t i = 0; i < pieces.size(); ++i)
+    compound->addChild(pieces[i].hull);
+  return compound;
+}
+
+}  // namespace fcl
+}  // namespace hpp
@@ -296,7 +296,7 @@ void computeBV<AABB, Ellipsoid>(const Ellipsoid& e, const Transform3f& tf,
   const Matrix3f& R = tf.getRotation();
   const Vec3f& T = tf.getTranslation();
 
-  Vec3f v_delta = R * e.radii;
+  Vec3f v_delta = (R * e.radii.asDiagonal()).rowwise().norm();
   bv.max_ = T + v_delta;
   bv.min_ = T - v_delta;
 }
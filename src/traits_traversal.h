@@ -9,7 +9,7 @@
 
 #include <hpp/fcl/collision_func_matrix.h>
 #include <hpp/fcl/narrowphase/narrowphase.h>
-#include <../src/collision_node.h>
+#include <hpp/fcl/internal/collision_node.h>
 #include <hpp/fcl/internal/traversal_node_setup.h>
 #include <hpp/fcl/internal/shape_shape_func.h>
 
@@ -0,0 +1,156 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/// Compares the throughput of the batched collision and distance queries with
+/// a loop of single queries, for two geometries placed along a path.
+
+#include <iostream>
+#include <vector>
+
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// @brief Place the first geometry along a path which goes through the
+/// second one, with a slowly varying orientation.
+void generatePath(std::vector<Transform3f>& tf1, std::vector<Transform3f>& tf2,
+                  size_t n) {
+  tf1.resize(n);
+  tf2.assign(n, Transform3f::Identity());
+  const Vec3f start(-1, -0.2, 0.1), end(1, 0.3, -0.1);
+  for (size_t i = 0; i < n; ++i) {
+    const FCL_REAL t = (FCL_REAL)i / (FCL_REAL)(n - 1);
+    Matrix3f R(Eigen::AngleAxisd(3 * t, Vec3f(1, 2, 3).normalized()));
+    tf1[i] = Transform3f(R, (1 - t) * start + t * end);
+  }
+}
+
+/// @brief Print a throughput in queries per second
+void report(const char* name, double time_us, size_t n) {
+  std::cout << "  " << name << (double)n / time_us * 1e6 << " queries/s\n";
+}
+
+int main() {
+  const size_t n = 100000;
+  std::vector<Transform3f> tf1, tf2;
+  generatePath(tf1, tf2, n);
+
+  Ellipsoid shape1(0.1, 0.2, 0.3);
+  Box shape2(0.3, 0.2, 0.5);
+
+  BenchTimer timer;
+  CollisionRequest collision_request;
+  CollisionRequest cached_collision_request;
+  cached_collision_request.gjk_initial_guess = GJKInitialGuess::CachedGuess;
+  std::vector<CollisionResult> collision_results(n);
+  ComputeCollision calc_collision(&shape1, &shape2);
+  size_t num_collisions = 0;
+
+  std::cout << n << " queries between an ellipsoid and a box\n"
+            << "collision:\n";
+  timer.start();
+  for (size_t i = 0; i < n; ++i) {
+    collision_results[i].clear();
+    num_collisions += calc_collision(tf1[i], tf2[i], collision_request,
+                                     collision_results[i]);
+  }
+  timer.stop();
+  report("single queries:                 ", timer.getElapsedTimeInMicroSec(),
+         n);
+
+  timer.start();
+  calc_collision(tf1.data(), tf2.data(), n, collision_request,
+                 collision_results.data(), 1);
+  timer.stop();
+  report("batch, 1 thread:                ", timer.getElapsedTimeInMicroSec(),
+         n);
+
+  timer.start();
+  calc_collision(tf1.data(), tf2.data(), n, cached_collision_request,
+                 collision_results.data(), 1);
+  timer.stop();
+  report("batch, 1 thread, chained guess: ", timer.getElapsedTimeInMicroSec(),
+         n);
+
+  timer.start();
+  calc_collision(tf1.data(), tf2.data(), n, cached_collision_request,
+                 collision_results.data(), 0);
+  timer.stop();
+  report("batch, all threads:             ", timer.getElapsedTimeInMicroSec(),
+         n);
+
+  DistanceRequest distance_request;
+  DistanceRequest cached_distance_request;
+  cached_distance_request.gjk_initial_guess = GJKInitialGuess::CachedGuess;
+  std::vector<DistanceResult> distance_results(n);
+  ComputeDistance calc_distance(&shape1, &shape2);
+
+  std::cout << "distance:\n";
+  timer.start();
+  for (size_t i = 0; i < n; ++i) {
+    distance_results[i].clear();
+    calc_distance(tf1[i], tf2[i], distance_request, distance_results[i]);
+  }
+  timer.stop();
+  report("single queries:                 ", timer.getElapsedTimeInMicroSec(),
+         n);
+
+  timer.start();
+  calc_distance(tf1.data(), tf2.data(), n, distance_request,
+                distance_results.data(), 1);
+  timer.stop();
+  report("batch, 1 thread:                ", timer.getElapsedTimeInMicroSec(),
+         n);
+
+  timer.start();
+  calc_distance(tf1.data(), tf2.data(), n, cached_distance_request,
+                distance_results.data(), 1);
+  timer.stop();
+  report("batch, 1 thread, chained guess: ", timer.getElapsedTimeInMicroSec(),
+         n);
+
+  timer.start();
+  calc_distance(tf1.data(), tf2.data(), n, cached_distance_request,
+                distance_results.data(), 0);
+  timer.stop();
+  report("batch, all threads:             ", timer.getElapsedTimeInMicroSec(),
+         n);
+
+  std::cout << "queries in collision: " << num_collisions << std::endl;
+  return 0;
+}
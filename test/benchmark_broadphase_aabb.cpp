@@ -0,0 +1,169 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/// Compares the number of candidate pairs reported by a broadphase manager when
+/// the world AABB of rotated objects is computed from the bounding sphere of
+/// their geometry or from their rotated local AABB.
+///
+/// The scene is made of several serial robot arms whose links are long and thin
+/// capsules, in random configurations.
+
+#include <iostream>
+
+#include <boost/math/constants/constants.hpp>
+
+#include <hpp/fcl/broadphase/broadphase_dynamic_AABB_tree.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// @brief Callback counting the candidate pairs
+struct CountCallBack : CollisionCallBackBase {
+  void init() { count = 0; }
+
+  bool collide(CollisionObject*, CollisionObject*) {
+    ++count;
+    return false;
+  }
+
+  size_t count;
+};
+
+/// @brief Set the world AABB of an object from its bounding sphere, as it used
+/// to be done for rotated objects.
+void computeSphereAABB(CollisionObject* obj) {
+  const CollisionGeometryPtr_t& geom = obj->collisionGeometry();
+  Vec3f center(obj->getTransform().transform(geom->aabb_center));
+  Vec3f delta(Vec3f::Constant(geom->aabb_radius));
+  obj->getAABB().min_ = center - delta;
+  obj->getAABB().max_ = center + delta;
+}
+
+/// @brief Place the links of an arm of base transform base in a random
+/// configuration. The links rotate alternatively around the x and z axis.
+void placeArm(const Transform3f& base,
+              const std::vector<CollisionObject*>& links,
+              const std::vector<FCL_REAL>& lengths) {
+  const FCL_REAL pi = boost::math::constants::pi<FCL_REAL>();
+  Transform3f joint(base);
+  for (size_t i = 0; i < links.size(); ++i) {
+    FCL_REAL q = (2 * (rand() / (FCL_REAL)RAND_MAX) - 1) * pi;
+    Vec3f axis((i % 2 == 0) ? Vec3f::UnitX() : Vec3f::UnitZ());
+    Matrix3f R(Eigen::AngleAxisd(q, axis));
+    joint = joint * Transform3f(R, Vec3f::Zero());
+    // The capsule axis is z: the link goes from the joint to the next one.
+    Transform3f link(joint * Transform3f(Matrix3f::Identity(),
+                                         Vec3f(0, 0, lengths[i] / 2)));
+    links[i]->setTransform(link);
+    joint = joint * Transform3f(Matrix3f::Identity(), Vec3f(0, 0, lengths[i]));
+  }
+}
+
+int main() {
+  const size_t nb_arms = 50;
+  const size_t nb_links = 7;
+  const size_t nb_configurations = 100;
+  const FCL_REAL link_lengths[nb_links] = {0.3, 0.4, 0.4, 0.35, 0.3, 0.1, 0.1};
+
+  std::vector<FCL_REAL> lengths(link_lengths, link_lengths + nb_links);
+  std::vector<CollisionObject*> objects;
+  std::vector<std::vector<CollisionObject*>> arms(nb_arms);
+  std::vector<Transform3f> bases(nb_arms);
+  for (size_t a = 0; a < nb_arms; ++a) {
+    // Arms on a grid with a spacing of 1 meter.
+    bases[a] = Transform3f(Matrix3f::Identity(),
+                           Vec3f((FCL_REAL)(a % 10), (FCL_REAL)(a / 10), 0));
+    for (size_t i = 0; i < nb_links; ++i) {
+      CollisionGeometryPtr_t capsule(new Capsule(0.04, lengths[i]));
+      arms[a].push_back(new CollisionObject(capsule));
+      objects.push_back(arms[a].back());
+    }
+  }
+
+  DynamicAABBTreeCollisionManager manager;
+  manager.registerObjects(objects);
+  manager.setup();
+
+  BenchTimer timer;
+  double sphere_time = 0, tight_time = 0, batched_time = 0;
+  size_t sphere_pairs = 0, tight_pairs = 0;
+  CountCallBack callback;
+  for (size_t c = 0; c < nb_configurations; ++c) {
+    for (size_t a = 0; a < nb_arms; ++a) placeArm(bases[a], arms[a], lengths);
+
+    timer.start();
+    for (size_t i = 0; i < objects.size(); ++i) computeSphereAABB(objects[i]);
+    timer.stop();
+    sphere_time += timer.getElapsedTimeInMicroSec();
+    manager.update();
+    manager.collide(&callback);
+    sphere_pairs += callback.count;
+
+    timer.start();
+    for (size_t i = 0; i < objects.size(); ++i) objects[i]->computeAABB();
+    timer.stop();
+    tight_time += timer.getElapsedTimeInMicroSec();
+
+    timer.start();
+    computeAABBs(objects);
+    timer.stop();
+    batched_time += timer.getElapsedTimeInMicroSec();
+    manager.update();
+    manager.collide(&callback);
+    tight_pairs += callback.count;
+  }
+
+  std::cout << nb_arms << " arms of " << nb_links << " links, "
+            << nb_configurations << " configurations\n"
+            << "candidate pairs per configuration:\n"
+            << "  bounding sphere AABB: "
+            << (double)sphere_pairs / (double)nb_configurations << '\n'
+            << "  rotated local AABB:   "
+            << (double)tight_pairs / (double)nb_configurations << '\n'
+            << "  reduction:            "
+            << 100 * (1 - (double)tight_pairs / (double)sphere_pairs) << " %\n"
+            << "AABB computation time per configuration (us):\n"
+            << "  bounding sphere AABB: "
+            << sphere_time / (double)nb_configurations << '\n'
+            << "  rotated local AABB:   "
+            << tight_time / (double)nb_configurations << '\n'
+            << "  computeAABBs:         "
+            << batched_time / (double)nb_configurations << std::endl;
+
+  for (size_t i = 0; i < objects.size(); ++i) delete objects[i];
+  return 0;
+}
@@ -0,0 +1,112 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/// Compares the throughput of the narrowphase on the candidate pairs of a
+/// large scene, when each pair is queried by the default callback and when
+/// the pairs are processed by CollisionCallBackBatch.
+
+#include <iostream>
+#include <vector>
+
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/broadphase/broadphase_dynamic_AABB_tree.h>
+#include <hpp/fcl/broadphase/default_broadphase_callbacks.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// @brief Print a throughput in pairs per second
+void report(const char* name, double time_us, size_t n) {
+  std::cout << "  " << name << (double)n / time_us * 1e6 << " pairs/s\n";
+}
+
+int main() {
+  const FCL_REAL env_scale = 1000;
+  const size_t env_size = 20000;
+  const size_t nb_runs = 10;
+
+  // Boxes, spheres and cylinders, and a few meshes.
+  std::vector<CollisionObject*> env;
+  generateEnvironments(env, env_scale, env_size);
+  generateEnvironmentsMesh(env, env_scale, env_size / 100);
+
+  DynamicAABBTreeCollisionManager manager;
+  manager.registerObjects(env);
+  manager.setup();
+
+  CollisionRequest request;
+  CollisionCallBackBatch batch(request);
+  manager.collide(&batch);
+  const std::vector<CollisionCallBackBatch::CollisionPair>& pairs =
+      batch.getCollisionPairs();
+  const size_t nb_pairs = pairs.size() * nb_runs;
+  std::cout << env.size() << " objects, " << pairs.size()
+            << " candidate pairs\n";
+
+  // As the batch, keep the results of the pairs in collision.
+  BenchTimer timer;
+  std::vector<CollisionResult> results;
+  timer.start();
+  for (size_t r = 0; r < nb_runs; ++r) {
+    results.clear();
+    for (size_t i = 0; i < pairs.size(); ++i) {
+      CollisionResult result;
+      if (collide(pairs[i].first, pairs[i].second, request, result))
+        results.push_back(result);
+    }
+  }
+  timer.stop();
+  report("collide on each pair: ", timer.getElapsedTimeInMicroSec(),
+         nb_pairs);
+
+  timer.start();
+  for (size_t r = 0; r < nb_runs; ++r) batch.processPairs();
+  timer.stop();
+  report("batch, 1 thread:      ", timer.getElapsedTimeInMicroSec(),
+         nb_pairs);
+
+  batch.parallel = true;
+  timer.start();
+  for (size_t r = 0; r < nb_runs; ++r) batch.processPairs();
+  timer.stop();
+  report("batch, all threads:   ", timer.getElapsedTimeInMicroSec(),
+         nb_pairs);
+
+  std::cout << results.size() << " pairs in collision, "
+            << batch.getResults().size() << " with the batch" << std::endl;
+
+  for (size_t i = 0; i < env.size(); ++i) delete env[i];
+  return 0;
+}
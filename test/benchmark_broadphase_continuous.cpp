@@ -0,0 +1,206 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/// Compares the continuous collision checking of a scene of moving objects
+/// over one step with the continuous broadphase manager, with
+/// continuousCollide on all the pairs, and with discrete broadphase passes at
+/// sampled times of the motions.
+///
+/// Usage: test-benchmark-broadphase-continuous
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <hpp/fcl/broadphase/broadphase_continuous_dynamic_AABB_tree.h>
+#include <hpp/fcl/broadphase/broadphase_dynamic_AABB_tree.h>
+#include <hpp/fcl/broadphase/default_broadphase_callbacks.h>
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+void generateScene(std::size_t n, FCL_REAL size,
+                   std::vector<ContinuousCollisionObject*>& objects) {
+  FCL_REAL extents[] = {-size, -size, -size, size, size, size};
+  FCL_REAL delta_trans[] = {1, 1, 1};
+  std::vector<Transform3f> transforms, transforms2;
+  generateRandomTransforms(extents, delta_trans, 0.5, transforms, transforms2,
+                           n);
+  objects.resize(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    shared_ptr<CollisionGeometry> geom;
+    if (i % 2)
+      geom.reset(new Box(0.3, 0.4, 0.5));
+    else
+      geom.reset(new Capsule(0.1, 0.5));
+    objects[i] = new ContinuousCollisionObject(geom, transforms[i],
+                                               transforms2[i]);
+  }
+}
+
+/// @brief Time spent by the continuous broadphase manager on one step, update
+/// included.
+double timeManager(const std::vector<ContinuousCollisionObject*>& objects,
+                   std::size_t& num_collisions) {
+  // The manager is set up with the objects at rest at their initial
+  // placements, as after the previous step.
+  std::vector<Motion> motions;
+  for (std::size_t i = 0; i < objects.size(); ++i) {
+    motions.push_back(objects[i]->getMotion());
+    const Transform3f& tf_beg = motions.back().getBeginTransform();
+    objects[i]->setMotion(tf_beg, tf_beg);
+    objects[i]->computeAABB();
+  }
+  DynamicAABBTreeContinuousCollisionManager manager;
+  manager.registerObjects(objects);
+  manager.setup();
+  ContinuousCollisionCallBackCollect callback;
+
+  BenchTimer timer;
+  timer.start();
+  for (std::size_t i = 0; i < objects.size(); ++i) {
+    objects[i]->setMotion(motions[i]);
+    objects[i]->computeAABB();
+  }
+  manager.update();
+  manager.collide(&callback);
+  timer.stop();
+  num_collisions = callback.getCollidingPairs().size();
+  return timer.getElapsedTimeInMicroSec();
+}
+
+/// @brief Time spent running continuousCollide on all the pairs.
+double timeAllPairs(const std::vector<ContinuousCollisionObject*>& objects,
+                    std::size_t& num_collisions) {
+  const ContinuousCollisionRequest request;
+  ContinuousCollisionResult result;
+  num_collisions = 0;
+
+  BenchTimer timer;
+  timer.start();
+  for (std::size_t i = 0; i < objects.size(); ++i)
+    for (std::size_t j = i + 1; j < objects.size(); ++j) {
+      continuousCollide(objects[i], objects[j], request, result);
+      if (result.is_collide) ++num_collisions;
+    }
+  timer.stop();
+  return timer.getElapsedTimeInMicroSec();
+}
+
+/// @brief Discrete collision callback storing the pairs in collision.
+struct CollidingPairs : CollisionCallBackBase {
+  bool collide(CollisionObject* o1, CollisionObject* o2) {
+    result.clear();
+    if (hpp::fcl::collide(o1, o2, request, result))
+      pairs.push_back(std::make_pair(std::min(o1, o2), std::max(o1, o2)));
+    return false;
+  }
+
+  CollisionRequest request;
+  CollisionResult result;
+  std::vector<std::pair<CollisionObject*, CollisionObject*> > pairs;
+};
+
+/// @brief Time spent by discrete broadphase passes at num_steps + 1 evenly
+/// spaced times.
+double timeSampling(const std::vector<ContinuousCollisionObject*>& objects,
+                    int num_steps, std::size_t& num_collisions) {
+  std::vector<CollisionObject*> samples(objects.size());
+  for (std::size_t i = 0; i < objects.size(); ++i)
+    samples[i] = new CollisionObject(
+        objects[i]->collisionGeometry(),
+        objects[i]->getMotion().getBeginTransform(), false);
+  DynamicAABBTreeCollisionManager manager;
+  manager.registerObjects(samples);
+  manager.setup();
+  CollidingPairs callback;
+
+  BenchTimer timer;
+  timer.start();
+  for (int k = 0; k <= num_steps; ++k) {
+    for (std::size_t i = 0; i < objects.size(); ++i) {
+      samples[i]->setTransform(
+          objects[i]->getMotion().getTransform((FCL_REAL)k / num_steps));
+      samples[i]->computeAABB();
+    }
+    manager.update();
+    manager.collide(&callback);
+  }
+  timer.stop();
+
+  std::vector<std::pair<CollisionObject*, CollisionObject*> >& colliding =
+      callback.pairs;
+  std::sort(colliding.begin(), colliding.end());
+  num_collisions =
+      (std::size_t)(std::unique(colliding.begin(), colliding.end()) -
+                    colliding.begin());
+  for (std::size_t i = 0; i < samples.size(); ++i) delete samples[i];
+  return timer.getElapsedTimeInMicroSec();
+}
+
+int main() {
+  const std::size_t sizes[] = {100, 1000, 5000};
+  for (int s = 0; s < 3; ++s) {
+    std::vector<ContinuousCollisionObject*> objects;
+    // Constant density of objects.
+    generateScene(sizes[s], 2 * std::cbrt((FCL_REAL)sizes[s]), objects);
+
+    std::size_t num_collisions;
+    const double manager_time = timeManager(objects, num_collisions);
+    std::cout << std::setw(5) << sizes[s] << " objects  manager: "
+              << std::setw(10) << manager_time << " us (" << num_collisions
+              << " collisions)\n";
+    if (sizes[s] <= 1000) {
+      const double all_pairs_time = timeAllPairs(objects, num_collisions);
+      std::cout << std::setw(15) << "" << " all pairs: " << std::setw(10)
+                << all_pairs_time << " us (" << num_collisions
+                << " collisions)\n";
+    }
+    const int steps[] = {10, 50};
+    for (int k = 0; k < 2; ++k) {
+      const double sampling_time =
+          timeSampling(objects, steps[k], num_collisions);
+      std::cout << std::setw(15) << "" << std::setw(3) << steps[k]
+                << " samples: " << std::setw(10) << sampling_time << " us ("
+                << num_collisions << " collisions)\n";
+    }
+    for (std::size_t i = 0; i < objects.size(); ++i) delete objects[i];
+  }
+  return 0;
+}
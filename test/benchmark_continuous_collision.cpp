@@ -0,0 +1,153 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/// Compares continuous collision checking by conservative advancement with
+/// discrete collision checking at densely sampled times along the same
+/// motions, as done to check the edges of motion planners.
+///
+/// Usage: test-benchmark-continuous-collision
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/continuous_collision.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+#include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// @brief Time spent checking the motions of o2 from tf[i] to tf[i+1] with
+/// discrete collision checks at num_steps + 1 evenly spaced times.
+double timeSampling(const CollisionGeometry* o1, const CollisionGeometry* o2,
+                    const std::vector<Transform3f>& tf, int num_steps,
+                    std::size_t& num_collisions) {
+  ComputeCollision compute_collision(o1, o2);
+  const CollisionRequest request(NO_REQUEST, 1);
+  num_collisions = 0;
+
+  BenchTimer timer;
+  timer.start();
+  for (std::size_t i = 0; i + 1 < tf.size(); i += 2) {
+    const Motion motion(tf[i], tf[i + 1]);
+    for (int k = 0; k <= num_steps; ++k) {
+      CollisionResult result;
+      if (compute_collision(Transform3f::Identity(),
+                            motion.getTransform((FCL_REAL)k / num_steps),
+                            request, result)) {
+        ++num_collisions;
+        break;
+      }
+    }
+  }
+  timer.stop();
+  return timer.getElapsedTimeInMicroSec() / (double)(tf.size() / 2);
+}
+
+/// @brief Time spent checking the same motions with continuousCollide.
+double timeContinuous(const CollisionGeometry* o1,
+                      const CollisionGeometry* o2,
+                      const std::vector<Transform3f>& tf,
+                      std::size_t& num_collisions,
+                      double& num_iterations) {
+  const ContinuousCollisionRequest request;
+  num_collisions = 0;
+  num_iterations = 0;
+
+  BenchTimer timer;
+  timer.start();
+  for (std::size_t i = 0; i + 1 < tf.size(); i += 2) {
+    ContinuousCollisionResult result;
+    continuousCollide(o1, Transform3f::Identity(), Transform3f::Identity(),
+                      o2, tf[i], tf[i + 1], request, result);
+    if (result.is_collide) ++num_collisions;
+    num_iterations += (double)result.num_iterations;
+  }
+  timer.stop();
+  num_iterations /= (double)(tf.size() / 2);
+  return timer.getElapsedTimeInMicroSec() / (double)(tf.size() / 2);
+}
+
+void runScene(const std::string& name, const CollisionGeometry* o1,
+              const CollisionGeometry* o2,
+              const std::vector<Transform3f>& tf) {
+  std::size_t num_collisions;
+  double num_iterations;
+  const double continuous_time =
+      timeContinuous(o1, o2, tf, num_collisions, num_iterations);
+  std::cout << std::setw(16) << std::left << name << std::right
+            << " continuous: " << std::setw(9) << continuous_time << " us ("
+            << std::setw(5) << num_collisions << " collisions, "
+            << num_iterations << " iterations)\n";
+
+  const int steps[] = {50, 100, 200};
+  for (int s = 0; s < 3; ++s) {
+    const double sampling_time =
+        timeSampling(o1, o2, tf, steps[s], num_collisions);
+    std::cout << std::setw(16) << "" << " " << std::setw(3) << steps[s]
+              << " samples: " << std::setw(9) << sampling_time << " us ("
+              << std::setw(5) << num_collisions << " collisions)\n";
+  }
+}
+
+int main() {
+  // Motions of o2 between random pairs of placements.
+  const size_t n = 2000;
+  FCL_REAL extents[] = {-2, -2, -2, 2, 2, 2};
+  std::vector<Transform3f> tf;
+  generateRandomTransforms(extents, tf, n);
+
+  Box box(0.4, 0.6, 0.3);
+  Capsule capsule(0.05, 0.6);
+  Sphere sphere(0.3);
+  box.computeLocalAABB();
+  capsule.computeLocalAABB();
+  sphere.computeLocalAABB();
+  runScene("box-capsule", &box, &capsule, tf);
+  runScene("sphere-box", &sphere, &box, tf);
+
+  BVHModel<OBBRSS> box_mesh, sphere_mesh;
+  generateBVHModel(box_mesh, box, Transform3f());
+  generateBVHModel(sphere_mesh, sphere, Transform3f(), 16, 16);
+  box_mesh.computeLocalAABB();
+  sphere_mesh.computeLocalAABB();
+  runScene("mesh-capsule", &sphere_mesh, &capsule, tf);
+  runScene("mesh-mesh", &sphere_mesh, &box_mesh, tf);
+  return 0;
+}
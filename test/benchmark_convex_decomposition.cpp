@@ -0,0 +1,183 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+/// Compares the collision and distance queries against a concave triangle
+/// mesh with the same queries against its approximate convex decomposition,
+/// for several numbers of pieces. The accuracy is the ratio of collision
+/// queries with the same answer and the mean error on the distance.
+///
+/// Usage: test-benchmark-convex-decomposition
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/compound.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/shape/convex_decomposition.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// @brief Closed mesh of a unit sphere whose radius oscillates with the
+/// longitude and the latitude.
+void makeBumpySphere(BVHModel<OBBRSS>& mesh, unsigned int n_lat,
+                     unsigned int n_lon) {
+  std::vector<Vec3f> points;
+  std::vector<Triangle> triangles;
+  points.push_back(Vec3f(0, 0, 1));
+  for (unsigned int i = 1; i < n_lat; ++i) {
+    const FCL_REAL theta = M_PI * FCL_REAL(i) / FCL_REAL(n_lat);
+    for (unsigned int j = 0; j < n_lon; ++j) {
+      const FCL_REAL phi = 2 * M_PI * FCL_REAL(j) / FCL_REAL(n_lon);
+      const FCL_REAL r = 1 + 0.2 * std::cos(5 * phi) * std::sin(3 * theta);
+      points.push_back(r * Vec3f(std::sin(theta) * std::cos(phi),
+                                 std::sin(theta) * std::sin(phi),
+                                 std::cos(theta)));
+    }
+  }
+  points.push_back(Vec3f(0, 0, -1));
+
+  const unsigned int south = (unsigned int)points.size() - 1;
+  for (unsigned int j = 0; j < n_lon; ++j) {
+    const unsigned int k = (j + 1) % n_lon;
+    triangles.push_back(Triangle(0, 1 + j, 1 + k));
+    triangles.push_back(Triangle(south, 1 + (n_lat - 2) * n_lon + k,
+                                 1 + (n_lat - 2) * n_lon + j));
+    for (unsigned int i = 0; i + 2 < n_lat; ++i) {
+      const unsigned int a = 1 + i * n_lon, b = a + n_lon;
+      triangles.push_back(Triangle(a + j, b + j, b + k));
+      triangles.push_back(Triangle(a + j, b + k, a + k));
+    }
+  }
+
+  mesh.beginModel();
+  mesh.addSubModel(points, triangles);
+  mesh.endModel();
+}
+
+/// @brief Answers and time per query, in microseconds, of the collision
+/// queries between geom and the box at the given placements.
+double runCollision(const CollisionGeometry* geom, const Box& box,
+                    const std::vector<Transform3f>& transforms,
+                    std::vector<bool>& answers) {
+  CollisionRequest request;
+  answers.resize(transforms.size());
+  BenchTimer timer;
+  timer.start();
+  for (std::size_t i = 0; i < transforms.size(); ++i) {
+    CollisionResult result;
+    answers[i] =
+        collide(geom, Transform3f(), &box, transforms[i], request, result) > 0;
+  }
+  timer.stop();
+  return timer.getElapsedTimeInMicroSec() / (double)transforms.size();
+}
+
+/// @brief Distances and time per query, in microseconds, of the distance
+/// queries between geom and the box at the given placements.
+double runDistance(const CollisionGeometry* geom, const Box& box,
+                   const std::vector<Transform3f>& transforms,
+                   std::vector<FCL_REAL>& distances) {
+  DistanceRequest request;
+  distances.resize(transforms.size());
+  BenchTimer timer;
+  timer.start();
+  for (std::size_t i = 0; i < transforms.size(); ++i) {
+    DistanceResult result;
+    distances[i] =
+        distance(geom, Transform3f(), &box, transforms[i], request, result);
+  }
+  timer.stop();
+  return timer.getElapsedTimeInMicroSec() / (double)transforms.size();
+}
+
+int main() {
+  BVHModel<OBBRSS> mesh;
+  makeBumpySphere(mesh, 64, 128);
+  std::cout << "mesh: " << mesh.num_tris << " triangles\n";
+
+  FCL_REAL extents[] = {-1.5, -1.5, -1.5, 1.5, 1.5, 1.5};
+  std::vector<Transform3f> transforms;
+  generateRandomTransforms(extents, transforms, 2000);
+  Box box(0.2, 0.1, 0.3);
+
+  std::vector<bool> mesh_answers, answers;
+  std::vector<FCL_REAL> mesh_distances, distances;
+  std::cout << std::setw(8) << "pieces" << std::setw(14) << "build (ms)"
+            << std::setw(16) << "collide (us)" << std::setw(12) << "agree (%)"
+            << std::setw(16) << "distance (us)" << std::setw(14)
+            << "mean error" << "\n";
+  std::cout << std::setprecision(3) << std::fixed;
+  std::cout << std::setw(8) << "mesh" << std::setw(14) << "-" << std::setw(16)
+            << runCollision(&mesh, box, transforms, mesh_answers)
+            << std::setw(12) << "-" << std::setw(16)
+            << runDistance(&mesh, box, transforms, mesh_distances)
+            << std::setw(14) << "-" << "\n";
+
+  const unsigned int max_num_pieces[] = {1, 4, 16, 64};
+  for (int k = 0; k < 4; ++k) {
+    BenchTimer timer;
+    timer.start();
+    shared_ptr<Compound> pieces(convexDecomposition(
+        mesh, ConvexDecompositionRequest(max_num_pieces[k], 0.005)));
+    timer.stop();
+    const double build = timer.getElapsedTimeInMilliSec();
+
+    const double collide_time =
+        runCollision(pieces.get(), box, transforms, answers);
+    const double distance_time =
+        runDistance(pieces.get(), box, transforms, distances);
+
+    std::size_t n_agree = 0, n_separated = 0;
+    FCL_REAL error = 0;
+    for (std::size_t i = 0; i < transforms.size(); ++i) {
+      n_agree += answers[i] == mesh_answers[i];
+      if (mesh_distances[i] > 0) {
+        error += std::abs(distances[i] - mesh_distances[i]);
+        ++n_separated;
+      }
+    }
+
+    std::cout << std::setw(8) << pieces->getNumChildren() << std::setw(14)
+              << build << std::setw(16) << collide_time << std::setw(12)
+              << 100. * (double)n_agree / (double)transforms.size()
+              << std::setw(16) << distance_time << std::setw(14)
+              << error / (FCL_REAL)n_separated << "\n";
+  }
+  return 0;
+}
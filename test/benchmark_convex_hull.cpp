@@ -0,0 +1,115 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+/// Measures the time to build the convex hulls of many sets of points with
+/// the quickhull of hpp-fcl, sequentially and in batch, and with Qhull when
+/// the library is built with it.
+///
+/// Usage: test-benchmark-convex-hull [num_threads]
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <hpp/fcl/shape/convex.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// @brief Time, in milliseconds, to build the hulls one after the other.
+double runSequential(const std::vector<std::vector<Vec3f> >& point_sets,
+                     bool qhull, std::size_t& num_vertices) {
+  num_vertices = 0;
+  BenchTimer timer;
+  timer.start();
+  for (std::size_t i = 0; i < point_sets.size(); ++i) {
+    const Vec3f* points = point_sets[i].data();
+    const unsigned int n = (unsigned int)point_sets[i].size();
+    shared_ptr<ConvexBase> hull(qhull
+                                    ? ConvexBase::convexHull(points, n, true)
+                                    : ConvexBase::quickHull(points, n, true));
+    num_vertices += hull->num_points;
+  }
+  timer.stop();
+  return timer.getElapsedTimeInMilliSec();
+}
+
+int main(int argc, char** argv) {
+  const int num_threads = argc > 1 ? std::atoi(argv[1]) : 0;
+
+  // Thousands of small sets, as for the links of many robots, and a few
+  // large ones.
+  const std::size_t sizes[] = {100, 1000, 100000};
+  const std::size_t counts[] = {5000, 1000, 10};
+
+  std::cout << std::setw(10) << "points" << std::setw(8) << "sets"
+            << std::setw(10) << "vertices" << std::setw(16) << "quickhull (ms)"
+            << std::setw(12) << "batch (ms)"
+#ifdef HPP_FCL_HAS_QHULL
+            << std::setw(12) << "qhull (ms)"
+#endif
+            << "\n";
+  std::cout << std::setprecision(1) << std::fixed;
+  for (int s = 0; s < 3; ++s) {
+    // Half of the sets are in a cube, the others on a sphere where every
+    // point is a vertex of the hull.
+    std::vector<std::vector<Vec3f> > point_sets(counts[s]);
+    for (std::size_t i = 0; i < counts[s]; ++i) {
+      point_sets[i].resize(sizes[s]);
+      for (std::size_t j = 0; j < sizes[s]; ++j) {
+        point_sets[i][j] = Vec3f::Random();
+        if (i % 2) point_sets[i][j].normalize();
+      }
+    }
+
+    std::size_t num_vertices;
+    const double sequential = runSequential(point_sets, false, num_vertices);
+
+    std::vector<shared_ptr<ConvexBase> > hulls;
+    BenchTimer timer;
+    timer.start();
+    ConvexBase::quickHull(point_sets, true, hulls, num_threads);
+    timer.stop();
+
+    std::cout << std::setw(10) << sizes[s] << std::setw(8) << counts[s]
+              << std::setw(10) << num_vertices / counts[s] << std::setw(16)
+              << sequential << std::setw(12) << timer.getElapsedTimeInMilliSec()
+#ifdef HPP_FCL_HAS_QHULL
+              << std::setw(12) << runSequential(point_sets, true, num_vertices)
+#endif
+              << "\n";
+  }
+  return 0;
+}
@@ -0,0 +1,167 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/// Compares the throughput of distance queries returning the gradients of
+/// the distance with respect to the placements of both objects, with the
+/// forward finite differences which need 12 more distance queries.
+///
+/// Usage: test-benchmark-distance-gradients
+
+#include <boost/filesystem.hpp>
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// @brief Placement tf moved by the twist eps * e_k in the frame of the
+/// object.
+Transform3f perturb(const Transform3f& tf, int k, FCL_REAL eps) {
+  if (k < 3) return tf * Transform3f(Vec3f(eps * Vec3f::Unit(k)));
+  return tf * Transform3f(Matrix3f(Eigen::AngleAxis<FCL_REAL>(
+                              eps, Vec3f::Unit(k - 3))),
+                          Vec3f::Zero());
+}
+
+void run(const std::string& name, const CollisionGeometry* o1,
+         const CollisionGeometry* o2, const std::vector<Transform3f>& tf1,
+         const std::vector<Transform3f>& tf2) {
+  const std::size_t n = tf1.size();
+  DistanceRequest request;
+  request.enable_gradients = true;
+  BenchTimer timer;
+  timer.start();
+  for (std::size_t i = 0; i < n; ++i) {
+    DistanceResult result;
+    distance(o1, tf1[i], o2, tf2[i], request, result);
+  }
+  timer.stop();
+  const double time_analytic = timer.getElapsedTimeInMicroSec() / (double)n;
+
+  DistanceRequest fd_request;
+  const FCL_REAL eps = 1e-6;
+  std::vector<Vec6f> fd(2 * n);
+  timer.start();
+  for (std::size_t i = 0; i < n; ++i) {
+    DistanceResult result;
+    const FCL_REAL d = distance(o1, tf1[i], o2, tf2[i], fd_request, result);
+    for (int k = 0; k < 6; ++k) {
+      result.clear();
+      fd[2 * i][k] = (distance(o1, perturb(tf1[i], k, eps), o2, tf2[i],
+                               fd_request, result) -
+                      d) /
+                     eps;
+      result.clear();
+      fd[2 * i + 1][k] = (distance(o1, tf1[i], o2, perturb(tf2[i], k, eps),
+                                   fd_request, result) -
+                          d) /
+                         eps;
+    }
+  }
+  timer.stop();
+  const double time_fd = timer.getElapsedTimeInMicroSec() / (double)n;
+
+  // Largest difference between the two gradients.
+  FCL_REAL error = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    DistanceResult result;
+    distance(o1, tf1[i], o2, tf2[i], request, result);
+    for (int j = 0; j < 2; ++j)
+      error = (std::max)(error, (result.gradients[j] - fd[2 * i + j]).norm());
+  }
+
+  std::cout << std::setw(20) << std::left << name << std::right
+            << std::setprecision(3) << std::fixed << std::setw(12)
+            << time_analytic << std::setw(14) << time_fd << std::setw(10)
+            << std::setprecision(1) << time_fd / time_analytic
+            << std::setw(14) << std::scientific << std::setprecision(1)
+            << error << "\n";
+}
+
+int main() {
+  const std::size_t n = 2000;
+  std::vector<Transform3f> tf1(n), tf2(n);
+  FCL_REAL extents[] = {-1, -1, -1, 1, 1, 1};
+  generateRandomTransforms(extents, tf1, n);
+  generateRandomTransforms(extents, tf2, n);
+  // Separate the objects, which do not exceed a radius of 1.
+  for (std::size_t i = 0; i < n; ++i)
+    tf2[i].setTranslation(
+        tf2[i].getTranslation() +
+        3 * (tf2[i].getTranslation() - tf1[i].getTranslation()).normalized());
+
+  Sphere sphere(0.5);
+  Capsule capsule(0.3, 1);
+  Box box(0.6, 0.8, 1);
+  Convex<Triangle> convex(
+      constructPolytopeFromEllipsoid(Ellipsoid(0.4, 0.5, 0.6)));
+
+  std::vector<Vec3f> points;
+  std::vector<Triangle> triangles;
+  boost::filesystem::path path(TEST_RESOURCES_DIR);
+  loadOBJFile((path / "rob.obj").string().c_str(), points, triangles);
+  // Scale the mesh to a radius of about 1.
+  Vec3f lo(points[0]), hi(points[0]);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    lo = lo.cwiseMin(points[i]);
+    hi = hi.cwiseMax(points[i]);
+  }
+  const FCL_REAL scale = 2 / (hi - lo).norm();
+  for (std::size_t i = 0; i < points.size(); ++i)
+    points[i] = scale * (points[i] - (lo + hi) / 2);
+  BVHModel<OBBRSS> mesh;
+  mesh.beginModel();
+  mesh.addSubModel(points, triangles);
+  mesh.endModel();
+
+  std::cout << std::setw(20) << std::left << "pair" << std::right
+            << std::setw(12) << "grad (us)" << std::setw(14) << "fd (us)"
+            << std::setw(10) << "ratio" << std::setw(14) << "max diff"
+            << "\n";
+  run("sphere-capsule", &sphere, &capsule, tf1, tf2);
+  run("box-capsule", &box, &capsule, tf1, tf2);
+  run("convex-box", &convex, &box, tf1, tf2);
+  run("mesh-capsule", &mesh, &capsule, tf1, tf2);
+  run("mesh-convex", &mesh, &convex, tf1, tf2);
+  run("mesh-mesh", &mesh, &mesh, tf1, tf2);
+  return 0;
+}
@@ -0,0 +1,111 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/// Compares the time spent in collision queries which only ask whether the
+/// objects overlap, and thus stop GJK as soon as the answer is known, with
+/// the time spent in queries which also compute the contact information.
+///
+/// Usage: test-benchmark-overlap
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+#include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// @brief Time the collision queries between o1 and o2 for every pose in tf.
+double timeCollision(const CollisionGeometry* o1, const CollisionGeometry* o2,
+                     const std::vector<Transform3f>& tf,
+                     const CollisionRequest& request,
+                     std::size_t& num_collisions) {
+  ComputeCollision calc_collision(o1, o2);
+  num_collisions = 0;
+
+  BenchTimer timer;
+  timer.start();
+  for (size_t i = 0; i < tf.size(); ++i) {
+    CollisionResult result;
+    if (calc_collision(tf[i], Transform3f::Identity(), request, result) > 0)
+      ++num_collisions;
+  }
+  timer.stop();
+  return timer.getElapsedTimeInMicroSec() / (double)tf.size();
+}
+
+void runScene(const std::string& name, const CollisionGeometry* o1,
+              const CollisionGeometry* o2,
+              const std::vector<Transform3f>& tf) {
+  std::size_t boolean_collisions, contact_collisions;
+  const double boolean_time = timeCollision(
+      o1, o2, tf, CollisionRequest(NO_REQUEST, 1), boolean_collisions);
+  const double contact_time = timeCollision(
+      o1, o2, tf, CollisionRequest(CONTACT, 1), contact_collisions);
+
+  std::cout << std::setw(20) << std::left << name << std::right
+            << " boolean: " << std::setw(8) << boolean_time << " us"
+            << "   contact: " << std::setw(8) << contact_time << " us"
+            << "   collisions: " << boolean_collisions << " / "
+            << contact_collisions << "\n";
+}
+
+int main() {
+  const size_t n = 100000;
+  FCL_REAL extents[] = {-1, -1, -1, 1, 1, 1};
+  std::vector<Transform3f> tf;
+  generateRandomTransforms(extents, tf, n);
+
+  Box box(0.4, 0.6, 0.3);
+  Capsule capsule(0.1, 0.6);
+  Cone cone(0.3, 0.5);
+  Cylinder cylinder(0.2, 0.5);
+  Ellipsoid ellipsoid(0.2, 0.3, 0.4);
+  runScene("box-box", &box, &box, tf);
+  runScene("box-ellipsoid", &box, &ellipsoid, tf);
+  runScene("capsule-cone", &capsule, &cone, tf);
+  runScene("cylinder-ellipsoid", &cylinder, &ellipsoid, tf);
+
+  BVHModel<OBBRSS> mesh;
+  generateBVHModel(mesh, Sphere(0.4), Transform3f(), 16, 16);
+  runScene("mesh-capsule", &mesh, &capsule, tf);
+  runScene("mesh-ellipsoid", &mesh, &ellipsoid, tf);
+  return 0;
+}
@@ -0,0 +1,158 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/// Measures the time of the collision and distance queries between a point
+/// cloud of one million points and a few shapes, a triangle mesh and a height
+/// field, and compares it with testing each point separately.
+///
+/// Usage: test-benchmark-point-cloud
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/hfield.h>
+#include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// @brief Time per query, in microseconds, of the collision queries between
+/// the cloud and geom at the given placements.
+double runCollision(const CollisionGeometry* cloud,
+                    const CollisionGeometry* geom,
+                    const std::vector<Transform3f>& transforms) {
+  CollisionRequest request;
+  BenchTimer timer;
+  timer.start();
+  for (std::size_t i = 0; i < transforms.size(); ++i) {
+    CollisionResult result;
+    collide(cloud, Transform3f(), geom, transforms[i], request, result);
+  }
+  timer.stop();
+  return timer.getElapsedTimeInMicroSec() / (double)transforms.size();
+}
+
+/// @brief Time per query, in microseconds, of the distance queries between
+/// the cloud and geom at the given placements.
+double runDistance(const CollisionGeometry* cloud,
+                   const CollisionGeometry* geom,
+                   const std::vector<Transform3f>& transforms) {
+  DistanceRequest request;
+  BenchTimer timer;
+  timer.start();
+  for (std::size_t i = 0; i < transforms.size(); ++i) {
+    DistanceResult result;
+    distance(cloud, Transform3f(), geom, transforms[i], request, result);
+  }
+  timer.stop();
+  return timer.getElapsedTimeInMicroSec() / (double)transforms.size();
+}
+
+/// @brief Time per query, in microseconds, of the collision queries between
+/// each point of the cloud, taken as a sphere, and geom.
+double runBruteForce(const BVHModelBase& cloud, const CollisionGeometry* geom,
+                     const std::vector<Transform3f>& transforms) {
+  Sphere sphere(cloud.point_radius);
+  CollisionRequest request;
+  BenchTimer timer;
+  timer.start();
+  for (std::size_t i = 0; i < transforms.size(); ++i) {
+    for (unsigned int j = 0; j < cloud.num_vertices; ++j) {
+      CollisionResult result;
+      if (collide(&sphere, Transform3f(cloud.vertices[j]), geom, transforms[i],
+                  request, result))
+        break;
+    }
+  }
+  timer.stop();
+  return timer.getElapsedTimeInMicroSec() / (double)transforms.size();
+}
+
+int main() {
+  const std::size_t n_points = 1000000;
+  std::vector<Vec3f> points(n_points);
+  for (std::size_t i = 0; i < n_points; ++i) points[i] = Vec3f::Random();
+
+  BVHModel<OBBRSS> cloud;
+  BenchTimer timer;
+  timer.start();
+  cloud.beginModel();
+  cloud.addSubModel(points);
+  cloud.endModel();
+  timer.stop();
+  cloud.point_radius = 0.005;
+  cloud.computeLocalAABB();
+  std::cout << "cloud: " << n_points << " points, build "
+            << timer.getElapsedTimeInMilliSec() << " ms\n";
+
+  FCL_REAL extents[] = {-2, -2, -2, 2, 2, 2};
+  std::vector<Transform3f> transforms;
+  generateRandomTransforms(extents, transforms, 200);
+
+  Sphere sphere(0.2);
+  Capsule capsule(0.1, 0.4);
+  Box box(0.3, 0.2, 0.4);
+  BVHModel<OBBRSS> mesh;
+  generateBVHModel(mesh, Sphere(0.2), Transform3f(), 16, 16);
+  HeightField<OBBRSS> hfield(1, 1, 0.1 * MatrixXf::Random(50, 50), -0.2);
+  const CollisionGeometry* geoms[] = {&sphere, &capsule, &box, &mesh, &hfield};
+  const char* names[] = {"sphere", "capsule", "box", "mesh", "hfield"};
+
+  std::cout << std::setw(10) << std::left << "object" << std::right
+            << std::setw(16) << "collide (us)" << std::setw(16)
+            << "distance (us)" << std::setw(18) << "per point (us)"
+            << "\n";
+  std::cout << std::setprecision(3) << std::fixed;
+  for (int g = 0; g < 5; ++g) {
+    std::cout << std::setw(10) << std::left << names[g] << std::right
+              << std::setw(16) << runCollision(&cloud, geoms[g], transforms);
+    if (g != 4)
+      std::cout << std::setw(16) << runDistance(&cloud, geoms[g], transforms);
+    else
+      std::cout << std::setw(16) << "-";
+    // The per point loop is only run on the shapes, for a few placements.
+    if (g < 3) {
+      const std::vector<Transform3f> few(transforms.begin(),
+                                         transforms.begin() + 5);
+      std::cout << std::setw(18) << runBruteForce(cloud, geoms[g], few);
+    }
+    std::cout << "\n";
+  }
+  return 0;
+}
@@ -0,0 +1,219 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/// Runs collision and distance queries on the test scenes and reports the
+/// time spent in each of them, for the scalar type the library is built with
+/// (see the CMake option HPP_FCL_USE_FLOAT).
+///
+/// Usage: test-benchmark-precision [output [reference]]
+///   - output: file where the result of every query is written,
+///   - reference: file written by another build of this program, usually the
+///     double precision one, against which the results are compared.
+
+#include <boost/filesystem.hpp>
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+
+#include "utility.h"
+#include "fcl_resources/config.h"
+
+using namespace hpp::fcl;
+
+/// @brief Result of one query
+struct QueryRecord {
+  bool collision;
+  double distance;
+};
+
+typedef std::map<std::string, std::vector<QueryRecord> > Records;
+
+/// @brief Run collision and distance queries between o1 and o2 for every
+/// pose in tf and store their results in records.
+void runScene(const std::string& name, const CollisionGeometry* o1,
+              const CollisionGeometry* o2, const std::vector<Transform3f>& tf,
+              Records& records) {
+  ComputeCollision calc_collision(o1, o2);
+  ComputeDistance calc_distance(o1, o2);
+  CollisionRequest collision_request;
+  DistanceRequest distance_request;
+  std::vector<QueryRecord>& record = records[name];
+  record.resize(tf.size());
+
+  BenchTimer timer;
+  timer.start();
+  for (size_t i = 0; i < tf.size(); ++i) {
+    CollisionResult result;
+    record[i].collision = calc_collision(tf[i], Transform3f::Identity(),
+                                         collision_request, result) > 0;
+  }
+  timer.stop();
+  const double collision_time = timer.getElapsedTimeInMilliSec();
+
+  timer.start();
+  for (size_t i = 0; i < tf.size(); ++i) {
+    DistanceResult result;
+    record[i].distance = (double)calc_distance(tf[i], Transform3f::Identity(),
+                                               distance_request, result);
+  }
+  timer.stop();
+  const double distance_time = timer.getElapsedTimeInMilliSec();
+
+  std::cout << std::setw(24) << std::left << name << std::right
+            << " collision: " << std::setw(9) << collision_time << " ms"
+            << "   distance: " << std::setw(9) << distance_time << " ms\n";
+}
+
+void writeRecords(const char* filename, const Records& records) {
+  std::ofstream file(filename);
+  file << std::setprecision(17);
+  for (Records::const_iterator it = records.begin(); it != records.end();
+       ++it)
+    for (size_t i = 0; i < it->second.size(); ++i)
+      file << it->first << " " << i << " " << it->second[i].collision << " "
+           << it->second[i].distance << "\n";
+}
+
+bool readRecords(const char* filename, Records& records) {
+  std::ifstream file(filename);
+  if (!file) return false;
+  std::string name;
+  size_t i;
+  QueryRecord record;
+  while (file >> name >> i >> record.collision >> record.distance) {
+    std::vector<QueryRecord>& scene = records[name];
+    if (scene.size() <= i) scene.resize(i + 1);
+    scene[i] = record;
+  }
+  return true;
+}
+
+/// @brief Print the discrepancies between the results and the reference.
+/// The distances are only compared for the queries where the objects are
+/// disjoint in both results.
+void compareRecords(const Records& records, const Records& reference) {
+  std::cout << "\ncomparison with the reference:\n";
+  for (Records::const_iterator it = records.begin(); it != records.end();
+       ++it) {
+    Records::const_iterator ref = reference.find(it->first);
+    if (ref == reference.end() || ref->second.size() != it->second.size()) {
+      std::cout << it->first << ": no matching reference\n";
+      continue;
+    }
+    size_t collision_mismatches = 0, n = 0;
+    double max_error = 0, sum_error = 0, max_rel_error = 0;
+    for (size_t i = 0; i < it->second.size(); ++i) {
+      const QueryRecord &a = it->second[i], &b = ref->second[i];
+      if (a.collision != b.collision) ++collision_mismatches;
+      if (a.collision || b.collision) continue;
+      const double error = std::fabs(a.distance - b.distance);
+      max_error = std::max(max_error, error);
+      if (b.distance > 0)
+        max_rel_error = std::max(max_rel_error, error / b.distance);
+      sum_error += error;
+      ++n;
+    }
+    std::cout << std::setw(24) << std::left << it->first << std::right
+              << " collision mismatches: " << collision_mismatches << " / "
+              << it->second.size() << "   distance error: max " << max_error
+              << ", mean " << (n > 0 ? sum_error / (double)n : 0.)
+              << ", max relative " << max_rel_error << "\n";
+  }
+}
+
+int main(int argc, char** argv) {
+  std::cout << "scalar type: " << 8 * sizeof(FCL_REAL) << " bits\n";
+  Records records;
+
+  // Shapes at the scale of a robot.
+  {
+    const size_t n = 20000;
+    FCL_REAL extents[] = {-1, -1, -1, 1, 1, 1};
+    std::vector<Transform3f> tf;
+    generateRandomTransforms(extents, tf, n);
+
+    Box box(0.4, 0.6, 0.3);
+    Ellipsoid ellipsoid(0.2, 0.3, 0.4);
+    Capsule capsule(0.1, 0.6);
+    Cylinder cylinder(0.2, 0.5);
+    runScene("box-ellipsoid", &box, &ellipsoid, tf, records);
+    runScene("capsule-cylinder", &capsule, &cylinder, tf, records);
+    runScene("ellipsoid-cylinder", &ellipsoid, &cylinder, tf, records);
+  }
+
+  // Meshes of the test resources, which span several thousands of units.
+  {
+    const size_t n = 2000;
+    FCL_REAL extents[] = {-3000, -3000, -3000, 3000, 3000, 3000};
+    std::vector<Transform3f> tf;
+    generateRandomTransforms(extents, tf, n);
+
+    std::vector<Vec3f> p1, p2;
+    std::vector<Triangle> t1, t2;
+    boost::filesystem::path path(TEST_RESOURCES_DIR);
+    loadOBJFile((path / "env.obj").string().c_str(), p1, t1);
+    loadOBJFile((path / "rob.obj").string().c_str(), p2, t2);
+
+    BVHModel<OBBRSS> env, rob;
+    env.beginModel();
+    env.addSubModel(p1, t1);
+    env.endModel();
+    rob.beginModel();
+    rob.addSubModel(p2, t2);
+    rob.endModel();
+    runScene("rob-env-OBBRSS", &rob, &env, tf, records);
+  }
+
+  if (argc > 1) writeRecords(argv[1], records);
+  if (argc > 2) {
+    Records reference;
+    if (!readRecords(argv[2], reference)) {
+      std::cerr << "cannot read " << argv[2] << std::endl;
+      return 1;
+    }
+    compareRecords(records, reference);
+  }
+  return 0;
+}
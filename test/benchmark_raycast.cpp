@@ -0,0 +1,148 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/// Measures the number of rays per second cast on the environment mesh of
+/// the test resources, ray by ray and by packets of 4 and 8 rays, for the
+/// coherent rays of a camera and for random rays.
+///
+/// Usage: test-benchmark-raycast
+
+#include <boost/filesystem.hpp>
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/raycast.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// @brief Rays of a pinhole camera of resolution n x n placed at eye and
+/// looking at target.
+std::vector<Ray> cameraRays(const Vec3f& eye, const Vec3f& target,
+                            FCL_REAL field_of_view, int n) {
+  const Vec3f forward((target - eye).normalized());
+  Vec3f right(forward.cross(Vec3f::UnitZ()));
+  if (right.squaredNorm() < 1e-12) right = forward.cross(Vec3f::UnitX());
+  right.normalize();
+  const Vec3f up(right.cross(forward));
+  const FCL_REAL scale = std::tan(field_of_view / 2);
+
+  std::vector<Ray> rays;
+  rays.reserve((std::size_t)(n * n));
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      const FCL_REAL u = scale * (2 * (j + .5) / n - 1);
+      const FCL_REAL v = scale * (1 - 2 * (i + .5) / n);
+      rays.push_back(Ray(eye, forward + u * right + v * up));
+    }
+  }
+  return rays;
+}
+
+/// @brief Random rays between random points of the box [lo, hi].
+std::vector<Ray> randomRays(const Vec3f& lo, const Vec3f& hi, std::size_t n) {
+  std::vector<Ray> rays;
+  rays.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const Vec3f a(lo + (hi - lo).cwiseProduct(
+                           (Vec3f::Random() + Vec3f::Ones()) / 2));
+    const Vec3f b(lo + (hi - lo).cwiseProduct(
+                           (Vec3f::Random() + Vec3f::Ones()) / 2));
+    rays.push_back(Ray(a, b - a));
+  }
+  return rays;
+}
+
+void runScene(const std::string& name, const CollisionGeometry* geom,
+              const std::vector<Ray>& rays) {
+  std::vector<RayResult> results(rays.size());
+  const RayHitMode modes[] = {RAY_CLOSEST_HIT, RAY_ANY_HIT};
+  const char* mode_names[] = {"closest", "any"};
+  const unsigned int packet_sizes[] = {1, 4, 8};
+
+  for (int m = 0; m < 2; ++m) {
+    std::cout << std::setw(20) << std::left << name << std::setw(8)
+              << mode_names[m] << std::right;
+    std::size_t num_hits = 0;
+    for (int p = 0; p < 3; ++p) {
+      const RayRequest request(modes[m], packet_sizes[p]);
+      BenchTimer timer;
+      timer.start();
+      num_hits = raycast(geom, Transform3f::Identity(), rays.data(),
+                         rays.size(), request, results.data());
+      timer.stop();
+      const double rays_per_second =
+          (double)rays.size() / timer.getElapsedTimeInSec();
+      std::cout << "  packet " << packet_sizes[p] << ": " << std::setw(10)
+                << (long)rays_per_second << " rays/s";
+    }
+    std::cout << "   hits: " << num_hits << " / " << rays.size() << "\n";
+  }
+}
+
+template <typename BV>
+void runModel(const std::string& name, const std::vector<Vec3f>& points,
+              const std::vector<Triangle>& triangles) {
+  BVHModel<BV> env;
+  env.beginModel();
+  env.addSubModel(points, triangles);
+  env.endModel();
+  env.computeLocalAABB();
+  const AABB& aabb = env.aabb_local;
+  const Vec3f center(aabb.center());
+  const Vec3f size(aabb.max_ - aabb.min_);
+
+  const std::vector<Ray> camera(cameraRays(
+      center + Vec3f(0.1, -0.8, 0.6).cwiseProduct(size), center, 1., 512));
+  runScene(name + " camera", &env, camera);
+  const std::vector<Ray> random(randomRays(aabb.min_, aabb.max_, 200000));
+  runScene(name + " random", &env, random);
+}
+
+int main() {
+  std::vector<Vec3f> points;
+  std::vector<Triangle> triangles;
+  boost::filesystem::path path(TEST_RESOURCES_DIR);
+  loadOBJFile((path / "env.obj").string().c_str(), points, triangles);
+
+  runModel<AABB>("AABB", points, triangles);
+  runModel<OBBRSS>("OBBRSS", points, triangles);
+  runModel<KDOP<18> >("KDOP18", points, triangles);
+  return 0;
+}
@@ -0,0 +1,131 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/// Compares the time of the distance queries between the environment mesh of
+/// the test resources and a few shapes, computed on the mesh and on its
+/// signed distance field, for several voxel sizes.
+///
+/// Usage: test-benchmark-sdf
+
+#include <boost/filesystem.hpp>
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/sdf.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// @brief Time per query, in microseconds, of the distance queries between
+/// geom and the shape at the given placements.
+double run(const CollisionGeometry* geom, const ShapeBase& shape,
+           const std::vector<Transform3f>& transforms) {
+  DistanceRequest request(true);
+  BenchTimer timer;
+  timer.start();
+  for (std::size_t i = 0; i < transforms.size(); ++i) {
+    DistanceResult result;
+    distance(geom, Transform3f(), &shape, transforms[i], request, result);
+  }
+  timer.stop();
+  return timer.getElapsedTimeInMicroSec() / (double)transforms.size();
+}
+
+int main() {
+  std::vector<Vec3f> points;
+  std::vector<Triangle> triangles;
+  boost::filesystem::path path(TEST_RESOURCES_DIR);
+  loadOBJFile((path / "env.obj").string().c_str(), points, triangles);
+
+  BVHModel<OBBRSS> mesh;
+  mesh.beginModel();
+  mesh.addSubModel(points, triangles);
+  mesh.endModel();
+  mesh.computeLocalAABB();
+  const AABB& aabb = mesh.aabb_local;
+  const FCL_REAL size = (aabb.max_ - aabb.min_).maxCoeff();
+  std::cout << "mesh: " << mesh.num_tris << " triangles, size " << size
+            << "\n";
+
+  std::vector<Transform3f> transforms(2000);
+  for (std::size_t i = 0; i < transforms.size(); ++i) {
+    transforms[i].setQuatRotation(Quaternion3f::UnitRandom());
+    transforms[i].setTranslation(
+        aabb.min_ + (aabb.max_ - aabb.min_)
+                        .cwiseProduct((Vec3f::Random() + Vec3f::Ones()) / 2));
+  }
+
+  const FCL_REAL r = size / 50;
+  Sphere sphere(r);
+  Capsule capsule(r, 2 * r);
+  Box box(2 * r, r, 3 * r);
+  const ShapeBase* shapes[] = {&sphere, &capsule, &box};
+  const char* names[] = {"sphere", "capsule", "box"};
+
+  const FCL_REAL voxel_ratios[] = {100, 200};
+  std::vector<SignedDistanceField> fields;
+  for (int v = 0; v < 2; ++v) {
+    BenchTimer timer;
+    timer.start();
+    fields.push_back(SignedDistanceField(mesh, size / voxel_ratios[v]));
+    timer.stop();
+    std::cout << "voxel size 1/" << voxel_ratios[v] << ": build "
+              << timer.getElapsedTimeInMilliSec() << " ms, "
+              << fields.back().getNumSampledBricks() << " / "
+              << fields.back().getNumBricks().prod() << " bricks sampled\n";
+  }
+
+  std::cout << std::setw(10) << std::left << "shape" << std::right
+            << std::setw(12) << "mesh (us)" << std::setw(14) << "sdf 1/100"
+            << std::setw(14) << "sdf 1/200" << "\n";
+  std::cout << std::setprecision(3) << std::fixed;
+  for (int s = 0; s < 3; ++s) {
+    const double time_mesh = run(&mesh, *shapes[s], transforms);
+    std::cout << std::setw(10) << std::left << names[s] << std::right
+              << std::setw(12) << time_mesh;
+    for (int v = 0; v < 2; ++v) {
+      const double time = run(&fields[v], *shapes[s], transforms);
+      std::cout << std::setw(8) << time << " (x" << std::setprecision(0)
+                << time_mesh / time << ")" << std::setprecision(3);
+    }
+    std::cout << "\n";
+  }
+  return 0;
+}
@@ -0,0 +1,167 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/// Compares the BVH traversal dispatched through the virtual methods of the
+/// traversal node base classes with the traversal instantiated for the
+/// concrete traversal node type.
+
+#include <iostream>
+#include <vector>
+
+#include <hpp/fcl/internal/traversal_node_setup.h>
+#include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
+#include <hpp/fcl/internal/collision_node.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// @brief Time the collision queries on the poses tf, once with the virtual
+/// traversal and once with the traversal instantiated for Node.
+template <typename Node, typename Init>
+void compareCollision(const char* name, const std::vector<Transform3f>& tf,
+                      const CollisionRequest& request, Init init) {
+  BenchTimer timer;
+  double times[2];
+  size_t num_contacts[2] = {0, 0};
+  for (int k = 0; k < 2; ++k) {
+    timer.start();
+    for (size_t i = 0; i < tf.size(); ++i) {
+      CollisionResult result;
+      Node node(request);
+      init(node, tf[i], result);
+      if (k == 0)
+        collide(static_cast<CollisionTraversalNodeBase*>(&node), request,
+                result);
+      else
+        collide(&node, request, result);
+      num_contacts[k] += result.numContacts();
+    }
+    timer.stop();
+    times[k] = timer.getElapsedTimeInMicroSec();
+  }
+  std::cout << name << "\n  virtual:  " << times[0] * 1e-3 << " ms"
+            << "\n  template: " << times[1] * 1e-3 << " ms ("
+            << 100 * (1 - times[1] / times[0]) << "% saved)\n";
+  if (num_contacts[0] != num_contacts[1])
+    std::cout << "  mismatch in the number of contacts: " << num_contacts[0]
+              << " != " << num_contacts[1] << "\n";
+}
+
+/// @brief Time the distance queries on the poses tf, once with the virtual
+/// traversal and once with the traversal instantiated for Node.
+template <typename Node, typename Init>
+void compareDistance(const char* name, const std::vector<Transform3f>& tf,
+                     const DistanceRequest& request, Init init) {
+  BenchTimer timer;
+  double times[2];
+  FCL_REAL sum_distances[2] = {0, 0};
+  for (int k = 0; k < 2; ++k) {
+    timer.start();
+    for (size_t i = 0; i < tf.size(); ++i) {
+      DistanceResult result;
+      Node node;
+      init(node, tf[i], request, result);
+      if (k == 0)
+        distance(static_cast<DistanceTraversalNodeBase*>(&node));
+      else
+        distance(&node);
+      sum_distances[k] += result.min_distance;
+    }
+    timer.stop();
+    times[k] = timer.getElapsedTimeInMicroSec();
+  }
+  std::cout << name << "\n  virtual:  " << times[0] * 1e-3 << " ms"
+            << "\n  template: " << times[1] * 1e-3 << " ms ("
+            << 100 * (1 - times[1] / times[0]) << "% saved)\n";
+  if (sum_distances[0] != sum_distances[1])
+    std::cout << "  mismatch in the distances\n";
+}
+
+int main() {
+  const size_t n = 2000;
+  FCL_REAL extents[] = {-1, -1, -1, 1, 1, 1};
+  std::vector<Transform3f> tf;
+  generateRandomTransforms(extents, tf, n);
+  const Transform3f identity(Transform3f::Identity());
+
+  BVHModel<OBBRSS> mesh1, mesh2;
+  generateBVHModel(mesh1, Sphere(1), identity, 32, 32);
+  generateBVHModel(mesh2, Box(1.5, 1, 0.5), identity);
+
+  Sphere sphere(0.5);
+  Box box(0.4, 0.6, 0.3);
+  GJKSolver solver;
+
+  MatrixXf heights(64, 64);
+  for (Eigen::Index i = 0; i < heights.rows(); ++i)
+    for (Eigen::Index j = 0; j < heights.cols(); ++j)
+      heights(i, j) = 0.2 * std::sin(0.3 * (FCL_REAL)i) *
+                      std::cos(0.2 * (FCL_REAL)j);
+  HeightField<OBBRSS> hfield(4, 4, heights, -1);
+
+  // Report every contact so that the traversal is not stopped early.
+  CollisionRequest request(CONTACT, 100000);
+  std::cout << n << " queries\n";
+
+  compareCollision<MeshCollisionTraversalNodeOBBRSS>(
+      "mesh-mesh collision", tf, request,
+      [&](MeshCollisionTraversalNodeOBBRSS& node, const Transform3f& tf1,
+          CollisionResult& result) {
+        initialize(node, mesh1, tf1, mesh2, identity, result);
+      });
+
+  compareCollision<MeshShapeCollisionTraversalNode<OBBRSS, Box, 0> >(
+      "mesh-shape collision", tf, request,
+      [&](MeshShapeCollisionTraversalNode<OBBRSS, Box, 0>& node,
+          const Transform3f& tf1, CollisionResult& result) {
+        initialize(node, mesh1, tf1, box, identity, &solver, result);
+      });
+
+  compareCollision<HeightFieldShapeCollisionTraversalNode<OBBRSS, Sphere, 0> >(
+      "hfield-shape collision", tf, request,
+      [&](HeightFieldShapeCollisionTraversalNode<OBBRSS, Sphere, 0>& node,
+          const Transform3f& tf1, CollisionResult& result) {
+        initialize(node, hfield, identity, sphere, tf1, &solver, result);
+      });
+
+  compareDistance<MeshDistanceTraversalNodeOBBRSS>(
+      "mesh-mesh distance", tf, DistanceRequest(),
+      [&](MeshDistanceTraversalNodeOBBRSS& node, const Transform3f& tf1,
+          const DistanceRequest& request, DistanceResult& result) {
+        initialize(node, mesh1, tf1, mesh2, identity, request, result);
+      });
+  return 0;
+}
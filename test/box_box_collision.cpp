@@ -4,6 +4,7 @@
 #include <Eigen/Geometry>
 #include <hpp/fcl/narrowphase/narrowphase.h>
 #include <hpp/fcl/shape/geometric_shapes.h>
+#include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
 #include <hpp/fcl/internal/tools.h>
 
 #include "utility.h"
@@ -45,3 +46,169 @@ BOOST_AUTO_TEST_CASE(box_box_collision) {
   res.clear();
   BOOST_CHECK(collide_functor(T1, T2, req, res) == false);
 }
+
+BOOST_AUTO_TEST_CASE(box_box_collision_batch) {
+  Box shape1(1, 2, 3);
+  Box shape2(2, 1, 1);
+
+  const std::size_t n = 1000;
+  FCL_REAL extents[] = {-3, -3, -3, 3, 3, 3};
+  std::vector<Transform3f> tf1, tf2;
+  generateRandomTransforms(extents, tf1, n);
+  generateRandomTransforms(extents, tf2, n);
+
+  CollisionRequest req(hpp::fcl::CONTACT, 1);
+  ComputeCollision collide_functor(&shape1, &shape2);
+
+  std::vector<CollisionResult> expected(n);
+  std::size_t num_collisions = 0;
+  for (std::size_t i = 0; i < n; ++i)
+    num_collisions += collide_functor(tf1[i], tf2[i], req, expected[i]);
+  BOOST_CHECK(num_collisions > 0 && num_collisions < n);
+
+  // The chained guesses must not change the results.
+  CollisionRequest cached_req(req);
+  cached_req.gjk_initial_guess = hpp::fcl::GJKInitialGuess::CachedGuess;
+
+  const int num_threads[] = {1, 0, 3};
+  for (int threads : num_threads) {
+    for (const CollisionRequest& request : {req, cached_req}) {
+      std::vector<CollisionResult> results(n);
+      BOOST_CHECK_EQUAL(collide_functor(tf1.data(), tf2.data(), n, request,
+                                        results.data(), threads),
+                        num_collisions);
+      for (std::size_t i = 0; i < n; ++i) {
+        BOOST_CHECK_EQUAL(results[i].isCollision(), expected[i].isCollision());
+        if (results[i].isCollision() && expected[i].isCollision())
+          BOOST_CHECK_SMALL(results[i].getContact(0).penetration_depth -
+                                expected[i].getContact(0).penetration_depth,
+                            1e-6);
+      }
+    }
+  }
+
+  std::vector<CollisionResult> results(n);
+  BOOST_CHECK_EQUAL(collide(&shape1, tf1.data(), &shape2, tf2.data(), n, req,
+                            results.data(), 2),
+                    num_collisions);
+
+  // The errors of the queries are reported, also from the threads.
+  hpp::fcl::BVHModel<hpp::fcl::OBBRSS> mesh1;
+  hpp::fcl::generateBVHModel(mesh1, shape1, Transform3f::Identity());
+  ComputeCollision mesh_collide_functor(&mesh1, &shape2);
+  CollisionRequest negative_margin_req(req);
+  negative_margin_req.security_margin = -0.01;
+  for (int threads : num_threads)
+    BOOST_CHECK_THROW(mesh_collide_functor(tf1.data(), tf2.data(), n,
+                                           negative_margin_req, results.data(),
+                                           threads),
+                      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(box_box_collision_batch_contacts) {
+  hpp::fcl::BVHModel<hpp::fcl::OBBRSS> mesh1, mesh2;
+  hpp::fcl::generateBVHModel(mesh1, Box(1, 1, 1), Transform3f::Identity());
+  hpp::fcl::generateBVHModel(mesh2, Box(1, 1, 1), Transform3f::Identity());
+
+  // One query with several contacts, and one without collision.
+  const Transform3f tf1[] = {Transform3f(), Transform3f()};
+  const Transform3f tf2[] = {Transform3f(Vec3f(0.5, 0.5, 0)),
+                             Transform3f(Vec3f(3, 0, 0))};
+  CollisionRequest req(hpp::fcl::CONTACT, 10);
+  ComputeCollision collide_functor(&mesh1, &mesh2);
+
+  CollisionResult results[2];
+  BOOST_CHECK_EQUAL(collide_functor(tf1, tf2, 2, req, results), 1);
+  BOOST_CHECK(results[0].numContacts() > 1);
+  BOOST_CHECK(!results[1].isCollision());
+}
+
+BOOST_AUTO_TEST_CASE(box_box_collision_contact_buffer) {
+  using hpp::fcl::BVHModel;
+  using hpp::fcl::Contact;
+  using hpp::fcl::OBBRSS;
+
+  BVHModel<OBBRSS> mesh1, mesh2;
+  hpp::fcl::generateBVHModel(mesh1, Box(1, 1, 1), Transform3f::Identity());
+  hpp::fcl::generateBVHModel(mesh2, Box(1, 1, 1), Transform3f::Identity());
+  ComputeCollision collide_functor(&mesh1, &mesh2);
+
+  const std::size_t capacity = 8;
+  CollisionRequest req(hpp::fcl::CONTACT, capacity);
+  CollisionResult res, buffered_res;
+  std::vector<Contact> buffer;
+  buffered_res.setContactBuffer(buffer, capacity);
+  BOOST_CHECK(buffered_res.hasContactBuffer());
+  BOOST_CHECK_EQUAL(buffered_res.contactCapacity(), capacity);
+  const Contact* data = buffer.data();
+
+  for (int i = 0; i < 20; ++i) {
+    Transform3f T1(Transform3f::Identity());
+    T1.setTranslation(Vec3f(0.05 * i, 0.2, 0.1));
+    res.clear();
+    buffered_res.clear();
+    collide_functor(T1, Transform3f::Identity(), req, res);
+    collide_functor(T1, Transform3f::Identity(), req, buffered_res);
+    BOOST_CHECK(res == buffered_res);
+    BOOST_CHECK(buffered_res.numContacts() <= capacity);
+    BOOST_CHECK(&buffered_res.getContacts() == &buffer);
+  }
+  BOOST_CHECK(buffered_res.isCollision());
+  // The buffer is never reallocated.
+  BOOST_CHECK_EQUAL(buffer.data(), data);
+
+  // Copies use their own storage, assignments keep the contact buffer.
+  CollisionResult copy(buffered_res);
+  BOOST_CHECK(!copy.hasContactBuffer());
+  BOOST_CHECK(copy == buffered_res);
+  buffered_res = CollisionResult();
+  BOOST_CHECK(buffered_res.hasContactBuffer());
+  BOOST_CHECK(buffer.empty());
+  buffered_res = copy;
+  BOOST_CHECK_EQUAL(buffer.size(), copy.numContacts());
+
+  // Assigning more contacts than the capacity grows the buffer.
+  CollisionResult large;
+  for (std::size_t i = 0; i < capacity + 2; ++i)
+    large.addContact(copy.getContact(0));
+  buffered_res = large;
+  BOOST_CHECK(buffered_res.hasContactBuffer());
+  BOOST_CHECK_EQUAL(buffered_res.contactCapacity(), capacity + 2);
+  BOOST_CHECK(buffered_res == large);
+  buffered_res = copy;
+
+  // Moves take over the storage of the moved result.
+  CollisionResult moved(std::move(buffered_res));
+  BOOST_CHECK(moved.hasContactBuffer());
+  BOOST_CHECK(&moved.getContacts() == &buffer);
+  BOOST_CHECK(!buffered_res.hasContactBuffer());
+  BOOST_CHECK_EQUAL(buffered_res.numContacts(), 0);
+  CollisionResult moved_copy(std::move(copy));
+  BOOST_CHECK(!moved_copy.hasContactBuffer());
+  BOOST_CHECK(moved_copy == moved);
+  copy = moved_copy;
+  // A result with a contact buffer keeps it when it is moved to.
+  moved = std::move(large);
+  BOOST_CHECK(&moved.getContacts() == &buffer);
+  BOOST_CHECK_EQUAL(buffer.size(), capacity + 2);
+  moved.resetContactBuffer();
+  buffered_res.setContactBuffer(buffer, capacity);
+  buffered_res = copy;
+
+  // The request cannot ask for more contacts than the buffer holds.
+  CollisionRequest large_req(hpp::fcl::CONTACT, capacity + 1);
+  BOOST_CHECK_THROW(collide_functor(Transform3f::Identity(),
+                                    Transform3f::Identity(), large_req,
+                                    buffered_res),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(collide(&mesh1, Transform3f::Identity(), &mesh2,
+                            Transform3f::Identity(), large_req, buffered_res),
+                    std::invalid_argument);
+
+  buffered_res.resetContactBuffer();
+  BOOST_CHECK(!buffered_res.hasContactBuffer());
+  BOOST_CHECK(buffered_res == copy);
+  BOOST_CHECK_NO_THROW(collide_functor(Transform3f::Identity(),
+                                       Transform3f::Identity(), large_req,
+                                       buffered_res));
+}
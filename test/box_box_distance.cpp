@@ -252,3 +252,51 @@ BOOST_AUTO_TEST_CASE(distance_box_box_4) {
   distance = -1;
   BOOST_CHECK_CLOSE(distanceResult.min_distance, distance, 2e-3);
 }
+
+BOOST_AUTO_TEST_CASE(distance_box_box_batch) {
+  hpp::fcl::Box s1(1, 2, 3);
+  hpp::fcl::Box s2(2, 1, 1);
+
+  const std::size_t n = 1000;
+  hpp::fcl::FCL_REAL extents[] = {-5, -5, -5, 5, 5, 5};
+  std::vector<Transform3f> tf1, tf2;
+  generateRandomTransforms(extents, tf1, n);
+  generateRandomTransforms(extents, tf2, n);
+
+  DistanceRequest request(true);
+  hpp::fcl::ComputeDistance distance_functor(&s1, &s2);
+
+  std::vector<DistanceResult> expected(n);
+  hpp::fcl::FCL_REAL min_distance =
+      (std::numeric_limits<hpp::fcl::FCL_REAL>::max)();
+  for (std::size_t i = 0; i < n; ++i)
+    min_distance = (std::min)(
+        min_distance, distance_functor(tf1[i], tf2[i], request, expected[i]));
+
+  // The chained guesses must not change the results.
+  DistanceRequest cached_request(request);
+  cached_request.gjk_initial_guess = hpp::fcl::GJKInitialGuess::CachedGuess;
+
+  const int num_threads[] = {1, 0, 3};
+  for (int threads : num_threads) {
+    for (const DistanceRequest& req : {request, cached_request}) {
+      std::vector<DistanceResult> results(n);
+      BOOST_CHECK_CLOSE(distance_functor(tf1.data(), tf2.data(), n, req,
+                                         results.data(), threads),
+                        min_distance, 1e-6);
+      for (std::size_t i = 0; i < n; ++i) {
+        BOOST_CHECK_SMALL(results[i].min_distance - expected[i].min_distance,
+                          1e-6);
+        BOOST_CHECK_SMALL((results[i].nearest_points[0] -
+                           expected[i].nearest_points[0])
+                              .norm(),
+                          1e-4);
+      }
+    }
+  }
+
+  std::vector<DistanceResult> results(n);
+  BOOST_CHECK_CLOSE(hpp::fcl::distance(&s1, tf1.data(), &s2, tf2.data(), n,
+                                       request, results.data(), 2),
+                    min_distance, 1e-6);
+}
@@ -330,6 +330,8 @@ void broad_phase_self_distance_test(double env_scale, std::size_t env_size,
 #endif
   managers.push_back(new DynamicAABBTreeCollisionManager());
   managers.push_back(new DynamicAABBTreeArrayCollisionManager());
+  managers.push_back(
+      new MBPCollisionManager(lower_limit, upper_limit, 4, 4, 4));
 
   {
     DynamicAABBTreeCollisionManager* m = new DynamicAABBTreeCollisionManager();
@@ -480,6 +482,8 @@ void broad_phase_distance_test(double env_scale, std::size_t env_size,
 #endif
   managers.push_back(new DynamicAABBTreeCollisionManager());
   managers.push_back(new DynamicAABBTreeArrayCollisionManager());
+  managers.push_back(
+      new MBPCollisionManager(lower_limit, upper_limit, 4, 4, 4));
 
   {
     DynamicAABBTreeCollisionManager* m = new DynamicAABBTreeCollisionManager();
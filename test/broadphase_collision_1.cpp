@@ -42,6 +42,7 @@
 #include "hpp/fcl/broadphase/broadphase_spatialhash.h"
 #include "hpp/fcl/broadphase/broadphase_SaP.h"
 #include "hpp/fcl/broadphase/broadphase_SSaP.h"
+#include "hpp/fcl/broadphase/broadphase_MBP.h"
 #include "hpp/fcl/broadphase/broadphase_interval_tree.h"
 #include "hpp/fcl/broadphase/broadphase_dynamic_AABB_tree.h"
 #include "hpp/fcl/broadphase/broadphase_dynamic_AABB_tree_array.h"
@@ -58,8 +59,10 @@
 #include <hash_map>
 #endif
 
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include <set>
 
 using namespace hpp::fcl;
 
@@ -68,6 +71,16 @@ using namespace hpp::fcl;
 void broad_phase_duplicate_check_test(FCL_REAL env_scale, std::size_t env_size,
                                       bool verbose = false);
 
+/// @brief make sure that broadphase algorithms only report the pairs of objects
+/// whose collision filters match
+void broad_phase_collision_filter_test(FCL_REAL env_scale,
+                                       std::size_t env_size);
+
+/// @brief make sure that the batched narrowphase gives the same results as
+/// the narrowphase called on each pair
+void broad_phase_batch_collision_test(FCL_REAL env_scale, std::size_t env_size,
+                                      bool parallel);
+
 /// @brief test for broad phase update
 void broad_phase_update_collision_test(FCL_REAL env_scale, std::size_t env_size,
                                        std::size_t query_size,
@@ -171,6 +184,26 @@ BOOST_AUTO_TEST_CASE(
 #endif
 }
 
+/// make sure that broadphase algorithms respect the collision groups and masks
+BOOST_AUTO_TEST_CASE(test_broad_phase_collision_filter) {
+#ifdef NDEBUG
+  broad_phase_collision_filter_test(200, 1000);
+#else
+  broad_phase_collision_filter_test(200, 100);
+#endif
+}
+
+/// check the batched narrowphase against the narrowphase on each pair
+BOOST_AUTO_TEST_CASE(test_broad_phase_batch_collision) {
+#ifdef NDEBUG
+  broad_phase_batch_collision_test(200, 1000, false);
+  broad_phase_batch_collision_test(200, 1000, true);
+#else
+  broad_phase_batch_collision_test(200, 100, false);
+  broad_phase_batch_collision_test(200, 100, true);
+#endif
+}
+
 //==============================================================================
 struct CollisionDataForUniquenessChecking {
   std::set<std::pair<CollisionObject*, CollisionObject*>> checkedPairs;
@@ -232,6 +265,8 @@ void broad_phase_duplicate_check_test(FCL_REAL env_scale, std::size_t env_size,
 #endif
   managers.push_back(new DynamicAABBTreeCollisionManager());
   managers.push_back(new DynamicAABBTreeArrayCollisionManager());
+  managers.push_back(
+      new MBPCollisionManager(lower_limit, upper_limit, 4, 4, 4));
 
   {
     DynamicAABBTreeCollisionManager* m = new DynamicAABBTreeCollisionManager();
@@ -404,6 +439,8 @@ void broad_phase_update_collision_test(FCL_REAL env_scale, std::size_t env_size,
 #endif
   managers.push_back(new DynamicAABBTreeCollisionManager());
   managers.push_back(new DynamicAABBTreeArrayCollisionManager());
+  managers.push_back(
+      new MBPCollisionManager(lower_limit, upper_limit, 4, 4, 4));
 
   {
     DynamicAABBTreeCollisionManager* m = new DynamicAABBTreeCollisionManager();
@@ -418,6 +455,15 @@ void broad_phase_update_collision_test(FCL_REAL env_scale, std::size_t env_size,
     managers.push_back(m);
   }
 
+  // These managers are updated one object at a time and with the set of
+  // objects.
+  const size_t single_update = managers.size();
+  managers.push_back(
+      new MBPCollisionManager(lower_limit, upper_limit, 4, 4, 4));
+  const size_t set_update = managers.size();
+  managers.push_back(
+      new MBPCollisionManager(lower_limit, upper_limit, 4, 4, 4));
+
   ts.resize(managers.size());
   timers.resize(managers.size());
 
@@ -466,7 +512,13 @@ void broad_phase_update_collision_test(FCL_REAL env_scale, std::size_t env_size,
 
   for (size_t i = 0; i < managers.size(); ++i) {
     timers[i].start();
-    managers[i]->update();
+    if (i == single_update) {
+      for (size_t j = 0; j < env.size(); ++j) managers[i]->update(env[j]);
+    } else if (i == set_update) {
+      managers[i]->update(env);
+    } else {
+      managers[i]->update();
+    }
     timers[i].stop();
     ts[i].push_back(timers[i].getElapsedTime());
   }
@@ -590,3 +642,185 @@ void broad_phase_update_collision_test(FCL_REAL env_scale, std::size_t env_size,
   std::cout << std::endl;
   std::cout << std::endl;
 }
+
+/// @brief Callback recording the pairs of objects reported by the broadphase
+struct CollisionCallBackPairs : CollisionCallBackBase {
+  void init() { pairs.clear(); }
+
+  bool collide(CollisionObject* o1, CollisionObject* o2) {
+    if (o2 < o1) std::swap(o1, o2);
+    pairs.insert(std::make_pair(o1, o2));
+    return false;
+  }
+
+  std::set<std::pair<CollisionObject*, CollisionObject*>> pairs;
+};
+
+//==============================================================================
+void broad_phase_collision_filter_test(FCL_REAL env_scale,
+                                       std::size_t env_size) {
+  std::vector<CollisionObject*> env;
+  generateEnvironments(env, env_scale, env_size);
+
+  // Three groups: objects of the first group ignore each other.
+  for (size_t i = 0; i < env.size(); ++i) {
+    CollisionGroup group = (CollisionGroup)1 << (i % 3);
+    env[i]->setCollisionGroup(group);
+    if (group == 1) env[i]->setCollisionMask(ALL_COLLISION_GROUPS & ~group);
+  }
+
+  std::vector<BroadPhaseCollisionManager*> managers;
+  managers.push_back(new NaiveCollisionManager());
+  managers.push_back(new SSaPCollisionManager());
+  managers.push_back(new SaPCollisionManager());
+  managers.push_back(new IntervalTreeCollisionManager());
+  Vec3f lower_limit, upper_limit;
+  SpatialHashingCollisionManager<>::computeBound(env, lower_limit, upper_limit);
+  FCL_REAL cell_size =
+      std::min(std::min((upper_limit[0] - lower_limit[0]) / 20,
+                        (upper_limit[1] - lower_limit[1]) / 20),
+               (upper_limit[2] - lower_limit[2]) / 20);
+  managers.push_back(
+      new SpatialHashingCollisionManager<
+          detail::SparseHashTable<AABB, CollisionObject*, detail::SpatialHash>>(
+          cell_size, lower_limit, upper_limit));
+  managers.push_back(new DynamicAABBTreeCollisionManager());
+  managers.push_back(new DynamicAABBTreeArrayCollisionManager());
+  managers.push_back(
+      new MBPCollisionManager(lower_limit, upper_limit, 4, 4, 4));
+
+  for (size_t i = 0; i < managers.size(); ++i) {
+    managers[i]->registerObjects(env);
+    managers[i]->setup();
+  }
+
+  for (int pass = 0; pass < 3; ++pass) {
+    if (pass == 1) {
+      // Let the second group ignore the third one and update the managers.
+      for (size_t i = 1; i < env.size(); i += 3)
+        env[i]->setCollisionMask(ALL_COLLISION_GROUPS & ~((CollisionGroup)4));
+      for (size_t i = 0; i < managers.size(); ++i) managers[i]->update();
+    } else if (pass == 2) {
+      // Move some objects of the first group into the third one, one at a
+      // time, so that the managers update and rebalance incrementally.
+      for (size_t i = 9; i < env.size(); i += 9) {
+        env[i]->setCollisionGroup(4);
+        env[i]->setCollisionMask(ALL_COLLISION_GROUPS);
+        env[i]->setTranslation(env[(i + 4) % env.size()]->getTranslation());
+        env[i]->computeAABB();
+        for (size_t j = 0; j < managers.size(); ++j)
+          managers[j]->update(env[i]);
+      }
+    }
+
+    std::set<std::pair<CollisionObject*, CollisionObject*>> expected;
+    for (size_t i = 0; i < env.size(); ++i) {
+      for (size_t j = i + 1; j < env.size(); ++j) {
+        if (env[i]->canCollideWith(*env[j]) &&
+            env[i]->getAABB().overlap(env[j]->getAABB())) {
+          CollisionObject* o1 = env[i];
+          CollisionObject* o2 = env[j];
+          if (o2 < o1) std::swap(o1, o2);
+          expected.insert(std::make_pair(o1, o2));
+        }
+      }
+    }
+    BOOST_CHECK(!expected.empty());
+
+    std::set<std::pair<CollisionObject*, CollisionObject*>> expected_query;
+    for (const auto& pair : expected)
+      if (pair.first == env[0] || pair.second == env[0])
+        expected_query.insert(pair);
+
+    // Some managers report candidate pairs whose AABB do not overlap: only
+    // check that the filtered pairs are never reported.
+    for (size_t i = 0; i < managers.size(); ++i) {
+      CollisionCallBackPairs callback;
+      managers[i]->collide(&callback);
+      for (const auto& pair : callback.pairs)
+        BOOST_CHECK(pair.first->canCollideWith(*pair.second));
+      BOOST_CHECK(std::includes(callback.pairs.begin(), callback.pairs.end(),
+                                expected.begin(), expected.end()));
+
+      // The query object belongs to the first group: it is tested against the
+      // second and third groups only.
+      CollisionCallBackPairs query_callback;
+      managers[i]->collide(env[0], &query_callback);
+      for (const auto& pair : query_callback.pairs)
+        BOOST_CHECK(pair.first->canCollideWith(*pair.second));
+      BOOST_CHECK(std::includes(query_callback.pairs.begin(),
+                                query_callback.pairs.end(),
+                                expected_query.begin(), expected_query.end()));
+    }
+  }
+
+  for (size_t i = 0; i < env.size(); ++i) delete env[i];
+  for (size_t i = 0; i < managers.size(); ++i) delete managers[i];
+}
+
+//==============================================================================
+void broad_phase_batch_collision_test(FCL_REAL env_scale, std::size_t env_size,
+                                      bool parallel) {
+  std::vector<CollisionObject*> env;
+  generateEnvironments(env, env_scale, env_size);
+  generateEnvironmentsMesh(env, env_scale, env_size / 10);
+
+  DynamicAABBTreeCollisionManager manager;
+  manager.registerObjects(env);
+  manager.setup();
+
+  CollisionRequest request(CONTACT, 4);
+  CollisionCallBackBatch callback(request, parallel);
+  manager.collide(&callback);
+  BOOST_CHECK(callback.numCollisionPairs() > 0);
+
+  size_t nb_collisions = callback.processPairs();
+  BOOST_CHECK(nb_collisions > 0);
+
+  const std::vector<CollisionCallBackBatch::CollisionPair>& pairs =
+      callback.getCollisionPairs();
+  const std::vector<CollisionCallBackBatch::CollisionPair>& colliding_pairs =
+      callback.getCollidingPairs();
+  const std::vector<CollisionResult>& results = callback.getResults();
+  BOOST_REQUIRE(results.size() == nb_collisions);
+  BOOST_REQUIRE(colliding_pairs.size() == nb_collisions);
+
+  size_t k = 0;
+  for (size_t i = 0; i < pairs.size(); ++i) {
+    CollisionResult result;
+    collide(pairs[i].first, pairs[i].second, request, result);
+    if (!result.isCollision()) continue;
+
+    // The pairs in collision are reported in the collection order.
+    BOOST_REQUIRE(k < nb_collisions);
+    BOOST_CHECK(colliding_pairs[k] == pairs[i]);
+    BOOST_REQUIRE(results[k].numContacts() == result.numContacts());
+    for (size_t c = 0; c < result.numContacts(); ++c) {
+      const Contact& contact = results[k].getContact(c);
+      const Contact& expected = result.getContact(c);
+      BOOST_CHECK(contact.o1 == expected.o1);
+      BOOST_CHECK(contact.o2 == expected.o2);
+      BOOST_CHECK(contact.b1 == expected.b1);
+      BOOST_CHECK(contact.b2 == expected.b2);
+      BOOST_CHECK(contact.pos.isApprox(expected.pos, 1e-6));
+    }
+    ++k;
+  }
+  BOOST_CHECK(k == nb_collisions);
+
+  // The errors of the narrowphase are reported, also when the pairs are
+  // processed in parallel. Negative security margins are not handled between
+  // a mesh and a shape.
+  CollisionCallBackBatch mesh_shape_callback(request, parallel);
+  for (size_t i = 0; i < pairs.size(); ++i) {
+    if ((pairs[i].first->getObjectType() == OT_BVH) !=
+        (pairs[i].second->getObjectType() == OT_BVH))
+      mesh_shape_callback.collide(pairs[i].first, pairs[i].second);
+  }
+  BOOST_REQUIRE(mesh_shape_callback.numCollisionPairs() > 0);
+  mesh_shape_callback.request.security_margin = -1e-3;
+  BOOST_CHECK_THROW(mesh_shape_callback.processPairs(), std::invalid_argument);
+  BOOST_CHECK(mesh_shape_callback.getResults().empty());
+
+  for (size_t i = 0; i < env.size(); ++i) delete env[i];
+}
@@ -42,6 +42,7 @@
 #include "hpp/fcl/broadphase/broadphase_spatialhash.h"
 #include "hpp/fcl/broadphase/broadphase_SaP.h"
 #include "hpp/fcl/broadphase/broadphase_SSaP.h"
+#include "hpp/fcl/broadphase/broadphase_MBP.h"
 #include "hpp/fcl/broadphase/broadphase_interval_tree.h"
 #include "hpp/fcl/broadphase/broadphase_dynamic_AABB_tree.h"
 #include "hpp/fcl/broadphase/broadphase_dynamic_AABB_tree_array.h"
@@ -234,6 +235,8 @@ void broad_phase_collision_test(FCL_REAL env_scale, std::size_t env_size,
   managers.push_back(new DynamicAABBTreeCollisionManager());
 
   managers.push_back(new DynamicAABBTreeArrayCollisionManager());
+  managers.push_back(
+      new MBPCollisionManager(lower_limit, upper_limit, 4, 4, 4));
 
   {
     DynamicAABBTreeCollisionManager* m = new DynamicAABBTreeCollisionManager();
@@ -0,0 +1,235 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_MODULE FCL_BROADPHASE_CONTINUOUS_COLLISION
+#include <boost/test/included/unit_test.hpp>
+
+#include <algorithm>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <hpp/fcl/broadphase/broadphase_continuous_dynamic_AABB_tree.h>
+#include <hpp/fcl/broadphase/default_broadphase_callbacks.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+typedef std::pair<ContinuousCollisionObject*, ContinuousCollisionObject*>
+    ObjectPair;
+typedef std::set<ObjectPair> ObjectPairSet;
+
+const CCDMotionType motion_types[] = {CCDM_LINEAR, CCDM_SCREW};
+
+ObjectPair orderedPair(ContinuousCollisionObject* o1,
+                       ContinuousCollisionObject* o2) {
+  return (o1 < o2) ? ObjectPair(o1, o2) : ObjectPair(o2, o1);
+}
+
+/// Random objects moving by up to 2 in translation and 1 in rotation.
+std::vector<ContinuousCollisionObject*> generateObjects(std::size_t n,
+                                                        CCDMotionType type) {
+  FCL_REAL extents[] = {-5, -5, -5, 5, 5, 5};
+  FCL_REAL delta_trans[] = {2, 2, 2};
+  std::vector<Transform3f> transforms, transforms2;
+  generateRandomTransforms(extents, delta_trans, 1, transforms, transforms2, n);
+
+  std::vector<ContinuousCollisionObject*> objects(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    shared_ptr<CollisionGeometry> geom;
+    switch (i % 3) {
+      case 0:
+        geom.reset(new Box(0.4, 0.6, 1.2));
+        break;
+      case 1:
+        geom.reset(new Sphere(0.5));
+        break;
+      default:
+        geom.reset(new Capsule(0.2, 1.));
+    }
+    objects[i] = new ContinuousCollisionObject(geom, transforms[i],
+                                               transforms2[i], type);
+  }
+  return objects;
+}
+
+void deleteObjects(std::vector<ContinuousCollisionObject*>& objects) {
+  for (std::size_t i = 0; i < objects.size(); ++i) delete objects[i];
+  objects.clear();
+}
+
+ObjectPairSet bruteForce(const std::vector<ContinuousCollisionObject*>& objs,
+                         const ContinuousCollisionRequest& request) {
+  ObjectPairSet pairs;
+  ContinuousCollisionResult result;
+  for (std::size_t i = 0; i < objs.size(); ++i)
+    for (std::size_t j = i + 1; j < objs.size(); ++j) {
+      continuousCollide(objs[i], objs[j], request, result);
+      if (result.is_collide) pairs.insert(orderedPair(objs[i], objs[j]));
+    }
+  return pairs;
+}
+
+ObjectPairSet collectedPairs(
+    const ContinuousCollisionCallBackCollect& callback) {
+  ObjectPairSet pairs;
+  for (std::size_t i = 0; i < callback.getCollidingPairs().size(); ++i)
+    pairs.insert(orderedPair(callback.getCollidingPairs()[i].first,
+                             callback.getCollidingPairs()[i].second));
+  return pairs;
+}
+
+BOOST_AUTO_TEST_CASE(swept_aabb) {
+  for (int m = 0; m < 2; ++m) {
+    std::vector<ContinuousCollisionObject*> objects =
+        generateObjects(60, motion_types[m]);
+    for (std::size_t i = 0; i < objects.size(); ++i) {
+      const Motion& motion = objects[i]->getMotion();
+      CollisionObject sample(objects[i]->collisionGeometry(), false);
+      for (int k = 0; k <= 50; ++k) {
+        sample.setTransform(motion.getTransform(k / 50.));
+        sample.computeAABB();
+        BOOST_CHECK(objects[i]->getAABB().contain(sample.getAABB()));
+      }
+    }
+    deleteObjects(objects);
+  }
+
+  // Without rotation, the swept AABB is the union of the end AABBs.
+  shared_ptr<CollisionGeometry> box(new Box(1, 2, 3));
+  ContinuousCollisionObject translated(box, Transform3f(Vec3f(0, 0, 0)),
+                                       Transform3f(Vec3f(4, 0, 0)));
+  BOOST_CHECK(translated.getAABB().min_.isApprox(Vec3f(-0.5, -1, -1.5)));
+  BOOST_CHECK(translated.getAABB().max_.isApprox(Vec3f(4.5, 1, 1.5)));
+}
+
+BOOST_AUTO_TEST_CASE(self_collision) {
+  for (int m = 0; m < 2; ++m) {
+    ContinuousCollisionRequest request(motion_types[m]);
+    std::vector<ContinuousCollisionObject*> objects =
+        generateObjects(90, motion_types[m]);
+    const ObjectPairSet expected = bruteForce(objects, request);
+    BOOST_CHECK(!expected.empty());
+
+    DynamicAABBTreeContinuousCollisionManager manager;
+    manager.registerObjects(objects);
+    manager.setup();
+    BOOST_CHECK_EQUAL(manager.size(), objects.size());
+
+    ContinuousCollisionCallBackCollect collect(request);
+    manager.collide(&collect);
+    BOOST_CHECK(collectedPairs(collect) == expected);
+
+    // The default callback finds the earliest contact.
+    ContinuousCollisionCallBackDefault earliest;
+    earliest.data.request = request;
+    manager.collide(&earliest);
+    BOOST_CHECK(earliest.data.result.is_collide);
+    FCL_REAL min_toc = 1;
+    for (std::size_t i = 0; i < collect.getResults().size(); ++i)
+      min_toc = std::min(min_toc, collect.getResults()[i].time_of_contact);
+    BOOST_CHECK_EQUAL(earliest.data.result.time_of_contact, min_toc);
+    BOOST_CHECK(expected.count(
+        orderedPair(earliest.data.o1, earliest.data.o2)));
+
+    // New motions, processed in one update.
+    FCL_REAL extents[] = {-5, -5, -5, 5, 5, 5};
+    FCL_REAL delta_trans[] = {2, 2, 2};
+    std::vector<Transform3f> transforms, transforms2;
+    generateRandomTransforms(extents, delta_trans, 1, transforms, transforms2,
+                             objects.size());
+    for (std::size_t i = 0; i < objects.size(); ++i) {
+      objects[i]->setMotion(transforms[i], transforms2[i]);
+      objects[i]->computeAABB();
+    }
+    manager.update();
+    manager.collide(&collect);
+    BOOST_CHECK(collectedPairs(collect) == bruteForce(objects, request));
+
+    manager.unregisterObject(objects.back());
+    BOOST_CHECK_EQUAL(manager.size(), objects.size() - 1);
+    manager.clear();
+    BOOST_CHECK(manager.empty());
+    deleteObjects(objects);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(collision_with_objects) {
+  ContinuousCollisionRequest request;
+  std::vector<ContinuousCollisionObject*> objects =
+      generateObjects(120, CCDM_LINEAR);
+  const std::vector<ContinuousCollisionObject*> objects1(
+      objects.begin(), objects.begin() + 60),
+      objects2(objects.begin() + 60, objects.end());
+
+  ObjectPairSet expected;
+  ContinuousCollisionResult result;
+  for (std::size_t i = 0; i < objects1.size(); ++i)
+    for (std::size_t j = 0; j < objects2.size(); ++j) {
+      continuousCollide(objects1[i], objects2[j], request, result);
+      if (result.is_collide)
+        expected.insert(orderedPair(objects1[i], objects2[j]));
+    }
+  BOOST_CHECK(!expected.empty());
+
+  DynamicAABBTreeContinuousCollisionManager manager1, manager2;
+  manager1.registerObjects(objects1);
+  manager1.setup();
+  manager2.registerObjects(objects2);
+  manager2.setup();
+
+  ContinuousCollisionCallBackCollect collect(request);
+  manager1.collide(&manager2, &collect);
+  BOOST_CHECK(collectedPairs(collect) == expected);
+
+  // One object against a manager, whether it is registered or not.
+  ObjectPairSet pairs;
+  for (std::size_t j = 0; j < objects2.size(); ++j) {
+    manager1.collide(objects2[j], &collect);
+    const ObjectPairSet object_pairs = collectedPairs(collect);
+    pairs.insert(object_pairs.begin(), object_pairs.end());
+  }
+  BOOST_CHECK(pairs == expected);
+
+  manager2.collide(objects2[0], &collect);
+  for (std::size_t i = 0; i < collect.getCollidingPairs().size(); ++i)
+    BOOST_CHECK(collect.getCollidingPairs()[i].first !=
+                collect.getCollidingPairs()[i].second);
+
+  manager1.clear();
+  manager2.clear();
+  deleteObjects(objects);
+}
@@ -141,3 +141,45 @@ BOOST_AUTO_TEST_CASE(DynamicAABBTreeCollisionManager_class) {
     dynamic_tree.distance(&callback);
   }
 }
+
+struct CountCallBack : CollisionCallBackBase {
+  CountCallBack() : count(0) {}
+
+  bool collide(CollisionObject*, CollisionObject*) {
+    ++count;
+    return false;
+  }
+
+  size_t count;
+};
+
+// Tests that the manager uses the world AABBs computed by computeAABBs for
+// objects moved without calling computeAABB.
+BOOST_AUTO_TEST_CASE(DynamicAABBTreeCollisionManager_computeAABBs) {
+  CollisionGeometryPtr_t sphere = make_shared<Sphere>(0.1);
+  CollisionObject object0(sphere);
+  CollisionObject object1(sphere);
+  std::vector<CollisionObject*> objects;
+  objects.push_back(&object0);
+  objects.push_back(&object1);
+
+  object0.setTranslation(Vec3f(1, 0, 0));
+  object1.setTranslation(Vec3f(1.15, 0, 0));
+  computeAABBs(objects);
+  DynamicAABBTreeCollisionManager dynamic_tree;
+  dynamic_tree.registerObjects(objects);
+  dynamic_tree.setup();
+  BOOST_CHECK(object0.getAABB().center().isApprox(Vec3f(1, 0, 0)));
+
+  CountCallBack callback;
+  dynamic_tree.collide(&callback);
+  BOOST_CHECK_EQUAL(callback.count, 1);
+
+  object1.setTranslation(Vec3f(-1, 0, 0));
+  computeAABBs(objects);
+  dynamic_tree.update(objects);
+  BOOST_CHECK(object1.getAABB().center().isApprox(Vec3f(-1, 0, 0)));
+  callback.count = 0;
+  dynamic_tree.collide(&callback);
+  BOOST_CHECK_EQUAL(callback.count, 0);
+}
@@ -0,0 +1,145 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_MODULE FCL_BROADPHASE_NEIGHBOR_QUERY
+#include <boost/test/included/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <hpp/fcl/broadphase/broadphase_dynamic_AABB_tree.h>
+#include <hpp/fcl/broadphase/broadphase_SaP.h>
+#include <hpp/fcl/distance.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+template <typename Manager>
+void check_neighbor_queries(const Manager& manager,
+                            const std::vector<CollisionObject*>& env,
+                            CollisionObject* query, FCL_REAL radius,
+                            std::size_t k, bool exact) {
+  // Brute force
+  std::vector<NeighborResult> expected;
+  for (std::size_t i = 0; i < env.size(); ++i) {
+    if (env[i] == query || !env[i]->canCollideWith(*query)) continue;
+    FCL_REAL d;
+    if (exact) {
+      DistanceResult result;
+      d = distance(query, env[i], DistanceRequest(), result);
+    } else
+      d = query->getAABB().distance(env[i]->getAABB());
+    expected.push_back(NeighborResult(env[i], d));
+  }
+  std::sort(expected.begin(), expected.end(),
+            [](const NeighborResult& a, const NeighborResult& b) {
+              return a.distance < b.distance;
+            });
+
+  std::size_t nb_in_radius = 0;
+  while (nb_in_radius < expected.size() &&
+         expected[nb_in_radius].distance <= radius)
+    ++nb_in_radius;
+
+  std::vector<NeighborResult> results;
+  BOOST_CHECK_EQUAL(manager.radiusQuery(query, radius, results, exact),
+                    nb_in_radius);
+  BOOST_REQUIRE_EQUAL(results.size(), nb_in_radius);
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    BOOST_CHECK_EQUAL(results[i].distance, expected[i].distance);
+    BOOST_CHECK(std::find(expected.begin(), expected.end(), results[i]) !=
+                expected.end());
+  }
+
+  const std::size_t nb_nearest = (std::min)(k, expected.size());
+  BOOST_CHECK_EQUAL(manager.nearestNeighbors(query, k, results, exact),
+                    nb_nearest);
+  BOOST_REQUIRE_EQUAL(results.size(), nb_nearest);
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    BOOST_CHECK_EQUAL(results[i].distance, expected[i].distance);
+    BOOST_CHECK(std::find(expected.begin(), expected.end(), results[i]) !=
+                expected.end());
+  }
+}
+
+void broad_phase_neighbor_query_test(double env_scale, std::size_t env_size,
+                                     std::size_t query_size, bool exact) {
+  std::vector<CollisionObject*> env;
+  generateEnvironments(env, env_scale, env_size);
+
+  // Some objects are filtered out by the collision groups.
+  for (std::size_t i = 0; i < env.size(); i += 7) env[i]->setCollisionGroup(2);
+
+  std::vector<CollisionObject*> query;
+  generateEnvironments(query, env_scale, query_size);
+  // A registered object is skipped by its own queries.
+  query.push_back(env[1]);
+  for (std::size_t i = 0; i < query.size(); i += 2)
+    query[i]->setCollisionMask(~CollisionGroup(2));
+
+  DynamicAABBTreeCollisionManager tree;
+  tree.registerObjects(env);
+  tree.setup();
+
+  SaPCollisionManager sap;
+  sap.registerObjects(env);
+  sap.setup();
+
+  const FCL_REAL radius = env_scale / 10;
+  const std::size_t k = 10;
+  for (std::size_t i = 0; i < query.size(); ++i) {
+    check_neighbor_queries(tree, env, query[i], radius, k, exact);
+    check_neighbor_queries(sap, env, query[i], radius, k, exact);
+  }
+
+  // The results contain all the objects when k exceeds their number.
+  std::vector<NeighborResult> results;
+  BOOST_CHECK_EQUAL(tree.nearestNeighbors(query[0], 2 * env.size(), results),
+                    env.size() - (env.size() + 6) / 7);
+  BOOST_CHECK_EQUAL(sap.nearestNeighbors(query[0], 2 * env.size(), results),
+                    env.size() - (env.size() + 6) / 7);
+
+  query.pop_back();
+  for (std::size_t i = 0; i < env.size(); ++i) delete env[i];
+  for (std::size_t i = 0; i < query.size(); ++i) delete query[i];
+}
+
+/// check broad phase radius and nearest neighbor queries
+BOOST_AUTO_TEST_CASE(test_broad_phase_neighbor_query) {
+  broad_phase_neighbor_query_test(200, 1000, 20, false);
+  broad_phase_neighbor_query_test(200, 1000, 20, true);
+  broad_phase_neighbor_query_test(2000, 100, 20, false);
+  broad_phase_neighbor_query_test(2000, 100, 20, true);
+}
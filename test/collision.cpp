@@ -51,7 +51,7 @@
 
 #include <hpp/fcl/internal/traversal_node_bvhs.h>
 #include <hpp/fcl/internal/traversal_node_setup.h>
-#include "../src/collision_node.h"
+#include <hpp/fcl/internal/collision_node.h>
 #include <hpp/fcl/internal/BV_splitter.h>
 
 #include <hpp/fcl/timings.h>
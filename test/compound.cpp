@@ -0,0 +1,268 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#define BOOST_TEST_MODULE FCL_COMPOUND
+#include <boost/test/included/unit_test.hpp>
+
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/compound.h>
+#include <hpp/fcl/hfield.h>
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+#include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
+#include <hpp/fcl/broadphase/broadphase_dynamic_AABB_tree.h>
+#include <hpp/fcl/broadphase/default_broadphase_callbacks.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// @brief Compound made of shapes, a mesh and a nested compound.
+shared_ptr<Compound> makeCompound(bool with_mesh = true) {
+  shared_ptr<Compound> compound(new Compound);
+  compound->addChild(shared_ptr<CollisionGeometry>(new Box(0.4, 0.2, 0.6)),
+                     Transform3f(Vec3f(0.5, 0, 0)));
+  compound->addChild(shared_ptr<CollisionGeometry>(new Cylinder(0.1, 0.8)),
+                     Transform3f(Quaternion3f(Eigen::AngleAxisd(
+                                     0.5, Vec3f::UnitX().normalized())),
+                                 Vec3f(-0.5, 0.2, 0)));
+  compound->addChild(shared_ptr<CollisionGeometry>(new Sphere(0.25)),
+                     Transform3f(Vec3f(0, 0.6, 0.3)));
+
+  if (with_mesh) {
+    shared_ptr<BVHModel<OBBRSS> > mesh(new BVHModel<OBBRSS>);
+    generateBVHModel(*mesh, Sphere(0.2), Transform3f(), 8, 8);
+    compound->addChild(mesh, Transform3f(Vec3f(0, -0.6, -0.2)));
+  }
+
+  shared_ptr<Compound> nested(new Compound);
+  nested->addChild(shared_ptr<CollisionGeometry>(new Capsule(0.1, 0.4)));
+  nested->addChild(shared_ptr<CollisionGeometry>(new Ellipsoid(0.1, 0.2, 0.1)),
+                   Transform3f(Vec3f(0.3, 0, 0)));
+  compound->addChild(nested, Transform3f(Vec3f(0, 0, -0.7)));
+  return compound;
+}
+
+/// @brief Other objects of the queries, with the type of all the supported
+/// families.
+std::vector<shared_ptr<CollisionGeometry> > makeOthers() {
+  std::vector<shared_ptr<CollisionGeometry> > others;
+  others.push_back(shared_ptr<CollisionGeometry>(new Box(0.3, 0.3, 0.3)));
+  others.push_back(shared_ptr<CollisionGeometry>(new Sphere(0.2)));
+
+  shared_ptr<BVHModel<OBBRSS> > mesh(new BVHModel<OBBRSS>);
+  generateBVHModel(*mesh, Box(0.3, 0.2, 0.4), Transform3f());
+  others.push_back(mesh);
+
+  const Eigen::DenseIndex n = 10;
+  const MatrixXf heights = 0.1 * MatrixXf::Random(n, n);
+  others.push_back(shared_ptr<CollisionGeometry>(
+      new HeightField<OBBRSS>(1., 1., heights, -0.2)));
+
+  others.push_back(makeCompound());
+  return others;
+}
+
+BOOST_AUTO_TEST_CASE(compound_collision) {
+  const std::vector<shared_ptr<CollisionGeometry> > others(makeOthers());
+
+  std::vector<Transform3f> transforms;
+  FCL_REAL extents[] = {-1, -1, -1, 1, 1, 1};
+  generateRandomTransforms(extents, transforms, 100);
+  const Transform3f tf_compound(
+      Quaternion3f(Eigen::AngleAxisd(0.3, Vec3f(1, 1, 0).normalized())),
+      Vec3f(0.1, -0.1, 0.05));
+
+  CollisionRequest request(CONTACT, 100);
+  std::size_t n_collisions = 0;
+  for (std::size_t k = 0; k < others.size(); ++k) {
+    // Collision between meshes and height fields is not implemented.
+    shared_ptr<Compound> compound(
+        makeCompound(others[k]->getObjectType() != OT_HFIELD));
+    for (std::size_t i = 0; i < transforms.size(); ++i) {
+      bool expected = false;
+      for (std::size_t c = 0; c < compound->getNumChildren(); ++c) {
+        CollisionResult child_result;
+        collide(compound->getChild(c).get(),
+                tf_compound * compound->getChildPlacement(c), others[k].get(),
+                transforms[i], request, child_result);
+        expected = expected || child_result.isCollision();
+      }
+      n_collisions += expected;
+
+      CollisionResult result;
+      collide(compound.get(), tf_compound, others[k].get(), transforms[i],
+              request, result);
+      BOOST_CHECK_EQUAL(result.isCollision(), expected);
+      for (std::size_t j = 0; j < result.numContacts(); ++j) {
+        const Contact& contact = result.getContact(j);
+        BOOST_CHECK(contact.o1 == compound.get());
+        BOOST_CHECK(contact.o2 == others[k].get());
+        BOOST_CHECK(contact.b1 >= 0 &&
+                    (std::size_t)contact.b1 < compound->getNumChildren());
+      }
+
+      result.clear();
+      collide(others[k].get(), transforms[i], compound.get(), tf_compound,
+              request, result);
+      BOOST_CHECK_EQUAL(result.isCollision(), expected);
+      for (std::size_t j = 0; j < result.numContacts(); ++j) {
+        const Contact& contact = result.getContact(j);
+        BOOST_CHECK(contact.o1 == others[k].get());
+        BOOST_CHECK(contact.o2 == compound.get());
+        BOOST_CHECK(contact.b2 >= 0 &&
+                    (std::size_t)contact.b2 < compound->getNumChildren());
+      }
+    }
+  }
+  BOOST_CHECK(n_collisions > 0);
+}
+
+BOOST_AUTO_TEST_CASE(compound_distance) {
+  shared_ptr<Compound> compound(makeCompound());
+  std::vector<shared_ptr<CollisionGeometry> > others(makeOthers());
+  // Distance against height fields is only implemented for BVH models.
+  others.erase(others.begin() + 3);
+
+  std::vector<Transform3f> transforms;
+  FCL_REAL extents[] = {-2, -2, -2, 2, 2, 2};
+  generateRandomTransforms(extents, transforms, 100);
+  const Transform3f tf_compound(Vec3f(0.1, -0.1, 0.05));
+
+  DistanceRequest request(true);
+  for (std::size_t k = 0; k < others.size(); ++k) {
+    for (std::size_t i = 0; i < transforms.size(); ++i) {
+      FCL_REAL expected = (std::numeric_limits<FCL_REAL>::max)();
+      for (std::size_t c = 0; c < compound->getNumChildren(); ++c) {
+        DistanceResult child_result;
+        distance(compound->getChild(c).get(),
+                 tf_compound * compound->getChildPlacement(c), others[k].get(),
+                 transforms[i], request, child_result);
+        expected = (std::min)(expected, child_result.min_distance);
+      }
+
+      DistanceResult result;
+      distance(compound.get(), tf_compound, others[k].get(), transforms[i],
+               request, result);
+      DistanceResult swapped;
+      distance(others[k].get(), transforms[i], compound.get(), tf_compound,
+               request, swapped);
+
+      if (expected > 0) {
+        BOOST_CHECK_SMALL(result.min_distance - expected, 1e-6);
+        // GJK is not symmetric in the order of the objects.
+        BOOST_CHECK_SMALL(swapped.min_distance - expected, 1e-5);
+        // The nearest points are expressed in the world frame.
+        BOOST_CHECK_SMALL(
+            (result.nearest_points[1] - result.nearest_points[0]).norm() -
+                expected,
+            1e-6);
+        BOOST_CHECK_SMALL(
+            (swapped.nearest_points[1] - swapped.nearest_points[0]).norm() -
+                expected,
+            1e-5);
+      } else {
+        // The query stops at the first child found in collision.
+        BOOST_CHECK(result.min_distance <= 0);
+        BOOST_CHECK(swapped.min_distance <= 0);
+      }
+      BOOST_CHECK(result.o1 == compound.get());
+      BOOST_CHECK(swapped.o2 == compound.get());
+      BOOST_CHECK(result.b1 >= 0 &&
+                  (std::size_t)result.b1 < compound->getNumChildren());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(compound_child_placement) {
+  Compound compound;
+  const std::size_t i = compound.addChild(
+      shared_ptr<CollisionGeometry>(new Sphere(0.1)),
+      Transform3f(Vec3f(1, 0, 0)));
+  BOOST_CHECK_EQUAL(compound.getNumChildren(), 1);
+  BOOST_CHECK(compound.aabb_local.contain(Vec3f(1.05, 0, 0)));
+
+  Sphere sphere(0.1);
+  CollisionRequest request;
+  CollisionResult result;
+  collide(&compound, Transform3f(), &sphere, Transform3f(Vec3f(1, 0, 0)),
+          request, result);
+  BOOST_CHECK(result.isCollision());
+
+  compound.setChildPlacement(i, Transform3f(Vec3f(-1, 0, 0)));
+  BOOST_CHECK(compound.aabb_local.contain(Vec3f(-1.05, 0, 0)));
+  BOOST_CHECK(!compound.aabb_local.contain(Vec3f(1.05, 0, 0)));
+
+  result.clear();
+  collide(&compound, Transform3f(), &sphere, Transform3f(Vec3f(1, 0, 0)),
+          request, result);
+  BOOST_CHECK(!result.isCollision());
+
+  BOOST_CHECK_THROW(compound.setChildPlacement(1, Transform3f()),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(compound.addChild(shared_ptr<CollisionGeometry>()),
+                    std::invalid_argument);
+
+  Compound* clone = compound.clone();
+  BOOST_CHECK(*clone == compound);
+  delete clone;
+}
+
+BOOST_AUTO_TEST_CASE(compound_broadphase) {
+  CollisionObject compound_object(makeCompound(),
+                                  Transform3f(Vec3f(0.1, 0, 0)));
+  CollisionObject box_object(
+      shared_ptr<CollisionGeometry>(new Box(0.2, 0.2, 0.2)),
+      Transform3f(Vec3f(0.6, 0, 0)));
+  CollisionObject far_object(
+      shared_ptr<CollisionGeometry>(new Box(0.2, 0.2, 0.2)),
+      Transform3f(Vec3f(5, 0, 0)));
+
+  DynamicAABBTreeCollisionManager manager;
+  manager.registerObject(&compound_object);
+  manager.registerObject(&box_object);
+  manager.registerObject(&far_object);
+  manager.setup();
+
+  CollisionCallBackDefault callback;
+  manager.collide(&callback);
+  BOOST_CHECK(callback.data.result.isCollision());
+  for (std::size_t j = 0; j < callback.data.result.numContacts(); ++j) {
+    const Contact& contact = callback.data.result.getContact(j);
+    BOOST_CHECK(contact.o1 != far_object.collisionGeometry().get() &&
+                contact.o2 != far_object.collisionGeometry().get());
+  }
+}
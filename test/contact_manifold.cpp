@@ -0,0 +1,196 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_MODULE FCL_CONTACT_MANIFOLD
+#include <boost/test/included/unit_test.hpp>
+
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/shape/convex.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// Collide o1 and o2 with the contact manifold enabled.
+CollisionResult collideManifold(const CollisionGeometry* o1,
+                                const Transform3f& tf1,
+                                const CollisionGeometry* o2,
+                                const Transform3f& tf2,
+                                size_t num_max_contacts = 4) {
+  CollisionRequest request(CONTACT, num_max_contacts);
+  request.enable_contact_manifold = true;
+  CollisionResult result;
+  collide(o1, tf1, o2, tf2, request, result);
+  return result;
+}
+
+/// Check that all the contacts have the given normal and depth and that
+/// their positions lie in the plane z = height.
+void checkContacts(const CollisionResult& result, const Vec3f& normal,
+                   FCL_REAL depth, FCL_REAL height) {
+  for (size_t i = 0; i < result.numContacts(); ++i) {
+    const Contact& contact = result.getContact(i);
+    // The normal and the depth computed by EPA are approximate.
+    BOOST_CHECK(contact.normal.isApprox(normal, 1e-5));
+    BOOST_CHECK_CLOSE(contact.penetration_depth, depth, 0.1);
+    BOOST_CHECK_SMALL(contact.pos[2] - height, 1e-6);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(box_box) {
+  Box ground(2, 2, 1), box(0.5, 0.5, 0.5);
+  Transform3f tf_box(Eigen::AngleAxis<FCL_REAL>(0.3, Vec3f::UnitZ())
+                         .toRotationMatrix(),
+                     Vec3f(0.1, -0.2, 0.74));
+
+  CollisionResult result = collideManifold(&ground, Transform3f(), &box,
+                                           tf_box);
+  BOOST_CHECK_EQUAL(result.numContacts(), 4);
+  checkContacts(result, Vec3f::UnitZ(), 0.01, 0.495);
+  // The contacts are the corners of the bottom face of the box.
+  for (size_t i = 0; i < result.numContacts(); ++i) {
+    const Vec3f local(tf_box.getRotation().transpose() *
+                      (result.getContact(i).pos - tf_box.getTranslation()));
+    BOOST_CHECK_CLOSE(std::fabs(local[0]), 0.25, 1e-6);
+    BOOST_CHECK_CLOSE(std::fabs(local[1]), 0.25, 1e-6);
+  }
+
+  // The number of contacts is bounded by num_max_contacts.
+  result = collideManifold(&ground, Transform3f(), &box, tf_box, 2);
+  BOOST_CHECK_EQUAL(result.numContacts(), 2);
+  checkContacts(result, Vec3f::UnitZ(), 0.01, 0.495);
+
+  // Without the manifold, a single contact is returned.
+  CollisionRequest request(CONTACT, 4);
+  result.clear();
+  collide(&ground, Transform3f(), &box, tf_box, request, result);
+  BOOST_CHECK_EQUAL(result.numContacts(), 1);
+
+  // A box standing on an edge touches the ground with 2 points.
+  Transform3f tf_edge(Eigen::AngleAxis<FCL_REAL>(M_PI / 4, Vec3f::UnitX())
+                          .toRotationMatrix(),
+                      Vec3f(0, 0, 0.5 + 0.25 * std::sqrt(2.) - 0.01));
+  result = collideManifold(&ground, Transform3f(), &box, tf_edge);
+  BOOST_CHECK_EQUAL(result.numContacts(), 2);
+  checkContacts(result, Vec3f::UnitZ(), 0.01, 0.495);
+
+  // A box standing on a vertex touches the ground with a single point.
+  Transform3f tf_vertex(
+      Quaternion3f::FromTwoVectors(Vec3f(1, 1, 1), -Vec3f::UnitZ()),
+      Vec3f(0, 0, 0.5 + 0.25 * std::sqrt(3.) - 0.01));
+  result = collideManifold(&box, tf_vertex, &ground, Transform3f());
+  BOOST_CHECK_EQUAL(result.numContacts(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(cylinder_capsule) {
+  Box ground(2, 2, 1);
+  Cylinder cylinder(0.3, 1);
+  Capsule capsule(0.2, 1);
+
+  // Cylinder standing on its cap.
+  Transform3f tf(Vec3f(0.2, 0.1, 0.99));
+  CollisionResult result =
+      collideManifold(&ground, Transform3f(), &cylinder, tf);
+  BOOST_CHECK_EQUAL(result.numContacts(), 4);
+  checkContacts(result, Vec3f::UnitZ(), 0.01, 0.495);
+  for (size_t i = 0; i < result.numContacts(); ++i) {
+    const Vec3f local(tf.getRotation().transpose() *
+                      (result.getContact(i).pos - tf.getTranslation()));
+    BOOST_CHECK_CLOSE(local.head<2>().norm(), 0.3, 1e-4);
+  }
+
+  // Cylinder and capsule lying on their sides.
+  const Matrix3f R(
+      Eigen::AngleAxis<FCL_REAL>(M_PI / 2, Vec3f::UnitY()).toRotationMatrix());
+  result = collideManifold(&ground, Transform3f(), &cylinder,
+                           Transform3f(R, Vec3f(0, 0, 0.79)));
+  BOOST_CHECK_EQUAL(result.numContacts(), 2);
+  checkContacts(result, Vec3f::UnitZ(), 0.01, 0.495);
+
+  result = collideManifold(&capsule, Transform3f(R, Vec3f(0, 0, 0.69)),
+                           &ground, Transform3f());
+  BOOST_CHECK_EQUAL(result.numContacts(), 2);
+  checkContacts(result, -Vec3f::UnitZ(), 0.01, 0.495);
+  for (size_t i = 0; i < result.numContacts(); ++i)
+    BOOST_CHECK_CLOSE(std::fabs(result.getContact(i).pos[0]), 0.5, 1e-6);
+
+  // Parallel capsules. The capsule-capsule distance orients the normal from
+  // the second capsule to the first one.
+  result = collideManifold(&capsule, Transform3f(R, Vec3f(0, 0, 0)), &capsule,
+                           Transform3f(R, Vec3f(0.5, 0, 0.39)));
+  BOOST_CHECK_EQUAL(result.numContacts(), 2);
+  checkContacts(result, -Vec3f::UnitZ(), 0.01, 0.195);
+
+  // Crossing capsules touch at a single point.
+  const Matrix3f R2(
+      Eigen::AngleAxis<FCL_REAL>(M_PI / 2, Vec3f::UnitX()).toRotationMatrix());
+  result = collideManifold(&capsule, Transform3f(R, Vec3f(0, 0, 0)), &capsule,
+                           Transform3f(R2, Vec3f(0, 0, 0.39)));
+  BOOST_CHECK_EQUAL(result.numContacts(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(convex_box) {
+  Vec3f* points = new Vec3f[8];
+  for (int i = 0; i < 8; ++i)
+    points[i] = Vec3f((i & 1) ? 0.25 : -0.25, (i & 2) ? 0.25 : -0.25,
+                      (i & 4) ? 0.25 : -0.25);
+  Quadrilateral* polygons = new Quadrilateral[6];
+  polygons[0].set(1, 3, 7, 5);
+  polygons[1].set(0, 4, 6, 2);
+  polygons[2].set(2, 6, 7, 3);
+  polygons[3].set(0, 1, 5, 4);
+  polygons[4].set(4, 5, 7, 6);
+  polygons[5].set(0, 2, 3, 1);
+  Convex<Quadrilateral> convex(true, points, 8, polygons, 6);
+  Box box(0.5, 0.5, 0.5);
+
+  // Convex box shifted on top of a box: the manifold is the intersection of
+  // the faces.
+  CollisionResult result = collideManifold(&box, Transform3f(), &convex,
+                                           Transform3f(Vec3f(0.2, 0.1, 0.49)));
+  BOOST_CHECK_EQUAL(result.numContacts(), 4);
+  checkContacts(result, Vec3f::UnitZ(), 0.01, 0.245);
+  for (size_t i = 0; i < result.numContacts(); ++i) {
+    const Vec3f& pos = result.getContact(i).pos;
+    BOOST_CHECK(pos[0] > -0.05 - 1e-6 && pos[0] < 0.25 + 1e-6);
+    BOOST_CHECK(pos[1] > -0.15 - 1e-6 && pos[1] < 0.25 + 1e-6);
+  }
+
+  // Shapes whose features are not supported return a single contact.
+  Sphere sphere(0.3);
+  result = collideManifold(&box, Transform3f(), &sphere,
+                           Transform3f(Vec3f(0, 0, 0.54)));
+  BOOST_CHECK_EQUAL(result.numContacts(), 1);
+}
@@ -0,0 +1,282 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_MODULE FCL_CONTINUOUS_COLLISION
+#include <boost/test/included/unit_test.hpp>
+
+#include <vector>
+
+#include <hpp/fcl/continuous_collision.h>
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+#include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
+#include <hpp/fcl/BVH/BVH_model.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+const CCDMotionType motion_types[] = {CCDM_LINEAR, CCDM_SCREW};
+
+BOOST_AUTO_TEST_CASE(motion) {
+  std::vector<Transform3f> transforms;
+  FCL_REAL extents[] = {-1, -1, -1, 1, 1, 1};
+  generateRandomTransforms(extents, transforms, 100);
+
+  for (int m = 0; m < 2; ++m) {
+    for (std::size_t i = 0; i + 1 < transforms.size(); i += 2) {
+      const Motion motion(transforms[i], transforms[i + 1], motion_types[m]);
+      const Transform3f tf0(motion.getTransform(0)),
+          tf1(motion.getTransform(1));
+      EIGEN_MATRIX_IS_APPROX(tf0.getRotation(), transforms[i].getRotation(),
+                             1e-10);
+      EIGEN_VECTOR_IS_APPROX(tf0.getTranslation(),
+                             transforms[i].getTranslation(), 1e-10);
+      EIGEN_MATRIX_IS_APPROX(tf1.getRotation(),
+                             transforms[i + 1].getRotation(), 1e-10);
+      EIGEN_VECTOR_IS_APPROX(tf1.getTranslation(),
+                             transforms[i + 1].getTranslation(), 1e-10);
+    }
+  }
+
+  // Rotation around an axis which does not go through the origin: with a
+  // screw motion, the points of the axis do not move.
+  const Vec3f p(0.3, -0.2, 0.1);
+  const Matrix3f R(
+      Eigen::AngleAxis<FCL_REAL>(2, Vec3f::UnitZ()).toRotationMatrix());
+  const Transform3f tf_end(R, p - R * p);
+  const Motion screw(Transform3f(), tf_end, CCDM_SCREW);
+  const Motion linear(Transform3f(), tf_end, CCDM_LINEAR);
+  for (FCL_REAL t = 0; t <= 1; t += 0.1) {
+    EIGEN_VECTOR_IS_APPROX(screw.getTransform(t).transform(p), p, 1e-10);
+    EIGEN_VECTOR_IS_APPROX(linear.getTransform(t).getTranslation(),
+                           t * tf_end.getTranslation(), 1e-10);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(speed_bound) {
+  Box box(0.4, 0.6, 0.8);
+  box.computeLocalAABB();
+  std::vector<Transform3f> transforms;
+  FCL_REAL extents[] = {-1, -1, -1, 1, 1, 1};
+  generateRandomTransforms(extents, transforms, 100);
+
+  const FCL_REAL dt = 1e-4;
+  for (int m = 0; m < 2; ++m) {
+    for (std::size_t i = 0; i + 1 < transforms.size(); i += 2) {
+      const Motion motion(transforms[i], transforms[i + 1], motion_types[m]);
+      const FCL_REAL bound = motion.speedBound(box);
+      for (FCL_REAL t = 0; t + dt <= 1; t += 0.05) {
+        const Transform3f tf0(motion.getTransform(t)),
+            tf1(motion.getTransform(t + dt));
+        for (int k = 0; k < 8; ++k) {
+          const Vec3f corner(box.halfSide.cwiseProduct(
+              Vec3f((k & 1) ? 1 : -1, (k & 2) ? 1 : -1, (k & 4) ? 1 : -1)));
+          const FCL_REAL speed =
+              (tf1.transform(corner) - tf0.transform(corner)).norm() / dt;
+          BOOST_CHECK_LE(speed, bound * (1 + 1e-6));
+        }
+      }
+    }
+  }
+
+  Box unknown_aabb(1, 1, 1);
+  BOOST_CHECK_THROW(Motion(Transform3f(), Transform3f()).speedBound(
+                        unknown_aabb),
+                    std::invalid_argument);
+}
+
+/// @brief Check the result of continuous collision checking against
+/// discrete collision checking at sampled times.
+void checkContinuousCollision(const CollisionGeometry* o1,
+                              const Transform3f& tf1_beg,
+                              const Transform3f& tf1_end,
+                              const CollisionGeometry* o2,
+                              const Transform3f& tf2_beg,
+                              const Transform3f& tf2_end,
+                              CCDMotionType motion_type,
+                              bool expect_collision) {
+  const ContinuousCollisionRequest request(motion_type);
+  ContinuousCollisionResult result;
+  const FCL_REAL toc = continuousCollide(o1, tf1_beg, tf1_end, o2, tf2_beg,
+                                         tf2_end, request, result);
+  BOOST_CHECK_EQUAL(result.is_collide, expect_collision);
+  BOOST_CHECK_EQUAL(toc, result.time_of_contact);
+  BOOST_CHECK(result.num_iterations < request.num_max_iterations);
+
+  // The objects do not collide before the time of contact.
+  const Motion motion1(tf1_beg, tf1_end, motion_type),
+      motion2(tf2_beg, tf2_end, motion_type);
+  for (int i = 0; i < 200 && toc > 0; ++i) {
+    const FCL_REAL t = toc * i / 200;
+    CollisionRequest collision_request;
+    CollisionResult collision_result;
+    BOOST_CHECK(!collide(o1, motion1.getTransform(t), o2,
+                         motion2.getTransform(t), collision_request,
+                         collision_result));
+  }
+  if (!expect_collision) {
+    BOOST_CHECK_EQUAL(toc, 1);
+    return;
+  }
+
+  // At the time of contact, the objects are in contact.
+  EIGEN_VECTOR_IS_APPROX(result.contact_tf1.getTranslation(),
+                         motion1.getTransform(toc).getTranslation(), 1e-10);
+  EIGEN_VECTOR_IS_APPROX(result.contact_tf2.getTranslation(),
+                         motion2.getTransform(toc).getTranslation(), 1e-10);
+  DistanceRequest distance_request;
+  DistanceResult distance_result;
+  const FCL_REAL distance =
+      hpp::fcl::distance(o1, result.contact_tf1, o2, result.contact_tf2,
+                         distance_request, distance_result);
+  BOOST_CHECK_LE(distance, request.distance_tolerance);
+}
+
+BOOST_AUTO_TEST_CASE(spheres) {
+  Sphere s1(0.3), s2(0.2);
+  s1.computeLocalAABB();
+  s2.computeLocalAABB();
+  const Transform3f tf2_beg(Vec3f(-2, 0.1, 0)), tf2_end(Vec3f(2, 0.1, 0));
+
+  for (int m = 0; m < 2; ++m) {
+    ContinuousCollisionResult result;
+    const FCL_REAL toc = continuousCollide(
+        &s1, Transform3f(), Transform3f(), &s2, tf2_beg, tf2_end,
+        ContinuousCollisionRequest(motion_types[m]), result);
+    BOOST_CHECK(result.is_collide);
+    // The spheres touch when their centers are 0.5 apart.
+    const FCL_REAL x = -std::sqrt(0.25 - 0.01);
+    const FCL_REAL expected = (x + 2) / 4;
+    BOOST_CHECK_LE(toc, expected);
+    BOOST_CHECK_GE(toc, expected - 1e-4);
+    checkContinuousCollision(&s1, Transform3f(), Transform3f(), &s2, tf2_beg,
+                             tf2_end, motion_types[m], true);
+
+    // The spheres pass by each other.
+    checkContinuousCollision(&s1, Transform3f(), Transform3f(), &s2,
+                             Transform3f(Vec3f(-2, 0.6, 0)),
+                             Transform3f(Vec3f(2, 0.6, 0)), motion_types[m],
+                             false);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(tunneling) {
+  // A fast sphere crosses a thin wall between two discrete checks.
+  Box wall(0.01, 2, 2);
+  Sphere sphere(0.05);
+  wall.computeLocalAABB();
+  sphere.computeLocalAABB();
+  const Transform3f tf_beg(Vec3f(-1, 0, 0)), tf_end(Vec3f(1, 0, 0));
+
+  CollisionRequest collision_request;
+  CollisionResult collision_result;
+  BOOST_CHECK(!collide(&wall, Transform3f(), &sphere, tf_beg,
+                       collision_request, collision_result));
+  BOOST_CHECK(!collide(&wall, Transform3f(), &sphere, tf_end,
+                       collision_request, collision_result));
+  for (int m = 0; m < 2; ++m)
+    checkContinuousCollision(&wall, Transform3f(), Transform3f(), &sphere,
+                             tf_beg, tf_end, motion_types[m], true);
+}
+
+BOOST_AUTO_TEST_CASE(rotation) {
+  // A rotating bar sweeps a sphere.
+  Box bar(2, 0.1, 0.1);
+  Sphere sphere(0.1);
+  bar.computeLocalAABB();
+  sphere.computeLocalAABB();
+  const Transform3f bar_end(
+      Eigen::AngleAxis<FCL_REAL>(M_PI / 2, Vec3f::UnitZ()).toRotationMatrix(),
+      Vec3f::Zero());
+  for (int m = 0; m < 2; ++m) {
+    checkContinuousCollision(&bar, Transform3f(), bar_end, &sphere,
+                             Transform3f(Vec3f(0.5, 0.5, 0)),
+                             Transform3f(Vec3f(0.5, 0.5, 0)), motion_types[m],
+                             true);
+    checkContinuousCollision(&bar, Transform3f(), bar_end, &sphere,
+                             Transform3f(Vec3f(1.2, 0.5, 0)),
+                             Transform3f(Vec3f(1.2, 0.5, 0)), motion_types[m],
+                             false);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(meshes) {
+  Box box(0.4, 0.6, 0.8);
+  Sphere sphere(0.3);
+  BVHModel<OBBRSS> box_mesh, sphere_mesh;
+  generateBVHModel(box_mesh, box, Transform3f());
+  generateBVHModel(sphere_mesh, sphere, Transform3f(), 16, 16);
+  box.computeLocalAABB();
+  box_mesh.computeLocalAABB();
+  sphere_mesh.computeLocalAABB();
+
+  std::vector<Transform3f> transforms;
+  FCL_REAL extents[] = {-2, -2, -2, 2, 2, 2};
+  generateRandomTransforms(extents, transforms, 40);
+  for (int m = 0; m < 2; ++m) {
+    for (std::size_t i = 0; i + 1 < transforms.size(); i += 2) {
+      // The result is checked against discrete collision checking.
+      ContinuousCollisionResult result;
+      continuousCollide(&sphere_mesh, Transform3f(), Transform3f(), &box_mesh,
+                        transforms[i], transforms[i + 1],
+                        ContinuousCollisionRequest(motion_types[m]), result);
+      checkContinuousCollision(&sphere_mesh, Transform3f(), Transform3f(),
+                               &box_mesh, transforms[i], transforms[i + 1],
+                               motion_types[m], result.is_collide);
+
+      // Shape and mesh of the same box give the same time of contact.
+      ContinuousCollisionResult shape_result;
+      continuousCollide(&sphere_mesh, Transform3f(), Transform3f(), &box,
+                        transforms[i], transforms[i + 1],
+                        ContinuousCollisionRequest(motion_types[m]),
+                        shape_result);
+      BOOST_CHECK_EQUAL(result.is_collide, shape_result.is_collide);
+      BOOST_CHECK_SMALL(result.time_of_contact - shape_result.time_of_contact,
+                        1e-3);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(collision_objects) {
+  shared_ptr<Sphere> s1(new Sphere(0.3)), s2(new Sphere(0.2));
+  const CollisionObject o1(s1), o2(s2, Transform3f(Vec3f(-2, 0.1, 0)));
+  ContinuousCollisionResult result;
+  const FCL_REAL toc =
+      continuousCollide(&o1, Transform3f(), &o2, Transform3f(Vec3f(2, 0.1, 0)),
+                        ContinuousCollisionRequest(), result);
+  BOOST_CHECK(result.is_collide);
+  BOOST_CHECK_CLOSE(toc, (2 - std::sqrt(0.25 - 0.01)) / 4, 1e-2);
+}
@@ -199,7 +199,6 @@ BOOST_AUTO_TEST_CASE(compare_convex_box) {
   }
 }
 
-#ifdef HPP_FCL_HAS_QHULL
 BOOST_AUTO_TEST_CASE(convex_hull_throw) {
   std::vector<Vec3f> points({
       Vec3f(1, 1, 1),
@@ -272,4 +271,132 @@ BOOST_AUTO_TEST_CASE(convex_hull_box_like) {
   }
   delete convexHull;
 }
+
+/// @brief Check that hull is the convex hull of the n points.
+void checkHull(const Vec3f* points, unsigned int n, const ConvexBase& hull,
+               bool triangles) {
+  // The vertices are input points.
+  for (unsigned int i = 0; i < hull.num_points; ++i) {
+    bool found = false;
+    for (unsigned int j = 0; j < n && !found; ++j)
+      found = hull.points[i] == points[j];
+    BOOST_CHECK(found);
+  }
+  // The neighbor relation is symmetric.
+  std::size_t n_edges = 0;
+  for (unsigned int i = 0; i < hull.num_points; ++i) {
+    const ConvexBase::Neighbors& neighbors = hull.neighbors[i];
+    BOOST_CHECK(neighbors.count() >= 3);
+    n_edges += neighbors.count();
+    for (unsigned char k = 0; k < neighbors.count(); ++k) {
+      const ConvexBase::Neighbors& other = hull.neighbors[neighbors[k]];
+      bool found = false;
+      for (unsigned char l = 0; l < other.count() && !found; ++l)
+        found = other[l] == i;
+      BOOST_CHECK(found);
+    }
+  }
+  if (!triangles) return;
+
+  const Convex<Triangle>& convex = dynamic_cast<const Convex<Triangle>&>(hull);
+  // Euler characteristic of a closed triangulated surface.
+  BOOST_CHECK_EQUAL((long)convex.num_points - (long)n_edges / 2 +
+                        (long)convex.num_polygons,
+                    2);
+  // Every point lies below the outward oriented triangles.
+  for (unsigned int f = 0; f < convex.num_polygons; ++f) {
+    const Triangle& tri = convex.polygons[f];
+    const Vec3f& p0 = convex.points[tri[0]];
+    const Vec3f normal((convex.points[tri[1]] - p0)
+                           .cross(convex.points[tri[2]] - p0)
+                           .normalized());
+    BOOST_CHECK(normal.dot(p0 - convex.center) > 0);
+    for (unsigned int j = 0; j < n; ++j)
+      BOOST_CHECK(normal.dot(points[j] - p0) <= 1e-10);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(quick_hull) {
+  std::vector<Vec3f> points(1000);
+  for (std::size_t i = 0; i < points.size(); ++i) points[i] = Vec3f::Random();
+  // Points on a sphere are all vertices of the hull.
+  std::vector<Vec3f> sphere(200);
+  for (std::size_t i = 0; i < sphere.size(); ++i)
+    sphere[i] = Vec3f::Random().normalized();
+
+  for (int keep = 0; keep < 2; ++keep) {
+    shared_ptr<ConvexBase> hull(ConvexBase::quickHull(
+        points.data(), (unsigned int)points.size(), keep == 1));
+    checkHull(points.data(), (unsigned int)points.size(), *hull, keep == 1);
+
+    hull.reset(ConvexBase::quickHull(sphere.data(),
+                                     (unsigned int)sphere.size(), keep == 1));
+    checkHull(sphere.data(), (unsigned int)sphere.size(), *hull, keep == 1);
+    BOOST_CHECK_EQUAL(hull->num_points, sphere.size());
+  }
+
+  // A cube with points on its faces, edges and inside.
+  std::vector<Vec3f> cube;
+  for (int i = 0; i < 5; ++i)
+    for (int j = 0; j < 5; ++j)
+      for (int k = 0; k < 5; ++k)
+        cube.push_back(Vec3f(i - 2, j - 2, k - 2) / 2);
+  shared_ptr<ConvexBase> hull(
+      ConvexBase::quickHull(cube.data(), (unsigned int)cube.size(), false));
+  BOOST_REQUIRE_EQUAL(hull->num_points, 8);
+  for (unsigned int i = 0; i < 8; ++i) {
+    BOOST_CHECK(hull->points[i].cwiseAbs() == Vec3f(1, 1, 1));
+    BOOST_CHECK_EQUAL(hull->neighbors[i].count(), 3);
+  }
+
+  std::vector<Vec3f> square(cube.begin(), cube.begin() + 25);
+  BOOST_CHECK_THROW(ConvexBase::quickHull(square.data(),
+                                          (unsigned int)square.size(), true),
+                    std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(quick_hull_batch) {
+  std::vector<std::vector<Vec3f> > point_sets(20);
+  for (std::size_t i = 0; i < point_sets.size(); ++i) {
+    point_sets[i].resize(50 + 10 * i);
+    for (std::size_t j = 0; j < point_sets[i].size(); ++j)
+      point_sets[i][j] = Vec3f::Random();
+  }
+
+  for (int num_threads = 0; num_threads < 3; ++num_threads) {
+    std::vector<shared_ptr<ConvexBase> > hulls;
+    ConvexBase::quickHull(point_sets, true, hulls, num_threads);
+    BOOST_REQUIRE_EQUAL(hulls.size(), point_sets.size());
+    for (std::size_t i = 0; i < point_sets.size(); ++i) {
+      shared_ptr<ConvexBase> hull(ConvexBase::quickHull(
+          point_sets[i].data(), (unsigned int)point_sets[i].size(), true));
+      BOOST_REQUIRE_EQUAL(hulls[i]->num_points, hull->num_points);
+      for (unsigned int j = 0; j < hull->num_points; ++j)
+        BOOST_CHECK(hulls[i]->points[j] == hull->points[j]);
+    }
+  }
+
+  point_sets[3].resize(3);
+  std::vector<shared_ptr<ConvexBase> > hulls;
+  BOOST_CHECK_THROW(ConvexBase::quickHull(point_sets, true, hulls, 2),
+                    std::invalid_argument);
+}
+
+#ifdef HPP_FCL_HAS_QHULL
+BOOST_AUTO_TEST_CASE(quick_hull_qhull) {
+  std::vector<Vec3f> points(500);
+  for (std::size_t i = 0; i < points.size(); ++i) points[i] = Vec3f::Random();
+
+  shared_ptr<ConvexBase> qhull(ConvexBase::convexHull(
+      points.data(), (unsigned int)points.size(), true));
+  shared_ptr<ConvexBase> hull(ConvexBase::quickHull(
+      points.data(), (unsigned int)points.size(), true));
+  BOOST_REQUIRE_EQUAL(hull->num_points, qhull->num_points);
+  for (unsigned int i = 0; i < hull->num_points; ++i) {
+    bool found = false;
+    for (unsigned int j = 0; j < qhull->num_points && !found; ++j)
+      found = hull->points[i] == qhull->points[j];
+    BOOST_CHECK(found);
+  }
+}
 #endif
@@ -0,0 +1,166 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#define BOOST_TEST_MODULE FCL_CONVEX_DECOMPOSITION
+#include <boost/test/included/unit_test.hpp>
+
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/compound.h>
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/shape/convex.h>
+#include <hpp/fcl/shape/convex_decomposition.h>
+#include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// @brief Closed mesh of a unit sphere whose radius oscillates with the
+/// longitude, hence concave.
+shared_ptr<BVHModel<OBBRSS> > makeBumpySphere(unsigned int n_lat,
+                                              unsigned int n_lon) {
+  std::vector<Vec3f> points;
+  std::vector<Triangle> triangles;
+  points.push_back(Vec3f(0, 0, 1));
+  for (unsigned int i = 1; i < n_lat; ++i) {
+    const FCL_REAL theta = M_PI * FCL_REAL(i) / FCL_REAL(n_lat);
+    for (unsigned int j = 0; j < n_lon; ++j) {
+      const FCL_REAL phi = 2 * M_PI * FCL_REAL(j) / FCL_REAL(n_lon);
+      const FCL_REAL r = 1 + 0.3 * std::cos(4 * phi) * std::sin(theta);
+      points.push_back(r * Vec3f(std::sin(theta) * std::cos(phi),
+                                 std::sin(theta) * std::sin(phi),
+                                 std::cos(theta)));
+    }
+  }
+  points.push_back(Vec3f(0, 0, -1));
+
+  const unsigned int south = (unsigned int)points.size() - 1;
+  for (unsigned int j = 0; j < n_lon; ++j) {
+    const unsigned int k = (j + 1) % n_lon;
+    triangles.push_back(Triangle(0, 1 + j, 1 + k));
+    triangles.push_back(Triangle(south, 1 + (n_lat - 2) * n_lon + k,
+                                 1 + (n_lat - 2) * n_lon + j));
+    for (unsigned int i = 0; i + 2 < n_lat; ++i) {
+      const unsigned int a = 1 + i * n_lon, b = a + n_lon;
+      triangles.push_back(Triangle(a + j, b + j, b + k));
+      triangles.push_back(Triangle(a + j, b + k, a + k));
+    }
+  }
+
+  shared_ptr<BVHModel<OBBRSS> > mesh(new BVHModel<OBBRSS>);
+  mesh->beginModel();
+  mesh->addSubModel(points, triangles);
+  mesh->endModel();
+  mesh->computeLocalAABB();
+  return mesh;
+}
+
+BOOST_AUTO_TEST_CASE(convex_decomposition_invalid_arguments) {
+  BVHModel<OBBRSS> cloud;
+  std::vector<Vec3f> points(10);
+  for (std::size_t i = 0; i < points.size(); ++i) points[i] = Vec3f::Random();
+  cloud.beginModel();
+  cloud.addSubModel(points);
+  cloud.endModel();
+  BOOST_CHECK_THROW(convexDecomposition(cloud), std::invalid_argument);
+
+  BVHModel<OBBRSS> box;
+  generateBVHModel(box, Box(1, 1, 1), Transform3f());
+  BOOST_CHECK_THROW(convexDecomposition(box, ConvexDecompositionRequest(0)),
+                    std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(convex_decomposition_convex_mesh) {
+  BVHModel<OBBRSS> box;
+  generateBVHModel(box, Box(1, 2, 3), Transform3f());
+  box.computeLocalAABB();
+  shared_ptr<Compound> pieces(convexDecomposition(box));
+  BOOST_CHECK_EQUAL(pieces->getNumChildren(), 1);
+  BOOST_CHECK(pieces->aabb_local == box.aabb_local);
+}
+
+BOOST_AUTO_TEST_CASE(convex_decomposition_concave_mesh) {
+  shared_ptr<BVHModel<OBBRSS> > mesh(makeBumpySphere(16, 32));
+  const ConvexDecompositionRequest request(12, 0.01);
+  shared_ptr<Compound> pieces(convexDecomposition(*mesh, request));
+  BOOST_CHECK(pieces->getNumChildren() > 1);
+  BOOST_CHECK(pieces->getNumChildren() <= request.max_num_pieces);
+
+  for (std::size_t i = 0; i < pieces->getNumChildren(); ++i) {
+    const ConvexBase* piece =
+        dynamic_cast<const ConvexBase*>(pieces->getChild(i).get());
+    BOOST_REQUIRE(piece != NULL);
+    BOOST_CHECK(piece->neighbors != NULL);
+    // The pieces are built from the vertices of the mesh.
+    for (unsigned int j = 0; j < piece->num_points; ++j) {
+      bool found = false;
+      for (unsigned int k = 0; k < mesh->num_vertices && !found; ++k)
+        found = piece->points[j] == mesh->vertices[k];
+      BOOST_CHECK(found);
+    }
+  }
+
+  // The pieces cover the surface of the mesh, so any object in collision
+  // with the mesh is in collision with a piece.
+  std::vector<Transform3f> transforms;
+  FCL_REAL extents[] = {-1.5, -1.5, -1.5, 1.5, 1.5, 1.5};
+  generateRandomTransforms(extents, transforms, 500);
+  Box box(0.2, 0.1, 0.3);
+  CollisionRequest collision_request;
+  std::size_t n_mesh = 0, n_pieces = 0;
+  for (std::size_t i = 0; i < transforms.size(); ++i) {
+    CollisionResult mesh_result, pieces_result;
+    const bool in_mesh = collide(mesh.get(), Transform3f(), &box, transforms[i],
+                                 collision_request, mesh_result) > 0;
+    const bool in_pieces = collide(pieces.get(), Transform3f(), &box,
+                                   transforms[i], collision_request,
+                                   pieces_result) > 0;
+    if (in_mesh) BOOST_CHECK(in_pieces);
+    n_mesh += in_mesh;
+    n_pieces += in_pieces;
+  }
+  BOOST_CHECK(n_mesh > 0);
+  BOOST_TEST_MESSAGE(pieces->getNumChildren()
+                     << " pieces, " << n_mesh << " collisions with the mesh, "
+                     << n_pieces << " with the pieces");
+}
+
+BOOST_AUTO_TEST_CASE(convex_decomposition_single_piece) {
+  shared_ptr<BVHModel<OBBRSS> > mesh(makeBumpySphere(8, 16));
+  shared_ptr<Compound> pieces(
+      convexDecomposition(*mesh, ConvexDecompositionRequest(1)));
+  BOOST_REQUIRE_EQUAL(pieces->getNumChildren(), 1);
+  BOOST_CHECK(pieces->aabb_local == mesh->aabb_local);
+}
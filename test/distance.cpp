@@ -43,7 +43,7 @@
 
 #include <hpp/fcl/internal/traversal_node_bvhs.h>
 #include <hpp/fcl/internal/traversal_node_setup.h>
-#include "../src/collision_node.h"
+#include <hpp/fcl/internal/collision_node.h>
 #include <hpp/fcl/internal/BV_splitter.h>
 
 #include "utility.h"
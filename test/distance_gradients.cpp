@@ -0,0 +1,308 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_MODULE FCL_DISTANCE_GRADIENTS
+#include <boost/test/included/unit_test.hpp>
+
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/typed_query.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+#include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// @brief Placement tf moved by the twist eps * e_k in the frame of the
+/// object, k < 3 for the translations and k >= 3 for the rotations.
+Transform3f perturb(const Transform3f& tf, int k, FCL_REAL eps) {
+  if (k < 3) return tf * Transform3f(Vec3f(eps * Vec3f::Unit(k)));
+  return tf * Transform3f(Matrix3f(Eigen::AngleAxis<FCL_REAL>(
+                              eps, Vec3f::Unit(k - 3))),
+                          Vec3f::Zero());
+}
+
+/// @brief Check the gradients of the distance between o1 and o2 against
+/// central finite differences.
+void checkGradients(const CollisionGeometry* o1, const Transform3f& tf1,
+                    const CollisionGeometry* o2, const Transform3f& tf2,
+                    FCL_REAL tolerance = 1e-4) {
+  DistanceRequest request;
+  request.enable_gradients = true;
+  request.gjk_tolerance = 1e-10;
+  DistanceResult result;
+  const FCL_REAL d = distance(o1, tf1, o2, tf2, request, result);
+  BOOST_REQUIRE(result.gradients[0].allFinite());
+  BOOST_REQUIRE(result.gradients[1].allFinite());
+
+  DistanceRequest fd_request;
+  fd_request.gjk_tolerance = 1e-10;
+  const FCL_REAL eps = 1e-4;
+  Vec6f fd[2];
+  for (int k = 0; k < 6; ++k) {
+    DistanceResult r;
+    const FCL_REAL d1_plus =
+        distance(o1, perturb(tf1, k, eps), o2, tf2, fd_request, r);
+    r.clear();
+    const FCL_REAL d1_minus =
+        distance(o1, perturb(tf1, k, -eps), o2, tf2, fd_request, r);
+    r.clear();
+    const FCL_REAL d2_plus =
+        distance(o1, tf1, o2, perturb(tf2, k, eps), fd_request, r);
+    r.clear();
+    const FCL_REAL d2_minus =
+        distance(o1, tf1, o2, perturb(tf2, k, -eps), fd_request, r);
+    fd[0][k] = (d1_plus - d1_minus) / (2 * eps);
+    fd[1][k] = (d2_plus - d2_minus) / (2 * eps);
+  }
+  for (int i = 0; i < 2; ++i) {
+    BOOST_CHECK_MESSAGE((result.gradients[i] - fd[i]).norm() <= tolerance,
+                        "distance " << d << ", gradient " << i << ":\n"
+                                    << result.gradients[i].transpose()
+                                    << "\nfinite differences:\n"
+                                    << fd[i].transpose());
+  }
+
+  // The distance does not depend on the placement of the pair.
+  BOOST_CHECK_SMALL((result.gradients[0].head<3>() +
+                     (tf1.getRotation().transpose() * tf2.getRotation()) *
+                         result.gradients[1].head<3>())
+                        .norm(),
+                    1e-8);
+}
+
+/// @brief Random placements of two objects at most 2 apart.
+void randomPlacements(Transform3f& tf1, Transform3f& tf2) {
+  FCL_REAL extents[] = {-1, -1, -1, 1, 1, 1};
+  generateRandomTransform(extents, tf1);
+  generateRandomTransform(extents, tf2);
+}
+
+BOOST_AUTO_TEST_CASE(primitives) {
+  Sphere sphere(0.3);
+  Box box(0.4, 0.6, 0.8);
+  Capsule capsule(0.2, 0.6);
+  Ellipsoid ellipsoid(0.3, 0.4, 0.5);
+  Cylinder cylinder(0.3, 0.5);
+  Cone cone(0.3, 0.6);
+  const ShapeBase* shapes[] = {&sphere, &box,      &capsule,
+                               &ellipsoid, &cylinder, &cone};
+
+  for (int i = 0; i < 6; ++i) {
+    for (int j = 0; j < 6; ++j) {
+      for (int k = 0; k < 10; ++k) {
+        Transform3f tf1, tf2;
+        randomPlacements(tf1, tf2);
+        // Separate the shapes.
+        tf2.setTranslation(tf2.getTranslation() +
+                           3 * (tf2.getTranslation() - tf1.getTranslation())
+                                   .normalized());
+        checkGradients(shapes[i], tf1, shapes[j], tf2);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(penetration) {
+  // Pairs whose penetration depth is computed in closed form.
+  Sphere sphere(0.5);
+  Capsule capsule(0.3, 0.8);
+  Box box(0.6, 0.8, 1);
+  for (int k = 0; k < 10; ++k) {
+    Transform3f tf1, tf2;
+    randomPlacements(tf1, tf2);
+    tf2.setTranslation(tf1.getTranslation() +
+                       0.6 * Vec3f::Random().normalized());
+    checkGradients(&sphere, tf1, &sphere, tf2);
+    checkGradients(&capsule, tf1, &capsule, tf2);
+    tf2.setTranslation(tf1.transform(Vec3f(0.1, 0.2, 0.65)));
+    checkGradients(&box, tf1, &sphere, tf2);
+    checkGradients(&sphere, tf2, &box, tf1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(convex) {
+  Convex<Triangle> convex1(
+      constructPolytopeFromEllipsoid(Ellipsoid(0.3, 0.4, 0.5)));
+  Convex<Triangle> convex2(
+      constructPolytopeFromEllipsoid(Ellipsoid(0.5, 0.2, 0.3)));
+  Capsule capsule(0.2, 0.6);
+  for (int k = 0; k < 20; ++k) {
+    Transform3f tf1, tf2;
+    randomPlacements(tf1, tf2);
+    tf2.setTranslation(tf2.getTranslation() +
+                       3 * (tf2.getTranslation() - tf1.getTranslation())
+                               .normalized());
+    checkGradients(&convex1, tf1, &convex2, tf2);
+    checkGradients(&convex1, tf1, &capsule, tf2);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(mesh_leaves) {
+  BVHModel<OBBRSS> mesh1, mesh2;
+  generateBVHModel(mesh1, Box(1, 0.8, 0.6), Transform3f());
+  generateBVHModel(mesh2, Sphere(0.4), Transform3f(), 8, 8);
+  Sphere sphere(0.3);
+  Capsule capsule(0.2, 0.6);
+  Ellipsoid ellipsoid(0.3, 0.4, 0.5);
+  const ShapeBase* shapes[] = {&sphere, &capsule, &ellipsoid};
+
+  for (int k = 0; k < 20; ++k) {
+    Transform3f tf1, tf2;
+    randomPlacements(tf1, tf2);
+    tf2.setTranslation(tf2.getTranslation() +
+                       3 * (tf2.getTranslation() - tf1.getTranslation())
+                               .normalized());
+    for (int i = 0; i < 3; ++i) {
+      checkGradients(&mesh1, tf1, shapes[i], tf2);
+      checkGradients(shapes[i], tf2, &mesh1, tf1);
+    }
+    checkGradients(&mesh1, tf1, &mesh2, tf2);
+
+    // A sphere penetrating a face of the mesh.
+    const Transform3f tf_sphere(
+        tf1.transform(Vec3f(0.1, -0.05, 0.3 + 0.2 * (FCL_REAL)k / 20)));
+    checkGradients(&mesh1, tf1, &sphere, tf_sphere);
+    checkGradients(&sphere, tf_sphere, &mesh1, tf1);
+  }
+}
+
+template <typename BV>
+void checkMeshShapeNormal() {
+  // A sphere penetrating the top face of a box mesh: the normal points from
+  // the mesh to the sphere. The query stops at the first penetrating
+  // triangle, which may be on the edge of the face.
+  BVHModel<BV> mesh;
+  generateBVHModel(mesh, Box(1, 0.8, 0.6), Transform3f());
+  Sphere sphere(0.3);
+  Transform3f tf1;
+  FCL_REAL extents[] = {-1, -1, -1, 1, 1, 1};
+  generateRandomTransform(extents, tf1);
+  const Transform3f tf2(tf1.transform(Vec3f(0.1, -0.05, 0.5)));
+
+  DistanceRequest request;
+  DistanceResult result;
+  distance(&mesh, tf1, &sphere, tf2, request, result);
+  BOOST_CHECK(result.min_distance < 0);
+  BOOST_CHECK_GT(result.normal.dot(tf1.getRotation() * Vec3f(0, 0, 1)), 0.9);
+}
+
+BOOST_AUTO_TEST_CASE(mesh_shape_normal) {
+  checkMeshShapeNormal<RSS>();
+  checkMeshShapeNormal<kIOS>();
+  checkMeshShapeNormal<OBBRSS>();
+}
+
+BOOST_AUTO_TEST_CASE(interfaces) {
+  BVHModel<OBBRSS> mesh;
+  generateBVHModel(mesh, Box(1, 0.8, 0.6), Transform3f());
+  Capsule capsule(0.2, 0.6);
+  const Transform3f tf1(Vec3f(0.1, 0.2, 0.3)), tf2(Vec3f(1.2, 0.5, 0.4));
+
+  // The gradients are only computed on request.
+  DistanceRequest request;
+  DistanceResult result;
+  distance(&capsule, tf2, &mesh, tf1, request, result);
+  BOOST_CHECK(!result.gradients[0].allFinite());
+
+  request.enable_gradients = true;
+  DistanceResult reference;
+  distance(&capsule, tf2, &mesh, tf1, request, reference);
+  BOOST_CHECK(reference.gradients[0].allFinite());
+
+  // ComputeDistance, with and without cache, and the typed distance give the
+  // same gradients.
+  ComputeDistance compute_distance(&capsule, &mesh);
+  result.clear();
+  compute_distance(tf2, tf1, request, result);
+  EIGEN_VECTOR_IS_APPROX(result.gradients[0], reference.gradients[0], 1e-8);
+  EIGEN_VECTOR_IS_APPROX(result.gradients[1], reference.gradients[1], 1e-8);
+
+  PairCache cache;
+  for (int i = 0; i < 2; ++i) {
+    result.clear();
+    compute_distance(tf2, tf1, request, result, cache);
+    EIGEN_VECTOR_IS_APPROX(result.gradients[0], reference.gradients[0], 1e-6);
+    EIGEN_VECTOR_IS_APPROX(result.gradients[1], reference.gradients[1], 1e-6);
+  }
+
+  result.clear();
+  distance(&capsule, tf2, &mesh, tf1, request, result);
+  EIGEN_VECTOR_IS_APPROX(result.gradients[0], reference.gradients[0], 1e-8);
+  result.clear();
+  hpp::fcl::distance<Capsule, BVHModel<OBBRSS> >(&capsule, tf2, &mesh, tf1,
+                                                 request, result);
+  EIGEN_VECTOR_IS_APPROX(result.gradients[0], reference.gradients[0], 1e-8);
+  EIGEN_VECTOR_IS_APPROX(result.gradients[1], reference.gradients[1], 1e-8);
+
+  // Between intersecting meshes, the direction is unknown.
+  BVHModel<OBBRSS> mesh2;
+  generateBVHModel(mesh2, Box(1, 1, 1), Transform3f());
+  result.clear();
+  distance(&mesh, tf1, &mesh2, tf1, request, result);
+  BOOST_CHECK(!result.gradients[0].allFinite());
+}
+
+BOOST_AUTO_TEST_CASE(swapped_normal) {
+  // The queries between a shape and a mesh swap the objects. The normal of
+  // penetrating objects points from o1 to o2 whether or not the nearest
+  // points are requested.
+  BVHModel<OBBRSS> mesh;
+  generateBVHModel(mesh, Box(1, 0.8, 0.6), Transform3f());
+  Capsule capsule(0.2, 0.6);
+  const Transform3f tf1(Vec3f(0.1, 0.2, 0.3)), tf2(Vec3f(0.75, 0.5, 0.4));
+  const Vec3f expected(-1, 0, 0);
+
+  DistanceRequest request;
+  DistanceResult result;
+  distance(&capsule, tf2, &mesh, tf1, request, result);
+  EIGEN_VECTOR_IS_APPROX(result.normal, expected, 1e-8);
+
+  ComputeDistance compute_distance(&capsule, &mesh);
+  result.clear();
+  compute_distance(tf2, tf1, request, result);
+  EIGEN_VECTOR_IS_APPROX(result.normal, expected, 1e-8);
+
+  PairCache cache;
+  for (int i = 0; i < 2; ++i) {
+    result.clear();
+    compute_distance(tf2, tf1, request, result, cache);
+    EIGEN_VECTOR_IS_APPROX(result.normal, expected, 1e-8);
+  }
+
+  result.clear();
+  hpp::fcl::distance<Capsule, BVHModel<OBBRSS> >(&capsule, tf2, &mesh, tf1,
+                                                 request, result);
+  EIGEN_VECTOR_IS_APPROX(result.normal, expected, 1e-8);
+}
@@ -45,6 +45,7 @@
 #include <iostream>
 #include <hpp/fcl/internal/tools.h>
 #include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
+#include <hpp/fcl/shape/geometric_shapes_utility.h>
 
 using namespace hpp::fcl;
 
@@ -2726,6 +2727,45 @@ BOOST_AUTO_TEST_CASE(shapeIntersection_planecone) {
   testShapeIntersection(s, tf1, hs, tf2, false);
 }
 
+BOOST_AUTO_TEST_CASE(shapeDistance_spheretriangle) {
+  // The center of the sphere projects inside the triangle: the distance is
+  // the one to the plane of the triangle.
+  Sphere s(1);
+  Vec3f t[3];
+  t[0] << -10, -10, 5;
+  t[1] << 10, -10, 5;
+  t[2] << 0, 10, 5;
+
+  Transform3f transform;
+  generateRandomTransform(extents, transform);
+
+  Vec3f c1, c2, normal;
+  FCL_REAL distance;
+  bool res;
+
+  res =
+      solver1.shapeTriangleInteraction(s, Transform3f(), t[0], t[1], t[2],
+                                       Transform3f(), distance, c1, c2, normal);
+  BOOST_CHECK(!res);
+  BOOST_CHECK_CLOSE(distance, 4, 1e-6);
+  BOOST_CHECK(isEqual(c1, Vec3f(0, 0, 1), 1e-9));
+  BOOST_CHECK(isEqual(c2, Vec3f(0, 0, 5), 1e-9));
+
+  res = solver1.shapeTriangleInteraction(s, transform, t[0], t[1], t[2],
+                                         transform, distance, c1, c2, normal);
+  BOOST_CHECK(!res);
+  BOOST_CHECK_CLOSE(distance, 4, 1e-6);
+  BOOST_CHECK(isEqual(c2, transform.transform(Vec3f(0, 0, 5)), 1e-9));
+
+  t[0][2] = t[1][2] = t[2][2] = 0.5;
+  res =
+      solver1.shapeTriangleInteraction(s, Transform3f(), t[0], t[1], t[2],
+                                       Transform3f(), distance, c1, c2, normal);
+  BOOST_CHECK(res);
+  BOOST_CHECK_CLOSE(distance, -0.5, 1e-6);
+  BOOST_CHECK(isEqual(normal, Vec3f(0, 0, 1), 1e-9));
+}
+
 BOOST_AUTO_TEST_CASE(shapeDistance_spheresphere) {
   Sphere s1(20);
   Sphere s2(10);
@@ -2809,6 +2849,28 @@ BOOST_AUTO_TEST_CASE(shapeDistance_spheresphere) {
   BOOST_CHECK_FALSE(res);
 }
 
+BOOST_AUTO_TEST_CASE(distance_spheresphere_normal) {
+  // The normal goes from the center of the first sphere to the center of the
+  // second one, whether the spheres are separated or penetrating.
+  Sphere s1(20);
+  Sphere s2(10);
+  const Transform3f transform(
+      Matrix3f(Eigen::AngleAxis<FCL_REAL>(0.3, Vec3f(1, 2, 3).normalized())),
+      Vec3f(1, -2, 0.5));
+  const Vec3f direction(transform.getRotation() * Vec3f(0, 1, 0));
+
+  const FCL_REAL offsets[] = {40, 25};
+  for (int i = 0; i < 2; ++i) {
+    DistanceRequest request;
+    DistanceResult result;
+    distance(&s1, transform, &s2,
+             transform * Transform3f(Vec3f(0, offsets[i], 0)), request,
+             result);
+    BOOST_CHECK_CLOSE(result.min_distance, offsets[i] - 30, 1e-6);
+    BOOST_CHECK(isEqual(result.normal, direction, 1e-9));
+  }
+}
+
 BOOST_AUTO_TEST_CASE(shapeDistance_boxbox) {
   Box s1(20, 40, 50);
   Box s2(10, 10, 10);
@@ -4067,3 +4129,79 @@ BOOST_AUTO_TEST_CASE(reversibleShapeDistance_allshapes) {
 
   //  testReversibleShapeDistance(plane, halfspace, distance);
 }
+
+BOOST_AUTO_TEST_CASE(collision_object_aabb) {
+  std::vector<Transform3f> transforms;
+  generateRandomTransforms(extents, transforms, 100);
+
+  shared_ptr<Box> box(new Box(0.1, 0.2, 2));
+  shared_ptr<Capsule> capsule(new Capsule(0.05, 2));
+
+  std::vector<CollisionObject*> objects;
+  for (size_t i = 0; i < transforms.size(); ++i) {
+    CollisionObject box_obj(box, transforms[i]);
+
+    // The AABB of a rotated box is the AABB of its corners.
+    AABB expected;
+    for (int c = 0; c < 8; ++c) {
+      Vec3f corner((c & 1) ? box->halfSide[0] : -box->halfSide[0],
+                   (c & 2) ? box->halfSide[1] : -box->halfSide[1],
+                   (c & 4) ? box->halfSide[2] : -box->halfSide[2]);
+      if (c == 0)
+        expected = AABB(transforms[i].transform(corner));
+      else
+        expected += transforms[i].transform(corner);
+    }
+    BOOST_CHECK(box_obj.getAABB().min_.isApprox(expected.min_, 1e-12));
+    BOOST_CHECK(box_obj.getAABB().max_.isApprox(expected.max_, 1e-12));
+
+    // The AABB of a capsule contains its two end spheres.
+    CollisionObject capsule_obj(capsule, transforms[i]);
+    const AABB& aabb = capsule_obj.getAABB();
+    for (int end = -1; end <= 1; end += 2) {
+      Vec3f center(transforms[i].transform(
+          Vec3f(0, 0, end * capsule->halfLength)));
+      Vec3f radius(Vec3f::Constant(capsule->radius - 1e-12));
+      BOOST_CHECK(aabb.contain(AABB(center - radius, center + radius)));
+    }
+    // and is tighter than the AABB of its bounding sphere.
+    BOOST_CHECK(aabb.volume() <=
+                std::pow(2 * capsule->aabb_radius, 3) + 1e-12);
+
+    objects.push_back(new CollisionObject(capsule, transforms[i]));
+  }
+
+  // The batched computation gives the same result.
+  for (size_t i = 0; i < objects.size(); ++i)
+    objects[i]->setTransform(transforms[transforms.size() - 1 - i]);
+  computeAABBs(objects);
+  for (size_t i = 0; i < objects.size(); ++i) {
+    CollisionObject expected(capsule, transforms[transforms.size() - 1 - i]);
+    BOOST_CHECK(objects[i]->getAABB() == expected.getAABB());
+    delete objects[i];
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ellipsoid_aabb) {
+  const Ellipsoid ellipsoid(0.1, 0.3, 0.2);
+  Transform3f tf(Quaternion3f(AngleAxis(M_PI / 4, UnitZ)), Vec3f(1, 2, 3));
+
+  AABB aabb;
+  computeBV(ellipsoid, tf, aabb);
+  const FCL_REAL half_x = std::sqrt(0.5 * (0.1 * 0.1 + 0.3 * 0.3));
+  BOOST_CHECK(aabb.max_.isApprox(Vec3f(1 + half_x, 2 + half_x, 3.2)));
+  BOOST_CHECK(aabb.min_.isApprox(Vec3f(1 - half_x, 2 - half_x, 2.8)));
+
+  // Under any rotation, the AABB touches the ellipsoid on each side.
+  tf.setQuatRotation(
+      Quaternion3f(AngleAxis(0.3, Vec3f(1, 2, 3).normalized())));
+  computeBV(ellipsoid, tf, aabb);
+  const Matrix3f& R = tf.getRotation();
+  for (int i = 0; i < 3; ++i) {
+    // Support point of the ellipsoid along the world axis i.
+    const Vec3f d(ellipsoid.radii.cwiseProduct(R.row(i).transpose()));
+    const Vec3f p(tf.transform(ellipsoid.radii.cwiseProduct(d) / d.norm()));
+    BOOST_CHECK_CLOSE(aabb.max_[i], p[i], 1e-8);
+    BOOST_CHECK_CLOSE(aabb.min_[i], 2 * tf.getTranslation()[i] - p[i], 1e-8);
+  }
+}
@@ -42,6 +42,9 @@
 #include <hpp/fcl/narrowphase/narrowphase.h>
 #include <hpp/fcl/shape/geometric_shapes.h>
 #include <hpp/fcl/internal/tools.h>
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
 
 #include "utility.h"
 
@@ -441,3 +444,92 @@ BOOST_AUTO_TEST_CASE(triangle_capsule) {
   test_gjk_triangle_capsule(Vec3f(-0.5, -0.01, 0), true, true, Vec3f(0, 1, 0),
                             Vec3f(0.5, 0, 0));
 }
+
+template <typename S1, typename S2>
+void test_shape_overlap(const S1& s1, const S2& s2,
+                        const std::vector<Transform3f>& tfs,
+                        FCL_REAL security_margin,
+                        bool check_lower_bound = true) {
+  using hpp::fcl::collide;
+  using hpp::fcl::CollisionRequest;
+  using hpp::fcl::CollisionResult;
+  using hpp::fcl::CONTACT;
+  using hpp::fcl::NO_REQUEST;
+
+  Transform3f identity;
+  for (std::size_t i = 0; i < tfs.size(); ++i) {
+    CollisionRequest boolean_request(NO_REQUEST, 1),
+        contact_request(CONTACT, 1);
+    boolean_request.security_margin = security_margin;
+    contact_request.security_margin = security_margin;
+
+    CollisionResult boolean_result, contact_result;
+    collide(&s1, tfs[i], &s2, identity, boolean_request, boolean_result);
+    collide(&s1, tfs[i], &s2, identity, contact_request, contact_result);
+
+    BOOST_CHECK_EQUAL(boolean_result.isCollision(),
+                      contact_result.isCollision());
+    if (boolean_result.isCollision()) {
+      // The contact of the boolean query is estimated without EPA.
+      const hpp::fcl::Contact& contact = boolean_result.getContact(0);
+      const hpp::fcl::Contact& expected = contact_result.getContact(0);
+      BOOST_CHECK(contact.pos.allFinite());
+      BOOST_CHECK_CLOSE(contact.normal.norm(), 1, 1e-6);
+      if (check_lower_bound) {
+        // Its depth is exact when the shapes are separated, and a lower
+        // bound of the penetration depth otherwise.
+        if (expected.penetration_depth < 0) {
+          BOOST_CHECK_SMALL(
+              contact.penetration_depth - expected.penetration_depth, 1e-6);
+          BOOST_CHECK(contact.normal.isApprox(expected.normal, 1e-6));
+        }
+        BOOST_CHECK_LE(contact.penetration_depth,
+                       expected.penetration_depth + 1e-6);
+      }
+    }
+    if (check_lower_bound && !boolean_result.isCollision()) {
+      // The distance lower bound of the boolean query must stay below the
+      // distance found with the full contact query.
+      hpp::fcl::DistanceRequest distance_request;
+      hpp::fcl::DistanceResult distance_result;
+      hpp::fcl::distance(&s1, tfs[i], &s2, identity, distance_request,
+                         distance_result);
+      BOOST_CHECK_LE(boolean_result.distance_lower_bound,
+                     distance_result.min_distance - security_margin + 1e-6);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(shape_overlap) {
+  using hpp::fcl::Box;
+  using hpp::fcl::BVHModel;
+  using hpp::fcl::Capsule;
+  using hpp::fcl::Cone;
+  using hpp::fcl::Cylinder;
+  using hpp::fcl::Ellipsoid;
+  using hpp::fcl::OBBRSS;
+
+  std::vector<Transform3f> tfs;
+  FCL_REAL extents[] = {-2, -2, -2, 2, 2, 2};
+  hpp::fcl::generateRandomTransforms(extents, tfs, 1000);
+
+  Box box(1, 0.5, 0.8);
+  Capsule capsule(0.3, 1.2);
+  Cone cone(0.5, 1.);
+  Cylinder cylinder(0.4, 0.9);
+  Ellipsoid ellipsoid(0.3, 0.6, 0.9);
+
+  for (FCL_REAL security_margin = -0.1; security_margin < 0.2;
+       security_margin += 0.1) {
+    test_shape_overlap(box, box, tfs, security_margin);
+    test_shape_overlap(box, capsule, tfs, security_margin);
+    test_shape_overlap(capsule, cone, tfs, security_margin);
+    test_shape_overlap(cylinder, ellipsoid, tfs, security_margin);
+    test_shape_overlap(ellipsoid, box, tfs, security_margin);
+  }
+
+  BVHModel<OBBRSS> mesh;
+  hpp::fcl::generateBVHModel(mesh, cylinder, Transform3f(), 16, 4);
+  test_shape_overlap(mesh, capsule, tfs, 0., false);
+  test_shape_overlap(ellipsoid, mesh, tfs, 0.1, false);
+}
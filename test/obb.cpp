@@ -41,6 +41,7 @@
 #include <chrono>
 
 #include <hpp/fcl/narrowphase/narrowphase.h>
+#include <hpp/fcl/BV/OBB.h>
 
 #include "../src/BV/OBB.h"
 #include <hpp/fcl/internal/shape_shape_func.h>
@@ -1309,6 +1310,90 @@ std::size_t obb_overlap_and_lower_bound_distance(std::ostream* output) {
   return nbFailure;
 }
 
+/// Compare the float and double instantiations of obbDisjoint and the time
+/// they take. They must agree, unless inflating or shrinking the boxes by
+/// the float rounding errors changes the answer.
+std::size_t obb_disjoint_float_and_double(std::ostream* output) {
+  std::size_t nbFailure = 0;
+
+  Vec3f a, b;
+  Matrix3f B;
+  Vec3f T;
+
+#ifndef NDEBUG  // if debug mode
+  static const size_t nbCases = 100;
+  static const size_t nbRunForTimeMeas = 10;
+#else
+  static const size_t nbCases = 10000;
+  static const size_t nbRunForTimeMeas = 1000;
+#endif
+  static const FCL_REAL extentNorm = 1.;
+  static const double tolerance = 1e-4;
+
+  duration_type duration_float(0), duration_double(0);
+  std::size_t nbDisjoint = 0;
+  for (std::size_t icase = 0; icase < nbCases; ++icase) {
+    randomOBBs(a, b, extentNorm);
+    randomTransform(B, T, a, b, extentNorm);
+
+    const Eigen::Matrix3d Bd(B.cast<double>());
+    const Eigen::Vector3d Td(T.cast<double>()), ad(a.cast<double>()),
+        bd(b.cast<double>());
+    const Eigen::Matrix3f Bf(B.cast<float>());
+    const Eigen::Vector3f Tf(T.cast<float>()), af(a.cast<float>()),
+        bf(b.cast<float>());
+
+    bool disjoint_double = false, disjoint_float = false;
+    clock_type::time_point start = clock_type::now();
+    for (std::size_t i = 0; i < nbRunForTimeMeas; ++i)
+      disjoint_double = obbDisjoint<double>(Bd, Td, ad, bd);
+    duration_double += clock_type::now() - start;
+
+    start = clock_type::now();
+    for (std::size_t i = 0; i < nbRunForTimeMeas; ++i)
+      disjoint_float = obbDisjoint<float>(Bf, Tf, af, bf);
+    duration_float += clock_type::now() - start;
+
+    if (disjoint_double) ++nbDisjoint;
+    if (disjoint_float == disjoint_double) continue;
+    const Eigen::Vector3d ad_inflated((1 + tolerance) * ad),
+        bd_inflated((1 + tolerance) * bd), ad_shrunk((1 - tolerance) * ad),
+        bd_shrunk((1 - tolerance) * bd);
+    const bool ambiguous =
+        obbDisjoint<double>(Bd, Td, ad_inflated, bd_inflated) !=
+        obbDisjoint<double>(Bd, Td, ad_shrunk, bd_shrunk);
+    if (!ambiguous) {
+      std::cerr << "Failure: float and double obbDisjoint mismatch."
+                << "\nR = "
+                << Quaternion3f(B).coeffs().transpose().format(py_fmt)
+                << "\nT = " << T.transpose().format(py_fmt)
+                << "\na = " << a.transpose().format(py_fmt)
+                << "\nb = " << b.transpose().format(py_fmt) << '\n'
+                << std::endl;
+      nbFailure++;
+    }
+  }
+
+  if (output != NULL) {
+    const double N = static_cast<double>(nbCases * nbRunForTimeMeas);
+    *output << "obbDisjoint on " << nbCases << " cases (" << nbDisjoint
+            << " disjoint)" << sep << "double (us)" << sep
+            << static_cast<double>(
+                   std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       duration_double)
+                       .count()) *
+                   1e-3 / N
+            << sep << "float (us)" << sep
+            << static_cast<double>(
+                   std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       duration_float)
+                       .count()) *
+                   1e-3 / N
+            << '\n';
+  }
+  return nbFailure;
+}
+
 int main(int argc, char** argv) {
   std::ostream* output = NULL;
   if (argc > 1 && strcmp(argv[1], "--generate-output") == 0) {
@@ -1324,6 +1409,7 @@ int main(int argc, char** argv) {
                "\n";
 
   std::size_t nbFailure = obb_overlap_and_lower_bound_distance(output);
+  nbFailure += obb_disjoint_float_and_double(output);
   if (nbFailure > INT_MAX) return INT_MAX;
   return (int)nbFailure;
 }
@@ -0,0 +1,222 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_MODULE FCL_PAIR_CACHE
+#include <boost/test/included/unit_test.hpp>
+
+#include <vector>
+
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+#include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
+#include <hpp/fcl/BVH/BVH_model.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// @brief Placement along a path which translates from start to end while
+/// rotating around a fixed axis.
+Transform3f pathPlacement(const Vec3f& start, const Vec3f& end,
+                          FCL_REAL angle, FCL_REAL t) {
+  const Vec3f axis(Vec3f(1, 2, 3).normalized());
+  return Transform3f(
+      Eigen::AngleAxis<FCL_REAL>(angle * t, axis).toRotationMatrix(),
+      (1 - t) * start + t * end);
+}
+
+BOOST_AUTO_TEST_CASE(motion_bound) {
+  Box box(0.4, 0.6, 0.8);
+  Capsule capsule(0.2, 1.);
+  Sphere sphere(0.5);
+  capsule.computeLocalAABB();
+
+  std::vector<Transform3f> transforms;
+  FCL_REAL extents[] = {-1, -1, -1, 1, 1, 1};
+  generateRandomTransforms(extents, transforms, 200);
+
+  PairCache cache;
+  for (std::size_t i = 0; i + 1 < transforms.size(); i += 2) {
+    cache.relative_pose = transforms[i];
+    const Transform3f& new_pose = transforms[i + 1];
+    // The local AABB of the box is unknown: the bound is given by the motion
+    // of the capsule in the frame of the box.
+    const FCL_REAL bound = cache.motionBound(&box, &capsule, new_pose);
+    const AABB& aabb = capsule.aabb_local;
+    for (int k = 0; k < 8; ++k) {
+      const Vec3f corner((k & 1) ? aabb.min_[0] : aabb.max_[0],
+                         (k & 2) ? aabb.min_[1] : aabb.max_[1],
+                         (k & 4) ? aabb.min_[2] : aabb.max_[2]);
+      const FCL_REAL displacement =
+          (new_pose.transform(corner) - cache.relative_pose.transform(corner))
+              .norm();
+      BOOST_CHECK_LE(displacement, bound + 1e-12);
+    }
+    BOOST_CHECK_EQUAL(
+        cache.motionBound(&box, &capsule, cache.relative_pose), 0);
+    BOOST_CHECK(std::isinf(cache.motionBound(&box, &sphere, new_pose)));
+  }
+
+  box.computeLocalAABB();
+  for (std::size_t i = 0; i + 1 < transforms.size(); i += 2) {
+    cache.relative_pose = transforms[i];
+    const Transform3f& new_pose = transforms[i + 1];
+    const FCL_REAL bound = cache.motionBound(&box, &capsule, new_pose);
+    BOOST_CHECK_LE(bound, cache.motionBound(&sphere, &capsule, new_pose));
+    BOOST_CHECK_LE(bound, cache.motionBound(&box, &sphere, new_pose));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(collision) {
+  Capsule capsule(0.2, 1.);
+  Ellipsoid ellipsoid(0.3, 0.4, 0.5);
+  capsule.computeLocalAABB();
+  ellipsoid.computeLocalAABB();
+
+  ComputeCollision compute(&capsule, &ellipsoid);
+  const Transform3f tf1(Transform3f::Identity());
+  const Vec3f start(3, 0.5, 0.2), end(0.1, 0, 0);
+  const std::size_t n = 400;
+  const FCL_REAL eps = 1e-6;
+
+  // The reference computes the distance lower bound, which is otherwise only
+  // bounded by GJK when no contact information is requested.
+  CollisionRequest request, reference_request;
+  reference_request.enable_distance_lower_bound = true;
+  PairCache cache;
+  for (FCL_REAL margin = 0; margin < 0.15; margin += 0.1) {
+    request.security_margin = margin;
+    reference_request.security_margin = margin;
+    cache.clear();
+    std::size_t num_collisions = 0;
+    for (std::size_t i = 0; i <= n; ++i) {
+      const Transform3f tf2(pathPlacement(start, end, 1., FCL_REAL(i) / n));
+      CollisionResult reference, cached;
+      compute(tf1, tf2, reference_request, reference);
+      compute(tf1, tf2, request, cached, cache);
+
+      BOOST_CHECK_EQUAL(reference.isCollision(), cached.isCollision());
+      BOOST_CHECK_EQUAL(reference.numContacts(), cached.numContacts());
+      if (!reference.isCollision()) {
+        BOOST_CHECK_LE(cached.distance_lower_bound,
+                       reference.distance_lower_bound + eps);
+        BOOST_CHECK_GT(cached.distance_lower_bound,
+                       request.collision_distance_threshold);
+      } else
+        ++num_collisions;
+    }
+    BOOST_CHECK_GT(num_collisions, 0);
+    BOOST_CHECK_GT(cache.num_skipped_queries, 0);
+    BOOST_CHECK_LT(cache.num_skipped_queries, n - num_collisions);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(shape_distance) {
+  Capsule capsule(0.2, 1.);
+  Ellipsoid ellipsoid(0.3, 0.4, 0.5);
+  capsule.computeLocalAABB();
+  ellipsoid.computeLocalAABB();
+
+  ComputeDistance compute(&capsule, &ellipsoid);
+  const Transform3f tf1(Transform3f::Identity());
+  const Vec3f start(3, 0.5, 0.2), end(1, 0, 0);
+  const std::size_t n = 400;
+  const FCL_REAL eps = 1e-4;
+
+  // The cached distance is accurate up to the tolerance of the request.
+  DistanceRequest request(true, 0, 1e-2);
+  PairCache cache;
+  for (std::size_t i = 0; i <= n; ++i) {
+    const Transform3f tf2(pathPlacement(start, end, 1., FCL_REAL(i) / n));
+    DistanceResult reference, cached;
+    const FCL_REAL d = compute(tf1, tf2, request, reference);
+    const FCL_REAL d_cached = compute(tf1, tf2, request, cached, cache);
+
+    BOOST_CHECK_EQUAL(d_cached, cached.min_distance);
+    BOOST_CHECK_GE(d_cached, d - eps);
+    BOOST_CHECK_LE(d_cached, d + request.abs_err + eps);
+    BOOST_CHECK_CLOSE(
+        (cached.nearest_points[1] - cached.nearest_points[0]).norm(),
+        d_cached, 1e-6);
+  }
+  BOOST_CHECK_GT(cache.num_skipped_queries, 0);
+  BOOST_CHECK_LT(cache.num_skipped_queries, n);
+
+  // A query repeated at the same placement is answered from the cache.
+  request.abs_err = 0;
+  cache.clear();
+  const Transform3f tf2(pathPlacement(start, end, 1., 0.5));
+  DistanceResult first, second;
+  compute(tf1, tf2, request, first, cache);
+  BOOST_CHECK_EQUAL(cache.num_skipped_queries, 0);
+  compute(tf1, tf2, request, second, cache);
+  BOOST_CHECK_EQUAL(cache.num_skipped_queries, 1);
+  BOOST_CHECK_CLOSE(first.min_distance, second.min_distance, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(mesh_distance) {
+  BVHModel<OBBRSS> mesh;
+  generateBVHModel(mesh, Sphere(0.5), Transform3f::Identity(), 16, 16);
+  mesh.computeLocalAABB();
+  Box box(0.4, 0.6, 0.8);
+  box.computeLocalAABB();
+
+  // The box comes first: the narrow phase runs with swapped geometries.
+  ComputeDistance compute(&box, &mesh);
+  const Transform3f tf1(Transform3f::Identity());
+  const Vec3f start(2.5, 0.5, 0.2), end(1, 0, 0);
+  const std::size_t n = 200;
+  const FCL_REAL eps = 1e-6;
+
+  for (int nearest_points = 0; nearest_points < 2; ++nearest_points) {
+    DistanceRequest request(nearest_points == 1, 0, 1e-2);
+    PairCache cache;
+    for (std::size_t i = 0; i <= n; ++i) {
+      const Transform3f tf2(pathPlacement(start, end, 2., FCL_REAL(i) / n));
+      DistanceResult reference, cached;
+      const FCL_REAL d = compute(tf1, tf2, request, reference);
+      const FCL_REAL d_cached = compute(tf1, tf2, request, cached, cache);
+
+      BOOST_CHECK_GE(d_cached, d - request.abs_err - eps);
+      BOOST_CHECK_LE(d_cached, d + request.abs_err + eps);
+      // The points are reported in the same order as without cache.
+      const int i_box = (request.enable_nearest_points ? 0 : 1);
+      const Vec3f& p_box = cached.nearest_points[i_box];
+      BOOST_CHECK((p_box.array().abs() <= box.halfSide.array() + eps).all());
+    }
+    BOOST_CHECK_GT(cache.num_skipped_queries, 0);
+    BOOST_CHECK_LT(cache.num_skipped_queries, n);
+  }
+}
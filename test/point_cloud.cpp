@@ -0,0 +1,367 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_MODULE FCL_POINT_CLOUD
+#include <boost/test/included/unit_test.hpp>
+
+#include <set>
+
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/hfield.h>
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/narrowphase/narrowphase.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+#include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
+#include <hpp/fcl/internal/traversal_node_point_cloud.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// @brief Cloud of n random points in [-1, 1]^3.
+template <typename BV>
+shared_ptr<BVHModel<BV> > makeCloud(std::size_t n, FCL_REAL radius) {
+  std::vector<Vec3f> points(n);
+  for (std::size_t i = 0; i < n; ++i) points[i] = Vec3f::Random();
+  shared_ptr<BVHModel<BV> > cloud(new BVHModel<BV>);
+  cloud->beginModel();
+  cloud->addSubModel(points);
+  cloud->endModel();
+  cloud->point_radius = radius;
+  cloud->computeLocalAABB();
+  return cloud;
+}
+
+/// @brief Distance between the sphere of the point i of the cloud and geom.
+FCL_REAL pointDistance(const BVHModelBase& cloud, const Transform3f& tf1,
+                       int i, const CollisionGeometry* geom,
+                       const Transform3f& tf2) {
+  Sphere sphere(cloud.point_radius);
+  DistanceRequest request;
+  DistanceResult result;
+  return distance(&sphere, Transform3f(tf1.transform(cloud.vertices[i])), geom,
+                  tf2, request, result);
+}
+
+/// @brief Indices of the points of the cloud whose sphere collides with geom.
+std::set<int> collidingPoints(const BVHModelBase& cloud, const Transform3f& tf1,
+                              const CollisionGeometry* geom,
+                              const Transform3f& tf2) {
+  std::set<int> points;
+  Sphere sphere(cloud.point_radius);
+  CollisionRequest request;
+  for (unsigned int i = 0; i < cloud.num_vertices; ++i) {
+    CollisionResult result;
+    if (collide(&sphere, Transform3f(tf1.transform(cloud.vertices[i])), geom,
+                tf2, request, result))
+      points.insert((int)i);
+  }
+  return points;
+}
+
+/// @brief Indices of the points of the cloud in the contacts of result, where
+/// the cloud is the object index.
+std::set<int> contactPoints(const CollisionResult& result, int index) {
+  std::set<int> points;
+  for (std::size_t i = 0; i < result.numContacts(); ++i)
+    points.insert(index == 0 ? result.getContact(i).b1
+                             : result.getContact(i).b2);
+  return points;
+}
+
+template <typename BV>
+void testShapeCollision(const ShapeBase& shape) {
+  shared_ptr<BVHModel<BV> > cloud = makeCloud<BV>(300, 0.05);
+  FCL_REAL extents[] = {-1, -1, -1, 1, 1, 1};
+  std::vector<Transform3f> tf1s, tf2s;
+  generateRandomTransforms(extents, tf1s, 10);
+  generateRandomTransforms(extents, tf2s, 10);
+
+  std::size_t n_collisions = 0;
+  for (std::size_t k = 0; k < tf1s.size(); ++k) {
+    const std::set<int> expected =
+        collidingPoints(*cloud, tf1s[k], &shape, tf2s[k]);
+
+    CollisionRequest request(CONTACT, 1000);
+    CollisionResult result;
+    collide(cloud.get(), tf1s[k], &shape, tf2s[k], request, result);
+    BOOST_CHECK(contactPoints(result, 0) == expected);
+
+    // The shape first, without contacts.
+    CollisionRequest overlap_request(NO_REQUEST, 1);
+    CollisionResult overlap_result;
+    const bool collision = collide(&shape, tf2s[k], cloud.get(), tf1s[k],
+                                   overlap_request, overlap_result);
+    BOOST_CHECK_EQUAL(collision, !expected.empty());
+    if (!expected.empty()) {
+      ++n_collisions;
+      const Contact& contact = overlap_result.getContact(0);
+      BOOST_CHECK(contact.pos.allFinite());
+      BOOST_CHECK(contact.normal.allFinite());
+      BOOST_CHECK(std::isfinite(contact.penetration_depth));
+    }
+  }
+  BOOST_CHECK(n_collisions > 0);
+}
+
+template <typename BV>
+void testShapeCollision() {
+  testShapeCollision<BV>(Box(0.6, 0.4, 0.8));
+  testShapeCollision<BV>(Sphere(0.3));
+  testShapeCollision<BV>(Capsule(0.1, 0.6));
+  testShapeCollision<BV>(Cylinder(0.2, 0.5));
+  testShapeCollision<BV>(Ellipsoid(0.2, 0.3, 0.4));
+  testShapeCollision<BV>(Halfspace(Vec3f(0, 0, 1), 0.8));
+}
+
+BOOST_AUTO_TEST_CASE(point_cloud_shape_collision) {
+  testShapeCollision<AABB>();
+  testShapeCollision<OBB>();
+  testShapeCollision<RSS>();
+  testShapeCollision<kIOS>();
+  testShapeCollision<OBBRSS>();
+  testShapeCollision<KDOP<16> >();
+}
+
+template <typename BV>
+void testShapeDistance(const ShapeBase& shape) {
+  shared_ptr<BVHModel<BV> > cloud = makeCloud<BV>(300, 0.05);
+  FCL_REAL extents[] = {-3, -3, -3, 3, 3, 3};
+  std::vector<Transform3f> tf1s, tf2s;
+  generateRandomTransforms(extents, tf1s, 10);
+  generateRandomTransforms(extents, tf2s, 10);
+
+  for (std::size_t k = 0; k < tf1s.size(); ++k) {
+    FCL_REAL expected = (std::numeric_limits<FCL_REAL>::max)();
+    for (unsigned int i = 0; i < cloud->num_vertices; ++i)
+      expected = (std::min)(expected, pointDistance(*cloud, tf1s[k], (int)i,
+                                                    &shape, tf2s[k]));
+
+    DistanceRequest request(true);
+    DistanceResult result;
+    const FCL_REAL d =
+        distance(cloud.get(), tf1s[k], &shape, tf2s[k], request, result);
+    if (expected > 0) {
+      BOOST_CHECK_CLOSE(d, expected, 1e-6);
+      BOOST_CHECK_CLOSE(pointDistance(*cloud, tf1s[k], result.b1, &shape,
+                                      tf2s[k]),
+                        expected, 1e-6);
+      BOOST_CHECK_CLOSE(
+          (result.nearest_points[1] - result.nearest_points[0]).norm(), d,
+          1e-4);
+    } else
+      BOOST_CHECK(d <= 0);
+  }
+}
+
+template <typename BV>
+void testShapeDistance() {
+  testShapeDistance<BV>(Box(0.6, 0.4, 0.8));
+  testShapeDistance<BV>(Sphere(0.3));
+  testShapeDistance<BV>(Capsule(0.1, 0.6));
+  testShapeDistance<BV>(Cylinder(0.2, 0.5));
+  testShapeDistance<BV>(Ellipsoid(0.2, 0.3, 0.4));
+}
+
+BOOST_AUTO_TEST_CASE(point_cloud_shape_distance) {
+  testShapeDistance<OBB>();
+  testShapeDistance<RSS>();
+  testShapeDistance<kIOS>();
+  testShapeDistance<OBBRSS>();
+}
+
+/// @brief Pairs (point, primitive) of the cloud and the model whose distance
+/// is lower than the security margin, and minimal distance between them.
+template <typename BV>
+std::set<std::pair<int, int> > collidingPairs(const BVHModel<BV>& cloud,
+                                              const Transform3f& tf1,
+                                              const BVHModel<BV>& model,
+                                              const Transform3f& tf2,
+                                              FCL_REAL& min_distance) {
+  GJKSolver solver;
+  std::set<std::pair<int, int> > pairs;
+  min_distance = (std::numeric_limits<FCL_REAL>::max)();
+  const unsigned int n = model.getModelType() == BVH_MODEL_POINTCLOUD
+                             ? model.num_vertices
+                             : model.num_tris;
+  for (unsigned int i = 0; i < cloud.num_vertices; ++i) {
+    for (unsigned int j = 0; j < n; ++j) {
+      Vec3f p1, p2, normal;
+      const FCL_REAL d = details::bvhPrimitiveDistance(
+          &solver, cloud, tf1, (int)i, model, tf2, (int)j, p1, p2, normal);
+      if (d <= 0) pairs.insert(std::make_pair((int)i, (int)j));
+      min_distance = (std::min)(min_distance, d);
+    }
+  }
+  return pairs;
+}
+
+template <typename BV>
+void testBVHCollision(const BVHModel<BV>& cloud, const BVHModel<BV>& model,
+                      bool test_distance) {
+  FCL_REAL extents[] = {-1, -1, -1, 1, 1, 1};
+  std::vector<Transform3f> tf1s, tf2s;
+  generateRandomTransforms(extents, tf1s, 10);
+  generateRandomTransforms(extents, tf2s, 10);
+
+  for (std::size_t k = 0; k < tf1s.size(); ++k) {
+    FCL_REAL expected_distance;
+    const std::set<std::pair<int, int> > expected =
+        collidingPairs(cloud, tf1s[k], model, tf2s[k], expected_distance);
+
+    CollisionRequest request(CONTACT, 100000);
+    CollisionResult result;
+    collide(&cloud, tf1s[k], &model, tf2s[k], request, result);
+    std::set<std::pair<int, int> > pairs;
+    for (std::size_t i = 0; i < result.numContacts(); ++i)
+      pairs.insert(std::make_pair(result.getContact(i).b1,
+                                  result.getContact(i).b2));
+    BOOST_CHECK(pairs == expected);
+
+    // The model first.
+    CollisionRequest overlap_request(NO_REQUEST, 1);
+    CollisionResult overlap_result;
+    BOOST_CHECK_EQUAL(collide(&model, tf2s[k], &cloud, tf1s[k],
+                              overlap_request, overlap_result) > 0,
+                      !expected.empty());
+
+    if (!test_distance) continue;
+    DistanceRequest distance_request;
+    DistanceResult distance_result;
+    const FCL_REAL d = distance(&cloud, tf1s[k], &model, tf2s[k],
+                                distance_request, distance_result);
+    if (expected_distance > 0)
+      BOOST_CHECK_CLOSE(d, expected_distance, 1e-6);
+    else
+      BOOST_CHECK(d <= 0);
+  }
+}
+
+template <typename BV>
+void testBVHCollision(bool test_distance) {
+  shared_ptr<BVHModel<BV> > cloud = makeCloud<BV>(100, 0.05);
+  shared_ptr<BVHModel<BV> > other = makeCloud<BV>(100, 0.1);
+  BVHModel<BV> mesh;
+  generateBVHModel(mesh, Sphere(0.5), Transform3f(), 8, 8);
+
+  testBVHCollision(*cloud, mesh, test_distance);
+  testBVHCollision(*cloud, *other, test_distance);
+}
+
+BOOST_AUTO_TEST_CASE(point_cloud_bvh) {
+  testBVHCollision<AABB>(true);
+  testBVHCollision<OBB>(true);
+  testBVHCollision<RSS>(true);
+  testBVHCollision<kIOS>(true);
+  testBVHCollision<OBBRSS>(true);
+  testBVHCollision<KDOP<16> >(false);
+}
+
+template <typename BV>
+void testHeightField() {
+  const Eigen::DenseIndex nx = 10, ny = 12;
+  const MatrixXf heights = 0.2 * MatrixXf::Random(ny, nx);
+  HeightField<BV> hfield(2, 2, heights, -0.5);
+  shared_ptr<BVHModel<BV> > cloud = makeCloud<BV>(300, 0.02);
+
+  FCL_REAL extents[] = {-0.5, -0.5, -0.5, 0.5, 0.5, 0.5};
+  std::vector<Transform3f> tf1s;
+  generateRandomTransforms(extents, tf1s, 10);
+  const Transform3f tf2(makeQuat(0.9, 0.1, 0.3, 0.2).normalized(),
+                        Vec3f(0.1, -0.2, 0.05));
+
+  std::size_t n_collisions = 0;
+  for (std::size_t k = 0; k < tf1s.size(); ++k) {
+    const std::set<int> expected =
+        collidingPoints(*cloud, tf1s[k], &hfield, tf2);
+
+    CollisionRequest request(CONTACT, 100000);
+    CollisionResult result;
+    collide(cloud.get(), tf1s[k], &hfield, tf2, request, result);
+    BOOST_CHECK(contactPoints(result, 0) == expected);
+
+    CollisionResult swapped_result;
+    collide(&hfield, tf2, cloud.get(), tf1s[k], request, swapped_result);
+    BOOST_CHECK(contactPoints(swapped_result, 1) == expected);
+    if (!expected.empty()) ++n_collisions;
+  }
+  BOOST_CHECK(n_collisions > 0);
+
+  // Triangle meshes against height fields are not handled.
+  BVHModel<BV> mesh;
+  generateBVHModel(mesh, Sphere(0.5), Transform3f(), 8, 8);
+  CollisionRequest request;
+  CollisionResult result;
+  BOOST_CHECK_THROW(
+      collide(&mesh, Transform3f(), &hfield, tf2, request, result),
+      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(point_cloud_height_field) {
+  testHeightField<AABB>();
+  testHeightField<OBBRSS>();
+}
+
+BOOST_AUTO_TEST_CASE(point_radius) {
+  shared_ptr<BVHModel<OBBRSS> > cloud = makeCloud<OBBRSS>(50, 0);
+  const AABB aabb = cloud->aabb_local;
+  cloud->point_radius = 0.1;
+  cloud->computeLocalAABB();
+  const Vec3f radius(Vec3f::Constant(0.1));
+  BOOST_CHECK(cloud->aabb_local.min_.isApprox(aabb.min_ - radius));
+  BOOST_CHECK(cloud->aabb_local.max_.isApprox(aabb.max_ + radius));
+
+  // A point at distance 0.05 of the box collides only when its radius is
+  // larger.
+  shared_ptr<BVHModel<OBBRSS> > point(new BVHModel<OBBRSS>);
+  point->beginModel();
+  point->addVertex(Vec3f(0.55, 0, 0));
+  point->endModel();
+  Box box(1, 1, 1);
+  CollisionRequest request;
+  CollisionResult result;
+  BOOST_CHECK(!collide(point.get(), Transform3f(), &box, Transform3f(), request,
+                       result));
+  point->point_radius = 0.1;
+  result.clear();
+  BOOST_CHECK(collide(point.get(), Transform3f(), &box, Transform3f(), request,
+                      result));
+
+  DistanceRequest distance_request;
+  DistanceResult distance_result;
+  BOOST_CHECK_CLOSE(distance(point.get(), Transform3f(), &box, Transform3f(),
+                             distance_request, distance_result),
+                    -0.05, 1e-6);
+}
@@ -190,6 +190,9 @@ class TestGeometricShapes(TestCase):
                     str(e), "You shouldn't use this function with less than 4 points."
                 )
 
+        convexHull = hppfcl.Convex.quickHull(verts, True)
+        self.assertEqual(convexHull.num_points, 4)
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -0,0 +1,180 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_MODULE FCL_QUERY_PROFILE
+#include <boost/test/included/unit_test.hpp>
+
+#include <thread>
+#include <vector>
+
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+#include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
+#include <hpp/fcl/BVH/BVH_model.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// @brief Check a counter: positive when the library records the profile,
+/// zero otherwise.
+#define CHECK_COUNTER(counter)                  \
+  if (QueryProfile::enabled())                  \
+    BOOST_CHECK_GT(counter, 0);                 \
+  else                                          \
+    BOOST_CHECK_EQUAL(counter, 0)
+
+BOOST_AUTO_TEST_CASE(shape_queries) {
+  Ellipsoid ellipsoid(0.3, 0.4, 0.5);
+  Box box(0.6, 0.4, 0.2);
+  Transform3f tf1(Transform3f::Identity()), tf2(Transform3f::Identity());
+
+  // Disjoint shapes: only GJK runs.
+  tf2.setTranslation(Vec3f(1, 0, 0));
+  DistanceRequest distance_request;
+  DistanceResult distance_result;
+  distance(&ellipsoid, tf1, &box, tf2, distance_request, distance_result);
+  const QueryProfile& profile = distance_result.profile;
+  CHECK_COUNTER(profile.num_gjk_calls);
+  CHECK_COUNTER(profile.num_gjk_iterations);
+  CHECK_COUNTER(profile.num_support_calls);
+  BOOST_CHECK_EQUAL(profile.num_epa_calls, 0);
+  BOOST_CHECK_EQUAL(profile.num_bv_tests, 0);
+  BOOST_CHECK(profile.num_gjk_iterations <= profile.num_support_calls);
+
+  // Penetrating shapes: EPA computes the penetration depth.
+  tf2.setTranslation(Vec3f(0.2, 0.1, 0));
+  CollisionRequest collision_request(CONTACT, 1);
+  CollisionResult collision_result;
+  collide(&ellipsoid, tf1, &box, tf2, collision_request, collision_result);
+  BOOST_CHECK(collision_result.isCollision());
+  CHECK_COUNTER(collision_result.profile.num_gjk_calls);
+  CHECK_COUNTER(collision_result.profile.num_epa_calls);
+  CHECK_COUNTER(collision_result.profile.num_epa_iterations);
+  BOOST_CHECK(collision_result.profile.num_support_calls >
+              collision_result.profile.num_gjk_iterations ||
+              !QueryProfile::enabled());
+
+  // ComputeCollision records the same profile as collide.
+  const QueryProfile first = collision_result.profile;
+  ComputeCollision calc_collision(&ellipsoid, &box);
+  collision_result.clear();
+  calc_collision(tf1, tf2, collision_request, collision_result);
+  BOOST_CHECK_EQUAL(collision_result.profile.num_gjk_calls,
+                    first.num_gjk_calls);
+  BOOST_CHECK_EQUAL(collision_result.profile.num_epa_iterations,
+                    first.num_epa_iterations);
+
+  // The profile only covers the last query, which returns early here since
+  // the result already holds the requested contact.
+  calc_collision(tf1, tf2, collision_request, collision_result);
+  BOOST_CHECK_EQUAL(collision_result.profile.num_gjk_calls, 0);
+  BOOST_CHECK_EQUAL(collision_result.numContacts(), 1);
+
+  collision_result.clear();
+  BOOST_CHECK_EQUAL(collision_result.profile.num_gjk_calls, 0);
+}
+
+BOOST_AUTO_TEST_CASE(mesh_queries) {
+  BVHModel<OBBRSS> mesh1, mesh2;
+  generateBVHModel(mesh1, Sphere(1), Transform3f::Identity(), 16, 16);
+  generateBVHModel(mesh2, Box(1, 2, 1), Transform3f::Identity());
+  Transform3f tf(Transform3f::Identity());
+  tf.setTranslation(Vec3f(1.2, 0, 0));
+
+  CollisionRequest collision_request(CONTACT, 100);
+  CollisionResult collision_result;
+  collide(&mesh1, tf, &mesh2, Transform3f::Identity(), collision_request,
+          collision_result);
+  BOOST_CHECK(collision_result.isCollision());
+  CHECK_COUNTER(collision_result.profile.num_bv_tests);
+  CHECK_COUNTER(collision_result.profile.num_leaf_tests);
+
+  // Mesh against shape: the leaf tests run GJK.
+  Capsule capsule(0.2, 1);
+  DistanceRequest distance_request;
+  DistanceResult distance_result;
+  distance(&mesh1, tf, &capsule, Transform3f::Identity(), distance_request,
+           distance_result);
+  CHECK_COUNTER(distance_result.profile.num_bv_tests);
+  CHECK_COUNTER(distance_result.profile.num_leaf_tests);
+  CHECK_COUNTER(distance_result.profile.num_gjk_calls);
+}
+
+BOOST_AUTO_TEST_CASE(aggregate_across_threads) {
+  Ellipsoid ellipsoid(0.3, 0.4, 0.5);
+  Cylinder cylinder(0.3, 0.8);
+  FCL_REAL extents[] = {-1, -1, -1, 1, 1, 1};
+  std::vector<Transform3f> tf;
+  generateRandomTransforms(extents, tf, 400);
+  ComputeCollision calc_collision(&ellipsoid, &cylinder);
+  CollisionRequest request(CONTACT, 1);
+
+  // Sequential reference
+  QueryProfile expected;
+  for (std::size_t i = 0; i < tf.size(); ++i) {
+    CollisionResult result;
+    calc_collision(tf[i], Transform3f::Identity(), request, result);
+    expected += result.profile;
+  }
+
+  const std::size_t num_threads = 4;
+  std::vector<QueryProfile> profiles(num_threads);
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < num_threads; ++t)
+    threads.push_back(std::thread([&, t]() {
+      for (std::size_t i = t; i < tf.size(); i += num_threads) {
+        CollisionResult result;
+        calc_collision(tf[i], Transform3f::Identity(), request, result);
+        profiles[t] += result.profile;
+      }
+    }));
+  QueryProfile total;
+  for (std::size_t t = 0; t < num_threads; ++t) {
+    threads[t].join();
+    total += profiles[t];
+  }
+
+  BOOST_CHECK_EQUAL(total.num_gjk_calls, expected.num_gjk_calls);
+  BOOST_CHECK_EQUAL(total.num_gjk_iterations, expected.num_gjk_iterations);
+  BOOST_CHECK_EQUAL(total.num_support_calls, expected.num_support_calls);
+  BOOST_CHECK_EQUAL(total.num_epa_calls, expected.num_epa_calls);
+  BOOST_CHECK_EQUAL(total.num_epa_iterations, expected.num_epa_iterations);
+  BOOST_CHECK_EQUAL(total.num_epa_fallbacks, expected.num_epa_fallbacks);
+  if (QueryProfile::enabled()) {
+    BOOST_CHECK_EQUAL(total.num_gjk_calls, tf.size());
+    BOOST_CHECK_GT(total.gjk_time, 0);
+  }
+}
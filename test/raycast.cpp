@@ -0,0 +1,340 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_MODULE FCL_RAYCAST
+#include <boost/test/included/unit_test.hpp>
+
+#include <vector>
+
+#include <hpp/fcl/raycast.h>
+#include <hpp/fcl/hfield.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+#include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
+#include <hpp/fcl/BVH/BVH_model.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// @brief Random rays whose origin lies in [-extent, extent]^3 and which
+/// point towards the origin, up to a random offset.
+std::vector<Ray> randomRays(FCL_REAL extent, std::size_t n) {
+  std::vector<Ray> rays;
+  for (std::size_t i = 0; i < n; ++i) {
+    const Vec3f origin(Vec3f::Random() * extent);
+    const Vec3f target(Vec3f::Random());
+    rays.push_back(Ray(origin, target - origin));
+  }
+  return rays;
+}
+
+void checkHit(const CollisionGeometry* geom, const Transform3f& tf,
+              const Ray& ray, FCL_REAL distance, const Vec3f& normal) {
+  RayResult result;
+  BOOST_CHECK(raycast(geom, tf, ray, RayRequest(), result));
+  BOOST_CHECK_CLOSE(result.distance, distance, 1e-8);
+  EIGEN_VECTOR_IS_APPROX(result.normal, normal, 1e-8);
+  BOOST_CHECK_EQUAL(result.primitive_id, -1);
+}
+
+BOOST_AUTO_TEST_CASE(shapes) {
+  const Transform3f tf(Vec3f(1, 2, 3));
+  const Vec3f down(0, 0, -1);
+  const Ray ray(Vec3f(1, 2, 8), down);
+
+  Box box(2, 4, 6);
+  checkHit(&box, tf, ray, 2, Vec3f::UnitZ());
+  // A ray starting inside a shape hits it where it leaves the shape.
+  checkHit(&box, tf, Ray(Vec3f(1, 2, 3), Vec3f(1, 0, 0)), 1, -Vec3f::UnitX());
+
+  Sphere sphere(1);
+  checkHit(&sphere, tf, ray, 4, Vec3f::UnitZ());
+  checkHit(&sphere, tf, Ray(Vec3f(1, 2, 3), down), 1, Vec3f::UnitZ());
+
+  Ellipsoid ellipsoid(1, 2, 3);
+  checkHit(&ellipsoid, tf, ray, 2, Vec3f::UnitZ());
+  checkHit(&ellipsoid, tf, Ray(Vec3f(1, 5, 3), Vec3f(0, -1, 0)), 1,
+           Vec3f::UnitY());
+
+  Capsule capsule(1, 4);
+  checkHit(&capsule, tf, ray, 2, Vec3f::UnitZ());
+  checkHit(&capsule, tf, Ray(Vec3f(4, 2, 4), Vec3f(-1, 0, 0)), 2,
+           Vec3f::UnitX());
+
+  Cylinder cylinder(1, 4);
+  checkHit(&cylinder, tf, Ray(Vec3f(1.5, 2, 8), down), 3, Vec3f::UnitZ());
+  checkHit(&cylinder, tf, Ray(Vec3f(4, 2, 4.5), Vec3f(-1, 0, 0)), 2,
+           Vec3f::UnitX());
+  RayResult result;
+  BOOST_CHECK(!raycast(&cylinder, tf, Ray(Vec3f(4, 2, 5.5), Vec3f(-1, 0, 0)),
+                       RayRequest(), result));
+
+  // Cone of radius 1 whose apex is at z = 5 in the world frame.
+  Cone cone(1, 4);
+  checkHit(&cone, tf, Ray(Vec3f(1.5, 2, 8), down), 5,
+           Vec3f(4, 0, 1).normalized());
+  checkHit(&cone, tf, Ray(Vec3f(1.5, 2, -2), -down), 3, -Vec3f::UnitZ());
+
+  Halfspace halfspace(Vec3f(0, 0, 1), 1);
+  checkHit(&halfspace, tf, ray, 4, Vec3f::UnitZ());
+  BOOST_CHECK(!raycast(&halfspace, tf, Ray(Vec3f(1, 2, 8), -down),
+                       RayRequest(), result));
+  Plane plane(Vec3f(0, 0, 1), 1);
+  checkHit(&plane, tf, Ray(Vec3f(1, 2, 0), -down), 4, -Vec3f::UnitZ());
+
+  TriangleP triangle(Vec3f(-1, -1, 0), Vec3f(1, -1, 0), Vec3f(0, 1, 0));
+  checkHit(&triangle, tf, ray, 5, Vec3f::UnitZ());
+  BOOST_CHECK(!raycast(&triangle, tf, Ray(Vec3f(1, 4, 8), down), RayRequest(),
+                       result));
+
+  // Segments stop at their maximal distance.
+  BOOST_CHECK(
+      !raycast(&box, tf, Ray(Vec3f(1, 2, 8), down, 1.5), RayRequest(), result));
+  BOOST_CHECK(!result.hit);
+  BOOST_CHECK(
+      raycast(&box, tf, Ray(Vec3f(1, 2, 8), down, 2.5), RayRequest(), result));
+}
+
+/// @brief A mesh of a box gives the same hits as the box.
+template <typename BV>
+void testBoxMesh(const std::vector<Ray>& rays) {
+  Box box(1, 2, 3);
+  BVHModel<BV> mesh;
+  generateBVHModel(mesh, box, Transform3f());
+  const Transform3f tf(
+      Eigen::AngleAxis<FCL_REAL>(0.3, Vec3f(1, 2, 3).normalized())
+          .toRotationMatrix(),
+      Vec3f(0.1, 0.2, 0.3));
+
+  std::size_t num_hits = 0;
+  for (std::size_t i = 0; i < rays.size(); ++i) {
+    RayResult box_result, mesh_result;
+    const bool box_hit = raycast(&box, tf, rays[i], RayRequest(), box_result);
+    const bool mesh_hit =
+        raycast(&mesh, tf, rays[i], RayRequest(), mesh_result);
+    BOOST_CHECK_EQUAL(box_hit, mesh_hit);
+    if (!box_hit || !mesh_hit) continue;
+    ++num_hits;
+    BOOST_CHECK_CLOSE(box_result.distance, mesh_result.distance, 1e-6);
+    // Hits on edges may take the normal of either face.
+    const Vec3f p(tf.getRotation().transpose() *
+                  (rays[i].pointAt(box_result.distance) - tf.getTranslation()));
+    if (((p.cwiseAbs() - box.halfSide).array().abs() < 1e-6).count() == 1)
+      EIGEN_VECTOR_IS_APPROX(box_result.normal, mesh_result.normal, 1e-6);
+    BOOST_CHECK(mesh_result.primitive_id >= 0 &&
+                mesh_result.primitive_id < (int)mesh.num_tris);
+  }
+  BOOST_CHECK(num_hits > rays.size() / 4);
+}
+
+BOOST_AUTO_TEST_CASE(box_mesh) {
+  const std::vector<Ray> rays(randomRays(5, 1000));
+  testBoxMesh<AABB>(rays);
+  testBoxMesh<OBB>(rays);
+  testBoxMesh<RSS>(rays);
+  testBoxMesh<kIOS>(rays);
+  testBoxMesh<OBBRSS>(rays);
+  testBoxMesh<KDOP<16> >(rays);
+  testBoxMesh<KDOP<18> >(rays);
+  testBoxMesh<KDOP<24> >(rays);
+}
+
+/// @brief Traversal of the hierarchy of a mesh against brute force.
+template <typename BV>
+void testMeshBruteForce(const BVHModel<BV>& mesh,
+                        const std::vector<Ray>& rays) {
+  const Transform3f tf(Vec3f(0.1, -0.2, 0.3));
+  TriangleP triangle(Vec3f::Zero(), Vec3f::Zero(), Vec3f::Zero());
+  for (std::size_t i = 0; i < rays.size(); ++i) {
+    RayResult result, expected;
+    raycast(&mesh, tf, rays[i], RayRequest(), result);
+    for (unsigned int k = 0; k < mesh.num_tris; ++k) {
+      const Triangle& t = mesh.tri_indices[k];
+      triangle = TriangleP(mesh.vertices[t[0]], mesh.vertices[t[1]],
+                           mesh.vertices[t[2]]);
+      RayResult r;
+      if (raycast(&triangle, tf, rays[i], RayRequest(), r) &&
+          r.distance < expected.distance) {
+        expected = r;
+        expected.primitive_id = (int)k;
+      }
+    }
+    BOOST_CHECK_EQUAL(result.hit, expected.hit);
+    if (!expected.hit) continue;
+    BOOST_CHECK_CLOSE(result.distance, expected.distance, 1e-8);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(mesh_brute_force) {
+  Sphere sphere(1);
+  BVHModel<OBBRSS> mesh_obbrss;
+  generateBVHModel(mesh_obbrss, sphere, Transform3f(), 12, 12);
+  BVHModel<AABB> mesh_aabb;
+  generateBVHModel(mesh_aabb, sphere, Transform3f(), 12, 12);
+  const std::vector<Ray> rays(randomRays(3, 500));
+  testMeshBruteForce(mesh_obbrss, rays);
+  testMeshBruteForce(mesh_aabb, rays);
+}
+
+BOOST_AUTO_TEST_CASE(any_hit) {
+  Sphere sphere(1);
+  BVHModel<OBBRSS> mesh;
+  generateBVHModel(mesh, sphere, Transform3f(), 16, 16);
+  const std::vector<Ray> rays(randomRays(3, 500));
+  for (std::size_t i = 0; i < rays.size(); ++i) {
+    RayResult closest, any;
+    raycast(&mesh, Transform3f(), rays[i], RayRequest(RAY_CLOSEST_HIT),
+            closest);
+    raycast(&mesh, Transform3f(), rays[i], RayRequest(RAY_ANY_HIT), any);
+    BOOST_CHECK_EQUAL(closest.hit, any.hit);
+    if (any.hit) BOOST_CHECK(any.distance >= closest.distance);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(packets) {
+  Sphere sphere(1);
+  BVHModel<OBBRSS> mesh_obbrss;
+  generateBVHModel(mesh_obbrss, sphere, Transform3f(), 16, 16);
+  BVHModel<KDOP<18> > mesh_kdop;
+  generateBVHModel(mesh_kdop, sphere, Transform3f(), 16, 16);
+  const Transform3f tf(Eigen::AngleAxis<FCL_REAL>(0.5, Vec3f::UnitZ())
+                           .toRotationMatrix(),
+                       Vec3f(0.1, 0.2, 0.3));
+  // The number of rays is not a multiple of the packet sizes.
+  const std::vector<Ray> rays(randomRays(3, 501));
+
+  const CollisionGeometry* meshes[] = {&mesh_obbrss, &mesh_kdop};
+  for (int m = 0; m < 2; ++m) {
+    std::vector<RayResult> single(rays.size());
+    for (std::size_t i = 0; i < rays.size(); ++i)
+      raycast(meshes[m], tf, rays[i], RayRequest(), single[i]);
+
+    const unsigned int sizes[] = {1, 4, 8};
+    for (int s = 0; s < 3; ++s) {
+      std::vector<RayResult> results(rays.size());
+      const std::size_t num_hits =
+          raycast(meshes[m], tf, rays.data(), rays.size(),
+                  RayRequest(RAY_CLOSEST_HIT, sizes[s]), results.data());
+      std::size_t expected_hits = 0;
+      for (std::size_t i = 0; i < rays.size(); ++i) {
+        BOOST_CHECK_EQUAL(results[i].hit, single[i].hit);
+        if (!single[i].hit) continue;
+        ++expected_hits;
+        BOOST_CHECK_CLOSE(results[i].distance, single[i].distance, 1e-8);
+        BOOST_CHECK_EQUAL(results[i].primitive_id, single[i].primitive_id);
+        EIGEN_VECTOR_IS_APPROX(results[i].normal, single[i].normal, 1e-8);
+      }
+      BOOST_CHECK_EQUAL(num_hits, expected_hits);
+
+      raycast(meshes[m], tf, rays.data(), rays.size(),
+              RayRequest(RAY_ANY_HIT, sizes[s]), results.data());
+      for (std::size_t i = 0; i < rays.size(); ++i)
+        BOOST_CHECK_EQUAL(results[i].hit, single[i].hit);
+    }
+  }
+
+  RayResult result;
+  BOOST_CHECK_THROW(raycast(&mesh_obbrss, tf, rays.data(), rays.size(),
+                            RayRequest(RAY_CLOSEST_HIT, 3), &result),
+                    std::invalid_argument);
+}
+
+/// @brief The height field gives the same hits as the mesh of its cells.
+BOOST_AUTO_TEST_CASE(height_field) {
+  const Eigen::DenseIndex nx = 7, ny = 5;
+  const MatrixXf heights(MatrixXf::Random(ny, nx));
+  HeightField<OBBRSS> hfield(3, 2, heights, -2);
+  const VecXf &x_grid = hfield.getXGrid(), &y_grid = hfield.getYGrid();
+
+  BVHModel<OBBRSS> mesh;
+  mesh.beginModel();
+  for (Eigen::DenseIndex row = 0; row + 1 < ny; ++row) {
+    for (Eigen::DenseIndex col = 0; col + 1 < nx; ++col) {
+      const Vec3f p00(x_grid[col], y_grid[row], heights(row, col)),
+          p10(x_grid[col], y_grid[row + 1], heights(row + 1, col)),
+          p11(x_grid[col + 1], y_grid[row + 1], heights(row + 1, col + 1)),
+          p01(x_grid[col + 1], y_grid[row], heights(row, col + 1));
+      mesh.addTriangle(p00, p10, p01);
+      mesh.addTriangle(p10, p11, p01);
+    }
+  }
+  mesh.endModel();
+
+  const Transform3f tf(Eigen::AngleAxis<FCL_REAL>(0.2, Vec3f::UnitX())
+                           .toRotationMatrix(),
+                       Vec3f(0.1, 0.2, 0.3));
+  std::vector<Ray> rays(randomRays(4, 1000));
+  // Rays which graze the surface cross many cells.
+  for (int i = 0; i < 200; ++i)
+    rays.push_back(Ray(Vec3f(-2, Vec3f::Random()[0], 1),
+                       Vec3f(1, 0.3 * Vec3f::Random()[0], -0.2)));
+
+  std::size_t num_hits = 0;
+  for (std::size_t i = 0; i < rays.size(); ++i) {
+    RayResult hfield_result, mesh_result;
+    raycast(&hfield, tf, rays[i], RayRequest(), hfield_result);
+    raycast(&mesh, tf, rays[i], RayRequest(), mesh_result);
+    BOOST_CHECK_EQUAL(hfield_result.hit, mesh_result.hit);
+    if (!hfield_result.hit || !mesh_result.hit) continue;
+    ++num_hits;
+    BOOST_CHECK_CLOSE(hfield_result.distance, mesh_result.distance, 1e-6);
+    BOOST_CHECK_EQUAL(hfield_result.primitive_id,
+                      mesh_result.primitive_id / 2);
+
+    RayResult any;
+    raycast(&hfield, tf, rays[i], RayRequest(RAY_ANY_HIT), any);
+    BOOST_CHECK(any.hit);
+  }
+  BOOST_CHECK(num_hits > rays.size() / 4);
+}
+
+#ifdef HPP_FCL_HAS_OCTOMAP
+BOOST_AUTO_TEST_CASE(octree) {
+  const FCL_REAL resolution = 0.5;
+  octomap::OcTreePtr_t tree(new octomap::OcTree(resolution));
+  tree->updateNode(octomap::point3d(0.25f, 0.25f, 0.25f), true);
+  tree->updateNode(octomap::point3d(0.25f, 0.25f, 2.25f), true);
+  tree->updateNode(octomap::point3d(0.25f, 0.25f, 1.25f), false);
+  OcTree octree(tree);
+
+  checkHit(&octree, Transform3f(), Ray(Vec3f(0.25, 0.25, -2), Vec3f::UnitZ()),
+           2, -Vec3f::UnitZ());
+  checkHit(&octree, Transform3f(), Ray(Vec3f(0.25, 0.25, 4), -Vec3f::UnitZ()),
+           1.5, Vec3f::UnitZ());
+  RayResult result;
+  BOOST_CHECK(!raycast(&octree, Transform3f(),
+                       Ray(Vec3f(2.25, 0.25, -2), Vec3f::UnitZ()),
+                       RayRequest(), result));
+}
+#endif
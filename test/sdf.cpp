@@ -0,0 +1,234 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_MODULE FCL_SDF
+#include <boost/test/included/unit_test.hpp>
+
+#include <hpp/fcl/sdf.h>
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+#include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// @brief Exact signed distance to the box [-half, half].
+FCL_REAL boxDistance(const Vec3f& half, const Vec3f& p) {
+  const Vec3f q(p.cwiseAbs() - half);
+  return q.cwiseMax(0).norm() + (std::min)(q.maxCoeff(), FCL_REAL(0));
+}
+
+BOOST_AUTO_TEST_CASE(box_field) {
+  const Vec3f half(1, 0.5, 0.75);
+  BVHModel<OBBRSS> mesh;
+  generateBVHModel(mesh, Box(2 * half), Transform3f());
+  const FCL_REAL h = 0.02;
+  SignedDistanceField sdf(mesh, h);
+  BOOST_CHECK_EQUAL(sdf.getNarrowBand(), 3 * h);
+  BOOST_CHECK(sdf.getNumSampledBricks() > 0);
+  BOOST_CHECK(sdf.getNumSampledBricks() <
+              (std::size_t)sdf.getNumBricks().prod());
+  BOOST_CHECK(sdf.aabb_local.contain(half));
+  BOOST_CHECK(sdf.aabb_local.contain(-half));
+
+  for (int i = 0; i < 1000; ++i) {
+    const Vec3f p(Vec3f::Random().cwiseProduct(half + Vec3f::Constant(0.3)));
+    const FCL_REAL exact = boxDistance(half, p);
+    Vec3f gradient;
+    const FCL_REAL d = sdf.distance(p, gradient);
+    // Within the narrow band, the field is sampled at every voxel.
+    if (std::abs(exact) < sdf.getNarrowBand())
+      BOOST_CHECK_SMALL(d - exact, 0.2 * h);
+    else
+      BOOST_CHECK_SMALL(d - exact, SignedDistanceField::brick_size * h);
+    BOOST_CHECK_EQUAL(d, sdf.distance(p));
+    if (std::abs(exact) > 0.1 * h) BOOST_CHECK_EQUAL(d < 0, exact < 0);
+  }
+
+  // Far from the grid, the field is an upper bound of the distance.
+  for (int i = 0; i < 100; ++i) {
+    const Vec3f p(10 * Vec3f::Random());
+    BOOST_CHECK(sdf.distance(p) >= boxDistance(half, p) - 0.1 * h);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(gradient) {
+  const Vec3f half(1, 1, 1);
+  BVHModel<OBBRSS> mesh;
+  generateBVHModel(mesh, Box(2 * half), Transform3f());
+  const FCL_REAL h = 0.05;
+  SignedDistanceField sdf(mesh, h);
+
+  // The gradient of the trilinear interpolation matches finite differences
+  // within a voxel, and the gradient of the distance close to the faces.
+  const FCL_REAL eps = 1e-6;
+  for (int i = 0; i < 200; ++i) {
+    const Vec3f p(Vec3f::Random() * 1.4);
+    Vec3f gradient;
+    const FCL_REAL d = sdf.distance(p, gradient);
+    Vec3f fd;
+    for (int k = 0; k < 3; ++k) {
+      Vec3f q(p);
+      q[k] += eps;
+      fd[k] = (sdf.distance(q) - d) / eps;
+    }
+    EIGEN_VECTOR_IS_APPROX(gradient, fd, 1e-4);
+  }
+  Vec3f gradient;
+  sdf.distance(Vec3f(1.02, 0.3, -0.2), gradient);
+  EIGEN_VECTOR_IS_APPROX(gradient, Vec3f::UnitX(), 1e-3);
+  sdf.distance(Vec3f(0.3, -0.96, 0.1), gradient);
+  EIGEN_VECTOR_IS_APPROX(gradient, -Vec3f::UnitY(), 1e-3);
+}
+
+/// @brief Check the distance between the field of a box and a shape, and
+/// their collision, against the box itself.
+void checkShape(const SignedDistanceField& sdf, const Box& box,
+                const ShapeBase& shape, FCL_REAL tolerance) {
+  FCL_REAL extents_sdf[] = {-1, -1, -1, 1, 1, 1};
+  FCL_REAL extents_shape[] = {-3, -3, -3, 3, 3, 3};
+  const FCL_REAL band = sdf.getNarrowBand();
+  for (int i = 0; i < 200; ++i) {
+    Transform3f tf_sdf, tf_shape;
+    generateRandomTransform(extents_sdf, tf_sdf);
+    generateRandomTransform(extents_shape, tf_shape);
+
+    DistanceRequest request(true);
+    DistanceResult result_box, result_sdf, result_swapped;
+    const FCL_REAL d_box =
+        distance(&box, tf_sdf, &shape, tf_shape, request, result_box);
+    const FCL_REAL d_sdf =
+        distance(&sdf, tf_sdf, &shape, tf_shape, request, result_sdf);
+    const FCL_REAL d_swapped =
+        distance(&shape, tf_shape, &sdf, tf_sdf, request, result_swapped);
+    BOOST_CHECK_CLOSE(d_sdf, d_swapped, 1e-8);
+    EIGEN_VECTOR_IS_APPROX(result_sdf.nearest_points[0],
+                           result_swapped.nearest_points[1], 1e-8);
+    EIGEN_VECTOR_IS_APPROX(result_sdf.normal, -result_swapped.normal, 1e-8);
+
+    // Out of the narrow band, the field is only known to be out of it. In
+    // penetration, the depth of the deepest point of the shape is not its
+    // penetration depth.
+    if (d_box > band) {
+      BOOST_CHECK(d_sdf > band - tolerance);
+    } else if (d_box < 0) {
+      BOOST_CHECK(d_sdf < tolerance);
+    } else {
+      BOOST_CHECK_SMALL(d_sdf - d_box, tolerance);
+      // The witness point of the field lies on its surface.
+      BOOST_CHECK_SMALL(
+          sdf.distance(tf_sdf.getRotation().transpose() *
+                       (result_sdf.nearest_points[0] -
+                        tf_sdf.getTranslation())),
+          tolerance);
+    }
+
+    if (std::abs(d_box) < tolerance) continue;
+    CollisionRequest collision_request(CONTACT, 1);
+    CollisionResult collision_result, swapped_result;
+    collide(&sdf, tf_sdf, &shape, tf_shape, collision_request,
+            collision_result);
+    collide(&shape, tf_shape, &sdf, tf_sdf, collision_request,
+            swapped_result);
+    BOOST_CHECK_EQUAL(collision_result.isCollision(), d_box < 0);
+    BOOST_CHECK_EQUAL(swapped_result.isCollision(), d_box < 0);
+    if (collision_result.isCollision() && swapped_result.isCollision()) {
+      EIGEN_VECTOR_IS_APPROX(collision_result.getContact(0).normal,
+                             -swapped_result.getContact(0).normal, 1e-8);
+      BOOST_CHECK_CLOSE(collision_result.getContact(0).penetration_depth,
+                        -d_sdf, 1e-8);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(shapes) {
+  const Box box(2, 1, 1.5);
+  BVHModel<OBBRSS> mesh;
+  generateBVHModel(mesh, box, Transform3f());
+  const FCL_REAL h = 0.02;
+  SignedDistanceField sdf(mesh, h, 0.2, 1);
+  const FCL_REAL tolerance = 3 * h;
+
+  checkShape(sdf, box, Sphere(0.4), tolerance);
+  checkShape(sdf, box, Capsule(0.2, 0.8), tolerance);
+  checkShape(sdf, box, Box(0.6, 0.4, 0.8), tolerance);
+  checkShape(sdf, box, Cylinder(0.3, 0.6), tolerance);
+  checkShape(sdf, box,
+             constructPolytopeFromEllipsoid(Ellipsoid(0.3, 0.4, 0.5)),
+             tolerance);
+}
+
+BOOST_AUTO_TEST_CASE(penetration) {
+  BVHModel<OBBRSS> mesh;
+  generateBVHModel(mesh, Box(2, 2, 2), Transform3f());
+  SignedDistanceField sdf(mesh, 0.05);
+
+  // A sphere inside the box penetrates it by its radius plus its distance to
+  // the closest face, and is pushed out through that face.
+  Sphere sphere(0.2);
+  DistanceRequest request(true);
+  DistanceResult result;
+  const FCL_REAL d = distance(&sdf, Transform3f(), &sphere,
+                              Transform3f(Vec3f(0.9, 0.1, 0)), request, result);
+  BOOST_CHECK_SMALL(d + 0.3, 5e-3);
+  EIGEN_VECTOR_IS_APPROX(result.normal, Vec3f::UnitX(), 1e-2);
+
+  CollisionRequest collision_request(CONTACT, 1);
+  CollisionResult collision_result;
+  BOOST_CHECK(collide(&sdf, Transform3f(), &sphere,
+                      Transform3f(Vec3f(0.9, 0.1, 0)), collision_request,
+                      collision_result));
+  BOOST_CHECK_SMALL(collision_result.getContact(0).penetration_depth - 0.3,
+                    5e-3);
+}
+
+BOOST_AUTO_TEST_CASE(exceptions) {
+  BVHModel<OBBRSS> mesh;
+  generateBVHModel(mesh, Box(1, 1, 1), Transform3f());
+  BOOST_CHECK_THROW(SignedDistanceField(mesh, 0), std::invalid_argument);
+  BOOST_CHECK_THROW(SignedDistanceField(BVHModel<OBBRSS>(), 0.1),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(SignedDistanceField().distance(Vec3f::Zero()),
+                    std::invalid_argument);
+
+  SignedDistanceField sdf(mesh, 0.1);
+  Halfspace halfspace(Vec3f::UnitZ(), 0);
+  DistanceRequest request;
+  DistanceResult result;
+  BOOST_CHECK_THROW(distance(&sdf, Transform3f(), &halfspace, Transform3f(),
+                             request, result),
+                    std::invalid_argument);
+}
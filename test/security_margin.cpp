@@ -44,6 +44,8 @@
 #include <hpp/fcl/shape/geometric_shapes.h>
 #include <hpp/fcl/shape/geometric_shapes_utility.h>
 #include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
+#include <hpp/fcl/BV/RSS.h>
+#include <hpp/fcl/BV/kIOS.h>
 
 #include "utility.h"
 
@@ -179,6 +181,95 @@ BOOST_AUTO_TEST_CASE(aabb_aabb_degenerated_cases) {
   BOOST_CHECK(!bv1.overlap(bv3));
 }
 
+BOOST_AUTO_TEST_CASE(rss_rss) {
+  // Two parallel unit squares swept by spheres of radius 0.1, 0.3 apart.
+  RSS bv1;
+  bv1.axes.setIdentity();
+  bv1.Tr.setZero();
+  bv1.length[0] = bv1.length[1] = 1;
+  bv1.radius = 0.1;
+  RSS bv2(bv1);
+  bv2.Tr = Vec3f(0, 0, 0.5);
+  const double distance = 0.3;
+  const double tol = 1e-8;
+
+  // No security margin - no collision
+  {
+    CollisionRequest collisionRequest(CONTACT, 1);
+    FCL_REAL sqrDistLowerBound;
+    BOOST_CHECK(!bv1.overlap(bv2, collisionRequest, sqrDistLowerBound));
+    BOOST_CHECK_CLOSE(sqrDistLowerBound, MATH_SQUARED(distance), tol);
+  }
+
+  // Security margin - no collision
+  {
+    CollisionRequest collisionRequest(CONTACT, 1);
+    collisionRequest.security_margin = 0.1;
+    FCL_REAL sqrDistLowerBound;
+    BOOST_CHECK(!bv1.overlap(bv2, collisionRequest, sqrDistLowerBound));
+    BOOST_CHECK_CLOSE(sqrDistLowerBound, MATH_SQUARED(0.2), tol);
+  }
+
+  // Security margin - collision
+  {
+    CollisionRequest collisionRequest(CONTACT, 1);
+    collisionRequest.security_margin = distance + 0.01;
+    FCL_REAL sqrDistLowerBound;
+    BOOST_CHECK(bv1.overlap(bv2, collisionRequest, sqrDistLowerBound));
+  }
+
+  // Negative security margin - no collision
+  {
+    bv2.Tr = Vec3f(0, 0, 0.15);
+    CollisionRequest collisionRequest(CONTACT, 1);
+    FCL_REAL sqrDistLowerBound;
+    BOOST_CHECK(bv1.overlap(bv2, collisionRequest, sqrDistLowerBound));
+    collisionRequest.security_margin = -0.1;
+    BOOST_CHECK(!bv1.overlap(bv2, collisionRequest, sqrDistLowerBound));
+    BOOST_CHECK_CLOSE(sqrDistLowerBound, MATH_SQUARED(0.05), tol);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(kios_kios) {
+  // Two unit spheres in their bounding cubes, 0.5 apart.
+  kIOS bv1;
+  bv1.num_spheres = 1;
+  bv1.spheres[0].o.setZero();
+  bv1.spheres[0].r = 1;
+  bv1.obb.axes.setIdentity();
+  bv1.obb.To.setZero();
+  bv1.obb.extent.setOnes();
+  kIOS bv2(bv1);
+  bv2.spheres[0].o = bv2.obb.To = Vec3f(2.5, 0, 0);
+  const double distance = 0.5;
+  const double tol = 1e-8;
+
+  // No security margin - no collision
+  {
+    CollisionRequest collisionRequest(CONTACT, 1);
+    FCL_REAL sqrDistLowerBound;
+    BOOST_CHECK(!bv1.overlap(bv2, collisionRequest, sqrDistLowerBound));
+    BOOST_CHECK_CLOSE(sqrDistLowerBound, MATH_SQUARED(distance), tol);
+  }
+
+  // Security margin - no collision
+  {
+    CollisionRequest collisionRequest(CONTACT, 1);
+    collisionRequest.security_margin = 0.4;
+    FCL_REAL sqrDistLowerBound;
+    BOOST_CHECK(!bv1.overlap(bv2, collisionRequest, sqrDistLowerBound));
+    BOOST_CHECK_CLOSE(sqrDistLowerBound, MATH_SQUARED(0.1), tol);
+  }
+
+  // Security margin - collision
+  {
+    CollisionRequest collisionRequest(CONTACT, 1);
+    collisionRequest.security_margin = distance + 0.01;
+    FCL_REAL sqrDistLowerBound;
+    BOOST_CHECK(bv1.overlap(bv2, collisionRequest, sqrDistLowerBound));
+  }
+}
+
 BOOST_AUTO_TEST_CASE(sphere_sphere) {
   CollisionGeometryPtr_t s1(new hpp::fcl::Sphere(1));
   CollisionGeometryPtr_t s2(new hpp::fcl::Sphere(2));
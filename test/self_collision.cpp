@@ -0,0 +1,240 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_MODULE FCL_SELF_COLLISION
+#include <boost/test/included/unit_test.hpp>
+
+#include <set>
+
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/narrowphase/narrowphase.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+#include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+typedef std::set<std::pair<int, int> > Pairs_t;
+
+/// @brief Square cloth [0, 1]^2 of n x n cells in the plane z = 0.
+void clothGrid(int n, std::vector<Vec3f>& points,
+               std::vector<Triangle>& triangles) {
+  points.clear();
+  triangles.clear();
+  for (int i = 0; i <= n; ++i)
+    for (int j = 0; j <= n; ++j)
+      points.push_back(Vec3f((FCL_REAL)i / n, (FCL_REAL)j / n, 0));
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      const Triangle::index_type v = (Triangle::index_type)(i * (n + 1) + j),
+                                 w = v + (Triangle::index_type)n + 1;
+      triangles.push_back(Triangle(v, w, v + 1));
+      triangles.push_back(Triangle(v + 1, w, w + 1));
+    }
+  }
+}
+
+/// @brief Fold the half x > 0.5 of the cloth by 150 degrees and bend it, so
+/// that it crosses the other half.
+std::vector<Vec3f> fold(const std::vector<Vec3f>& points) {
+  const FCL_REAL angle = 150 * M_PI / 180;
+  std::vector<Vec3f> folded(points);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const FCL_REAL u = points[i][0] - 0.5;
+    if (u <= 0) continue;
+    folded[i][0] = 0.5 + u * std::cos(angle);
+    folded[i][2] = u * std::sin(angle) - 2 * u * u;
+  }
+  return folded;
+}
+
+/// @brief Pairs of non adjacent triangles in collision, tested one by one.
+Pairs_t bruteForce(const std::vector<Vec3f>& points,
+                   const std::vector<Triangle>& triangles,
+                   const CollisionRequest& request) {
+  Pairs_t pairs;
+  GJKSolver solver;
+  for (std::size_t i = 0; i < triangles.size(); ++i) {
+    const Triangle& t1 = triangles[i];
+    TriangleP tri1(points[t1[0]], points[t1[1]], points[t1[2]]);
+    for (std::size_t j = i + 1; j < triangles.size(); ++j) {
+      const Triangle& t2 = triangles[j];
+      bool adjacent = false;
+      for (int k = 0; k < 3; ++k)
+        adjacent |= (t1[k] == t2[0] || t1[k] == t2[1] || t1[k] == t2[2]);
+      if (adjacent) continue;
+      TriangleP tri2(points[t2[0]], points[t2[1]], points[t2[2]]);
+      FCL_REAL distance;
+      Vec3f p1, p2, normal;
+      solver.shapeDistance(tri1, Transform3f(), tri2, Transform3f(), distance,
+                           p1, p2, normal);
+      if (distance - request.security_margin <=
+          request.collision_distance_threshold)
+        pairs.insert(std::make_pair((int)i, (int)j));
+    }
+  }
+  return pairs;
+}
+
+Pairs_t contactPairs(const CollisionResult& result) {
+  Pairs_t pairs;
+  for (std::size_t i = 0; i < result.numContacts(); ++i) {
+    const Contact& contact = result.getContact(i);
+    BOOST_CHECK(contact.b1 != contact.b2);
+    pairs.insert(std::make_pair((std::min)(contact.b1, contact.b2),
+                                (std::max)(contact.b1, contact.b2)));
+  }
+  return pairs;
+}
+
+template <typename BV>
+void checkCloth() {
+  std::vector<Vec3f> points;
+  std::vector<Triangle> triangles;
+  clothGrid(16, points, triangles);
+
+  BVHModel<BV> cloth;
+  cloth.beginModel();
+  cloth.addSubModel(points, triangles);
+  cloth.endModel();
+
+  CollisionRequest request(CONTACT, 10000);
+  CollisionResult result;
+  // A flat cloth only touches itself between adjacent triangles.
+  BOOST_CHECK_EQUAL(selfCollide(&cloth, Transform3f(), request, result), 0);
+  BOOST_CHECK(!result.isCollision());
+
+  // Fold the cloth and refit the hierarchy.
+  const std::vector<Vec3f> folded(fold(points));
+  cloth.beginUpdateModel();
+  cloth.updateSubModel(folded);
+  cloth.endUpdateModel();
+
+  const Pairs_t expected(bruteForce(folded, triangles, request));
+  BOOST_REQUIRE(!expected.empty());
+  result.clear();
+  selfCollide(&cloth, Transform3f(), request, result);
+  BOOST_CHECK(contactPairs(result) == expected);
+  BOOST_CHECK_EQUAL(result.numContacts(), expected.size());
+
+  // The contacts are expressed in the world frame.
+  const Transform3f tf(Vec3f(0.25, -0.5, 0.125));
+  CollisionResult moved;
+  selfCollide(&cloth, tf, request, moved);
+  BOOST_REQUIRE_EQUAL(moved.numContacts(), result.numContacts());
+  for (std::size_t i = 0; i < result.numContacts(); ++i) {
+    const Contact& c = result.getContact(i);
+    const Contact& m = moved.getContact(i);
+    BOOST_CHECK_EQUAL(c.b1, m.b1);
+    BOOST_CHECK_EQUAL(c.b2, m.b2);
+    BOOST_CHECK(m.o1 == &cloth && m.o2 == &cloth);
+    EIGEN_VECTOR_IS_APPROX(tf.transform(c.pos), m.pos, 1e-6);
+  }
+
+  // Unfold it again.
+  cloth.beginUpdateModel();
+  cloth.updateSubModel(points);
+  cloth.endUpdateModel();
+  result.clear();
+  BOOST_CHECK_EQUAL(selfCollide(&cloth, Transform3f(), request, result), 0);
+}
+
+BOOST_AUTO_TEST_CASE(cloth) {
+  checkCloth<AABB>();
+  checkCloth<OBB>();
+  checkCloth<RSS>();
+  checkCloth<kIOS>();
+  checkCloth<OBBRSS>();
+  checkCloth<KDOP<16> >();
+  checkCloth<KDOP<18> >();
+  checkCloth<KDOP<24> >();
+}
+
+BOOST_AUTO_TEST_CASE(sub_models) {
+  // Two boxes in a single model: only triangles of different boxes collide.
+  BVHModel<OBBRSS> box1, box2;
+  generateBVHModel(box1, Box(1, 1, 1), Transform3f());
+  generateBVHModel(box2, Box(1, 1, 1), Transform3f(Vec3f(0.5, 0.3, 0.2)));
+
+  BVHModel<OBBRSS> model;
+  model.beginModel();
+  model.addSubModel(
+      std::vector<Vec3f>(box1.vertices, box1.vertices + box1.num_vertices),
+      std::vector<Triangle>(box1.tri_indices,
+                            box1.tri_indices + box1.num_tris));
+  model.addSubModel(
+      std::vector<Vec3f>(box2.vertices, box2.vertices + box2.num_vertices),
+      std::vector<Triangle>(box2.tri_indices,
+                            box2.tri_indices + box2.num_tris));
+  model.endModel();
+
+  CollisionRequest request(CONTACT, 1000);
+  CollisionResult result, reference;
+  selfCollide(&model, Transform3f(), request, result);
+  collide(&box1, Transform3f(), &box2, Transform3f(), request, reference);
+  BOOST_CHECK(result.numContacts() > 0);
+  BOOST_CHECK_EQUAL(result.numContacts(), reference.numContacts());
+  const int offset = (int)box1.num_tris;
+  for (std::size_t i = 0; i < result.numContacts(); ++i) {
+    const Contact& contact = result.getContact(i);
+    BOOST_CHECK((contact.b1 < offset) != (contact.b2 < offset));
+  }
+
+  // Early stop.
+  CollisionRequest first(CONTACT, 1);
+  result.clear();
+  BOOST_CHECK_EQUAL(selfCollide(&model, Transform3f(), first, result), 1);
+
+  // A closed mesh does not collide with itself.
+  result.clear();
+  BOOST_CHECK_EQUAL(selfCollide(&box1, Transform3f(), request, result), 0);
+  BVHModel<OBBRSS> sphere;
+  generateBVHModel(sphere, Sphere(1), Transform3f(), 16, 16);
+  result.clear();
+  BOOST_CHECK_EQUAL(selfCollide(&sphere, Transform3f(), request, result), 0);
+}
+
+BOOST_AUTO_TEST_CASE(point_cloud) {
+  BVHModel<OBBRSS> cloud;
+  std::vector<Vec3f> points(10, Vec3f::Zero());
+  cloud.beginModel();
+  cloud.addSubModel(points);
+  cloud.endModel();
+  CollisionRequest request;
+  CollisionResult result;
+  BOOST_CHECK_THROW(selfCollide(&cloud, Transform3f(), request, result),
+                    std::invalid_argument);
+}
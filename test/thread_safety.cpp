@@ -0,0 +1,205 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_MODULE FCL_THREAD_SAFETY
+#include <boost/test/included/unit_test.hpp>
+
+#include <thread>
+#include <vector>
+
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+#include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
+#include <hpp/fcl/BVH/BVH_model.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+const std::size_t num_threads = 4;
+const std::size_t num_queries = 2000;
+
+/// @brief Run the queries of the functors from several threads at once, each
+/// thread going through all the placements, and compare the results with the
+/// ones of sequential queries.
+void check_concurrent_queries(const CollisionGeometry* o1,
+                              const CollisionGeometry* o2) {
+  FCL_REAL extents[] = {-2, -2, -2, 2, 2, 2};
+  std::vector<Transform3f> tf1, tf2;
+  generateRandomTransforms(extents, tf1, num_queries);
+  generateRandomTransforms(extents, tf2, num_queries);
+
+  const ComputeCollision calc_collision(o1, o2);
+  const ComputeDistance calc_distance(o1, o2);
+
+  CollisionRequest collision_request(CONTACT, 1);
+  collision_request.gjk_initial_guess = GJKInitialGuess::CachedGuess;
+  DistanceRequest distance_request(true);
+  distance_request.gjk_initial_guess = GJKInitialGuess::CachedGuess;
+
+  std::vector<bool> expected_collisions(num_queries);
+  std::vector<FCL_REAL> expected_distances(num_queries);
+  {
+    CollisionRequest creq(collision_request);
+    DistanceRequest dreq(distance_request);
+    for (std::size_t i = 0; i < num_queries; ++i) {
+      CollisionResult cres;
+      expected_collisions[i] = calc_collision(tf1[i], tf2[i], creq, cres) > 0;
+      DistanceResult dres;
+      expected_distances[i] = calc_distance(tf1[i], tf2[i], dreq, dres);
+    }
+  }
+
+  // Each thread starts at a different placement, so that the threads do not
+  // run the same query at the same time.
+  std::vector<std::vector<bool> > collisions(
+      num_threads, std::vector<bool>(num_queries));
+  std::vector<std::vector<FCL_REAL> > distances(
+      num_threads, std::vector<FCL_REAL>(num_queries));
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < num_threads; ++t) {
+    threads.push_back(std::thread([&, t]() {
+      CollisionRequest creq(collision_request);
+      DistanceRequest dreq(distance_request);
+      // Half of the threads provide their own solver.
+      GJKSolver solver;
+      for (std::size_t k = 0; k < num_queries; ++k) {
+        const std::size_t i = (k + t * num_queries / num_threads) % num_queries;
+        CollisionResult cres;
+        DistanceResult dres;
+        if (t % 2 == 0) {
+          collisions[t][i] = calc_collision(tf1[i], tf2[i], creq, cres) > 0;
+          distances[t][i] = calc_distance(tf1[i], tf2[i], dreq, dres);
+        } else {
+          collisions[t][i] =
+              calc_collision(tf1[i], tf2[i], creq, cres, solver) > 0;
+          distances[t][i] = calc_distance(tf1[i], tf2[i], dreq, dres, solver);
+        }
+      }
+    }));
+  }
+  for (std::size_t t = 0; t < num_threads; ++t) threads[t].join();
+
+  // The guesses are chained in a different order by each thread, so the
+  // distances may differ by the tolerance of GJK.
+  for (std::size_t t = 0; t < num_threads; ++t) {
+    for (std::size_t i = 0; i < num_queries; ++i) {
+      BOOST_CHECK_EQUAL(collisions[t][i], expected_collisions[i]);
+      BOOST_CHECK_SMALL(distances[t][i] - expected_distances[i], 1e-4);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_shape_queries) {
+  Box box(1, 0.5, 0.8);
+  Ellipsoid ellipsoid(0.3, 0.6, 0.4);
+  Capsule capsule(0.2, 1);
+  check_concurrent_queries(&box, &ellipsoid);
+  check_concurrent_queries(&capsule, &box);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_mesh_queries) {
+  Box box(1, 0.5, 0.8);
+  BVHModel<OBBRSS> mesh;
+  generateBVHModel(mesh, box, Transform3f());
+  Sphere sphere(0.4);
+  check_concurrent_queries(&mesh, &sphere);
+  check_concurrent_queries(&sphere, &mesh);
+}
+
+/// @brief Functors overriding run, which every operator must go through.
+struct CountingComputeCollision : ComputeCollision {
+  CountingComputeCollision(const CollisionGeometry* o1,
+                           const CollisionGeometry* o2)
+      : ComputeCollision(o1, o2), num_calls(0) {}
+
+  mutable std::size_t num_calls;
+
+ protected:
+  std::size_t run(const Transform3f& tf1, const Transform3f& tf2,
+                  const CollisionRequest& request, CollisionResult& result,
+                  const GJKSolver* solver) const {
+    ++num_calls;
+    return ComputeCollision::run(tf1, tf2, request, result, solver);
+  }
+};
+
+struct CountingComputeDistance : ComputeDistance {
+  CountingComputeDistance(const CollisionGeometry* o1,
+                          const CollisionGeometry* o2)
+      : ComputeDistance(o1, o2), num_calls(0) {}
+
+  mutable std::size_t num_calls;
+
+ protected:
+  FCL_REAL run(const Transform3f& tf1, const Transform3f& tf2,
+               const DistanceRequest& request, DistanceResult& result,
+               const GJKSolver* solver) const {
+    ++num_calls;
+    return ComputeDistance::run(tf1, tf2, request, result, solver);
+  }
+};
+
+BOOST_AUTO_TEST_CASE(run_override) {
+  Box box(1, 0.5, 0.8);
+  Sphere sphere(0.4);
+  Transform3f tf1, tf2(Vec3f(0.5, 0, 0));
+  GJKSolver solver;
+
+  const CountingComputeCollision calc_collision(&box, &sphere);
+  const CountingComputeDistance calc_distance(&box, &sphere);
+
+  CollisionRequest collision_request(CONTACT, 1);
+  CollisionResult collision_result;
+  BOOST_CHECK(calc_collision(tf1, tf2, collision_request, collision_result));
+  BOOST_CHECK_EQUAL(calc_collision.num_calls, 1);
+  collision_result.clear();
+  BOOST_CHECK(
+      calc_collision(tf1, tf2, collision_request, collision_result, solver));
+  BOOST_CHECK_EQUAL(calc_collision.num_calls, 2);
+
+  DistanceRequest distance_request(true);
+  DistanceResult distance_result;
+  tf2.setTranslation(Vec3f(2, 0, 0));
+  FCL_REAL distance =
+      calc_distance(tf1, tf2, distance_request, distance_result);
+  BOOST_CHECK_CLOSE(distance, 1.1, 1e-6);
+  BOOST_CHECK_EQUAL(calc_distance.num_calls, 1);
+  distance_result.clear();
+  distance =
+      calc_distance(tf1, tf2, distance_request, distance_result, solver);
+  BOOST_CHECK_CLOSE(distance, 1.1, 1e-6);
+  BOOST_CHECK_EQUAL(calc_distance.num_calls, 2);
+}
@@ -0,0 +1,205 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2023, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_MODULE FCL_TYPED_QUERY
+#include <boost/test/included/unit_test.hpp>
+
+#include <vector>
+
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/typed_query.h>
+#include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+const FCL_REAL tol = std::sqrt(std::numeric_limits<FCL_REAL>::epsilon());
+
+/// @brief Check that the typed collide returns the results of the runtime
+/// collide on the poses tf.
+template <typename T1, typename T2>
+void checkCollision(const T1& o1, const T2& o2,
+                    const std::vector<Transform3f>& tf) {
+  const CollisionGeometry* g1 = &o1;
+  const CollisionGeometry* g2 = &o2;
+  const Transform3f tf2(Transform3f::Identity());
+  CollisionRequest request(CONTACT, 10);
+  request.security_margin = 0.01;
+  std::size_t num_collisions = 0;
+  for (std::size_t i = 0; i < tf.size(); ++i) {
+    CollisionResult typed_result, runtime_result;
+    std::size_t typed = collide(&o1, tf[i], &o2, tf2, request, typed_result);
+    std::size_t runtime = collide(g1, tf[i], g2, tf2, request, runtime_result);
+    BOOST_CHECK_EQUAL(typed, runtime);
+    BOOST_CHECK_SMALL(
+        typed_result.distance_lower_bound - runtime_result.distance_lower_bound,
+        tol);
+    if (typed != runtime) continue;
+    for (std::size_t j = 0; j < typed; ++j) {
+      const Contact& c1 = typed_result.getContact(j);
+      const Contact& c2 = runtime_result.getContact(j);
+      BOOST_CHECK_EQUAL(c1.b1, c2.b1);
+      BOOST_CHECK_EQUAL(c1.b2, c2.b2);
+      BOOST_CHECK(c1.pos.isApprox(c2.pos, tol));
+      BOOST_CHECK(c1.normal.isApprox(c2.normal, tol));
+      BOOST_CHECK_SMALL(c1.penetration_depth - c2.penetration_depth, tol);
+    }
+    if (typed > 0) ++num_collisions;
+  }
+  // Make sure that both colliding and non colliding poses are tested.
+  BOOST_CHECK(num_collisions > 0);
+  BOOST_CHECK(num_collisions < tf.size());
+}
+
+/// @brief Check that the typed distance returns the results of the runtime
+/// distance on the poses tf.
+template <typename T1, typename T2>
+void checkDistance(const T1& o1, const T2& o2,
+                   const std::vector<Transform3f>& tf) {
+  const CollisionGeometry* g1 = &o1;
+  const CollisionGeometry* g2 = &o2;
+  const Transform3f tf2(Transform3f::Identity());
+  DistanceRequest request(true);
+  for (std::size_t i = 0; i < tf.size(); ++i) {
+    DistanceResult typed_result, runtime_result;
+    FCL_REAL typed = distance(&o1, tf[i], &o2, tf2, request, typed_result);
+    FCL_REAL runtime = distance(g1, tf[i], g2, tf2, request, runtime_result);
+    BOOST_CHECK_SMALL(typed - runtime, tol);
+    BOOST_CHECK(typed_result.o1 == runtime_result.o1);
+    BOOST_CHECK(typed_result.o2 == runtime_result.o2);
+    BOOST_CHECK(typed_result.nearest_points[0].isApprox(
+        runtime_result.nearest_points[0], tol));
+    BOOST_CHECK(typed_result.nearest_points[1].isApprox(
+        runtime_result.nearest_points[1], tol));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(dispatch) {
+  using details::query_dispatch;
+  BOOST_CHECK((query_dispatch<CollisionFunctor, Box, Sphere>::Direct));
+  BOOST_CHECK((query_dispatch<CollisionFunctor, Convex<Triangle>,
+                              Capsule>::Direct));
+  BOOST_CHECK((query_dispatch<CollisionFunctor, BVHModel<OBBRSS>,
+                              Capsule>::Direct));
+  BOOST_CHECK((query_dispatch<CollisionFunctor, Capsule,
+                              BVHModel<OBBRSS> >::Swapped));
+  BOOST_CHECK((query_dispatch<CollisionFunctor, Sphere,
+                              HeightField<AABB> >::Swapped));
+  BOOST_CHECK(!(query_dispatch<CollisionFunctor, Ellipsoid, Plane>::Supported));
+  BOOST_CHECK(!(query_dispatch<CollisionFunctor, BVHModel<OBB>,
+                               BVHModel<RSS> >::Supported));
+  BOOST_CHECK(!(query_dispatch<CollisionFunctor, CollisionGeometry,
+                               Box>::Supported));
+  BOOST_CHECK(!(query_dispatch<DistanceFunctor, BVHModel<AABB>,
+                               Box>::Supported));
+  BOOST_CHECK((query_dispatch<DistanceFunctor, Box,
+                              BVHModel<RSS> >::Swapped));
+
+  // The look up tables hold the functions of the supported pairs.
+  CollisionFunctionMatrix collision_table;
+  DistanceFunctionMatrix distance_table;
+  BOOST_CHECK(collision_table.collision_matrix[BV_OBBRSS][GEOM_CAPSULE] !=
+              NULL);
+  BOOST_CHECK(collision_table.collision_matrix[GEOM_CAPSULE][BV_OBBRSS] ==
+              NULL);
+  BOOST_CHECK(collision_table.collision_matrix[GEOM_ELLIPSOID][GEOM_PLANE] ==
+              NULL);
+  BOOST_CHECK(distance_table.distance_matrix[BV_RSS][BV_RSS] != NULL);
+  BOOST_CHECK(distance_table.distance_matrix[BV_KDOP16][BV_KDOP16] == NULL);
+
+  // Unsupported pairs fall back to the runtime dispatch.
+  Ellipsoid ellipsoid(0.3, 0.4, 0.5);
+  Plane plane(Vec3f(0, 0, 1), 0);
+  CollisionRequest request;
+  CollisionResult result;
+  BOOST_CHECK_THROW(collide(&ellipsoid, Transform3f::Identity(), &plane,
+                            Transform3f::Identity(), request, result),
+                    std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(typed_collision) {
+  FCL_REAL extents[] = {-1, -1, -1, 1, 1, 1};
+  std::vector<Transform3f> tf;
+  generateRandomTransforms(extents, tf, 100);
+
+  Capsule capsule(0.2, 0.8);
+  Box box(0.5, 0.4, 0.3);
+  Sphere sphere(0.4);
+  Ellipsoid ellipsoid(0.3, 0.4, 0.5);
+  Cylinder cylinder(0.3, 0.6);
+  Convex<Triangle> convex(constructPolytopeFromEllipsoid(ellipsoid));
+
+  BVHModel<OBBRSS> mesh_obbrss;
+  generateBVHModel(mesh_obbrss, Sphere(0.6), Transform3f::Identity(), 16, 16);
+  BVHModel<AABB> mesh_aabb;
+  generateBVHModel(mesh_aabb, Box(0.8, 0.6, 0.4), Transform3f::Identity());
+
+  MatrixXf heights(16, 16);
+  for (Eigen::Index i = 0; i < heights.rows(); ++i)
+    for (Eigen::Index j = 0; j < heights.cols(); ++j)
+      heights(i, j) = 0.2 * std::sin(0.5 * (FCL_REAL)i);
+  HeightField<OBBRSS> hfield(2, 2, heights, -1);
+
+  checkCollision(ellipsoid, cylinder, tf);
+  checkCollision(convex, box, tf);
+  checkCollision(mesh_obbrss, capsule, tf);
+  checkCollision(capsule, mesh_obbrss, tf);
+  checkCollision(mesh_aabb, sphere, tf);
+  checkCollision(sphere, hfield, tf);
+  checkCollision(mesh_obbrss, mesh_obbrss, tf);
+}
+
+BOOST_AUTO_TEST_CASE(typed_distance) {
+  FCL_REAL extents[] = {-2, -2, -2, 2, 2, 2};
+  std::vector<Transform3f> tf;
+  generateRandomTransforms(extents, tf, 100);
+
+  Capsule capsule(0.2, 0.8);
+  Box box(0.5, 0.4, 0.3);
+  Sphere sphere(0.4);
+  Ellipsoid ellipsoid(0.3, 0.4, 0.5);
+  Convex<Triangle> convex(constructPolytopeFromEllipsoid(ellipsoid));
+
+  BVHModel<OBBRSS> mesh_obbrss;
+  generateBVHModel(mesh_obbrss, Sphere(0.6), Transform3f::Identity(), 16, 16);
+  BVHModel<RSS> mesh_rss;
+  generateBVHModel(mesh_rss, Box(0.8, 0.6, 0.4), Transform3f::Identity());
+
+  checkDistance(box, sphere, tf);
+  checkDistance(convex, capsule, tf);
+  checkDistance(capsule, mesh_obbrss, tf);
+  checkDistance(mesh_rss, mesh_rss, tf);
+}